@@ -25,6 +25,8 @@ char* mg_directory_path = nullptr;
 char* config_file_path = nullptr;
 char* log_file_path = nullptr;
 char* glsl_cache_file_path = nullptr;
+char* glsl_cache_index_path = nullptr;
+char* program_cache_dir_path = nullptr;
 
 static cJSON* config_json = nullptr;
 
@@ -46,6 +48,8 @@ int check_path() {
     config_file_path = concatenate(mg_directory_path, "/config.json");
     log_file_path = concatenate(mg_directory_path, "/latest.log");
     glsl_cache_file_path = concatenate(mg_directory_path, "/glsl_cache.tmp");
+    glsl_cache_index_path = concatenate(mg_directory_path, "/glsl_cache.idx");
+    program_cache_dir_path = concatenate(mg_directory_path, "/program_cache");
 
     if (mkdir(mg_directory_path, 0755) != 0 && errno != EEXIST) {
         LOG_E("Error creating MG directory.\n")
@@ -59,6 +63,8 @@ int config_refresh() {
     LOG_D("CONFIG_FILE_PATH=%s", config_file_path)
     LOG_D("LOG_FILE_PATH=%s", log_file_path)
     LOG_D("GLSL_CACHE_FILE_PATH=%s", glsl_cache_file_path)
+    LOG_D("GLSL_CACHE_INDEX_PATH=%s", glsl_cache_index_path)
+    LOG_D("PROGRAM_CACHE_DIR_PATH=%s", program_cache_dir_path)
 
     FILE* file = fopen(config_file_path, "r");
     if (file == NULL) {
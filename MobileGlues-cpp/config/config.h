@@ -16,6 +16,8 @@ extern "C"
     extern char* config_file_path;
     extern char* log_file_path;
     extern char* glsl_cache_file_path;
+    extern char* glsl_cache_index_path;
+    extern char* program_cache_dir_path;
 
     extern int initialized;
 
@@ -60,7 +60,7 @@ static bool loadEGLFunctions(void* lib) {
 }
 
 std::string getGPUInfo() {
-    void* egllib = open_lib(egl_libs, nullptr);
+    void* egllib = open_lib(egl_libs, backend_library_override("MG_EGL_LIBRARY"));
     if (!loadEGLFunctions(egllib)) {
         if (egllib) dlclose(egllib);
         return std::string();
@@ -117,7 +117,7 @@ std::string getGPUInfo() {
         return std::string();
     }
 
-    void* glesLib = open_lib(gles3_lib, nullptr);
+    void* glesLib = open_lib(gles3_lib, backend_library_override("MG_GLES_LIBRARY"));
     std::string renderer;
     if (glesLib) {
         auto glGetString = (const GLubyte* (*)(GLenum))dlsym(glesLib, "glGetString");
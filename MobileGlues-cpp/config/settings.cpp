@@ -27,7 +27,11 @@ void init_settings() {
     global_settings.ext_direct_state_access = false;
     global_settings.custom_gl_version = {0, 0, 0}; // will go default
     global_settings.fsr1_setting = FSR1_Quality_Preset::Disabled;
+    global_settings.fsr1_sharpness = DEFAULT_FSR1_SHARPNESS;
+    global_settings.fsr1_target_fps = 0;
     global_settings.hide_mg_env_level = HideMGEnvLevel::Disabled;
+    global_settings.state_filter = true;
+    global_settings.call_trace = false;
 
 #else
 
@@ -52,8 +56,14 @@ void init_settings() {
     int customGLVersionInt = success ? config_get_int("customGLVersion") : DEFAULT_GL_VERSION;
     FSR1_Quality_Preset fsr1Setting =
         success ? static_cast<FSR1_Quality_Preset>(config_get_int("fsr1Setting")) : FSR1_Quality_Preset::Disabled;
+    int fsr1Sharpness = success ? config_get_int("fsr1Sharpness") : DEFAULT_FSR1_SHARPNESS;
+    int fsr1TargetFPS = success ? config_get_int("fsr1TargetFPS") : 0;
     HideMGEnvLevel hideMGEnvLevel =
         success ? static_cast<HideMGEnvLevel>(config_get_int("hideMGEnvLevel")) : HideMGEnvLevel::Disabled;
+    // On unless explicitly set to 0
+    bool enableStateFilter = success ? (config_get_int("enableStateFilter") != 0) : true;
+    // Off unless explicitly set to 1
+    bool enableCallTrace = success && config_get_int("enableCallTrace") > 0;
 
     if (customGLVersionInt < 0) {
         customGLVersionInt = 0;
@@ -87,6 +97,12 @@ void init_settings() {
         static_cast<int>(fsr1Setting) >= static_cast<int>(FSR1_Quality_Preset::MaxValue)) {
         fsr1Setting = FSR1_Quality_Preset::Disabled;
     }
+    if (fsr1Sharpness < 0 || fsr1Sharpness > 10) {
+        fsr1Sharpness = DEFAULT_FSR1_SHARPNESS;
+    }
+    if (fsr1TargetFPS < 0 || fsr1TargetFPS > 240) {
+        fsr1TargetFPS = 0;
+    }
     if (static_cast<int>(hideMGEnvLevel) < 0 ||
         static_cast<int>(hideMGEnvLevel) >= static_cast<int>(HideMGEnvLevel::MaxValue)) {
         hideMGEnvLevel = HideMGEnvLevel::Disabled;
@@ -115,7 +131,11 @@ void init_settings() {
         maxGlslCacheSize = 0;
         angleDepthClearFixMode = AngleDepthClearFixMode::Disabled;
         fsr1Setting = FSR1_Quality_Preset::Disabled;
+        fsr1Sharpness = DEFAULT_FSR1_SHARPNESS;
+        fsr1TargetFPS = 0;
         hideMGEnvLevel = HideMGEnvLevel::Disabled;
+        enableStateFilter = true;
+        enableCallTrace = false;
     }
 
     AngleMode finalAngleMode = AngleMode::Disabled;
@@ -195,7 +215,11 @@ void init_settings() {
     global_settings.angle_depth_clear_fix_mode = angleDepthClearFixMode;
     global_settings.custom_gl_version = customGLVersion;
     global_settings.fsr1_setting = fsr1Setting;
+    global_settings.fsr1_sharpness = fsr1Sharpness;
+    global_settings.fsr1_target_fps = fsr1TargetFPS;
     global_settings.hide_mg_env_level = hideMGEnvLevel;
+    global_settings.state_filter = enableStateFilter;
+    global_settings.call_trace = enableCallTrace;
 #endif
 
     LOG_V("[MobileGlues] Setting: enableAngle                 = %s",
@@ -219,8 +243,12 @@ void init_settings() {
               global_settings.custom_gl_version.toString().c_str());
     }
     LOG_V("[MobileGlues] Setting: fsr1Setting                 = %i", static_cast<int>(global_settings.fsr1_setting))
+    LOG_V("[MobileGlues] Setting: fsr1Sharpness               = %i", global_settings.fsr1_sharpness)
+    LOG_V("[MobileGlues] Setting: fsr1TargetFPS               = %i", global_settings.fsr1_target_fps)
     LOG_V("[MobileGlues] Setting: hideMGEnvLevel              = %i",
           static_cast<int>(global_settings.hide_mg_env_level))
+    LOG_V("[MobileGlues] Setting: enableStateFilter           = %s", global_settings.state_filter ? "true" : "false")
+    LOG_V("[MobileGlues] Setting: enableCallTrace             = %s", global_settings.call_trace ? "true" : "false")
 
     GLVersion =
         global_settings.custom_gl_version.isEmpty() ? Version(DEFAULT_GL_VERSION) : global_settings.custom_gl_version;
@@ -412,6 +440,9 @@ std::string dump_settings_string(std::string prefix) {
     }
     ss << "\n";
 
+    ss << prefix << "Fsr1Sharpness: " << global_settings.fsr1_sharpness << "\n";
+    ss << prefix << "Fsr1TargetFPS: " << global_settings.fsr1_target_fps << "\n";
+
     ss << prefix << "HideMGEnvLevel: "
        << ((global_settings.hide_mg_env_level == HideMGEnvLevel::Disabled)
                ? "Disabled"
@@ -419,5 +450,8 @@ std::string dump_settings_string(std::string prefix) {
 
     ss << "\n";
 
+    ss << prefix << "StateFilter: " << (global_settings.state_filter ? "Enabled" : "Disabled") << "\n";
+    ss << prefix << "CallTrace: " << (global_settings.call_trace ? "Enabled" : "Disabled") << "\n";
+
     return ss.str();
 }
@@ -15,12 +15,13 @@
 #include <cctype>
 
 #if !defined(__APPLE__)
-#include <__stddef_size_t.h>
+#include <cstddef>
 #else
 typedef unsigned long size_t;
 #endif
 
 #define DEFAULT_GL_VERSION 40
+#define DEFAULT_FSR1_SHARPNESS 8
 
 enum class multidraw_mode_t : int {
     Auto = 0,
@@ -169,7 +170,14 @@ struct global_settings_t {
     AngleDepthClearFixMode angle_depth_clear_fix_mode;
     Version custom_gl_version;
     FSR1_Quality_Preset fsr1_setting;
+    // RCAS sharpening strength after FSR1 upscaling: 0 skips the pass,
+    // 1 (softest) to 10 (sharpest)
+    int fsr1_sharpness;
+    // Frame rate dynamic resolution aims for; 0 keeps the resolution fixed
+    int fsr1_target_fps;
     HideMGEnvLevel hide_mg_env_level;
+    bool state_filter;
+    bool call_trace;
 };
 
 extern global_settings_t global_settings;
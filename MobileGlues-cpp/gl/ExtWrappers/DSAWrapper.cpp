@@ -112,14 +112,13 @@ GLenum GetBindingQuery(GLenum target, bool forceTexture = false) {
 // buffer
 static thread_local ankerl::unordered_dense::map<GLenum, std::vector<GLuint>> bufferBindingStack;
 void temporarilyBindBuffer(GLuint bufferID, GLenum target = GL_ARRAY_BUFFER) {
-    GLenum bindingQuery = GetBindingQuery(target);
-    GLint prev = 0;
-    glGetIntegerv(bindingQuery, &prev);
+    // Answered from buffer.cpp's binding tracking, no driver round trip
+    GLuint prev = find_bound_buffer(GetBindingQuery(target));
     if (prev == bufferID) {
         bufferBindingStack[target].push_back(-1);
         // return;
     }
-    bufferBindingStack[target].push_back(static_cast<GLuint>(prev));
+    bufferBindingStack[target].push_back(prev);
 
     LOG_D("[DSA] [TempBind] target=0x%X, prev=%u -> bind=%u", target, prev, bufferID);
     CHECK_GL_ERROR;
@@ -151,6 +150,7 @@ void restoreTemporaryBufferBinding(GLenum target = GL_ARRAY_BUFFER) {
 
 void glCreateBuffers(GLsizei n, GLuint* buffers) {
     LOG()
+    MG_TRACE_ARGS(glCreateBuffers, n, buffers)
     LOG_D("[DSA] glCreateBuffers, n: %d, buffers: %p", n, buffers);
 
     if (n <= 0 || !buffers) {
@@ -177,6 +177,7 @@ void glCreateBuffers(GLsizei n, GLuint* buffers) {
 
 void glNamedBufferStorage(GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags) {
     LOG()
+    MG_TRACE_ARGS(glNamedBufferStorage, buffer, size, data, flags)
     LOG_D("[DSA] glNamedBufferStorage, buffer: %u, size: %lld, data: %p, flags: %u", buffer, size, data, flags);
 
     if (buffer == 0 || size <= 0) {
@@ -194,6 +195,7 @@ void glNamedBufferStorage(GLuint buffer, GLsizeiptr size, const void* data, GLbi
 
 void glNamedBufferData(GLuint buffer, GLsizeiptr size, const void* data, GLenum usage) {
     LOG()
+    MG_TRACE_ARGS(glNamedBufferData, buffer, size, data, usage)
     LOG_D("[DSA] glNamedBufferData, buffer: %u, size: %lld, data: %p, usage: %u", buffer, size, data, usage);
 
     if (buffer == 0 || size <= 0) {
@@ -211,6 +213,7 @@ void glNamedBufferData(GLuint buffer, GLsizeiptr size, const void* data, GLenum
 
 void glNamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data) {
     LOG()
+    MG_TRACE_ARGS(glNamedBufferSubData, buffer, offset, size, data)
     LOG_D("[DSA] glNamedBufferSubData, buffer: %u, offset: %lld, size: %lld, data: %p", buffer, offset, size, data);
 
     if (buffer == 0 || size <= 0 || offset < 0) {
@@ -228,6 +231,7 @@ void glNamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const
 void glCopyNamedBufferSubData(GLuint readBuffer, GLuint writeBuffer, GLintptr readOffset, GLintptr writeOffset,
                               GLsizeiptr size) {
     LOG()
+    MG_TRACE_ARGS(glCopyNamedBufferSubData, readBuffer, writeBuffer, readOffset, writeOffset, size)
     LOG_D("[DSA] glCopyNamedBufferSubData, readBuffer: %u, writeBuffer: %u, readOffset: %lld, writeOffset: %lld, size: "
           "%lld",
           readBuffer, writeBuffer, readOffset, writeOffset, size);
@@ -247,6 +251,7 @@ void glCopyNamedBufferSubData(GLuint readBuffer, GLuint writeBuffer, GLintptr re
 
 void glClearNamedBufferData(GLuint buffer, GLenum internalformat, GLenum format, GLenum type, const void* data) {
     LOG()
+    MG_TRACE_ARGS(glClearNamedBufferData, buffer, internalformat, format, type, data)
     LOG_D("[DSA] glClearNamedBufferData, buffer: %u, internalformat: 0x%X, format: 0x%X, type: 0x%X, data: %p", buffer,
           internalformat, format, type, data);
 
@@ -265,6 +270,7 @@ void glClearNamedBufferData(GLuint buffer, GLenum internalformat, GLenum format,
 void glClearNamedBufferSubData(GLuint buffer, GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format,
                                GLenum type, const void* data) {
     LOG()
+    MG_TRACE_ARGS(glClearNamedBufferSubData, buffer, internalformat, offset, size, format, type, data)
     LOG_D("[DSA] glClearNamedBufferSubData, buffer: %u, internalformat: 0x%X, offset: %lld, size: %lld, format: 0x%X, "
           "type: 0x%X, data: %p",
           buffer, internalformat, offset, size, format, type, data);
@@ -283,6 +289,7 @@ void glClearNamedBufferSubData(GLuint buffer, GLenum internalformat, GLintptr of
 
 void* glMapNamedBuffer(GLuint buffer, GLenum access) {
     LOG()
+    MG_TRACE_ARGS(glMapNamedBuffer, buffer, access)
     LOG_D("[DSA] glMapNamedBuffer, buffer: %u, access: 0x%X", buffer, access);
 
     if (buffer == 0) {
@@ -304,6 +311,7 @@ void* glMapNamedBuffer(GLuint buffer, GLenum access) {
 
 GLvoid* glMapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access) {
     LOG()
+    MG_TRACE_ARGS(glMapNamedBufferRange, buffer, offset, length, access)
     LOG_D("[DSA] glMapNamedBufferRange, buffer: %u, offset: %lld, length: %lld, access: 0x%X", buffer, offset, length,
           access);
 
@@ -326,6 +334,7 @@ GLvoid* glMapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length,
 
 GLboolean glUnmapNamedBuffer(GLuint buffer) {
     LOG()
+    MG_TRACE_ARGS(glUnmapNamedBuffer, buffer)
     LOG_D("[DSA] glUnmapNamedBuffer, buffer: %u", buffer);
 
     if (buffer == 0) {
@@ -347,6 +356,7 @@ GLboolean glUnmapNamedBuffer(GLuint buffer) {
 
 void glFlushMappedNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length) {
     LOG()
+    MG_TRACE_ARGS(glFlushMappedNamedBufferRange, buffer, offset, length)
     LOG_D("[DSA] glFlushMappedNamedBufferRange, buffer: %u, offset: %lld, length: %lld", buffer, offset, length);
 
     if (buffer == 0 || length <= 0 || offset < 0) {
@@ -363,6 +373,7 @@ void glFlushMappedNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr le
 
 void glGetNamedBufferParameteriv(GLuint buffer, GLenum pname, GLint* params) {
     LOG()
+    MG_TRACE_ARGS(glGetNamedBufferParameteriv, buffer, pname, params)
     LOG_D("[DSA] glGetNamedBufferParameteriv, buffer: %u, pname: 0x%X, params: %p", buffer, pname, params);
 
     if (buffer == 0 || !params) {
@@ -379,6 +390,7 @@ void glGetNamedBufferParameteriv(GLuint buffer, GLenum pname, GLint* params) {
 
 void glGetNamedBufferParameteri64v(GLuint buffer, GLenum pname, GLint64* params) {
     LOG()
+    MG_TRACE_ARGS(glGetNamedBufferParameteri64v, buffer, pname, params)
     LOG_D("[DSA] glGetNamedBufferParameteri64v, buffer: %u, pname: 0x%X, params: %p", buffer, pname, params);
 
     if (buffer == 0 || !params) {
@@ -395,6 +407,7 @@ void glGetNamedBufferParameteri64v(GLuint buffer, GLenum pname, GLint64* params)
 
 void glGetNamedBufferPointerv(GLuint buffer, GLenum pname, void** params) {
     LOG()
+    MG_TRACE_ARGS(glGetNamedBufferPointerv, buffer, pname, params)
     LOG_D("[DSA] glGetNamedBufferPointerv, buffer: %u, pname: 0x%X, params: %p", buffer, pname, params);
 
     if (buffer == 0 || !params) {
@@ -411,6 +424,7 @@ void glGetNamedBufferPointerv(GLuint buffer, GLenum pname, void** params) {
 
 void glGetNamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, void* data) {
     LOG()
+    MG_TRACE_ARGS(glGetNamedBufferSubData, buffer, offset, size, data)
     LOG_D("[DSA] glGetNamedBufferSubData, buffer: %u, offset: %lld, size: %lld, data: %p", buffer, offset, size, data);
 
     if (buffer == 0 || size <= 0 || offset < 0 || !data) {
@@ -462,6 +476,7 @@ void restoreTemporaryFramebufferBinding(GLenum target = GL_DRAW_FRAMEBUFFER) {
 
 void glCreateFramebuffers(GLsizei n, GLuint* framebuffers) {
     LOG()
+    MG_TRACE_ARGS(glCreateFramebuffers, n, framebuffers)
     LOG_D("[DSA] glCreateFramebuffers, n: %d, framebuffers: %p", n, framebuffers);
 
     if (n <= 0 || !framebuffers) {
@@ -487,6 +502,7 @@ void glCreateFramebuffers(GLsizei n, GLuint* framebuffers) {
 void glNamedFramebufferRenderbuffer(GLuint framebuffer, GLenum attachment, GLenum renderbuffertarget,
                                     GLuint renderbuffer) {
     LOG()
+    MG_TRACE_ARGS(glNamedFramebufferRenderbuffer, framebuffer, attachment, renderbuffertarget, renderbuffer)
     LOG_D("[DSA] glNamedFramebufferRenderbuffer, framebuffer: %u, attachment: 0x%X, renderbuffertarget: 0x%X, "
           "renderbuffer: %u",
           framebuffer, attachment, renderbuffertarget, renderbuffer);
@@ -502,6 +518,7 @@ void glNamedFramebufferRenderbuffer(GLuint framebuffer, GLenum attachment, GLenu
 
 void glNamedFramebufferParameteri(GLuint framebuffer, GLenum pname, GLint param) {
     LOG()
+    MG_TRACE_ARGS(glNamedFramebufferParameteri, framebuffer, pname, param)
     LOG_D("[DSA] glNamedFramebufferParameteri, framebuffer: %u, pname: 0x%X, param: %d", framebuffer, pname, param);
 
     temporarilyBindFramebuffer(framebuffer);
@@ -514,6 +531,7 @@ void glNamedFramebufferParameteri(GLuint framebuffer, GLenum pname, GLint param)
 
 void glNamedFramebufferTexture(GLuint framebuffer, GLenum attachment, GLuint texture, GLint level) {
     LOG()
+    MG_TRACE_ARGS(glNamedFramebufferTexture, framebuffer, attachment, texture, level)
     LOG_D("[DSA] glNamedFramebufferTexture, framebuffer: %u, attachment: 0x%X, texture: %u, level: %d", framebuffer,
           attachment, texture, level);
 
@@ -529,6 +547,7 @@ void glNamedFramebufferTexture(GLuint framebuffer, GLenum attachment, GLuint tex
 
 void glNamedFramebufferTextureLayer(GLuint framebuffer, GLenum attachment, GLuint texture, GLint level, GLint layer) {
     LOG()
+    MG_TRACE_ARGS(glNamedFramebufferTextureLayer, framebuffer, attachment, texture, level, layer)
     LOG_D("[DSA] glNamedFramebufferTextureLayer, framebuffer: %u, attachment: 0x%X, texture: %u, level: %d, layer: %d",
           framebuffer, attachment, texture, level, layer);
 
@@ -543,6 +562,7 @@ void glNamedFramebufferTextureLayer(GLuint framebuffer, GLenum attachment, GLuin
 
 void glNamedFramebufferDrawBuffer(GLuint framebuffer, GLenum mode) {
     LOG()
+    MG_TRACE_ARGS(glNamedFramebufferDrawBuffer, framebuffer, mode)
     LOG_D("[DSA] glNamedFramebufferDrawBuffer, framebuffer: %u, mode: 0x%X", framebuffer, mode);
 
     temporarilyBindFramebuffer(framebuffer);
@@ -555,6 +575,7 @@ void glNamedFramebufferDrawBuffer(GLuint framebuffer, GLenum mode) {
 
 void glNamedFramebufferDrawBuffers(GLuint framebuffer, GLsizei n, const GLenum* bufs) {
     LOG()
+    MG_TRACE_ARGS(glNamedFramebufferDrawBuffers, framebuffer, n, bufs)
     LOG_D("[DSA] glNamedFramebufferDrawBuffers, framebuffer: %u, n: %d, bufs: %p", framebuffer, n, bufs);
 
     if (n <= 0 || !bufs) {
@@ -571,6 +592,7 @@ void glNamedFramebufferDrawBuffers(GLuint framebuffer, GLsizei n, const GLenum*
 
 void glNamedFramebufferReadBuffer(GLuint framebuffer, GLenum mode) {
     LOG()
+    MG_TRACE_ARGS(glNamedFramebufferReadBuffer, framebuffer, mode)
     LOG_D("[DSA] glNamedFramebufferReadBuffer, framebuffer: %u, mode: 0x%X", framebuffer, mode);
 
     temporarilyBindFramebuffer(framebuffer, GL_READ_FRAMEBUFFER);
@@ -583,6 +605,7 @@ void glNamedFramebufferReadBuffer(GLuint framebuffer, GLenum mode) {
 
 void glInvalidateNamedFramebufferData(GLuint framebuffer, GLsizei numAttachments, const GLenum* attachments) {
     LOG()
+    MG_TRACE_ARGS(glInvalidateNamedFramebufferData, framebuffer, numAttachments, attachments)
     LOG_D("[DSA] glInvalidateNamedFramebufferData, framebuffer: %u, numAttachments: %d, attachments: %p", framebuffer,
           numAttachments, attachments);
 
@@ -603,6 +626,7 @@ void glInvalidateNamedFramebufferData(GLuint framebuffer, GLsizei numAttachments
 void glInvalidateNamedFramebufferSubData(GLuint framebuffer, GLsizei numAttachments, const GLenum* attachments, GLint x,
                                          GLint y, GLsizei width, GLsizei height) {
     LOG()
+    MG_TRACE_ARGS(glInvalidateNamedFramebufferSubData, framebuffer, numAttachments, attachments, x, y, width, height)
     LOG_D("[DSA] glInvalidateNamedFramebufferSubData, framebuffer: %u, numAttachments: %d, attachments: %p, x: %d, y: "
           "%d, width: %d, height: %d",
           framebuffer, numAttachments, attachments, x, y, width, height);
@@ -624,6 +648,7 @@ void glInvalidateNamedFramebufferSubData(GLuint framebuffer, GLsizei numAttachme
 
 void glClearNamedFramebufferiv(GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLint* value) {
     LOG()
+    MG_TRACE_ARGS(glClearNamedFramebufferiv, framebuffer, buffer, drawbuffer, value)
     LOG_D("[DSA] glClearNamedFramebufferiv, framebuffer: %u, buffer: 0x%X, drawbuffer: %d, value: %p", framebuffer,
           buffer, drawbuffer, value);
 
@@ -641,6 +666,7 @@ void glClearNamedFramebufferiv(GLuint framebuffer, GLenum buffer, GLint drawbuff
 
 void glClearNamedFramebufferuiv(GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLuint* value) {
     LOG()
+    MG_TRACE_ARGS(glClearNamedFramebufferuiv, framebuffer, buffer, drawbuffer, value)
     LOG_D("[DSA] glClearNamedFramebufferuiv, framebuffer: %u, buffer: 0x%X, drawbuffer: %d, value: %p", framebuffer,
           buffer, drawbuffer, value);
 
@@ -659,6 +685,7 @@ void glClearNamedFramebufferuiv(GLuint framebuffer, GLenum buffer, GLint drawbuf
 
 void glClearNamedFramebufferfv(GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLfloat* value) {
     LOG()
+    MG_TRACE_ARGS(glClearNamedFramebufferfv, framebuffer, buffer, drawbuffer, value)
     LOG_D("[DSA] glClearNamedFramebufferfv, framebuffer: %u, buffer: 0x%X, drawbuffer: %d, value: %p", framebuffer,
           buffer, drawbuffer, value);
 
@@ -676,6 +703,7 @@ void glClearNamedFramebufferfv(GLuint framebuffer, GLenum buffer, GLint drawbuff
 
 void glClearNamedFramebufferfi(GLuint framebuffer, GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil) {
     LOG()
+    MG_TRACE_ARGS(glClearNamedFramebufferfi, framebuffer, buffer, drawbuffer, depth, stencil)
     LOG_D("[DSA] glClearNamedFramebufferfi, framebuffer: %u, buffer: 0x%X, drawbuffer: %d, depth: %f, stencil: %d",
           framebuffer, buffer, drawbuffer, depth, stencil);
 
@@ -692,6 +720,8 @@ void glBlitNamedFramebuffer(GLuint readFramebuffer, GLuint drawFramebuffer, GLin
                             GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask,
                             GLenum filter) {
     LOG()
+    MG_TRACE_ARGS(glBlitNamedFramebuffer, readFramebuffer, drawFramebuffer, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0,
+                  dstX1, dstY1, mask, filter)
     LOG_D("[DSA] glBlitNamedFramebuffer, readFramebuffer: %u, drawFramebuffer: %u, src: (%d, %d) to (%d, %d), dst: "
           "(%d, %d) to (%d, %d), mask: 0x%X, filter: 0x%X",
           readFramebuffer, drawFramebuffer, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
@@ -708,6 +738,7 @@ void glBlitNamedFramebuffer(GLuint readFramebuffer, GLuint drawFramebuffer, GLin
 
 GLenum glCheckNamedFramebufferStatus(GLuint framebuffer, GLenum target) {
     LOG()
+    MG_TRACE_ARGS(glCheckNamedFramebufferStatus, framebuffer, target)
     LOG_D("[DSA] glCheckNamedFramebufferStatus, framebuffer: %u, target: 0x%X", framebuffer, target);
 
     temporarilyBindFramebuffer(framebuffer, target);
@@ -721,6 +752,7 @@ GLenum glCheckNamedFramebufferStatus(GLuint framebuffer, GLenum target) {
 
 void glGetNamedFramebufferParameteriv(GLuint framebuffer, GLenum pname, GLint* param) {
     LOG()
+    MG_TRACE_ARGS(glGetNamedFramebufferParameteriv, framebuffer, pname, param)
     LOG_D("[DSA] glGetNamedFramebufferParameteriv, framebuffer: %u, pname: 0x%X, param: %p", framebuffer, pname, param);
 
     if (!param) {
@@ -737,6 +769,7 @@ void glGetNamedFramebufferParameteriv(GLuint framebuffer, GLenum pname, GLint* p
 
 void glGetNamedFramebufferAttachmentParameteriv(GLuint framebuffer, GLenum attachment, GLenum pname, GLint* params) {
     LOG()
+    MG_TRACE_ARGS(glGetNamedFramebufferAttachmentParameteriv, framebuffer, attachment, pname, params)
     LOG_D(
         "[DSA] glGetNamedFramebufferAttachmentParameteriv, framebuffer: %u, attachment: 0x%X, pname: 0x%X, params: %p",
         framebuffer, attachment, pname, params);
@@ -791,6 +824,7 @@ void restoreTemporaryRenderbufferBinding() {
 
 void glCreateRenderbuffers(GLsizei n, GLuint* renderbuffers) {
     LOG()
+    MG_TRACE_ARGS(glCreateRenderbuffers, n, renderbuffers)
     LOG_D("[DSA] glCreateRenderbuffers, n: %d, renderbuffers: %p", n, renderbuffers);
 
     if (n <= 0 || !renderbuffers) {
@@ -815,6 +849,7 @@ void glCreateRenderbuffers(GLsizei n, GLuint* renderbuffers) {
 
 void glNamedRenderbufferStorage(GLuint renderbuffer, GLenum internalformat, GLsizei width, GLsizei height) {
     LOG()
+    MG_TRACE_ARGS(glNamedRenderbufferStorage, renderbuffer, internalformat, width, height)
     LOG_D("[DSA] glNamedRenderbufferStorage, renderbuffer: %u, internalformat: 0x%X, width: %d, height: %d",
           renderbuffer, internalformat, width, height);
 
@@ -834,6 +869,7 @@ void glNamedRenderbufferStorage(GLuint renderbuffer, GLenum internalformat, GLsi
 void glNamedRenderbufferStorageMultisample(GLuint renderbuffer, GLsizei samples, GLenum internalformat, GLsizei width,
                                            GLsizei height) {
     LOG()
+    MG_TRACE_ARGS(glNamedRenderbufferStorageMultisample, renderbuffer, samples, internalformat, width, height)
     LOG_D("[DSA] glNamedRenderbufferStorageMultisample, renderbuffer: %u, samples: %d, internalformat: 0x%X, width: "
           "%d, height: %d",
           renderbuffer, samples, internalformat, width, height);
@@ -853,6 +889,7 @@ void glNamedRenderbufferStorageMultisample(GLuint renderbuffer, GLsizei samples,
 
 void glGetNamedRenderbufferParameteriv(GLuint renderbuffer, GLenum pname, GLint* params) {
     LOG()
+    MG_TRACE_ARGS(glGetNamedRenderbufferParameteriv, renderbuffer, pname, params)
     LOG_D("[DSA] glGetNamedRenderbufferParameteriv, renderbuffer: %u, pname: 0x%X, params: %p", renderbuffer, pname,
           params);
 
@@ -917,6 +954,7 @@ void restoreTemporaryTextureBinding(GLuint textureID, GLenum possibleTarget = 0)
 
 void glCreateTextures(GLenum target, GLsizei n, GLuint* textures) {
     LOG()
+    MG_TRACE_ARGS(glCreateTextures, target, n, textures)
     LOG_D("[DSA] glCreateTextures, target: 0x%X, n: %d, textures: %p", target, n, textures);
 
     if (n <= 0 || !textures) {
@@ -942,6 +980,7 @@ void glCreateTextures(GLenum target, GLsizei n, GLuint* textures) {
 
 void glTextureBuffer(GLuint texture, GLenum internalformat, GLuint buffer) {
     LOG()
+    MG_TRACE_ARGS(glTextureBuffer, texture, internalformat, buffer)
     LOG_D("[DSA] glTextureBuffer, texture: %u, internalformat: 0x%X, buffer: %u", texture, internalformat, buffer);
 
     if (buffer == 0) {
@@ -959,6 +998,7 @@ void glTextureBuffer(GLuint texture, GLenum internalformat, GLuint buffer) {
 
 void glTextureBufferRange(GLuint texture, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size) {
     LOG()
+    MG_TRACE_ARGS(glTextureBufferRange, texture, internalformat, buffer, offset, size)
     LOG_D("[DSA] glTextureBufferRange, texture: %u, internalformat: 0x%X, buffer: %u, offset: %lld, size: %lld",
           texture, internalformat, buffer, offset, size);
 
@@ -976,8 +1016,9 @@ void glTextureBufferRange(GLuint texture, GLenum internalformat, GLuint buffer,
           internalformat, size, offset);
 }
 
-#define TEXTURE_OP_FUNC_BEGIN(func_name)                                                                               \
+#define TEXTURE_OP_FUNC_BEGIN(func_name, ...)                                                                          \
     LOG()                                                                                                              \
+    MG_TRACE_ARGS(func_name, __VA_ARGS__)                                                                              \
     LOG_D(#func_name ", texture: %u", texture);                                                                        \
     GLenum target = GetTexTarget(texture);                                                                             \
     temporarilyBindTexture(texture);
@@ -987,14 +1028,14 @@ void glTextureBufferRange(GLuint texture, GLenum internalformat, GLuint buffer,
     restoreTemporaryTextureBinding(texture);
 
 void glTextureStorage1D(GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureStorage1D)
+    TEXTURE_OP_FUNC_BEGIN(glTextureStorage1D, texture, levels, internalformat, width)
     glTexStorage1D(target, levels, internalformat, width);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set 1D storage for texture %u with internal format 0x%X and width %d", texture, internalformat, width);
 }
 
 void glTextureStorage2D(GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureStorage2D)
+    TEXTURE_OP_FUNC_BEGIN(glTextureStorage2D, texture, levels, internalformat, width, height)
     glTexStorage2D(target, levels, internalformat, width, height);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set 2D storage for texture %u with internal format 0x%X and size (%d, %d)", texture, internalformat,
@@ -1003,7 +1044,7 @@ void glTextureStorage2D(GLuint texture, GLsizei levels, GLenum internalformat, G
 
 void glTextureStorage3D(GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height,
                         GLsizei depth) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureStorage3D)
+    TEXTURE_OP_FUNC_BEGIN(glTextureStorage3D, texture, levels, internalformat, width, height, depth)
     glTexStorage3D(target, levels, internalformat, width, height, depth);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set 3D storage for texture %u with internal format 0x%X and size (%d, %d, %d)", texture,
@@ -1012,7 +1053,8 @@ void glTextureStorage3D(GLuint texture, GLsizei levels, GLenum internalformat, G
 
 void glTextureStorage2DMultisample(GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width,
                                    GLsizei height, GLboolean fixedsamplelocations) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureStorage2DMultisample)
+    TEXTURE_OP_FUNC_BEGIN(glTextureStorage2DMultisample, texture, samples, internalformat, width, height,
+                          fixedsamplelocations)
     glTexStorage2DMultisample(target, samples, internalformat, width, height, fixedsamplelocations);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set 2D multisample storage for texture %u with internal format 0x%X and size (%d, %d)", texture,
@@ -1021,7 +1063,8 @@ void glTextureStorage2DMultisample(GLuint texture, GLsizei samples, GLenum inter
 
 void glTextureStorage3DMultisample(GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width,
                                    GLsizei height, GLsizei depth, GLboolean fixedsamplelocations) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureStorage3DMultisample)
+    TEXTURE_OP_FUNC_BEGIN(glTextureStorage3DMultisample, texture, samples, internalformat, width, height, depth,
+                          fixedsamplelocations)
     glTexStorage3DMultisample(target, samples, internalformat, width, height, depth, fixedsamplelocations);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set 3D multisample storage for texture %u with internal format 0x%X and size (%d, %d, %d)", texture,
@@ -1030,7 +1073,7 @@ void glTextureStorage3DMultisample(GLuint texture, GLsizei samples, GLenum inter
 
 void glTextureSubImage1D(GLuint texture, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type,
                          const void* pixels) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureSubImage1D)
+    TEXTURE_OP_FUNC_BEGIN(glTextureSubImage1D, texture, level, xoffset, width, format, type, pixels)
     glTexSubImage1D(target, level, xoffset, width, format, type, pixels);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Updated 1D sub-image of texture %u at level %d with size %d at offset %d", texture, level, width,
@@ -1039,7 +1082,7 @@ void glTextureSubImage1D(GLuint texture, GLint level, GLint xoffset, GLsizei wid
 
 void glTextureSubImage2D(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
                          GLenum format, GLenum type, const void* pixels) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureSubImage2D)
+    TEXTURE_OP_FUNC_BEGIN(glTextureSubImage2D, texture, level, xoffset, yoffset, width, height, format, type, pixels)
     glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Updated 2D sub-image of texture %u at level %d with size (%d, %d) at offset (%d, %d)", texture, level,
@@ -1048,7 +1091,8 @@ void glTextureSubImage2D(GLuint texture, GLint level, GLint xoffset, GLint yoffs
 
 void glTextureSubImage3D(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width,
                          GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureSubImage3D)
+    TEXTURE_OP_FUNC_BEGIN(glTextureSubImage3D, texture, level, xoffset, yoffset, zoffset, width, height, depth, format,
+                          type, pixels)
     glTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Updated 3D sub-image of texture %u at level %d with size (%d, %d, %d) at offset (%d, %d, %d)", texture,
@@ -1057,7 +1101,7 @@ void glTextureSubImage3D(GLuint texture, GLint level, GLint xoffset, GLint yoffs
 
 void glCompressedTextureSubImage1D(GLuint texture, GLint level, GLint xoffset, GLsizei width, GLenum format,
                                    GLsizei imageSize, const void* data) {
-    TEXTURE_OP_FUNC_BEGIN(glCompressedTextureSubImage1D)
+    TEXTURE_OP_FUNC_BEGIN(glCompressedTextureSubImage1D, texture, level, xoffset, width, format, imageSize, data)
     glCompressedTexSubImage1D(target, level, xoffset, width, format, imageSize, data);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Updated compressed 1D sub-image of texture %u at level %d with size %d at offset %d", texture, level,
@@ -1066,7 +1110,8 @@ void glCompressedTextureSubImage1D(GLuint texture, GLint level, GLint xoffset, G
 
 void glCompressedTextureSubImage2D(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
                                    GLsizei height, GLenum format, GLsizei imageSize, const void* data) {
-    TEXTURE_OP_FUNC_BEGIN(glCompressedTextureSubImage2D)
+    TEXTURE_OP_FUNC_BEGIN(glCompressedTextureSubImage2D, texture, level, xoffset, yoffset, width, height, format,
+                          imageSize, data)
     glCompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Updated compressed 2D sub-image of texture %u at level %d with size (%d, %d) at offset (%d, %d)",
@@ -1076,7 +1121,8 @@ void glCompressedTextureSubImage2D(GLuint texture, GLint level, GLint xoffset, G
 void glCompressedTextureSubImage3D(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
                                    GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize,
                                    const void* data) {
-    TEXTURE_OP_FUNC_BEGIN(glCompressedTextureSubImage3D)
+    TEXTURE_OP_FUNC_BEGIN(glCompressedTextureSubImage3D, texture, level, xoffset, yoffset, zoffset, width, height,
+                          depth, format, imageSize, data)
     glCompressedTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
     TEXTURE_OP_FUNC_END
     LOG_D(
@@ -1085,7 +1131,7 @@ void glCompressedTextureSubImage3D(GLuint texture, GLint level, GLint xoffset, G
 }
 
 void glCopyTextureSubImage1D(GLuint texture, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width) {
-    TEXTURE_OP_FUNC_BEGIN(glCopyTextureSubImage1D)
+    TEXTURE_OP_FUNC_BEGIN(glCopyTextureSubImage1D, texture, level, xoffset, x, y, width)
     glCopyTexSubImage1D(target, level, xoffset, x, y, width);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Copied 1D sub-image to texture %u at level %d with size %d at offset %d", texture, level, width,
@@ -1094,7 +1140,7 @@ void glCopyTextureSubImage1D(GLuint texture, GLint level, GLint xoffset, GLint x
 
 void glCopyTextureSubImage2D(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width,
                              GLsizei height) {
-    TEXTURE_OP_FUNC_BEGIN(glCopyTextureSubImage2D)
+    TEXTURE_OP_FUNC_BEGIN(glCopyTextureSubImage2D, texture, level, xoffset, yoffset, x, y, width, height)
     glCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Copied 2D sub-image to texture %u at level %d with size (%d, %d) at offset (%d, %d)", texture, level,
@@ -1103,7 +1149,7 @@ void glCopyTextureSubImage2D(GLuint texture, GLint level, GLint xoffset, GLint y
 
 void glCopyTextureSubImage3D(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y,
                              GLsizei width, GLsizei height) {
-    TEXTURE_OP_FUNC_BEGIN(glCopyTextureSubImage3D)
+    TEXTURE_OP_FUNC_BEGIN(glCopyTextureSubImage3D, texture, level, xoffset, yoffset, zoffset, x, y, width, height)
     glCopyTexSubImage3D(target, level, xoffset, yoffset, zoffset, x, y, width, height);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Copied 3D sub-image to texture %u at level %d with size (%d, %d) at offset (%d, %d)", texture, level,
@@ -1111,49 +1157,49 @@ void glCopyTextureSubImage3D(GLuint texture, GLint level, GLint xoffset, GLint y
 }
 
 void glTextureParameterf(GLuint texture, GLenum pname, GLfloat param) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureParameterf)
+    TEXTURE_OP_FUNC_BEGIN(glTextureParameterf, texture, pname, param)
     glTexParameterf(target, pname, param);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set float parameter 0x%X for texture %u to %f", pname, texture, param);
 }
 
 void glTextureParameterfv(GLuint texture, GLenum pname, const GLfloat* param) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureParameterfv)
+    TEXTURE_OP_FUNC_BEGIN(glTextureParameterfv, texture, pname, param)
     glTexParameterfv(target, pname, param);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set float vector parameter 0x%X for texture %u", pname, texture);
 }
 
 void glTextureParameteri(GLuint texture, GLenum pname, GLint param) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureParameteri)
+    TEXTURE_OP_FUNC_BEGIN(glTextureParameteri, texture, pname, param)
     glTexParameteri(target, pname, param);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set integer parameter 0x%X for texture %u to %d", pname, texture, param);
 }
 
 void glTextureParameterIiv(GLuint texture, GLenum pname, const GLint* params) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureParameterIiv)
+    TEXTURE_OP_FUNC_BEGIN(glTextureParameterIiv, texture, pname, params)
     glTexParameterIiv(target, pname, params);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set integer vector parameter 0x%X for texture %u", pname, texture);
 }
 
 void glTextureParameterIuiv(GLuint texture, GLenum pname, const GLuint* params) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureParameterIuiv)
+    TEXTURE_OP_FUNC_BEGIN(glTextureParameterIuiv, texture, pname, params)
     glTexParameterIuiv(target, pname, params);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set unsigned integer vector parameter 0x%X for texture %u", pname, texture);
 }
 
 void glTextureParameteriv(GLuint texture, GLenum pname, const GLint* param) {
-    TEXTURE_OP_FUNC_BEGIN(glTextureParameteriv)
+    TEXTURE_OP_FUNC_BEGIN(glTextureParameteriv, texture, pname, param)
     glTexParameteriv(target, pname, param);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Set integer vector parameter 0x%X for texture %u", pname, texture);
 }
 
 void glGenerateTextureMipmap(GLuint texture) {
-    TEXTURE_OP_FUNC_BEGIN(glGenerateTextureMipmap)
+    TEXTURE_OP_FUNC_BEGIN(glGenerateTextureMipmap, texture)
     glGenerateMipmap(target);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Generated mipmap for texture %u", texture);
@@ -1161,14 +1207,14 @@ void glGenerateTextureMipmap(GLuint texture) {
 
 void glBindTextureUnit(GLuint unit, GLuint texture) {
     LOG()
+    MG_TRACE_ARGS(glBindTextureUnit, unit, texture)
     LOG_D("[DSA] glBindTextureUnit, unit: %u, texture: %u", unit, texture);
 
     if (unit >= GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS) {
         LOG_W("[DSA] Invalid parameters for glBindTextureUnit");
         // return;
     }
-    GLint prevUnit = 0;
-    glGetIntegerv(GL_ACTIVE_TEXTURE, &prevUnit);
+    GLenum prevUnit = GL_TEXTURE0 + gl_state->current_tex_unit;
     GLenum target = GetTexTarget(texture);
     glActiveTexture(GL_TEXTURE0 + unit);
     glBindTexture(target, texture);
@@ -1177,56 +1223,56 @@ void glBindTextureUnit(GLuint unit, GLuint texture) {
 }
 
 void glGetTextureImage(GLuint texture, GLint level, GLenum format, GLenum type, GLsizei bufSize, void* pixels) {
-    TEXTURE_OP_FUNC_BEGIN(glGetTextureImage)
+    TEXTURE_OP_FUNC_BEGIN(glGetTextureImage, texture, level, format, type, bufSize, pixels)
     glGetTexImage(target, level, format, type, pixels);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Retrieved texture image from texture %u at level %d", texture, level);
 }
 
 void glGetCompressedTextureImage(GLuint texture, GLint level, GLsizei bufSize, void* pixels) {
-    TEXTURE_OP_FUNC_BEGIN(glGetCompressedTextureImage)
+    TEXTURE_OP_FUNC_BEGIN(glGetCompressedTextureImage, texture, level, bufSize, pixels)
     glGetCompressedTexImage(target, level, pixels);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Retrieved compressed texture image from texture %u at level %d", texture, level);
 }
 
 void glGetTextureLevelParameterfv(GLuint texture, GLint level, GLenum pname, GLfloat* params) {
-    TEXTURE_OP_FUNC_BEGIN(glGetTextureLevelParameterfv)
+    TEXTURE_OP_FUNC_BEGIN(glGetTextureLevelParameterfv, texture, level, pname, params)
     glGetTexLevelParameterfv(target, level, pname, params);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Retrieved texture level parameter 0x%X for texture %u at level %d", pname, texture, level);
 }
 
 void glGetTextureLevelParameteriv(GLuint texture, GLint level, GLenum pname, GLint* params) {
-    TEXTURE_OP_FUNC_BEGIN(glGetTextureLevelParameteriv)
+    TEXTURE_OP_FUNC_BEGIN(glGetTextureLevelParameteriv, texture, level, pname, params)
     glGetTexLevelParameteriv(target, level, pname, params);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Retrieved texture level parameter 0x%X for texture %u at level %d", pname, texture, level);
 }
 
 void glGetTextureParameterfv(GLuint texture, GLenum pname, GLfloat* params) {
-    TEXTURE_OP_FUNC_BEGIN(glGetTextureParameterfv)
+    TEXTURE_OP_FUNC_BEGIN(glGetTextureParameterfv, texture, pname, params)
     glGetTexParameterfv(target, pname, params);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Retrieved texture parameter 0x%X for texture %u", pname, texture);
 }
 
 void glGetTextureParameterIiv(GLuint texture, GLenum pname, GLint* params) {
-    TEXTURE_OP_FUNC_BEGIN(glGetTextureParameterIiv)
+    TEXTURE_OP_FUNC_BEGIN(glGetTextureParameterIiv, texture, pname, params)
     glGetTexParameterIiv(target, pname, params);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Retrieved integer texture parameter 0x%X for texture %u", pname, texture);
 }
 
 void glGetTextureParameterIuiv(GLuint texture, GLenum pname, GLuint* params) {
-    TEXTURE_OP_FUNC_BEGIN(glGetTextureParameterIuiv)
+    TEXTURE_OP_FUNC_BEGIN(glGetTextureParameterIuiv, texture, pname, params)
     glGetTexParameterIuiv(target, pname, params);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Retrieved unsigned integer texture parameter 0x%X for texture %u", pname, texture);
 }
 
 void glGetTextureParameteriv(GLuint texture, GLenum pname, GLint* params) {
-    TEXTURE_OP_FUNC_BEGIN(glGetTextureParameteriv)
+    TEXTURE_OP_FUNC_BEGIN(glGetTextureParameteriv, texture, pname, params)
     glGetTexParameteriv(target, pname, params);
     TEXTURE_OP_FUNC_END
     LOG_D("[DSA] Retrieved integer texture parameter 0x%X for texture %u", pname, texture);
@@ -1258,6 +1304,7 @@ void restoreTemporaryVertexArrayBinding() {
 
 void glCreateVertexArrays(GLsizei n, GLuint* arrays) {
     LOG()
+    MG_TRACE_ARGS(glCreateVertexArrays, n, arrays)
     LOG_D("[DSA] glCreateVertexArrays, n: %d, arrays: %p", n, arrays);
 
     if (n <= 0 || !arrays) {
@@ -1282,6 +1329,7 @@ void glCreateVertexArrays(GLsizei n, GLuint* arrays) {
 
 void glDisableVertexArrayAttrib(GLuint vaobj, GLuint index) {
     LOG()
+    MG_TRACE_ARGS(glDisableVertexArrayAttrib, vaobj, index)
     LOG_D("[DSA] glDisableVertexArrayAttrib, vaobj: %u, index: %u", vaobj, index);
 
     if (vaobj == 0 || index >= GL_MAX_VERTEX_ATTRIBS) {
@@ -1298,6 +1346,7 @@ void glDisableVertexArrayAttrib(GLuint vaobj, GLuint index) {
 
 void glEnableVertexArrayAttrib(GLuint vaobj, GLuint index) {
     LOG()
+    MG_TRACE_ARGS(glEnableVertexArrayAttrib, vaobj, index)
     LOG_D("[DSA] glEnableVertexArrayAttrib, vaobj: %u, index: %u", vaobj, index);
 
     if (vaobj == 0 || index >= GL_MAX_VERTEX_ATTRIBS) {
@@ -1314,6 +1363,7 @@ void glEnableVertexArrayAttrib(GLuint vaobj, GLuint index) {
 
 void glVertexArrayElementBuffer(GLuint vaobj, GLuint buffer) {
     LOG()
+    MG_TRACE_ARGS(glVertexArrayElementBuffer, vaobj, buffer)
     LOG_D("[DSA] glVertexArrayElementBuffer, vaobj: %u, buffer: %u", vaobj, buffer);
 
     if (vaobj == 0 || buffer == 0) {
@@ -1330,6 +1380,7 @@ void glVertexArrayElementBuffer(GLuint vaobj, GLuint buffer) {
 
 void glVertexArrayVertexBuffer(GLuint vaobj, GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride) {
     LOG()
+    MG_TRACE_ARGS(glVertexArrayVertexBuffer, vaobj, bindingindex, buffer, offset, stride)
     LOG_D("[DSA] glVertexArrayVertexBuffer, vaobj: %u, bindingindex: %u, buffer: %u, offset: %lld, stride: %d", vaobj,
           bindingindex, buffer, offset, stride);
 
@@ -1349,6 +1400,7 @@ void glVertexArrayVertexBuffer(GLuint vaobj, GLuint bindingindex, GLuint buffer,
 void glVertexArrayVertexBuffers(GLuint vaobj, GLuint first, GLsizei count, const GLuint* buffers,
                                 const GLintptr* offsets, const GLsizei* strides) {
     LOG()
+    MG_TRACE_ARGS(glVertexArrayVertexBuffers, vaobj, first, count, buffers, offsets, strides)
     LOG_D("[DSA] glVertexArrayVertexBuffers, vaobj: %u, first: %u, count: %d, buffers: %p, offsets: %p, strides: %p",
           vaobj, first, count, buffers, offsets, strides);
 
@@ -1367,6 +1419,7 @@ void glVertexArrayVertexBuffers(GLuint vaobj, GLuint first, GLsizei count, const
 void glVertexArrayAttribFormat(GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLboolean normalized,
                                GLuint relativeoffset) {
     LOG()
+    MG_TRACE_ARGS(glVertexArrayAttribFormat, vaobj, attribindex, size, type, normalized, relativeoffset)
     LOG_D("[DSA] glVertexArrayAttribFormat, vaobj: %u, attribindex: %u, size: %d, type: 0x%X, normalized: %d, "
           "relativeoffset: %u",
           vaobj, attribindex, size, type, normalized, relativeoffset);
@@ -1381,6 +1434,7 @@ void glVertexArrayAttribFormat(GLuint vaobj, GLuint attribindex, GLint size, GLe
 
 void glVertexArrayAttribIFormat(GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset) {
     LOG()
+    MG_TRACE_ARGS(glVertexArrayAttribIFormat, vaobj, attribindex, size, type, relativeoffset)
     LOG_D("[DSA] glVertexArrayAttribIFormat, vaobj: %u, attribindex: %u, size: %d, type: 0x%X, relativeoffset: %u",
           vaobj, attribindex, size, type, relativeoffset);
 
@@ -1399,6 +1453,7 @@ void glVertexArrayAttribIFormat(GLuint vaobj, GLuint attribindex, GLint size, GL
 
 void glVertexArrayAttribLFormat(GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset) {
     LOG()
+    MG_TRACE_ARGS(glVertexArrayAttribLFormat, vaobj, attribindex, size, type, relativeoffset)
     LOG_D("[DSA] glVertexArrayAttribLFormat, vaobj: %u, attribindex: %u, size: %d, type: 0x%X, relativeoffset: %u",
           vaobj, attribindex, size, type, relativeoffset);
 
@@ -1416,6 +1471,7 @@ void glVertexArrayAttribLFormat(GLuint vaobj, GLuint attribindex, GLint size, GL
 
 void glVertexArrayAttribBinding(GLuint vaobj, GLuint attribindex, GLuint bindingindex) {
     LOG()
+    MG_TRACE_ARGS(glVertexArrayAttribBinding, vaobj, attribindex, bindingindex)
     LOG_D("[DSA] glVertexArrayAttribBinding, vaobj: %u, attribindex: %u, bindingindex: %u", vaobj, attribindex,
           bindingindex);
 
@@ -1434,6 +1490,7 @@ void glVertexArrayAttribBinding(GLuint vaobj, GLuint attribindex, GLuint binding
 
 void glVertexArrayBindingDivisor(GLuint vaobj, GLuint bindingindex, GLuint divisor) {
     LOG()
+    MG_TRACE_ARGS(glVertexArrayBindingDivisor, vaobj, bindingindex, divisor)
     LOG_D("[DSA] glVertexArrayBindingDivisor, vaobj: %u, bindingindex: %u, divisor: %u", vaobj, bindingindex, divisor);
 
     if (vaobj == 0 || bindingindex >= GL_MAX_VERTEX_ATTRIB_BINDINGS) {
@@ -1451,6 +1508,7 @@ void glVertexArrayBindingDivisor(GLuint vaobj, GLuint bindingindex, GLuint divis
 
 void glGetVertexArrayiv(GLuint vaobj, GLenum pname, GLint* param) {
     LOG()
+    MG_TRACE_ARGS(glGetVertexArrayiv, vaobj, pname, param)
     LOG_D("[DSA] glGetVertexArrayiv, vaobj: %u, pname: 0x%X, param: %p", vaobj, pname, param);
 
     if (vaobj == 0 || !param) {
@@ -1474,6 +1532,7 @@ void glGetVertexArrayiv(GLuint vaobj, GLenum pname, GLint* param) {
 
 void glGetVertexArrayIndexediv(GLuint vaobj, GLuint index, GLenum pname, GLint* param) {
     LOG()
+    MG_TRACE_ARGS(glGetVertexArrayIndexediv, vaobj, index, pname, param)
     LOG_D("[DSA] glGetVertexArrayIndexediv, vaobj: %u, index: %u, pname: 0x%X, param: %p", vaobj, index, pname, param);
 
     if (vaobj == 0 || index >= GL_MAX_VERTEX_ATTRIBS || !param) {
@@ -1491,6 +1550,7 @@ void glGetVertexArrayIndexediv(GLuint vaobj, GLuint index, GLenum pname, GLint*
 
 void glGetVertexArrayIndexed64iv(GLuint vaobj, GLuint index, GLenum pname, GLint64* param) {
     LOG()
+    MG_TRACE_ARGS(glGetVertexArrayIndexed64iv, vaobj, index, pname, param)
     LOG_D("[DSA] glGetVertexArrayIndexed64iv, vaobj: %u, index: %u, pname: 0x%X, param: %p", vaobj, index, pname,
           param);
 
@@ -1510,6 +1570,7 @@ void glGetVertexArrayIndexed64iv(GLuint vaobj, GLuint index, GLenum pname, GLint
 // sampler
 void glCreateSamplers(GLsizei n, GLuint* samplers) {
     LOG()
+    MG_TRACE_ARGS(glCreateSamplers, n, samplers)
     LOG_D("[DSA] glCreateSamplers, n: %d, samplers: %p", n, samplers);
 
     if (n <= 0 || !samplers) {
@@ -1539,6 +1600,7 @@ void glCreateSamplers(GLsizei n, GLuint* samplers) {
 // program pipeline
 void glCreateProgramPipelines(GLsizei n, GLuint* pipelines) {
     LOG()
+    MG_TRACE_ARGS(glCreateProgramPipelines, n, pipelines)
     LOG_D("[DSA] glCreateProgramPipelines, n: %d, pipelines: %p", n, pipelines);
 
     if (n <= 0 || !pipelines) {
@@ -1568,6 +1630,7 @@ void glCreateProgramPipelines(GLsizei n, GLuint* pipelines) {
 // query
 void glCreateQueries(GLenum target, GLsizei n, GLuint* ids) {
     LOG()
+    MG_TRACE_ARGS(glCreateQueries, target, n, ids)
     LOG_D("[DSA] glCreateQueries, target: 0x%X, n: %d, ids: %p", target, n, ids);
     if (n <= 0 || !ids) // return;
         glGenQueries(n, ids);
@@ -1589,6 +1652,7 @@ static void popQueryBufferBinding(GLint prev) {
 
 void glGetQueryBufferObjectiv(GLuint id, GLuint buffer, GLenum pname, GLintptr offset) {
     LOG()
+    MG_TRACE_ARGS(glGetQueryBufferObjectiv, id, buffer, pname, offset)
     LOG_D("[DSA] glGetQueryBufferObjectiv, id: %u, buffer: %u, pname: 0x%X, offset: %lld", id, buffer, pname, offset);
     assert(pname == GL_QUERY_RESULT || pname == GL_QUERY_RESULT_AVAILABLE);
     GLint prev = pushQueryBufferBinding(buffer);
@@ -1601,6 +1665,7 @@ void glGetQueryBufferObjectiv(GLuint id, GLuint buffer, GLenum pname, GLintptr o
 
 void glGetQueryBufferObjectuiv(GLuint id, GLuint buffer, GLenum pname, GLintptr offset) {
     LOG()
+    MG_TRACE_ARGS(glGetQueryBufferObjectuiv, id, buffer, pname, offset)
     LOG_D("[DSA] glGetQueryBufferObjectuiv, id: %u, buffer: %u, pname: 0x%X, offset: %lld", id, buffer, pname, offset);
     assert(pname == GL_QUERY_RESULT || pname == GL_QUERY_RESULT_AVAILABLE);
     GLint prev = pushQueryBufferBinding(buffer);
@@ -1613,6 +1678,7 @@ void glGetQueryBufferObjectuiv(GLuint id, GLuint buffer, GLenum pname, GLintptr
 
 void glGetQueryBufferObjecti64v(GLuint id, GLuint buffer, GLenum pname, GLintptr offset) {
     LOG()
+    MG_TRACE_ARGS(glGetQueryBufferObjecti64v, id, buffer, pname, offset)
     LOG_D("[DSA] glGetQueryBufferObjecti64v, id: %u, buffer: %u, pname: 0x%X, offset: %lld", id, buffer, pname, offset);
     assert(pname == GL_QUERY_RESULT || pname == GL_QUERY_RESULT_AVAILABLE);
     GLint prev = pushQueryBufferBinding(buffer);
@@ -1625,6 +1691,7 @@ void glGetQueryBufferObjecti64v(GLuint id, GLuint buffer, GLenum pname, GLintptr
 
 void glGetQueryBufferObjectui64v(GLuint id, GLuint buffer, GLenum pname, GLintptr offset) {
     LOG()
+    MG_TRACE_ARGS(glGetQueryBufferObjectui64v, id, buffer, pname, offset)
     LOG_D("[DSA] glGetQueryBufferObjectui64v, id: %u, buffer: %u, pname: 0x%X, offset: %lld", id, buffer, pname,
           offset);
     assert(pname == GL_QUERY_RESULT || pname == GL_QUERY_RESULT_AVAILABLE);
@@ -1665,6 +1732,7 @@ static void popXFB() {
 
 GLAPI void glCreateTransformFeedbacks(GLsizei n, GLuint* ids) {
     LOG();
+    MG_TRACE_ARGS(glCreateTransformFeedbacks, n, ids)
     LOG_D("[DSA] glCreateTransformFeedbacks, n=%d, ids=%p", n, ids);
     if (n <= 0 || !ids) {
         LOG_W("[DSA] Invalid parameters for glCreateTransformFeedbacks");
@@ -1677,6 +1745,7 @@ GLAPI void glCreateTransformFeedbacks(GLsizei n, GLuint* ids) {
 
 GLAPI void glTransformFeedbackBufferBase(GLuint xfb, GLuint index, GLuint buffer) {
     LOG();
+    MG_TRACE_ARGS(glTransformFeedbackBufferBase, xfb, index, buffer)
     LOG_D("[DSA] glTransformFeedbackBufferBase, xfb=%u, index=%u, buffer=%u", xfb, index, buffer);
     if (xfb == 0 || index >= (GLuint)GL_MAX_TRANSFORM_FEEDBACK_BUFFERS || buffer == 0) {
         LOG_W("[DSA] Invalid parameters for glTransformFeedbackBufferBase");
@@ -1691,6 +1760,7 @@ GLAPI void glTransformFeedbackBufferBase(GLuint xfb, GLuint index, GLuint buffer
 
 GLAPI void glTransformFeedbackBufferRange(GLuint xfb, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
     LOG();
+    MG_TRACE_ARGS(glTransformFeedbackBufferRange, xfb, index, buffer, offset, size)
     LOG_D("[DSA] glTransformFeedbackBufferRange, xfb=%u, index=%u, buffer=%u, offset=%lld, size=%lld", xfb, index,
           buffer, offset, size);
     if (xfb == 0 || index >= (GLuint)GL_MAX_TRANSFORM_FEEDBACK_BUFFERS || buffer == 0 || offset < 0 || size <= 0) {
@@ -1706,6 +1776,7 @@ GLAPI void glTransformFeedbackBufferRange(GLuint xfb, GLuint index, GLuint buffe
 
 GLAPI void glGetTransformFeedbackiv(GLuint xfb, GLenum pname, GLint* param) {
     LOG();
+    MG_TRACE_ARGS(glGetTransformFeedbackiv, xfb, pname, param)
     LOG_D("[DSA] glGetTransformFeedbackiv, xfb=%u, pname=0x%X, param=%p", xfb, pname, param);
     if (xfb == 0 || !param) {
         LOG_W("[DSA] Invalid parameters for glGetTransformFeedbackiv");
@@ -1720,6 +1791,7 @@ GLAPI void glGetTransformFeedbackiv(GLuint xfb, GLenum pname, GLint* param) {
 
 GLAPI void glGetTransformFeedbacki_v(GLuint xfb, GLenum pname, GLuint index, GLint* param) {
     LOG();
+    MG_TRACE_ARGS(glGetTransformFeedbacki_v, xfb, pname, index, param)
     LOG_D("[DSA] glGetTransformFeedbacki_v, xfb=%u, pname=0x%X, index=%u, param=%p", xfb, pname, index, param);
     if (xfb == 0 || index >= (GLuint)GL_MAX_TRANSFORM_FEEDBACK_BUFFERS || !param) {
         LOG_W("[DSA] Invalid parameters for glGetTransformFeedbacki_v");
@@ -1734,6 +1806,7 @@ GLAPI void glGetTransformFeedbacki_v(GLuint xfb, GLenum pname, GLuint index, GLi
 
 GLAPI void glGetTransformFeedbacki64_v(GLuint xfb, GLenum pname, GLuint index, GLint64* param) {
     LOG();
+    MG_TRACE_ARGS(glGetTransformFeedbacki64_v, xfb, pname, index, param)
     LOG_D("[DSA] glGetTransformFeedbacki64_v, xfb=%u, pname=0x%X, index=%u, param=%p", xfb, pname, index, param);
     if (xfb == 0 || index >= (GLuint)GL_MAX_TRANSFORM_FEEDBACK_BUFFERS || !param) {
         LOG_W("[DSA] Invalid parameters for glGetTransformFeedbacki64_v");
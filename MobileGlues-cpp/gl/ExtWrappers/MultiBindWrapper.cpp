@@ -12,8 +12,9 @@
 #define DEBUG 0
 
 void glBindTextures(GLuint first, GLsizei count, const GLuint* textures) {
-    GLuint prevUnit;
-    glGetIntegerv(GL_ACTIVE_TEXTURE, reinterpret_cast<GLint*>(&prevUnit));
+    LOG()
+    MG_TRACE_ARGS(glBindTextures, first, count, textures)
+    GLenum prevUnit = GL_TEXTURE0 + gl_state->current_tex_unit;
     for (GLsizei i = 0; i < count; ++i) {
         GLenum target = ConvertTextureTargetToGLEnum(mgGetTexObjectByID(textures[i])->target);
         glActiveTexture(GL_TEXTURE0 + first + i);
@@ -23,12 +24,16 @@ void glBindTextures(GLuint first, GLsizei count, const GLuint* textures) {
 }
 
 void glBindSamplers(GLuint first, GLsizei count, const GLuint* samplers) {
+    LOG()
+    MG_TRACE_ARGS(glBindSamplers, first, count, samplers)
     for (GLsizei i = 0; i < count; ++i) {
         glBindSampler(first + i, samplers[i]);
     }
 }
 
 void glBindImageTextures(GLuint first, GLsizei count, const GLuint* textures) {
+    LOG()
+    MG_TRACE_ARGS(glBindImageTextures, first, count, textures)
     for (int i = 0; i < count; i++) {
         if (textures == nullptr || textures[i] == 0) {
             glBindImageTexture(first + i, 0, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R8);
@@ -41,6 +46,8 @@ void glBindImageTextures(GLuint first, GLsizei count, const GLuint* textures) {
 
 void glBindVertexBuffers(GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets,
                          const GLsizei* strides) {
+    LOG()
+    MG_TRACE_ARGS(glBindVertexBuffers, first, count, buffers, offsets, strides)
     for (GLsizei i = 0; i < count; ++i) {
         glBindVertexBuffer(first + i, buffers[i], offsets[i], strides[i]);
     }
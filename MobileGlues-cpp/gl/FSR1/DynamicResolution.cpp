@@ -0,0 +1,70 @@
+// MobileGlues - gl/FSR1/DynamicResolution.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+DynamicResolutionController::DynamicResolutionController(const DynamicResolutionConfig& config)
+    : m_config(config), m_scale(config.max_scale) {}
+
+void DynamicResolutionController::reset() {
+    m_scale = m_config.max_scale;
+    m_smoothed_ms = 0.0f;
+    m_over_frames = 0;
+    m_under_frames = 0;
+    m_cooldown = 0;
+}
+
+float DynamicResolutionController::clamp_scale(float scale) const {
+    // Snap to the step grid so the same load always lands on the same size
+    scale = std::round(scale / m_config.step) * m_config.step;
+    return std::clamp(scale, m_config.min_scale, m_config.max_scale);
+}
+
+float DynamicResolutionController::update(float frame_ms) {
+    if (!(frame_ms > 0.0f)) return m_scale;
+
+    if (m_cooldown > 0) {
+        --m_cooldown;
+        return m_scale;
+    }
+    if (m_smoothed_ms > 0.0f) {
+        frame_ms = std::min(frame_ms, m_smoothed_ms * m_config.spike_limit);
+        m_smoothed_ms += (frame_ms - m_smoothed_ms) * m_config.smoothing;
+    } else {
+        m_smoothed_ms = frame_ms;
+    }
+
+    const float target = m_config.target_frame_ms;
+    if (m_smoothed_ms > target * m_config.upper_band) {
+        m_under_frames = 0;
+        if (++m_over_frames < m_config.down_frames) return m_scale;
+        float scale = m_scale * std::sqrt(target / m_smoothed_ms);
+        scale = clamp_scale(std::min(scale, m_scale - m_config.step));
+        m_over_frames = 0;
+        if (scale == m_scale) return m_scale;
+        m_scale = scale;
+    } else if (m_smoothed_ms < target * m_config.lower_band) {
+        m_over_frames = 0;
+        if (++m_under_frames < m_config.up_frames) return m_scale;
+        float scale = clamp_scale(m_scale + m_config.step);
+        m_under_frames = 0;
+        if (scale == m_scale) return m_scale;
+        m_scale = scale;
+    } else {
+        m_over_frames = 0;
+        m_under_frames = 0;
+        return m_scale;
+    }
+
+    // Frame times measured so far belong to the old size
+    m_cooldown = m_config.cooldown_frames;
+    m_smoothed_ms = 0.0f;
+    return m_scale;
+}
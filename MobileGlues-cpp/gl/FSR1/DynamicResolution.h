@@ -0,0 +1,62 @@
+// MobileGlues - gl/FSR1/DynamicResolution.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_DYNAMIC_RESOLUTION_H
+#define MOBILEGLUES_DYNAMIC_RESOLUTION_H
+
+struct DynamicResolutionConfig {
+    // Fraction of the window size rendered, per axis
+    float min_scale = 0.5f;
+    float max_scale = 1.0f;
+    float target_frame_ms = 1000.0f / 60.0f;
+    // Smallest change of the scale, also the step taken when scaling up
+    float step = 0.05f;
+    // The scale only moves once the smoothed frame time has left
+    // [target * lower_band, target * upper_band] for long enough
+    float lower_band = 0.8f;
+    float upper_band = 1.05f;
+    int down_frames = 5;
+    int up_frames = 30;
+    // Samples ignored after a change while the new size takes effect
+    int cooldown_frames = 10;
+    // Weight of a new sample in the smoothed frame time
+    float smoothing = 0.2f;
+    // Samples are clamped to this multiple of the smoothed frame time, so
+    // a single hitch (a GC pause, a chunk load) cannot hold the average
+    // over the band for down_frames on its own
+    float spike_limit = 2.0f;
+};
+
+// Picks the render scale from measured GPU frame times. Frame time is taken
+// to be proportional to the pixel count, so a frame over budget scales down
+// by the square root of the excess at once, while headroom is only claimed
+// one step at a time. The dead band and the frame counts keep the scale
+// from flickering between two sizes. Deterministic and free of GL calls.
+class DynamicResolutionController {
+public:
+    explicit DynamicResolutionController(const DynamicResolutionConfig& config = DynamicResolutionConfig());
+
+    // Feeds one GPU frame time and returns the scale for the next frames
+    float update(float frame_ms);
+    void reset();
+
+    float scale() const { return m_scale; }
+    float smoothed_frame_ms() const { return m_smoothed_ms; }
+    const DynamicResolutionConfig& config() const { return m_config; }
+
+private:
+    float clamp_scale(float scale) const;
+
+    DynamicResolutionConfig m_config;
+    float m_scale;
+    float m_smoothed_ms = 0.0f;
+    int m_over_frames = 0;
+    int m_under_frames = 0;
+    int m_cooldown = 0;
+};
+
+#endif // MOBILEGLUES_DYNAMIC_RESOLUTION_H
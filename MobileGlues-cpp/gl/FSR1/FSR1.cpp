@@ -6,54 +6,35 @@
 // End of Source File Header
 #include "FSR1.h"
 #include "FSRShaderSource.h"
+#include "DynamicResolution.h"
+#include "../immediate.h"
 #include "../../config/settings.h"
+#include "../state.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 #define DEBUG 0
 
-struct GLStateGuard {
-    GLint prevProgram;
-    GLint prevVAO;
-    GLint prevArrayBuffer;
-    GLint prevActiveTexture;
-    GLint prevTexture;
-    // GLint prevViewport[4];
-    GLint prevReadFBO;
-    GLint prevDrawFBO;
-    GLint prevRenderbuffer;
-
-    GLStateGuard() {
-        GLES.glGetIntegerv(GL_CURRENT_PROGRAM, &prevProgram);
-        GLES.glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &prevVAO);
-        GLES.glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &prevArrayBuffer);
-        GLES.glGetIntegerv(GL_ACTIVE_TEXTURE, &prevActiveTexture);
-        GLES.glActiveTexture(prevActiveTexture);
-        GLES.glGetIntegerv(GL_TEXTURE_BINDING_2D, &prevTexture);
-        // GLES.glGetIntegerv(GL_VIEWPORT, prevViewport);
-        GLES.glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFBO);
-        GLES.glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDrawFBO);
-        GLES.glGetIntegerv(GL_RENDERBUFFER_BINDING, &prevRenderbuffer);
-    }
+#ifndef GL_TIMESTAMP_EXT
+#define GL_TIMESTAMP_EXT 0x8E28
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
 
-    ~GLStateGuard() {
-        GLES.glUseProgram(prevProgram);
-        GLES.glBindVertexArray(prevVAO);
-        GLES.glBindBuffer(GL_ARRAY_BUFFER, prevArrayBuffer);
-        GLES.glActiveTexture(prevActiveTexture);
-        GLES.glBindTexture(GL_TEXTURE_2D, prevTexture);
-        // GLES.glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
-        GLES.glBindRenderbuffer(GL_RENDERBUFFER, prevRenderbuffer);
-        GLES.glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFBO);
-        GLES.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFBO);
-    }
-};
+// Everything the FSR passes touch, restored from the state shadow on exit
+static constexpr GLbitfield kFSRStateScope = STATE_SCOPE_PROGRAM | STATE_SCOPE_VERTEX_ARRAY | STATE_SCOPE_ARRAY_BUFFER |
+                                             STATE_SCOPE_TEXTURE | STATE_SCOPE_FRAMEBUFFER | STATE_SCOPE_RENDERBUFFER;
 
 namespace FSR1_Context {
     GLuint g_renderFBO = 0;
     GLuint g_renderTexture = 0;
     GLuint g_depthStencilRBO = 0;
-    GLuint g_quadVAO = 0;
-    GLuint g_quadVBO = 0;
-    GLuint g_fsrProgram = 0;
+    GLuint g_triangleVAO = 0;
+    GLuint g_easuProgram = 0;
+    GLuint g_rcasProgram = 0;
 
     GLuint g_targetFBO = 0;
     GLuint g_targetTexture = 0;
@@ -69,28 +50,268 @@ namespace FSR1_Context {
     bool g_resolutionChanged = false;
     GLsizei g_pendingWidth = 0;
     GLsizei g_pendingHeight = 0;
+    bool g_surfaceDirty = true;
+
+    float g_dynamicScale = 1.0f;
 } // namespace FSR1_Context
 
-void CalculateTargetResolution(FSR1_Quality_Preset preset, int renderWidth, int renderHeight, int* targetWidth,
-                               int* targetHeight) {
-    float scale;
+namespace {
+    struct EasuUniforms {
+        GLint inputTex = -1;
+        GLint con[4] = {-1, -1, -1, -1};
+    } g_easuUniforms;
+
+    struct RcasUniforms {
+        GLint inputTex = -1;
+        GLint con = -1;
+    } g_rcasUniforms;
+
+    // Whether the constants in the programs are stale after a resize
+    bool g_constantsDirty = true;
+
+    // Frames in flight whose GPU time can be outstanding at once
+    constexpr int kFrameTimerSlots = 4;
+
+    // Measures the GPU time of each frame, from the end of one swap to the
+    // start of the FSR passes. EXT_disjoint_timer_query timestamps are used
+    // when present; they do not occupy the GL_TIME_ELAPSED target the
+    // application may use itself. Without them a fence per frame gives the
+    // wall-clock time until the frame completed. Fences are only polled at
+    // swaps, so the frame is taken to have completed when its fence was last
+    // seen unsignaled; taking the swap it was first seen signaled at would
+    // add up to a whole frame interval, and under vsync every frame would
+    // look twice as long as it is.
+    class FrameTimer {
+    public:
+        void init() {
+            m_queries = g_gles_caps.GL_EXT_disjoint_timer_query && GLES.glQueryCounterEXT &&
+                        GLES.glGetQueryObjecti64vEXT;
+            if (m_queries) GLES.glGenQueries(2 * kFrameTimerSlots, &m_timestamps[0][0]);
+            LOG_D("FSR1 frame timer: %s", m_queries ? "timestamp queries" : "fences")
+        }
+
+        void begin_frame() {
+            Slot& slot = m_slots[m_frame % kFrameTimerSlots];
+            discard(slot);
+            if (m_queries)
+                GLES.glQueryCounterEXT(m_timestamps[m_frame % kFrameTimerSlots][0], GL_TIMESTAMP_EXT);
+            else
+                slot.start = std::chrono::steady_clock::now();
+            slot.began = true;
+        }
+
+        void end_frame() {
+            Slot& slot = m_slots[m_frame % kFrameTimerSlots];
+            if (!slot.began) return;
+            if (m_queries)
+                GLES.glQueryCounterEXT(m_timestamps[m_frame % kFrameTimerSlots][1], GL_TIMESTAMP_EXT);
+            else {
+                slot.fence = GLES.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                slot.unsignaled = std::chrono::steady_clock::now();
+            }
+            slot.pending = true;
+            ++m_frame;
+        }
+
+        // Returns the time of the oldest frame that finished since the last
+        // call, or a negative value if none did
+        float collect() {
+            for (int i = 0; i < kFrameTimerSlots; ++i) {
+                const int index = (m_frame + i) % kFrameTimerSlots;
+                Slot& slot = m_slots[index];
+                if (!slot.pending) continue;
+                float ms = m_queries ? read_queries(index) : read_fence(slot);
+                if (ms == 0.0f) return -1.0f;
+                slot.pending = false;
+                slot.began = false;
+                if (ms > 0.0f) return ms;
+            }
+            return -1.0f;
+        }
+
+    private:
+        struct Slot {
+            bool began = false;
+            bool pending = false;
+            GLsync fence = nullptr;
+            std::chrono::steady_clock::time_point start;
+            // Last time the fence was known not to have signaled yet
+            std::chrono::steady_clock::time_point unsignaled;
+        };
+
+        // 0 while the result is not ready, negative if it is unusable
+        float read_queries(int index) {
+            GLuint available = 0;
+            GLES.glGetQueryObjectuiv(m_timestamps[index][1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) return 0.0f;
+            GLint disjoint = 0;
+            GLES.glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+            if (disjoint) return -1.0f;
+            GLint64 start = 0, end = 0;
+            GLES.glGetQueryObjecti64vEXT(m_timestamps[index][0], GL_QUERY_RESULT, &start);
+            GLES.glGetQueryObjecti64vEXT(m_timestamps[index][1], GL_QUERY_RESULT, &end);
+            return end > start ? (float)(end - start) / 1.0e6f : -1.0f;
+        }
+
+        float read_fence(Slot& slot) {
+            const auto now = std::chrono::steady_clock::now();
+            GLenum status = GLES.glClientWaitSync(slot.fence, 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED) {
+                slot.unsignaled = now;
+                return 0.0f;
+            }
+            GLES.glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            if (status == GL_WAIT_FAILED) return -1.0f;
+            std::chrono::duration<float, std::milli> elapsed = slot.unsignaled - slot.start;
+            return elapsed.count() > 0.0f ? elapsed.count() : -1.0f;
+        }
+
+        void discard(Slot& slot) {
+            if (slot.fence) GLES.glDeleteSync(slot.fence);
+            slot = Slot();
+        }
+
+        bool m_queries = false;
+        GLuint m_timestamps[kFrameTimerSlots][2] = {};
+        Slot m_slots[kFrameTimerSlots];
+        uint32_t m_frame = 0;
+    };
+
+    FrameTimer g_frameTimer;
+    DynamicResolutionController g_drsController;
+    bool g_drsEnabled = false;
+    // Whether the driver's viewport and scissor are currently scaled
+    bool g_rectsScaled = false;
+
+    // Maps a rectangle of the application's default framebuffer into the
+    // part of the render target drawn at the dynamic scale
+    void ScaleRect(GLint& x, GLint& y, GLsizei& w, GLsizei& h) {
+        const float scale = FSR1_Context::g_dynamicScale;
+        GLint x0 = (GLint)lroundf(x * scale), y0 = (GLint)lroundf(y * scale);
+        GLint x1 = (GLint)lroundf((x + w) * scale), y1 = (GLint)lroundf((y + h) * scale);
+        x = x0;
+        y = y0;
+        w = x1 - x0;
+        h = y1 - y0;
+    }
+
+    bool DrawingToRenderTarget() {
+        return g_drsEnabled && FSR1_Context::g_renderFBO && gl_state->current_draw_fbo == FSR1_Context::g_renderFBO;
+    }
+
+    bool ReadingFromRenderTarget() {
+        return g_drsEnabled && FSR1_Context::g_renderFBO && gl_state->current_read_fbo == FSR1_Context::g_renderFBO;
+    }
+
+    void ScaleCorners(GLint& x0, GLint& y0, GLint& x1, GLint& y1) {
+        const float scale = FSR1_Context::g_dynamicScale;
+        x0 = (GLint)lroundf(x0 * scale);
+        y0 = (GLint)lroundf(y0 * scale);
+        x1 = (GLint)lroundf(x1 * scale);
+        y1 = (GLint)lroundf(y1 * scale);
+    }
+
+    // Full-size copy of a part of the render target, for FSRReadScope
+    GLuint g_readFBO = 0;
+    GLuint g_readRBO = 0;
+    GLsizei g_readWidth = 0;
+    GLsizei g_readHeight = 0;
+
+    // Reissues the shadowed viewport and scissor with or without scaling
+    void ReapplyRects() {
+        g_rectsScaled = DrawingToRenderTarget();
+        if (gl_state->viewport_known) {
+            GLint x = gl_state->viewport[0], y = gl_state->viewport[1];
+            GLsizei w = gl_state->viewport[2], h = gl_state->viewport[3];
+            if (g_rectsScaled) ScaleRect(x, y, w, h);
+            GLES.glViewport(x, y, w, h);
+        }
+        if (gl_state->scissor_known) {
+            GLint x = gl_state->scissor_box[0], y = gl_state->scissor_box[1];
+            GLsizei w = gl_state->scissor_box[2], h = gl_state->scissor_box[3];
+            if (g_rectsScaled) ScaleRect(x, y, w, h);
+            GLES.glScissor(x, y, w, h);
+        }
+    }
+
+    uint32_t float_bits(float f) {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    // packHalf2x16 for one normal value; the RCAS scale stays in [0.25, 1]
+    uint32_t half_bits(float f) {
+        uint32_t bits = float_bits(f);
+        uint32_t sign = (bits >> 16) & 0x8000u;
+        int32_t exponent = (int32_t)((bits >> 23) & 0xffu) - 127 + 15;
+        uint32_t mantissa = bits & 0x7fffffu;
+        if (exponent <= 0) return sign;
+        if (exponent >= 31) return sign | 0x7c00u;
+        uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+        // Round to nearest even
+        if ((mantissa & 0x1fffu) > 0x1000u || ((mantissa & 0x1fffu) == 0x1000u && (half & 1u))) ++half;
+        return half;
+    }
+} // namespace
+
+void FsrEasuConstants(uint32_t con[16], float viewportWidth, float viewportHeight, float inputWidth,
+                      float inputHeight, float outputWidth, float outputHeight) {
+    // Output pixel position to a pixel position in the viewport
+    con[0] = float_bits(viewportWidth * (1.0f / outputWidth));
+    con[1] = float_bits(viewportHeight * (1.0f / outputHeight));
+    con[2] = float_bits(0.5f * viewportWidth * (1.0f / outputWidth) - 0.5f);
+    con[3] = float_bits(0.5f * viewportHeight * (1.0f / outputHeight) - 0.5f);
+    // Viewport pixel position to normalized image space, and the gather
+    // offsets of the 12-tap filter
+    const float rcpWidth = 1.0f / inputWidth;
+    const float rcpHeight = 1.0f / inputHeight;
+    con[4] = float_bits(rcpWidth);
+    con[5] = float_bits(rcpHeight);
+    con[6] = float_bits(1.0f * rcpWidth);
+    con[7] = float_bits(-1.0f * rcpHeight);
+    con[8] = float_bits(-1.0f * rcpWidth);
+    con[9] = float_bits(2.0f * rcpHeight);
+    con[10] = float_bits(1.0f * rcpWidth);
+    con[11] = float_bits(2.0f * rcpHeight);
+    con[12] = float_bits(0.0f * rcpWidth);
+    con[13] = float_bits(4.0f * rcpHeight);
+    con[14] = 0;
+    con[15] = 0;
+}
+
+void FsrRcasConstants(uint32_t con[4], float sharpnessStops) {
+    const float sharpness = exp2f(-sharpnessStops);
+    con[0] = float_bits(sharpness);
+    con[1] = half_bits(sharpness) | (half_bits(sharpness) << 16);
+    con[2] = 0;
+    con[3] = 0;
+}
+
+float FsrSharpnessStops(int strength) {
+    return (float)(10 - strength) * 0.2f;
+}
+
+// Upscaling factor of a preset, per axis
+static float PresetScale(FSR1_Quality_Preset preset) {
     switch (preset) {
     case FSR1_Quality_Preset::UltraQuality:
-        scale = 1.3f;
-        break;
+        return 1.3f;
     case FSR1_Quality_Preset::Quality:
-        scale = 1.5f;
-        break;
+        return 1.5f;
     case FSR1_Quality_Preset::Balanced:
-        scale = 1.7f;
-        break;
+        return 1.7f;
     case FSR1_Quality_Preset::Performance:
-        scale = 2.0f;
-        break;
+        return 2.0f;
     default:
-        scale = 1.5f;
-        break;
+        return 1.5f;
     }
+}
+
+void CalculateTargetResolution(FSR1_Quality_Preset preset, int renderWidth, int renderHeight, int* targetWidth,
+                               int* targetHeight) {
+    float scale = PresetScale(preset);
 
     *targetWidth = static_cast<int>(renderWidth * scale);
     *targetHeight = static_cast<int>(renderHeight * scale);
@@ -103,23 +324,7 @@ void CalculateTargetResolution(FSR1_Quality_Preset preset, int renderWidth, int
 
 void CalculateRenderResolution(FSR1_Quality_Preset preset, int targetWidth, int targetHeight, int* renderWidth,
                                int* renderHeight) {
-    float scale;
-    switch (preset) {
-    case FSR1_Quality_Preset::UltraQuality:
-        scale = 1.3f;
-        break;
-    case FSR1_Quality_Preset::Quality:
-        scale = 1.5f;
-        break;
-    case FSR1_Quality_Preset::Balanced:
-        scale = 1.7f;
-        break;
-    case FSR1_Quality_Preset::Performance:
-        scale = 2.0f;
-        break;
-    default:
-        scale = 1.5f;
-    }
+    float scale = PresetScale(preset);
 
     *renderWidth = (int)(targetWidth / scale);
     *renderHeight = (int)(targetHeight / scale);
@@ -128,234 +333,271 @@ void CalculateRenderResolution(FSR1_Quality_Preset preset, int targetWidth, int
     *renderHeight = (*renderHeight + 1) & ~1;
 }
 
-GLuint CompileFSRShader() {
-    GLuint program = glCreateProgram();
-
-    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
-    LOG_D("Vertex shader source:\n%s", FSR_VSSource);
-    glShaderSource(vs, 1, &FSR_VSSource, nullptr);
-    glCompileShader(vs);
+static GLuint CompileFSRShader(GLenum type, const GLchar* const* sources, GLsizei count) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, count, sources, nullptr);
+    glCompileShader(shader);
 
     GLint status;
-    glGetShaderiv(vs, GL_COMPILE_STATUS, &status);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
     if (!status) {
         char log[512];
-        glGetShaderInfoLog(vs, 512, nullptr, log);
-        LOG_F("Vertex shader error: %s\n", log);
+        glGetShaderInfoLog(shader, 512, nullptr, log);
+        LOG_F("FSR1 %s shader error: %s\n", type == GL_VERTEX_SHADER ? "vertex" : "fragment", log);
+        glDeleteShader(shader);
         return 0;
     }
+    return shader;
+}
 
-    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
-    LOG_D("Fragment shader source:\n%s", FSR_FSSource);
-    glShaderSource(fs, 1, &FSR_FSSource, nullptr);
-    glCompileShader(fs);
-
-    glGetShaderiv(fs, GL_COMPILE_STATUS, &status);
-    if (!status) {
-        char log[512];
-        glGetShaderInfoLog(fs, 512, nullptr, log);
-        LOG_F("Fragment shader error: %s\n", log);
-        return 0;
-    }
+static GLuint LinkFSRProgram(GLuint vs, const char* header, const char* main) {
+    const GLchar* sources[] = {header, FSR_FSLibrary, main};
+    GLuint fs = CompileFSRShader(GL_FRAGMENT_SHADER, sources, 3);
+    if (!vs || !fs) return 0;
 
+    GLuint program = glCreateProgram();
     glAttachShader(program, vs);
     glAttachShader(program, fs);
     glLinkProgram(program);
+    glDeleteShader(fs);
 
+    GLint status;
     glGetProgramiv(program, GL_LINK_STATUS, &status);
     if (!status) {
         char log[512];
         glGetProgramInfoLog(program, 512, nullptr, log);
-        LOG_F("Program link error: %s\n", log);
+        LOG_F("FSR1 program link error: %s\n", log);
+        glDeleteProgram(program);
         return 0;
     }
-
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-
     return program;
 }
 
-void InitFullscreenQuad() {
-    GLStateGuard state;
-    const float quadVertices[] = {-1.0f, 1.0f, 0.0f, 1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 1.0f, -1.0f, 1.0f, 0.0f,
-
-                                  -1.0f, 1.0f, 0.0f, 1.0f, 1.0f,  -1.0f, 1.0f, 0.0f, 1.0f, 1.0f,  1.0f, 1.0f};
-
-    GLES.glGenVertexArrays(1, &FSR1_Context::g_quadVAO);
-    GLES.glGenBuffers(1, &FSR1_Context::g_quadVBO);
-
-    GLES.glBindVertexArray(FSR1_Context::g_quadVAO);
-    GLES.glBindBuffer(GL_ARRAY_BUFFER, FSR1_Context::g_quadVBO);
-
-    GLES.glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
-
-    GLES.glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    GLES.glEnableVertexAttribArray(0);
-
-    GLES.glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    GLES.glEnableVertexAttribArray(1);
-
-    GLES.glBindBuffer(GL_ARRAY_BUFFER, 0);
-    GLES.glBindVertexArray(0);
+static void CompileFSRPrograms() {
+    GLuint vs = CompileFSRShader(GL_VERTEX_SHADER, &FSR_VSSource, 1);
+    FSR1_Context::g_easuProgram = LinkFSRProgram(vs, FSR_EASU_FSHeader, FSR_EASU_FSMain);
+    FSR1_Context::g_rcasProgram = LinkFSRProgram(vs, FSR_RCAS_FSHeader, FSR_RCAS_FSMain);
+    if (vs) glDeleteShader(vs);
+
+    // Locations never change after linking, and the sampler units are fixed
+    if (GLuint program = FSR1_Context::g_easuProgram) {
+        g_easuUniforms.inputTex = glGetUniformLocation(program, "uInputTex");
+        static const char* conNames[] = {"uCon0", "uCon1", "uCon2", "uCon3"};
+        for (int i = 0; i < 4; ++i)
+            g_easuUniforms.con[i] = glGetUniformLocation(program, conNames[i]);
+        GLES.glUseProgram(program);
+        GLES.glUniform1i(g_easuUniforms.inputTex, 0);
+    }
+    if (GLuint program = FSR1_Context::g_rcasProgram) {
+        g_rcasUniforms.inputTex = glGetUniformLocation(program, "uInputTex");
+        g_rcasUniforms.con = glGetUniformLocation(program, "uCon");
+        GLES.glUseProgram(program);
+        GLES.glUniform1i(g_rcasUniforms.inputTex, 0);
+    }
 }
 
-bool fsrInitialized = false;
-void InitFSRResources() {
-    fsrInitialized = true;
-    GLStateGuard state;
-
-    FSR1_Context::g_fsrProgram = CompileFSRShader();
-
-    GLint inputTexLoc = glGetUniformLocation(FSR1_Context::g_fsrProgram, "uInputTex");
-    GLint const0Loc = glGetUniformLocation(FSR1_Context::g_fsrProgram, "uConst0");
-    GLint viewportSizeLoc = glGetUniformLocation(FSR1_Context::g_fsrProgram, "uViewportSize");
-
-    glUseProgram(FSR1_Context::g_fsrProgram);
-    glUniform1i(inputTexLoc, 0);
-    glUseProgram(0);
-
-    InitFullscreenQuad();
+static bool RcasEnabled() {
+    return global_settings.fsr1_sharpness > 0 && FSR1_Context::g_rcasProgram;
+}
 
-    GLES.glGenTextures(1, &FSR1_Context::g_renderTexture);
-    GLES.glBindTexture(GL_TEXTURE_2D, FSR1_Context::g_renderTexture);
-    GLES.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, FSR1_Context::g_renderWidth, FSR1_Context::g_renderHeight, 0, GL_RGBA,
-                      GL_UNSIGNED_BYTE, nullptr);
+static GLuint CreateFSRTexture(GLsizei width, GLsizei height) {
+    GLuint texture;
+    GLES.glGenTextures(1, &texture);
+    GLES.glBindTexture(GL_TEXTURE_2D, texture);
+    GLES.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    return texture;
+}
 
-    GLES.glGenRenderbuffers(1, &FSR1_Context::g_depthStencilRBO);
-    GLES.glBindRenderbuffer(GL_RENDERBUFFER, FSR1_Context::g_depthStencilRBO);
-    GLES.glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, FSR1_Context::g_renderWidth,
-                               FSR1_Context::g_renderHeight);
+// Creates the render target the application draws into in place of the
+// default framebuffer, and the intermediate target RCAS reads from
+static void CreateFSRTargets() {
+    using namespace FSR1_Context;
+    g_renderTexture = CreateFSRTexture(g_renderWidth, g_renderHeight);
+
+    GLES.glGenRenderbuffers(1, &g_depthStencilRBO);
+    GLES.glBindRenderbuffer(GL_RENDERBUFFER, g_depthStencilRBO);
+    GLES.glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, g_renderWidth, g_renderHeight);
+
+    GLES.glGenFramebuffers(1, &g_renderFBO);
+    GLES.glBindFramebuffer(GL_FRAMEBUFFER, g_renderFBO);
+    GLES.glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_renderTexture, 0);
+    GLES.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, g_depthStencilRBO);
+
+    if (RcasEnabled()) {
+        g_targetTexture = CreateFSRTexture(g_targetWidth, g_targetHeight);
+        GLES.glGenFramebuffers(1, &g_targetFBO);
+        GLES.glBindFramebuffer(GL_FRAMEBUFFER, g_targetFBO);
+        GLES.glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_targetTexture, 0);
+    }
 
-    GLES.glGenFramebuffers(1, &FSR1_Context::g_renderFBO);
-    GLES.glBindFramebuffer(GL_FRAMEBUFFER, FSR1_Context::g_renderFBO);
-    GLES.glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, FSR1_Context::g_renderTexture, 0);
-    GLES.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
-                                   FSR1_Context::g_depthStencilRBO);
-
-    GLES.glGenTextures(1, &FSR1_Context::g_targetTexture);
-    GLES.glBindTexture(GL_TEXTURE_2D, FSR1_Context::g_targetTexture);
-    GLES.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, FSR1_Context::g_targetWidth, FSR1_Context::g_targetHeight, 0, GL_RGBA,
-                      GL_UNSIGNED_BYTE, nullptr);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    g_constantsDirty = true;
+}
 
-    GLES.glGenFramebuffers(1, &FSR1_Context::g_targetFBO);
-    GLES.glBindFramebuffer(GL_FRAMEBUFFER, FSR1_Context::g_targetFBO);
-    GLES.glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, FSR1_Context::g_targetTexture, 0);
+static void DestroyFSRTargets() {
+    using namespace FSR1_Context;
+    if (g_readFBO) {
+        GLES.glDeleteFramebuffers(1, &g_readFBO);
+        GLES.glDeleteRenderbuffers(1, &g_readRBO);
+        g_readFBO = 0;
+        g_readRBO = 0;
+        g_readWidth = 0;
+        g_readHeight = 0;
+    }
+    GLES.glDeleteFramebuffers(1, &g_renderFBO);
+    GLES.glDeleteTextures(1, &g_renderTexture);
+    GLES.glDeleteRenderbuffers(1, &g_depthStencilRBO);
+    if (g_targetFBO) {
+        GLES.glDeleteFramebuffers(1, &g_targetFBO);
+        GLES.glDeleteTextures(1, &g_targetTexture);
+        g_targetFBO = 0;
+        g_targetTexture = 0;
+    }
+}
+
+bool fsrInitialized = false;
+void InitFSRResources() {
+    fsrInitialized = true;
+    StateScope state(kFSRStateScope);
+
+    CompileFSRPrograms();
+    GLES.glGenVertexArrays(1, &FSR1_Context::g_triangleVAO);
+    CreateFSRTargets();
+
+    if (global_settings.fsr1_target_fps > 0) {
+        // The preset's factor becomes the largest upscale the controller
+        // may fall back to
+        DynamicResolutionConfig config;
+        config.min_scale = 1.0f / PresetScale(global_settings.fsr1_setting);
+        config.target_frame_ms = 1000.0f / (float)global_settings.fsr1_target_fps;
+        g_drsController = DynamicResolutionController(config);
+        g_frameTimer.init();
+        g_frameTimer.begin_frame();
+        g_drsEnabled = true;
+    }
 
     GLES.glBindFramebuffer(GL_FRAMEBUFFER, FSR1_Context::g_renderFBO);
 }
 
-void RecreateFSRFBO() {
-    GLStateGuard state;
-    GLES.glDeleteFramebuffers(1, &FSR1_Context::g_renderFBO);
-    GLES.glDeleteTextures(1, &FSR1_Context::g_renderTexture);
-    GLES.glDeleteRenderbuffers(1, &FSR1_Context::g_depthStencilRBO);
-
-    GLES.glDeleteFramebuffers(1, &FSR1_Context::g_targetFBO);
-    GLES.glDeleteTextures(1, &FSR1_Context::g_targetTexture);
-
-    GLES.glGenTextures(1, &FSR1_Context::g_renderTexture);
-    GLES.glBindTexture(GL_TEXTURE_2D, FSR1_Context::g_renderTexture);
-    GLES.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, FSR1_Context::g_renderWidth, FSR1_Context::g_renderHeight, 0,
-                      GL_RGBA, GL_FLOAT, nullptr);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-    GLES.glGenRenderbuffers(1, &FSR1_Context::g_depthStencilRBO);
-    GLES.glBindRenderbuffer(GL_RENDERBUFFER, FSR1_Context::g_depthStencilRBO);
-    GLES.glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, FSR1_Context::g_renderWidth,
-                               FSR1_Context::g_renderHeight);
-    GLES.glGenFramebuffers(1, &FSR1_Context::g_renderFBO);
-    GLES.glBindFramebuffer(GL_FRAMEBUFFER, FSR1_Context::g_renderFBO);
-    GLES.glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, FSR1_Context::g_renderTexture, 0);
-    GLES.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
-                                   FSR1_Context::g_depthStencilRBO);
-
-    GLES.glGenTextures(1, &FSR1_Context::g_targetTexture);
-    GLES.glBindTexture(GL_TEXTURE_2D, FSR1_Context::g_targetTexture);
-    GLES.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, FSR1_Context::g_targetWidth, FSR1_Context::g_targetHeight, 0, GL_RGBA,
-                      GL_UNSIGNED_BYTE, nullptr);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+// Points the viewport at the whole default framebuffer, as the application
+// sees it, with the render target bound
+static void ResetFSRViewport() {
+    set_gl_state_viewport(0, 0, FSR1_Context::g_renderWidth, FSR1_Context::g_renderHeight);
+    if (g_drsEnabled) {
+        ReapplyRects();
+    } else {
+        GLES.glViewport(0, 0, FSR1_Context::g_renderWidth, FSR1_Context::g_renderHeight);
+    }
+}
 
-    GLES.glGenFramebuffers(1, &FSR1_Context::g_targetFBO);
-    GLES.glBindFramebuffer(GL_FRAMEBUFFER, FSR1_Context::g_targetFBO);
-    GLES.glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, FSR1_Context::g_targetTexture, 0);
+void RecreateFSRFBO() {
+    StateScope state(kFSRStateScope);
+    DestroyFSRTargets();
+    CreateFSRTargets();
 
     GLES.glBindFramebuffer(GL_FRAMEBUFFER, FSR1_Context::g_renderFBO);
-    GLES.glViewport(0, 0, FSR1_Context::g_renderWidth, FSR1_Context::g_renderHeight);
+    ResetFSRViewport();
 
     LOG_D("FSR1 resources recreated: render %dx%d, target %dx%d", FSR1_Context::g_renderWidth,
           FSR1_Context::g_renderHeight, FSR1_Context::g_targetWidth, FSR1_Context::g_targetHeight);
 }
 
-std::vector<std::pair<GLsizei, GLsizei>> g_viewportStack;
+static void UploadFSRConstants() {
+    using namespace FSR1_Context;
+    // With dynamic resolution only the scaled corner of the input holds
+    // the frame
+    GLint x = 0, y = 0;
+    GLsizei viewportWidth = g_renderWidth, viewportHeight = g_renderHeight;
+    if (g_drsEnabled) ScaleRect(x, y, viewportWidth, viewportHeight);
+    uint32_t easu[16];
+    FsrEasuConstants(easu, (float)viewportWidth, (float)viewportHeight, (float)g_renderWidth, (float)g_renderHeight,
+                     (float)g_targetWidth, (float)g_targetHeight);
+    GLES.glUseProgram(g_easuProgram);
+    for (int i = 0; i < 4; ++i)
+        GLES.glUniform4uiv(g_easuUniforms.con[i], 1, easu + 4 * i);
+
+    if (g_rcasProgram) {
+        uint32_t rcas[4];
+        FsrRcasConstants(rcas, FsrSharpnessStops(global_settings.fsr1_sharpness));
+        GLES.glUseProgram(g_rcasProgram);
+        GLES.glUniform4uiv(g_rcasUniforms.con, 1, rcas);
+    }
+    g_constantsDirty = false;
+}
+
+// Everything the passes change besides kFSRStateScope. The viewport is
+// reset to the render size afterwards, as before.
+static constexpr GLbitfield kFSRPassScope = kFSRStateScope | STATE_SCOPE_CAPS | STATE_SCOPE_COLOR_MASK;
 
 void ApplyFSR() {
-    GLStateGuard state;
+    using namespace FSR1_Context;
+    if (!g_easuProgram) return;
+    if (g_drsEnabled) g_frameTimer.end_frame();
+    StateScope state(kFSRPassScope);
 
-    GLES.glBindFramebuffer(GL_FRAMEBUFFER, FSR1_Context::g_targetFBO);
-    GLES.glViewport(0, 0, FSR1_Context::g_targetWidth, FSR1_Context::g_targetHeight);
-    GLES.glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    GLES.glClear(GL_COLOR_BUFFER_BIT);
+    if (g_constantsDirty) UploadFSRConstants();
 
-    GLES.glUseProgram(FSR1_Context::g_fsrProgram);
+    // Fixed-function state from the application must not affect the passes
+    for (GLenum cap : {GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_SCISSOR_TEST, GL_STENCIL_TEST,
+                       GL_RASTERIZER_DISCARD, GL_POLYGON_OFFSET_FILL, GL_SAMPLE_ALPHA_TO_COVERAGE})
+        GLES.glDisable(cap);
+    GLES.glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
+    GLES.glBindVertexArray(g_triangleVAO);
     GLES.glActiveTexture(GL_TEXTURE0);
-    GLES.glBindTexture(GL_TEXTURE_2D, FSR1_Context::g_renderTexture);
-
-    glm::vec4 const0 = {float(FSR1_Context::g_renderWidth) / FSR1_Context::g_targetWidth,
-                        float(FSR1_Context::g_renderHeight) / FSR1_Context::g_targetHeight,
-                        1.0f / FSR1_Context::g_targetWidth, 1.0f / FSR1_Context::g_targetHeight};
-
-    GLES.glUniform1i(glGetUniformLocation(FSR1_Context::g_fsrProgram, "uInputTex"), 0);
-    GLES.glUniform4fv(glGetUniformLocation(FSR1_Context::g_fsrProgram, "uConst0"), 1,
-                      reinterpret_cast<const GLfloat*>(&const0));
-
-    glm::vec2 viewportSize = {(float)FSR1_Context::g_renderWidth, (float)FSR1_Context::g_renderHeight};
-    GLES.glUniform2fv(glGetUniformLocation(FSR1_Context::g_fsrProgram, "uViewportSize"), 1,
-                      reinterpret_cast<const GLfloat*>(&viewportSize));
-
-    GLES.glBindVertexArray(FSR1_Context::g_quadVAO);
-    GLES.glDrawArrays(GL_TRIANGLES, 0, 6);
-    GLES.glBindVertexArray(0);
+    GLES.glViewport(0, 0, g_targetWidth, g_targetHeight);
+
+    // EASU upscales straight into the default framebuffer unless RCAS
+    // still has to sharpen the result
+    const bool rcas = RcasEnabled() && g_targetFBO;
+    GLES.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, rcas ? g_targetFBO : 0);
+    GLES.glUseProgram(g_easuProgram);
+    GLES.glBindTexture(GL_TEXTURE_2D, g_renderTexture);
+    GLES.glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    if (rcas) {
+        GLES.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        GLES.glUseProgram(g_rcasProgram);
+        GLES.glBindTexture(GL_TEXTURE_2D, g_targetTexture);
+        GLES.glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
 
-    GLES.glBindFramebuffer(GL_READ_FRAMEBUFFER, FSR1_Context::g_targetFBO);
-    GLES.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-    GLES.glBlitFramebuffer(0, 0, FSR1_Context::g_targetWidth, FSR1_Context::g_targetHeight, 0, 0,
-                           FSR1_Context::g_targetWidth, FSR1_Context::g_targetHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    GLES.glBindFramebuffer(GL_FRAMEBUFFER, g_renderFBO);
+    ResetFSRViewport();
+}
 
-    GLES.glBindFramebuffer(GL_FRAMEBUFFER, FSR1_Context::g_renderFBO);
-    GLES.glViewport(0, 0, FSR1_Context::g_renderWidth, FSR1_Context::g_renderHeight);
+// Feeds the frame time to the controller and rescales the next frame
+static void UpdateDynamicResolution() {
+    float frameMs = g_frameTimer.collect();
+    if (frameMs > 0.0f) {
+        float scale = g_drsController.update(frameMs);
+        if (scale != FSR1_Context::g_dynamicScale) {
+            LOG_D("FSR1 dynamic resolution: %.2f (GPU %.2f ms)", scale, frameMs)
+            FSR1_Context::g_dynamicScale = scale;
+            g_constantsDirty = true;
+            if (g_rectsScaled) ReapplyRects();
+        }
+    }
+    g_frameTimer.begin_frame();
 }
 
-void CheckResolutionChange() {
-    GLsizei width = 0, height = 0;
-    LOAD_EGL(eglQuerySurface);
-    static EGLDisplay display;
-    static EGLSurface surface;
-    if (!display || !surface) {
-        display = eglGetCurrentDisplay();
-        surface = eglGetCurrentSurface(EGL_DRAW);
+void CheckResolutionChange(EGLDisplay display, EGLSurface surface) {
+    if (FSR1_Context::g_surfaceDirty) {
+        FSR1_Context::g_surfaceDirty = false;
+        LOAD_EGL(eglQuerySurface);
+        EGLint width = 0, height = 0;
+        if (egl_eglQuerySurface && egl_eglQuerySurface(display, surface, EGL_WIDTH, &width) &&
+            egl_eglQuerySurface(display, surface, EGL_HEIGHT, &height) && width > 0 && height > 0) {
+            OnResize(width, height);
+        } else if (FSR1_Context::g_pendingWidth > 0 && FSR1_Context::g_pendingHeight > 0) {
+            // No window surface to ask, go by the application's viewport
+            OnResize(FSR1_Context::g_pendingWidth, FSR1_Context::g_pendingHeight);
+        }
     }
-    egl_eglQuerySurface(display, surface, EGL_WIDTH, &width);
-    egl_eglQuerySurface(display, surface, EGL_HEIGHT, &height);
-    OnResize(width, height);
 
     if (FSR1_Context::g_resolutionChanged) {
         FSR1_Context::g_resolutionChanged = false;
@@ -364,12 +606,79 @@ void CheckResolutionChange() {
         FSR1_Context::g_renderWidth = width;
         FSR1_Context::g_renderHeight = height;
 
-        CalculateTargetResolution(global_settings.fsr1_setting, width, height,
-                                  reinterpret_cast<int*>(&FSR1_Context::g_targetWidth),
-                                  reinterpret_cast<int*>(&FSR1_Context::g_targetHeight));
+        if (g_drsEnabled) {
+            // The render target matches the window and is drawn partially
+            FSR1_Context::g_targetWidth = width;
+            FSR1_Context::g_targetHeight = height;
+        } else {
+            CalculateTargetResolution(global_settings.fsr1_setting, width, height,
+                                      reinterpret_cast<int*>(&FSR1_Context::g_targetWidth),
+                                      reinterpret_cast<int*>(&FSR1_Context::g_targetHeight));
+        }
         RecreateFSRFBO();
     }
-    GLES.glViewport(0, 0, FSR1_Context::g_renderWidth, FSR1_Context::g_renderHeight);
+
+    if (g_drsEnabled) UpdateDynamicResolution();
+}
+
+void ApplyFSRViewport(GLint x, GLint y, GLsizei w, GLsizei h) {
+    if (DrawingToRenderTarget()) ScaleRect(x, y, w, h);
+    GLES.glViewport(x, y, w, h);
+}
+
+void ApplyFSRScissor(GLint x, GLint y, GLsizei w, GLsizei h) {
+    if (DrawingToRenderTarget()) ScaleRect(x, y, w, h);
+    GLES.glScissor(x, y, w, h);
+}
+
+void OnFSRDrawFramebufferChanged() {
+    if (g_drsEnabled && DrawingToRenderTarget() != g_rectsScaled) ReapplyRects();
+}
+
+void ScaleFSRReadCorners(GLint& x0, GLint& y0, GLint& x1, GLint& y1) {
+    if (ReadingFromRenderTarget()) ScaleCorners(x0, y0, x1, y1);
+}
+
+void ScaleFSRDrawCorners(GLint& x0, GLint& y0, GLint& x1, GLint& y1) {
+    if (DrawingToRenderTarget()) ScaleCorners(x0, y0, x1, y1);
+}
+
+FSRReadScope::FSRReadScope(GLint& x, GLint& y, GLsizei width, GLsizei height) {
+    using namespace FSR1_Context;
+    if (!ReadingFromRenderTarget() || g_dynamicScale == 1.0f || width <= 0 || height <= 0) return;
+
+    {
+        StateScope state(STATE_SCOPE_FRAMEBUFFER | STATE_SCOPE_RENDERBUFFER);
+        if (!g_readFBO) {
+            GLES.glGenRenderbuffers(1, &g_readRBO);
+            GLES.glGenFramebuffers(1, &g_readFBO);
+        }
+        GLES.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, g_readFBO);
+        if (width > g_readWidth || height > g_readHeight) {
+            g_readWidth = std::max(width, g_readWidth);
+            g_readHeight = std::max(height, g_readHeight);
+            GLES.glBindRenderbuffer(GL_RENDERBUFFER, g_readRBO);
+            GLES.glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, g_readWidth, g_readHeight);
+            GLES.glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, g_readRBO);
+        }
+
+        // Blits are scissored, reads are not
+        const bool scissor = gl_state->enabled_caps & STATE_CAP_SCISSOR_TEST;
+        if (scissor) GLES.glDisable(GL_SCISSOR_TEST);
+        GLint x0 = x, y0 = y, x1 = x + width, y1 = y + height;
+        ScaleCorners(x0, y0, x1, y1);
+        GLES.glBlitFramebuffer(x0, y0, x1, y1, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        if (scissor) GLES.glEnable(GL_SCISSOR_TEST);
+    }
+
+    GLES.glBindFramebuffer(GL_READ_FRAMEBUFFER, g_readFBO);
+    x = 0;
+    y = 0;
+    m_active = true;
+}
+
+FSRReadScope::~FSRReadScope() {
+    if (m_active) GLES.glBindFramebuffer(GL_READ_FRAMEBUFFER, gl_state->current_read_fbo);
 }
 
 void OnResize(int width, int height) {
@@ -382,13 +691,22 @@ void OnResize(int width, int height) {
 
 void glViewport(GLint x, GLint y, GLsizei w, GLsizei h) {
     LOG()
+    MG_TRACE_ARGS(glViewport, x, y, w, h)
     LOG_D("glViewport: x=%d, y=%d, w=%d, h=%d", x, y, w, h);
+    flush_immediate();
 
-    if (w > FSR1_Context::g_pendingWidth || h > FSR1_Context::g_pendingHeight) {
+    // A full viewport on the default framebuffer that does not match the
+    // render size means the window was probably resized
+    if (x == 0 && y == 0 && gl_state->current_draw_fbo == FSR1_Context::g_renderFBO &&
+        (w != FSR1_Context::g_renderWidth || h != FSR1_Context::g_renderHeight)) {
         FSR1_Context::g_pendingWidth = w;
         FSR1_Context::g_pendingHeight = h;
-        FSR1_Context::g_resolutionChanged = true;
+        FSR1_Context::g_surfaceDirty = true;
     }
 
-    GLES.glViewport(x, y, w, h);
-}
\ No newline at end of file
+    FILTER_REDUNDANT_CALL(FilteredCall::Viewport, gl_state->viewport_known && gl_state->viewport[0] == x &&
+                                                      gl_state->viewport[1] == y && gl_state->viewport[2] == w &&
+                                                      gl_state->viewport[3] == h)
+    if (w >= 0 && h >= 0) set_gl_state_viewport(x, y, w, h);
+    ApplyFSRViewport(x, y, w, h);
+}
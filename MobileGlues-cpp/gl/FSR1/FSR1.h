@@ -34,10 +34,12 @@ namespace FSR1_Context {
     extern GLuint g_renderFBO;
     extern GLuint g_renderTexture;
     extern GLuint g_depthStencilRBO;
-    extern GLuint g_quadVAO;
-    extern GLuint g_quadVBO;
-    extern GLuint g_fsrProgram;
+    // Empty, so the fullscreen triangle never reads the application's arrays
+    extern GLuint g_triangleVAO;
+    extern GLuint g_easuProgram;
+    extern GLuint g_rcasProgram;
 
+    // EASU output that RCAS sharpens. Only exists while RCAS is enabled.
     extern GLuint g_targetFBO;
     extern GLuint g_targetTexture;
 
@@ -52,14 +54,62 @@ namespace FSR1_Context {
     extern bool g_resolutionChanged;
     extern GLsizei g_pendingWidth;
     extern GLsizei g_pendingHeight;
+    // Set when the window surface may have changed size: a new surface was
+    // made current, or the application set a viewport on the default
+    // framebuffer that does not match it. The size is only queried then.
+    extern bool g_surfaceDirty;
+
+    // Dynamic resolution (fsr1_target_fps): the application's default
+    // framebuffer is drawn into this fraction of the render target, from
+    // its lower left corner, and EASU upscales only that part. Viewports,
+    // scissor boxes and blit rectangles are scaled on their way to the
+    // driver while the render target is bound, and reads from it go through
+    // FSRReadScope; the state shadow keeps the application's values.
+    extern float g_dynamicScale;
 } // namespace FSR1_Context
 
 extern bool fsrInitialized;
 void ApplyFSR();
 void InitFSRResources();
-void CheckResolutionChange();
+void CheckResolutionChange(EGLDisplay display, EGLSurface surface);
 void OnResize(int width, int height);
 
+// glViewport/glScissor towards the driver, scaled for dynamic resolution
+void ApplyFSRViewport(GLint x, GLint y, GLsizei w, GLsizei h);
+void ApplyFSRScissor(GLint x, GLint y, GLsizei w, GLsizei h);
+// Rescales viewport and scissor after the draw framebuffer changed
+void OnFSRDrawFramebufferChanged();
+
+// Blit corners in the application's default framebuffer, scaled when the
+// read or the draw framebuffer is the render target drawn at the dynamic scale
+void ScaleFSRReadCorners(GLint& x0, GLint& y0, GLint& x1, GLint& y1);
+void ScaleFSRDrawCorners(GLint& x0, GLint& y0, GLint& x1, GLint& y1);
+
+// Reads (glReadPixels, glCopyTex*) of a width x height rectangle at x, y.
+// While the read framebuffer is the render target at a dynamic scale, the
+// part of it that holds the rectangle is upsampled into a scratch
+// framebuffer, which is bound for reading with x and y moved to its origin.
+// The application's read framebuffer is bound again on destruction.
+class FSRReadScope {
+public:
+    FSRReadScope(GLint& x, GLint& y, GLsizei width, GLsizei height);
+    ~FSRReadScope();
+
+    FSRReadScope(const FSRReadScope&) = delete;
+    FSRReadScope& operator=(const FSRReadScope&) = delete;
+
+private:
+    bool m_active = false;
+};
+
+// CPU versions of FsrEasuCon and FsrRcasCon from ffx_fsr1.h, producing the
+// same bits the shader would. con receives con0..con3 back to back.
+void FsrEasuConstants(uint32_t con[16], float viewportWidth, float viewportHeight, float inputWidth,
+                      float inputHeight, float outputWidth, float outputHeight);
+void FsrRcasConstants(uint32_t con[4], float sharpnessStops);
+// Maps fsr1_sharpness (1 softest to 10 sharpest) to RCAS stops
+float FsrSharpnessStops(int strength);
+
 extern "C"
 {
     GLAPI void glViewport(GLint x, GLint y, GLsizei w, GLsizei h);
@@ -7,23 +7,31 @@
 #pragma once
 #include <string>
 
+// One triangle covering the viewport, generated from gl_VertexID so no
+// vertex buffer is needed
 const char* FSR_VSSource = R"fsr_glsl(#version 450
 
-layout(location = 0) in vec2 aPosition;
-out vec2 vTexCoord;
-
 void main() {
-    gl_Position = vec4(aPosition, 0.0, 1.0);
-    vTexCoord = aPosition * 0.5 + 0.5;
+    vec2 pos = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
 })fsr_glsl";
 
-const char* FSR_FSSource = R"fsr_glsl(#version 450
+// Each pass is built from its header, FSR_FSLibrary and its main
+const char* FSR_EASU_FSHeader = R"fsr_glsl(#version 450
 
 #define A_GPU 1
 #define A_GLSL 1
 #define FSR_EASU_F 1
+)fsr_glsl";
+
+const char* FSR_RCAS_FSHeader = R"fsr_glsl(#version 450
+
+#define A_GPU 1
+#define A_GLSL 1
 #define FSR_RCAS_F 1
+)fsr_glsl";
 
+const char* FSR_FSLibrary = R"fsr_glsl(
 // #include "ffx_a.h"
 //==============================================================================================================================
 //
@@ -3884,62 +3892,38 @@ AF1 sharpness){
   cB=ASatH2(nB+AGtZeroH2(dit-rB)*AH2_(1.0/1023.0));}
 #endif
 
+)fsr_glsl";
+
+// Upscales uInputTex to the viewport. uCon0..3 come from FsrEasuCon on the CPU.
+const char* FSR_EASU_FSMain = R"fsr_glsl(
 uniform sampler2D uInputTex;
-uniform vec4 uConst0;
-uniform vec2 uViewportSize;
-in vec2 vTexCoord;
+uniform uvec4 uCon0;
+uniform uvec4 uCon1;
+uniform uvec4 uCon2;
+uniform uvec4 uCon3;
 out vec4 oFragColor;
 
-AF4 FsrRcasLoadF(ASU2 p) { return texelFetch(uInputTex, ASU2(p), 0); }
-void FsrRcasInputF(inout AF1 r, inout AF1 g, inout AF1 b) {}
-AF4 FsrEasuRF(AF2 p) { AF4 res = textureGather(uInputTex, p, 0); return res; }
-AF4 FsrEasuGF(AF2 p) { AF4 res = textureGather(uInputTex, p, 1); return res; }
-AF4 FsrEasuBF(AF2 p) { AF4 res = textureGather(uInputTex, p, 2); return res; }
+AF4 FsrEasuRF(AF2 p) { return textureGather(uInputTex, p, 0); }
+AF4 FsrEasuGF(AF2 p) { return textureGather(uInputTex, p, 1); }
+AF4 FsrEasuBF(AF2 p) { return textureGather(uInputTex, p, 2); }
 
 void main() {
-    ivec2 texSize = textureSize(uInputTex, 0);
-    vec2 inputTexCoord = vTexCoord * (vec2(texSize) / uViewportSize);
-    AU2 ip = AU2(gl_FragCoord.xy);
-    
-    AF1 inputViewportInPixelsX = uViewportSize.x;
-    AF1 inputViewportInPixelsY = uViewportSize.y;
-    AF1 outputSizeInPixelsX = float(texSize.x);
-    AF1 outputSizeInPixelsY = float(texSize.y);
-    
-    A_STATIC const AF1 sharpness = 0.2; // 0.0-1.0
-    A_STATIC const AF3 lumaWeight = AF3(0.2126, 0.7152, 0.0722);
-    
-    AU4 const0;
-    AU4 const1;
-    AU4 const2;
-    AU4 const3;
-    FsrEasuCon(
-        const0, const1, const2, const3,
-        inputViewportInPixelsX, inputViewportInPixelsY,
-        inputViewportInPixelsX, inputViewportInPixelsY,
-        outputSizeInPixelsX, outputSizeInPixelsY
-    );
-    
     AF3 color;
-    FsrEasuF(
-        color,
-        ip,
-        const0, const1, const2, const3
-    );
-    
-    A_STATIC const AF1 rcasAt = 0.25;
-    AU4 con;
-    FsrRcasCon(con, rcasAt);
-    
-    AF3 sharpenedColor;
-    FsrRcasF(
-        sharpenedColor.r,
-        sharpenedColor.g,
-        sharpenedColor.b,
-        ip,
-        con
-    );
+    FsrEasuF(color, AU2(gl_FragCoord.xy), uCon0, uCon1, uCon2, uCon3);
+    oFragColor = vec4(color, 1.0);
+})fsr_glsl";
 
-    
-    oFragColor = vec4(sharpenedColor, 1.0);
-})fsr_glsl";
\ No newline at end of file
+// Sharpens the EASU output, which has the size of the viewport
+const char* FSR_RCAS_FSMain = R"fsr_glsl(
+uniform sampler2D uInputTex;
+uniform uvec4 uCon;
+out vec4 oFragColor;
+
+AF4 FsrRcasLoadF(ASU2 p) { return texelFetch(uInputTex, p, 0); }
+void FsrRcasInputF(inout AF1 r, inout AF1 g, inout AF1 b) {}
+
+void main() {
+    AF3 color;
+    FsrRcasF(color.r, color.g, color.b, AU2(gl_FragCoord.xy), uCon);
+    oFragColor = vec4(color, 1.0);
+})fsr_glsl";
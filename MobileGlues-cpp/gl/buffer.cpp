@@ -7,11 +7,13 @@
 
 #include "buffer.h"
 #include "ankerl/unordered_dense.h"
+#include "pixel.h"
 #include "texture.h"
+#include "state.h"
+#include "texture_buffer.h"
 
 #define DEBUG 0
 
-GLuint bound_array;
 static GLint maxBufferId = 0;
 static GLint maxArrayId = 0;
 
@@ -25,6 +27,14 @@ static std::vector<GLuint> g_free_array_ids;
 
 static std::vector<size_t> g_buffer_datasize;
 
+// Bumped on every write to a buffer we can see, so data derived from a
+// buffer's contents (see index_cache.cpp) can detect that it went stale.
+// Generations are never reset, not even when an id is reused.
+static std::vector<uint32_t> g_buffer_generation;
+// Buffers that can change without going through us: persistently mapped,
+// or bound as a GPU write target.
+static std::vector<char> g_buffer_volatile;
+
 static std::vector<GLuint> g_element_array_buffer_per_vao;
 
 enum BindingIndex : int {
@@ -40,15 +50,19 @@ enum BindingIndex : int {
     BI_SHADER_STORAGE,
     BI_TRANSFORM_FEEDBACK,
     BI_UNIFORM_BUFFER,
+    BI_TEXTURE_BUFFER,
     BINDING_COUNT
 };
-static std::array<GLuint, BINDING_COUNT> g_bound_buffers_arr = {0};
+// The bindings themselves are in gl_state->bound_buffers, per context
+static_assert(BINDING_COUNT == MG_BUFFER_BINDING_COUNT);
 
 static inline int ensure_buffer_capacity(GLuint id) {
     if ((int)g_gen_buffers.size() <= (int)id) {
         g_gen_buffers.resize(id + 1, 0);
         g_gen_buffer_exists.resize(id + 1, 0);
         if (g_buffer_datasize.size() <= (size_t)id) g_buffer_datasize.resize(id + 1, 0);
+        if (g_buffer_generation.size() <= (size_t)id) g_buffer_generation.resize(id + 1, 0);
+        if (g_buffer_volatile.size() <= (size_t)id) g_buffer_volatile.resize(id + 1, 0);
     }
     return 0;
 }
@@ -97,6 +111,8 @@ void remove_buffer(GLuint key) {
         g_gen_buffer_exists[key] = 0;
         g_gen_buffers[key] = 0;
         if (key < g_buffer_datasize.size()) g_buffer_datasize[key] = 0;
+        mark_buffer_written(key);
+        g_buffer_volatile[key] = 0;
         g_free_buffer_ids.push_back(key);
     }
 }
@@ -112,7 +128,7 @@ GLuint get_ibo_by_vao(GLuint vao) {
 }
 
 GLuint find_bound_array() {
-    return bound_array;
+    return gl_state->bound_vertex_array;
 }
 
 void update_vao_ibo_binding(GLuint vao, GLuint ibo) {
@@ -130,6 +146,19 @@ size_t get_buffer_data_size(GLuint buffer) {
     return 0;
 }
 
+void mark_buffer_written(GLuint buffer) {
+    if (buffer < g_buffer_generation.size()) ++g_buffer_generation[buffer];
+}
+
+void mark_buffer_volatile(GLuint buffer) {
+    if (buffer < g_buffer_volatile.size()) g_buffer_volatile[buffer] = 1;
+}
+
+uint32_t get_buffer_generation(GLuint buffer) {
+    if (!has_buffer(buffer) || g_buffer_volatile[buffer]) return BUFFER_GENERATION_VOLATILE;
+    return g_buffer_generation[buffer] & ~BUFFER_GENERATION_VOLATILE;
+}
+
 static inline int binding_target_to_index(GLenum target) {
     switch (target) {
     case GL_ARRAY_BUFFER:
@@ -156,6 +185,8 @@ static inline int binding_target_to_index(GLenum target) {
         return BI_TRANSFORM_FEEDBACK;
     case GL_UNIFORM_BUFFER:
         return BI_UNIFORM_BUFFER;
+    case GL_TEXTURE_BUFFER:
+        return BI_TEXTURE_BUFFER;
     default:
         return -1;
     }
@@ -163,7 +194,7 @@ static inline int binding_target_to_index(GLenum target) {
 
 void set_bound_buffer_by_target(GLenum target, GLuint buffer) {
     int idx = binding_target_to_index(target);
-    if (idx >= 0) g_bound_buffers_arr[idx] = buffer;
+    if (idx >= 0) gl_state->bound_buffers[idx] = buffer;
 }
 
 GLuint find_bound_buffer(GLenum key) {
@@ -205,6 +236,9 @@ GLuint find_bound_buffer(GLenum key) {
     case GL_UNIFORM_BUFFER_BINDING:
         target = GL_UNIFORM_BUFFER;
         break;
+    case GL_TEXTURE_BUFFER_BINDING:
+        target = GL_TEXTURE_BUFFER;
+        break;
     default:
         target = 0;
         break;
@@ -213,7 +247,7 @@ GLuint find_bound_buffer(GLenum key) {
         return get_ibo_by_vao(find_bound_array());
     }
     int idx = binding_target_to_index(target);
-    if (idx >= 0) return g_bound_buffers_arr[idx];
+    if (idx >= 0) return gl_state->bound_buffers[idx];
     return 0;
 }
 
@@ -287,6 +321,8 @@ static GLenum get_binding_query(GLenum target) {
         return GL_DRAW_INDIRECT_BUFFER_BINDING;
     case GL_DISPATCH_INDIRECT_BUFFER:
         return GL_DISPATCH_INDIRECT_BUFFER_BINDING;
+    case GL_TEXTURE_BUFFER:
+        return GL_TEXTURE_BUFFER_BINDING;
     default:
         return 0;
     }
@@ -312,16 +348,31 @@ void InitVertexArrayMap(size_t expectedSize) {
 
 void glGenBuffers(GLsizei n, GLuint* buffers) {
     LOG()
+    MG_TRACE_ARGS(glGenBuffers, n, buffers)
     LOG_D("glGenBuffers(%i, %p)", n, buffers)
     for (int i = 0; i < n; ++i) {
         buffers[i] = gen_buffer();
     }
 }
 
+// Deleting a bound buffer reverts that binding to 0
+static void unbind_deleted_buffer(GLuint buffer) {
+    for (auto& bound : gl_state->bound_buffers) {
+        if (bound == buffer) bound = 0;
+    }
+    GLuint vao = find_bound_array();
+    if (vao < g_element_array_buffer_per_vao.size() && g_element_array_buffer_per_vao[vao] == buffer)
+        g_element_array_buffer_per_vao[vao] = 0;
+}
+
 void glDeleteBuffers(GLsizei n, const GLuint* buffers) {
     LOG()
+    MG_TRACE_ARGS(glDeleteBuffers, n, buffers)
     LOG_D("glDeleteBuffers(%i, %p)", n, buffers)
     for (int i = 0; i < n; ++i) {
+        if (buffers[i] != 0) unbind_deleted_buffer(buffers[i]);
+        texture_buffer_forget_buffer(buffers[i]);
+        pack_buffer_forget(buffers[i]);
         if (find_real_buffer(buffers[i])) {
             GLuint real_buff = find_real_buffer(buffers[i]);
             GLES.glDeleteBuffers(1, &real_buff);
@@ -333,14 +384,19 @@ void glDeleteBuffers(GLsizei n, const GLuint* buffers) {
 
 GLboolean glIsBuffer(GLuint buffer) {
     LOG()
+    MG_TRACE_ARGS(glIsBuffer, buffer)
     LOG_D("glIsBuffer, buffer = %d", buffer)
     return has_buffer(buffer);
 }
 
 void glBindBuffer(GLenum target, GLuint buffer) {
     LOG()
+    MG_TRACE_ARGS(glBindBuffer, target, buffer)
     LOG_D("glBindBuffer, target = %s, buffer = %d", glEnumToString(target), buffer)
+    GLenum query = get_binding_query(target);
+    FILTER_REDUNDANT_CALL(FilteredCall::BindBuffer, query != 0 && find_bound_buffer(query) == buffer)
     set_bound_buffer_by_target(target, buffer);
+    if (target == GL_PIXEL_PACK_BUFFER || target == GL_TRANSFORM_FEEDBACK_BUFFER) mark_buffer_volatile(buffer);
     // save ibo binding to vao
     if (target == GL_ELEMENT_ARRAY_BUFFER) {
         update_vao_ibo_binding(find_bound_array(), buffer);
@@ -358,6 +414,7 @@ void glBindBuffer(GLenum target, GLuint buffer) {
         CHECK_GL_ERROR
     }
     LOG_D("glBindBuffer: %d -> %d", buffer, real_buffer)
+    if (target != GL_PIXEL_PACK_BUFFER) pack_buffer_resolve(buffer, 0, -1);
     GLES.glBindBuffer(target, real_buffer);
     CHECK_GL_ERROR
 }
@@ -369,7 +426,33 @@ struct atomic_buffer {
 };
 
 static std::vector<atomic_buffer> g_buffer_map_atomic_buffer_info;
-static std::vector<GLuint> g_buffer_map_ssbo_id; // shall we use this in the future?
+
+// What is bound to each indexed GL_SHADER_STORAGE_BUFFER binding on the
+// backend, so internal compute passes can put it back without glGet.
+struct indexed_binding {
+    GLuint real_buffer;
+    GLintptr offset;
+    GLsizeiptr size; // 0 for glBindBufferBase
+};
+static std::vector<indexed_binding> g_ssbo_bindings;
+
+static void track_ssbo_binding(GLuint index, GLuint real_buffer, GLintptr offset, GLsizeiptr size) {
+    if (index >= g_ssbo_bindings.size()) g_ssbo_bindings.resize(index + 1, {});
+    g_ssbo_bindings[index] = {real_buffer, offset, size};
+}
+
+void restore_ssbo_binding(GLuint index) {
+    indexed_binding binding = index < g_ssbo_bindings.size() ? g_ssbo_bindings[index] : indexed_binding{};
+    if (binding.size > 0)
+        GLES.glBindBufferRange(GL_SHADER_STORAGE_BUFFER, index, binding.real_buffer, binding.offset, binding.size);
+    else
+        GLES.glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, binding.real_buffer);
+}
+
+GLuint find_real_bound_buffer(GLenum key) {
+    GLuint buffer = find_bound_buffer(key);
+    return has_buffer(buffer) ? find_real_buffer(buffer) : buffer;
+}
 
 void bindAllAtomicCounterAsSSBO() {
     const size_t count = g_buffer_map_atomic_buffer_info.size();
@@ -378,6 +461,7 @@ void bindAllAtomicCounterAsSSBO() {
         if (buf.id != 0) {
             GLuint realID = find_real_buffer(buf.id);
             GLES.glBindBufferRange(GL_SHADER_STORAGE_BUFFER, i, realID, buf.offset, buf.size);
+            track_ssbo_binding(i, realID, buf.offset, buf.size);
             LOG_D("Bound atomic counter buffer %u(real: %u) as SSBO at index %zu", buf, realID, i);
         }
     }
@@ -385,11 +469,13 @@ void bindAllAtomicCounterAsSSBO() {
 
 void glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
     LOG()
+    MG_TRACE_ARGS(glBindBufferRange, target, index, buffer, offset, size)
     LOG_D("glBindBufferRange, target = %s, index = %d, buffer = %d, offset = %p, size = %zi", glEnumToString(target),
           index, buffer, (void*)offset, size)
 
     if (!has_buffer(buffer) || buffer == 0) {
         GLES.glBindBufferRange(target, index, buffer, offset, size);
+        if (target == GL_SHADER_STORAGE_BUFFER) track_ssbo_binding(index, buffer, offset, size);
         CHECK_GL_ERROR
         return;
     }
@@ -399,7 +485,10 @@ void glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offs
         modify_buffer(buffer, real_buffer);
         CHECK_GL_ERROR
     }
+    pack_buffer_resolve(buffer, 0, -1);
     GLES.glBindBufferRange(target, index, real_buffer, offset, size);
+    if (target != GL_UNIFORM_BUFFER) mark_buffer_volatile(buffer);
+    if (target == GL_SHADER_STORAGE_BUFFER) track_ssbo_binding(index, real_buffer, offset, size);
     if (target == GL_ATOMIC_COUNTER_BUFFER) {
         if (g_buffer_map_atomic_buffer_info.empty()) {
             g_buffer_map_atomic_buffer_info.resize(GL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS, {});
@@ -411,10 +500,12 @@ void glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offs
 
 void glBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
     LOG()
+    MG_TRACE_ARGS(glBindBufferBase, target, index, buffer)
     LOG_D("glBindBufferBase, target = %s, index = %d, buffer = %d", glEnumToString(target), index, buffer)
 
     if (!has_buffer(buffer) || buffer == 0) {
         GLES.glBindBufferBase(target, index, buffer);
+        if (target == GL_SHADER_STORAGE_BUFFER) track_ssbo_binding(index, buffer, 0, 0);
         CHECK_GL_ERROR
         return;
     }
@@ -424,18 +515,16 @@ void glBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
         modify_buffer(buffer, real_buffer);
         CHECK_GL_ERROR
     }
+    pack_buffer_resolve(buffer, 0, -1);
     GLES.glBindBufferBase(target, index, real_buffer);
-    if (target == GL_SHADER_STORAGE_BUFFER) {
-        if (g_buffer_map_ssbo_id.empty()) {
-            g_buffer_map_ssbo_id.resize(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, 0);
-        }
-        g_buffer_map_ssbo_id[index] = buffer;
-    }
+    if (target != GL_UNIFORM_BUFFER) mark_buffer_volatile(buffer);
+    if (target == GL_SHADER_STORAGE_BUFFER) track_ssbo_binding(index, real_buffer, 0, 0);
     CHECK_GL_ERROR
 }
 
 void glBindVertexBuffer(GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride) {
     LOG()
+    MG_TRACE_ARGS(glBindVertexBuffer, bindingindex, buffer, offset, stride)
     LOG_D("glBindVertexBuffer, bindingindex = %d, buffer = %d, offset = %p, stride = %i", bindingindex, buffer, offset,
           stride)
     // Todo: should record fake buffer binding here, when glGetVertexArrayIntegeri_v is called, should return fake
@@ -451,109 +540,14 @@ void glBindVertexBuffer(GLuint bindingindex, GLuint buffer, GLintptr offset, GLs
         modify_buffer(buffer, real_buffer);
         CHECK_GL_ERROR
     }
+    pack_buffer_resolve(buffer, 0, -1);
     GLES.glBindVertexBuffer(bindingindex, real_buffer, offset, stride);
     CHECK_GL_ERROR
 }
 
-size_t get_internal_format_size(GLenum internalformat) {
-    switch (internalformat) {
-    case GL_R8:
-        return 1;
-    case GL_R8I:
-    case GL_R8UI:
-        return 1;
-    case GL_R16:
-        return 2;
-    case GL_R16I:
-    case GL_R16UI:
-    case GL_R16F:
-        return 2;
-    case GL_R32I:
-    case GL_R32UI:
-    case GL_R32F:
-        return 4;
-
-    case GL_RG8:
-        return 2;
-    case GL_RG8I:
-    case GL_RG8UI:
-        return 2;
-    case GL_RG16:
-        return 4;
-    case GL_RG16I:
-    case GL_RG16UI:
-    case GL_RG16F:
-        return 4;
-    case GL_RG32I:
-    case GL_RG32UI:
-    case GL_RG32F:
-        return 8;
-
-    case GL_RGB8:
-        return 3;
-    case GL_RGB8I:
-    case GL_RGB8UI:
-        return 3;
-    case GL_RGB16:
-        return 6;
-    case GL_RGB16I:
-    case GL_RGB16UI:
-    case GL_RGB16F:
-        return 6;
-    case GL_RGB32I:
-    case GL_RGB32UI:
-    case GL_RGB32F:
-        return 12;
-
-    case GL_RGBA8:
-        return 4;
-    case GL_RGBA8I:
-    case GL_RGBA8UI:
-        return 4;
-    case GL_RGBA16:
-        return 8;
-    case GL_RGBA16I:
-    case GL_RGBA16UI:
-    case GL_RGBA16F:
-        return 8;
-    case GL_RGBA32I:
-    case GL_RGBA32UI:
-    case GL_RGBA32F:
-        return 16;
-
-    case GL_DEPTH_COMPONENT16:
-        return 2;
-    case GL_DEPTH_COMPONENT24:
-        return 3;
-    case GL_DEPTH_COMPONENT32:
-        return 4;
-    case GL_DEPTH_COMPONENT32F:
-        return 4;
-    case GL_DEPTH24_STENCIL8:
-        return 4;
-    case GL_DEPTH32F_STENCIL8:
-        return 5;
-
-    case GL_STENCIL_INDEX8:
-        return 1;
-
-    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
-    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
-        return 8;
-    case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
-    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
-        return 16;
-
-    default:
-        LOG_E("Unknown internal format size for %s", glEnumToString(internalformat));
-        return 0;
-    }
-}
-
-extern std::string bufSampelerName;
-// Todo: any glGet* related to this function?
 void glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer) {
     LOG()
+    MG_TRACE_ARGS(glTexBuffer, target, internalformat, buffer)
     LOG_D("glTexBuffer, target = %s, internalformat = %s, buffer = %d", glEnumToString(target),
           glEnumToString(internalformat), buffer)
     if (target != GL_TEXTURE_BUFFER) return;
@@ -569,104 +563,16 @@ void glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer) {
         modify_buffer(buffer, real_buffer);
         CHECK_GL_ERROR
     }
+    pack_buffer_resolve(buffer, 0, -1);
 
     if (hardware->emulate_texture_buffer) {
-        LOG_D("Emulating glTexBuffer");
-
-        GLint boundTexture = 0;
-        GLint prev_pixel_buffer_binding = 0;
-
-        GLES.glActiveTexture(GL_TEXTURE0 + 15);
-
-        GLES.glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture);
-        LOG_D("Current GL_TEXTURE_BINDING_BUFFER = %d", boundTexture);
-        GLES.glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &prev_pixel_buffer_binding);
-        LOG_D("Previous GL_PIXEL_UNPACK_BUFFER_BINDING = %d", prev_pixel_buffer_binding);
-
+        GLuint boundTexture = gl_state->texture_binding_2d[TEXTURE_BUFFER_UNIT];
         if (!boundTexture) {
             LOG_D("No texture bound to GL_TEXTURE_BUFFER, skipping emulation.");
             return;
         }
-
-        GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, real_buffer);
-        LOG_D("Bound GL_PIXEL_UNPACK_BUFFER to buffer %u", real_buffer);
-
-        GLint bufferSize;
-        GLES.glGetBufferParameteriv(GL_PIXEL_UNPACK_BUFFER, GL_BUFFER_SIZE, &bufferSize);
-        LOG_D("Buffer size = %d bytes", bufferSize);
-
-        GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-
-        GLES.glBindTexture(GL_TEXTURE_2D, boundTexture);
-        LOG_D("Binding texture %u to GL_TEXTURE_2D", boundTexture);
-
-        const GLuint MAX_WIDTH = 8192;
-        GLuint pixelSize = get_internal_format_size(internalformat);
-        GLuint numElements = bufferSize / pixelSize;
-
-        GLuint width = numElements;
-        GLuint height = 1;
-
-        if (width > MAX_WIDTH) {
-            width = MAX_WIDTH;
-            height = (numElements + MAX_WIDTH - 1) / MAX_WIDTH;
-        }
-
-        GLint prev_alignment, prev_row_length, prev_skip_pixels, prev_skip_rows;
-        GLES.glGetIntegerv(GL_UNPACK_ALIGNMENT, &prev_alignment);
-        GLES.glGetIntegerv(GL_UNPACK_ROW_LENGTH, &prev_row_length);
-        GLES.glGetIntegerv(GL_UNPACK_SKIP_PIXELS, &prev_skip_pixels);
-        GLES.glGetIntegerv(GL_UNPACK_SKIP_ROWS, &prev_skip_rows);
-
-        // why do these 2 params not work
-        // GLES.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        // GLES.glPixelStorei(GL_UNPACK_ROW_LENGTH, 0)
-        GLES.glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-        GLES.glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-
-        // TODO: Optimize the glTexImage2D call
-        GLES.glTexImage2D(GL_TEXTURE_2D, 0, internalformat, width, height, 0, GL_RED_INTEGER, GL_BYTE, nullptr);
-
-        GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, real_buffer);
-
-        for (GLuint row = 0; row < height; ++row) {
-            void* offset = (void*)(row * width * pixelSize);
-            GLES.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, row, width, 1, GL_RED_INTEGER, GL_BYTE, offset);
-        }
-
-        GLES.glPixelStorei(GL_UNPACK_ALIGNMENT, prev_alignment);
-        GLES.glPixelStorei(GL_UNPACK_ROW_LENGTH, prev_row_length);
-        GLES.glPixelStorei(GL_UNPACK_SKIP_PIXELS, prev_skip_pixels);
-        GLES.glPixelStorei(GL_UNPACK_SKIP_ROWS, prev_skip_rows);
-
-        auto tex = mgGetTexObjectByTarget(target);
-        tex->target = ConvertGLEnumToTextureTarget(target);
-        tex->internal_format = internalformat;
-        tex->width = width;
-        tex->height = height;
-        tex->depth = 1;
-        tex->swizzle_param[0] = GL_RED;
-        tex->swizzle_param[1] = GL_GREEN;
-        tex->swizzle_param[2] = GL_BLUE;
-        tex->swizzle_param[3] = GL_ALPHA;
-
-        LOG_D("Called glTexImage2D with internalformat = 0x%X", internalformat);
-
-        GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-        GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-        LOG_D("Set texture parameters: MIN_FILTER=NEAREST, MAG_FILTER=NEAREST, WRAP_S/T=CLAMP_TO_EDGE");
-
-        GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, prev_pixel_buffer_binding);
-
-        GLES.glActiveTexture(GL_TEXTURE0 + gl_state->current_tex_unit);
-
-        LOG_D("Restored bindings: GL_PIXEL_UNPACK_BUFFER=%d", prev_pixel_buffer_binding);
-
-        CHECK_GL_ERROR;
+        // Uploaded on the next draw that samples it
+        texture_buffer_attach(boundTexture, internalformat, buffer, 0, -1);
         return;
     }
 
@@ -676,6 +582,7 @@ void glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer) {
 
 void glTexBufferRange(GLenum target, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size) {
     LOG()
+    MG_TRACE_ARGS(glTexBufferRange, target, internalformat, buffer, offset, size)
     LOG_D("glTexBufferRange, target = %s, internalformat = %s, buffer = %d, offset = %p, size = %zi",
           glEnumToString(target), glEnumToString(internalformat), buffer, (void*)offset, size)
     if (!has_buffer(buffer) || buffer == 0) {
@@ -689,23 +596,67 @@ void glTexBufferRange(GLenum target, GLenum internalformat, GLuint buffer, GLint
         modify_buffer(buffer, real_buffer);
         CHECK_GL_ERROR
     }
+    pack_buffer_resolve(buffer, 0, -1);
+
+    if (hardware->emulate_texture_buffer && target == GL_TEXTURE_BUFFER) {
+        GLuint boundTexture = gl_state->texture_binding_2d[TEXTURE_BUFFER_UNIT];
+        if (boundTexture) texture_buffer_attach(boundTexture, internalformat, buffer, offset, size);
+        return;
+    }
     GLES.glTexBufferRange(target, internalformat, real_buffer, offset, size);
     CHECK_GL_ERROR
 }
 
 void glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
     LOG()
+    MG_TRACE_ARGS(glBufferData, target, size, data, usage)
     LOG_D("glBufferData, target = %s, size = %d, data = 0x%x, usage = %s", glEnumToString(target), size, data,
           glEnumToString(usage))
     GLES.glBufferData(target, size, data, usage);
-    set_buffer_data_size(find_bound_buffer(target), size);
+    GLuint buffer = find_bound_buffer(get_binding_query(target));
+    pack_buffer_forget(buffer);
+    set_buffer_data_size(buffer, size);
+    mark_buffer_written(buffer);
+    texture_buffer_written(buffer, 0, -1);
+    CHECK_GL_ERROR
+}
+
+void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    LOG()
+    MG_TRACE_ARGS(glBufferSubData, target, offset, size, data)
+    LOG_D("glBufferSubData, target = %s, offset = %p, size = %zi", glEnumToString(target), (void*)offset, size)
+    GLuint buffer = find_bound_buffer(get_binding_query(target));
+    pack_buffer_resolve(buffer, offset, size);
+    GLES.glBufferSubData(target, offset, size, data);
+    mark_buffer_written(buffer);
+    texture_buffer_written(buffer, offset, size);
+    CHECK_GL_ERROR
+}
+
+void glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset,
+                         GLsizeiptr size) {
+    LOG()
+    MG_TRACE_ARGS(glCopyBufferSubData, readTarget, writeTarget, readOffset, writeOffset, size)
+    GLuint buffer = find_bound_buffer(get_binding_query(writeTarget));
+    pack_buffer_resolve(find_bound_buffer(get_binding_query(readTarget)), readOffset, size);
+    pack_buffer_resolve(buffer, writeOffset, size);
+    GLES.glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+    mark_buffer_written(buffer);
+    texture_buffer_written(buffer, writeOffset, size);
     CHECK_GL_ERROR
 }
 
 void* glMapBuffer(GLenum target, GLenum access) {
     LOG()
+    MG_TRACE_ARGS(glMapBuffer, target, access)
     LOG_D("glMapBuffer, target = %s, access = %s", glEnumToString(target), glEnumToString(access))
     if (g_gles_caps.GL_OES_mapbuffer) {
+        GLuint buffer = find_bound_buffer(get_binding_query(target));
+        pack_buffer_resolve(buffer, 0, -1);
+        if (access != GL_READ_ONLY) {
+            mark_buffer_written(buffer);
+            texture_buffer_mapped(buffer, 0, -1);
+        }
         return GLES.glMapBufferOES(target, access);
     }
     GLint buffer_size;
@@ -751,14 +702,29 @@ extern "C"
 
 void* glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
     LOG()
+    MG_TRACE_ARGS(glMapBufferRange, target, offset, length, access)
     if (global_settings.buffer_coherent_as_flush) access &= ~GL_MAP_FLUSH_EXPLICIT_BIT;
     //    access |= GL_MAP_UNSYNCHRONIZED_BIT;
+    GLuint buffer = find_bound_buffer(get_binding_query(target));
+    if (access & GL_MAP_PERSISTENT_BIT) mark_buffer_volatile(buffer);
+    if (access & GL_MAP_INVALIDATE_BUFFER_BIT)
+        pack_buffer_forget(buffer);
+    else
+        pack_buffer_resolve(buffer, offset, length);
+    if (access & GL_MAP_WRITE_BIT) {
+        mark_buffer_written(buffer);
+        texture_buffer_mapped(buffer, offset, length);
+    }
     return GLES.glMapBufferRange(target, offset, length, access);
 }
 
 GLboolean glUnmapBuffer(GLenum target) {
     LOG()
+    MG_TRACE_ARGS(glUnmapBuffer, target)
     LOG_D("%s(%s)", __func__, glEnumToString(target));
+    GLuint buffer = find_bound_buffer(get_binding_query(target));
+    mark_buffer_written(buffer);
+    texture_buffer_unmapped(buffer);
     if (g_gles_caps.GL_OES_mapbuffer) return GLES.glUnmapBuffer(target);
 
     GLboolean result = GLES.glUnmapBuffer(target);
@@ -768,10 +734,17 @@ GLboolean glUnmapBuffer(GLenum target) {
 
 void glBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
     LOG()
+    MG_TRACE_ARGS(glBufferStorage, target, size, data, flags)
     if (GLES.glBufferStorageEXT) {
         if (global_settings.buffer_coherent_as_flush &&
             ((flags & GL_MAP_PERSISTENT_BIT) != 0 || (flags & GL_DYNAMIC_STORAGE_BIT) != 0))
             flags |= (GL_MAP_WRITE_BIT | GL_MAP_COHERENT_BIT | GL_MAP_PERSISTENT_BIT);
+        GLuint buffer = find_bound_buffer(get_binding_query(target));
+        if (flags & GL_MAP_PERSISTENT_BIT) mark_buffer_volatile(buffer);
+        mark_buffer_written(buffer);
+        set_buffer_data_size(buffer, size);
+        pack_buffer_forget(buffer);
+        texture_buffer_written(buffer, 0, -1);
         GLES.glBufferStorageEXT(target, size, data, flags);
     }
     CHECK_GL_ERROR
@@ -779,11 +752,13 @@ void glBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfiel
 
 void glFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length) {
     LOG()
+    MG_TRACE_ARGS(glFlushMappedBufferRange, target, offset, length)
     if (!global_settings.buffer_coherent_as_flush) GLES.glFlushMappedBufferRange(target, offset, length);
 }
 
 void glGenVertexArrays(GLsizei n, GLuint* arrays) {
     LOG()
+    MG_TRACE_ARGS(glGenVertexArrays, n, arrays)
     LOG_D("glGenVertexArrays(%i, %p)", n, arrays)
     for (int i = 0; i < n; ++i) {
         arrays[i] = gen_array();
@@ -792,10 +767,17 @@ void glGenVertexArrays(GLsizei n, GLuint* arrays) {
 
 void glDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
     LOG()
+    MG_TRACE_ARGS(glDeleteVertexArrays, n, arrays)
     LOG_D("glDeleteVertexArrays(%i, %p)", n, arrays)
     for (int i = 0; i < n; ++i) {
+        // Deleting the bound vertex array reverts to the default one
+        if (arrays[i] != 0 && arrays[i] == gl_state->bound_vertex_array) {
+            gl_state->bound_vertex_array = 0;
+            set_bound_buffer_by_target(GL_ELEMENT_ARRAY_BUFFER, get_ibo_by_vao(0));
+        }
         if (find_real_array(arrays[i])) {
             GLuint real_array = find_real_array(arrays[i]);
+            if (real_array == gl_state->current_vao) set_gl_state_current_vao(0);
             GLES.glDeleteVertexArrays(1, &real_array);
             CHECK_GL_ERROR
         }
@@ -805,20 +787,24 @@ void glDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
 
 GLboolean glIsVertexArray(GLuint array) {
     LOG()
+    MG_TRACE_ARGS(glIsVertexArray, array)
     LOG_D("glIsVertexArray(%d)", array)
     return has_array(array);
 }
 
 void glBindVertexArray(GLuint array) {
     LOG()
+    MG_TRACE_ARGS(glBindVertexArray, array)
     LOG_D("glBindVertexArray(%d)", array)
-    bound_array = array;
+    FILTER_REDUNDANT_CALL(FilteredCall::BindVertexArray, gl_state->bound_vertex_array == array)
+    gl_state->bound_vertex_array = array;
 
     // update bound ibo
     set_bound_buffer_by_target(GL_ELEMENT_ARRAY_BUFFER, get_ibo_by_vao(array));
 
     if (!has_array(array) || array == 0) {
         LOG_D("Does not have va=%d found!", array)
+        set_gl_state_current_vao(array);
         GLES.glBindVertexArray(array);
         CHECK_GL_ERROR
         return;
@@ -832,6 +818,7 @@ void glBindVertexArray(GLuint array) {
         CHECK_GL_ERROR
     }
     LOG_D("glBindVertexArray: %d -> %d", array, real_array)
+    set_gl_state_current_vao(real_array);
     GLES.glBindVertexArray(real_array);
     CHECK_GL_ERROR
 }
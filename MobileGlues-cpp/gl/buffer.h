@@ -34,6 +34,26 @@ extern "C"
 
     GLuint find_bound_buffer(GLenum key);
 
+    // Backend name of the buffer bound to binding point `key`
+    GLuint find_real_bound_buffer(GLenum key);
+
+    void restore_ssbo_binding(GLuint index);
+
+#define BUFFER_GENERATION_VOLATILE 0x80000000u
+
+    // Write tracking: the generation of a buffer changes whenever its contents
+    // may have changed. Volatile buffers report BUFFER_GENERATION_VOLATILE.
+    void mark_buffer_written(GLuint key);
+
+    void mark_buffer_volatile(GLuint key);
+
+    uint32_t get_buffer_generation(GLuint key);
+
+    // Size last given to glBufferData/glBufferStorage, 0 if unknown
+    void set_buffer_data_size(GLuint key, size_t size);
+
+    size_t get_buffer_data_size(GLuint key);
+
     GLuint gen_array();
 
     GLboolean has_array(GLuint key);
@@ -80,6 +100,11 @@ extern "C"
 
     GLAPI GLAPIENTRY void glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
 
+    GLAPI GLAPIENTRY void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+
+    GLAPI GLAPIENTRY void glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset,
+                                              GLintptr writeOffset, GLsizeiptr size);
+
     GLAPI GLAPIENTRY void glBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
 
     GLAPI GLAPIENTRY void glFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length);
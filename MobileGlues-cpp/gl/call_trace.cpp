@@ -0,0 +1,934 @@
+// MobileGlues - gl/call_trace.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "call_trace.h"
+#include "buffer.h"
+#include "log.h"
+#include "mg.h"
+#include "pixel.h"
+#include "../config/config.h"
+#include "../config/settings.h"
+#include <ankerl/unordered_dense.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#define DEBUG 0
+
+#define CALL_TRACE_FLUSH_SIZE (256 * 1024)
+
+// Marks an array of strings whose count no rule gave
+#define CALL_TRACE_UNCAPTURED_STRINGS (UINT32_MAX - 1)
+
+bool g_call_trace_enabled = false;
+
+namespace {
+    struct CallStats {
+        const char* name;
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+    };
+
+    std::mutex g_mutex;
+    FILE* g_file = nullptr;
+    std::vector<uint8_t> g_buffer;
+    ankerl::unordered_dense::map<const char*, uint16_t> g_ids;
+    std::vector<CallStats> g_stats;
+    std::chrono::steady_clock::time_point g_epoch;
+    std::atomic<uint32_t> g_next_thread{0};
+
+    // Arguments of the calls in flight on this thread, innermost last
+    thread_local std::vector<uint8_t> t_args;
+    thread_local uint32_t t_depth = 0;
+    // Lengths for the glShaderSource strings, set by its rule
+    thread_local const GLint* t_string_lengths = nullptr;
+
+    template <typename T> void put(T value) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        g_buffer.insert(g_buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void flush_locked() {
+        if (!g_file || g_buffer.empty()) return;
+        fwrite(g_buffer.data(), 1, g_buffer.size(), g_file);
+        fflush(g_file);
+        g_buffer.clear();
+    }
+
+    // Names are __func__ of the caller, so the pointer identifies the entry point
+    uint16_t intern_locked(const char* name) {
+        auto it = g_ids.find(name);
+        if (it != g_ids.end()) return it->second;
+
+        auto id = (uint16_t)g_stats.size();
+        g_ids.emplace(name, id);
+        g_stats.push_back({name});
+
+        auto length = (uint16_t)std::min<size_t>(strlen(name), UINT16_MAX);
+        put<uint8_t>(CALL_TRACE_NAME);
+        put<uint16_t>(id);
+        put<uint16_t>(length);
+        g_buffer.insert(g_buffer.end(), name, name + length);
+        return id;
+    }
+} // namespace
+
+void init_call_trace() {
+    if (!global_settings.call_trace || !mg_directory_path) return;
+
+    std::string path = std::string(mg_directory_path) + "/call_trace.bin";
+    if (call_trace_start(path.c_str())) LOG_V("Call trace: writing to %s", path.c_str())
+}
+
+bool call_trace_start(const char* path) {
+    call_trace_stop();
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_file = fopen(path, "wb");
+    if (!g_file) {
+        LOG_W_FORCE("Call trace: cannot open %s", path)
+        return false;
+    }
+    fwrite("MGCT", 1, 4, g_file);
+    uint32_t header[2] = {CALL_TRACE_VERSION, (uint32_t)sizeof(void*)};
+    fwrite(header, sizeof(header), 1, g_file);
+
+    // Every trace file carries its own names
+    g_ids.clear();
+    g_stats.clear();
+    g_buffer.clear();
+    g_buffer.reserve(CALL_TRACE_FLUSH_SIZE + 64);
+    g_epoch = std::chrono::steady_clock::now();
+    g_call_trace_enabled = true;
+    return true;
+}
+
+void call_trace_stop() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (!g_file) return;
+    g_call_trace_enabled = false;
+    flush_locked();
+    fclose(g_file);
+    g_file = nullptr;
+}
+
+uint64_t call_trace_now() {
+    // Never 0, so CallTraceScope can use 0 as "not timed"
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_epoch)
+               .count() +
+           1;
+}
+
+void call_trace_record(const char* name, uint64_t start, uint64_t end, uint8_t depth, const uint8_t* args,
+                       uint32_t args_size) {
+    static thread_local uint32_t thread = g_next_thread.fetch_add(1);
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (!g_file) return;
+    uint16_t id = intern_locked(name);
+    auto duration = (uint32_t)std::min<uint64_t>(end - start, UINT32_MAX);
+    g_stats[id].count++;
+    g_stats[id].totalNs += duration;
+
+    put<uint8_t>(CALL_TRACE_CALL);
+    put<uint16_t>(id);
+    put<uint32_t>(thread);
+    put<uint64_t>(start);
+    put<uint32_t>(duration);
+    put<uint8_t>(depth);
+    put<uint32_t>(args_size);
+    if (args_size != CALL_TRACE_NO_ARGS) g_buffer.insert(g_buffer.end(), args, args + args_size);
+
+    if (g_buffer.size() >= CALL_TRACE_FLUSH_SIZE) flush_locked();
+}
+
+void call_trace_frame() {
+    if (!g_call_trace_enabled) return;
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    put<uint8_t>(CALL_TRACE_FRAME);
+    put<uint64_t>(call_trace_now());
+    flush_locked();
+}
+
+void CallTraceScope::begin() {
+    m_start = call_trace_now();
+    m_args_begin = (uint32_t)t_args.size();
+    t_depth++;
+}
+
+void CallTraceScope::end() {
+    uint64_t end = call_trace_now();
+    t_depth--;
+    uint32_t size = m_has_args ? (uint32_t)(t_args.size() - m_args_begin) : CALL_TRACE_NO_ARGS;
+    call_trace_record(m_name, m_start, end, (uint8_t)std::min<uint32_t>(t_depth, UINT8_MAX),
+                      t_args.data() + m_args_begin, size);
+    t_args.resize(m_args_begin);
+}
+
+std::string dump_call_trace_stats(const std::string& prefix) {
+    if (!g_call_trace_enabled) return "";
+
+    std::vector<CallStats> stats;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        stats = g_stats;
+    }
+    std::sort(stats.begin(), stats.end(),
+              [](const CallStats& a, const CallStats& b) { return a.totalNs > b.totalNs; });
+
+    std::string out;
+    for (const auto& s : stats) {
+        out += prefix + s.name + ": " + std::to_string(s.count) + " calls, " + std::to_string(s.totalNs / 1000) +
+               " us\n";
+    }
+    return out;
+}
+
+// Arguments
+
+void call_trace_put_bytes(const void* bytes, size_t size) {
+    const auto* begin = static_cast<const uint8_t*>(bytes);
+    t_args.insert(t_args.end(), begin, begin + size);
+}
+
+void call_trace_put_string(const char* string, uint64_t size) {
+    if (!string) {
+        call_trace_put<uint32_t>(CALL_TRACE_NULL_STRING);
+        return;
+    }
+    auto length = (uint32_t)std::min<uint64_t>(size == CALL_TRACE_SIZE_UNSET ? strlen(string) : size,
+                                               CALL_TRACE_UNCAPTURED_STRINGS - 1);
+    call_trace_put<uint32_t>(length);
+    t_args.insert(t_args.end(), string, string + length);
+}
+
+void call_trace_put_strings(const char* const* strings, uint64_t count) {
+    const GLint* lengths = t_string_lengths;
+    t_string_lengths = nullptr;
+    if (!strings) {
+        call_trace_put<uint32_t>(CALL_TRACE_NULL_STRING);
+        return;
+    }
+    if (count == CALL_TRACE_SIZE_UNSET || count >= CALL_TRACE_UNCAPTURED_STRINGS) {
+        call_trace_put<uint32_t>(CALL_TRACE_UNCAPTURED_STRINGS);
+        return;
+    }
+    call_trace_put<uint32_t>((uint32_t)count);
+    for (uint64_t i = 0; i < count; ++i) {
+        bool sized = lengths && lengths[i] >= 0;
+        call_trace_put_string(strings[i], sized ? (uint64_t)lengths[i] : CALL_TRACE_SIZE_UNSET);
+    }
+}
+
+void call_trace_put_pointer(const void* pointer, uint64_t size, bool writable) {
+    if (!pointer || (size != CALL_TRACE_SIZE_UNSET && (size & CALL_TRACE_SIZE_ADDRESS)) ||
+        (size == CALL_TRACE_SIZE_UNSET && !writable)) {
+        call_trace_put<uint8_t>(CALL_TRACE_ADDRESS);
+        call_trace_put<uint64_t>((uint64_t)(uintptr_t)pointer);
+    } else if (size == CALL_TRACE_SIZE_UNSET || (size & CALL_TRACE_SIZE_OUT)) {
+        call_trace_put<uint8_t>(CALL_TRACE_OUT);
+        call_trace_put<uint64_t>(size == CALL_TRACE_SIZE_UNSET ? CALL_TRACE_DEFAULT_OUT : size & ~CALL_TRACE_SIZE_OUT);
+    } else {
+        call_trace_put<uint8_t>(CALL_TRACE_BLOB);
+        call_trace_put<uint64_t>(size);
+        const auto* bytes = static_cast<const uint8_t*>(pointer);
+        t_args.insert(t_args.end(), bytes, bytes + size);
+    }
+}
+
+// Client memory rules. Pointers into bound buffers stay addresses, client
+// memory is captured when its size follows from the arguments and the
+// shadowed pixel store state.
+
+namespace {
+    using Rule = const CallTraceRule&;
+    using Raw = const uint64_t*;
+    using Sizes = uint64_t*;
+
+    bool bound(GLenum binding) {
+        return find_bound_buffer(binding) != 0;
+    }
+
+    uint64_t index_bytes(uint64_t type) {
+        switch (type) {
+        case GL_UNSIGNED_BYTE:
+            return 1;
+        case GL_UNSIGNED_SHORT:
+            return 2;
+        default:
+            return 4;
+        }
+    }
+
+    uint64_t list_bytes(uint64_t type) {
+        switch (type) {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:
+            return 1;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        case GL_2_BYTES:
+            return 2;
+        case GL_3_BYTES:
+            return 3;
+        default:
+            return 4;
+        }
+    }
+
+    uint64_t pixel_bytes(uint64_t format, uint64_t type) {
+        GLsizei components = 0;
+        switch (format) {
+        case GL_RED_INTEGER:
+        case GL_STENCIL_INDEX:
+            components = 1;
+            break;
+        case GL_RG_INTEGER:
+            components = 2;
+            break;
+        case GL_RGB_INTEGER:
+            components = 3;
+            break;
+        case GL_RGBA_INTEGER:
+        case GL_BGRA_INTEGER:
+            components = 4;
+            break;
+        default:
+            return (uint64_t)pixel_sizeof((GLenum)format, (GLenum)type);
+        }
+        if (is_type_packed((GLenum)type)) components = 1;
+        return (uint64_t)(components * gl_sizeof((GLenum)type));
+    }
+
+    // Bytes an image of this size spans in client memory under a pixel store
+    uint64_t image_bytes(const gl_pixel_store_s& store, uint64_t width, uint64_t height, uint64_t depth,
+                         uint64_t format, uint64_t type, bool volume) {
+        if ((int64_t)width <= 0 || (int64_t)height <= 0 || (int64_t)depth <= 0) return 0;
+        uint64_t pixel = pixel_bytes(format, type);
+        if (pixel == 0) return CALL_TRACE_SIZE_ADDRESS;
+        uint64_t alignment = store.alignment > 0 ? (uint64_t)store.alignment : 4;
+        uint64_t row = widthalign((store.row_length > 0 ? (uint64_t)store.row_length : width) * pixel, alignment);
+        uint64_t size = (store.skip_rows + height - 1) * row + (store.skip_pixels + width) * pixel;
+        if (volume) {
+            uint64_t image = (store.image_height > 0 ? (uint64_t)store.image_height : height) * row;
+            size += (store.skip_images + depth - 1) * image;
+        }
+        return size;
+    }
+
+    uint64_t unpack(uint64_t width, uint64_t height, uint64_t depth, uint64_t format, uint64_t type, bool volume) {
+        if (!gl_state || bound(GL_PIXEL_UNPACK_BUFFER_BINDING)) return CALL_TRACE_SIZE_UNSET;
+        return image_bytes(gl_state->unpack, width, height, depth, format, type, volume);
+    }
+
+    uint64_t pack(uint64_t width, uint64_t height, uint64_t format, uint64_t type) {
+        if (!gl_state || bound(GL_PIXEL_PACK_BUFFER_BINDING)) return CALL_TRACE_SIZE_ADDRESS;
+        uint64_t size = image_bytes(gl_state->pack, width, height, 1, format, type, false);
+        return size == CALL_TRACE_SIZE_ADDRESS ? size : size | CALL_TRACE_SIZE_OUT;
+    }
+
+    uint64_t client_indices(uint64_t count, uint64_t type) {
+        if (bound(GL_ELEMENT_ARRAY_BUFFER_BINDING)) return CALL_TRACE_SIZE_UNSET;
+        return count * index_bytes(type);
+    }
+
+    uint64_t indirect(uint64_t count, uint64_t stride, uint64_t tight) {
+        if (bound(GL_DRAW_INDIRECT_BUFFER_BINDING)) return CALL_TRACE_SIZE_UNSET;
+        return count * (stride ? stride : tight);
+    }
+
+    uint64_t clear_value(uint64_t buffer) {
+        return (buffer == GL_COLOR ? 4 : 1) * 4;
+    }
+
+    uint64_t parameter_values(uint64_t pname) {
+        return (pname == GL_TEXTURE_BORDER_COLOR || pname == GL_TEXTURE_SWIZZLE_RGBA ? 4 : 1) * 4;
+    }
+
+    uint64_t sized_string(uint64_t length) {
+        return (int64_t)length >= 0 ? length : CALL_TRACE_SIZE_UNSET;
+    }
+
+    void names_n1(Rule, Raw a, Sizes s) {
+        s[1] = a[0] * 4;
+    }
+    void names_n2(Rule, Raw a, Sizes s) {
+        s[2] = a[1] * 4;
+    }
+    void gen_names_n1(Rule, Raw a, Sizes s) {
+        s[1] = a[0] * 4 | CALL_TRACE_SIZE_OUT;
+    }
+    void gen_names_n2(Rule, Raw a, Sizes s) {
+        s[2] = a[1] * 4 | CALL_TRACE_SIZE_OUT;
+    }
+    void data_at2(Rule, Raw a, Sizes s) {
+        s[2] = a[1];
+    }
+    void data_at3(Rule, Raw a, Sizes s) {
+        s[3] = a[2];
+    }
+    void read_at3(Rule, Raw a, Sizes s) {
+        s[3] = a[2] | CALL_TRACE_SIZE_OUT;
+    }
+    void parameters(Rule, Raw a, Sizes s) {
+        s[2] = parameter_values(a[1]);
+    }
+    void elements(Rule, Raw a, Sizes s) {
+        s[3] = client_indices(a[1], a[2]);
+    }
+    void range_elements(Rule, Raw a, Sizes s) {
+        s[5] = client_indices(a[3], a[4]);
+    }
+    void clear_buffer(Rule, Raw a, Sizes s) {
+        s[2] = clear_value(a[0]);
+    }
+    void clear_named_framebuffer(Rule, Raw a, Sizes s) {
+        s[3] = clear_value(a[1]);
+    }
+    void clear_data_at4(Rule, Raw a, Sizes s) {
+        s[4] = pixel_bytes(a[2], a[3]);
+    }
+    void clear_data_at6(Rule, Raw a, Sizes s) {
+        s[6] = pixel_bytes(a[4], a[5]);
+    }
+    void matrix_f(Rule, Raw, Sizes s) {
+        s[0] = 16 * sizeof(GLfloat);
+    }
+    void matrix_d(Rule, Raw, Sizes s) {
+        s[0] = 16 * sizeof(GLdouble);
+    }
+    void info_at3(Rule, Raw a, Sizes s) {
+        s[3] = a[1] | CALL_TRACE_SIZE_OUT;
+    }
+    void active_name_at6(Rule, Raw a, Sizes s) {
+        s[6] = a[2] | CALL_TRACE_SIZE_OUT;
+    }
+    void image_handle(Rule, Raw, Sizes s) {
+        s[1] = CALL_TRACE_SIZE_ADDRESS;
+    }
+    void unknown_read_at4(Rule, Raw, Sizes s) {
+        s[4] = CALL_TRACE_SIZE_ADDRESS;
+    }
+    void compressed_at6(Rule, Raw a, Sizes s) {
+        if (!bound(GL_PIXEL_UNPACK_BUFFER_BINDING)) s[6] = a[5];
+    }
+    void compressed_at7(Rule, Raw a, Sizes s) {
+        if (!bound(GL_PIXEL_UNPACK_BUFFER_BINDING)) s[7] = a[6];
+    }
+    void compressed_at8(Rule, Raw a, Sizes s) {
+        if (!bound(GL_PIXEL_UNPACK_BUFFER_BINDING)) s[8] = a[7];
+    }
+    void compressed_at10(Rule, Raw a, Sizes s) {
+        if (!bound(GL_PIXEL_UNPACK_BUFFER_BINDING)) s[10] = a[9];
+    }
+    void sub_image_1d(Rule, Raw a, Sizes s) {
+        s[6] = unpack(a[3], 1, 1, a[4], a[5], false);
+    }
+    void sub_image_2d(Rule, Raw a, Sizes s) {
+        s[8] = unpack(a[4], a[5], 1, a[6], a[7], false);
+    }
+    void sub_image_3d(Rule, Raw a, Sizes s) {
+        s[10] = unpack(a[5], a[6], a[7], a[8], a[9], true);
+    }
+
+    struct NamedRule {
+        const char* name;
+        size_t argc;
+        void (*sizes)(Rule, Raw, Sizes);
+    };
+
+    const NamedRule kRules[] = {
+        // Buffers
+        {"glBufferData", 4, data_at2},
+        {"glBufferStorage", 4, data_at2},
+        {"glNamedBufferData", 4, data_at2},
+        {"glNamedBufferStorage", 4, data_at2},
+        {"glBufferSubData", 4, data_at3},
+        {"glNamedBufferSubData", 4, data_at3},
+        {"glGetBufferSubData", 4, read_at3},
+        {"glGetNamedBufferSubData", 4, read_at3},
+        {"glClearBufferData", 5, clear_data_at4},
+        {"glClearNamedBufferData", 5, clear_data_at4},
+        {"glClearBufferSubData", 7, clear_data_at6},
+        {"glClearNamedBufferSubData", 7, clear_data_at6},
+
+        // Arrays of names and enums
+        {"glGenBuffers", 2, gen_names_n1},
+        {"glGenTextures", 2, gen_names_n1},
+        {"glGenFramebuffers", 2, gen_names_n1},
+        {"glGenRenderbuffers", 2, gen_names_n1},
+        {"glGenVertexArrays", 2, gen_names_n1},
+        {"glGenQueries", 2, gen_names_n1},
+        {"glGenSamplers", 2, gen_names_n1},
+        {"glGenTransformFeedbacks", 2, gen_names_n1},
+        {"glGenProgramPipelines", 2, gen_names_n1},
+        {"glCreateBuffers", 2, gen_names_n1},
+        {"glCreateFramebuffers", 2, gen_names_n1},
+        {"glCreateRenderbuffers", 2, gen_names_n1},
+        {"glCreateVertexArrays", 2, gen_names_n1},
+        {"glCreateSamplers", 2, gen_names_n1},
+        {"glCreateProgramPipelines", 2, gen_names_n1},
+        {"glCreateTransformFeedbacks", 2, gen_names_n1},
+        {"glCreateTextures", 3, gen_names_n2},
+        {"glCreateQueries", 3, gen_names_n2},
+        {"glDeleteBuffers", 2, names_n1},
+        {"glDeleteTextures", 2, names_n1},
+        {"glDeleteFramebuffers", 2, names_n1},
+        {"glDeleteRenderbuffers", 2, names_n1},
+        {"glDeleteVertexArrays", 2, names_n1},
+        {"glDeleteQueries", 2, names_n1},
+        {"glDeleteSamplers", 2, names_n1},
+        {"glDeleteTransformFeedbacks", 2, names_n1},
+        {"glDeleteProgramPipelines", 2, names_n1},
+        {"glDrawBuffers", 2, names_n1},
+        {"glInvalidateFramebuffer", 3, names_n2},
+        {"glInvalidateSubFramebuffer", 7, names_n2},
+        {"glInvalidateNamedFramebufferData", 3, names_n2},
+        {"glNamedFramebufferDrawBuffers", 3, names_n2},
+        {"glBindTextures", 3, names_n2},
+        {"glBindSamplers", 3, names_n2},
+        {"glBindImageTextures", 3, names_n2},
+        {"glBindBuffersBase", 4,
+         [](Rule, Raw a, Sizes s) { s[3] = a[2] * 4; }},
+        {"glBindBuffersRange", 6,
+         [](Rule, Raw a, Sizes s) {
+             s[3] = a[2] * 4;
+             s[4] = s[5] = a[2] * sizeof(GLintptr);
+         }},
+        {"glBindVertexBuffers", 5,
+         [](Rule, Raw a, Sizes s) {
+             s[2] = s[4] = a[1] * 4;
+             s[3] = a[1] * sizeof(GLintptr);
+         }},
+        {"glDebugMessageControl", 6,
+         [](Rule, Raw a, Sizes s) { s[4] = a[3] * 4; }},
+
+        // Pixels
+        {"glTexImage1D", 8,
+         [](Rule, Raw a, Sizes s) { s[7] = unpack(a[3], 1, 1, a[5], a[6], false); }},
+        {"glTexImage2D", 9,
+         [](Rule, Raw a, Sizes s) { s[8] = unpack(a[3], a[4], 1, a[6], a[7], false); }},
+        {"glTexImage3D", 10,
+         [](Rule, Raw a, Sizes s) { s[9] = unpack(a[3], a[4], a[5], a[7], a[8], true); }},
+        {"glTexSubImage1D", 7, sub_image_1d},
+        {"glTexSubImage2D", 9, sub_image_2d},
+        {"glTexSubImage3D", 11, sub_image_3d},
+        {"glTextureSubImage1D", 7, sub_image_1d},
+        {"glTextureSubImage2D", 9, sub_image_2d},
+        {"glTextureSubImage3D", 11, sub_image_3d},
+        {"glCompressedTexImage1D", 7, compressed_at6},
+        {"glCompressedTexSubImage1D", 7, compressed_at6},
+        {"glCompressedTextureSubImage1D", 7, compressed_at6},
+        {"glCompressedTexImage2D", 8, compressed_at7},
+        {"glCompressedTexSubImage2D", 9, compressed_at8},
+        {"glCompressedTextureSubImage2D", 9, compressed_at8},
+        {"glCompressedTexImage3D", 9, compressed_at8},
+        {"glCompressedTexSubImage3D", 11, compressed_at10},
+        {"glCompressedTextureSubImage3D", 11, compressed_at10},
+        {"glClearTexImage", 5, clear_data_at4},
+        {"glClearTexSubImage", 11,
+         [](Rule, Raw a, Sizes s) { s[10] = pixel_bytes(a[8], a[9]); }},
+        {"glReadPixels", 7,
+         [](Rule, Raw a, Sizes s) { s[6] = pack(a[2], a[3], a[4], a[5]); }},
+        {"glReadnPixels", 8,
+         [](Rule, Raw a, Sizes s) {
+             s[7] = bound(GL_PIXEL_PACK_BUFFER_BINDING) ? CALL_TRACE_SIZE_ADDRESS : a[6] | CALL_TRACE_SIZE_OUT;
+         }},
+        // Their size depends on the texture, so they are not replayed
+        {"glGetTexImage", 5, unknown_read_at4},
+        {"glGetTextureImage", 6,
+         [](Rule, Raw, Sizes s) { s[5] = CALL_TRACE_SIZE_ADDRESS; }},
+        {"glGetCompressedTexImage", 3,
+         [](Rule, Raw, Sizes s) { s[2] = CALL_TRACE_SIZE_ADDRESS; }},
+
+        // Draws
+        {"glDrawElements", 4, elements},
+        {"glDrawElementsBaseVertex", 5, elements},
+        {"glDrawElementsInstanced", 5, elements},
+        {"glDrawElementsInstancedBaseVertex", 6, elements},
+        {"glDrawRangeElements", 6, range_elements},
+        {"glDrawRangeElementsBaseVertex", 7, range_elements},
+        {"glMultiDrawArrays", 4,
+         [](Rule, Raw a, Sizes s) { s[1] = s[2] = a[3] * 4; }},
+        {"glMultiDrawElements", 5,
+         [](Rule, Raw a, Sizes s) {
+             s[1] = a[4] * 4;
+             // Offsets into the element buffer; client index arrays are not captured
+             if (bound(GL_ELEMENT_ARRAY_BUFFER_BINDING)) s[3] = a[4] * sizeof(void*);
+         }},
+        {"glMultiDrawElementsBaseVertex", 6,
+         [](Rule, Raw a, Sizes s) {
+             s[1] = s[5] = a[4] * 4;
+             if (bound(GL_ELEMENT_ARRAY_BUFFER_BINDING)) s[3] = a[4] * sizeof(void*);
+         }},
+        {"glDrawArraysIndirect", 2,
+         [](Rule, Raw, Sizes s) { s[1] = indirect(1, 0, 4 * sizeof(GLuint)); }},
+        {"glDrawElementsIndirect", 3,
+         [](Rule, Raw, Sizes s) { s[2] = indirect(1, 0, 5 * sizeof(GLuint)); }},
+        {"glMultiDrawArraysIndirect", 4,
+         [](Rule, Raw a, Sizes s) { s[1] = indirect(a[2], a[3], 4 * sizeof(GLuint)); }},
+        {"glMultiDrawElementsIndirect", 5,
+         [](Rule, Raw a, Sizes s) { s[2] = indirect(a[3], a[4], 5 * sizeof(GLuint)); }},
+
+        // Clears and parameters
+        {"glClearBufferiv", 3, clear_buffer},
+        {"glClearBufferuiv", 3, clear_buffer},
+        {"glClearBufferfv", 3, clear_buffer},
+        {"glClearNamedFramebufferiv", 4, clear_named_framebuffer},
+        {"glClearNamedFramebufferuiv", 4, clear_named_framebuffer},
+        {"glClearNamedFramebufferfv", 4, clear_named_framebuffer},
+        {"glTexParameterfv", 3, parameters},
+        {"glTexParameteriv", 3, parameters},
+        {"glTexParameterIiv", 3, parameters},
+        {"glTexParameterIuiv", 3, parameters},
+        {"glTextureParameterfv", 3, parameters},
+        {"glTextureParameteriv", 3, parameters},
+        {"glTextureParameterIiv", 3, parameters},
+        {"glTextureParameterIuiv", 3, parameters},
+        {"glSamplerParameterfv", 3, parameters},
+        {"glSamplerParameteriv", 3, parameters},
+        {"glSamplerParameterIiv", 3, parameters},
+        {"glSamplerParameterIuiv", 3, parameters},
+        {"glLoadMatrixf", 1, matrix_f},
+        {"glMultMatrixf", 1, matrix_f},
+        {"glLoadTransposeMatrixf", 1, matrix_f},
+        {"glMultTransposeMatrixf", 1, matrix_f},
+        {"glLoadMatrixd", 1, matrix_d},
+        {"glMultMatrixd", 1, matrix_d},
+        {"glLoadTransposeMatrixd", 1, matrix_d},
+        {"glMultTransposeMatrixd", 1, matrix_d},
+        {"glCallLists", 3,
+         [](Rule, Raw a, Sizes s) { s[2] = a[0] * list_bytes(a[1]); }},
+
+        // Shaders and programs
+        {"glShaderSource", 4,
+         [](Rule, Raw a, Sizes s) {
+             s[2] = a[1];
+             if (a[3]) s[3] = a[1] * 4;
+             t_string_lengths = (const GLint*)(uintptr_t)a[3];
+         }},
+        {"glCreateShaderProgramv", 3,
+         [](Rule, Raw a, Sizes s) { s[2] = a[1]; }},
+        {"glTransformFeedbackVaryings", 4,
+         [](Rule, Raw a, Sizes s) { s[2] = a[1]; }},
+        {"glGetUniformIndices", 4,
+         [](Rule, Raw a, Sizes s) {
+             s[2] = a[1];
+             s[3] = a[1] * 4 | CALL_TRACE_SIZE_OUT;
+         }},
+        {"glProgramBinary", 4,
+         [](Rule, Raw a, Sizes s) { s[2] = a[3]; }},
+        {"glShaderBinary", 5,
+         [](Rule, Raw a, Sizes s) {
+             s[1] = a[0] * 4;
+             s[3] = a[4];
+         }},
+        {"glGetProgramBinary", 5,
+         [](Rule, Raw a, Sizes s) { s[4] = a[1] | CALL_TRACE_SIZE_OUT; }},
+        {"glGetShaderInfoLog", 4, info_at3},
+        {"glGetProgramInfoLog", 4, info_at3},
+        {"glGetShaderSource", 4, info_at3},
+        {"glGetActiveUniform", 7, active_name_at6},
+        {"glGetActiveAttrib", 7, active_name_at6},
+        {"glGetTransformFeedbackVarying", 7, active_name_at6},
+        {"glGetActiveUniformBlockName", 5,
+         [](Rule, Raw a, Sizes s) { s[4] = a[2] | CALL_TRACE_SIZE_OUT; }},
+
+        // Labels with an explicit length
+        {"glObjectLabel", 4,
+         [](Rule, Raw a, Sizes s) { s[3] = sized_string(a[2]); }},
+        {"glPushDebugGroup", 4,
+         [](Rule, Raw a, Sizes s) { s[3] = sized_string(a[2]); }},
+        {"glDebugMessageInsert", 6,
+         [](Rule, Raw a, Sizes s) { s[5] = sized_string(a[4]); }},
+
+        // EGL images are handles of the capturing process
+        {"glEGLImageTargetTexture2DOES", 2, image_handle},
+        {"glEGLImageTargetRenderbufferStorageOES", 2, image_handle},
+    };
+
+    // Vector forms: glVertex3fv, glColor4ubv, glVertexAttrib4Nubv,
+    // glUniform2iv, glUniformMatrix4x3fv, glProgramUniform4fv, ...
+    void vectors(Rule rule, Raw a, Sizes s) {
+        uint64_t count = rule.count >= 0 ? a[rule.count] : 1;
+        s[rule.pointer] = count * rule.bytes;
+    }
+
+    CallTraceRule vector_rule(std::string_view name, size_t argc) {
+        CallTraceRule rule;
+        if (argc == 0 || name.substr(0, 5) == "glGet") return rule;
+        // Vendor suffix
+        while (!name.empty() && name.back() >= 'A' && name.back() <= 'Z')
+            name.remove_suffix(1);
+        if (name.size() < 4 || name.back() != 'v') return rule;
+        name.remove_suffix(1);
+
+        static const std::pair<std::string_view, uint32_t> kTypes[] = {
+            {"ui64", 8}, {"i64", 8}, {"ub", 1}, {"us", 2}, {"ui", 4}, {"b", 1},
+            {"s", 2},    {"i", 4},   {"f", 4},  {"d", 8},
+        };
+        uint32_t bytes = 0;
+        for (const auto& [suffix, size] : kTypes) {
+            if (name.size() > suffix.size() && name.substr(name.size() - suffix.size()) == suffix) {
+                name.remove_suffix(suffix.size());
+                bytes = size;
+                break;
+            }
+        }
+        if (!bytes) return rule;
+        if (name.back() == 'N') name.remove_suffix(1);
+
+        uint32_t components = 0;
+        bool matrix = false;
+        if (name.size() > 9 && name[name.size() - 2] == 'x' && name.substr(name.size() - 9, 6) == "Matrix") {
+            // MatrixCxR
+            components = (uint32_t)(name[name.size() - 3] - '0') * (uint32_t)(name.back() - '0');
+            matrix = true;
+        } else if (name.size() > 7 && name.substr(name.size() - 7, 6) == "Matrix") {
+            components = (uint32_t)(name.back() - '0') * (uint32_t)(name.back() - '0');
+            matrix = true;
+        } else if (name.back() >= '1' && name.back() <= '4' && name[name.size() - 2] != 'P') {
+            // Packed forms (glVertexAttribP4uiv) hold one value
+            components = (uint32_t)(name.back() - '0');
+        }
+        if (components == 0 || components > 16) return rule;
+
+        bool uniform = name.find("Uniform") != std::string_view::npos;
+        int pointer = (int)argc - 1;
+        int count = uniform ? pointer - (matrix ? 2 : 1) : -1;
+        if (count < -1 || (uniform && count < 0)) return rule;
+
+        rule.sizes = vectors;
+        rule.pointer = pointer;
+        rule.count = count;
+        rule.bytes = components * bytes;
+        return rule;
+    }
+} // namespace
+
+CallTraceRule call_trace_rule(const char* name, size_t argc) {
+    static const auto rules = [] {
+        ankerl::unordered_dense::map<std::string_view, const NamedRule*> map;
+        for (const NamedRule& rule : kRules)
+            map.emplace(rule.name, &rule);
+        return map;
+    }();
+
+    auto it = rules.find(name);
+    if (it != rules.end()) {
+        CallTraceRule rule;
+        // A signature that does not match the table is left uncaptured
+        if (it->second->argc == argc) rule.sizes = it->second->sizes;
+        return rule;
+    }
+    return vector_rule(name, argc);
+}
+
+#if MG_CALL_TRACE_REPLAY
+
+// Replay
+
+namespace {
+    std::vector<std::pair<const char*, CallTraceReplayFn>>& replay_registry() {
+        static std::vector<std::pair<const char*, CallTraceReplayFn>> registry;
+        return registry;
+    }
+} // namespace
+
+bool call_trace_register(const char* name, CallTraceReplayFn replay) {
+    replay_registry().emplace_back(name, replay);
+    return true;
+}
+
+bool CallTracePointerArg::read(CallTraceReader& in, Kind kind) {
+    switch (kind) {
+    case Sync:
+    case Callback: {
+        uint64_t value;
+        if (!in.read(&value, sizeof(value))) return false;
+        // Callbacks are dropped. Syncs of the capture mean nothing here.
+        return kind == Callback || value == 0;
+    }
+    case String: {
+        uint32_t length;
+        if (!in.read(&length, sizeof(length))) return false;
+        if (length == CALL_TRACE_NULL_STRING) return true;
+        if ((size_t)(in.end - in.pos) < length) return false;
+        strings.emplace_back((const char*)in.pos, length);
+        in.pos += length;
+        address = (uintptr_t)strings.back().c_str();
+        return true;
+    }
+    case Strings: {
+        uint32_t count;
+        if (!in.read(&count, sizeof(count))) return false;
+        if (count == CALL_TRACE_NULL_STRING) return true;
+        if (count == CALL_TRACE_UNCAPTURED_STRINGS || (size_t)(in.end - in.pos) / sizeof(uint32_t) < count)
+            return false;
+        strings.reserve(count);
+        std::vector<bool> null(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t length;
+            if (!in.read(&length, sizeof(length))) return false;
+            null[i] = length == CALL_TRACE_NULL_STRING;
+            if (null[i]) length = 0;
+            if ((size_t)(in.end - in.pos) < length) return false;
+            strings.emplace_back((const char*)in.pos, length);
+            in.pos += length;
+        }
+        for (uint32_t i = 0; i < count; ++i)
+            pointers.push_back(null[i] ? nullptr : strings[i].c_str());
+        address = (uintptr_t)pointers.data();
+        return true;
+    }
+    case Data:
+        break;
+    }
+
+    uint8_t type;
+    uint64_t value;
+    if (!in.read(&type, sizeof(type)) || !in.read(&value, sizeof(value))) return false;
+    switch (type) {
+    case CALL_TRACE_ADDRESS:
+        // Client memory of the capturing process that was not captured
+        if (value >= in.client_floor) return false;
+        address = (uintptr_t)value;
+        return true;
+    case CALL_TRACE_BLOB:
+        if ((uint64_t)(in.end - in.pos) < value) return false;
+        data.resize(value / sizeof(uint64_t) + 1);
+        memcpy(data.data(), in.pos, value);
+        in.pos += value;
+        address = (uintptr_t)data.data();
+        return true;
+    case CALL_TRACE_OUT:
+        if (value > (1u << 31)) return false;
+        data.assign(value / sizeof(uint64_t) + 1, 0);
+        address = (uintptr_t)data.data();
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool call_trace_replay(const char* path, CallTraceReplayStats& stats, const std::function<void()>& on_frame,
+                       std::string& error) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+    std::vector<uint8_t> trace;
+    uint8_t chunk[64 * 1024];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        trace.insert(trace.end(), chunk, chunk + got);
+    fclose(file);
+
+    uint32_t header[2];
+    if (trace.size() < 12 || memcmp(trace.data(), "MGCT", 4) != 0) {
+        error = "not a call trace";
+        return false;
+    }
+    memcpy(header, trace.data() + 4, sizeof(header));
+    if (header[0] != CALL_TRACE_VERSION) {
+        error = "call trace version " + std::to_string(header[0]) + ", expected " +
+                std::to_string(CALL_TRACE_VERSION);
+        return false;
+    }
+
+    ankerl::unordered_dense::map<std::string_view, CallTraceReplayFn> replays;
+    for (const auto& [name, fn] : replay_registry())
+        replays.emplace(name, fn);
+
+    // 64-bit processes never place client memory in the low 4 GiB
+    CallTraceReader in{trace.data() + 12, trace.data() + trace.size(), header[1] == 8 ? 1ull << 32 : 1ull << 24};
+    std::vector<CallTraceReplayFn> fns;
+    uint64_t frame_ns = 0;
+
+    while (in.pos < in.end) {
+        uint8_t type = *in.pos++;
+        if (type == CALL_TRACE_NAME) {
+            uint16_t id, length;
+            if (!in.read(&id, sizeof(id)) || !in.read(&length, sizeof(length)) ||
+                (size_t)(in.end - in.pos) < length) {
+                break;
+            }
+            std::string name((const char*)in.pos, length);
+            in.pos += length;
+            if (id >= stats.entries.size()) {
+                stats.entries.resize(id + 1);
+                fns.resize(id + 1);
+            }
+            auto it = replays.find(name);
+            fns[id] = it != replays.end() ? it->second : nullptr;
+            stats.entries[id].name = std::move(name);
+        } else if (type == CALL_TRACE_FRAME) {
+            uint64_t ns;
+            if (!in.read(&ns, sizeof(ns))) break;
+            uint64_t start = call_trace_now();
+            if (on_frame) on_frame();
+            frame_ns = call_trace_now() - start;
+            stats.frames++;
+        } else if (type == CALL_TRACE_CALL) {
+            uint16_t id;
+            uint32_t thread, duration, size;
+            uint64_t start;
+            uint8_t depth;
+            if (!in.read(&id, sizeof(id)) || !in.read(&thread, sizeof(thread)) || !in.read(&start, sizeof(start)) ||
+                !in.read(&duration, sizeof(duration)) || !in.read(&depth, sizeof(depth)) ||
+                !in.read(&size, sizeof(size))) {
+                break;
+            }
+            uint32_t skip = size == CALL_TRACE_NO_ARGS ? 0 : size;
+            if ((size_t)(in.end - in.pos) < skip || id >= stats.entries.size()) break;
+            CallTraceReader args{in.pos, in.pos + skip, in.client_floor};
+            in.pos += skip;
+            // Calls made by MobileGlues itself come back through their caller
+            if (depth != 0) continue;
+
+            CallTraceReplayEntryStats& entry = stats.entries[id];
+            entry.calls++;
+            stats.calls++;
+            uint64_t ns = 0;
+            if (entry.name == "eglSwapBuffers") {
+                // Replayed by the frame marker it wrote
+                ns = frame_ns;
+            } else if (size == CALL_TRACE_NO_ARGS) {
+                stats.no_args++;
+                continue;
+            } else if (!fns[id]) {
+                stats.unknown++;
+                continue;
+            } else if (!fns[id](args, ns)) {
+                stats.unreplayable++;
+                continue;
+            }
+            entry.replayed++;
+            entry.captured_ns += duration;
+            entry.replayed_ns += ns;
+            stats.replayed++;
+        } else {
+            error = "corrupt record at offset " + std::to_string(in.pos - 1 - trace.data());
+            return false;
+        }
+    }
+    if (in.pos < in.end) {
+        error = "truncated trace";
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,311 @@
+// MobileGlues - gl/call_trace.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_CALL_TRACE_H
+#define MOBILEGLUES_CALL_TRACE_H
+
+#include <GLES3/gl32.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Opt-in call trace (enableCallTrace). Every entry point that goes through
+// LOG() or NATIVE_FUNCTION_HEAD is timed and appended to
+// <MG_DIR>/call_trace.bin, which is flushed once per eglSwapBuffers. Entry
+// points that also use MG_TRACE_ARGS record their arguments and the client
+// memory they read, so the trace can be replayed (tests/tools/mg_replay).
+//
+// File layout, little endian:
+//   "MGCT" u32 version, u32 pointer size of the capturing process
+//   then records, each starting with a u8 type:
+//     CALL_TRACE_NAME   u16 id, u16 length, name bytes (first use of an id)
+//     CALL_TRACE_CALL   u16 id, u32 thread, u64 start ns, u32 duration ns,
+//                       u8 depth, u32 argument bytes, argument bytes
+//     CALL_TRACE_FRAME  u64 ns
+// Times are relative to the start of the capture. Durations are inclusive,
+// so a wrapper that calls another wrapper is also counted in the inner one;
+// depth is 0 for calls made by the application. A call without
+// MG_TRACE_ARGS has CALL_TRACE_NO_ARGS as its argument size.
+//
+// Arguments are stored in order. Values are stored as is. const char* is a
+// u32 length (CALL_TRACE_NULL_STRING for nullptr) and the bytes, arrays of
+// strings a u32 count (CALL_TRACE_NULL_STRING) and a string per element.
+// GLsync and function pointers are a u64 handle. Other pointers are a u8
+// CallTracePointer kind followed by its payload.
+
+#define CALL_TRACE_VERSION 2
+
+#define CALL_TRACE_NO_ARGS UINT32_MAX
+#define CALL_TRACE_NULL_STRING UINT32_MAX
+
+// Client memory behind a pointer argument, as set by the rules in
+// call_trace.cpp. Unset pointers to const are stored as an address and
+// other unset pointers as an output of CALL_TRACE_DEFAULT_OUT bytes.
+#define CALL_TRACE_SIZE_UNSET UINT64_MAX
+#define CALL_TRACE_SIZE_OUT (1ull << 63)
+#define CALL_TRACE_SIZE_ADDRESS (1ull << 62)
+#define CALL_TRACE_DEFAULT_OUT (64 * 1024)
+
+enum CallTraceRecord : uint8_t {
+    CALL_TRACE_NAME = 1,
+    CALL_TRACE_CALL = 2,
+    CALL_TRACE_FRAME = 3,
+};
+
+enum CallTracePointer : uint8_t {
+    CALL_TRACE_ADDRESS = 0, // u64 value: an offset into a bound buffer, or client memory that was not captured
+    CALL_TRACE_BLOB = 1,    // u64 size, bytes the call reads
+    CALL_TRACE_OUT = 2,     // u64 size of the memory the call writes
+};
+
+extern bool g_call_trace_enabled;
+
+void init_call_trace();
+// Starts writing a trace to path, replacing a running one
+bool call_trace_start(const char* path);
+// Writes out what is buffered and closes the trace
+void call_trace_stop();
+uint64_t call_trace_now();
+void call_trace_record(const char* name, uint64_t start, uint64_t end, uint8_t depth, const uint8_t* args,
+                       uint32_t args_size);
+
+// Marks the end of a frame and writes the buffered records out.
+void call_trace_frame();
+
+// Per entry point call counts and total time, slowest first
+std::string dump_call_trace_stats(const std::string& prefix = "");
+
+void call_trace_put_bytes(const void* bytes, size_t size);
+
+template <typename T> inline void call_trace_put(const T& value) {
+    call_trace_put_bytes(&value, sizeof(T));
+}
+
+void call_trace_put_string(const char* string, uint64_t size);
+void call_trace_put_strings(const char* const* strings, uint64_t count);
+void call_trace_put_pointer(const void* pointer, uint64_t size, bool writable);
+
+// Pointers the callee never dereferences on the client side
+template <typename T>
+inline constexpr bool call_trace_is_handle =
+    std::is_same_v<T, GLsync> || std::is_function_v<std::remove_pointer_t<T>>;
+
+template <typename T>
+inline constexpr bool call_trace_is_strings =
+    std::is_same_v<T, const GLchar* const*> || std::is_same_v<T, const GLchar**>;
+
+// An argument widened to 64 bits for the size rules; floats as their bits
+template <typename T> inline uint64_t call_trace_raw(T value) {
+    if constexpr (std::is_pointer_v<T>) {
+        return (uint64_t)(uintptr_t)value;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if constexpr (sizeof(T) == 4) {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        } else {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+    } else {
+        return (uint64_t)(int64_t)value;
+    }
+}
+
+template <typename T> inline void call_trace_put_arg(T value, uint64_t size) {
+    if constexpr (!std::is_pointer_v<T>) {
+        call_trace_put(value);
+    } else if constexpr (std::is_same_v<T, const GLchar*>) {
+        call_trace_put_string(value, size);
+    } else if constexpr (call_trace_is_strings<T>) {
+        call_trace_put_strings(value, size);
+    } else if constexpr (call_trace_is_handle<T>) {
+        call_trace_put<uint64_t>((uint64_t)(uintptr_t)value);
+    } else {
+        call_trace_put_pointer((const void*)value, size, !std::is_const_v<std::remove_pointer_t<T>>);
+    }
+}
+
+// How much client memory an entry point reads or writes through its
+// pointer arguments. raw holds the arguments widened by call_trace_raw,
+// sizes receives a CALL_TRACE_SIZE_* value per argument.
+struct CallTraceRule {
+    void (*sizes)(const CallTraceRule& rule, const uint64_t* raw, uint64_t* sizes) = nullptr;
+    int pointer = -1; // argument read by the vector forms (glUniform4fv, glVertex3fv, ...)
+    int count = -1;   // argument holding the number of vectors, or -1 for one
+    uint32_t bytes = 0;
+};
+
+CallTraceRule call_trace_rule(const char* name, size_t argc);
+
+// Name of an entry point as a template argument
+template <size_t N> struct CallTraceName {
+    constexpr CallTraceName(const char (&string)[N]) { std::copy_n(string, N, value); }
+    char value[N];
+};
+
+#if MG_CALL_TRACE_REPLAY
+struct CallTraceReader {
+    const uint8_t* pos;
+    const uint8_t* end;
+    uint64_t client_floor; // addresses from here up were client memory
+
+    bool read(void* out, size_t size) {
+        if ((size_t)(end - pos) < size) return false;
+        memcpy(out, pos, size);
+        pos += size;
+        return true;
+    }
+};
+
+// Storage for a decoded pointer argument, alive for the replayed call
+struct CallTracePointerArg {
+    enum Kind { Data, String, Strings, Sync, Callback };
+
+    uintptr_t address = 0;
+    std::vector<uint64_t> data;
+    std::vector<std::string> strings;
+    std::vector<const char*> pointers;
+
+    bool read(CallTraceReader& in, Kind kind);
+};
+
+template <typename T, typename = void> struct CallTraceArg {
+    T value;
+    bool read(CallTraceReader& in) { return in.read(&value, sizeof(T)); }
+    T get() const { return value; }
+};
+
+template <typename T> struct CallTraceArg<T, std::enable_if_t<std::is_pointer_v<T>>> {
+    CallTracePointerArg storage;
+    bool read(CallTraceReader& in) {
+        if constexpr (std::is_same_v<T, const GLchar*>)
+            return storage.read(in, CallTracePointerArg::String);
+        else if constexpr (call_trace_is_strings<T>)
+            return storage.read(in, CallTracePointerArg::Strings);
+        else if constexpr (std::is_same_v<T, GLsync>)
+            return storage.read(in, CallTracePointerArg::Sync);
+        else if constexpr (std::is_function_v<std::remove_pointer_t<T>>)
+            return storage.read(in, CallTracePointerArg::Callback);
+        else
+            return storage.read(in, CallTracePointerArg::Data);
+    }
+    T get() const { return (T)storage.address; }
+};
+
+// Decodes the arguments of one call and makes it; false if the call cannot
+// be replayed. ns receives the time spent in the entry point.
+typedef bool (*CallTraceReplayFn)(CallTraceReader& in, uint64_t& ns);
+
+bool call_trace_register(const char* name, CallTraceReplayFn replay);
+
+struct CallTraceReplayEntryStats {
+    std::string name;
+    uint64_t calls = 0; // made by the application
+    uint64_t replayed = 0;
+    uint64_t captured_ns = 0; // of the replayed calls
+    uint64_t replayed_ns = 0;
+};
+
+struct CallTraceReplayStats {
+    std::vector<CallTraceReplayEntryStats> entries; // by trace name id
+    uint64_t frames = 0;
+    uint64_t calls = 0;
+    uint64_t replayed = 0;
+    uint64_t unreplayable = 0; // read client memory that was not captured, or a sync
+    uint64_t no_args = 0;      // entry points without MG_TRACE_ARGS
+    uint64_t unknown = 0;      // entry points this build does not have
+};
+
+// Replays the calls the application made through the entry points of this
+// process, in trace order on the calling thread. on_frame runs at every
+// frame marker in place of eglSwapBuffers. Object names are not remapped,
+// so the trace has to start at the beginning of the process, as
+// enableCallTrace does, and be replayed into a fresh one.
+bool call_trace_replay(const char* path, CallTraceReplayStats& stats, const std::function<void()>& on_frame,
+                       std::string& error);
+#endif
+
+template <auto Fn> struct CallTraceSignature;
+
+template <typename R, typename... A, R (*Fn)(A...)> struct CallTraceSignature<Fn> {
+    // Out of line, so the entry points only carry the call
+    __attribute__((noinline, cold)) static void put(const char* name, std::type_identity_t<A>... args) {
+        static const CallTraceRule rule = call_trace_rule(name, sizeof...(A));
+        uint64_t sizes[sizeof...(A) + 1];
+        std::fill(std::begin(sizes), std::end(sizes), CALL_TRACE_SIZE_UNSET);
+        if (rule.sizes) {
+            const uint64_t raw[sizeof...(A) + 1] = {call_trace_raw(args)...};
+            rule.sizes(rule, raw, sizes);
+        }
+        size_t i = 0;
+        (call_trace_put_arg(args, sizes[i++]), ...);
+        (void)i;
+    }
+
+#if MG_CALL_TRACE_REPLAY
+    static bool replay(CallTraceReader& in, uint64_t& ns) {
+        std::tuple<CallTraceArg<A>...> args;
+        if (!std::apply([&](auto&... arg) { return (arg.read(in) && ...); }, args) || in.pos != in.end) return false;
+        uint64_t start = call_trace_now();
+        std::apply([](const auto&... arg) { Fn(arg.get()...); }, args);
+        ns = call_trace_now() - start;
+        return true;
+    }
+#endif
+};
+
+#if MG_CALL_TRACE_REPLAY
+template <auto Fn, CallTraceName Name> struct CallTraceReplayEntry {
+    static inline const bool registered = call_trace_register(Name.value, &CallTraceSignature<Fn>::replay);
+};
+#endif
+
+class CallTraceScope {
+public:
+    explicit CallTraceScope(const char* name) : m_name(name) {
+        if (__builtin_expect(g_call_trace_enabled, 0)) begin();
+    }
+    ~CallTraceScope() {
+        if (__builtin_expect(m_start != 0, 0)) end();
+    }
+
+    template <auto Fn, CallTraceName Name, typename... T> void args(const T&... values) {
+#if MG_CALL_TRACE_REPLAY
+        (void)CallTraceReplayEntry<Fn, Name>::registered;
+#endif
+        if (__builtin_expect(m_start != 0, 0)) {
+            CallTraceSignature<Fn>::put(Name.value, values...);
+            m_has_args = true;
+        }
+    }
+
+    CallTraceScope(const CallTraceScope&) = delete;
+    CallTraceScope& operator=(const CallTraceScope&) = delete;
+
+private:
+    void begin();
+    void end();
+
+    const char* m_name;
+    uint64_t m_start = 0;
+    uint32_t m_args_begin = 0;
+    bool m_has_args = false;
+};
+
+#define MG_TRACE_CALL() CallTraceScope _mg_call_trace_scope_(__func__);
+
+// Records the arguments of the entry point fn for replay. Follows LOG().
+#define MG_TRACE_ARGS(fn, ...) _mg_call_trace_scope_.args<&fn, #fn>(__VA_ARGS__);
+
+#endif // MOBILEGLUES_CALL_TRACE_H
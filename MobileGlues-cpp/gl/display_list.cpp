@@ -0,0 +1,348 @@
+// MobileGlues - gl/display_list.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "display_list.h"
+#include "fixed_function.h"
+#include "immediate.h"
+#include "log.h"
+#include "mg.h"
+#include "state.h"
+#include "../gles/loader.h"
+
+#include <ankerl/unordered_dense.h>
+#include <cstring>
+#include <vector>
+
+#define DEBUG 0
+
+// GL_MAX_LIST_NESTING, as desktop implementations report it
+#define MAX_LIST_NESTING 64
+
+bool g_list_recording = false;
+bool g_list_execute = false;
+
+namespace {
+    struct DisplayList {
+        std::vector<uint32_t> commands;
+        immediate_baked_t baked;
+    };
+
+    struct CompilingList {
+        GLuint name = 0;
+        DisplayList list;
+        std::vector<immediate_vertex_t> vertices;
+        // Word offset of the last command if it is a DrawBaked that the next
+        // primitive may extend
+        size_t lastDraw = SIZE_MAX;
+    };
+
+    ankerl::unordered_dense::map<GLuint, DisplayList> g_lists;
+    CompilingList g_compiling;
+    GLuint g_next_list = 1;
+    GLuint g_list_base = 0;
+    GLuint g_list_depth = 0;
+
+    void release_list(DisplayList& list) {
+        if (list.baked.vao) GLES.glDeleteVertexArrays(1, &list.baked.vao);
+        if (list.baked.vbo) GLES.glDeleteBuffers(1, &list.baked.vbo);
+        list.baked = immediate_baked_t();
+    }
+
+    void append(ListOp op, const uint32_t* args, size_t count) {
+        auto& commands = g_compiling.list.commands;
+        commands.push_back((uint32_t)op);
+        commands.insert(commands.end(), args, args + count);
+        g_compiling.lastDraw = SIZE_MAX;
+    }
+
+    void append(ListOp op, std::initializer_list<uint32_t> args) {
+        append(op, args.begin(), args.size());
+    }
+
+    // Records the current attributes the list changed since they were last
+    // recorded. They are only needed before a command that could observe
+    // them, so primitives in between still merge into one draw.
+    void record_attribs() {
+        const immediate_vertex_t* values;
+        for (GLbitfield dirty = immediate_list_take_dirty(&values); dirty; dirty &= dirty - 1) {
+            GLuint attrib = __builtin_ctz(dirty);
+            const GLfloat* v = attrib == IMMEDIATE_ATTRIB_COLOR      ? values->color
+                               : attrib == IMMEDIATE_ATTRIB_TEXCOORD ? values->texcoord
+                                                                     : values->normal;
+            GLfloat w = attrib == IMMEDIATE_ATTRIB_NORMAL ? 0.0f : v[3];
+            append(ListOp::SetAttrib, {attrib, list_float_bits(v[0]), list_float_bits(v[1]), list_float_bits(v[2]),
+                                       list_float_bits(w)});
+        }
+    }
+
+    void bake_vertices(CompilingList& compiling) {
+        if (compiling.vertices.empty()) return;
+        immediate_baked_t& baked = compiling.list.baked;
+        {
+            StateScope scope(STATE_SCOPE_ARRAY_BUFFER);
+            GLES.glGenBuffers(1, &baked.vbo);
+            GLES.glBindBuffer(GL_ARRAY_BUFFER, baked.vbo);
+            GLES.glBufferData(GL_ARRAY_BUFFER, compiling.vertices.size() * sizeof(immediate_vertex_t),
+                              compiling.vertices.data(), GL_STATIC_DRAW);
+        }
+        baked.vao = immediate_create_vao(baked.vbo);
+        LOG_D("Display list %u: baked %zu vertices", compiling.name, compiling.vertices.size())
+        CHECK_GL_ERROR
+    }
+
+    void execute_list(GLuint name) {
+        if (g_list_depth >= MAX_LIST_NESTING) return;
+        auto it = g_lists.find(name);
+        if (it == g_lists.end()) return;
+        DisplayList& list = it->second;
+
+        // Calls made by the replay must not be recorded again
+        const bool recording = g_list_recording;
+        g_list_recording = false;
+        ++g_list_depth;
+
+        const uint32_t* p = list.commands.data();
+        const uint32_t* end = p + list.commands.size();
+        while (p < end) {
+            switch ((ListOp)*p++) {
+            case ListOp::Enable:
+                glEnable(p[0]);
+                p += 1;
+                break;
+            case ListOp::Disable:
+                glDisable(p[0]);
+                p += 1;
+                break;
+            case ListOp::BindTexture:
+                glBindTexture(p[0], p[1]);
+                p += 2;
+                break;
+            case ListOp::BlendFunc:
+                glBlendFunc(p[0], p[1]);
+                p += 2;
+                break;
+            case ListOp::DepthFunc:
+                glDepthFunc(p[0]);
+                p += 1;
+                break;
+            case ListOp::DepthMask:
+                glDepthMask((GLboolean)p[0]);
+                p += 1;
+                break;
+            case ListOp::SetAttrib: {
+                GLfloat v[4];
+                memcpy(v, p + 1, sizeof(v));
+                immediate_set_attrib(p[0], v);
+                p += 5;
+                break;
+            }
+            case ListOp::CallList:
+                execute_list(p[0]);
+                p += 1;
+                break;
+            case ListOp::DrawBaked:
+                immediate_draw_baked(list.baked, p[0], (GLint)p[1], (GLsizei)p[2], p[3]);
+                p += 4;
+                break;
+            case ListOp::MatrixMode:
+                glMatrixMode(p[0]);
+                p += 1;
+                break;
+            case ListOp::PushMatrix:
+                glPushMatrix();
+                break;
+            case ListOp::PopMatrix:
+                glPopMatrix();
+                break;
+            case ListOp::LoadMatrix: {
+                GLfloat m[16];
+                memcpy(m, p, sizeof(m));
+                glLoadMatrixf(m);
+                p += 16;
+                break;
+            }
+            case ListOp::MultMatrix: {
+                GLfloat m[16];
+                memcpy(m, p, sizeof(m));
+                glMultMatrixf(m);
+                p += 16;
+                break;
+            }
+            default:
+                __builtin_unreachable();
+            }
+        }
+
+        --g_list_depth;
+        g_list_recording = recording;
+    }
+
+    GLuint list_name_at(GLenum type, const GLvoid* lists, GLsizei i, bool& ok) {
+        ok = true;
+        auto bytes = (const GLubyte*)lists;
+        switch (type) {
+        case GL_BYTE:
+            return (GLuint)(GLint)((const GLbyte*)lists)[i];
+        case GL_UNSIGNED_BYTE:
+            return bytes[i];
+        case GL_SHORT:
+            return (GLuint)(GLint)((const GLshort*)lists)[i];
+        case GL_UNSIGNED_SHORT:
+            return ((const GLushort*)lists)[i];
+        case GL_INT:
+            return (GLuint)((const GLint*)lists)[i];
+        case GL_UNSIGNED_INT:
+            return ((const GLuint*)lists)[i];
+        case GL_FLOAT:
+            return (GLuint)((const GLfloat*)lists)[i];
+        case GL_2_BYTES:
+            return (bytes[2 * i] << 8) | bytes[2 * i + 1];
+        case GL_3_BYTES:
+            return (bytes[3 * i] << 16) | (bytes[3 * i + 1] << 8) | bytes[3 * i + 2];
+        case GL_4_BYTES:
+            return ((GLuint)bytes[4 * i] << 24) | (bytes[4 * i + 1] << 16) | (bytes[4 * i + 2] << 8) |
+                   bytes[4 * i + 3];
+        default:
+            ok = false;
+            return 0;
+        }
+    }
+} // namespace
+
+bool list_record(ListOp op, const uint32_t* args, size_t count) {
+    record_attribs();
+    append(op, args, count);
+    if (op == ListOp::CallList) immediate_list_forget_attribs();
+    return g_list_execute;
+}
+
+bool list_record(ListOp op, std::initializer_list<uint32_t> args) {
+    return list_record(op, args.begin(), args.size());
+}
+
+void list_record_primitive(GLenum mode, GLbitfield inherit, const immediate_vertex_t* vertices, size_t count) {
+    auto& compiling = g_compiling;
+    auto& commands = compiling.list.commands;
+    const size_t first = compiling.vertices.size();
+    compiling.vertices.insert(compiling.vertices.end(), vertices, vertices + count);
+
+    size_t last = compiling.lastDraw;
+    if (last != SIZE_MAX && commands[last + 1] == mode && commands[last + 4] == inherit) {
+        commands[last + 3] += (uint32_t)count;
+        return;
+    }
+    last = commands.size();
+    append(ListOp::DrawBaked, {mode, (uint32_t)first, (uint32_t)count, inherit});
+    compiling.lastDraw = last;
+}
+
+GLboolean glIsList(GLuint list) {
+    LOG()
+    MG_TRACE_ARGS(glIsList, list)
+    return g_lists.contains(list) ? GL_TRUE : GL_FALSE;
+}
+
+void glDeleteLists(GLuint list, GLsizei range) {
+    LOG()
+    MG_TRACE_ARGS(glDeleteLists, list, range)
+    LOG_D("glDeleteLists, list = %u, range = %d", list, range)
+    for (GLsizei i = 0; i < range; ++i) {
+        auto it = g_lists.find(list + i);
+        if (it == g_lists.end()) continue;
+        release_list(it->second);
+        g_lists.erase(it);
+    }
+}
+
+GLuint glGenLists(GLsizei range) {
+    LOG()
+    MG_TRACE_ARGS(glGenLists, range)
+    LOG_D("glGenLists, range = %d", range)
+    if (range <= 0) return 0;
+    GLuint base = g_next_list;
+    for (GLsizei i = 0; i < range; ++i) {
+        // Skip past names glNewList created without glGenLists
+        if (g_lists.contains(base + i)) {
+            base += i + 1;
+            i = -1;
+        }
+    }
+    for (GLsizei i = 0; i < range; ++i)
+        g_lists.emplace(base + i, DisplayList());
+    g_next_list = base + range;
+    return base;
+}
+
+void glNewList(GLuint list, GLenum mode) {
+    LOG()
+    MG_TRACE_ARGS(glNewList, list, mode)
+    LOG_D("glNewList, list = %u, mode = %s", list, glEnumToString(mode))
+    if (list == 0 || (mode != GL_COMPILE && mode != GL_COMPILE_AND_EXECUTE)) {
+        LOG_E("glNewList: invalid list %u or mode %s", list, glEnumToString(mode))
+        return;
+    }
+    if (g_compiling.name) {
+        LOG_E("glNewList: list %u is already being compiled", g_compiling.name)
+        return;
+    }
+    g_compiling = CompilingList();
+    g_compiling.name = list;
+    immediate_list_begin();
+    g_list_recording = true;
+    g_list_execute = mode == GL_COMPILE_AND_EXECUTE;
+}
+
+void glEndList() {
+    LOG()
+    MG_TRACE_ARGS(glEndList)
+    auto& compiling = g_compiling;
+    if (!compiling.name) {
+        LOG_E("glEndList called without glNewList")
+        return;
+    }
+    g_list_recording = false;
+    g_list_execute = false;
+    record_attribs();
+    bake_vertices(compiling);
+    compiling.list.commands.shrink_to_fit();
+    LOG_D("glEndList, list %u: %zu command words", compiling.name, compiling.list.commands.size())
+
+    DisplayList& slot = g_lists[compiling.name];
+    release_list(slot);
+    slot = std::move(compiling.list);
+    compiling = CompilingList();
+}
+
+void glCallList(GLuint list) {
+    LOG()
+    MG_TRACE_ARGS(glCallList, list)
+    LOG_D("glCallList, list = %u", list)
+    LIST_RECORD(ListOp::CallList, {list})
+    execute_list(list);
+}
+
+void glCallLists(GLsizei n, GLenum type, const GLvoid* lists) {
+    LOG()
+    MG_TRACE_ARGS(glCallLists, n, type, lists)
+    LOG_D("glCallLists, n = %d, type = %s", n, glEnumToString(type))
+    for (GLsizei i = 0; i < n; ++i) {
+        bool ok;
+        GLuint name = list_name_at(type, lists, i, ok);
+        if (!ok) {
+            LOG_E("glCallLists: invalid type %s", glEnumToString(type))
+            return;
+        }
+        glCallList(g_list_base + name);
+    }
+}
+
+void glListBase(GLuint base) {
+    LOG()
+    MG_TRACE_ARGS(glListBase, base)
+    LOG_D("glListBase, base = %u", base)
+    g_list_base = base;
+}
@@ -0,0 +1,89 @@
+// MobileGlues - gl/display_list.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_DISPLAY_LIST_H
+#define MOBILEGLUES_DISPLAY_LIST_H
+
+#include "../includes.h"
+#include <GL/gl.h>
+#include "glcorearb.h"
+#include <cstdint>
+#include <initializer_list>
+
+struct immediate_vertex_t;
+
+// Display lists (glNewList/glEndList/glCallList).
+//
+// A list is compiled into a flat command buffer of 32-bit words: an opcode
+// followed by its arguments, checked when recorded so replay can dispatch
+// without validation. glBegin/glEnd geometry is baked at compile time into
+// one static VBO per list, and consecutive primitives of the same kind
+// become a single draw.
+//
+// Calls that can be compiled begin with LIST_RECORD. Calls without it run
+// immediately even while a list is compiled.
+
+enum class ListOp : uint32_t {
+    Enable,      // cap
+    Disable,     // cap
+    BindTexture, // target, texture
+    BlendFunc,   // sfactor, dfactor
+    DepthFunc,   // func
+    DepthMask,   // flag
+    SetAttrib,   // attrib, 4 float bits
+    CallList,    // list
+    DrawBaked,   // mode, first, count, inherited attribs
+    MatrixMode,  // mode
+    PushMatrix,
+    PopMatrix,
+    LoadMatrix,  // 16 float bits
+    MultMatrix,  // 16 float bits
+    Count
+};
+
+// Whether calls are being recorded into a list right now. Cleared while a
+// list is replayed.
+extern bool g_list_recording;
+// Whether recorded calls also run (GL_COMPILE_AND_EXECUTE)
+extern bool g_list_execute;
+
+// Records a command into the list being compiled. Returns whether the call
+// should also run now.
+bool list_record(ListOp op, std::initializer_list<uint32_t> args);
+bool list_record(ListOp op, const uint32_t* args, size_t count);
+
+#define LIST_RECORD(...)                                                                                               \
+    if (__builtin_expect(g_list_recording, 0) && !list_record(__VA_ARGS__)) return;
+
+inline uint32_t list_float_bits(GLfloat f) {
+    uint32_t bits;
+    __builtin_memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+// Bakes a converted glBegin/glEnd primitive into the list being compiled
+void list_record_primitive(GLenum mode, GLbitfield inherit, const immediate_vertex_t* vertices, size_t count);
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    GLAPI GLAPIENTRY GLboolean glIsList(GLuint list);
+    GLAPI GLAPIENTRY void glDeleteLists(GLuint list, GLsizei range);
+    GLAPI GLAPIENTRY GLuint glGenLists(GLsizei range);
+    GLAPI GLAPIENTRY void glNewList(GLuint list, GLenum mode);
+    GLAPI GLAPIENTRY void glEndList();
+    GLAPI GLAPIENTRY void glCallList(GLuint list);
+    GLAPI GLAPIENTRY void glCallLists(GLsizei n, GLenum type, const GLvoid* lists);
+    GLAPI GLAPIENTRY void glListBase(GLuint base);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOBILEGLUES_DISPLAY_LIST_H
@@ -8,98 +8,37 @@
 #include "drawing.h"
 #include "buffer.h"
 #include "framebuffer.h"
+#include "immediate.h"
+#include "index_cache.h"
 #include "mg.h"
 #include "texture.h"
+#include "texture_buffer.h"
 #include <ankerl/unordered_dense.h>
 
 #define DEBUG 0
 
-GLuint bufSampelerProg;
-GLuint bufSampelerLoc;
-std::string bufSampelerName;
-
-extern UnorderedMap<GLuint, bool> program_map_is_sampler_buffer_emulated;
 extern UnorderedMap<GLuint, bool> program_map_is_atomic_counter_emulated;
 
-UnorderedMap<GLuint, SamplerInfo> g_samplerCacheForSamplerBuffer;
-
-void setupBufferTextureUniforms(GLuint program) {
-    LOG_D("setupBufferTextureUniforms, program: %d", program);
-
-    if (!program_map_is_sampler_buffer_emulated[program]) return;
-
-    if (g_samplerCacheForSamplerBuffer.find(program) == g_samplerCacheForSamplerBuffer.end()) {
-        auto& progSamplerInfo = g_samplerCacheForSamplerBuffer[program];
-        GLint locWidth = GLES.glGetUniformLocation(program, "u_BufferTexWidth");
-        GLint locHeight = GLES.glGetUniformLocation(program, "u_BufferTexHeight");
-        if (locWidth == -1) {
-            LOG_W("u_BufferTexWidth uniform not found in program %d", program);
-            return;
-        }
-
-        progSamplerInfo.locHeight = locHeight;
-        progSamplerInfo.locWidth = locWidth;
-        progSamplerInfo.samplers.clear();
-
-        GLint numUniforms = 0;
-        GLES.glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &numUniforms);
-        LOG_D("Program %d has %d active uniforms", program, numUniforms);
-
-        for (GLint i = 0; i < numUniforms; ++i) {
-            const GLsizei bufSize = 256;
-            GLchar name[bufSize];
-            GLsizei length = 0;
-            GLint size = 0;
-            GLenum type = 0;
-            GLES.glGetActiveUniform(program, i, bufSize, &length, &size, &type, name);
-
-            if (type == GL_SAMPLER_2D || type == GL_INT_SAMPLER_2D) {
-                GLint locSampler = GLES.glGetUniformLocation(program, name);
-                progSamplerInfo.samplers.push_back(locSampler);
-            }
-        }
-    }
-
-    auto& progSamplerInfo = g_samplerCacheForSamplerBuffer[program];
-
-    GLint locWidth = progSamplerInfo.locWidth;
-    GLint locHeight = progSamplerInfo.locHeight;
-
-    for (auto locSampler : progSamplerInfo.samplers) {
-        if (locSampler < 0) {
-            continue;
-        }
-
-        GLuint prev_unit = gl_state->current_tex_unit;
-        const GLint unit = 15;
-
-        GLES.glActiveTexture(GL_TEXTURE0 + unit);
-        GLint texId = 0;
-        GLES.glGetIntegerv(GL_TEXTURE_BINDING_2D, &texId);
-        if (texId == 0) {
-            GLES.glActiveTexture(GL_TEXTURE0 + prev_unit);
-            continue;
-        }
-
-        auto texObject = mgGetTexObjectByID(texId);
-
-        GLES.glUniform1i(locSampler, unit);
-        GLES.glUniform1i(locWidth, texObject->width);
-        GLES.glUniform1i(locHeight, texObject->height);
-
-        GLES.glActiveTexture(GL_TEXTURE0 + prev_unit);
-    }
-}
-
 void prepareForDraw() {
     LOG_D("prepareForDraw...")
+    flush_immediate();
     if (hardware->emulate_texture_buffer) {
-        setupBufferTextureUniforms(gl_state->current_program);
+        texture_buffer_prepare_draw(gl_state->current_program);
     }
 }
 
+void glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    LOG()
+    MG_TRACE_ARGS(glDrawArrays, mode, first, count)
+    LOG_D("glDrawArrays, mode: %d, first: %d, count: %d", mode, first, count)
+    prepareForDraw();
+    GLES.glDrawArrays(mode, first, count);
+    CHECK_GL_ERROR
+}
+
 void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount) {
     LOG()
+    MG_TRACE_ARGS(glDrawElementsInstanced, mode, count, type, indices, primcount)
     LOG_D("glDrawElementsInstanced, mode: %d, count: %d, type: %d, indices: %p, primcount: %d", mode, count, type,
           indices, primcount)
     prepareForDraw();
@@ -109,6 +48,7 @@ void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void
 
 void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
     LOG()
+    MG_TRACE_ARGS(glDrawElements, mode, count, type, indices)
     LOG_D("glDrawElements, mode: %d, count: %d, type: %d, indices: %p", mode, count, type, indices)
     prepareForDraw();
     GLES.glDrawElements(mode, count, type, indices);
@@ -118,6 +58,7 @@ void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices
 void glBindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access,
                         GLenum format) {
     LOG()
+    MG_TRACE_ARGS(glBindImageTexture, unit, texture, level, layered, layer, access, format)
     LOG_D("glBindImageTexture, unit: %d, texture: %d, level: %d, layered: %d, layer: %d, access: %d, format: %d", unit,
           texture, level, layered, layer, access, format)
     GLES.glBindImageTexture(unit, texture, level, layered, layer, access, format);
@@ -126,7 +67,11 @@ void glBindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean laye
 
 void glUniform1i(GLint location, GLint v0) {
     LOG()
+    MG_TRACE_ARGS(glUniform1i, location, v0)
     LOG_D("glUniform1i, location: %d, v0: %d", location, v0)
+    // Emulated buffer samplers always read from their own unit
+    if (hardware->emulate_texture_buffer && texture_buffer_is_sampler(gl_state->current_program, location))
+        v0 = TEXTURE_BUFFER_UNIT;
     GLES.glUniform1i(location, v0);
     CHECK_GL_ERROR
 }
@@ -134,6 +79,7 @@ void glUniform1i(GLint location, GLint v0) {
 void bindAllAtomicCounterAsSSBO();
 void glDispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z) {
     LOG()
+    MG_TRACE_ARGS(glDispatchCompute, num_groups_x, num_groups_y, num_groups_z)
     LOG_D("glDispatchCompute, num_groups_x: %d, num_groups_y: %d, num_groups_z: %d", num_groups_x, num_groups_y,
           num_groups_z)
     if (program_map_is_atomic_counter_emulated[gl_state->current_program]) {
@@ -148,6 +94,7 @@ void glDispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_grou
 
 void glMemoryBarrier(GLbitfield barriers) {
     LOG()
+    MG_TRACE_ARGS(glMemoryBarrier, barriers)
     LOG_D("glMemoryBarrier, barriers: %d", barriers)
     if (program_map_is_atomic_counter_emulated[gl_state->current_program]) {
         barriers |= GL_ATOMIC_COUNTER_BARRIER_BIT;
@@ -159,6 +106,7 @@ void glMemoryBarrier(GLbitfield barriers) {
 
 void glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex) {
     LOG()
+    MG_TRACE_ARGS(glDrawElementsBaseVertex, mode, count, type, indices, basevertex)
     LOG_D("glDrawElementsBaseVertex, mode: %d, count: %d, type: %d, indices: %p, basevertex: %d", mode, count, type,
           indices, basevertex);
     prepareForDraw();
@@ -166,78 +114,16 @@ void glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const voi
         !g_gles_caps.GL_OES_draw_elements_base_vertex) {
         // TODO: use indirect drawing for GLES 3.1
         LOG_D("Emulating glDrawElementsBaseVertex")
-        GLint prevElementBuffer;
-        GLES.glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &prevElementBuffer);
-
         if (basevertex == 0) {
             GLES.glDrawElements(mode, count, type, indices);
             return;
         }
 
-        size_t indexSize;
-        switch (type) {
-        case GL_UNSIGNED_INT:
-            indexSize = sizeof(GLuint);
-            break;
-        case GL_UNSIGNED_SHORT:
-            indexSize = sizeof(GLushort);
-            break;
-        case GL_UNSIGNED_BYTE:
-            indexSize = sizeof(GLubyte);
-            break;
-        default:
-            return;
+        const void* offset = nullptr;
+        if (BaseVertexIndexCache::get_instance().bind(count, type, indices, basevertex, offset)) {
+            GLES.glDrawElements(mode, count, type, offset);
         }
-
-        void* tempIndices = malloc(count * indexSize);
-        if (!tempIndices) {
-            return;
-        }
-
-        if (prevElementBuffer != 0) {
-            GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, prevElementBuffer);
-            void* srcData =
-                GLES.glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)indices, count * indexSize, GL_MAP_READ_BIT);
-
-            if (srcData) {
-                memcpy(tempIndices, srcData, count * indexSize);
-                GLES.glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
-            } else {
-                free(tempIndices);
-                return;
-            }
-        } else {
-            memcpy(tempIndices, indices, count * indexSize);
-        }
-
-        switch (type) {
-        case GL_UNSIGNED_INT:
-            for (int j = 0; j < count; ++j) {
-                ((GLuint*)tempIndices)[j] += basevertex;
-            }
-            break;
-        case GL_UNSIGNED_SHORT:
-            for (int j = 0; j < count; ++j) {
-                ((GLushort*)tempIndices)[j] += basevertex;
-            }
-            break;
-        case GL_UNSIGNED_BYTE:
-            for (int j = 0; j < count; ++j) {
-                ((GLubyte*)tempIndices)[j] += basevertex;
-            }
-            break;
-        }
-
-        GLuint tempBuffer;
-        GLES.glGenBuffers(1, &tempBuffer);
-        GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tempBuffer);
-        GLES.glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * indexSize, tempIndices, GL_STREAM_DRAW);
-        free(tempIndices);
-
-        GLES.glDrawElements(mode, count, type, 0);
-
-        GLES.glDeleteBuffers(1, &tempBuffer);
-        GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, prevElementBuffer);
+        GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, find_real_bound_buffer(GL_ELEMENT_ARRAY_BUFFER_BINDING));
 
         CHECK_GL_ERROR
     } else {
@@ -21,12 +21,6 @@
 #include "../gles/loader.h"
 #include "mg.h"
 
-struct SamplerInfo {
-    GLint locWidth;
-    GLint locHeight;
-    std::vector<GLint> samplers;
-};
-
 #ifdef __cplusplus
 extern "C"
 {
@@ -40,6 +34,8 @@ extern "C"
                                               const void* const* indices, GLsizei primcount);
     GLAPI GLAPIENTRY void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
 
+    GLAPI GLAPIENTRY void glDrawArrays(GLenum mode, GLint first, GLsizei count);
+
     GLAPI GLAPIENTRY void glBindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer,
                                              GLenum access, GLenum format);
     GLAPI GLAPIENTRY void glDispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
@@ -0,0 +1,491 @@
+// MobileGlues - gl/fixed_function.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "fixed_function.h"
+#include "display_list.h"
+#include "immediate.h"
+#include "log.h"
+#include "mg.h"
+#include "state.h"
+#include "FSR1/FSR1.h"
+
+#include <cstring>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#define DEBUG 0
+
+// Stack depths, as desktop implementations commonly report them
+#define MAX_MODELVIEW_STACK_DEPTH 32
+#define MAX_PROJECTION_STACK_DEPTH 32
+#define MAX_TEXTURE_STACK_DEPTH 10
+#define MAX_COLOR_MATRIX_STACK_DEPTH 10
+#define MAX_ATTRIB_STACK_DEPTH 16
+
+uint32_t g_ff_matrix_serial = 1;
+
+namespace {
+    struct MatrixStack {
+        std::vector<glm::mat4> stack;
+        size_t maxDepth;
+
+        explicit MatrixStack(size_t depth = MAX_TEXTURE_STACK_DEPTH) : maxDepth(depth) {
+            stack.reserve(depth);
+            stack.emplace_back(1.0f);
+        }
+
+        glm::mat4& top() { return stack.back(); }
+    };
+
+    struct AttribFrame {
+        GLbitfield mask;
+        gl_state_s state;
+        GLenum matrixMode;
+        bool texture2d;
+        GLfloat color[4];
+        GLfloat texcoord[4];
+        GLfloat normal[3];
+    };
+
+    struct FixedFunctionState {
+        GLenum matrixMode = GL_MODELVIEW;
+        MatrixStack modelview{MAX_MODELVIEW_STACK_DEPTH};
+        MatrixStack projection{MAX_PROJECTION_STACK_DEPTH};
+        MatrixStack color{MAX_COLOR_MATRIX_STACK_DEPTH};
+        MatrixStack texture[FF_TEXTURE_UNITS];
+
+        glm::mat4 mvp{1.0f};
+        uint32_t mvpSerial = 0;
+
+        std::vector<AttribFrame> attribStack;
+    };
+
+    FixedFunctionState g_ff;
+
+    MatrixStack* current_stack() {
+        switch (g_ff.matrixMode) {
+        case GL_MODELVIEW:
+            return &g_ff.modelview;
+        case GL_PROJECTION:
+            return &g_ff.projection;
+        case GL_COLOR:
+            return &g_ff.color;
+        case GL_TEXTURE:
+            if (gl_state->current_tex_unit < FF_TEXTURE_UNITS) return &g_ff.texture[gl_state->current_tex_unit];
+            LOG_E("No texture matrix for texture unit %u", gl_state->current_tex_unit)
+            return nullptr;
+        default:
+            return nullptr;
+        }
+    }
+
+    // Draws pending immediate mode geometry with the old matrices before
+    // they change
+    inline void matrix_changed() {
+        flush_immediate();
+        ++g_ff_matrix_serial;
+    }
+
+    bool record_matrix(ListOp op, const glm::mat4& m) {
+        uint32_t bits[16];
+        memcpy(bits, glm::value_ptr(m), sizeof(bits));
+        return list_record(op, bits, 16);
+    }
+
+    void load_matrix(const glm::mat4& m) {
+        if (__builtin_expect(g_list_recording, 0) && !record_matrix(ListOp::LoadMatrix, m)) return;
+        MatrixStack* stack = current_stack();
+        if (!stack) return;
+        matrix_changed();
+        stack->top() = m;
+    }
+
+    void mult_matrix(const glm::mat4& m) {
+        if (__builtin_expect(g_list_recording, 0) && !record_matrix(ListOp::MultMatrix, m)) return;
+        MatrixStack* stack = current_stack();
+        if (!stack) return;
+        matrix_changed();
+        stack->top() *= m;
+    }
+
+    const glm::mat4& mvp() {
+        if (g_ff.mvpSerial != g_ff_matrix_serial) {
+            g_ff.mvp = g_ff.projection.top() * g_ff.modelview.top();
+            g_ff.mvpSerial = g_ff_matrix_serial;
+        }
+        return g_ff.mvp;
+    }
+
+    const glm::mat4* matrix_for_query(GLenum pname, bool& transpose) {
+        transpose = false;
+        switch (pname) {
+        case GL_TRANSPOSE_MODELVIEW_MATRIX:
+            transpose = true;
+            [[fallthrough]];
+        case GL_MODELVIEW_MATRIX:
+            return &g_ff.modelview.top();
+        case GL_TRANSPOSE_PROJECTION_MATRIX:
+            transpose = true;
+            [[fallthrough]];
+        case GL_PROJECTION_MATRIX:
+            return &g_ff.projection.top();
+        case GL_TRANSPOSE_COLOR_MATRIX:
+            transpose = true;
+            [[fallthrough]];
+        case GL_COLOR_MATRIX:
+            return &g_ff.color.top();
+        case GL_TRANSPOSE_TEXTURE_MATRIX:
+            transpose = true;
+            [[fallthrough]];
+        case GL_TEXTURE_MATRIX:
+            return &g_ff.texture[gl_state->current_tex_unit < FF_TEXTURE_UNITS ? gl_state->current_tex_unit : 0].top();
+        default:
+            return nullptr;
+        }
+    }
+
+    bool same_stencil_func(const gl_stencil_face_s& a, const gl_stencil_face_s& b) {
+        return a.func == b.func && a.ref == b.ref && a.value_mask == b.value_mask;
+    }
+
+    bool same_stencil_op(const gl_stencil_face_s& a, const gl_stencil_face_s& b) {
+        return a.fail == b.fail && a.zfail == b.zfail && a.zpass == b.zpass;
+    }
+
+    bool same_blend_func(const gl_state_s& a, const gl_state_s& b) {
+        return a.blend_src_rgb == b.blend_src_rgb && a.blend_dst_rgb == b.blend_dst_rgb &&
+               a.blend_src_alpha == b.blend_src_alpha && a.blend_dst_alpha == b.blend_dst_alpha;
+    }
+
+    void restore_stencil_face(GLenum face, const gl_stencil_face_s& saved, const gl_stencil_face_s& now) {
+        if (!same_stencil_func(saved, now)) glStencilFuncSeparate(face, saved.func, saved.ref, saved.value_mask);
+        if (!same_stencil_op(saved, now)) glStencilOpSeparate(face, saved.fail, saved.zfail, saved.zpass);
+        if (saved.write_mask != now.write_mask) glStencilMaskSeparate(face, saved.write_mask);
+    }
+
+    void restore_attribs(const AttribFrame& frame) {
+        const GLbitfield mask = frame.mask;
+        const gl_state_s& s = frame.state;
+
+        GLbitfield caps = 0;
+        if (mask & GL_ENABLE_BIT) {
+            caps = ~0u;
+            immediate_set_texture_2d(frame.texture2d);
+        }
+        if (mask & GL_COLOR_BUFFER_BIT) {
+            caps |= STATE_CAP_BLEND | STATE_CAP_DITHER;
+            if (!same_blend_func(s, *gl_state))
+                glBlendFuncSeparate(s.blend_src_rgb, s.blend_dst_rgb, s.blend_src_alpha, s.blend_dst_alpha);
+            if (s.blend_equation_rgb != gl_state->blend_equation_rgb ||
+                s.blend_equation_alpha != gl_state->blend_equation_alpha)
+                glBlendEquationSeparate(s.blend_equation_rgb, s.blend_equation_alpha);
+            if (memcmp(s.color_mask, gl_state->color_mask, sizeof(s.color_mask)) != 0)
+                glColorMask(s.color_mask[0], s.color_mask[1], s.color_mask[2], s.color_mask[3]);
+        }
+        if (mask & GL_DEPTH_BUFFER_BIT) {
+            caps |= STATE_CAP_DEPTH_TEST;
+            if (s.depth_func != gl_state->depth_func) glDepthFunc(s.depth_func);
+            if (s.depth_mask != gl_state->depth_mask) glDepthMask(s.depth_mask);
+        }
+        if (mask & GL_STENCIL_BUFFER_BIT) {
+            caps |= STATE_CAP_STENCIL_TEST;
+            restore_stencil_face(GL_FRONT, s.stencil_front, gl_state->stencil_front);
+            restore_stencil_face(GL_BACK, s.stencil_back, gl_state->stencil_back);
+        }
+        if (mask & GL_SCISSOR_BIT) {
+            caps |= STATE_CAP_SCISSOR_TEST;
+            if (s.scissor_known) glScissor(s.scissor_box[0], s.scissor_box[1], s.scissor_box[2], s.scissor_box[3]);
+        }
+        if (mask & GL_POLYGON_BIT) caps |= STATE_CAP_CULL_FACE | STATE_CAP_POLYGON_OFFSET_FILL;
+        if (mask & GL_MULTISAMPLE_BIT)
+            caps |= STATE_CAP_SAMPLE_ALPHA_TO_COVERAGE | STATE_CAP_SAMPLE_COVERAGE | STATE_CAP_SAMPLE_MASK;
+        if (caps) set_gl_state_caps((gl_state->enabled_caps & ~caps) | (s.enabled_caps & caps));
+
+        if ((mask & GL_VIEWPORT_BIT) && s.viewport_known &&
+            (!gl_state->viewport_known || memcmp(s.viewport, gl_state->viewport, sizeof(s.viewport)) != 0))
+            glViewport(s.viewport[0], s.viewport[1], s.viewport[2], s.viewport[3]);
+        if (mask & GL_TRANSFORM_BIT) g_ff.matrixMode = frame.matrixMode;
+        if (mask & GL_CURRENT_BIT) {
+            immediate_set_attrib(IMMEDIATE_ATTRIB_COLOR, frame.color);
+            immediate_set_attrib(IMMEDIATE_ATTRIB_TEXCOORD, frame.texcoord);
+            immediate_set_attrib(IMMEDIATE_ATTRIB_NORMAL, frame.normal);
+        }
+        if (mask & GL_TEXTURE_BIT) {
+            for (GLuint unit = 0; unit < MG_MAX_TEXTURE_UNITS; ++unit) {
+                if (s.texture_binding_2d[unit] == gl_state->texture_binding_2d[unit]) continue;
+                glActiveTexture(GL_TEXTURE0 + unit);
+                glBindTexture(GL_TEXTURE_2D, s.texture_binding_2d[unit]);
+            }
+            if (gl_state->current_tex_unit != s.current_tex_unit) glActiveTexture(GL_TEXTURE0 + s.current_tex_unit);
+        }
+    }
+} // namespace
+
+const GLfloat* ff_mvp_matrix() {
+    return glm::value_ptr(mvp());
+}
+
+const GLfloat* ff_texture_matrix(GLuint unit) {
+    return glm::value_ptr(g_ff.texture[unit < FF_TEXTURE_UNITS ? unit : 0].top());
+}
+
+bool ff_get_floatv(GLenum pname, GLfloat* params) {
+    bool transpose;
+    if (const glm::mat4* m = matrix_for_query(pname, transpose)) {
+        memcpy(params, glm::value_ptr(transpose ? glm::transpose(*m) : *m), 16 * sizeof(GLfloat));
+        return true;
+    }
+    switch (pname) {
+    case GL_CURRENT_COLOR:
+        memcpy(params, immediate_current_color(), 4 * sizeof(GLfloat));
+        return true;
+    case GL_CURRENT_TEXTURE_COORDS:
+        memcpy(params, immediate_current_texcoord(), 4 * sizeof(GLfloat));
+        return true;
+    case GL_CURRENT_NORMAL:
+        memcpy(params, immediate_current_normal(), 3 * sizeof(GLfloat));
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool ff_get_integerv(GLenum pname, GLint* params) {
+    switch (pname) {
+    case GL_MATRIX_MODE:
+        *params = (GLint)g_ff.matrixMode;
+        return true;
+    case GL_MODELVIEW_STACK_DEPTH:
+        *params = (GLint)g_ff.modelview.stack.size();
+        return true;
+    case GL_PROJECTION_STACK_DEPTH:
+        *params = (GLint)g_ff.projection.stack.size();
+        return true;
+    case GL_COLOR_MATRIX_STACK_DEPTH:
+        *params = (GLint)g_ff.color.stack.size();
+        return true;
+    case GL_TEXTURE_STACK_DEPTH:
+        *params =
+            (GLint)g_ff.texture[gl_state->current_tex_unit < FF_TEXTURE_UNITS ? gl_state->current_tex_unit : 0]
+                .stack.size();
+        return true;
+    case GL_ATTRIB_STACK_DEPTH:
+        *params = (GLint)g_ff.attribStack.size();
+        return true;
+    case GL_MAX_MODELVIEW_STACK_DEPTH:
+        *params = MAX_MODELVIEW_STACK_DEPTH;
+        return true;
+    case GL_MAX_PROJECTION_STACK_DEPTH:
+        *params = MAX_PROJECTION_STACK_DEPTH;
+        return true;
+    case GL_MAX_TEXTURE_STACK_DEPTH:
+        *params = MAX_TEXTURE_STACK_DEPTH;
+        return true;
+    case GL_MAX_COLOR_MATRIX_STACK_DEPTH:
+        *params = MAX_COLOR_MATRIX_STACK_DEPTH;
+        return true;
+    case GL_MAX_ATTRIB_STACK_DEPTH:
+        *params = MAX_ATTRIB_STACK_DEPTH;
+        return true;
+    default:
+        return false;
+    }
+}
+
+void glMatrixMode(GLenum mode) {
+    LOG()
+    MG_TRACE_ARGS(glMatrixMode, mode)
+    LOG_D("glMatrixMode, mode = %s", glEnumToString(mode))
+    if (mode != GL_MODELVIEW && mode != GL_PROJECTION && mode != GL_TEXTURE && mode != GL_COLOR) {
+        LOG_E("glMatrixMode: invalid mode %s", glEnumToString(mode))
+        return;
+    }
+    LIST_RECORD(ListOp::MatrixMode, {mode})
+    g_ff.matrixMode = mode;
+}
+
+void glPushMatrix() {
+    LOG()
+    MG_TRACE_ARGS(glPushMatrix)
+    LIST_RECORD(ListOp::PushMatrix, {})
+    MatrixStack* stack = current_stack();
+    if (!stack) return;
+    if (stack->stack.size() >= stack->maxDepth) {
+        LOG_E("glPushMatrix: stack overflow")
+        return;
+    }
+    stack->stack.push_back(stack->top());
+}
+
+void glPopMatrix() {
+    LOG()
+    MG_TRACE_ARGS(glPopMatrix)
+    LIST_RECORD(ListOp::PopMatrix, {})
+    MatrixStack* stack = current_stack();
+    if (!stack) return;
+    if (stack->stack.size() <= 1) {
+        LOG_E("glPopMatrix: stack underflow")
+        return;
+    }
+    if (stack->stack[stack->stack.size() - 2] != stack->top()) matrix_changed();
+    stack->stack.pop_back();
+}
+
+void glLoadIdentity() {
+    LOG()
+    MG_TRACE_ARGS(glLoadIdentity)
+    load_matrix(glm::mat4(1.0f));
+}
+
+void glLoadMatrixf(const GLfloat* m) {
+    LOG()
+    MG_TRACE_ARGS(glLoadMatrixf, m)
+    load_matrix(glm::make_mat4(m));
+}
+
+void glLoadMatrixd(const GLdouble* m) {
+    LOG()
+    MG_TRACE_ARGS(glLoadMatrixd, m)
+    load_matrix(glm::mat4(glm::make_mat4(m)));
+}
+
+void glMultMatrixf(const GLfloat* m) {
+    LOG()
+    MG_TRACE_ARGS(glMultMatrixf, m)
+    mult_matrix(glm::make_mat4(m));
+}
+
+void glMultMatrixd(const GLdouble* m) {
+    LOG()
+    MG_TRACE_ARGS(glMultMatrixd, m)
+    mult_matrix(glm::mat4(glm::make_mat4(m)));
+}
+
+void glLoadTransposeMatrixf(const GLfloat* m) {
+    LOG()
+    MG_TRACE_ARGS(glLoadTransposeMatrixf, m)
+    load_matrix(glm::transpose(glm::make_mat4(m)));
+}
+
+void glLoadTransposeMatrixd(const GLdouble* m) {
+    LOG()
+    MG_TRACE_ARGS(glLoadTransposeMatrixd, m)
+    load_matrix(glm::transpose(glm::mat4(glm::make_mat4(m))));
+}
+
+void glMultTransposeMatrixf(const GLfloat* m) {
+    LOG()
+    MG_TRACE_ARGS(glMultTransposeMatrixf, m)
+    mult_matrix(glm::transpose(glm::make_mat4(m)));
+}
+
+void glMultTransposeMatrixd(const GLdouble* m) {
+    LOG()
+    MG_TRACE_ARGS(glMultTransposeMatrixd, m)
+    mult_matrix(glm::transpose(glm::mat4(glm::make_mat4(m))));
+}
+
+void glRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z) {
+    LOG()
+    MG_TRACE_ARGS(glRotatef, angle, x, y, z)
+    LOG_D("glRotatef, angle = %f, axis = %f, %f, %f", angle, x, y, z)
+    if (x == 0.0f && y == 0.0f && z == 0.0f) return;
+    mult_matrix(glm::rotate(glm::mat4(1.0f), glm::radians(angle), glm::vec3(x, y, z)));
+}
+
+void glRotated(GLdouble angle, GLdouble x, GLdouble y, GLdouble z) {
+    LOG()
+    MG_TRACE_ARGS(glRotated, angle, x, y, z)
+    glRotatef((GLfloat)angle, (GLfloat)x, (GLfloat)y, (GLfloat)z);
+}
+
+void glScalef(GLfloat x, GLfloat y, GLfloat z) {
+    LOG()
+    MG_TRACE_ARGS(glScalef, x, y, z)
+    LOG_D("glScalef, %f, %f, %f", x, y, z)
+    mult_matrix(glm::scale(glm::mat4(1.0f), glm::vec3(x, y, z)));
+}
+
+void glScaled(GLdouble x, GLdouble y, GLdouble z) {
+    LOG()
+    MG_TRACE_ARGS(glScaled, x, y, z)
+    glScalef((GLfloat)x, (GLfloat)y, (GLfloat)z);
+}
+
+void glTranslatef(GLfloat x, GLfloat y, GLfloat z) {
+    LOG()
+    MG_TRACE_ARGS(glTranslatef, x, y, z)
+    LOG_D("glTranslatef, %f, %f, %f", x, y, z)
+    mult_matrix(glm::translate(glm::mat4(1.0f), glm::vec3(x, y, z)));
+}
+
+void glTranslated(GLdouble x, GLdouble y, GLdouble z) {
+    LOG()
+    MG_TRACE_ARGS(glTranslated, x, y, z)
+    glTranslatef((GLfloat)x, (GLfloat)y, (GLfloat)z);
+}
+
+void glOrtho(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar) {
+    LOG()
+    MG_TRACE_ARGS(glOrtho, left, right, bottom, top, zNear, zFar)
+    LOG_D("glOrtho, %f, %f, %f, %f, %f, %f", left, right, bottom, top, zNear, zFar)
+    if (left == right || bottom == top || zNear == zFar) {
+        LOG_E("glOrtho: empty volume")
+        return;
+    }
+    mult_matrix(glm::mat4(glm::ortho(left, right, bottom, top, zNear, zFar)));
+}
+
+void glFrustum(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar) {
+    LOG()
+    MG_TRACE_ARGS(glFrustum, left, right, bottom, top, zNear, zFar)
+    LOG_D("glFrustum, %f, %f, %f, %f, %f, %f", left, right, bottom, top, zNear, zFar)
+    if (zNear <= 0.0 || zFar <= 0.0 || left == right || bottom == top || zNear == zFar) {
+        LOG_E("glFrustum: invalid volume")
+        return;
+    }
+    mult_matrix(glm::mat4(glm::frustum(left, right, bottom, top, zNear, zFar)));
+}
+
+void glPushAttrib(GLbitfield mask) {
+    LOG()
+    MG_TRACE_ARGS(glPushAttrib, mask)
+    LOG_D("glPushAttrib, mask = 0x%x", mask)
+    auto& stack = g_ff.attribStack;
+    if (stack.size() >= MAX_ATTRIB_STACK_DEPTH) {
+        LOG_E("glPushAttrib: stack overflow")
+        return;
+    }
+    AttribFrame& frame = stack.emplace_back();
+    frame.mask = mask;
+    frame.state = *gl_state;
+    frame.matrixMode = g_ff.matrixMode;
+    frame.texture2d = immediate_texture_2d_enabled();
+    memcpy(frame.color, immediate_current_color(), sizeof(frame.color));
+    memcpy(frame.texcoord, immediate_current_texcoord(), sizeof(frame.texcoord));
+    memcpy(frame.normal, immediate_current_normal(), sizeof(frame.normal));
+}
+
+void glPopAttrib() {
+    LOG()
+    MG_TRACE_ARGS(glPopAttrib)
+    auto& stack = g_ff.attribStack;
+    if (stack.empty()) {
+        LOG_E("glPopAttrib: stack underflow")
+        return;
+    }
+    // glPushAttrib/glPopAttrib are not compiled into display lists, and the
+    // calls made to restore the state must not be either
+    const bool recording = g_list_recording;
+    g_list_recording = false;
+    restore_attribs(stack.back());
+    g_list_recording = recording;
+    stack.pop_back();
+}
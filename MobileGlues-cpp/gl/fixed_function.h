@@ -0,0 +1,38 @@
+// MobileGlues - gl/fixed_function.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_FIXED_FUNCTION_H
+#define MOBILEGLUES_FIXED_FUNCTION_H
+
+#include "../includes.h"
+#include <GL/gl.h>
+#include "glcorearb.h"
+#include <cstdint>
+
+// Fixed-function state GLES does not have: the modelview, projection, texture
+// and color matrix stacks, and the glPushAttrib/glPopAttrib stack.
+//
+// Matrices live on the CPU. g_ff_matrix_serial changes whenever any of them
+// does, so consumers (immediate mode) re-upload their uniforms only then.
+// glPopAttrib restores from a CPU snapshot and only calls back into the
+// entry points for state that differs, which the redundant state filter
+// then reduces further.
+
+// Fixed-function texture units with their own texture matrix
+#define FF_TEXTURE_UNITS 8
+
+extern uint32_t g_ff_matrix_serial;
+
+// Column-major projection * modelview
+const GLfloat* ff_mvp_matrix();
+const GLfloat* ff_texture_matrix(GLuint unit);
+
+// Answer fixed-function queries. Return false if pname is not one of them.
+bool ff_get_floatv(GLenum pname, GLfloat* params);
+bool ff_get_integerv(GLenum pname, GLint* params);
+
+#endif // MOBILEGLUES_FIXED_FUNCTION_H
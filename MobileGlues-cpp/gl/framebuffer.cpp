@@ -9,6 +9,10 @@
 #include "log.h"
 #include "../config/settings.h"
 #include "FSR1/FSR1.h"
+#include "immediate.h"
+
+#include <algorithm>
+#include <cstring>
 
 #define DEBUG 0
 
@@ -21,12 +25,18 @@ void ensure_max_attachments() {
     if (MAX_COLOR_ATTACHMENTS == 0) {
         GLES.glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &MAX_COLOR_ATTACHMENTS);
         MAX_COLOR_ATTACHMENTS = MAX_COLOR_ATTACHMENTS > 0 ? MAX_COLOR_ATTACHMENTS : 8;
+        if (MAX_COLOR_ATTACHMENTS > MAX_FBO_COLOR_ATTACHMENTS) MAX_COLOR_ATTACHMENTS = MAX_FBO_COLOR_ATTACHMENTS;
     }
     if (MAX_DRAW_BUFFERS == 0) {
         GLES.glGetIntegerv(GL_MAX_DRAW_BUFFERS, &MAX_DRAW_BUFFERS);
         MAX_DRAW_BUFFERS = MAX_DRAW_BUFFERS > 0 ? MAX_DRAW_BUFFERS : 8;
+        if (MAX_DRAW_BUFFERS > MAX_FBO_COLOR_ATTACHMENTS) MAX_DRAW_BUFFERS = MAX_FBO_COLOR_ATTACHMENTS;
     }
 }
+GLint getMaxDrawBuffers() {
+    ensure_max_attachments();
+    return MAX_DRAW_BUFFERS;
+}
 framebuffer_t& get_framebuffer(GLuint id) {
     if (id >= framebuffers.size()) {
         framebuffers.resize(id + 10);
@@ -36,16 +46,43 @@ framebuffer_t& get_framebuffer(GLuint id) {
 void InitFramebufferMap(size_t expectedSize) {
     framebuffers.reserve(expectedSize);
 }
-void init_framebuffer(framebuffer_t& fbo) {
-    if (!fbo.initialized) {
-        fbo.color_attachments = new attachment_t[MAX_COLOR_ATTACHMENTS];
-        memset(fbo.color_attachments, 0, sizeof(attachment_t) * MAX_COLOR_ATTACHMENTS);
-        fbo.initialized = true;
+// The name of a deleted texture may come back as a new texture the driver
+// has attached nowhere, so no slot can be trusted to hold it any more
+void framebuffer_forget_texture(GLuint texture) {
+    if (texture == 0) return;
+    for (framebuffer_t& fbo : framebuffers) {
+        for (GLuint slot = 0; slot < MAX_FBO_COLOR_ATTACHMENTS; ++slot) {
+            if (fbo.physical_attachments[slot].texture == texture) fbo.physical_known &= ~(1u << slot);
+        }
+    }
+}
+static bool is_color_attachment(GLenum attachment) {
+    return attachment >= GL_COLOR_ATTACHMENT0 && attachment < GL_COLOR_ATTACHMENT0 + MAX_COLOR_ATTACHMENTS;
+}
+// Puts an attachment into a physical color slot unless the driver already
+// has it there
+static void attach_physical(framebuffer_t& fbo, GLenum target, GLuint slot, const attachment_t& attach) {
+    const uint32_t bit = 1u << slot;
+    if ((fbo.physical_known & bit) && fbo.physical_attachments[slot] == attach) return;
+    GLES.glFramebufferTexture2D(target, GL_COLOR_ATTACHMENT0 + slot, attach.textarget, attach.texture, attach.level);
+    fbo.physical_attachments[slot] = attach;
+    fbo.physical_known |= bit;
+}
+static void set_draw_buffers(framebuffer_t& fbo, GLsizei n, const GLenum* bufs) {
+    if (n == fbo.draw_buffer_count && memcmp(fbo.draw_buffers, bufs, n * sizeof(GLenum)) == 0) return;
+    GLES.glDrawBuffers(n, bufs);
+    if (n <= MAX_FBO_COLOR_ATTACHMENTS) {
+        memcpy(fbo.draw_buffers, bufs, n * sizeof(GLenum));
+        fbo.draw_buffer_count = n;
+    } else {
+        fbo.draw_buffer_count = -1;
     }
 }
 void glBindFramebuffer(GLenum target, GLuint framebuffer) {
+    LOG()
+    MG_TRACE_ARGS(glBindFramebuffer, target, framebuffer)
+    flush_immediate();
     ensure_max_attachments();
-    framebuffer_t& fbo = get_framebuffer(framebuffer);
 
     if (framebuffer == 0 && target != GL_READ_FRAMEBUFFER) {
         framebuffer = FSR1_Context::g_renderFBO;
@@ -55,10 +92,11 @@ void glBindFramebuffer(GLenum target, GLuint framebuffer) {
     if (target != GL_READ_FRAMEBUFFER) {
         set_gl_state_current_draw_fbo(framebuffer);
     }
-
-    if (framebuffer != 0) {
-        init_framebuffer(fbo);
+    if (target != GL_DRAW_FRAMEBUFFER) {
+        set_gl_state_current_read_fbo(framebuffer);
     }
+
+    get_framebuffer(framebuffer);
     if (target == GL_DRAW_FRAMEBUFFER || target == GL_FRAMEBUFFER) {
         current_draw_fbo = framebuffer;
     }
@@ -66,62 +104,131 @@ void glBindFramebuffer(GLenum target, GLuint framebuffer) {
         current_read_fbo = framebuffer;
     }
     GLES.glBindFramebuffer(target, framebuffer);
+    if (target != GL_READ_FRAMEBUFFER) OnFSRDrawFramebufferChanged();
+}
+void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    LOG()
+    MG_TRACE_ARGS(glDeleteFramebuffers, n, framebuffers)
+    LOG_D("glDeleteFramebuffers, n = %d", n)
+    // Deleting a bound framebuffer reverts that binding to 0
+    for (GLsizei i = 0; i < n; ++i) {
+        if (framebuffers[i] == 0) continue;
+        if (framebuffers[i] == gl_state->current_draw_fbo) {
+            set_gl_state_current_draw_fbo(0);
+            current_draw_fbo = 0;
+        }
+        if (framebuffers[i] == gl_state->current_read_fbo) {
+            set_gl_state_current_read_fbo(0);
+            current_read_fbo = 0;
+        }
+        // The driver may hand the name out again for a new framebuffer
+        if (framebuffers[i] < ::framebuffers.size()) ::framebuffers[framebuffers[i]] = framebuffer_t();
+    }
+    GLES.glDeleteFramebuffers(n, framebuffers);
+    CHECK_GL_ERROR
+}
+void glBindRenderbuffer(GLenum target, GLuint renderbuffer) {
+    LOG()
+    MG_TRACE_ARGS(glBindRenderbuffer, target, renderbuffer)
+    LOG_D("glBindRenderbuffer, target = %s, renderbuffer = %u", glEnumToString(target), renderbuffer)
+    if (target == GL_RENDERBUFFER) set_gl_state_current_renderbuffer(renderbuffer);
+    GLES.glBindRenderbuffer(target, renderbuffer);
+    CHECK_GL_ERROR
+}
+void glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
+    LOG()
+    MG_TRACE_ARGS(glDeleteRenderbuffers, n, renderbuffers)
+    LOG_D("glDeleteRenderbuffers, n = %d", n)
+    for (GLsizei i = 0; i < n; ++i) {
+        if (renderbuffers[i] != 0 && renderbuffers[i] == gl_state->current_renderbuffer)
+            set_gl_state_current_renderbuffer(0);
+    }
+    GLES.glDeleteRenderbuffers(n, renderbuffers);
+    CHECK_GL_ERROR
 }
 void update_attachment(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
     GLuint current_fbo = (target == GL_READ_FRAMEBUFFER) ? current_read_fbo : current_draw_fbo;
     if (current_fbo == 0) return;
-    framebuffer_t& fbo = framebuffers[current_fbo];
-    if (attachment >= GL_COLOR_ATTACHMENT0 && attachment < GL_COLOR_ATTACHMENT0 + MAX_COLOR_ATTACHMENTS) {
+    framebuffer_t& fbo = get_framebuffer(current_fbo);
+    if (is_color_attachment(attachment)) {
         int index = attachment - GL_COLOR_ATTACHMENT0;
         fbo.color_attachments[index] = {textarget, texture, level};
+        // The application attaches to the slot it names, so that slot now
+        // holds it in the driver as well
+        fbo.physical_attachments[index] = {textarget, texture, level};
+        fbo.physical_known |= 1u << index;
     } else if (attachment == GL_DEPTH_ATTACHMENT) {
         fbo.depth_attachment = {textarget, texture, level};
     } else if (attachment == GL_STENCIL_ATTACHMENT) {
         fbo.stencil_attachment = {textarget, texture, level};
     }
 }
+// A renderbuffer or texture layer the physical slots cannot describe went
+// into the attachment point, so the next remap attaches to it again
+static void forget_physical(GLenum target, GLenum attachment) {
+    GLuint current_fbo = (target == GL_READ_FRAMEBUFFER) ? current_read_fbo : current_draw_fbo;
+    if (current_fbo == 0 || !is_color_attachment(attachment)) return;
+    get_framebuffer(current_fbo).physical_known &= ~(1u << (attachment - GL_COLOR_ATTACHMENT0));
+}
 void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+    LOG()
+    MG_TRACE_ARGS(glFramebufferTexture2D, target, attachment, textarget, texture, level)
     update_attachment(target, attachment, textarget, texture, level);
     GLES.glFramebufferTexture2D(target, attachment, textarget, texture, level);
 }
 void glFramebufferTexture(GLenum target, GLenum attachment, GLuint texture, GLint level) {
+    LOG()
+    MG_TRACE_ARGS(glFramebufferTexture, target, attachment, texture, level)
     update_attachment(target, attachment, GL_TEXTURE_2D, texture, level);
     GLES.glFramebufferTexture(target, attachment, texture, level);
 }
+void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) {
+    LOG()
+    MG_TRACE_ARGS(glFramebufferRenderbuffer, target, attachment, renderbuffertarget, renderbuffer)
+    forget_physical(target, attachment);
+    GLES.glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+    CHECK_GL_ERROR
+}
+void glFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer) {
+    LOG()
+    MG_TRACE_ARGS(glFramebufferTextureLayer, target, attachment, texture, level, layer)
+    forget_physical(target, attachment);
+    GLES.glFramebufferTextureLayer(target, attachment, texture, level, layer);
+    CHECK_GL_ERROR
+}
 void glDrawBuffer(GLenum buffer) {
     LOG()
+    MG_TRACE_ARGS(glDrawBuffer, buffer)
     LOG_D("glDrawBuffer %d", buffer)
 
-    //    GLint currentFBO;
-    //    GLES.glGetIntegerv(GL_FRAMEBUFFER_BINDING, &currentFBO);
     if (current_draw_fbo == 0) {
         GLenum buffers[] = {buffer};
         glDrawBuffers(1, buffers);
     } else {
-        GLint maxAttachments;
-        GLES.glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &maxAttachments);
+        GLint maxAttachments = MAX_COLOR_ATTACHMENTS;
+        GLenum buffers[MAX_FBO_COLOR_ATTACHMENTS];
+        std::fill_n(buffers, maxAttachments, GL_NONE);
 
         if (buffer == GL_NONE) {
-            framebuffers[current_draw_fbo].color_attachments_all_none = true;
-            std::vector<GLenum> buffers(maxAttachments, GL_NONE);
-            glDrawBuffers(maxAttachments, buffers.data());
-        } else if (buffer >= GL_COLOR_ATTACHMENT0 && buffer < GL_COLOR_ATTACHMENT0 + maxAttachments) {
-            framebuffers[current_draw_fbo].color_attachments_all_none = false;
-            std::vector<GLenum> buffers(maxAttachments, GL_NONE);
+            get_framebuffer(current_draw_fbo).color_attachments_all_none = true;
+            glDrawBuffers(maxAttachments, buffers);
+        } else if (is_color_attachment(buffer)) {
+            get_framebuffer(current_draw_fbo).color_attachments_all_none = false;
             buffers[buffer - GL_COLOR_ATTACHMENT0] = buffer;
-            glDrawBuffers(maxAttachments, buffers.data());
+            glDrawBuffers(maxAttachments, buffers);
         }
     }
     CHECK_GL_ERROR;
 }
 void glDrawBuffers(GLsizei n, const GLenum* bufs) {
     LOG()
+    MG_TRACE_ARGS(glDrawBuffers, n, bufs)
     if (current_draw_fbo == 0) {
         GLES.glDrawBuffers(n, bufs);
         return;
     }
 
-    framebuffer_t& fbo = framebuffers[current_draw_fbo];
+    framebuffer_t& fbo = get_framebuffer(current_draw_fbo);
 
     bool all_none = true;
     for (int i = 0; i < n; ++i) {
@@ -134,45 +241,59 @@ void glDrawBuffers(GLsizei n, const GLenum* bufs) {
     if (all_none) {
         LOG_D("glDrawBuffers, fb %d all_none true", current_draw_fbo)
         fbo.color_attachments_all_none = true;
-        GLES.glDrawBuffers(n, bufs);
+        set_draw_buffers(fbo, n, bufs);
         return;
     } else {
         LOG_D("glDrawBuffers, fb %d all_none false", current_draw_fbo)
         fbo.color_attachments_all_none = false;
     }
 
-    std::vector<GLenum> new_bufs(n);
+    if (n > MAX_COLOR_ATTACHMENTS) {
+        LOG_E("glDrawBuffers: %d buffers exceed the %d color attachments", n, MAX_COLOR_ATTACHMENTS)
+        return;
+    }
+
+    // Logical attachment bufs[i] is drawn through physical slot i
+    GLenum new_bufs[MAX_FBO_COLOR_ATTACHMENTS];
     for (int i = 0; i < n; i++) {
-        if (bufs[i] >= GL_COLOR_ATTACHMENT0 && bufs[i] < GL_COLOR_ATTACHMENT0 + MAX_COLOR_ATTACHMENTS) {
-            GLenum logical_attachment = bufs[i];
-            GLenum physical_attachment = GL_COLOR_ATTACHMENT0 + i;
-            new_bufs[i] = physical_attachment;
-            int index = logical_attachment - GL_COLOR_ATTACHMENT0;
-            attachment_t& attach = fbo.color_attachments[index];
-            GLES.glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, physical_attachment, attach.textarget, attach.texture,
-                                        attach.level);
+        if (is_color_attachment(bufs[i])) {
+            new_bufs[i] = GL_COLOR_ATTACHMENT0 + i;
+            attach_physical(fbo, GL_DRAW_FRAMEBUFFER, i, fbo.color_attachments[bufs[i] - GL_COLOR_ATTACHMENT0]);
         } else {
             new_bufs[i] = bufs[i];
         }
     }
-    GLES.glDrawBuffers(n, new_bufs.data());
+    set_draw_buffers(fbo, n, new_bufs);
 }
 void glReadBuffer(GLenum src) {
-    if (current_read_fbo != 0 && src >= GL_COLOR_ATTACHMENT0 && src < GL_COLOR_ATTACHMENT0 + MAX_COLOR_ATTACHMENTS) {
-        framebuffer_t& fbo = framebuffers[current_read_fbo];
-        int index = src - GL_COLOR_ATTACHMENT0;
-        attachment_t& attach = fbo.color_attachments[index];
-        GLES.glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, attach.textarget, attach.texture,
-                                    attach.level);
+    LOG()
+    MG_TRACE_ARGS(glReadBuffer, src)
+    if (current_read_fbo != 0 && is_color_attachment(src)) {
+        framebuffer_t& fbo = get_framebuffer(current_read_fbo);
+        attach_physical(fbo, GL_READ_FRAMEBUFFER, 0, fbo.color_attachments[src - GL_COLOR_ATTACHMENT0]);
         GLES.glReadBuffer(GL_COLOR_ATTACHMENT0);
     } else {
         GLES.glReadBuffer(src);
     }
 }
 GLenum glCheckFramebufferStatus(GLenum target) {
+    LOG()
+    MG_TRACE_ARGS(glCheckFramebufferStatus, target)
     GLenum status = GLES.glCheckFramebufferStatus(target);
     if (global_settings.ignore_error == IgnoreErrorLevel::Full && status != GL_FRAMEBUFFER_COMPLETE) {
         return GL_FRAMEBUFFER_COMPLETE;
     }
     return status;
-}
\ No newline at end of file
+}void glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1,
+                       GLint dstY1, GLbitfield mask, GLenum filter) {
+    LOG()
+    MG_TRACE_ARGS(glBlitFramebuffer, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter)
+    LOG_D("glBlitFramebuffer, src = %d,%d %d,%d, dst = %d,%d %d,%d, mask = 0x%x, filter = %s", srcX0, srcY0, srcX1,
+          srcY1, dstX0, dstY0, dstX1, dstY1, mask, glEnumToString(filter))
+    flush_immediate();
+    // The default framebuffer may be drawn into only part of the render target
+    ScaleFSRReadCorners(srcX0, srcY0, srcX1, srcY1);
+    ScaleFSRDrawCorners(dstX0, dstY0, dstX1, dstY1);
+    GLES.glBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    CHECK_GL_ERROR
+}
@@ -10,18 +10,36 @@
 
 #include <GL/gl.h>
 #include <cstddef>
+#include <cstdint>
+
+// Color attachments tracked per framebuffer. Drivers expose at most 8.
+#define MAX_FBO_COLOR_ATTACHMENTS 16
 
 struct attachment_t {
     GLenum textarget;
     GLuint texture;
     GLint level;
+
+    bool operator==(const attachment_t& other) const {
+        return textarget == other.textarget && texture == other.texture && level == other.level;
+    }
 };
 struct framebuffer_t {
-    bool initialized = false;
     bool color_attachments_all_none = false;
-    attachment_t* color_attachments = nullptr;
+    // Attachments by the index the application attached them to
+    attachment_t color_attachments[MAX_FBO_COLOR_ATTACHMENTS] = {};
     attachment_t depth_attachment = {0};
     attachment_t stencil_attachment = {0};
+
+    // glDrawBuffers/glReadBuffer move attachments to the slots GLES can draw
+    // to. This is what each slot holds in the driver right now, so a remap
+    // only touches the slots that change. Bit i of physical_known is set once
+    // slot i has been attached through us.
+    attachment_t physical_attachments[MAX_FBO_COLOR_ATTACHMENTS] = {};
+    uint32_t physical_known = 0;
+    // Buffer list last passed to GLES.glDrawBuffers, count -1 if none yet
+    GLenum draw_buffers[MAX_FBO_COLOR_ATTACHMENTS] = {};
+    GLsizei draw_buffer_count = -1;
 };
 
 #ifdef __cplusplus
@@ -32,18 +50,28 @@ extern "C"
     GLint getMaxDrawBuffers();
 
     GLAPI GLAPIENTRY void glBindFramebuffer(GLenum target, GLuint framebuffer);
+    GLAPI GLAPIENTRY void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+    GLAPI GLAPIENTRY void glBindRenderbuffer(GLenum target, GLuint renderbuffer);
+    GLAPI GLAPIENTRY void glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
     GLAPI GLAPIENTRY void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture,
                                                  GLint level);
     GLAPI GLAPIENTRY void glFramebufferTexture(GLenum target, GLenum attachment, GLuint texture, GLint level);
+    GLAPI GLAPIENTRY void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget,
+                                                    GLuint renderbuffer);
+    GLAPI GLAPIENTRY void glFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level,
+                                                    GLint layer);
     GLAPI GLAPIENTRY void glDrawBuffer(GLenum buf);
     GLAPI GLAPIENTRY void glDrawBuffers(GLsizei n, const GLenum* bufs);
     GLAPI GLAPIENTRY void glReadBuffer(GLenum src);
     GLAPI GLAPIENTRY GLenum glCheckFramebufferStatus(GLenum target);
+    GLAPI GLAPIENTRY void glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0,
+                                            GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
 
 #ifdef __cplusplus
 }
 #endif
 
 void InitFramebufferMap(size_t expectedSize);
+void framebuffer_forget_texture(GLuint texture);
 
 #endif // MOBILEGLUES_FRAMEBUFFER_H
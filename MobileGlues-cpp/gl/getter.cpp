@@ -7,20 +7,26 @@
 
 #include "getter.h"
 #include "buffer.h"
+#include "state.h"
+#include "fixed_function.h"
 #include <string>
-#include <format>
 #include <vector>
 #include <random>
 #include "FSR1/FSR1.h"
 #include "log.h"
 #include "random_string_gen.h"
 
+#include <ankerl/unordered_dense.h>
+#include <deque>
+#include <string_view>
+
 #define DEBUG 0
 
 Version GLVersion;
 
 void glGetIntegerv(GLenum pname, GLint* params) {
     LOG()
+    MG_TRACE_ARGS(glGetIntegerv, pname, params)
     LOG_D("glGetIntegerv, pname: %s", glEnumToString(pname))
     switch (pname) {
     case GL_NUM_EXTENSIONS + GL_BACKEND_GETTER_MG:
@@ -30,24 +36,7 @@ void glGetIntegerv(GLenum pname, GLint* params) {
         (*params) = GL_CONTEXT_CORE_PROFILE_BIT;
         break;
     case GL_NUM_EXTENSIONS:
-        static GLint num_extensions = -1;
-        if (num_extensions == -1) {
-            const GLubyte* ext_str = glGetString(GL_EXTENSIONS);
-            if (ext_str) {
-                std::string copy_str((const char*)ext_str);
-                std::string token;
-                size_t pos = 0;
-                num_extensions = 0;
-                while ((pos = copy_str.find(' ')) != std::string::npos) {
-                    num_extensions++;
-                    copy_str.erase(0, pos + 1);
-                }
-                if (!copy_str.empty()) num_extensions++; // Count the last token
-            } else {
-                num_extensions = 0;
-            }
-        }
-        (*params) = num_extensions;
+        (*params) = (GLint)GetExtensionCount();
         break;
     case GL_MAJOR_VERSION:
         (*params) = GLVersion.Major;
@@ -86,14 +75,77 @@ void glGetIntegerv(GLenum pname, GLint* params) {
         (*params) = (int)find_bound_array();
         break;
     default:
+        if (get_shadow_integerv(pname, params)) {
+            LOG_D("  -> %d (shadow)", *params)
+            break;
+        }
+        if (ff_get_integerv(pname, params)) {
+            LOG_D("  -> %d (fixed function)", *params)
+            break;
+        }
         GLES.glGetIntegerv(pname, params);
         LOG_D("  -> %d", *params)
         CHECK_GL_ERROR
     }
 }
 
+void glGetFloatv(GLenum pname, GLfloat* data) {
+    LOG()
+    MG_TRACE_ARGS(glGetFloatv, pname, data)
+    LOG_D("glGetFloatv, pname: %s", glEnumToString(pname))
+    if (ff_get_floatv(pname, data)) return;
+    GLint value;
+    if (ff_get_integerv(pname, &value)) {
+        *data = (GLfloat)value;
+        return;
+    }
+    GLES.glGetFloatv(pname, data);
+    CHECK_GL_ERROR
+}
+
+// Values glGetDoublev converts for pname
+static int get_double_count(GLenum pname) {
+    switch (pname) {
+    case GL_MODELVIEW_MATRIX:
+    case GL_PROJECTION_MATRIX:
+    case GL_TEXTURE_MATRIX:
+    case GL_COLOR_MATRIX:
+    case GL_TRANSPOSE_MODELVIEW_MATRIX:
+    case GL_TRANSPOSE_PROJECTION_MATRIX:
+    case GL_TRANSPOSE_TEXTURE_MATRIX:
+    case GL_TRANSPOSE_COLOR_MATRIX:
+        return 16;
+    case GL_CURRENT_COLOR:
+    case GL_CURRENT_TEXTURE_COORDS:
+    case GL_VIEWPORT:
+    case GL_SCISSOR_BOX:
+    case GL_COLOR_CLEAR_VALUE:
+    case GL_BLEND_COLOR:
+        return 4;
+    case GL_CURRENT_NORMAL:
+        return 3;
+    case GL_DEPTH_RANGE:
+    case GL_ALIASED_LINE_WIDTH_RANGE:
+    case GL_ALIASED_POINT_SIZE_RANGE:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+void glGetDoublev(GLenum pname, GLdouble* data) {
+    LOG()
+    MG_TRACE_ARGS(glGetDoublev, pname, data)
+    LOG_D("glGetDoublev, pname: %s", glEnumToString(pname))
+    GLfloat values[16];
+    glGetFloatv(pname, values);
+    for (int i = 0, count = get_double_count(pname); i < count; ++i)
+        data[i] = values[i];
+}
+
 GLenum glGetError() {
     LOG()
+    MG_TRACE_ARGS(glGetError)
     GLenum err = GLES.glGetError();
     // just clear gles error, no reporting
     if (err != GL_NO_ERROR) {
@@ -104,10 +156,53 @@ GLenum glGetError() {
     return GL_NO_ERROR;
 }
 
-static std::string es_ext;
-std::string GetExtensionsList() {
-    return es_ext;
-}
+namespace {
+    // Extensions exposed to the application, in the order they are
+    // reported. Each name is stored once; the deque never moves its strings,
+    // so glGetStringi can return them directly and the lookup set can key on
+    // views of them. The joined GL_EXTENSIONS string is only rebuilt after
+    // the list changed, which in practice means once after init.
+    struct ExtensionRegistry {
+        std::deque<std::string> names;
+        std::vector<const char*> table;
+        ankerl::unordered_dense::set<std::string_view> lookup;
+        std::string joined;
+        bool joined_dirty = true;
+
+        void clear() {
+            lookup.clear();
+            table.clear();
+            names.clear();
+            joined_dirty = true;
+        }
+
+        void add(std::string_view name) {
+            if (name.empty() || lookup.contains(name)) return;
+            const std::string& stored = names.emplace_back(name);
+            table.push_back(stored.c_str());
+            lookup.insert(std::string_view(stored));
+            joined_dirty = true;
+        }
+
+        const std::string& string() {
+            if (joined_dirty) {
+                size_t length = 0;
+                for (const std::string& name : names)
+                    length += name.size() + 1;
+                joined.clear();
+                joined.reserve(length);
+                for (const std::string& name : names) {
+                    joined += name;
+                    joined += ' ';
+                }
+                joined_dirty = false;
+            }
+            return joined;
+        }
+    };
+
+    ExtensionRegistry g_extensions;
+} // namespace
 
 void InitGLESBaseExtensions() {
     std::vector<std::string> extensions;
@@ -149,16 +244,17 @@ void InitGLESBaseExtensions() {
         }
     }
 
-    es_ext.clear();
-    for (const auto& ext : extensions) {
-        es_ext += ext;
-        es_ext += " ";
-    }
+    g_extensions.clear();
+    for (const auto& ext : extensions)
+        g_extensions.add(ext);
 }
 
 void AppendExtension(const char* ext) {
-    es_ext += ext;
-    es_ext += ' ';
+    g_extensions.add(ext);
+}
+
+GLuint GetExtensionCount() {
+    return (GLuint)g_extensions.table.size();
 }
 
 std::string getBeforeThirdSpace(const std::string& str) {
@@ -240,6 +336,7 @@ static std::string vendorString;
 static std::string versionString;
 const GLubyte* glGetString(GLenum name) {
     LOG()
+    MG_TRACE_ARGS(glGetString, name)
     LOG_D("glGetString, %s", glEnumToString(name))
     switch (name) {
     case GL_VENDOR: {
@@ -380,20 +477,13 @@ const GLubyte* glGetString(GLenum name) {
 
         return reinterpret_cast<const GLubyte*>(shadingLangString.c_str());
     }
-    case GL_EXTENSIONS: {
-#if !defined(__APPLE__)
-        static std::string cached;
-        cached = GetExtensionsList();
-        return (const GLubyte*)cached.c_str();
-#else
-        return (const GLubyte*)GetExtensionsList().c_str();
-#endif
-    }
+    case GL_EXTENSIONS:
+        return (const GLubyte*)g_extensions.string().c_str();
     case GL_SETTINGS_MG: {
         if (global_settings.hide_mg_env_level >= HideMGEnvLevel::Level1) return GLES.glGetString(name);
 
         static char* settings_string = nullptr;
-        std::string tmp = dump_settings_string("  ");
+        std::string tmp = dump_settings_string("  ") + dump_state_filter_stats("  ") + dump_call_trace_stats("  ");
         settings_string = strdup(tmp.c_str());
         return reinterpret_cast<const GLubyte*>(settings_string);
     }
@@ -413,17 +503,21 @@ const GLubyte* glGetString(GLenum name) {
 
 const GLubyte* glGetStringi(GLenum name, GLuint index) {
     LOG()
+    MG_TRACE_ARGS(glGetStringi, name, index)
     if (name == GL_EXTENSIONS + GL_BACKEND_GETTER_MG && global_settings.hide_mg_env_level == HideMGEnvLevel::Disabled) {
         return GLES.glGetStringi(name - GL_BACKEND_GETTER_MG, index);
     }
+    if (name == GL_EXTENSIONS) {
+        if (index >= g_extensions.table.size()) return nullptr;
+        return (const GLubyte*)g_extensions.table[index];
+    }
 
     typedef struct {
         GLenum name;
         const char** parts;
         GLuint count;
     } StringCache;
-    static StringCache caches[] = {{GL_EXTENSIONS, nullptr, 0},
-                                   {GL_VENDOR, nullptr, 0},
+    static StringCache caches[] = {{GL_VENDOR, nullptr, 0},
                                    {GL_VERSION, nullptr, 0},
                                    {GL_SHADING_LANGUAGE_VERSION, nullptr, 0}};
     static int initialized = 0;
@@ -445,9 +539,6 @@ const GLubyte* glGetStringi(GLenum name, GLuint index) {
             case GL_SHADING_LANGUAGE_VERSION:
                 str = glGetString(GL_SHADING_LANGUAGE_VERSION);
                 break;
-            case GL_EXTENSIONS:
-                str = glGetString(GL_EXTENSIONS);
-                break;
             default:
                 return GLES.glGetStringi(name, index);
             }
@@ -487,6 +578,7 @@ const GLubyte* glGetStringi(GLenum name, GLuint index) {
 
 void glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {
     LOG()
+    MG_TRACE_ARGS(glGetQueryObjectiv, id, pname, params)
     if (GLES.glGetQueryObjectivEXT) {
         GLES.glGetQueryObjectivEXT(id, pname, params);
         CHECK_GL_ERROR
@@ -495,6 +587,7 @@ void glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {
 
 void glGetQueryObjecti64v(GLuint id, GLenum pname, GLint64* params) {
     LOG()
+    MG_TRACE_ARGS(glGetQueryObjecti64v, id, pname, params)
     if (GLES.glGetQueryObjecti64vEXT) {
         GLES.glGetQueryObjecti64vEXT(id, pname, params);
         CHECK_GL_ERROR
@@ -26,10 +26,13 @@ extern "C"
     GLAPI GLAPIENTRY const GLubyte* glGetStringi(GLenum name, GLuint index);
     GLAPI GLAPIENTRY GLenum glGetError();
     GLAPI GLAPIENTRY void glGetIntegerv(GLenum pname, GLint* params);
+    GLAPI GLAPIENTRY void glGetFloatv(GLenum pname, GLfloat* data);
+    GLAPI GLAPIENTRY void glGetDoublev(GLenum pname, GLdouble* data);
     GLAPI GLAPIENTRY void glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params);
     GLAPI GLAPIENTRY void glGetQueryObjecti64v(GLuint id, GLenum pname, GLint64* params);
 
     void AppendExtension(const char* ext);
+    GLuint GetExtensionCount();
     void InitGLESBaseExtensions();
     void set_es_version();
 
@@ -39,4 +42,6 @@ extern "C"
 
 extern Version GLVersion;
 
+std::string getGpuName();
+
 #endif // MOBILEGLUES_GETTER_H
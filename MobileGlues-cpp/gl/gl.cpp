@@ -13,17 +13,22 @@
 #include "../config/settings.h"
 #include "mg.h"
 #include "framebuffer.h"
+#include "state.h"
+#include "immediate.h"
 
-#define DEBUG 0
+#include <cmath>
 
-static GLclampd currentDepthValue;
+#define DEBUG 0
 
 extern GLuint current_draw_fbo;
 extern std::vector<framebuffer_t> framebuffers;
 
 void glClearDepth(GLclampd depth) {
     LOG()
-    currentDepthValue = depth;
+    MG_TRACE_ARGS(glClearDepth, depth)
+    FILTER_REDUNDANT_CALL(FilteredCall::ClearDepth, gl_state->clear_depth_known && gl_state->clear_depth == depth)
+    gl_state->clear_depth = depth;
+    gl_state->clear_depth_known = GL_TRUE;
     GLES.glClearDepthf((float)depth);
     CHECK_GL_ERROR
 }
@@ -54,6 +59,7 @@ static const char* kDepthClearFS = R"glsl(
 
 void InitDepthClearCoreProfile() {
     if (g_depthClearProgram) return;
+    StateScope scope(STATE_SCOPE_VERTEX_ARRAY | STATE_SCOPE_ARRAY_BUFFER);
 
     auto compile = [&](GLenum type, const char* src) {
         GLuint s = GLES.glCreateShader(type);
@@ -80,20 +86,12 @@ void InitDepthClearCoreProfile() {
 
     GLES.glEnableVertexAttribArray(0);
     GLES.glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    GLES.glBindBuffer(GL_ARRAY_BUFFER, 0);
-    GLES.glBindVertexArray(0);
 }
 
 void DrawDepthClearTri() {
     InitDepthClearCoreProfile();
 
-    GLboolean prevColorMask[4];
-    GLES.glGetBooleanv(GL_COLOR_WRITEMASK, prevColorMask);
-    GLboolean prevDepthMask;
-    GLES.glGetBooleanv(GL_DEPTH_WRITEMASK, &prevDepthMask);
-    GLint prevDepthFunc;
-    GLES.glGetIntegerv(GL_DEPTH_FUNC, &prevDepthFunc);
+    StateScope scope(STATE_SCOPE_COLOR_MASK | STATE_SCOPE_DEPTH | STATE_SCOPE_PROGRAM | STATE_SCOPE_VERTEX_ARRAY);
 
     GLES.glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
     GLES.glDepthMask(GL_TRUE);
@@ -102,24 +100,21 @@ void DrawDepthClearTri() {
     GLES.glUseProgram(g_depthClearProgram);
     GLES.glBindVertexArray(g_depthClearVAO);
     GLES.glDrawArrays(GL_TRIANGLES, 0, 3);
-    GLES.glBindVertexArray(0);
-    GLES.glUseProgram(0);
-
-    GLES.glDepthFunc(prevDepthFunc);
-    GLES.glDepthMask(prevDepthMask);
-    GLES.glColorMask(prevColorMask[0], prevColorMask[1], prevColorMask[2], prevColorMask[3]);
 }
 
 void glClear(GLbitfield mask) {
     LOG();
+    MG_TRACE_ARGS(glClear, mask)
     LOG_D("glClear, mask = 0x%x", mask);
+    flush_immediate();
 
     INIT_CHECK_GL_ERROR
 
     CHECK_GL_ERROR_NO_INIT
 
     if (global_settings.angle == AngleMode::Enabled && mask == GL_DEPTH_BUFFER_BIT &&
-        fabs(currentDepthValue - 1.0f) <= 0.001f && framebuffers[current_draw_fbo].color_attachments_all_none) {
+        gl_state->clear_depth_known && fabs(gl_state->clear_depth - 1.0f) <= 0.001f &&
+        framebuffers[current_draw_fbo].color_attachments_all_none) {
         LOG_D("doing depth workaround")
         if (global_settings.angle_depth_clear_fix_mode == AngleDepthClearFixMode::Mode1)
             // Workaround for ANGLE depth-clear bug: if depth≈1.0, draw a fullscreen triangle at z=1.0 to force actual
@@ -139,7 +134,22 @@ void glClear(GLbitfield mask) {
     CHECK_GL_ERROR_NO_INIT;
 }
 
+void glFinish() {
+    LOG()
+    MG_TRACE_ARGS(glFinish)
+    flush_immediate();
+    GLES.glFinish();
+}
+
+void glFlush() {
+    LOG()
+    MG_TRACE_ARGS(glFlush)
+    flush_immediate();
+    GLES.glFlush();
+}
+
 void glHint(GLenum target, GLenum mode) {
     LOG()
+    MG_TRACE_ARGS(glHint, target, mode)
     LOG_D("glHint, target = %s, mode = %s", glEnumToString(target), glEnumToString(mode))
 }
@@ -36,10 +36,10 @@ STUB_FUNCTION_HEAD(void, glGetClipPlane, GLenum plane, GLdouble *equation ) STUB
 
 STUB_FUNCTION_HEAD(void, glEnableClientState, GLenum cap ) STUB_FUNCTION_END_NO_RETURN(void, glEnableClientState,cap)
 STUB_FUNCTION_HEAD(void, glDisableClientState, GLenum cap ) STUB_FUNCTION_END_NO_RETURN(void, glDisableClientState,cap)
-STUB_FUNCTION_HEAD(void, glGetDoublev, GLenum pname, GLdouble *params ) STUB_FUNCTION_END_NO_RETURN(void, glGetDoublev,pname,params)
+//STUB_FUNCTION_HEAD(void, glGetDoublev, GLenum pname, GLdouble *params ) STUB_FUNCTION_END_NO_RETURN(void, glGetDoublev,pname,params)
 
-STUB_FUNCTION_HEAD(void, glPushAttrib, GLbitfield mask ) STUB_FUNCTION_END_NO_RETURN(void, glPushAttrib,mask)
-STUB_FUNCTION_HEAD(void, glPopAttrib) STUB_FUNCTION_END_NO_RETURN(void, glPopAttrib)
+//STUB_FUNCTION_HEAD(void, glPushAttrib, GLbitfield mask ) STUB_FUNCTION_END_NO_RETURN(void, glPushAttrib,mask)
+//STUB_FUNCTION_HEAD(void, glPopAttrib) STUB_FUNCTION_END_NO_RETURN(void, glPopAttrib)
 STUB_FUNCTION_HEAD(void, glPushClientAttrib, GLbitfield mask ) STUB_FUNCTION_END_NO_RETURN(void, glPushClientAttrib,mask)
 STUB_FUNCTION_HEAD(void, glPopClientAttrib) STUB_FUNCTION_END_NO_RETURN(void, glPopClientAttrib)
 STUB_FUNCTION_HEAD(GLint, glRenderMode, GLenum mode) STUB_FUNCTION_END(GLint, glRenderMode,mode)
@@ -57,72 +57,72 @@ STUB_FUNCTION_HEAD(void, glAccum, GLenum op, GLfloat value ) STUB_FUNCTION_END_N
 /*
 * Transformation
 */
-STUB_FUNCTION_HEAD(void, glMatrixMode, GLenum mode ) STUB_FUNCTION_END_NO_RETURN(void, glMatrixMode,mode)
-STUB_FUNCTION_HEAD(void, glOrtho, GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble near_val, GLdouble far_val ) STUB_FUNCTION_END_NO_RETURN(void, glOrtho,left,right,bottom,top,near_val,far_val)
-STUB_FUNCTION_HEAD(void, glFrustum, GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble near_val, GLdouble far_val ) STUB_FUNCTION_END_NO_RETURN(void, glFrustum,left,right,bottom,top,near_val,far_val)
-STUB_FUNCTION_HEAD(void, glPushMatrix) STUB_FUNCTION_END_NO_RETURN(void, glPushMatrix)
-STUB_FUNCTION_HEAD(void, glPopMatrix) STUB_FUNCTION_END_NO_RETURN(void, glPopMatrix)
-STUB_FUNCTION_HEAD(void, glLoadIdentity) STUB_FUNCTION_END_NO_RETURN(void, glLoadIdentity)
-STUB_FUNCTION_HEAD(void, glLoadMatrixd, const GLdouble *m ) STUB_FUNCTION_END_NO_RETURN(void, glLoadMatrixd,m)
-STUB_FUNCTION_HEAD(void, glLoadMatrixf, const GLfloat *m ) STUB_FUNCTION_END_NO_RETURN(void, glLoadMatrixf,m)
-STUB_FUNCTION_HEAD(void, glMultMatrixd, const GLdouble *m ) STUB_FUNCTION_END_NO_RETURN(void, glMultMatrixd,m)
-STUB_FUNCTION_HEAD(void, glMultMatrixf, const GLfloat *m ) STUB_FUNCTION_END_NO_RETURN(void, glMultMatrixf,m)
-STUB_FUNCTION_HEAD(void, glRotated, GLdouble angle, GLdouble x, GLdouble y, GLdouble z ) STUB_FUNCTION_END_NO_RETURN(void, glRotated,angle,x,y,z)
-STUB_FUNCTION_HEAD(void, glRotatef, GLfloat angle, GLfloat x, GLfloat y, GLfloat z ) STUB_FUNCTION_END_NO_RETURN(void, glRotatef,angle,x,y,z)
-STUB_FUNCTION_HEAD(void, glScaled, GLdouble x, GLdouble y, GLdouble z ) STUB_FUNCTION_END_NO_RETURN(void, glScaled,x,y,z)
-STUB_FUNCTION_HEAD(void, glScalef, GLfloat x, GLfloat y, GLfloat z ) STUB_FUNCTION_END_NO_RETURN(void, glScalef,x,y,z)
-STUB_FUNCTION_HEAD(void, glTranslated, GLdouble x, GLdouble y, GLdouble z ) STUB_FUNCTION_END_NO_RETURN(void, glTranslated,x,y,z)
-STUB_FUNCTION_HEAD(void, glTranslatef, GLfloat x, GLfloat y, GLfloat z ) STUB_FUNCTION_END_NO_RETURN(void, glTranslatef,x,y,z)
+//STUB_FUNCTION_HEAD(void, glMatrixMode, GLenum mode ) STUB_FUNCTION_END_NO_RETURN(void, glMatrixMode,mode)
+//STUB_FUNCTION_HEAD(void, glOrtho, GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble near_val, GLdouble far_val ) STUB_FUNCTION_END_NO_RETURN(void, glOrtho,left,right,bottom,top,near_val,far_val)
+//STUB_FUNCTION_HEAD(void, glFrustum, GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble near_val, GLdouble far_val ) STUB_FUNCTION_END_NO_RETURN(void, glFrustum,left,right,bottom,top,near_val,far_val)
+//STUB_FUNCTION_HEAD(void, glPushMatrix) STUB_FUNCTION_END_NO_RETURN(void, glPushMatrix)
+//STUB_FUNCTION_HEAD(void, glPopMatrix) STUB_FUNCTION_END_NO_RETURN(void, glPopMatrix)
+//STUB_FUNCTION_HEAD(void, glLoadIdentity) STUB_FUNCTION_END_NO_RETURN(void, glLoadIdentity)
+//STUB_FUNCTION_HEAD(void, glLoadMatrixd, const GLdouble *m ) STUB_FUNCTION_END_NO_RETURN(void, glLoadMatrixd,m)
+//STUB_FUNCTION_HEAD(void, glLoadMatrixf, const GLfloat *m ) STUB_FUNCTION_END_NO_RETURN(void, glLoadMatrixf,m)
+//STUB_FUNCTION_HEAD(void, glMultMatrixd, const GLdouble *m ) STUB_FUNCTION_END_NO_RETURN(void, glMultMatrixd,m)
+//STUB_FUNCTION_HEAD(void, glMultMatrixf, const GLfloat *m ) STUB_FUNCTION_END_NO_RETURN(void, glMultMatrixf,m)
+//STUB_FUNCTION_HEAD(void, glRotated, GLdouble angle, GLdouble x, GLdouble y, GLdouble z ) STUB_FUNCTION_END_NO_RETURN(void, glRotated,angle,x,y,z)
+//STUB_FUNCTION_HEAD(void, glRotatef, GLfloat angle, GLfloat x, GLfloat y, GLfloat z ) STUB_FUNCTION_END_NO_RETURN(void, glRotatef,angle,x,y,z)
+//STUB_FUNCTION_HEAD(void, glScaled, GLdouble x, GLdouble y, GLdouble z ) STUB_FUNCTION_END_NO_RETURN(void, glScaled,x,y,z)
+//STUB_FUNCTION_HEAD(void, glScalef, GLfloat x, GLfloat y, GLfloat z ) STUB_FUNCTION_END_NO_RETURN(void, glScalef,x,y,z)
+//STUB_FUNCTION_HEAD(void, glTranslated, GLdouble x, GLdouble y, GLdouble z ) STUB_FUNCTION_END_NO_RETURN(void, glTranslated,x,y,z)
+//STUB_FUNCTION_HEAD(void, glTranslatef, GLfloat x, GLfloat y, GLfloat z ) STUB_FUNCTION_END_NO_RETURN(void, glTranslatef,x,y,z)
 /*
 * Display Lists
 */
-STUB_FUNCTION_HEAD(GLboolean, glIsList, GLuint list ); STUB_FUNCTION_END(GLboolean, glIsList,list)
-STUB_FUNCTION_HEAD(void, glDeleteLists, GLuint list, GLsizei range ) STUB_FUNCTION_END_NO_RETURN(void, glDeleteLists,list,range)
-STUB_FUNCTION_HEAD(GLuint, glGenLists, GLsizei range ) STUB_FUNCTION_END(GLuint, glGenLists,range)
-STUB_FUNCTION_HEAD(void, glNewList, GLuint list, GLenum mode ) STUB_FUNCTION_END_NO_RETURN(void, glNewList,list,mode)
-STUB_FUNCTION_HEAD(void, glEndList) STUB_FUNCTION_END_NO_RETURN(void, glEndList)
-STUB_FUNCTION_HEAD(void, glCallList, GLuint list ) STUB_FUNCTION_END_NO_RETURN(void, glCallList,list)
-STUB_FUNCTION_HEAD(void, glCallLists, GLsizei n, GLenum type,const GLvoid* lists ) STUB_FUNCTION_END_NO_RETURN(void, glCallLists,n,type,lists)
-STUB_FUNCTION_HEAD(void, glListBase, GLuint base ) STUB_FUNCTION_END_NO_RETURN(void, glListBase,base)
+//STUB_FUNCTION_HEAD(GLboolean, glIsList, GLuint list ); STUB_FUNCTION_END(GLboolean, glIsList,list)
+//STUB_FUNCTION_HEAD(void, glDeleteLists, GLuint list, GLsizei range ) STUB_FUNCTION_END_NO_RETURN(void, glDeleteLists,list,range)
+//STUB_FUNCTION_HEAD(GLuint, glGenLists, GLsizei range ) STUB_FUNCTION_END(GLuint, glGenLists,range)
+//STUB_FUNCTION_HEAD(void, glNewList, GLuint list, GLenum mode ) STUB_FUNCTION_END_NO_RETURN(void, glNewList,list,mode)
+//STUB_FUNCTION_HEAD(void, glEndList) STUB_FUNCTION_END_NO_RETURN(void, glEndList)
+//STUB_FUNCTION_HEAD(void, glCallList, GLuint list ) STUB_FUNCTION_END_NO_RETURN(void, glCallList,list)
+//STUB_FUNCTION_HEAD(void, glCallLists, GLsizei n, GLenum type,const GLvoid* lists ) STUB_FUNCTION_END_NO_RETURN(void, glCallLists,n,type,lists)
+//STUB_FUNCTION_HEAD(void, glListBase, GLuint base ) STUB_FUNCTION_END_NO_RETURN(void, glListBase,base)
 /*
 * Drawing Functions
 */
-STUB_FUNCTION_HEAD(void, glBegin, GLenum mode ) STUB_FUNCTION_END_NO_RETURN(void, glBegin,mode)
-STUB_FUNCTION_HEAD(void, glEnd) STUB_FUNCTION_END_NO_RETURN(void, glEnd)
-STUB_FUNCTION_HEAD(void, glVertex2d, GLdouble x, GLdouble y ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2d,x,y)
-STUB_FUNCTION_HEAD(void, glVertex2f, GLfloat x, GLfloat y ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2f,x,y)
-STUB_FUNCTION_HEAD(void, glVertex2i, GLint x, GLint y ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2i,x,y)
-STUB_FUNCTION_HEAD(void, glVertex2s, GLshort x, GLshort y ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2s,x,y)
-STUB_FUNCTION_HEAD(void, glVertex3d, GLdouble x, GLdouble y, GLdouble z ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3d,x,y,z)
-STUB_FUNCTION_HEAD(void, glVertex3f, GLfloat x, GLfloat y, GLfloat z ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3f,x,y,z)
-STUB_FUNCTION_HEAD(void, glVertex3i, GLint x, GLint y, GLint z ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3i,x,y,z)
-STUB_FUNCTION_HEAD(void, glVertex3s, GLshort x, GLshort y, GLshort z ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3s,x,y,z)
-STUB_FUNCTION_HEAD(void, glVertex4d, GLdouble x, GLdouble y, GLdouble z, GLdouble w ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4d,x,y,z,w)
-STUB_FUNCTION_HEAD(void, glVertex4f, GLfloat x, GLfloat y, GLfloat z, GLfloat w ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4f,x,y,z,w)
-STUB_FUNCTION_HEAD(void, glVertex4i, GLint x, GLint y, GLint z, GLint w ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4i,x,y,z,w)
-STUB_FUNCTION_HEAD(void, glVertex4s, GLshort x, GLshort y, GLshort z, GLshort w ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4s,x,y,z,w)
-STUB_FUNCTION_HEAD(void, glVertex2dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2dv,v)
-STUB_FUNCTION_HEAD(void, glVertex2fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2fv,v)
-STUB_FUNCTION_HEAD(void, glVertex2iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2iv,v)
-STUB_FUNCTION_HEAD(void, glVertex2sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2sv,v)
-STUB_FUNCTION_HEAD(void, glVertex3dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3dv,v)
-STUB_FUNCTION_HEAD(void, glVertex3fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3fv,v)
-STUB_FUNCTION_HEAD(void, glVertex3iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3iv,v)
-STUB_FUNCTION_HEAD(void, glVertex3sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3sv,v)
-STUB_FUNCTION_HEAD(void, glVertex4dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4dv,v)
-STUB_FUNCTION_HEAD(void, glVertex4fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4fv,v)
-STUB_FUNCTION_HEAD(void, glVertex4iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4iv,v)
-STUB_FUNCTION_HEAD(void, glVertex4sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4sv,v)
-STUB_FUNCTION_HEAD(void, glNormal3b, GLbyte nx, GLbyte ny, GLbyte nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3b,nx,ny,nz)
-STUB_FUNCTION_HEAD(void, glNormal3d, GLdouble nx, GLdouble ny, GLdouble nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3d,nx,ny,nz)
-STUB_FUNCTION_HEAD(void, glNormal3f, GLfloat nx, GLfloat ny, GLfloat nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3f,nx,ny,nz)
-STUB_FUNCTION_HEAD(void, glNormal3i, GLint nx, GLint ny, GLint nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3i,nx,ny,nz)
-STUB_FUNCTION_HEAD(void, glNormal3s, GLshort nx, GLshort ny, GLshort nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3s,nx,ny,nz)
-STUB_FUNCTION_HEAD(void, glNormal3bv, const GLbyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3bv,v)
-STUB_FUNCTION_HEAD(void, glNormal3dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3dv,v)
-STUB_FUNCTION_HEAD(void, glNormal3fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3fv,v)
-STUB_FUNCTION_HEAD(void, glNormal3iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3iv,v)
-STUB_FUNCTION_HEAD(void, glNormal3sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3sv,v)
+//STUB_FUNCTION_HEAD(void, glBegin, GLenum mode ) STUB_FUNCTION_END_NO_RETURN(void, glBegin,mode)
+//STUB_FUNCTION_HEAD(void, glEnd) STUB_FUNCTION_END_NO_RETURN(void, glEnd)
+//STUB_FUNCTION_HEAD(void, glVertex2d, GLdouble x, GLdouble y ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2d,x,y)
+//STUB_FUNCTION_HEAD(void, glVertex2f, GLfloat x, GLfloat y ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2f,x,y)
+//STUB_FUNCTION_HEAD(void, glVertex2i, GLint x, GLint y ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2i,x,y)
+//STUB_FUNCTION_HEAD(void, glVertex2s, GLshort x, GLshort y ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2s,x,y)
+//STUB_FUNCTION_HEAD(void, glVertex3d, GLdouble x, GLdouble y, GLdouble z ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3d,x,y,z)
+//STUB_FUNCTION_HEAD(void, glVertex3f, GLfloat x, GLfloat y, GLfloat z ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3f,x,y,z)
+//STUB_FUNCTION_HEAD(void, glVertex3i, GLint x, GLint y, GLint z ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3i,x,y,z)
+//STUB_FUNCTION_HEAD(void, glVertex3s, GLshort x, GLshort y, GLshort z ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3s,x,y,z)
+//STUB_FUNCTION_HEAD(void, glVertex4d, GLdouble x, GLdouble y, GLdouble z, GLdouble w ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4d,x,y,z,w)
+//STUB_FUNCTION_HEAD(void, glVertex4f, GLfloat x, GLfloat y, GLfloat z, GLfloat w ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4f,x,y,z,w)
+//STUB_FUNCTION_HEAD(void, glVertex4i, GLint x, GLint y, GLint z, GLint w ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4i,x,y,z,w)
+//STUB_FUNCTION_HEAD(void, glVertex4s, GLshort x, GLshort y, GLshort z, GLshort w ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4s,x,y,z,w)
+//STUB_FUNCTION_HEAD(void, glVertex2dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2dv,v)
+//STUB_FUNCTION_HEAD(void, glVertex2fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2fv,v)
+//STUB_FUNCTION_HEAD(void, glVertex2iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2iv,v)
+//STUB_FUNCTION_HEAD(void, glVertex2sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex2sv,v)
+//STUB_FUNCTION_HEAD(void, glVertex3dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3dv,v)
+//STUB_FUNCTION_HEAD(void, glVertex3fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3fv,v)
+//STUB_FUNCTION_HEAD(void, glVertex3iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3iv,v)
+//STUB_FUNCTION_HEAD(void, glVertex3sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex3sv,v)
+//STUB_FUNCTION_HEAD(void, glVertex4dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4dv,v)
+//STUB_FUNCTION_HEAD(void, glVertex4fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4fv,v)
+//STUB_FUNCTION_HEAD(void, glVertex4iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4iv,v)
+//STUB_FUNCTION_HEAD(void, glVertex4sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glVertex4sv,v)
+//STUB_FUNCTION_HEAD(void, glNormal3b, GLbyte nx, GLbyte ny, GLbyte nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3b,nx,ny,nz)
+//STUB_FUNCTION_HEAD(void, glNormal3d, GLdouble nx, GLdouble ny, GLdouble nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3d,nx,ny,nz)
+//STUB_FUNCTION_HEAD(void, glNormal3f, GLfloat nx, GLfloat ny, GLfloat nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3f,nx,ny,nz)
+//STUB_FUNCTION_HEAD(void, glNormal3i, GLint nx, GLint ny, GLint nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3i,nx,ny,nz)
+//STUB_FUNCTION_HEAD(void, glNormal3s, GLshort nx, GLshort ny, GLshort nz ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3s,nx,ny,nz)
+//STUB_FUNCTION_HEAD(void, glNormal3bv, const GLbyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3bv,v)
+//STUB_FUNCTION_HEAD(void, glNormal3dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3dv,v)
+//STUB_FUNCTION_HEAD(void, glNormal3fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3fv,v)
+//STUB_FUNCTION_HEAD(void, glNormal3iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3iv,v)
+//STUB_FUNCTION_HEAD(void, glNormal3sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glNormal3sv,v)
 STUB_FUNCTION_HEAD(void, glIndexd, GLdouble c ) STUB_FUNCTION_END_NO_RETURN(void, glIndexd,c)
 STUB_FUNCTION_HEAD(void, glIndexf, GLfloat c ) STUB_FUNCTION_END_NO_RETURN(void, glIndexf,c)
 STUB_FUNCTION_HEAD(void, glIndexi, GLint c ) STUB_FUNCTION_END_NO_RETURN(void, glIndexi,c)
@@ -133,70 +133,70 @@ STUB_FUNCTION_HEAD(void, glIndexfv, const GLfloat *c ) STUB_FUNCTION_END_NO_RETU
 STUB_FUNCTION_HEAD(void, glIndexiv, const GLint *c ) STUB_FUNCTION_END_NO_RETURN(void, glIndexiv,c)
 STUB_FUNCTION_HEAD(void, glIndexsv, const GLshort *c ) STUB_FUNCTION_END_NO_RETURN(void, glIndexsv,c)
 STUB_FUNCTION_HEAD(void, glIndexubv, const GLubyte *c ) STUB_FUNCTION_END_NO_RETURN(void, glIndexubv,c)
-STUB_FUNCTION_HEAD(void, glColor3b, GLbyte red, GLbyte green, GLbyte blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3b,red,green,blue)
-STUB_FUNCTION_HEAD(void, glColor3d, GLdouble red, GLdouble green, GLdouble blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3d,red,green,blue)
-STUB_FUNCTION_HEAD(void, glColor3f, GLfloat red, GLfloat green, GLfloat blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3f,red,green,blue)
-STUB_FUNCTION_HEAD(void, glColor3i, GLint red, GLint green, GLint blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3i,red,green,blue)
-STUB_FUNCTION_HEAD(void, glColor3s, GLshort red, GLshort green, GLshort blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3s,red,green,blue)
-STUB_FUNCTION_HEAD(void, glColor3ub, GLubyte red, GLubyte green, GLubyte blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3ub,red,green,blue)
-STUB_FUNCTION_HEAD(void, glColor3ui, GLuint red, GLuint green, GLuint blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3ui,red,green,blue)
-STUB_FUNCTION_HEAD(void, glColor3us, GLushort red, GLushort green, GLushort blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3us,red,green,blue)
-STUB_FUNCTION_HEAD(void, glColor4b, GLbyte red, GLbyte green, GLbyte blue, GLbyte alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4b,red,green,blue,alpha)
-STUB_FUNCTION_HEAD(void, glColor4d, GLdouble red, GLdouble green, GLdouble blue, GLdouble alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4d,red,green,blue,alpha)
-STUB_FUNCTION_HEAD(void, glColor4f, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4f,red,green,blue,alpha)
-STUB_FUNCTION_HEAD(void, glColor4i, GLint red, GLint green, GLint blue, GLint alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4i,red,green,blue,alpha)
-STUB_FUNCTION_HEAD(void, glColor4s, GLshort red, GLshort green, GLshort blue, GLshort alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4s,red,green,blue,alpha)
-STUB_FUNCTION_HEAD(void, glColor4ub, GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4ub,red,green,blue,alpha)
-STUB_FUNCTION_HEAD(void, glColor4ui, GLuint red, GLuint green, GLuint blue, GLuint alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4ui,red,green,blue,alpha)
-STUB_FUNCTION_HEAD(void, glColor4us, GLushort red, GLushort green, GLushort blue, GLushort alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4us,red,green,blue,alpha)
-STUB_FUNCTION_HEAD(void, glColor3bv, const GLbyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3bv,v)
-STUB_FUNCTION_HEAD(void, glColor3dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3dv,v)
-STUB_FUNCTION_HEAD(void, glColor3fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3fv,v)
-STUB_FUNCTION_HEAD(void, glColor3iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3iv,v)
-STUB_FUNCTION_HEAD(void, glColor3sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3sv,v)
-STUB_FUNCTION_HEAD(void, glColor3ubv, const GLubyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3ubv,v)
-STUB_FUNCTION_HEAD(void, glColor3uiv, const GLuint *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3uiv,v)
-STUB_FUNCTION_HEAD(void, glColor3usv, const GLushort *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3usv,v)
-STUB_FUNCTION_HEAD(void, glColor4bv, const GLbyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4bv,v)
-STUB_FUNCTION_HEAD(void, glColor4dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4dv,v)
-STUB_FUNCTION_HEAD(void, glColor4fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4fv,v)
-STUB_FUNCTION_HEAD(void, glColor4iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4iv,v)
-STUB_FUNCTION_HEAD(void, glColor4sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4sv,v)
-STUB_FUNCTION_HEAD(void, glColor4ubv, const GLubyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4ubv,v)
-STUB_FUNCTION_HEAD(void, glColor4uiv, const GLuint *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4uiv,v)
-STUB_FUNCTION_HEAD(void, glColor4usv, const GLushort *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4usv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord1d, GLdouble s ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1d,s)
-STUB_FUNCTION_HEAD(void, glTexCoord1f, GLfloat s ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1f,s)
-STUB_FUNCTION_HEAD(void, glTexCoord1i, GLint s ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1i,s)
-STUB_FUNCTION_HEAD(void, glTexCoord1s, GLshort s ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1s,s)
-STUB_FUNCTION_HEAD(void, glTexCoord2d, GLdouble s, GLdouble t ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2d,s,t)
-STUB_FUNCTION_HEAD(void, glTexCoord2f, GLfloat s, GLfloat t ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2f,s,t)
-STUB_FUNCTION_HEAD(void, glTexCoord2i, GLint s, GLint t ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2i,s,t)
-STUB_FUNCTION_HEAD(void, glTexCoord2s, GLshort s, GLshort t ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2s,s,t)
-STUB_FUNCTION_HEAD(void, glTexCoord3d, GLdouble s, GLdouble t, GLdouble r ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3d,s,t,r)
-STUB_FUNCTION_HEAD(void, glTexCoord3f, GLfloat s, GLfloat t, GLfloat r ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3f,s,t,r)
-STUB_FUNCTION_HEAD(void, glTexCoord3i, GLint s, GLint t, GLint r ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3i,s,t,r)
-STUB_FUNCTION_HEAD(void, glTexCoord3s, GLshort s, GLshort t, GLshort r ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3s,s,t,r)
-STUB_FUNCTION_HEAD(void, glTexCoord4d, GLdouble s, GLdouble t, GLdouble r, GLdouble q ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4d,s,t,r,q)
-STUB_FUNCTION_HEAD(void, glTexCoord4f, GLfloat s, GLfloat t, GLfloat r, GLfloat q ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4f,s,t,r,q)
-STUB_FUNCTION_HEAD(void, glTexCoord4i, GLint s, GLint t, GLint r, GLint q ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4i,s,t,r,q)
-STUB_FUNCTION_HEAD(void, glTexCoord4s, GLshort s, GLshort t, GLshort r, GLshort q ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4s,s,t,r,q)
-STUB_FUNCTION_HEAD(void, glTexCoord1dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1dv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord1fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1fv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord1iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1iv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord1sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1sv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord2dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2dv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord2fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2fv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord2iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2iv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord2sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2sv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord3dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3dv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord3fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3fv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord3iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3iv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord3sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3sv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord4dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4dv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord4fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4fv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord4iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4iv,v)
-STUB_FUNCTION_HEAD(void, glTexCoord4sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4sv,v)
+//STUB_FUNCTION_HEAD(void, glColor3b, GLbyte red, GLbyte green, GLbyte blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3b,red,green,blue)
+//STUB_FUNCTION_HEAD(void, glColor3d, GLdouble red, GLdouble green, GLdouble blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3d,red,green,blue)
+//STUB_FUNCTION_HEAD(void, glColor3f, GLfloat red, GLfloat green, GLfloat blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3f,red,green,blue)
+//STUB_FUNCTION_HEAD(void, glColor3i, GLint red, GLint green, GLint blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3i,red,green,blue)
+//STUB_FUNCTION_HEAD(void, glColor3s, GLshort red, GLshort green, GLshort blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3s,red,green,blue)
+//STUB_FUNCTION_HEAD(void, glColor3ub, GLubyte red, GLubyte green, GLubyte blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3ub,red,green,blue)
+//STUB_FUNCTION_HEAD(void, glColor3ui, GLuint red, GLuint green, GLuint blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3ui,red,green,blue)
+//STUB_FUNCTION_HEAD(void, glColor3us, GLushort red, GLushort green, GLushort blue ) STUB_FUNCTION_END_NO_RETURN(void, glColor3us,red,green,blue)
+//STUB_FUNCTION_HEAD(void, glColor4b, GLbyte red, GLbyte green, GLbyte blue, GLbyte alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4b,red,green,blue,alpha)
+//STUB_FUNCTION_HEAD(void, glColor4d, GLdouble red, GLdouble green, GLdouble blue, GLdouble alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4d,red,green,blue,alpha)
+//STUB_FUNCTION_HEAD(void, glColor4f, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4f,red,green,blue,alpha)
+//STUB_FUNCTION_HEAD(void, glColor4i, GLint red, GLint green, GLint blue, GLint alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4i,red,green,blue,alpha)
+//STUB_FUNCTION_HEAD(void, glColor4s, GLshort red, GLshort green, GLshort blue, GLshort alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4s,red,green,blue,alpha)
+//STUB_FUNCTION_HEAD(void, glColor4ub, GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4ub,red,green,blue,alpha)
+//STUB_FUNCTION_HEAD(void, glColor4ui, GLuint red, GLuint green, GLuint blue, GLuint alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4ui,red,green,blue,alpha)
+//STUB_FUNCTION_HEAD(void, glColor4us, GLushort red, GLushort green, GLushort blue, GLushort alpha ) STUB_FUNCTION_END_NO_RETURN(void, glColor4us,red,green,blue,alpha)
+//STUB_FUNCTION_HEAD(void, glColor3bv, const GLbyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3bv,v)
+//STUB_FUNCTION_HEAD(void, glColor3dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3dv,v)
+//STUB_FUNCTION_HEAD(void, glColor3fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3fv,v)
+//STUB_FUNCTION_HEAD(void, glColor3iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3iv,v)
+//STUB_FUNCTION_HEAD(void, glColor3sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3sv,v)
+//STUB_FUNCTION_HEAD(void, glColor3ubv, const GLubyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3ubv,v)
+//STUB_FUNCTION_HEAD(void, glColor3uiv, const GLuint *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3uiv,v)
+//STUB_FUNCTION_HEAD(void, glColor3usv, const GLushort *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor3usv,v)
+//STUB_FUNCTION_HEAD(void, glColor4bv, const GLbyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4bv,v)
+//STUB_FUNCTION_HEAD(void, glColor4dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4dv,v)
+//STUB_FUNCTION_HEAD(void, glColor4fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4fv,v)
+//STUB_FUNCTION_HEAD(void, glColor4iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4iv,v)
+//STUB_FUNCTION_HEAD(void, glColor4sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4sv,v)
+//STUB_FUNCTION_HEAD(void, glColor4ubv, const GLubyte *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4ubv,v)
+//STUB_FUNCTION_HEAD(void, glColor4uiv, const GLuint *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4uiv,v)
+//STUB_FUNCTION_HEAD(void, glColor4usv, const GLushort *v ) STUB_FUNCTION_END_NO_RETURN(void, glColor4usv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord1d, GLdouble s ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1d,s)
+//STUB_FUNCTION_HEAD(void, glTexCoord1f, GLfloat s ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1f,s)
+//STUB_FUNCTION_HEAD(void, glTexCoord1i, GLint s ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1i,s)
+//STUB_FUNCTION_HEAD(void, glTexCoord1s, GLshort s ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1s,s)
+//STUB_FUNCTION_HEAD(void, glTexCoord2d, GLdouble s, GLdouble t ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2d,s,t)
+//STUB_FUNCTION_HEAD(void, glTexCoord2f, GLfloat s, GLfloat t ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2f,s,t)
+//STUB_FUNCTION_HEAD(void, glTexCoord2i, GLint s, GLint t ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2i,s,t)
+//STUB_FUNCTION_HEAD(void, glTexCoord2s, GLshort s, GLshort t ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2s,s,t)
+//STUB_FUNCTION_HEAD(void, glTexCoord3d, GLdouble s, GLdouble t, GLdouble r ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3d,s,t,r)
+//STUB_FUNCTION_HEAD(void, glTexCoord3f, GLfloat s, GLfloat t, GLfloat r ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3f,s,t,r)
+//STUB_FUNCTION_HEAD(void, glTexCoord3i, GLint s, GLint t, GLint r ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3i,s,t,r)
+//STUB_FUNCTION_HEAD(void, glTexCoord3s, GLshort s, GLshort t, GLshort r ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3s,s,t,r)
+//STUB_FUNCTION_HEAD(void, glTexCoord4d, GLdouble s, GLdouble t, GLdouble r, GLdouble q ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4d,s,t,r,q)
+//STUB_FUNCTION_HEAD(void, glTexCoord4f, GLfloat s, GLfloat t, GLfloat r, GLfloat q ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4f,s,t,r,q)
+//STUB_FUNCTION_HEAD(void, glTexCoord4i, GLint s, GLint t, GLint r, GLint q ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4i,s,t,r,q)
+//STUB_FUNCTION_HEAD(void, glTexCoord4s, GLshort s, GLshort t, GLshort r, GLshort q ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4s,s,t,r,q)
+//STUB_FUNCTION_HEAD(void, glTexCoord1dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1dv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord1fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1fv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord1iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1iv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord1sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord1sv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord2dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2dv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord2fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2fv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord2iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2iv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord2sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord2sv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord3dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3dv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord3fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3fv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord3iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3iv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord3sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord3sv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord4dv, const GLdouble *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4dv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord4fv, const GLfloat *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4fv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord4iv, const GLint *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4iv,v)
+//STUB_FUNCTION_HEAD(void, glTexCoord4sv, const GLshort *v ) STUB_FUNCTION_END_NO_RETURN(void, glTexCoord4sv,v)
 STUB_FUNCTION_HEAD(void, glRasterPos2d, GLdouble x, GLdouble y ) STUB_FUNCTION_END_NO_RETURN(void, glRasterPos2d,x,y)
 STUB_FUNCTION_HEAD(void, glRasterPos2f, GLfloat x, GLfloat y ) STUB_FUNCTION_END_NO_RETURN(void, glRasterPos2f,x,y)
 STUB_FUNCTION_HEAD(void, glRasterPos2i, GLint x, GLint y ) STUB_FUNCTION_END_NO_RETURN(void, glRasterPos2i,x,y)
@@ -421,10 +421,10 @@ STUB_FUNCTION_HEAD(void, glMultiTexCoord4i, GLenum target, GLint s, GLint t, GLi
 STUB_FUNCTION_HEAD(void, glMultiTexCoord4iv, GLenum target, const GLint* v); STUB_FUNCTION_END_NO_RETURN(void, glMultiTexCoord4iv,target,v)
 STUB_FUNCTION_HEAD(void, glMultiTexCoord4s, GLenum target, GLshort s, GLshort t, GLshort r, GLshort q); STUB_FUNCTION_END_NO_RETURN(void, glMultiTexCoord4s,target,s,t,r,q)
 STUB_FUNCTION_HEAD(void, glMultiTexCoord4sv, GLenum target, const GLshort* v); STUB_FUNCTION_END_NO_RETURN(void, glMultiTexCoord4sv,target,v)
-STUB_FUNCTION_HEAD(void, glLoadTransposeMatrixf,const GLfloat* m); STUB_FUNCTION_END_NO_RETURN(void, glLoadTransposeMatrixf,m)
-STUB_FUNCTION_HEAD(void, glLoadTransposeMatrixd,const GLdouble* m); STUB_FUNCTION_END_NO_RETURN(void, glLoadTransposeMatrixd,m)
-STUB_FUNCTION_HEAD(void, glMultTransposeMatrixf,const GLfloat* m); STUB_FUNCTION_END_NO_RETURN(void, glMultTransposeMatrixf,m)
-STUB_FUNCTION_HEAD(void, glMultTransposeMatrixd,const GLdouble* m); STUB_FUNCTION_END_NO_RETURN(void, glMultTransposeMatrixd,m)
+//STUB_FUNCTION_HEAD(void, glLoadTransposeMatrixf,const GLfloat* m); STUB_FUNCTION_END_NO_RETURN(void, glLoadTransposeMatrixf,m)
+//STUB_FUNCTION_HEAD(void, glLoadTransposeMatrixd,const GLdouble* m); STUB_FUNCTION_END_NO_RETURN(void, glLoadTransposeMatrixd,m)
+//STUB_FUNCTION_HEAD(void, glMultTransposeMatrixf,const GLfloat* m); STUB_FUNCTION_END_NO_RETURN(void, glMultTransposeMatrixf,m)
+//STUB_FUNCTION_HEAD(void, glMultTransposeMatrixd,const GLdouble* m); STUB_FUNCTION_END_NO_RETURN(void, glMultTransposeMatrixd,m)
 STUB_FUNCTION_HEAD(void, glMultiDrawArrays, GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawcount); STUB_FUNCTION_END_NO_RETURN(void, glMultiDrawArrays,mode,first,count,drawcount)
 //STUB_FUNCTION_HEAD(void, glMultiDrawElements, GLenum mode, const GLsizei* count, GLenum type, const void* const*indices, GLsizei drawcount); STUB_FUNCTION_END_NO_RETURN(void, glMultiDrawElements,mode,count,type,indices,drawcount)
 STUB_FUNCTION_HEAD(void, glPointParameterf, GLenum pname, GLfloat param); STUB_FUNCTION_END_NO_RETURN(void, glPointParameterf,pname,param)
@@ -6,219 +6,526 @@
 // End of Source File Header
 
 #include "cache.h"
-#include <fstream>
+#include <cerrno>
 #include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <ctime>
+#include <optional>
+#include <unistd.h>
 #include <vector>
+#include <xxhash32.h>
 
 using namespace std;
 
-// SHA256
-static const uint32_t k[64] = {
-    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
-
+// On-disk layout: FileHeader, then a sequence of RecordHeader + ESSL bytes.
+// A record is only trusted if its checksum matches; anything after the first
+// bad record is a torn write and gets truncated away.
+//
+// The index file is an IndexHeader followed by one IndexEntry per live record,
+// oldest first so recency survives a restart. It is only used if it names the
+// log's current generation (a fresh one is drawn whenever the log is rewritten)
+// and the log is at least as long as when the index was written. Records
+// appended after that are scanned as usual.
+//
+// Several processes may share the log. Anything that writes it (the header,
+// appends, tail truncation and compaction) holds an exclusive flock on it, and
+// a process whose log was compacted away by another one stops writing to it.
 namespace {
-    inline uint32_t rotr(uint32_t x, uint32_t n) {
-        return (x >> n) | (x << (32 - n));
-    }
-    inline uint32_t sigma0(uint32_t x) {
-        return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3);
-    }
-    inline uint32_t sigma1(uint32_t x) {
-        return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10);
-    }
-    inline uint32_t Sigma0(uint32_t x) {
-        return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22);
-    }
-    inline uint32_t Sigma1(uint32_t x) {
-        return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25);
-    }
-    inline uint32_t ch(uint32_t x, uint32_t y, uint32_t z) {
-        return (x & y) ^ (~x & z);
+    constexpr char CACHE_MAGIC[8] = {'M', 'G', 'G', 'L', 'S', 'L', 'C', '\0'};
+    constexpr uint32_t CACHE_VERSION = 1;
+    constexpr uint32_t RECORD_MAGIC = 0x52435347; // "GSCR"
+    constexpr size_t COMPACT_MIN_DEAD_BYTES = 1024 * 1024;
+    constexpr char INDEX_MAGIC[8] = {'M', 'G', 'G', 'L', 'S', 'L', 'I', '\0'};
+    constexpr uint32_t INDEX_VERSION = 1;
+    constexpr uint64_t NO_OFFSET = UINT64_MAX;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t generation;
+    };
+
+    struct RecordHeader {
+        uint32_t magic;
+        uint32_t checksum;
+        uint32_t esslSize;
+        uint8_t sha256[32];
+    };
+
+    struct IndexHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t generation;
+        uint64_t logSize;
+        uint32_t count;
+        uint32_t checksum;
+    };
+
+    struct IndexEntry {
+        uint8_t sha256[32];
+        uint64_t offset;
+        uint32_t esslSize;
+        uint32_t reserved;
+    };
+
+    inline size_t recordSize(size_t esslSize) {
+        return sizeof(RecordHeader) + esslSize;
     }
-    inline uint32_t maj(uint32_t x, uint32_t y, uint32_t z) {
-        return (x & y) ^ (x & z) ^ (y & z);
-    }
-} // namespace
-
-array<uint8_t, 32> Cache::computeSHA256(const char* data) {
-    vector<uint8_t> input(reinterpret_cast<const uint8_t*>(data),
-                          reinterpret_cast<const uint8_t*>(data) + strlen(data));
 
-    uint64_t bit_length = input.size() * 8;
-    input.push_back(0x80);
-    while ((input.size() % 64) != 56)
-        input.push_back(0x00);
-
-    for (int i = 0; i < 8; ++i) {
-        input.push_back(static_cast<uint8_t>(bit_length >> (56 - i * 8)));
+    uint32_t recordChecksum(const uint8_t* sha256, uint32_t esslSize, const char* essl) {
+        XXHash32 hasher(RECORD_MAGIC);
+        hasher.add(sha256, 32);
+        hasher.add(&esslSize, sizeof(esslSize));
+        hasher.add(essl, esslSize);
+        return hasher.hash();
     }
 
-    uint32_t h[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
-
-    for (size_t i = 0; i < input.size(); i += 64) {
-        uint32_t w[64] = {0};
-        for (int t = 0; t < 16; ++t) {
-            w[t] = (input[i + t * 4] << 24) | (input[i + t * 4 + 1] << 16) | (input[i + t * 4 + 2] << 8) |
-                   input[i + t * 4 + 3];
-        }
-
-        for (int t = 16; t < 64; ++t) {
-            w[t] = sigma1(w[t - 2]) + w[t - 7] + sigma0(w[t - 15]) + w[t - 16];
-        }
+    void buildRecord(string& out, const digest::SHA256& sha256, string_view essl) {
+        RecordHeader header{};
+        header.magic = RECORD_MAGIC;
+        header.esslSize = static_cast<uint32_t>(essl.size());
+        memcpy(header.sha256, sha256.data(), sha256.size());
+        header.checksum = recordChecksum(header.sha256, header.esslSize, essl.data());
+        out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.append(essl.data(), essl.size());
+    }
 
-        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
-
-        for (int t = 0; t < 64; ++t) {
-            uint32_t T1 = hh + Sigma1(e) + ch(e, f, g) + k[t] + w[t];
-            uint32_t T2 = Sigma0(a) + maj(a, b, c);
-            hh = g;
-            g = f;
-            f = e;
-            e = d + T1;
-            d = c;
-            c = b;
-            b = a;
-            a = T1 + T2;
+    bool writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += written;
+            size -= written;
         }
+        return true;
+    }
 
-        h[0] += a;
-        h[1] += b;
-        h[2] += c;
-        h[3] += d;
-        h[4] += e;
-        h[5] += f;
-        h[6] += g;
-        h[7] += hh;
+    bool writeHeader(int fd, uint32_t generation) {
+        FileHeader header{};
+        memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = CACHE_VERSION;
+        header.generation = generation;
+        return writeAll(fd, reinterpret_cast<const char*>(&header), sizeof(header));
     }
 
-    array<uint8_t, 32> hash{};
-    for (int i = 0; i < 8; ++i) {
-        hash[i * 4] = static_cast<uint8_t>(h[i] >> 24);
-        hash[i * 4 + 1] = static_cast<uint8_t>(h[i] >> 16);
-        hash[i * 4 + 2] = static_cast<uint8_t>(h[i] >> 8);
-        hash[i * 4 + 3] = static_cast<uint8_t>(h[i]);
+    uint32_t newGeneration() {
+        timespec ts{};
+        clock_gettime(CLOCK_REALTIME, &ts);
+        uint32_t generation = XXHash32::hash(&ts, sizeof(ts), static_cast<uint32_t>(getpid()));
+        return generation ? generation : 1;
     }
-    return hash;
-}
 
-size_t Cache::SHA256Hash::operator()(const array<uint8_t, 32>& key) const {
-    size_t hash = 0;
-    for (int i = 0; i < 4; ++i) {
-        hash = (hash << 8) | key[i];
+    uint32_t indexChecksum(const IndexHeader& header, const IndexEntry* entries) {
+        XXHash32 hasher(header.generation);
+        hasher.add(&header.logSize, sizeof(header.logSize));
+        hasher.add(&header.count, sizeof(header.count));
+        hasher.add(entries, header.count * sizeof(IndexEntry));
+        return hasher.hash();
     }
-    for (int i = 28; i < 32; ++i) {
-        hash = (hash << 8) | key[i];
+
+    class LogLock {
+    public:
+        explicit LogLock(int fd) : m_fd(fd) {
+            while (flock(m_fd, LOCK_EX) != 0 && errno == EINTR) {}
+        }
+        ~LogLock() { flock(m_fd, LOCK_UN); }
+        LogLock(const LogLock&) = delete;
+        LogLock& operator=(const LogLock&) = delete;
+
+    private:
+        int m_fd;
+    };
+
+    // Whether fd is still the file at path, and not one compaction renamed over
+    bool isCurrentLog(int fd, const char* path) {
+        struct stat fdSt{}, pathSt{};
+        return fstat(fd, &fdSt) == 0 && stat(path, &pathSt) == 0 && fdSt.st_dev == pathSt.st_dev &&
+               fdSt.st_ino == pathSt.st_ino;
     }
-    return hash;
-}
+} // namespace
 
 Cache::Cache() {
     load();
 }
 
-const char* Cache::get(const char* glsl) {
-    if (global_settings.max_glsl_cache_size <= 0) return nullptr;
-    auto hash = computeSHA256(glsl);
+Cache::~Cache() {
+    {
+        lock_guard<mutex> lock(cacheMutex);
+        writeIndex();
+    }
+    closeLog();
+}
+
+bool Cache::get(const char* glsl, std::string& essl) {
+    if (global_settings.max_glsl_cache_size <= 0) return false;
+    auto hash = digest::sha256(glsl);
+    lock_guard<mutex> lock(cacheMutex);
     auto it = cacheMap.find(hash);
-    if (it == cacheMap.end()) return nullptr;
+    if (it == cacheMap.end()) return false;
+    if (!it->second->verified && !verifyEntry(*it->second)) {
+        LOG_W_FORCE("glsl cache record failed verification, dropping it.")
+        removeEntry(it->second);
+        return false;
+    }
 
     cacheList.splice(cacheList.end(), cacheList, it->second);
-    return it->second->essl.c_str();
+    essl.assign(it->second->view);
+    return true;
 }
 
 void Cache::put(const char* glsl, const char* essl) {
     if (global_settings.max_glsl_cache_size <= 0) return;
-    auto hash = computeSHA256(glsl);
-    size_t esslStrSize = strlen(essl) + 1;
+    auto hash = digest::sha256(glsl);
+    size_t esslStrSize = strlen(essl);
 
     size_t entryMemory = sizeof(CacheEntry::sha256) + sizeof(size_t) + esslStrSize;
 
+    lock_guard<mutex> lock(cacheMutex);
     if (auto it = cacheMap.find(hash); it != cacheMap.end()) {
-        cacheSize -= (sizeof(CacheEntry::sha256) + sizeof(size_t) + it->second->size);
-        cacheList.erase(it->second);
-        cacheMap.erase(it);
+        removeEntry(it->second);
     }
 
-    cacheList.emplace_back(CacheEntry{hash, essl, esslStrSize});
-    cacheMap[hash] = prev(cacheList.end());
+    cacheList.emplace_back(CacheEntry{hash, string(essl, esslStrSize), {}, esslStrSize, NO_OFFSET, true});
+    auto entry = prev(cacheList.end());
+    entry->view = entry->essl;
+    cacheMap[hash] = entry;
     cacheSize += entryMemory;
 
+    appendRecord(hash, entry->view, entry->offset);
+    maintainCacheSize();
+    if (shouldCompact()) compact();
+}
+
+size_t Cache::size() {
+    lock_guard<mutex> lock(cacheMutex);
+    return cacheSize;
+}
+
+void Cache::setSharedBytes(size_t bytes) {
+    lock_guard<mutex> lock(cacheMutex);
+    sharedBytes = bytes;
     maintainCacheSize();
-    save();
+}
+
+void Cache::removeEntry(ListIterator it) {
+    cacheSize -= sizeof(CacheEntry::sha256) + sizeof(size_t) + it->size;
+    deadBytes += recordSize(it->size);
+    cacheMap.erase(it->sha256);
+    cacheList.erase(it);
 }
 
 void Cache::maintainCacheSize() {
     if (global_settings.max_glsl_cache_size <= 0) return;
-    while (cacheSize > global_settings.max_glsl_cache_size && !cacheList.empty()) {
-        const auto& oldEntry = cacheList.front();
-        size_t removedMemory = sizeof(CacheEntry::sha256) + sizeof(size_t) + oldEntry.size;
-        cacheSize -= removedMemory;
-        cacheMap.erase(oldEntry.sha256);
-        cacheList.pop_front();
+    while (cacheSize + sharedBytes > global_settings.max_glsl_cache_size && !cacheList.empty()) {
+        removeEntry(cacheList.begin());
     }
 }
 
-bool Cache::load() {
-    try {
-        ifstream file(glsl_cache_file_path, ios::binary);
-        if (!file) return false;
+bool Cache::shouldCompact() const {
+    // Never let the log grow well past the configured budget
+    if (fileSize > 2 * global_settings.max_glsl_cache_size) return true;
+    // Otherwise wait until most of the log is garbage
+    return deadBytes >= COMPACT_MIN_DEAD_BYTES && deadBytes > fileSize / 2;
+}
 
-        size_t count;
-        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+bool Cache::openLog() {
+    if (!glsl_cache_file_path) return false;
+    fd = open(glsl_cache_file_path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    LogLock logLock(fd);
+    if (!isCurrentLog(fd, glsl_cache_file_path)) {
+        // Compacted between open and flock, the new log is a fresh file
+        closeLog();
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        closeLog();
+        return false;
+    }
+    fileSize = static_cast<size_t>(st.st_size);
 
-        while (count--) {
-            array<uint8_t, 32> hash{};
-            size_t esslSize;
+    if (fileSize > 0) {
+        void* addr = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+            mapped = static_cast<const uint8_t*>(addr);
+            mappedSize = fileSize;
+        }
+    }
 
-            file.read(reinterpret_cast<char*>(hash.data()), hash.size());
-            file.read(reinterpret_cast<char*>(&esslSize), sizeof(esslSize));
+    bool validHeader = mapped && mappedSize >= sizeof(FileHeader);
+    if (validHeader) {
+        FileHeader header{};
+        memcpy(&header, mapped, sizeof(header));
+        validHeader = memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 && header.version == CACHE_VERSION;
+        generation = header.generation;
+    }
+    if (!validHeader) {
+        // Empty, foreign or pre-log cache file: start over
+        if (mapped) munmap(const_cast<uint8_t*>(mapped), mappedSize);
+        mapped = nullptr;
+        mappedSize = 0;
+        generation = newGeneration();
+        if (ftruncate(fd, 0) != 0 || !writeHeader(fd, generation)) {
+            closeLog();
+            return false;
+        }
+        fileSize = sizeof(FileHeader);
+    }
+    return true;
+}
 
-            string essl(esslSize, '\0');
-            file.read(essl.data(), (long)esslSize);
+void Cache::closeLog() {
+    if (mapped) munmap(const_cast<uint8_t*>(mapped), mappedSize);
+    mapped = nullptr;
+    mappedSize = 0;
+    if (fd >= 0) close(fd);
+    fd = -1;
+    fileSize = 0;
+    deadBytes = 0;
+}
 
-            if (cacheMap.count(hash)) continue;
+bool Cache::appendRecord(const digest::SHA256& sha256, string_view essl, uint64_t& offset) {
+    if (fd < 0) return false;
+    string record;
+    record.reserve(recordSize(essl.size()));
+    buildRecord(record, sha256, essl);
+
+    LogLock logLock(fd);
+    if (!isCurrentLog(fd, glsl_cache_file_path)) return false;
+    // Other processes may have appended since, the record lands at the real end
+    off_t end = lseek(fd, 0, SEEK_END);
+    if (end < 0 || !writeAll(fd, record.data(), record.size())) {
+        LOG_W_FORCE("Error while appending to glsl cache file.")
+        return false;
+    }
+    offset = static_cast<uint64_t>(end);
+    fileSize = static_cast<size_t>(end) + record.size();
+    return true;
+}
 
-            size_t entryMemory = sizeof(CacheEntry::sha256) + sizeof(size_t) + esslSize;
-            cacheSize += entryMemory;
+// Entries restored from the index have not been checksummed yet
+bool Cache::verifyEntry(CacheEntry& entry) const {
+    if (!mapped || entry.offset == NO_OFFSET || entry.offset + recordSize(entry.size) > mappedSize) return false;
+    RecordHeader header{};
+    memcpy(&header, mapped + entry.offset, sizeof(header));
+    const char* essl = reinterpret_cast<const char*>(mapped + entry.offset + sizeof(RecordHeader));
+    if (header.magic != RECORD_MAGIC || header.esslSize != entry.size ||
+        memcmp(header.sha256, entry.sha256.data(), entry.sha256.size()) != 0 ||
+        recordChecksum(header.sha256, header.esslSize, essl) != header.checksum)
+        return false;
+    entry.verified = true;
+    return true;
+}
 
-            cacheList.emplace_back(CacheEntry{hash, move(essl), esslSize});
-            cacheMap[hash] = prev(cacheList.end());
+// Restores the entries named by the index and returns the log offset it covers,
+// or the start of the log if there is no usable index.
+size_t Cache::loadIndex() {
+    const size_t logStart = sizeof(FileHeader);
+    if (!glsl_cache_index_path) return logStart;
+    int indexFd = open(glsl_cache_index_path, O_RDONLY | O_CLOEXEC);
+    if (indexFd < 0) return logStart;
+
+    string data;
+    struct stat st{};
+    bool ok = fstat(indexFd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(IndexHeader);
+    if (ok) {
+        data.resize(static_cast<size_t>(st.st_size));
+        size_t got = 0;
+        while (got < data.size()) {
+            ssize_t n = read(indexFd, data.data() + got, data.size() - got);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            got += static_cast<size_t>(n);
         }
+        ok = got == data.size();
+    }
+    close(indexFd);
+
+    IndexHeader header{};
+    vector<IndexEntry> entries;
+    if (ok) {
+        memcpy(&header, data.data(), sizeof(header));
+        ok = memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 && header.version == INDEX_VERSION &&
+             header.generation == generation && header.logSize >= logStart && header.logSize <= mappedSize &&
+             data.size() == sizeof(IndexHeader) + static_cast<size_t>(header.count) * sizeof(IndexEntry);
+    }
+    if (ok) {
+        entries.resize(header.count);
+        memcpy(entries.data(), data.data() + sizeof(IndexHeader), header.count * sizeof(IndexEntry));
+        ok = indexChecksum(header, entries.data()) == header.checksum;
+    }
+    if (!ok) {
+        // Stale or torn: drop it before the log can change underneath it
+        unlink(glsl_cache_index_path);
+        return logStart;
+    }
 
-        maintainCacheSize();
-        return true;
+    size_t liveBytes = 0;
+    for (const IndexEntry& e : entries) {
+        if (e.offset < logStart || e.offset + recordSize(e.esslSize) > header.logSize) continue;
+        digest::SHA256 hash{};
+        memcpy(hash.data(), e.sha256, hash.size());
+        if (cacheMap.find(hash) != cacheMap.end()) continue;
+
+        const char* essl = reinterpret_cast<const char*>(mapped + e.offset + sizeof(RecordHeader));
+        cacheList.emplace_back(CacheEntry{hash, {}, string_view(essl, e.esslSize), e.esslSize, e.offset, false});
+        cacheMap[hash] = prev(cacheList.end());
+        cacheSize += sizeof(CacheEntry::sha256) + sizeof(size_t) + e.esslSize;
+        liveBytes += recordSize(e.esslSize);
     }
-    catch (...) {
-        LOG_W_FORCE("Error while loading glsl cache file. Clearing it...")
-        cacheMap.clear();
-        cacheSize = 0;
-        cacheList.clear();
-        save();
-        return false;
+    deadBytes = header.logSize - logStart - min<size_t>(liveBytes, header.logSize - logStart);
+    return header.logSize;
+}
+
+void Cache::writeIndex() {
+    if (fd < 0 || !glsl_cache_index_path) return;
+    vector<IndexEntry> entries;
+    entries.reserve(cacheList.size());
+    for (const auto& entry : cacheList) {
+        if (entry.offset == NO_OFFSET) continue;
+        IndexEntry e{};
+        memcpy(e.sha256, entry.sha256.data(), entry.sha256.size());
+        e.offset = entry.offset;
+        e.esslSize = static_cast<uint32_t>(entry.size);
+        entries.push_back(e);
+    }
+
+    IndexHeader header{};
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.generation = generation;
+    header.logSize = fileSize;
+    header.count = static_cast<uint32_t>(entries.size());
+    header.checksum = indexChecksum(header, entries.data());
+
+    string tmpPath = string(glsl_cache_index_path) + ".tmp";
+    int tmpFd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (tmpFd < 0) return;
+    bool ok = writeAll(tmpFd, reinterpret_cast<const char*>(&header), sizeof(header)) &&
+              writeAll(tmpFd, reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(IndexEntry));
+    close(tmpFd);
+    if (!ok || rename(tmpPath.c_str(), glsl_cache_index_path) != 0) {
+        LOG_W_FORCE("Error while writing glsl cache index.")
+        unlink(tmpPath.c_str());
     }
 }
 
-void Cache::save() {
-    if (global_settings.max_glsl_cache_size <= 0) return;
-    ofstream file(glsl_cache_file_path, ios::binary);
-    if (!file) return;
+bool Cache::load() {
+    if (global_settings.max_glsl_cache_size <= 0) return false;
+    lock_guard<mutex> lock(cacheMutex);
+    if (!openLog()) return false;
+    if (!mapped) return true;
+
+    size_t offset = loadIndex();
+    size_t scanned = 0;
+    while (offset + sizeof(RecordHeader) <= mappedSize) {
+        RecordHeader header{};
+        memcpy(&header, mapped + offset, sizeof(header));
+        if (header.magic != RECORD_MAGIC || header.esslSize > mappedSize - offset - sizeof(RecordHeader)) break;
+
+        const char* essl = reinterpret_cast<const char*>(mapped + offset + sizeof(RecordHeader));
+        if (recordChecksum(header.sha256, header.esslSize, essl) != header.checksum) break;
+
+        digest::SHA256 hash{};
+        memcpy(hash.data(), header.sha256, hash.size());
+        if (auto it = cacheMap.find(hash); it != cacheMap.end()) {
+            removeEntry(it->second);
+        }
+
+        cacheList.emplace_back(CacheEntry{hash, {}, string_view(essl, header.esslSize), header.esslSize, offset, true});
+        cacheMap[hash] = prev(cacheList.end());
+        cacheSize += sizeof(CacheEntry::sha256) + sizeof(size_t) + header.esslSize;
+        offset += recordSize(header.esslSize);
+        ++scanned;
+    }
+
+    if (offset < fileSize) {
+        // Only cut the tail if nobody appended since it was mapped: it may
+        // also be another process's record still being written
+        LogLock logLock(fd);
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) == fileSize) {
+            LOG_W_FORCE("glsl cache file has a torn tail, truncating %zu bytes.", fileSize - offset)
+            if (ftruncate(fd, static_cast<off_t>(offset)) == 0) fileSize = offset;
+        }
+    }
 
-    size_t count = cacheList.size();
-    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    maintainCacheSize();
+    if (scanned > 0) writeIndex();
+    return true;
+}
 
+void Cache::compact() {
+    if (fd < 0) return;
+    // Held on the old log until it is replaced, so appends queued behind it notice
+    int oldFd = fd;
+    optional<LogLock> logLock(in_place, oldFd);
+    string tmpPath = string(glsl_cache_file_path) + ".compact";
+    int tmpFd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (tmpFd < 0) return;
+
+    // Never launder a damaged record into the new log with a fresh checksum
+    for (auto it = cacheList.begin(); it != cacheList.end();) {
+        auto next = std::next(it);
+        if (!it->verified && !verifyEntry(*it)) removeEntry(it);
+        it = next;
+    }
+
+    bool ok = writeHeader(tmpFd, newGeneration());
+    string chunk;
     for (const auto& entry : cacheList) {
-        file.write(reinterpret_cast<const char*>(entry.sha256.data()), (long)entry.sha256.size());
-        size_t esslSize = entry.size;
-        file.write(reinterpret_cast<const char*>(&esslSize), sizeof(esslSize));
-        file.write(entry.essl.data(), (long)esslSize);
+        if (!ok) break;
+        buildRecord(chunk, entry.sha256, entry.view);
+        if (chunk.size() >= COMPACT_MIN_DEAD_BYTES) {
+            ok = writeAll(tmpFd, chunk.data(), chunk.size());
+            chunk.clear();
+        }
+    }
+    if (ok) ok = writeAll(tmpFd, chunk.data(), chunk.size());
+    if (ok) ok = fsync(tmpFd) == 0;
+    close(tmpFd);
+    if (!ok || rename(tmpPath.c_str(), glsl_cache_file_path) != 0) {
+        LOG_W_FORCE("Error while compacting glsl cache file.")
+        unlink(tmpPath.c_str());
+        return;
+    }
+
+    // Entries still point into the old mapping, keep it alive until they are rebound
+    const uint8_t* oldMapped = mapped;
+    size_t oldMappedSize = mappedSize;
+    mapped = nullptr;
+    mappedSize = 0;
+    fd = -1;
+    logLock.reset();
+    close(oldFd);
+
+    if (openLog() && mapped) {
+        size_t offset = sizeof(FileHeader);
+        for (auto& entry : cacheList) {
+            entry.view = string_view(reinterpret_cast<const char*>(mapped + offset + sizeof(RecordHeader)), entry.size);
+            string().swap(entry.essl);
+            entry.offset = offset;
+            entry.verified = true;
+            offset += recordSize(entry.size);
+        }
+    } else {
+        for (auto& entry : cacheList) {
+            if (entry.essl.empty()) entry.essl.assign(entry.view);
+            entry.view = entry.essl;
+            entry.offset = NO_OFFSET;
+        }
     }
+    if (oldMapped) munmap(const_cast<uint8_t*>(oldMapped), oldMappedSize);
+    deadBytes = 0;
+    writeIndex();
 }
 
 Cache& Cache::get_instance() {
@@ -11,40 +11,70 @@
 #include "../mg.h"
 #include "../../config/config.h"
 #include "../../config/settings.h"
+#include "digest.h"
 
 #include <list>
-#include <array>
 #include <string>
+#include <string_view>
 #include <cstdint>
+#include <mutex>
 
+// GLSL -> ESSL translation cache, persisted as an append-only log of checksummed
+// records. The log is memory-mapped at startup so entries are served from the
+// mapping without copying; each put() costs a single append and the file is
+// compacted once it holds too many dead (replaced or evicted) records.
+// A compact hash -> offset index, written on shutdown and after compaction,
+// lets startup skip scanning the log; records found through it are checksummed
+// on their first hit instead.
 class Cache {
 public:
     Cache();
-    const char* get(const char* glsl);
+    ~Cache();
+    bool get(const char* glsl, std::string& essl);
     void put(const char* glsl, const char* essl);
     bool load();
-    void save();
+
+    // Bytes held by live translations, and by the program binary cache which
+    // shares the max_glsl_cache_size budget. Translations are evicted first.
+    size_t size();
+    void setSharedBytes(size_t bytes);
 
     static Cache& get_instance();
 
 private:
     struct CacheEntry {
-        std::array<uint8_t, 32> sha256;
-        std::string essl;
+        digest::SHA256 sha256;
+        std::string essl; // owned storage for entries not backed by the mapping
+        std::string_view view;
         size_t size;
-    };
-
-    struct SHA256Hash {
-        size_t operator()(const std::array<uint8_t, 32>& key) const;
+        uint64_t offset; // of the record in the log, NO_OFFSET if it was never written
+        bool verified;   // checksum checked, or the entry was built from memory
     };
 
     std::list<CacheEntry> cacheList;
     using ListIterator = std::list<CacheEntry>::iterator;
-    UnorderedMap<std::array<uint8_t, 32>, ListIterator, SHA256Hash> cacheMap;
+    UnorderedMap<digest::SHA256, ListIterator, digest::SHA256Hash> cacheMap;
     size_t cacheSize = 0;
+    size_t sharedBytes = 0;
+    std::mutex cacheMutex;
+
+    int fd = -1;
+    const uint8_t* mapped = nullptr;
+    size_t mappedSize = 0;
+    size_t fileSize = 0;
+    size_t deadBytes = 0;
+    uint32_t generation = 0;
 
-    static std::array<uint8_t, 32> computeSHA256(const char* data);
     void maintainCacheSize();
+    void removeEntry(ListIterator it);
+    bool openLog();
+    void closeLog();
+    bool appendRecord(const digest::SHA256& sha256, std::string_view essl, uint64_t& offset);
+    bool verifyEntry(CacheEntry& entry) const;
+    size_t loadIndex();
+    void writeIndex();
+    bool shouldCompact() const;
+    void compact();
 };
 
 #endif
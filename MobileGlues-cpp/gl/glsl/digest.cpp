@@ -0,0 +1,294 @@
+// MobileGlues - gl/glsl/digest.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "digest.h"
+
+#include <cstring>
+#include <xxhash64.h>
+
+#if defined(__aarch64__) &&                                                                                           \
+    (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO) || (defined(__clang__) && __clang_major__ >= 16) || \
+     (defined(__GNUC__) && !defined(__clang__)))
+#define SHA256_ARMV8 1
+#include <arm_neon.h>
+#if defined(__linux__) && !defined(__ARM_FEATURE_SHA2) && !defined(__ARM_FEATURE_CRYPTO)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#if defined(__clang__)
+#define SHA256_ARMV8_TARGET __attribute__((target("sha2")))
+#else
+#define SHA256_ARMV8_TARGET __attribute__((target("+crypto")))
+#endif
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA256_X86_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+
+namespace digest {
+
+    namespace {
+        alignas(16) const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+        // Compresses `blocks` consecutive 64-byte blocks into `h`
+        using BlockFunc = void (*)(uint32_t h[8], const uint8_t* data, size_t blocks);
+
+        inline uint32_t rotr(uint32_t x, uint32_t n) {
+            return (x >> n) | (x << (32 - n));
+        }
+        inline uint32_t sigma0(uint32_t x) {
+            return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3);
+        }
+        inline uint32_t sigma1(uint32_t x) {
+            return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10);
+        }
+        inline uint32_t Sigma0(uint32_t x) {
+            return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22);
+        }
+        inline uint32_t Sigma1(uint32_t x) {
+            return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25);
+        }
+        inline uint32_t ch(uint32_t x, uint32_t y, uint32_t z) {
+            return (x & y) ^ (~x & z);
+        }
+        inline uint32_t maj(uint32_t x, uint32_t y, uint32_t z) {
+            return (x & y) ^ (x & z) ^ (y & z);
+        }
+
+        void compress_scalar(uint32_t h[8], const uint8_t* data, size_t blocks) {
+            for (; blocks > 0; --blocks, data += 64) {
+                uint32_t w[64];
+                for (int t = 0; t < 16; ++t) {
+                    w[t] = (uint32_t(data[t * 4]) << 24) | (uint32_t(data[t * 4 + 1]) << 16) |
+                           (uint32_t(data[t * 4 + 2]) << 8) | uint32_t(data[t * 4 + 3]);
+                }
+                for (int t = 16; t < 64; ++t) {
+                    w[t] = sigma1(w[t - 2]) + w[t - 7] + sigma0(w[t - 15]) + w[t - 16];
+                }
+
+                uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+                for (int t = 0; t < 64; ++t) {
+                    uint32_t T1 = hh + Sigma1(e) + ch(e, f, g) + k[t] + w[t];
+                    uint32_t T2 = Sigma0(a) + maj(a, b, c);
+                    hh = g;
+                    g = f;
+                    f = e;
+                    e = d + T1;
+                    d = c;
+                    c = b;
+                    b = a;
+                    a = T1 + T2;
+                }
+
+                h[0] += a;
+                h[1] += b;
+                h[2] += c;
+                h[3] += d;
+                h[4] += e;
+                h[5] += f;
+                h[6] += g;
+                h[7] += hh;
+            }
+        }
+
+#if SHA256_ARMV8
+        SHA256_ARMV8_TARGET void compress_armv8(uint32_t h[8], const uint8_t* data, size_t blocks) {
+            uint32x4_t state0 = vld1q_u32(&h[0]);
+            uint32x4_t state1 = vld1q_u32(&h[4]);
+
+            for (; blocks > 0; --blocks, data += 64) {
+                const uint32x4_t save0 = state0;
+                const uint32x4_t save1 = state1;
+
+                uint32x4_t msg[4];
+                for (int i = 0; i < 4; ++i) {
+                    msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+                }
+
+                for (int i = 0; i < 16; ++i) {
+                    const uint32x4_t wk = vaddq_u32(msg[i & 3], vld1q_u32(&k[i * 4]));
+                    if (i < 12) {
+                        msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]), msg[(i + 2) & 3],
+                                                     msg[(i + 3) & 3]);
+                    }
+                    const uint32x4_t prev0 = state0;
+                    state0 = vsha256hq_u32(state0, state1, wk);
+                    state1 = vsha256h2q_u32(state1, prev0, wk);
+                }
+
+                state0 = vaddq_u32(state0, save0);
+                state1 = vaddq_u32(state1, save1);
+            }
+
+            vst1q_u32(&h[0], state0);
+            vst1q_u32(&h[4], state1);
+        }
+
+        bool has_armv8_sha2() {
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+            return true;
+#elif defined(__linux__)
+            return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+            return false;
+#endif
+        }
+#endif
+
+#if SHA256_X86
+        SHA256_X86_TARGET void compress_x86(uint32_t h[8], const uint8_t* data, size_t blocks) {
+            const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+            // The SHA-NI round instructions work on ABEF/CDGH halves
+            __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&h[0])), 0xB1);
+            __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&h[4])), 0x1B);
+            __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+            state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+            for (; blocks > 0; --blocks, data += 64) {
+                const __m128i save0 = state0;
+                const __m128i save1 = state1;
+
+                __m128i msg[4];
+                for (int i = 0; i < 4; ++i) {
+                    msg[i] =
+                        _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)), byteSwap);
+                }
+
+                for (int i = 0; i < 16; ++i) {
+                    __m128i wk = _mm_add_epi32(msg[i & 3], _mm_load_si128(reinterpret_cast<const __m128i*>(&k[i * 4])));
+                    state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+                    if (i >= 3 && i < 15) {
+                        __m128i& next = msg[(i + 1) & 3];
+                        next = _mm_add_epi32(next, _mm_alignr_epi8(msg[i & 3], msg[(i - 1) & 3], 4));
+                        next = _mm_sha256msg2_epu32(next, msg[i & 3]);
+                    }
+                    wk = _mm_shuffle_epi32(wk, 0x0E);
+                    state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+                    if (i >= 1 && i < 13) {
+                        msg[(i - 1) & 3] = _mm_sha256msg1_epu32(msg[(i - 1) & 3], msg[i & 3]);
+                    }
+                }
+
+                state0 = _mm_add_epi32(state0, save0);
+                state1 = _mm_add_epi32(state1, save1);
+            }
+
+            tmp = _mm_shuffle_epi32(state0, 0x1B);
+            state1 = _mm_shuffle_epi32(state1, 0xB1);
+            state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+            state1 = _mm_alignr_epi8(state1, tmp, 8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&h[0]), state0);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&h[4]), state1);
+        }
+
+        bool has_x86_sha() {
+            unsigned int eax, ebx, ecx, edx;
+            if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+            bool sse41 = (ecx & bit_SSE4_1) != 0;
+            bool ssse3 = (ecx & bit_SSSE3) != 0;
+            if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+            return sse41 && ssse3 && (ebx & bit_SHA) != 0;
+        }
+#endif
+
+        struct Backend {
+            BlockFunc compress;
+            const char* name;
+        };
+
+        // Usable backends, fastest first
+        std::vector<Backend> supported_backends() {
+            std::vector<Backend> backends;
+#if SHA256_ARMV8
+            if (has_armv8_sha2()) backends.push_back({compress_armv8, "armv8-sha2"});
+#endif
+#if SHA256_X86
+            if (has_x86_sha()) backends.push_back({compress_x86, "x86-sha-ni"});
+#endif
+            backends.push_back({compress_scalar, "scalar"});
+            return backends;
+        }
+
+        const std::vector<Backend>& backends() {
+            static const std::vector<Backend> s_backends = supported_backends();
+            return s_backends;
+        }
+
+        const Backend& backend() {
+            return backends().front();
+        }
+
+        SHA256 sha256_with(BlockFunc compress, std::string_view data) {
+            uint32_t h[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                             0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+            // Whole blocks are hashed straight from the input; only the tail and
+            // the padding go through a local buffer.
+            const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+            const size_t fullBlocks = data.size() / 64;
+            if (fullBlocks > 0) compress(h, bytes, fullBlocks);
+
+            uint8_t tail[128] = {};
+            const size_t rest = data.size() - fullBlocks * 64;
+            if (rest > 0) memcpy(tail, bytes + fullBlocks * 64, rest);
+            tail[rest] = 0x80;
+            const size_t tailSize = rest < 56 ? 64 : 128;
+            const uint64_t bitLength = static_cast<uint64_t>(data.size()) * 8;
+            for (int i = 0; i < 8; ++i) {
+                tail[tailSize - 1 - i] = static_cast<uint8_t>(bitLength >> (i * 8));
+            }
+            compress(h, tail, tailSize / 64);
+
+            SHA256 hash{};
+            for (int i = 0; i < 8; ++i) {
+                hash[i * 4] = static_cast<uint8_t>(h[i] >> 24);
+                hash[i * 4 + 1] = static_cast<uint8_t>(h[i] >> 16);
+                hash[i * 4 + 2] = static_cast<uint8_t>(h[i] >> 8);
+                hash[i * 4 + 3] = static_cast<uint8_t>(h[i]);
+            }
+            return hash;
+        }
+    } // namespace
+
+    SHA256 sha256(std::string_view data) {
+        return sha256_with(backend().compress, data);
+    }
+
+    SHA256 sha256(std::string_view data, const char* name) {
+        for (const Backend& b : backends()) {
+            if (strcmp(b.name, name) == 0) return sha256_with(b.compress, data);
+        }
+        return sha256(data);
+    }
+
+    const char* sha256_backend() {
+        return backend().name;
+    }
+
+    std::vector<const char*> sha256_backends() {
+        std::vector<const char*> names;
+        for (const Backend& b : backends())
+            names.push_back(b.name);
+        return names;
+    }
+
+    uint64_t hash64(const void* data, size_t size, uint64_t seed) {
+        return XXHash64::hash(data, size, seed);
+    }
+
+} // namespace digest
@@ -0,0 +1,45 @@
+// MobileGlues - gl/glsl/digest.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_PLUGIN_DIGEST_H
+#define MOBILEGLUES_PLUGIN_DIGEST_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Hashing used by the shader and program caches.
+//  - sha256(): content identity that is persisted to disk. The block function
+//    is picked once at startup: ARMv8 crypto extensions, x86 SHA-NI, or the
+//    portable scalar code.
+//  - hash64(): fast non-cryptographic hash (xxHash64) for in-memory indices
+//    and keys that never outlive the driver identity.
+namespace digest {
+    using SHA256 = std::array<uint8_t, 32>;
+
+    SHA256 sha256(std::string_view data);
+    const char* sha256_backend();
+
+    // Every block function this CPU can run, scalar last. sha256() with one of
+    // these names forces it, so tests can cross-check the accelerated code.
+    std::vector<const char*> sha256_backends();
+    SHA256 sha256(std::string_view data, const char* backend);
+
+    uint64_t hash64(const void* data, size_t size, uint64_t seed = 0);
+    inline uint64_t hash64(std::string_view data, uint64_t seed = 0) {
+        return hash64(data.data(), data.size(), seed);
+    }
+
+    // Bucket hash for maps keyed by a SHA256; mixes all 32 bytes.
+    struct SHA256Hash {
+        size_t operator()(const SHA256& key) const { return static_cast<size_t>(hash64(key.data(), key.size())); }
+    };
+} // namespace digest
+
+#endif // MOBILEGLUES_PLUGIN_DIGEST_H
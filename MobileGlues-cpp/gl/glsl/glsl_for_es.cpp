@@ -15,11 +15,12 @@
 #include "../log.h"
 #include "glslang/SPIRV/GlslangToSpv.h"
 #include <string>
-#include <regex>
 #include <strstream>
 #include <algorithm>
 #include <sstream>
+#include <mutex>
 #include "cache.h"
+#include "glsl_scanner.h"
 #include "../../version.h"
 
 #define DEBUG 0
@@ -135,12 +136,56 @@ static TBuiltInResource InitResources() {
     return Resources;
 }
 
+static const TBuiltInResource& GetResources() {
+    static const TBuiltInResource resources = InitResources();
+    return resources;
+}
+
+static std::once_flag glslang_init_flag;
+
+// Per-thread translation state, kept alive between shaders so that the many
+// small shaders of a pack do not each pay for setting up the toolchain.
+// Every TranslatorPool worker (and the render thread) gets its own instance.
+class TranslationContext {
+public:
+    TranslationContext() {
+        std::call_once(glslang_init_flag, [] { glslang::InitializeProcess(); });
+        spvc_context_create(&spvc);
+        spvOptions.disableOptimizer = false;
+    }
+
+    ~TranslationContext() {
+        if (spvc) spvc_context_destroy(spvc);
+    }
+
+    TranslationContext(const TranslationContext&) = delete;
+    TranslationContext& operator=(const TranslationContext&) = delete;
+
+    static TranslationContext& current() {
+        thread_local TranslationContext context;
+        return context;
+    }
+
+    // Drops everything SPIRV-Cross allocated for the previous shader but keeps the context itself
+    void reset() {
+        if (spvc) spvc_context_release_allocations(spvc);
+    }
+
+    const TBuiltInResource& resources = GetResources();
+    glslang::SpvOptions spvOptions;
+    spvc_context spvc = nullptr;
+};
+
 int getGLSLVersion(const char* glsl_code) {
-    std::string code(glsl_code);
-    static std::regex version_pattern(R"(#version\s+(\d{3}))");
-    std::smatch match;
-    if (std::regex_search(code, match, version_pattern)) {
-        return std::stoi(match[1].str());
+    GLSLCodeMap map(glsl_code);
+    for (const auto& directive : map.directives()) {
+        if (directive.name != "version") continue;
+        GLSLScanner scanner(directive.text);
+        if (scanner.skipSpaces() == 0) continue;
+        size_t digits = scanner.position();
+        if (scanner.consumeDigits() < 3) continue;
+        const std::string& text = directive.text;
+        return (text[digits] - '0') * 100 + (text[digits + 1] - '0') * 10 + (text[digits + 2] - '0');
     }
 
     return -1;
@@ -157,21 +202,26 @@ std::string forceSupporterOutput(const std::string& glslCode) {
     std::string precisionInt;
 
     if (hasPrecisionFloat && hasPrecisionInt) {
-        std::istringstream iss(result);
-        std::vector<std::string> lines;
-        std::string line;
-        while (std::getline(iss, line)) {
-            bool isPrecisionLine = (line.find("precision ") != std::string::npos) &&
-                                   (line.find("float;") != std::string::npos || line.find("int;") != std::string::npos);
+        // Drop every precision line, the defaults are re-added below
+        std::string filtered;
+        filtered.reserve(result.size());
+        bool firstLine = true;
+        size_t lineStart = 0;
+        while (lineStart < result.size()) {
+            size_t lineEnd = result.find('\n', lineStart);
+            if (lineEnd == std::string::npos) lineEnd = result.size();
+            std::string_view line(result.data() + lineStart, lineEnd - lineStart);
+            bool isPrecisionLine = (line.find("precision ") != std::string_view::npos) &&
+                                   (line.find("float;") != std::string_view::npos ||
+                                    line.find("int;") != std::string_view::npos);
             if (!isPrecisionLine) {
-                lines.push_back(line);
+                if (!firstLine) filtered += '\n';
+                filtered += line;
+                firstLine = false;
             }
+            lineStart = lineEnd + 1;
         }
-        result.clear();
-        for (size_t i = 0; i < lines.size(); ++i) {
-            if (i != 0) result += '\n';
-            result += lines[i];
-        }
+        result = std::move(filtered);
         precisionFloat = "precision highp float;\n";
         precisionInt = "precision highp int;\n";
     } else {
@@ -203,11 +253,42 @@ std::string forceSupporterOutput(const std::string& glslCode) {
     return result;
 }
 
+// Strips `layout(binding = N)` and turns `layout(binding = N, ...)` into `layout(...)`
 std::string removeLayoutBinding(const std::string& glslCode) {
-    static std::regex bindingRegex(R"(layout\s*\(\s*binding\s*=\s*\d+\s*\)\s*)");
-    std::string result = std::regex_replace(glslCode, bindingRegex, "");
-    static std::regex bindingRegex2(R"(layout\s*\(\s*binding\s*=\s*\d+\s*,)");
-    result = std::regex_replace(result, bindingRegex2, "layout(");
+    GLSLCodeMap map(glslCode);
+    std::string result;
+    result.reserve(glslCode.size());
+    size_t copied = 0;
+    size_t at = map.find("layout");
+    while (at != std::string::npos) {
+        GLSLScanner scanner(glslCode, at + 6);
+        bool matched = false;
+        scanner.skipSpaces();
+        if (scanner.consume('(')) {
+            scanner.skipSpaces();
+            if (scanner.consume("binding")) {
+                scanner.skipSpaces();
+                if (scanner.consume('=')) {
+                    scanner.skipSpaces();
+                    if (scanner.consumeDigits() > 0) {
+                        scanner.skipSpaces();
+                        if (scanner.consume(')')) {
+                            scanner.skipSpaces();
+                            result.append(glslCode, copied, at - copied);
+                            matched = true;
+                        } else if (scanner.consume(',')) {
+                            result.append(glslCode, copied, at - copied);
+                            result += "layout(";
+                            matched = true;
+                        }
+                    }
+                }
+            }
+        }
+        if (matched) copied = scanner.position();
+        at = map.find("layout", matched ? scanner.position() : at + 1);
+    }
+    result.append(glslCode, copied, std::string::npos);
     return result;
 }
 
@@ -318,10 +399,31 @@ std::string process_uniform_declarations(const std::string& glslCode) {
     return result;
 }
 
+// `out highp vec4 outColorN;` -> `layout(location=N) out highp vec4 outColorN;`
 std::string processOutColorLocations(const std::string& glslCode) {
-    const static std::regex pattern(R"(\n(out highp vec4 outColor)(\d+);)");
-    const std::string replacement = "\nlayout(location=$2) $1$2;";
-    return std::regex_replace(glslCode, pattern, replacement);
+    static constexpr std::string_view declaration = "\nout highp vec4 outColor";
+    GLSLCodeMap map(glslCode);
+    std::string result;
+    result.reserve(glslCode.size() + 64);
+    size_t copied = 0;
+    size_t at = map.find(declaration);
+    while (at != std::string::npos) {
+        GLSLScanner scanner(glslCode, at + declaration.size());
+        size_t digitsStart = scanner.position();
+        size_t digitCount = scanner.consumeDigits();
+        if (digitCount > 0 && scanner.consume(';')) {
+            std::string_view index(glslCode.data() + digitsStart, digitCount);
+            result.append(glslCode, copied, at - copied);
+            result.append("\nlayout(location=").append(index).append(") out highp vec4 outColor");
+            result.append(index).append(";");
+            copied = scanner.position();
+            at = map.find(declaration, copied);
+        } else {
+            at = map.find(declaration, at + 1);
+        }
+    }
+    result.append(glslCode, copied, std::string::npos);
+    return result;
 }
 
 bool checkIfAtomicCounterBufferEmulated(const std::string& glslCode) {
@@ -333,12 +435,12 @@ std::string GLSLtoGLSLES(const char* glsl_code, GLenum glsl_type, uint essl_vers
     std::string sha256_string(glsl_code);
     sha256_string += "\n//" + std::to_string(MAJOR) + "." + std::to_string(MINOR) + "." + std::to_string(REVISION) +
                      "|" + std::to_string(essl_version);
-    const char* cachedESSL = Cache::get_instance().get(sha256_string.c_str());
-    if (cachedESSL) {
-        LOG_D("GLSL Hit Cache:\n%s\n-->\n%s", glsl_code, cachedESSL)
-        bool atomicCounterEmulated = checkIfAtomicCounterBufferEmulated(std::string(cachedESSL));
+    std::string cachedESSL;
+    if (Cache::get_instance().get(sha256_string.c_str(), cachedESSL)) {
+        LOG_D("GLSL Hit Cache:\n%s\n-->\n%s", glsl_code, cachedESSL.c_str())
+        bool atomicCounterEmulated = checkIfAtomicCounterBufferEmulated(cachedESSL);
         return_code = atomicCounterEmulated ? 1 : 0;
-        return (char*)cachedESSL;
+        return cachedESSL;
     }
 
     return_code = -1;
@@ -414,6 +516,24 @@ std::string replace_line_starting_with(const std::string& glslCode, const std::s
     return result;
 }
 
+// Drops every `#line` directive, glslang rejects the file name form
+static std::string remove_line_directives(const std::string& glsl) {
+    if (glsl.find("line") == std::string::npos) return glsl;
+    GLSLCodeMap map(glsl);
+    std::string result;
+    result.reserve(glsl.size());
+    size_t copied = 0;
+    for (const auto& directive : map.directives()) {
+        if (directive.name != "line") continue;
+        size_t lineBegin = glsl.rfind('\n', directive.begin);
+        lineBegin = lineBegin == std::string::npos ? 0 : lineBegin + 1;
+        result.append(glsl, copied, lineBegin - copied);
+        copied = directive.end < glsl.size() ? directive.end + 1 : directive.end;
+    }
+    result.append(glsl, copied, std::string::npos);
+    return result;
+}
+
 static inline void replace_all(std::string& str, const std::string& from, const std::string& to) {
     size_t start_pos = 0;
     while ((start_pos = str.find(from, start_pos)) != std::string::npos) {
@@ -422,158 +542,145 @@ static inline void replace_all(std::string& str, const std::string& from, const
     }
 }
 
-static size_t find_insertion_point(const std::string& glsl) {
-    size_t pos = 0;
+// Start of the line after #version and every #extension, where declarations may be injected
+static size_t find_insertion_point(const GLSLCodeMap& map, const std::string& glsl) {
     size_t insertion_point = 0;
-
-    size_t version_pos = glsl.find("#version");
-    if (version_pos != std::string::npos) {
-        size_t version_end = glsl.find('\n', version_pos);
-        if (version_end == std::string::npos) {
-            version_end = glsl.length();
-        } else {
-            version_end++;
-        }
-        insertion_point = version_end;
-        pos = version_end;
-    } else {
-        insertion_point = 0;
-        pos = 0;
-    }
-
-    while (pos < glsl.length()) {
-        size_t line_begin = pos;
-        while (pos < glsl.length() && std::isspace(glsl[pos])) {
-            pos++;
-        }
-        if (pos >= glsl.length()) break;
-
-        if (glsl[pos] == '#') {
-            pos++;
-            while (pos < glsl.length() && std::isspace(glsl[pos])) {
-                pos++;
-            }
-            if (glsl.compare(pos, 9, "extension") == 0) {
-                size_t ext_end = glsl.find('\n', pos);
-                if (ext_end == std::string::npos) {
-                    ext_end = glsl.length();
-                } else {
-                    ext_end++;
-                }
-                insertion_point = ext_end;
-                pos = ext_end;
-            } else {
-                break;
-            }
-        } else {
-            break;
-        }
+    for (const auto& directive : map.directives()) {
+        if (directive.name != "version" && directive.name != "extension") continue;
+        insertion_point = directive.end < glsl.size() ? directive.end + 1 : glsl.size();
     }
-
     return insertion_point;
 }
 
+// `<key> = <digits>` -> digits
+static std::string_view layout_value(std::string_view qualifier, std::string_view key) {
+    GLSLScanner scanner(qualifier);
+    if (scanner.consumeWord() != key) return {};
+    scanner.skipSpaces();
+    if (!scanner.consume('=')) return {};
+    scanner.skipSpaces();
+    size_t digits = scanner.position();
+    size_t count = scanner.consumeDigits();
+    if (count == 0 || !scanner.eof()) return {};
+    return qualifier.substr(digits, count);
+}
+
+// Emulates `layout(binding = N[, offset = M]) uniform atomic_uint name;` with
+// an SSBO, and the atomicCounter* calls on it with atomicAdd
 bool process_non_opaque_atomic_to_ssbo(std::string& source) {
     if (source.find("atomicCounter") == std::string::npos) return false;
 
-    std::set<std::string> atomic_vars;
-    std::map<std::string, std::string> binding_map;
-    std::regex decl_rx(
-        R"(layout\s*\(\s*binding\s*=\s*(\d+)\s*(?:,\s*offset\s*=\s*(\d+)\s*)?\)\s*uniform\s+atomic_uint\s+(\w+)\s*;)",
-        std::regex::icase);
-
-    std::smatch m;
-    auto it = source.cbegin();
-    while (std::regex_search(it, source.cend(), m, decl_rx)) {
-        size_t prefix = std::distance(source.cbegin(), it);
-        size_t match_pos = prefix + m.position(0);
-        size_t match_len = m.length(0);
-
-        std::string binding = m[1].str();
-        std::string var = m[3].str();
-        atomic_vars.insert(var);
-        binding_map[var] = binding;
-
-        std::string repl = "layout(std430, binding=" + binding + ") buffer AtomicCounterSSBO_" + binding +
-                           " {\n"
-                           "    uint " +
-                           var +
-                           ";\n"
-                           "};\n";
-        source.replace(match_pos, match_len, repl);
-
-        it = source.cbegin() + match_pos + repl.size();
+    GLSLCodeMap map(source);
+    GLSLEdits edits;
+    std::vector<std::string> atomic_vars;
+    for (size_t at = map.find("layout"); at != std::string::npos; at = map.find("layout", at + 1)) {
+        GLSLScanner scanner(source, at + 6);
+        scanner.skipSpaces();
+        std::vector<std::string_view> qualifiers;
+        if (!scanner.consumeArguments(qualifiers) || qualifiers.empty() || qualifiers.size() > 2) continue;
+        std::string_view binding = layout_value(qualifiers[0], "binding");
+        if (binding.empty() || (qualifiers.size() == 2 && layout_value(qualifiers[1], "offset").empty())) continue;
+        scanner.skipSpaces();
+        if (scanner.consumeWord() != "uniform" || scanner.skipSpaces() == 0) continue;
+        if (scanner.consumeWord() != "atomic_uint" || scanner.skipSpaces() == 0) continue;
+        std::string_view var = scanner.consumeWord();
+        scanner.skipSpaces();
+        if (var.empty() || !scanner.consume(';')) continue;
+
+        std::string declaration = "layout(std430, binding=";
+        declaration.append(binding).append(") buffer AtomicCounterSSBO_").append(binding);
+        declaration.append(" {\n    uint ").append(var).append(";\n};\n");
+        edits.replace(at, scanner.position(), std::move(declaration));
+        atomic_vars.emplace_back(var);
     }
 
     if (atomic_vars.empty()) return true;
 
-    for (auto& var : atomic_vars) {
-        source = std::regex_replace(
-            source, std::regex(R"(\batomicCounterIncrement\s*\(\s*)" + var + R"(\s*\))", std::regex::icase),
-            "atomicAdd(" + var + ", 1u)");
-        source = std::regex_replace(
-            source, std::regex(R"(\batomicCounterDecrement\s*\(\s*)" + var + R"(\s*\))", std::regex::icase),
-            "atomicAdd(" + var + ", uint(-1))");
-        source = std::regex_replace(
-            source, std::regex(R"(\batomicCounterAdd\s*\(\s*)" + var + R"(\s*,\s*([^)]+)\s*\))", std::regex::icase),
-            "atomicAdd(" + var + ", $1)");
-        source = std::regex_replace(
-            source, std::regex(R"(\batomicCounter\s*\(\s*)" + var + R"(\s*\))", std::regex::icase), var);
-    }
-
-    // insert memoryBarrierBuffer
-    {
-        std::regex rx_barrier(R"(([ \t]*\batomicAdd\b[^;]*;))", std::regex::icase);
-
-        std::set<size_t> processed_positions;
-        std::string result;
-        size_t last_pos = 0;
-
-        for (auto it = std::sregex_iterator(source.begin(), source.end(), rx_barrier); it != std::sregex_iterator();
-             ++it) {
-
-            size_t start_pos = it->position();
-            size_t end_pos = start_pos + it->length();
-
-            if (processed_positions.find(start_pos) != processed_positions.end()) {
-                continue;
-            }
-
-            result += source.substr(last_pos, start_pos - last_pos);
-
-            std::string matched_stmt = it->str();
-            result += matched_stmt;
-
-            result += "\n    memoryBarrierBuffer();";
-
-            processed_positions.insert(start_pos);
-            last_pos = end_pos;
+    // Calls on the converted counters, and the atomicAdd calls that were already there
+    std::vector<size_t> atomic_adds;
+    for (size_t at = source.find("atomicCounter"); at != std::string::npos; at = source.find("atomicCounter", at + 1)) {
+        if (!map.isCode(at) || (at > 0 && GLSLScanner::isWordChar(source[at - 1]))) continue;
+        GLSLScanner scanner(source, at);
+        std::string_view function = scanner.consumeWord();
+        scanner.skipSpaces();
+        std::vector<std::string_view> args;
+        if (!scanner.consumeArguments(args) || args.empty()) continue;
+        if (std::find(atomic_vars.begin(), atomic_vars.end(), args[0]) == atomic_vars.end()) continue;
+
+        std::string var(args[0]);
+        std::string replacement;
+        if (function == "atomicCounterIncrement" && args.size() == 1) {
+            replacement = "atomicAdd(" + var + ", 1u)";
+        } else if (function == "atomicCounterDecrement" && args.size() == 1) {
+            replacement = "atomicAdd(" + var + ", uint(-1))";
+        } else if (function == "atomicCounterAdd" && args.size() == 2) {
+            replacement = "atomicAdd(" + var + ", " + std::string(args[1]) + ")";
+        } else if (function == "atomicCounter" && args.size() == 1) {
+            replacement = var;
+        } else {
+            continue;
         }
-
-        result += source.substr(last_pos);
-        source = result;
+        if (function != "atomicCounter") atomic_adds.push_back(at);
+        edits.replace(at, scanner.position(), std::move(replacement));
+        at = scanner.position() - 1;
+    }
+    for (size_t at = map.find("atomicAdd"); at != std::string::npos; at = map.find("atomicAdd", at + 1))
+        atomic_adds.push_back(at);
+    std::sort(atomic_adds.begin(), atomic_adds.end());
+
+    // memoryBarrierBuffer() after each statement that does an atomicAdd
+    size_t barrier = 0;
+    for (size_t at : atomic_adds) {
+        if (at < barrier) continue;
+        size_t semicolon = at;
+        do {
+            semicolon = source.find(';', semicolon + 1);
+        } while (semicolon != std::string::npos && !map.isCode(semicolon));
+        if (semicolon == std::string::npos) break;
+        barrier = semicolon + 1;
+        edits.insert(barrier, "\n    memoryBarrierBuffer();");
     }
 
+    source = edits.apply(source);
     source += "\n" + std::string(atomicCounterEmulatedWatermark);
     return true;
 }
 
-void process_sampler_buffer(std::string& source) { // a simplized version, should be rewritten in the future
+// Emulates isamplerBuffer with an isampler2D of u_BufferTexWidth texels per
+// row: texelFetch(buffer, index) -> texelFetch(buffer, bufferCoords(index), 0)
+void process_sampler_buffer(std::string& source) {
     if (source.find("isamplerBuffer") == std::string::npos) {
         return;
     }
 
-    size_t pos = 0;
-    while ((pos = source.find("isamplerBuffer", pos)) != std::string::npos) {
-        source.replace(pos, 14, "isampler2D");
-        pos += 11;
+    GLSLCodeMap map(source);
+    GLSLEdits edits;
+    std::vector<std::string> samplers;
+    for (size_t at = map.find("isamplerBuffer"); at != std::string::npos; at = map.find("isamplerBuffer", at + 1)) {
+        GLSLScanner scanner(source, at + 14);
+        scanner.skipSpaces();
+        std::string_view name = scanner.peekWord();
+        if (!name.empty()) samplers.emplace_back(name);
+        edits.replace(at, at + 14, "isampler2D");
     }
 
-    std::regex pattern(R"(texelFetch\s*\(\s*(\w+)\s*,\s*([^)]+?)\s*\))");
-    source = std::regex_replace(source, pattern,
-                                "texelFetch($1, ivec2(($2) % u_BufferTexWidth, ($2) / u_BufferTexWidth), 0)");
+    for (size_t at = map.find("texelFetch"); at != std::string::npos; at = map.find("texelFetch", at + 1)) {
+        GLSLScanner scanner(source, at + 10);
+        scanner.skipSpaces();
+        std::vector<std::string_view> args;
+        // Only the two argument (buffer) form, on one of the converted samplers
+        if (!scanner.consumeArguments(args) || args.size() != 2) continue;
+        if (std::find(samplers.begin(), samplers.end(), args[0]) == samplers.end()) continue;
+        std::string call = "texelFetch(";
+        call.append(args[0]).append(", bufferCoords(").append(args[1]).append("), 0)");
+        edits.replace(at, scanner.position(), std::move(call));
+        at = scanner.position() - 1;
+    }
+
+    const char* bufferDecl = R"(
+uniform int u_BufferTexWidth;
+uniform int u_BufferTexHeight;
 
-    const char* boundaryProtection = R"(
 ivec2 bufferCoords(int index) {
     int width = u_BufferTexWidth;
     int x = index % width;
@@ -585,36 +692,29 @@ ivec2 bufferCoords(int index) {
     return ivec2(x, y);
 }
 )";
+    edits.insert(find_insertion_point(map, source), bufferDecl);
+    source = edits.apply(source);
+}
 
-    source = std::regex_replace(source, std::regex("texelFetch\\((\\w+)\\s*,\\s*ivec2\\(([^)]+)\\)\\s*,\\s*0\\)"),
-                                "texelFetch($1, bufferCoords($2), 0)");
-
-    size_t insertion_point = find_insertion_point(source);
-    if (insertion_point != std::string::npos) {
-        source.insert(insertion_point, boundaryProtection);
-    }
-
-    const char* uniformDecl = R"(
-uniform int u_BufferTexWidth;
-uniform int u_BufferTexHeight;
-)";
-
-    insertion_point = find_insertion_point(source);
-    if (insertion_point != std::string::npos) {
-        insertion_point = source.find('\n', insertion_point);
-        if (insertion_point != std::string::npos) {
-            source.insert(insertion_point + 1, uniformDecl);
-        }
+// Whether `<type>\s+<name>\s*(` occurs in the code
+static bool has_function_definition(const GLSLCodeMap& map, std::string_view glsl, std::string_view type,
+                                    std::string_view name) {
+    for (size_t at = map.find(type); at != std::string_view::npos; at = map.find(type, at + 1)) {
+        GLSLScanner scanner(glsl, at + type.size());
+        if (scanner.skipSpaces() == 0 || !scanner.consume(name)) continue;
+        scanner.skipSpaces();
+        if (scanner.consume('(')) return true;
     }
+    return false;
 }
 
 static void inject_textureQueryLod(std::string& glsl) {
-    const std::regex defRegex(R"(vec2\s+mg_textureQueryLod\s*\()", std::regex::ECMAScript);
-
     if (glsl.find("textureQueryLod") == std::string::npos) {
         return;
     }
-    if (std::regex_search(glsl, defRegex)) {
+    GLSLCodeMap map(glsl);
+    if (map.find("textureQueryLod") == std::string::npos ||
+        has_function_definition(map, glsl, "vec2", "mg_textureQueryLod")) {
         return;
     }
 
@@ -631,29 +731,70 @@ vec2 mg_textureQueryLod(sampler2D tex, vec2 uv) {
 }
 )";
 
-    size_t insertPos = find_insertion_point(glsl);
+    size_t insertPos = find_insertion_point(map, glsl);
     glsl.insert(insertPos, "\n" + textureQueryLodImpl + "\n");
 }
 
-static inline void inject_temporal_filter(std::string& glsl) {
-    const std::regex defRegex(R"(vec4\s+GI_TemporalFilter\s*\()", std::regex::ECMAScript);
+// `[ <digits> ]`
+static bool consume_array_size(GLSLScanner& scanner) {
+    GLSLScanner probe = scanner;
+    probe.skipSpaces();
+    if (!probe.consume('[')) return false;
+    probe.skipSpaces();
+    if (probe.consumeDigits() == 0) return false;
+    probe.skipSpaces();
+    if (!probe.consume(']')) return false;
+    scanner = probe;
+    return true;
+}
+
+// End of the line holding the last `[layout(...)] uniform [precision] <type>[N] <name>[N];`
+// that starts a line, or 0 if there is none
+static size_t end_of_last_uniform_line(const GLSLCodeMap& map, std::string_view glsl) {
+    size_t last = 0;
+    for (size_t at = map.find("uniform"); at != std::string_view::npos; at = map.find("uniform", at + 1)) {
+        size_t lineBegin = glsl.rfind('\n', at);
+        GLSLScanner scanner(glsl, lineBegin == std::string_view::npos ? 0 : lineBegin + 1);
+        scanner.skipSpaces();
+        if (scanner.consume("layout")) {
+            scanner.skipSpaces();
+            std::vector<std::string_view> qualifiers;
+            if (!scanner.consumeArguments(qualifiers)) continue;
+            scanner.skipSpaces();
+        }
+        if (scanner.position() != at) continue;
+        scanner.consumeWord();
+        if (scanner.skipSpaces() == 0) continue;
+        std::string_view type = scanner.consumeWord();
+        if (type == "highp" || type == "mediump" || type == "lowp") {
+            scanner.skipSpaces();
+            type = scanner.consumeWord();
+        }
+        if (type.empty()) continue;
+        consume_array_size(scanner);
+        scanner.skipSpaces();
+        if (scanner.consumeWord().empty()) continue;
+        consume_array_size(scanner);
+        scanner.skipSpaces();
+        if (!scanner.consume(';')) continue;
+        size_t lineEnd = glsl.find('\n', scanner.position());
+        last = lineEnd == std::string_view::npos ? glsl.size() : lineEnd;
+    }
+    return last;
+}
 
+static inline void inject_temporal_filter(std::string& glsl) {
     if (glsl.find("GI_TemporalFilter") == std::string::npos) {
         return;
     }
-    if (std::regex_search(glsl, defRegex)) {
+    GLSLCodeMap map(glsl);
+    if (map.find("GI_TemporalFilter") == std::string::npos ||
+        has_function_definition(map, glsl, "vec4", "GI_TemporalFilter")) {
         return;
     }
 
-    const std::regex uniformRegex(
-        R"(^\s*(?:layout\s*\([^)]*\)\s*)?uniform\s+\w+(?:\s*\[\s*\d+\s*\])?\s+\w+(?:\s*\[\s*\d+\s*\])?\s*;.*$)",
-        std::regex::ECMAScript | std::regex::multiline);
-    std::sregex_iterator it(glsl.begin(), glsl.end(), uniformRegex);
-    std::sregex_iterator end;
-    size_t insertPos = 0;
-    for (; it != end; ++it) {
-        insertPos = it->position() + it->length();
-    }
+    size_t insertPos = end_of_last_uniform_line(map, glsl);
+    if (insertPos == 0) insertPos = find_insertion_point(map, glsl);
 
     const std::string GI_TemporalFilterImpl = R"(
 vec4 GI_TemporalFilter() {
@@ -704,9 +845,7 @@ void inject_mg_macro_definition(std::string& glslCode) {
 }
 
 std::string preprocess_glsl(const std::string& glsl, GLenum shaderType, bool* atomicCounterEmulated) {
-    std::string ret = glsl;
-    // Remove lines beginning with `#line`
-    ret = replace_line_starting_with(ret, "#line");
+    std::string ret = remove_line_directives(glsl);
     // Act as if disable_GL_ARB_derivative_control is false
     replace_all(ret, "#ifdef GL_ARB_derivative_control", "#if 0");
     replace_all(ret, "#ifndef GL_ARB_derivative_control", "#if 1");
@@ -753,6 +892,7 @@ int get_or_add_glsl_version(std::string& glsl) {
 
 std::vector<unsigned int> glsl_to_spirv(GLenum shader_type, int glsl_version, const char* const* shader_src,
                                         int& errc) {
+    TranslationContext& context = TranslationContext::current();
     EShLanguage shader_language;
     switch (shader_type) {
     case GL_VERTEX_SHADER:
@@ -789,9 +929,7 @@ std::vector<unsigned int> glsl_to_spirv(GLenum shader_type, int glsl_version, co
     shader.setAutoMapLocations(true);
     shader.setAutoMapBindings(true);
 
-    TBuiltInResource TBuiltInResource_resources = InitResources();
-
-    if (!shader.parse(&TBuiltInResource_resources, glsl_version, true, EShMsgDefault)) {
+    if (!shader.parse(&context.resources, glsl_version, true, EShMsgDefault)) {
         LOG_D("GLSL Compiling ERROR: \n%s", shader.getInfoLog())
         errc = -1;
         return {};
@@ -808,27 +946,28 @@ std::vector<unsigned int> glsl_to_spirv(GLenum shader_type, int glsl_version, co
     }
     LOG_D("Shader Linked.")
     std::vector<unsigned int> spirv_code;
-    glslang::SpvOptions spvOptions;
-    spvOptions.disableOptimizer = false;
-    glslang::GlslangToSpv(*program.getIntermediate(shader_language), spirv_code, &spvOptions);
+    glslang::GlslangToSpv(*program.getIntermediate(shader_language), spirv_code, &context.spvOptions);
     errc = 0;
     return spirv_code;
 }
 
-std::string spirv_to_essl(std::vector<unsigned int> spirv, uint essl_version, int& errc) {
-    spvc_context context = nullptr;
+std::string spirv_to_essl(const std::vector<unsigned int>& spirv, uint essl_version, int& errc) {
+    TranslationContext& translation_context = TranslationContext::current();
+    spvc_context context = translation_context.spvc;
     spvc_parsed_ir ir = nullptr;
     spvc_compiler compiler_glsl = nullptr;
     spvc_compiler_options options = nullptr;
     spvc_resources resources = nullptr;
     const char* result = nullptr;
-    size_t count;
 
     const SpvId* p_spirv = spirv.data();
     size_t word_count = spirv.size();
 
     LOG_D("spirv_code.size(): %d", spirv.size())
-    spvc_context_create(&context);
+    if (!context) {
+        errc = -1;
+        return "";
+    }
     spvc_context_parse_spirv(context, p_spirv, word_count, &ir);
     spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, ir, SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler_glsl);
     spvc_compiler_create_shader_resources(compiler_glsl, &resources);
@@ -841,29 +980,25 @@ std::string spirv_to_essl(std::vector<unsigned int> spirv, uint essl_version, in
 
     if (!result) {
         LOG_E("Error: unexpected error in spirv-cross.")
+        translation_context.reset();
         errc = -1;
         return "";
     }
 
     std::string essl = result;
 
-    spvc_context_destroy(context);
+    translation_context.reset();
 
     errc = 0;
     return essl;
 }
 
-static bool glslang_inited = false;
 std::string GLSLtoGLSLES_2(const char* glsl_code, GLenum glsl_type, uint essl_version, int& return_code) {
     bool atomicCounterEmulated = false;
     std::string correct_glsl_str = preprocess_glsl(glsl_code, glsl_type, &atomicCounterEmulated);
     LOG_D("Firstly converted GLSL:\n%s", correct_glsl_str.c_str())
     int glsl_version = get_or_add_glsl_version(correct_glsl_str);
 
-    if (!glslang_inited) {
-        glslang::InitializeProcess();
-        glslang_inited = true;
-    }
     const char* s[] = {correct_glsl_str.c_str()};
     int errc = 0;
     std::vector<unsigned int> spirv_code = glsl_to_spirv(glsl_type, glsl_version, s, errc);
@@ -13,6 +13,7 @@
 #include <GL/gl.h>
 #include <stdio.h>
 #include <string>
+#include <vector>
 
 #ifdef __cplusplus
 extern "C"
@@ -29,4 +30,14 @@ std::string GLSLtoGLSLES_1(const char* glsl_code, GLenum glsl_type, uint esversi
 std::string GLSLtoGLSLES_2(const char* glsl_code, GLenum glsl_type, uint essl_version, int& return_code);
 int getGLSLVersion(const char* glsl_code);
 
+// Stages of GLSLtoGLSLES_2, in order
+std::string preprocess_glsl(const std::string& glsl, GLenum shaderType, bool* atomicCounterEmulated);
+int get_or_add_glsl_version(std::string& glsl);
+std::vector<unsigned int> glsl_to_spirv(GLenum shader_type, int glsl_version, const char* const* shader_src,
+                                        int& errc);
+std::string spirv_to_essl(const std::vector<unsigned int>& spirv, uint essl_version, int& errc);
+std::string removeLayoutBinding(const std::string& glslCode);
+std::string processOutColorLocations(const std::string& glslCode);
+std::string forceSupporterOutput(const std::string& glslCode);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,259 @@
+// MobileGlues - gl/glsl/glsl_scanner.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "glsl_scanner.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace {
+    enum class Live { No, Yes, Unknown };
+
+    struct Group {
+        Live parent;
+        Live self;
+        bool taken;     // a previous branch was known to be live
+        bool maybeTaken; // a previous branch might have been live
+    };
+
+    Live combine(Live parent, Live self) {
+        if (parent == Live::No || self == Live::No) return Live::No;
+        if (parent == Live::Unknown || self == Live::Unknown) return Live::Unknown;
+        return Live::Yes;
+    }
+
+    // Known macro state: true = defined, false = undefined. Absent = unknown.
+    using Macros = std::unordered_map<std::string, bool>;
+
+    Live definedState(const Macros& macros, std::string_view name) {
+        auto it = macros.find(std::string(name));
+        if (it == macros.end()) return Live::Unknown;
+        return it->second ? Live::Yes : Live::No;
+    }
+
+    Live invert(Live v) {
+        return v == Live::Unknown ? Live::Unknown : (v == Live::Yes ? Live::No : Live::Yes);
+    }
+
+    // `0`, `1`, `defined X`, `defined(X)` and `!` of those, anything else is unknown
+    Live evaluate(std::string_view expr, const Macros& macros) {
+        expr = GLSLScanner::trim(expr);
+        if (!expr.empty() && expr.front() == '!') return invert(evaluate(expr.substr(1), macros));
+        if (expr.size() >= 2 && expr.front() == '(' && expr.back() == ')') {
+            return evaluate(expr.substr(1, expr.size() - 2), macros);
+        }
+        if (!expr.empty() && std::all_of(expr.begin(), expr.end(), GLSLScanner::isDigit)) {
+            return std::strtol(std::string(expr).c_str(), nullptr, 10) != 0 ? Live::Yes : Live::No;
+        }
+        GLSLScanner scanner(expr);
+        if (scanner.consumeWord() != "defined") return Live::Unknown;
+        scanner.skipSpaces();
+        bool paren = scanner.consume('(');
+        scanner.skipSpaces();
+        std::string_view name = scanner.consumeWord();
+        scanner.skipSpaces();
+        if (name.empty() || (paren && !scanner.consume(')'))) return Live::Unknown;
+        scanner.skipSpaces();
+        if (!scanner.eof()) return Live::Unknown;
+        return definedState(macros, name);
+    }
+
+    size_t lineEnd(std::string_view src, size_t pos) {
+        size_t end = src.find('\n', pos);
+        return end == std::string_view::npos ? src.size() : end;
+    }
+} // namespace
+
+GLSLCodeMap::GLSLCodeMap(std::string_view src) : src(src) {
+    std::vector<Group> groups;
+    Macros macros;
+    Live live = Live::Yes;
+    size_t disabledFrom = 0;
+
+    // Switches the liveness after the directive ending at `end`, recording disabled code
+    auto setLive = [&](Live next, size_t directiveBegin, size_t directiveEnd) {
+        if (live == Live::No && next != Live::No) skipped.push_back({disabledFrom, directiveBegin});
+        if (live != Live::No && next == Live::No) disabledFrom = directiveEnd;
+        live = next;
+    };
+
+    auto handleDirective = [&](Directive& d) {
+        GLSLScanner scanner(d.text);
+        scanner.skipSpaces();
+        std::string_view word = scanner.consumeWord();
+        scanner.skipSpaces();
+        std::string_view rest = d.text;
+        rest.remove_prefix(scanner.position());
+        std::string_view operand = GLSLScanner(rest).peekWord();
+
+        if (word == "if" || word == "ifdef" || word == "ifndef") {
+            Live self = word == "if"      ? evaluate(rest, macros)
+                        : word == "ifdef" ? definedState(macros, operand)
+                                          : invert(definedState(macros, operand));
+            groups.push_back({live, self, self == Live::Yes, self != Live::No});
+            setLive(combine(live, self), d.begin, d.end);
+        } else if ((word == "elif" || word == "else") && !groups.empty()) {
+            Group& g = groups.back();
+            Live self = g.taken ? Live::No : (word == "else" ? Live::Yes : evaluate(rest, macros));
+            if (self == Live::Yes && g.maybeTaken) self = Live::Unknown;
+            g.taken = g.taken || self == Live::Yes;
+            g.maybeTaken = g.maybeTaken || self != Live::No;
+            g.self = self;
+            setLive(combine(g.parent, self), d.begin, d.end);
+        } else if (word == "endif" && !groups.empty()) {
+            Live parent = groups.back().parent;
+            groups.pop_back();
+            setLive(parent, d.begin, d.end);
+        } else if ((word == "define" || word == "undef") && !operand.empty() && live != Live::No) {
+            if (live == Live::Yes) {
+                macros[std::string(operand)] = word == "define";
+            } else {
+                macros.erase(std::string(operand));
+            }
+        }
+    };
+
+    const size_t n = src.size();
+    bool lineStart = true;
+    size_t i = 0;
+    while (i < n) {
+        char c = src[i];
+        char next = i + 1 < n ? src[i + 1] : '\0';
+        if (c == '/' && next == '/') {
+            size_t end = lineEnd(src, i);
+            skipped.push_back({i, end});
+            i = end;
+        } else if (c == '/' && next == '*') {
+            size_t end = src.find("*/", i + 2);
+            end = end == std::string_view::npos ? n : end + 2;
+            skipped.push_back({i, end});
+            i = end;
+        } else if (c == '"') {
+            size_t end = i + 1;
+            while (end < n && src[end] != '"' && src[end] != '\n')
+                end += src[end] == '\\' ? 2 : 1;
+            end = std::min(n, end + 1);
+            skipped.push_back({i, end});
+            i = end;
+        } else if (c == '#' && lineStart) {
+            Directive d{i, i, {}, {}, live != Live::No};
+            size_t j = i + 1;
+            while (j < n && src[j] != '\n') {
+                if (src[j] == '\\' && j + 1 < n && (src[j + 1] == '\n' || src[j + 1] == '\r')) {
+                    j += src[j + 1] == '\r' && j + 2 < n && src[j + 2] == '\n' ? 3 : 2;
+                    d.text += ' ';
+                } else if (src[j] == '/' && j + 1 < n && src[j + 1] == '/') {
+                    j = lineEnd(src, j);
+                } else if (src[j] == '/' && j + 1 < n && src[j + 1] == '*') {
+                    size_t end = src.find("*/", j + 2);
+                    j = end == std::string_view::npos ? n : end + 2;
+                    d.text += ' ';
+                } else {
+                    d.text += src[j++];
+                }
+            }
+            if (!d.text.empty() && d.text.back() == '\r') d.text.pop_back();
+            d.end = j;
+            skipped.push_back({d.begin, d.end});
+
+            GLSLScanner scanner(src, i + 1);
+            scanner.skipSpaces();
+            d.name = scanner.peekWord();
+            // Keep only what follows the name in the text
+            size_t nameAt = d.text.find(d.name);
+            if (!d.name.empty() && nameAt != std::string::npos) d.text.erase(0, nameAt);
+            handleDirective(d);
+            d.text.erase(0, d.name.size());
+            directiveList.push_back(std::move(d));
+            i = j;
+            lineStart = false;
+        } else {
+            if (c == '\n') {
+                lineStart = true;
+            } else if (!GLSLScanner::isSpace(c)) {
+                lineStart = false;
+            }
+            ++i;
+        }
+    }
+    if (live == Live::No) skipped.push_back({disabledFrom, n});
+
+    std::sort(skipped.begin(), skipped.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+    std::vector<Range> merged;
+    for (const Range& r : skipped) {
+        if (r.end <= r.begin) continue;
+        if (!merged.empty() && r.begin <= merged.back().end) {
+            merged.back().end = std::max(merged.back().end, r.end);
+        } else {
+            merged.push_back(r);
+        }
+    }
+    skipped = std::move(merged);
+}
+
+bool GLSLCodeMap::isCode(size_t pos) const {
+    if (pos >= src.size()) return false;
+    auto it = std::upper_bound(skipped.begin(), skipped.end(), pos,
+                               [](size_t p, const Range& r) { return p < r.begin; });
+    return it == skipped.begin() || pos >= std::prev(it)->end;
+}
+
+size_t GLSLCodeMap::find(std::string_view needle, size_t from) const {
+    if (needle.empty()) return std::string_view::npos;
+    bool wordStart = GLSLScanner::isWordChar(needle.front());
+    bool wordEnd = GLSLScanner::isWordChar(needle.back());
+    for (size_t at = src.find(needle, from); at != std::string_view::npos; at = src.find(needle, at + 1)) {
+        if (wordStart && at > 0 && GLSLScanner::isWordChar(src[at - 1])) continue;
+        size_t end = at + needle.size();
+        if (wordEnd && end < src.size() && GLSLScanner::isWordChar(src[end])) continue;
+        if (!isCode(at)) continue;
+        return at;
+    }
+    return std::string_view::npos;
+}
+
+int GLSLCodeMap::lineAt(size_t pos) const {
+    int line = 1;
+    size_t counted = 0;
+    for (const Directive& d : directiveList) {
+        if (d.begin >= pos) break;
+        if (d.name != "line" || !d.live) continue;
+        GLSLScanner scanner(d.text);
+        scanner.skipSpaces();
+        size_t digits = scanner.position();
+        if (scanner.consumeDigits() == 0) continue;
+        // The line after the directive gets the given number
+        line = std::atoi(d.text.c_str() + digits) - 1;
+        counted = d.end;
+    }
+    for (size_t i = counted; i < pos && i < src.size(); ++i) {
+        if (src[i] == '\n') ++line;
+    }
+    return line;
+}
+
+std::string GLSLEdits::apply(std::string_view src) {
+    std::stable_sort(edits.begin(), edits.end(), [](const Edit& a, const Edit& b) {
+        return a.begin != b.begin ? a.begin < b.begin : (a.begin == a.end && b.begin != b.end);
+    });
+    size_t extra = 0;
+    for (const Edit& e : edits)
+        extra += e.text.size();
+    std::string result;
+    result.reserve(src.size() + extra);
+    size_t copied = 0;
+    for (const Edit& e : edits) {
+        if (e.begin < copied || e.end > src.size()) continue;
+        result.append(src, copied, e.begin - copied);
+        result += e.text;
+        copied = e.end;
+    }
+    result.append(src, copied, std::string_view::npos);
+    edits.clear();
+    return result;
+}
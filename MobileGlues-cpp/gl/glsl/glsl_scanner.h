@@ -0,0 +1,176 @@
+// MobileGlues - gl/glsl/glsl_scanner.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_PLUGIN_GLSL_SCANNER_H
+#define MOBILEGLUES_PLUGIN_GLSL_SCANNER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Forward-only cursor over GLSL source. The source rewrites are written
+// against it instead of std::regex so that each of them is a single linear
+// pass. Character classes follow the ECMAScript ones used by the old
+// patterns: \s, \w and \d.
+class GLSLScanner {
+public:
+    explicit GLSLScanner(std::string_view src, size_t pos = 0) : src(src), pos(pos) {}
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+    static bool isWordChar(char c) {
+        return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    bool eof() const { return pos >= src.size(); }
+    size_t position() const { return pos; }
+
+    // Each returns the number of characters consumed
+    size_t skipSpaces() {
+        size_t start = pos;
+        while (pos < src.size() && isSpace(src[pos]))
+            ++pos;
+        return pos - start;
+    }
+    size_t consumeDigits() {
+        size_t start = pos;
+        while (pos < src.size() && isDigit(src[pos]))
+            ++pos;
+        return pos - start;
+    }
+
+    bool consume(char c) {
+        if (pos < src.size() && src[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+    bool consume(std::string_view literal) {
+        if (src.substr(pos, literal.size()) == literal) {
+            pos += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    std::string_view consumeWord() {
+        size_t start = pos;
+        while (pos < src.size() && isWordChar(src[pos]))
+            ++pos;
+        return src.substr(start, pos - start);
+    }
+    std::string_view peekWord() const {
+        size_t end = pos;
+        while (end < src.size() && isWordChar(src[end]))
+            ++end;
+        return src.substr(pos, end - pos);
+    }
+
+    // At '(': consumes up to the matching ')' and splits the top-level
+    // comma-separated arguments, trimmed. False (nothing consumed) if the
+    // parentheses are unbalanced.
+    bool consumeArguments(std::vector<std::string_view>& args) {
+        if (pos >= src.size() || src[pos] != '(') return false;
+        args.clear();
+        int depth = 0;
+        size_t argStart = pos + 1;
+        for (size_t i = pos; i < src.size(); ++i) {
+            char c = src[i];
+            if (c == '(' || c == '[') {
+                ++depth;
+            } else if (c == ')' || c == ']') {
+                if (--depth == 0) {
+                    if (c != ')') return false;
+                    std::string_view last = trim(src.substr(argStart, i - argStart));
+                    if (!last.empty() || !args.empty()) args.push_back(last);
+                    pos = i + 1;
+                    return true;
+                }
+            } else if (c == ',' && depth == 1) {
+                args.push_back(trim(src.substr(argStart, i - argStart)));
+                argStart = i + 1;
+            }
+        }
+        return false;
+    }
+
+    static std::string_view trim(std::string_view s) {
+        while (!s.empty() && isSpace(s.front()))
+            s.remove_prefix(1);
+        while (!s.empty() && isSpace(s.back()))
+            s.remove_suffix(1);
+        return s;
+    }
+
+private:
+    std::string_view src;
+    size_t pos;
+};
+
+// Which parts of a GLSL source are live code. Comments, string literals,
+// preprocessor directives (with their continuation lines) and the bodies of
+// #if groups that are statically disabled are not, so rewrites neither match
+// inside them nor mistake them for declarations.
+//
+// Conditions are only evaluated when that is possible from the source alone:
+// integer literals, and defined()/#ifdef/#ifndef of macros the source itself
+// #defines or #undefs. Any other group is kept, as the driver may enable it.
+class GLSLCodeMap {
+public:
+    struct Directive {
+        size_t begin, end; // from '#' to the end of the (continued) line, newline excluded
+        std::string_view name;
+        std::string text; // after the name, comments and line continuations removed
+        bool live;        // not inside a disabled group
+    };
+
+    explicit GLSLCodeMap(std::string_view src);
+
+    bool isCode(size_t pos) const;
+    // First live occurrence of `needle` at or after `from`, as a whole word if
+    // it starts or ends with a word character. npos if there is none.
+    size_t find(std::string_view needle, size_t from = 0) const;
+    const std::vector<Directive>& directives() const { return directiveList; }
+    // Line of `pos` as the compiler reports it, following #line directives
+    int lineAt(size_t pos) const;
+
+private:
+    struct Range {
+        size_t begin, end;
+    };
+
+    std::string_view src;
+    std::vector<Range> skipped; // sorted and disjoint
+    std::vector<Directive> directiveList;
+};
+
+// Replacements found through one GLSLCodeMap, applied to its source in a
+// single pass, so a rewrite stage does not rescan what it already changed.
+// Positions refer to the original source; insertions at a position go before
+// a replacement starting there, and edits overlapping an earlier one are dropped.
+class GLSLEdits {
+public:
+    void replace(size_t begin, size_t end, std::string text) { edits.push_back({begin, end, std::move(text)}); }
+    void insert(size_t at, std::string text) { replace(at, at, std::move(text)); }
+    bool empty() const { return edits.empty(); }
+
+    std::string apply(std::string_view src);
+
+private:
+    struct Edit {
+        size_t begin, end;
+        std::string text;
+    };
+
+    std::vector<Edit> edits;
+};
+
+#endif // MOBILEGLUES_PLUGIN_GLSL_SCANNER_H
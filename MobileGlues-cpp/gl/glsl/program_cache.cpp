@@ -0,0 +1,262 @@
+// MobileGlues - gl/glsl/program_cache.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "program_cache.h"
+#include "cache.h"
+#include "../getter.h"
+#include "../../version.h"
+#include "digest.h"
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <algorithm>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include <xxhash32.h>
+#include <xxhash64.h>
+
+#define DEBUG 0
+
+namespace {
+    constexpr uint32_t BINARY_MAGIC = 0x3250474d; // "MGP2"
+
+    // Followed by keyLength bytes of key and length bytes of binary, both covered by the checksum
+    struct BinaryHeader {
+        uint32_t magic;
+        uint32_t format;
+        uint32_t length;
+        uint32_t keyLength;
+        uint32_t checksum;
+    };
+
+    uint32_t entryChecksum(const std::string& key, const char* binary, size_t length) {
+        XXHash32 hasher(BINARY_MAGIC);
+        hasher.add(key.data(), key.size());
+        hasher.add(binary, length);
+        return hasher.hash();
+    }
+
+    constexpr uint32_t MAX_KEY_LENGTH = 1024 * 1024;
+
+    const char* IDENTITY_FILE = "/identity";
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache() {
+    if (global_settings.max_glsl_cache_size <= 0 || !program_cache_dir_path) return;
+
+    GLint formats = 0;
+    GLES.glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0 || !GLES.glGetProgramBinary || !GLES.glProgramBinary) {
+        LOG_D("ProgramBinaryCache: driver exposes no program binary formats")
+        return;
+    }
+
+    directory = program_cache_dir_path;
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        LOG_W("ProgramBinaryCache: cannot create %s", directory.c_str())
+        return;
+    }
+
+    const char* renderer = (const char*)GLES.glGetString(GL_RENDERER);
+    const char* version = (const char*)GLES.glGetString(GL_VERSION);
+    std::string identityString = getGpuName() + "|" + (renderer ? renderer : "") + "|" + (version ? version : "") +
+                                 "|" + std::to_string(MAJOR) + "." + std::to_string(MINOR) + "." +
+                                 std::to_string(REVISION);
+    driverIdentity = digest::hash64(identityString);
+    checkIdentity(identityString);
+    available = true;
+}
+
+// Binaries are only valid for the driver that produced them. Wipe the
+// directory whenever the GPU, driver or MobileGlues version changes.
+void ProgramBinaryCache::checkIdentity(const std::string& identityString) {
+    std::string identityPath = directory + IDENTITY_FILE;
+    std::string stored;
+    {
+        std::ifstream in(identityPath);
+        std::getline(in, stored, '\0');
+    }
+
+    bool sameDriver = stored == identityString;
+    size_t size = 0;
+    if (DIR* dir = opendir(directory.c_str())) {
+        while (dirent* ent = readdir(dir)) {
+            std::string name = ent->d_name;
+            if (name.size() < 4 || name.compare(name.size() - 4, 4, ".bin") != 0) continue;
+            std::string path = directory + "/" + name;
+            struct stat st{};
+            if (!sameDriver) {
+                unlink(path.c_str());
+            } else if (stat(path.c_str(), &st) == 0) {
+                size += static_cast<size_t>(st.st_size);
+            }
+        }
+        closedir(dir);
+    }
+    setTotalSize(size);
+
+    if (!sameDriver) {
+        LOG_D("ProgramBinaryCache: driver changed, cache cleared")
+        std::ofstream out(identityPath, std::ios::trunc);
+        out << identityString;
+    }
+}
+
+void ProgramBinaryCache::setTotalSize(size_t size) {
+    totalSize = size;
+    Cache::get_instance().setSharedBytes(totalSize);
+}
+
+std::string ProgramBinaryCache::entryPath(const std::string& key) const {
+    char name[32];
+    snprintf(name, sizeof(name), "/%016" PRIx64 ".bin", XXHash64::hash(key.data(), key.size(), driverIdentity));
+    return directory + name;
+}
+
+bool ProgramBinaryCache::load(GLuint program, const std::string& key) {
+    if (!available) return false;
+    std::string path = entryPath(key);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    BinaryHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    std::string storedKey;
+    std::vector<char> binary;
+    bool valid = in && header.magic == BINARY_MAGIC && header.length > 0 && header.keyLength <= MAX_KEY_LENGTH;
+    if (valid) {
+        storedKey.resize(header.keyLength);
+        binary.resize(header.length);
+        in.read(storedKey.data(), header.keyLength);
+        in.read(binary.data(), header.length);
+        valid = in && entryChecksum(storedKey, binary.data(), binary.size()) == header.checksum;
+    }
+    in.close();
+    if (valid && storedKey != key) {
+        // Another program whose key hashes to the same name; storing after the link replaces it
+        LOG_D("ProgramBinaryCache: key mismatch for program %u", program)
+        return false;
+    }
+
+    if (valid) {
+        GLES.glProgramBinary(program, header.format, binary.data(), (GLsizei)header.length);
+        GLint status = GL_FALSE;
+        GLES.glGetProgramiv(program, GL_LINK_STATUS, &status);
+        if (status == GL_TRUE) {
+            LOG_D("ProgramBinaryCache: program %u restored from %s", program, path.c_str())
+            // The modification time doubles as the last use, evictOldest() goes by it
+            utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+            return true;
+        }
+        LOG_D("ProgramBinaryCache: driver rejected binary for program %u", program)
+    }
+
+    // Corrupt or rejected: drop it, the caller falls back to a regular link
+    struct stat st{};
+    if (stat(path.c_str(), &st) == 0 && unlink(path.c_str()) == 0) {
+        setTotalSize(totalSize - std::min(totalSize, static_cast<size_t>(st.st_size)));
+    }
+    return false;
+}
+
+void ProgramBinaryCache::store(GLuint program, const std::string& key) {
+    if (!available) return;
+
+    GLint length = 0;
+    GLES.glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::string path = entryPath(key);
+    struct stat st{};
+    size_t replaced = stat(path.c_str(), &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+    size_t entrySize = sizeof(BinaryHeader) + key.size() + length;
+    size_t glslSize = Cache::get_instance().size();
+    if (glslSize + entrySize > global_settings.max_glsl_cache_size) {
+        LOG_D("ProgramBinaryCache: size budget exhausted, not storing program %u", program)
+        return;
+    }
+    size_t budget = global_settings.max_glsl_cache_size - glslSize - entrySize;
+    if (totalSize - std::min(totalSize, replaced) > budget) {
+        evictOldest(budget + replaced, path);
+        if (totalSize - std::min(totalSize, replaced) > budget) {
+            LOG_D("ProgramBinaryCache: size budget exhausted, not storing program %u", program)
+            return;
+        }
+    }
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    GLES.glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+    binary.resize(written);
+
+    BinaryHeader header{BINARY_MAGIC, format, static_cast<uint32_t>(written), static_cast<uint32_t>(key.size()),
+                        entryChecksum(key, binary.data(), binary.size())};
+
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(key.data(), (std::streamsize)key.size());
+        out.write(binary.data(), written);
+        if (!out) {
+            out.close();
+            unlink(tmpPath.c_str());
+            return;
+        }
+    }
+    if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        return;
+    }
+    setTotalSize(totalSize - std::min(totalSize, replaced) + sizeof(header) + key.size() + written);
+}
+
+// Unlinks the least recently used binaries, other than `keep`, until the
+// directory holds at most `target` bytes.
+void ProgramBinaryCache::evictOldest(size_t target, const std::string& keep) {
+    struct Entry {
+        timespec used;
+        size_t size;
+        std::string path;
+    };
+    std::vector<Entry> entries;
+    if (DIR* dir = opendir(directory.c_str())) {
+        while (dirent* ent = readdir(dir)) {
+            std::string name = ent->d_name;
+            if (name.size() < 4 || name.compare(name.size() - 4, 4, ".bin") != 0) continue;
+            std::string path = directory + "/" + name;
+            struct stat st{};
+            if (path == keep || stat(path.c_str(), &st) != 0) continue;
+            entries.push_back({st.st_mtim, static_cast<size_t>(st.st_size), std::move(path)});
+        }
+        closedir(dir);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.used.tv_sec != b.used.tv_sec ? a.used.tv_sec < b.used.tv_sec : a.used.tv_nsec < b.used.tv_nsec;
+    });
+
+    size_t size = totalSize;
+    for (const Entry& entry : entries) {
+        if (size <= target) break;
+        if (unlink(entry.path.c_str()) != 0) continue;
+        LOG_D("ProgramBinaryCache: evicted %s", entry.path.c_str())
+        size -= std::min(size, entry.size);
+    }
+    setTotalSize(size);
+}
+
+ProgramBinaryCache& ProgramBinaryCache::get_instance() {
+    static ProgramBinaryCache s_cache;
+    return s_cache;
+}
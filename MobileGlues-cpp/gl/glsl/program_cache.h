@@ -0,0 +1,54 @@
+// MobileGlues - gl/glsl/program_cache.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_PLUGIN_PROGRAM_CACHE_H
+#define MOBILEGLUES_PLUGIN_PROGRAM_CACHE_H
+
+#include "../mg.h"
+#include "../../config/config.h"
+#include "../../config/settings.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Persistent cache of linked program binaries (glGetProgramBinary/glProgramBinary).
+// Keys are built by the caller from everything that affects the link (translated
+// sources, bound locations, transform feedback varyings, program parameters).
+// Entries are named by a hash of the key and driver identity but store the full
+// key, so a hash collision is a miss rather than the wrong program. Binaries
+// from a different driver are discarded on startup. The disk budget
+// (max_glsl_cache_size) is shared with the GLSL cache; once it is full the
+// least recently loaded or stored binaries are evicted to make room.
+// Only talks to the backend through the GLES function table.
+class ProgramBinaryCache {
+public:
+    ProgramBinaryCache();
+
+    bool enabled() const { return available; }
+    uint64_t identity() const { return driverIdentity; }
+
+    // Tries to restore `program` from the cache. Returns false (and drops the
+    // entry) if there is no binary or the driver rejects it.
+    bool load(GLuint program, const std::string& key);
+    void store(GLuint program, const std::string& key);
+
+    static ProgramBinaryCache& get_instance();
+
+private:
+    std::string entryPath(const std::string& key) const;
+    void setTotalSize(size_t size);
+    void checkIdentity(const std::string& identityString);
+    void evictOldest(size_t target, const std::string& keep);
+
+    bool available = false;
+    uint64_t driverIdentity = 0;
+    size_t totalSize = 0;
+    std::string directory;
+};
+
+#endif // MOBILEGLUES_PLUGIN_PROGRAM_CACHE_H
@@ -0,0 +1,83 @@
+// MobileGlues - gl/glsl/translator_pool.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "translator_pool.h"
+#include "glsl_for_es.h"
+
+#include <algorithm>
+
+#define DEBUG 0
+
+#define MAX_TRANSLATOR_WORKERS 4
+
+static TranslateResult translate(const std::string& glsl, GLenum shader_type, uint essl_version, uint glsl_version) {
+    TranslateResult result{};
+    result.essl = GLSLtoGLSLES(glsl.c_str(), shader_type, essl_version, glsl_version, result.return_code);
+    return result;
+}
+
+TranslatorPool::TranslatorPool(unsigned worker_count) {
+    workers.reserve(worker_count);
+    for (unsigned i = 0; i < worker_count; ++i) {
+        workers.emplace_back(&TranslatorPool::worker_main, this);
+    }
+    LOG_D("TranslatorPool: started %u worker(s)", worker_count)
+}
+
+TranslatorPool::~TranslatorPool() {
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        stopping = true;
+    }
+    tasks_cv.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+std::shared_future<TranslateResult> TranslatorPool::submit(std::string glsl, GLenum shader_type, uint essl_version,
+                                                           uint glsl_version) {
+    std::packaged_task<TranslateResult()> task(
+        [glsl = std::move(glsl), shader_type, essl_version, glsl_version]() {
+            return translate(glsl, shader_type, essl_version, glsl_version);
+        });
+    std::shared_future<TranslateResult> future = task.get_future().share();
+
+    // No spare core: translate on the calling thread, the result is ready immediately.
+    if (workers.empty()) {
+        task();
+        return future;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        tasks.emplace_back(std::move(task));
+    }
+    tasks_cv.notify_one();
+    return future;
+}
+
+void TranslatorPool::worker_main() {
+    for (;;) {
+        std::packaged_task<TranslateResult()> task;
+        {
+            std::unique_lock<std::mutex> lock(tasks_mutex);
+            tasks_cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+TranslatorPool& TranslatorPool::get_instance() {
+    // Leave one core to the render thread.
+    static TranslatorPool s_pool(std::min<unsigned>(
+        MAX_TRANSLATOR_WORKERS, std::max<unsigned>(std::thread::hardware_concurrency(), 1) - 1));
+    return s_pool;
+}
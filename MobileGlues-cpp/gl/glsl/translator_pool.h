@@ -0,0 +1,53 @@
+// MobileGlues - gl/glsl/translator_pool.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_PLUGIN_TRANSLATOR_POOL_H
+#define MOBILEGLUES_PLUGIN_TRANSLATOR_POOL_H
+
+#include "../mg.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct TranslateResult {
+    std::string essl;
+    int return_code;
+};
+
+// Runs GLSLtoGLSLES on background threads so that glShaderSource returns
+// immediately. The result is joined when the shader is compiled or attached.
+class TranslatorPool {
+public:
+    explicit TranslatorPool(unsigned worker_count);
+    ~TranslatorPool();
+
+    TranslatorPool(const TranslatorPool&) = delete;
+    TranslatorPool& operator=(const TranslatorPool&) = delete;
+
+    std::shared_future<TranslateResult> submit(std::string glsl, GLenum shader_type, uint essl_version,
+                                               uint glsl_version);
+    unsigned worker_count() const { return static_cast<unsigned>(workers.size()); }
+
+    static TranslatorPool& get_instance();
+
+private:
+    void worker_main();
+
+    std::vector<std::thread> workers;
+    std::deque<std::packaged_task<TranslateResult()>> tasks;
+    std::mutex tasks_mutex;
+    std::condition_variable tasks_cv;
+    bool stopping = false;
+};
+
+#endif // MOBILEGLUES_PLUGIN_TRANSLATOR_POOL_H
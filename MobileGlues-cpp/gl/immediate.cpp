@@ -0,0 +1,651 @@
+// MobileGlues - gl/immediate.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "immediate.h"
+#include "display_list.h"
+#include "fixed_function.h"
+#include "log.h"
+#include "mg.h"
+#include "state.h"
+#include "../gles/loader.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#define DEBUG 0
+
+// Streaming VBO size; a batch larger than this is drawn in several parts
+#define IMMEDIATE_VBO_SIZE (4 * 1024 * 1024)
+#define IMMEDIATE_VBO_VERTICES (IMMEDIATE_VBO_SIZE / sizeof(immediate_vertex_t))
+// Batches are drawn once they reach this many vertices
+#define IMMEDIATE_BATCH_VERTICES 65536
+
+bool g_immediate_pending = false;
+
+static const char* kImmediateVS = R"glsl(#version 300 es
+layout(location = 0) in vec4 aPosition;
+layout(location = 1) in vec4 aColor;
+layout(location = 2) in vec4 aTexCoord;
+uniform mat4 uMVP;
+uniform mat4 uTexMatrix;
+out vec4 vColor;
+out vec4 vTexCoord;
+void main() {
+    gl_Position = uMVP * aPosition;
+    gl_PointSize = 1.0;
+    vColor = aColor;
+    vTexCoord = uTexMatrix * aTexCoord;
+}
+)glsl";
+
+static const char* kImmediateFS = R"glsl(#version 300 es
+precision mediump float;
+uniform sampler2D uTexture;
+uniform bool uTextured;
+in vec4 vColor;
+in vec4 vTexCoord;
+out vec4 fragColor;
+void main() {
+    fragColor = uTextured ? vColor * texture(uTexture, vTexCoord.xy / vTexCoord.w) : vColor;
+}
+)glsl";
+
+namespace {
+    // Attribute and primitive state fed by glBegin/glEnd and glVertex*. There
+    // is one for rendering and one for the display list being compiled.
+    struct ImmediateInput {
+        immediate_vertex_t current = {{0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f},
+                                      {0.0f, 0.0f, 1.0f}};
+        bool inBegin = false;
+        GLenum mode = GL_POINTS;
+        // Vertices of the primitive being specified
+        std::vector<immediate_vertex_t> primitive;
+
+        // List compilation only: attributes set since glNewList, attributes
+        // changed since they were last recorded, and attributes the current
+        // primitive takes from the state at replay
+        GLbitfield setMask = 0;
+        GLbitfield dirtyMask = 0;
+        GLbitfield inheritMask = 0;
+    };
+
+    struct ImmediateState {
+        ImmediateInput live;
+        ImmediateInput compile;
+        bool texture2d = false;
+
+        // Converted vertices waiting to be drawn, all of batchMode
+        std::vector<immediate_vertex_t> batch;
+        GLenum batchMode = GL_POINTS;
+        bool batchTextured = false;
+        // Converted primitive handed to the display list being compiled
+        std::vector<immediate_vertex_t> compiled;
+
+        GLuint program = 0;
+        GLint locMVP = -1;
+        GLint locTexMatrix = -1;
+        // g_ff_matrix_serial of the matrices last uploaded to the program
+        uint32_t matrixSerial = 0;
+        GLint locTextured = -1;
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        // Next free vertex in the streaming VBO
+        size_t vboCursor = 0;
+    };
+
+    ImmediateState g_immediate;
+
+    // Runs f on the input state(s) the current call applies to: the list
+    // being compiled, rendering, or both for GL_COMPILE_AND_EXECUTE.
+    template <typename F> inline void apply_input(F&& f) {
+        if (__builtin_expect(g_list_recording, 0)) {
+            f(g_immediate.compile);
+            if (!g_list_execute) return;
+        }
+        f(g_immediate.live);
+    }
+
+    GLuint compile_shader(GLenum type, const char* src) {
+        GLuint shader = GLES.glCreateShader(type);
+        GLES.glShaderSource(shader, 1, &src, nullptr);
+        GLES.glCompileShader(shader);
+        GLint status = GL_FALSE;
+        GLES.glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+        if (status != GL_TRUE) {
+            char log[512];
+            GLES.glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            LOG_E("Immediate mode shader failed to compile:\n%s", log)
+        }
+        return shader;
+    }
+
+    // Points the attribute locations of the bound VAO at immediate_vertex_t
+    // records in the bound array buffer
+    void setup_vertex_layout() {
+        const GLsizei stride = sizeof(immediate_vertex_t);
+        GLES.glEnableVertexAttribArray(IMMEDIATE_ATTRIB_POSITION);
+        GLES.glVertexAttribPointer(IMMEDIATE_ATTRIB_POSITION, 4, GL_FLOAT, GL_FALSE, stride,
+                                   (const void*)offsetof(immediate_vertex_t, position));
+        GLES.glEnableVertexAttribArray(IMMEDIATE_ATTRIB_COLOR);
+        GLES.glVertexAttribPointer(IMMEDIATE_ATTRIB_COLOR, 4, GL_FLOAT, GL_FALSE, stride,
+                                   (const void*)offsetof(immediate_vertex_t, color));
+        GLES.glEnableVertexAttribArray(IMMEDIATE_ATTRIB_TEXCOORD);
+        GLES.glVertexAttribPointer(IMMEDIATE_ATTRIB_TEXCOORD, 4, GL_FLOAT, GL_FALSE, stride,
+                                   (const void*)offsetof(immediate_vertex_t, texcoord));
+        GLES.glEnableVertexAttribArray(IMMEDIATE_ATTRIB_NORMAL);
+        GLES.glVertexAttribPointer(IMMEDIATE_ATTRIB_NORMAL, 3, GL_FLOAT, GL_FALSE, stride,
+                                   (const void*)offsetof(immediate_vertex_t, normal));
+    }
+
+    void init_immediate_objects() {
+        auto& s = g_immediate;
+        if (s.program) return;
+        StateScope scope(STATE_SCOPE_PROGRAM | STATE_SCOPE_VERTEX_ARRAY | STATE_SCOPE_ARRAY_BUFFER);
+
+        GLuint vs = compile_shader(GL_VERTEX_SHADER, kImmediateVS);
+        GLuint fs = compile_shader(GL_FRAGMENT_SHADER, kImmediateFS);
+        s.program = GLES.glCreateProgram();
+        GLES.glAttachShader(s.program, vs);
+        GLES.glAttachShader(s.program, fs);
+        GLES.glLinkProgram(s.program);
+        GLES.glDeleteShader(vs);
+        GLES.glDeleteShader(fs);
+
+        s.locMVP = GLES.glGetUniformLocation(s.program, "uMVP");
+        s.locTexMatrix = GLES.glGetUniformLocation(s.program, "uTexMatrix");
+        s.locTextured = GLES.glGetUniformLocation(s.program, "uTextured");
+        GLES.glUseProgram(s.program);
+        GLES.glUniform1i(GLES.glGetUniformLocation(s.program, "uTexture"), 0);
+
+        GLES.glGenVertexArrays(1, &s.vao);
+        GLES.glGenBuffers(1, &s.vbo);
+        GLES.glBindVertexArray(s.vao);
+        GLES.glBindBuffer(GL_ARRAY_BUFFER, s.vbo);
+        GLES.glBufferData(GL_ARRAY_BUFFER, IMMEDIATE_VBO_SIZE, nullptr, GL_STREAM_DRAW);
+        setup_vertex_layout();
+        CHECK_GL_ERROR
+    }
+
+    // Uses the generated program unless the application has its own bound.
+    // Call inside a StateScope covering STATE_SCOPE_PROGRAM.
+    void use_draw_program(bool textured) {
+        auto& s = g_immediate;
+        if (gl_state->current_program != 0) return;
+        GLES.glUseProgram(s.program);
+        GLES.glUniform1i(s.locTextured, textured ? 1 : 0);
+        if (s.matrixSerial != g_ff_matrix_serial) {
+            s.matrixSerial = g_ff_matrix_serial;
+            GLES.glUniformMatrix4fv(s.locMVP, 1, GL_FALSE, ff_mvp_matrix());
+            GLES.glUniformMatrix4fv(s.locTexMatrix, 1, GL_FALSE, ff_texture_matrix(0));
+        }
+    }
+
+    // Copies count vertices into the streaming VBO and returns the index of
+    // the first one. The buffer is orphaned when it runs out, so the driver
+    // never has to wait for draws still reading the old contents.
+    size_t stream_vertices(const immediate_vertex_t* vertices, size_t count) {
+        auto& s = g_immediate;
+        GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        if (s.vboCursor + count > IMMEDIATE_VBO_VERTICES) {
+            GLES.glBufferData(GL_ARRAY_BUFFER, IMMEDIATE_VBO_SIZE, nullptr, GL_STREAM_DRAW);
+            s.vboCursor = 0;
+        }
+        const size_t first = s.vboCursor;
+        const size_t bytes = count * sizeof(immediate_vertex_t);
+        void* dst =
+            GLES.glMapBufferRange(GL_ARRAY_BUFFER, (GLintptr)(first * sizeof(immediate_vertex_t)), bytes, access);
+        if (dst) {
+            memcpy(dst, vertices, bytes);
+            GLES.glUnmapBuffer(GL_ARRAY_BUFFER);
+        } else {
+            GLES.glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)(first * sizeof(immediate_vertex_t)), bytes, vertices);
+        }
+        s.vboCursor += count;
+        return first;
+    }
+
+    void draw_batch() {
+        auto& s = g_immediate;
+        if (s.batch.empty()) return;
+        init_immediate_objects();
+
+        StateScope scope(STATE_SCOPE_PROGRAM | STATE_SCOPE_VERTEX_ARRAY | STATE_SCOPE_ARRAY_BUFFER);
+        use_draw_program(s.batchTextured);
+        GLES.glBindVertexArray(s.vao);
+        GLES.glBindBuffer(GL_ARRAY_BUFFER, s.vbo);
+
+        // Keep primitives whole when a batch does not fit the VBO at once
+        const size_t perPrimitive = s.batchMode == GL_TRIANGLES ? 3 : s.batchMode == GL_LINES ? 2 : 1;
+        const size_t maxChunk = IMMEDIATE_VBO_VERTICES / perPrimitive * perPrimitive;
+        for (size_t done = 0; done < s.batch.size();) {
+            size_t count = std::min(s.batch.size() - done, maxChunk);
+            size_t first = stream_vertices(s.batch.data() + done, count);
+            GLES.glDrawArrays(s.batchMode, (GLint)first, (GLsizei)count);
+            done += count;
+        }
+        LOG_D("Immediate mode: drew %zu vertices as %s", s.batch.size(), glEnumToString(s.batchMode))
+
+        s.batch.clear();
+        CHECK_GL_ERROR
+    }
+
+    // Appends the vertices at the given primitive indices to out
+    inline void emit(std::vector<immediate_vertex_t>& out, const immediate_vertex_t* v, size_t a, size_t b,
+                     size_t c) {
+        out.push_back(v[a]);
+        out.push_back(v[b]);
+        out.push_back(v[c]);
+    }
+
+    // Converts the finished primitive to points, lines or triangles
+    void convert_primitive(GLenum mode, const std::vector<immediate_vertex_t>& prim,
+                           std::vector<immediate_vertex_t>& out) {
+        const immediate_vertex_t* v = prim.data();
+        const size_t n = prim.size();
+        switch (mode) {
+        case GL_POINTS:
+        case GL_LINES:
+        case GL_TRIANGLES: {
+            const size_t per = mode == GL_TRIANGLES ? 3 : mode == GL_LINES ? 2 : 1;
+            out.insert(out.end(), v, v + n / per * per);
+            break;
+        }
+        case GL_LINE_STRIP:
+        case GL_LINE_LOOP:
+            for (size_t i = 0; i + 1 < n; ++i) {
+                out.push_back(v[i]);
+                out.push_back(v[i + 1]);
+            }
+            if (mode == GL_LINE_LOOP && n > 2) {
+                out.push_back(v[n - 1]);
+                out.push_back(v[0]);
+            }
+            break;
+        case GL_TRIANGLE_STRIP:
+            // Swap the first two vertices of every other triangle to keep the winding
+            for (size_t i = 0; i + 2 < n; ++i) {
+                if (i & 1)
+                    emit(out, v, i + 1, i, i + 2);
+                else
+                    emit(out, v, i, i + 1, i + 2);
+            }
+            break;
+        case GL_TRIANGLE_FAN:
+        case GL_POLYGON:
+            for (size_t i = 1; i + 1 < n; ++i)
+                emit(out, v, 0, i, i + 1);
+            break;
+        case GL_QUADS:
+            for (size_t i = 0; i + 3 < n; i += 4) {
+                emit(out, v, i, i + 1, i + 2);
+                emit(out, v, i, i + 2, i + 3);
+            }
+            break;
+        case GL_QUAD_STRIP:
+            // Quad i is vertices 2i, 2i+1, 2i+3, 2i+2 in winding order
+            for (size_t i = 0; i + 3 < n; i += 2) {
+                emit(out, v, i, i + 1, i + 3);
+                emit(out, v, i, i + 3, i + 2);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    GLenum batch_mode_for(GLenum mode) {
+        switch (mode) {
+        case GL_POINTS:
+            return GL_POINTS;
+        case GL_LINES:
+        case GL_LINE_STRIP:
+        case GL_LINE_LOOP:
+            return GL_LINES;
+        default:
+            return GL_TRIANGLES;
+        }
+    }
+
+    void end_live(ImmediateInput& in) {
+        auto& s = g_immediate;
+        GLenum batchMode = batch_mode_for(in.mode);
+        if (g_immediate_pending && (batchMode != s.batchMode || s.texture2d != s.batchTextured)) immediate_flush_batch();
+        s.batchMode = batchMode;
+        s.batchTextured = s.texture2d;
+        convert_primitive(in.mode, in.primitive, s.batch);
+        g_immediate_pending = !s.batch.empty();
+
+        // An application program may take uniforms between pairs that we do not see
+        if (gl_state->current_program != 0 || s.batch.size() >= IMMEDIATE_BATCH_VERTICES) immediate_flush_batch();
+    }
+
+    void end_compile(ImmediateInput& in) {
+        auto& out = g_immediate.compiled;
+        out.clear();
+        convert_primitive(in.mode, in.primitive, out);
+        if (!out.empty()) list_record_primitive(batch_mode_for(in.mode), in.inheritMask, out.data(), out.size());
+    }
+
+    inline void set_attrib(ImmediateInput& in, GLuint attrib, GLfloat* dst, const GLfloat* v, int n) {
+        memcpy(dst, v, n * sizeof(GLfloat));
+        in.setMask |= 1u << attrib;
+        in.dirtyMask |= 1u << attrib;
+    }
+
+    inline void immediate_vertex(GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+        apply_input([=](ImmediateInput& in) {
+            if (!in.inBegin) return;
+            // Attributes the list has not set yet come from the state at replay
+            if (in.primitive.empty()) in.inheritMask = IMMEDIATE_INHERITABLE_ATTRIBS & ~in.setMask;
+            in.current.position[0] = x;
+            in.current.position[1] = y;
+            in.current.position[2] = z;
+            in.current.position[3] = w;
+            in.primitive.push_back(in.current);
+        });
+    }
+
+    inline void immediate_color(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+        const GLfloat v[4] = {r, g, b, a};
+        apply_input([&](ImmediateInput& in) { set_attrib(in, IMMEDIATE_ATTRIB_COLOR, in.current.color, v, 4); });
+    }
+
+    inline void immediate_texcoord(GLfloat s, GLfloat t, GLfloat r, GLfloat q) {
+        const GLfloat v[4] = {s, t, r, q};
+        apply_input(
+            [&](ImmediateInput& in) { set_attrib(in, IMMEDIATE_ATTRIB_TEXCOORD, in.current.texcoord, v, 4); });
+    }
+
+    inline void immediate_normal(GLfloat x, GLfloat y, GLfloat z) {
+        const GLfloat v[3] = {x, y, z};
+        apply_input([&](ImmediateInput& in) { set_attrib(in, IMMEDIATE_ATTRIB_NORMAL, in.current.normal, v, 3); });
+    }
+
+    GLfloat* attrib_values(immediate_vertex_t& v, GLuint attrib) {
+        switch (attrib) {
+        case IMMEDIATE_ATTRIB_COLOR:
+            return v.color;
+        case IMMEDIATE_ATTRIB_TEXCOORD:
+            return v.texcoord;
+        case IMMEDIATE_ATTRIB_NORMAL:
+            return v.normal;
+        default:
+            return v.position;
+        }
+    }
+} // namespace
+
+void immediate_flush_batch() {
+    g_immediate_pending = false;
+    draw_batch();
+}
+
+bool immediate_in_begin() {
+    return g_immediate.live.inBegin;
+}
+
+void immediate_set_texture_2d(bool enabled) {
+    if (g_immediate.texture2d == enabled) return;
+    flush_immediate();
+    g_immediate.texture2d = enabled;
+}
+
+bool immediate_texture_2d_enabled() {
+    return g_immediate.texture2d;
+}
+
+const GLfloat* immediate_current_color() {
+    return g_immediate.live.current.color;
+}
+
+const GLfloat* immediate_current_texcoord() {
+    return g_immediate.live.current.texcoord;
+}
+
+const GLfloat* immediate_current_normal() {
+    return g_immediate.live.current.normal;
+}
+
+void immediate_set_attrib(GLuint attrib, const GLfloat* values) {
+    auto& in = g_immediate.live;
+    set_attrib(in, attrib, attrib_values(in.current, attrib), values, attrib == IMMEDIATE_ATTRIB_NORMAL ? 3 : 4);
+}
+
+void immediate_list_begin() {
+    auto& in = g_immediate.compile;
+    in.current = g_immediate.live.current;
+    in.inBegin = false;
+    in.primitive.clear();
+    in.setMask = 0;
+    in.dirtyMask = 0;
+}
+
+GLbitfield immediate_list_take_dirty(const immediate_vertex_t** values) {
+    auto& in = g_immediate.compile;
+    GLbitfield dirty = in.dirtyMask;
+    in.dirtyMask = 0;
+    *values = &in.current;
+    return dirty;
+}
+
+void immediate_list_forget_attribs() {
+    g_immediate.compile.setMask = 0;
+}
+
+GLuint immediate_create_vao(GLuint vbo) {
+    StateScope scope(STATE_SCOPE_VERTEX_ARRAY | STATE_SCOPE_ARRAY_BUFFER);
+    GLuint vao = 0;
+    GLES.glGenVertexArrays(1, &vao);
+    GLES.glBindVertexArray(vao);
+    GLES.glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    setup_vertex_layout();
+    return vao;
+}
+
+void immediate_draw_baked(immediate_baked_t& baked, GLenum mode, GLint first, GLsizei count, GLbitfield inherit) {
+    flush_immediate();
+    init_immediate_objects();
+    auto& live = g_immediate.live;
+
+    StateScope scope(STATE_SCOPE_PROGRAM | STATE_SCOPE_VERTEX_ARRAY);
+    use_draw_program(g_immediate.texture2d);
+    GLES.glBindVertexArray(baked.vao);
+    // Inherited attributes are read as constants from the current values
+    for (GLbitfield changed = inherit ^ baked.inherited; changed; changed &= changed - 1) {
+        GLuint attrib = __builtin_ctz(changed);
+        if (inherit & (1u << attrib))
+            GLES.glDisableVertexAttribArray(attrib);
+        else
+            GLES.glEnableVertexAttribArray(attrib);
+    }
+    baked.inherited = inherit;
+    for (GLbitfield bits = inherit; bits; bits &= bits - 1) {
+        GLuint attrib = __builtin_ctz(bits);
+        const GLfloat* v = attrib_values(live.current, attrib);
+        if (attrib == IMMEDIATE_ATTRIB_NORMAL)
+            GLES.glVertexAttrib3fv(attrib, v);
+        else
+            GLES.glVertexAttrib4fv(attrib, v);
+    }
+    GLES.glDrawArrays(mode, first, count);
+    CHECK_GL_ERROR
+}
+
+void glBegin(GLenum mode) {
+    LOG()
+    MG_TRACE_ARGS(glBegin, mode)
+    LOG_D("glBegin, mode = %s", glEnumToString(mode))
+    if (mode > GL_POLYGON) {
+        LOG_E("glBegin: invalid mode %s", glEnumToString(mode))
+        return;
+    }
+    apply_input([=](ImmediateInput& in) {
+        if (in.inBegin) {
+            LOG_E("glBegin called inside glBegin/glEnd")
+            return;
+        }
+        in.inBegin = true;
+        in.mode = mode;
+        in.primitive.clear();
+    });
+}
+
+void glEnd() {
+    LOG()
+    MG_TRACE_ARGS(glEnd)
+    apply_input([=](ImmediateInput& in) {
+        if (!in.inBegin) {
+            LOG_E("glEnd called outside glBegin/glEnd")
+            return;
+        }
+        in.inBegin = false;
+        LOG_D("glEnd, %zu vertices of %s", in.primitive.size(), glEnumToString(in.mode))
+        if (in.primitive.empty()) return;
+        if (&in == &g_immediate.compile)
+            end_compile(in);
+        else
+            end_live(in);
+        in.primitive.clear();
+    });
+}
+
+#define IMMEDIATE_VERTEX_FUNCS(suffix, type)                                                                           \
+    void glVertex2##suffix(type x, type y) {                                                                           \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glVertex2##suffix, x, y)                                                                         \
+        immediate_vertex((GLfloat)x, (GLfloat)y, 0.0f, 1.0f);                                                          \
+    }                                                                                                                  \
+    void glVertex3##suffix(type x, type y, type z) {                                                                   \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glVertex3##suffix, x, y, z)                                                                      \
+        immediate_vertex((GLfloat)x, (GLfloat)y, (GLfloat)z, 1.0f);                                                    \
+    }                                                                                                                  \
+    void glVertex4##suffix(type x, type y, type z, type w) {                                                           \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glVertex4##suffix, x, y, z, w)                                                                   \
+        immediate_vertex((GLfloat)x, (GLfloat)y, (GLfloat)z, (GLfloat)w);                                              \
+    }                                                                                                                  \
+    void glVertex2##suffix##v(const type* v) {                                                                         \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glVertex2##suffix##v, v)                                                                         \
+        immediate_vertex((GLfloat)v[0], (GLfloat)v[1], 0.0f, 1.0f);                                                    \
+    }                                                                                                                  \
+    void glVertex3##suffix##v(const type* v) {                                                                         \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glVertex3##suffix##v, v)                                                                         \
+        immediate_vertex((GLfloat)v[0], (GLfloat)v[1], (GLfloat)v[2], 1.0f);                                           \
+    }                                                                                                                  \
+    void glVertex4##suffix##v(const type* v) {                                                                         \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glVertex4##suffix##v, v)                                                                         \
+        immediate_vertex((GLfloat)v[0], (GLfloat)v[1], (GLfloat)v[2], (GLfloat)v[3]);                                  \
+    }
+
+IMMEDIATE_VERTEX_FUNCS(d, GLdouble)
+IMMEDIATE_VERTEX_FUNCS(f, GLfloat)
+IMMEDIATE_VERTEX_FUNCS(i, GLint)
+IMMEDIATE_VERTEX_FUNCS(s, GLshort)
+
+#define IMMEDIATE_TEXCOORD_FUNCS(suffix, type)                                                                         \
+    void glTexCoord1##suffix(type s) {                                                                                 \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glTexCoord1##suffix, s)                                                                          \
+        immediate_texcoord((GLfloat)s, 0.0f, 0.0f, 1.0f);                                                              \
+    }                                                                                                                  \
+    void glTexCoord2##suffix(type s, type t) {                                                                         \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glTexCoord2##suffix, s, t)                                                                       \
+        immediate_texcoord((GLfloat)s, (GLfloat)t, 0.0f, 1.0f);                                                        \
+    }                                                                                                                  \
+    void glTexCoord3##suffix(type s, type t, type r) {                                                                 \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glTexCoord3##suffix, s, t, r)                                                                    \
+        immediate_texcoord((GLfloat)s, (GLfloat)t, (GLfloat)r, 1.0f);                                                  \
+    }                                                                                                                  \
+    void glTexCoord4##suffix(type s, type t, type r, type q) {                                                         \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glTexCoord4##suffix, s, t, r, q)                                                                 \
+        immediate_texcoord((GLfloat)s, (GLfloat)t, (GLfloat)r, (GLfloat)q);                                            \
+    }                                                                                                                  \
+    void glTexCoord1##suffix##v(const type* v) {                                                                       \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glTexCoord1##suffix##v, v)                                                                       \
+        immediate_texcoord((GLfloat)v[0], 0.0f, 0.0f, 1.0f);                                                           \
+    }                                                                                                                  \
+    void glTexCoord2##suffix##v(const type* v) {                                                                       \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glTexCoord2##suffix##v, v)                                                                       \
+        immediate_texcoord((GLfloat)v[0], (GLfloat)v[1], 0.0f, 1.0f);                                                  \
+    }                                                                                                                  \
+    void glTexCoord3##suffix##v(const type* v) {                                                                       \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glTexCoord3##suffix##v, v)                                                                       \
+        immediate_texcoord((GLfloat)v[0], (GLfloat)v[1], (GLfloat)v[2], 1.0f);                                         \
+    }                                                                                                                  \
+    void glTexCoord4##suffix##v(const type* v) {                                                                       \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glTexCoord4##suffix##v, v)                                                                       \
+        immediate_texcoord((GLfloat)v[0], (GLfloat)v[1], (GLfloat)v[2], (GLfloat)v[3]);                                \
+    }
+
+IMMEDIATE_TEXCOORD_FUNCS(d, GLdouble)
+IMMEDIATE_TEXCOORD_FUNCS(f, GLfloat)
+IMMEDIATE_TEXCOORD_FUNCS(i, GLint)
+IMMEDIATE_TEXCOORD_FUNCS(s, GLshort)
+
+// Integer colors and normals map their full range to [0, 1] or [-1, 1]
+#define IMMEDIATE_COLOR_FUNCS(suffix, type, scale)                                                                     \
+    void glColor3##suffix(type r, type g, type b) {                                                                    \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glColor3##suffix, r, g, b)                                                                       \
+        immediate_color((GLfloat)r * (scale), (GLfloat)g * (scale), (GLfloat)b * (scale), 1.0f);                       \
+    }                                                                                                                  \
+    void glColor4##suffix(type r, type g, type b, type a) {                                                            \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glColor4##suffix, r, g, b, a)                                                                    \
+        immediate_color((GLfloat)r * (scale), (GLfloat)g * (scale), (GLfloat)b * (scale), (GLfloat)a * (scale));       \
+    }                                                                                                                  \
+    void glColor3##suffix##v(const type* v) {                                                                          \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glColor3##suffix##v, v)                                                                          \
+        immediate_color((GLfloat)v[0] * (scale), (GLfloat)v[1] * (scale), (GLfloat)v[2] * (scale), 1.0f);              \
+    }                                                                                                                  \
+    void glColor4##suffix##v(const type* v) {                                                                          \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glColor4##suffix##v, v)                                                                          \
+        immediate_color((GLfloat)v[0] * (scale), (GLfloat)v[1] * (scale), (GLfloat)v[2] * (scale),                     \
+                        (GLfloat)v[3] * (scale));                                                                      \
+    }
+
+IMMEDIATE_COLOR_FUNCS(b, GLbyte, 1.0f / 127.0f)
+IMMEDIATE_COLOR_FUNCS(d, GLdouble, 1.0f)
+IMMEDIATE_COLOR_FUNCS(f, GLfloat, 1.0f)
+IMMEDIATE_COLOR_FUNCS(i, GLint, 1.0f / 2147483647.0f)
+IMMEDIATE_COLOR_FUNCS(s, GLshort, 1.0f / 32767.0f)
+IMMEDIATE_COLOR_FUNCS(ub, GLubyte, 1.0f / 255.0f)
+IMMEDIATE_COLOR_FUNCS(ui, GLuint, 1.0f / 4294967295.0f)
+IMMEDIATE_COLOR_FUNCS(us, GLushort, 1.0f / 65535.0f)
+
+#define IMMEDIATE_NORMAL_FUNCS(suffix, type, scale)                                                                    \
+    void glNormal3##suffix(type x, type y, type z) {                                                                   \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glNormal3##suffix, x, y, z)                                                                      \
+        immediate_normal((GLfloat)x * (scale), (GLfloat)y * (scale), (GLfloat)z * (scale));                            \
+    }                                                                                                                  \
+    void glNormal3##suffix##v(const type* v) {                                                                         \
+        LOG()                                                                                                          \
+        MG_TRACE_ARGS(glNormal3##suffix##v, v)                                                                         \
+        immediate_normal((GLfloat)v[0] * (scale), (GLfloat)v[1] * (scale), (GLfloat)v[2] * (scale));                   \
+    }
+
+IMMEDIATE_NORMAL_FUNCS(b, GLbyte, 1.0f / 127.0f)
+IMMEDIATE_NORMAL_FUNCS(d, GLdouble, 1.0f)
+IMMEDIATE_NORMAL_FUNCS(f, GLfloat, 1.0f)
+IMMEDIATE_NORMAL_FUNCS(i, GLint, 1.0f / 2147483647.0f)
+IMMEDIATE_NORMAL_FUNCS(s, GLshort, 1.0f / 32767.0f)
@@ -0,0 +1,108 @@
+// MobileGlues - gl/immediate.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_IMMEDIATE_H
+#define MOBILEGLUES_IMMEDIATE_H
+
+#include "../includes.h"
+#include <GL/gl.h>
+#include "glcorearb.h"
+
+// Immediate mode (glBegin/glEnd) emulation.
+//
+// Vertices are collected in a client-side arena. glEnd converts the
+// primitive to points, lines or triangles and appends it to a batch, so
+// consecutive glBegin/glEnd pairs of the same kind are drawn together. The
+// batch is streamed into a VBO and drawn with a generated shader when the
+// kind changes, when it grows large, or at the next call that changes how it
+// would render (see flush_immediate).
+//
+// Attributes use fixed locations: 0 position, 1 color, 2 texture coordinate,
+// 3 normal. When the application has a program bound, it is drawn with that
+// program at those locations, and each glEnd is flushed on its own.
+//
+// The glVertex*, glColor*, glTexCoord* and glNormal* entry points are
+// declared by GL/gl.h.
+
+#define IMMEDIATE_ATTRIB_POSITION 0
+#define IMMEDIATE_ATTRIB_COLOR 1
+#define IMMEDIATE_ATTRIB_TEXCOORD 2
+#define IMMEDIATE_ATTRIB_NORMAL 3
+
+// Attributes a display list may leave to the state at replay
+#define IMMEDIATE_INHERITABLE_ATTRIBS                                                                                  \
+    ((1u << IMMEDIATE_ATTRIB_COLOR) | (1u << IMMEDIATE_ATTRIB_TEXCOORD) | (1u << IMMEDIATE_ATTRIB_NORMAL))
+
+struct immediate_vertex_t {
+    GLfloat position[4];
+    GLfloat color[4];
+    GLfloat texcoord[4];
+    GLfloat normal[3];
+};
+
+// Geometry baked into a display list, in the immediate_vertex_t layout
+struct immediate_baked_t {
+    GLuint vbo = 0;
+    GLuint vao = 0;
+    // Attribute arrays currently disabled on vao in favour of constants
+    GLbitfield inherited = 0;
+};
+
+// Whether a batch is waiting to be drawn
+extern bool g_immediate_pending;
+
+void immediate_flush_batch();
+
+// Draws the pending batch. Call it before anything that changes state the
+// batch would be drawn with, or that reads what it would draw.
+inline void flush_immediate() {
+    if (__builtin_expect(g_immediate_pending, 0)) immediate_flush_batch();
+}
+
+// Whether we are between glBegin and glEnd
+bool immediate_in_begin();
+
+// Fixed-function GL_TEXTURE_2D enable, which GLES does not have
+void immediate_set_texture_2d(bool enabled);
+bool immediate_texture_2d_enabled();
+
+// Current attribute values, as glGet(GL_CURRENT_*) reports them
+const GLfloat* immediate_current_color();
+const GLfloat* immediate_current_texcoord();
+const GLfloat* immediate_current_normal();
+
+// Sets a current attribute (IMMEDIATE_ATTRIB_*), as a display list replays it
+void immediate_set_attrib(GLuint attrib, const GLfloat* values);
+
+// Display list compilation. The list starts from the current attributes;
+// take_dirty returns the attributes the list changed since the last call, and
+// forget_attribs makes later primitives inherit all attributes again (after a
+// nested glCallList, whose effect is not known until replay).
+void immediate_list_begin();
+GLbitfield immediate_list_take_dirty(const immediate_vertex_t** values);
+void immediate_list_forget_attribs();
+
+// Creates a VAO reading immediate_vertex_t records from vbo
+GLuint immediate_create_vao(GLuint vbo);
+
+// Draws baked vertices like a glBegin/glEnd pair would be drawn. Attributes
+// in inherit take the current values instead of the baked ones.
+void immediate_draw_baked(immediate_baked_t& baked, GLenum mode, GLint first, GLsizei count, GLbitfield inherit);
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    GLAPI GLAPIENTRY void glBegin(GLenum mode);
+    GLAPI GLAPIENTRY void glEnd();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOBILEGLUES_IMMEDIATE_H
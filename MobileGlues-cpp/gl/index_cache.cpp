@@ -0,0 +1,212 @@
+// MobileGlues - gl/index_cache.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "index_cache.h"
+#include "buffer.h"
+#include "glsl/digest.h"
+
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define DEBUG 0
+
+#define INDEX_CACHE_MAX_BYTES (16 * 1024 * 1024)
+#define INDEX_CACHE_MAX_ENTRIES 4096
+#define INDEX_CACHE_POOL_SIZE 64
+#define INDEX_CACHE_MIN_BUFFER_SIZE 256
+
+void add_base_vertex(GLenum type, const void* src, void* dst, GLsizei count, GLint basevertex) {
+    const size_t n = count > 0 ? (size_t)count : 0;
+    size_t i = 0;
+    switch (type) {
+    case GL_UNSIGNED_INT: {
+        const auto* s = static_cast<const uint32_t*>(src);
+        auto* d = static_cast<uint32_t*>(dst);
+        const auto base = static_cast<uint32_t>(basevertex);
+#if defined(__ARM_NEON)
+        const uint32x4_t vbase = vdupq_n_u32(base);
+        for (; i + 4 <= n; i += 4)
+            vst1q_u32(d + i, vaddq_u32(vld1q_u32(s + i), vbase));
+#elif defined(__SSE2__)
+        const __m128i vbase = _mm_set1_epi32((int)base);
+        for (; i + 4 <= n; i += 4)
+            _mm_storeu_si128((__m128i*)(d + i), _mm_add_epi32(_mm_loadu_si128((const __m128i*)(s + i)), vbase));
+#endif
+        for (; i < n; ++i)
+            d[i] = s[i] + base;
+        break;
+    }
+    case GL_UNSIGNED_SHORT: {
+        const auto* s = static_cast<const uint16_t*>(src);
+        auto* d = static_cast<uint16_t*>(dst);
+        const auto base = static_cast<uint16_t>(basevertex);
+#if defined(__ARM_NEON)
+        const uint16x8_t vbase = vdupq_n_u16(base);
+        for (; i + 8 <= n; i += 8)
+            vst1q_u16(d + i, vaddq_u16(vld1q_u16(s + i), vbase));
+#elif defined(__SSE2__)
+        const __m128i vbase = _mm_set1_epi16((short)base);
+        for (; i + 8 <= n; i += 8)
+            _mm_storeu_si128((__m128i*)(d + i), _mm_add_epi16(_mm_loadu_si128((const __m128i*)(s + i)), vbase));
+#endif
+        for (; i < n; ++i)
+            d[i] = static_cast<uint16_t>(s[i] + base);
+        break;
+    }
+    case GL_UNSIGNED_BYTE: {
+        const auto* s = static_cast<const uint8_t*>(src);
+        auto* d = static_cast<uint8_t*>(dst);
+        const auto base = static_cast<uint8_t>(basevertex);
+#if defined(__ARM_NEON)
+        const uint8x16_t vbase = vdupq_n_u8(base);
+        for (; i + 16 <= n; i += 16)
+            vst1q_u8(d + i, vaddq_u8(vld1q_u8(s + i), vbase));
+#elif defined(__SSE2__)
+        const __m128i vbase = _mm_set1_epi8((char)base);
+        for (; i + 16 <= n; i += 16)
+            _mm_storeu_si128((__m128i*)(d + i), _mm_add_epi8(_mm_loadu_si128((const __m128i*)(s + i)), vbase));
+#endif
+        for (; i < n; ++i)
+            d[i] = static_cast<uint8_t>(s[i] + base);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+static size_t index_size(GLenum type) {
+    switch (type) {
+    case GL_UNSIGNED_INT:
+        return sizeof(GLuint);
+    case GL_UNSIGNED_SHORT:
+        return sizeof(GLushort);
+    case GL_UNSIGNED_BYTE:
+        return sizeof(GLubyte);
+    default:
+        return 0;
+    }
+}
+
+size_t BaseVertexIndexCache::KeyHash::operator()(const Key& key) const {
+    return static_cast<size_t>(digest::hash64(&key, sizeof(key)));
+}
+
+// Copies the source indices into `staging`. Leaves the source element
+// buffer, if any, bound.
+bool BaseVertexIndexCache::readSource(const Key& key, size_t bytes, const void* indices) {
+    staging.resize(bytes);
+    if (key.buffer == 0) {
+        memcpy(staging.data(), indices, bytes);
+        return true;
+    }
+
+    GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, find_real_bound_buffer(GL_ELEMENT_ARRAY_BUFFER_BINDING));
+    void* src = GLES.glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)indices, (GLsizeiptr)bytes, GL_MAP_READ_BIT);
+    if (!src) return false;
+    memcpy(staging.data(), src, bytes);
+    GLES.glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+    return true;
+}
+
+// Returns a buffer with room for `bytes`, bound to GL_ELEMENT_ARRAY_BUFFER.
+BaseVertexIndexCache::PooledBuffer BaseVertexIndexCache::acquireBuffer(size_t bytes) {
+    // Best fit from the pool, as long as it does not waste most of the buffer
+    auto best = pool.end();
+    for (auto it = pool.begin(); it != pool.end(); ++it) {
+        if (it->capacity >= bytes && it->capacity <= bytes * 4 &&
+            (best == pool.end() || it->capacity < best->capacity))
+            best = it;
+    }
+    if (best != pool.end()) {
+        PooledBuffer pooled = *best;
+        *best = pool.back();
+        pool.pop_back();
+        GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pooled.buffer);
+        return pooled;
+    }
+
+    PooledBuffer pooled{0, INDEX_CACHE_MIN_BUFFER_SIZE};
+    while (pooled.capacity < bytes)
+        pooled.capacity *= 2;
+    GLES.glGenBuffers(1, &pooled.buffer);
+    GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pooled.buffer);
+    GLES.glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)pooled.capacity, nullptr, GL_STATIC_DRAW);
+    return pooled;
+}
+
+void BaseVertexIndexCache::release(std::list<Entry>::iterator it) {
+    entries.erase(it->key);
+    cachedBytes -= it->capacity;
+    if (pool.size() < INDEX_CACHE_POOL_SIZE) {
+        pool.push_back({it->buffer, it->capacity});
+    } else {
+        GLES.glDeleteBuffers(1, &it->buffer);
+    }
+    lru.erase(it);
+}
+
+void BaseVertexIndexCache::evict() {
+    // Never evicts the newest entry, which the caller is about to draw from
+    while ((cachedBytes > INDEX_CACHE_MAX_BYTES || lru.size() > INDEX_CACHE_MAX_ENTRIES) && lru.size() > 1) {
+        release(lru.begin());
+    }
+}
+
+bool BaseVertexIndexCache::bind(GLsizei count, GLenum type, const void* indices, GLint basevertex,
+                                const void*& offset) {
+    const size_t bytes = (size_t)count * index_size(type);
+    if (bytes == 0) return false;
+    offset = nullptr;
+
+    const GLuint source = find_bound_buffer(GL_ELEMENT_ARRAY_BUFFER_BINDING);
+    const uint32_t generation = source ? get_buffer_generation(source) : BUFFER_GENERATION_VOLATILE;
+    const bool cacheable = generation != BUFFER_GENERATION_VOLATILE;
+    const Key key{(uint64_t)(uintptr_t)indices, source, (GLuint)count, type, basevertex};
+
+    if (cacheable) {
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            auto entry = it->second;
+            if (entry->generation == generation) {
+                lru.splice(lru.end(), lru, entry);
+                GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, entry->buffer);
+                return true;
+            }
+            LOG_D("BaseVertexIndexCache: source buffer %u changed, rewriting", source)
+            release(entry);
+        }
+    }
+
+    if (!readSource(key, bytes, indices)) return false;
+    add_base_vertex(type, staging.data(), staging.data(), count, basevertex);
+
+    if (!cacheable) {
+        if (!scratchBuffer) GLES.glGenBuffers(1, &scratchBuffer);
+        GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, scratchBuffer);
+        GLES.glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)bytes, staging.data(), GL_STREAM_DRAW);
+        return true;
+    }
+
+    PooledBuffer pooled = acquireBuffer(bytes);
+    GLES.glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, (GLsizeiptr)bytes, staging.data());
+    lru.push_back({key, generation, pooled.buffer, pooled.capacity});
+    entries[key] = std::prev(lru.end());
+    cachedBytes += pooled.capacity;
+    evict();
+    return true;
+}
+
+BaseVertexIndexCache& BaseVertexIndexCache::get_instance() {
+    static BaseVertexIndexCache s_cache;
+    return s_cache;
+}
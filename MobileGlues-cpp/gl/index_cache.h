@@ -0,0 +1,79 @@
+// MobileGlues - gl/index_cache.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_INDEX_CACHE_H
+#define MOBILEGLUES_INDEX_CACHE_H
+
+#include "../gles/loader.h"
+#include "mg.h"
+#include "../includes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+// dst[i] = src[i] + basevertex, wrapping in the index type like GL does.
+// src and dst may alias.
+void add_base_vertex(GLenum type, const void* src, void* dst, GLsizei count, GLint basevertex);
+
+// Emulates glDrawElementsBaseVertex on drivers without it by drawing from a
+// copy of the indices with basevertex already added.
+// Copies of ranges from application element buffers are cached and reused
+// until buffer.cpp reports a write to the source buffer; indices from client
+// memory or volatile buffers are rewritten into a scratch buffer every time.
+class BaseVertexIndexCache {
+public:
+    // Binds a GL_ELEMENT_ARRAY_BUFFER holding the rebased indices and returns
+    // the offset to pass to glDrawElements, or false if the source could not
+    // be read. The caller restores the application's element buffer.
+    bool bind(GLsizei count, GLenum type, const void* indices, GLint basevertex, const void*& offset);
+
+    static BaseVertexIndexCache& get_instance();
+
+private:
+    struct Key {
+        uint64_t offset;
+        GLuint buffer;
+        GLuint count;
+        GLenum type;
+        GLint basevertex;
+
+        bool operator==(const Key& other) const {
+            return offset == other.offset && buffer == other.buffer && count == other.count &&
+                   type == other.type && basevertex == other.basevertex;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+    struct Entry {
+        Key key;
+        uint32_t generation;
+        GLuint buffer;
+        size_t capacity;
+    };
+    struct PooledBuffer {
+        GLuint buffer;
+        size_t capacity;
+    };
+
+    bool readSource(const Key& key, size_t bytes, const void* indices);
+    PooledBuffer acquireBuffer(size_t bytes);
+    void release(std::list<Entry>::iterator it);
+    void evict();
+
+    std::list<Entry> lru;
+    UnorderedMap<Key, std::list<Entry>::iterator, KeyHash> entries;
+    std::vector<PooledBuffer> pool;
+    size_t cachedBytes = 0;
+
+    GLuint scratchBuffer = 0;
+    std::vector<uint8_t> staging;
+};
+
+#endif // MOBILEGLUES_INDEX_CACHE_H
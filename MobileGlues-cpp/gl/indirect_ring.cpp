@@ -0,0 +1,164 @@
+// MobileGlues - gl/indirect_ring.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "indirect_ring.h"
+#include "buffer.h"
+
+#define DEBUG 0
+
+#define INDIRECT_RING_MIN_SIZE (256 * 1024)
+// Keep at least this many of the largest request in flight before wrapping
+#define INDIRECT_RING_MIN_SEGMENTS 3
+// Submissions are fenced together per 1/INDIRECT_RING_FENCE_SEGMENTS of the ring
+#define INDIRECT_RING_FENCE_SEGMENTS 4
+#define INDIRECT_RING_WAIT_TIMEOUT_NS 1000000000ull
+
+// Retires everything in flight before the storage goes away: the persistent
+// mapping is released here, and fences are only deleted once they signaled.
+void IndirectRing::release() {
+    fenceOpenRange();
+    waitForRange(0, capacity);
+    if (buffer) {
+        if (persistentPtr) {
+            GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+            GLES.glUnmapBuffer(GL_DRAW_INDIRECT_BUFFER);
+        }
+        GLES.glDeleteBuffers(1, &buffer);
+    }
+    buffer = 0;
+    capacity = 0;
+    head = 0;
+    persistentPtr = nullptr;
+}
+
+// Leaves the new buffer bound to GL_DRAW_INDIRECT_BUFFER.
+void IndirectRing::reallocate(size_t minSize) {
+    release();
+
+    size_t size = INDIRECT_RING_MIN_SIZE;
+    while (size < minSize)
+        size *= 2;
+
+    GLES.glGenBuffers(1, &buffer);
+    GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+
+    if (g_gles_caps.GL_EXT_buffer_storage && GLES.glBufferStorageEXT) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLES.glBufferStorageEXT(GL_DRAW_INDIRECT_BUFFER, (GLsizeiptr)size, nullptr, flags);
+        persistentPtr = (uint8_t*)GLES.glMapBufferRange(GL_DRAW_INDIRECT_BUFFER, 0, (GLsizeiptr)size, flags);
+        if (!persistentPtr) {
+            LOG_W("IndirectRing: persistent mapping failed, falling back to per-draw mapping")
+            GLES.glDeleteBuffers(1, &buffer);
+            GLES.glGenBuffers(1, &buffer);
+            GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+        }
+    }
+    if (!persistentPtr) {
+        GLES.glBufferData(GL_DRAW_INDIRECT_BUFFER, (GLsizeiptr)size, nullptr, GL_STREAM_DRAW);
+    }
+
+    capacity = size;
+    head = 0;
+    LOG_D("IndirectRing: allocated %zu bytes (%s)", size, persistentPtr ? "persistent" : "mapped per draw")
+}
+
+// Waits until no in-flight submission overlaps [begin, end). Fences signal in
+// submission order, so only the newest overlapping one has to be waited on.
+void IndirectRing::waitForRange(size_t begin, size_t end) {
+    size_t last = fences.size();
+    for (size_t i = 0; i < fences.size(); ++i) {
+        if (fences[i].begin < end && begin < fences[i].end) last = i;
+    }
+    if (last == fences.size()) return;
+
+    GLenum result;
+    do {
+        result = GLES.glClientWaitSync(fences[last].sync, GL_SYNC_FLUSH_COMMANDS_BIT, INDIRECT_RING_WAIT_TIMEOUT_NS);
+    } while (result == GL_TIMEOUT_EXPIRED);
+    if (result == GL_WAIT_FAILED) LOG_E("IndirectRing: glClientWaitSync failed")
+
+    for (size_t i = 0; i <= last; ++i) {
+        GLES.glDeleteSync(fences.front().sync);
+        fences.pop_front();
+    }
+}
+
+draw_elements_indirect_command_t* IndirectRing::begin(GLsizei count, GLintptr& offset) {
+    const size_t bytes = (size_t)count * sizeof(draw_elements_indirect_command_t);
+
+    if (!buffer || bytes * INDIRECT_RING_MIN_SEGMENTS > capacity) {
+        reallocate(bytes * INDIRECT_RING_MIN_SEGMENTS);
+    } else {
+        GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+    }
+
+    // Commands never straddle the end of the ring
+    if (head + bytes > capacity) head = 0;
+    // Leaving the segment of the unfenced submissions, or wrapping, closes them
+    const size_t segment = capacity / INDIRECT_RING_FENCE_SEGMENTS;
+    if (openEnd > openBegin && (head < openEnd || (head + bytes - 1) / segment != openBegin / segment)) {
+        fenceOpenRange();
+    }
+    waitForRange(head, head + bytes);
+
+    pendingBegin = head;
+    pendingEnd = head + bytes;
+    head = pendingEnd;
+    offset = (GLintptr)pendingBegin;
+
+    if (persistentPtr) return reinterpret_cast<draw_elements_indirect_command_t*>(persistentPtr + pendingBegin);
+
+    void* ptr = GLES.glMapBufferRange(GL_DRAW_INDIRECT_BUFFER, (GLintptr)pendingBegin, (GLsizeiptr)bytes,
+                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    mapped = ptr != nullptr;
+    return static_cast<draw_elements_indirect_command_t*>(ptr);
+}
+
+void IndirectRing::end() {
+    if (mapped) {
+        GLES.glUnmapBuffer(GL_DRAW_INDIRECT_BUFFER);
+        mapped = false;
+    }
+}
+
+void IndirectRing::submit() {
+    if (pendingEnd > pendingBegin) {
+        if (openEnd == openBegin) openBegin = pendingBegin;
+        openEnd = pendingEnd;
+        pendingBegin = pendingEnd = 0;
+    }
+
+    GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, find_real_bound_buffer(GL_DRAW_INDIRECT_BUFFER_BINDING));
+}
+
+// One fence covers every submission since the previous one
+void IndirectRing::fenceOpenRange() {
+    if (openEnd == openBegin) return;
+    GLsync sync = GLES.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (sync) fences.push_back({sync, openBegin, openEnd});
+    openBegin = openEnd = 0;
+}
+
+// Polls the oldest fences so light frames do not pile them up until the ring wraps
+void IndirectRing::retireSignaled() {
+    while (!fences.empty()) {
+        GLenum result = GLES.glClientWaitSync(fences.front().sync, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) break;
+        GLES.glDeleteSync(fences.front().sync);
+        fences.pop_front();
+    }
+}
+
+void IndirectRing::endFrame() {
+    retireSignaled();
+    fenceOpenRange();
+}
+
+IndirectRing& IndirectRing::get_instance() {
+    static IndirectRing s_ring;
+    return s_ring;
+}
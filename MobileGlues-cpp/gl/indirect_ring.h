@@ -0,0 +1,73 @@
+// MobileGlues - gl/indirect_ring.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_INDIRECT_RING_H
+#define MOBILEGLUES_INDIRECT_RING_H
+
+#include "multidraw.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+// Streaming storage for draw indirect commands.
+// One buffer is suballocated as a ring. Submissions are fenced together when
+// the ring moves on to the next segment and at the end of each frame, and a
+// range is only handed out again once its fence has signaled.
+// With GL_EXT_buffer_storage the buffer is mapped once, persistently and
+// coherently; otherwise each allocation maps its own range unsynchronized,
+// which the fences make safe.
+class IndirectRing {
+public:
+    IndirectRing() = default;
+
+    IndirectRing(const IndirectRing&) = delete;
+    IndirectRing& operator=(const IndirectRing&) = delete;
+
+    // Binds the ring to GL_DRAW_INDIRECT_BUFFER and returns room for `count`
+    // commands, or nullptr if the range could not be mapped. `offset` receives
+    // the byte offset to pass to the draw call.
+    draw_elements_indirect_command_t* begin(GLsizei count, GLintptr& offset);
+    // Must be called after writing the commands and before drawing
+    void end();
+    // Marks the range handed out by begin() as in flight and restores the
+    // application's indirect buffer binding from the CPU-side tracking in
+    // buffer.cpp.
+    void submit();
+    // Fences the submissions of the frame, called before eglSwapBuffers
+    void endFrame();
+
+    static IndirectRing& get_instance();
+
+private:
+    struct Fence {
+        GLsync sync;
+        size_t begin;
+        size_t end;
+    };
+
+    void reallocate(size_t minSize);
+    void release();
+    void waitForRange(size_t begin, size_t end);
+    void fenceOpenRange();
+    void retireSignaled();
+
+    GLuint buffer = 0;
+    size_t capacity = 0;
+    size_t head = 0;
+    uint8_t* persistentPtr = nullptr;
+    bool mapped = false;
+
+    size_t pendingBegin = 0;
+    size_t pendingEnd = 0;
+    // Submitted but not fenced yet
+    size_t openBegin = 0;
+    size_t openEnd = 0;
+    std::deque<Fence> fences;
+};
+
+#endif // MOBILEGLUES_INDIRECT_RING_H
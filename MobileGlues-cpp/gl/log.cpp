@@ -7,7 +7,8 @@
 
 #include "log.h"
 #include <unistd.h>
-#include <mutex>
+#include <atomic>
+#include <cstring>
 
 #include <GL/gl.h>
 
@@ -1103,27 +1104,43 @@ const char* glEnumToString(GLenum e) {
 #if LOG_CALLED_FUNCS
 
 #include "../config/config.h"
+#include "log_ring.h"
 
-void log_unique_function(const char* func_name) {
-    if (!func_name || strlen(func_name) < 2 || strncmp(func_name, "gl", 2) != 0) {
-        return;
-    }
-    static std::unordered_set<std::string> logged_functions;
-    static std::mutex log_mutex;
-    std::string func_str(func_name);
+#define LOGGED_FUNCTIONS_CAPACITY 4096
 
-    std::lock_guard<std::mutex> guard(log_mutex);
+// Lock-free set of the names written so far. Slots are only ever filled, and
+// the table is far larger than the number of GL entry points.
+static std::atomic<const char*> logged_functions[LOGGED_FUNCTIONS_CAPACITY];
 
-    if (logged_functions.find(func_str) != logged_functions.end()) {
+void log_unique_function(const char* func_name) {
+    if (!func_name || strncmp(func_name, "gl", 2) != 0) {
         return;
     }
 
-    static FILE* fp = fopen(concatenate(mg_directory_path, "/glcalls.txt"), "a");
-    if (fp) {
-        fprintf(fp, "%s\n", func_name);
-        fflush(fp);
+    uint32_t hash = 2166136261u;
+    for (const char* c = func_name; *c; ++c) {
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
     }
 
-    logged_functions.insert(func_str);
+    for (uint32_t probe = 0; probe < LOGGED_FUNCTIONS_CAPACITY; ++probe) {
+        auto& slot = logged_functions[(hash + probe) & (LOGGED_FUNCTIONS_CAPACITY - 1)];
+        const char* name = slot.load(std::memory_order_acquire);
+        if (!name && slot.compare_exchange_strong(name, func_name, std::memory_order_acq_rel)) {
+            static bool opened = log_ring_open(LogSink::Calls, concatenate(mg_directory_path, "/glcalls.txt"));
+            if (opened) {
+                size_t length = strlen(func_name);
+                char line[256];
+                if (length >= sizeof(line)) return;
+                memcpy(line, func_name, length);
+                line[length] = '\n';
+                log_ring_write(LogSink::Calls, line, length + 1);
+            }
+            return;
+        }
+        // Same literal in the common case, so the string compare rarely runs
+        if (name == func_name || strcmp(name, func_name) == 0) {
+            return;
+        }
+    }
 }
-#endif
\ No newline at end of file
+#endif
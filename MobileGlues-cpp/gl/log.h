@@ -8,6 +8,7 @@
 #ifndef MOBILEGLUES_LOG_H
 
 #include "../includes.h"
+#include "call_trace.h"
 
 #define FORCE_SYNC_WITH_LOG_FILE 0
 
@@ -45,6 +46,7 @@ int __android_log_print(int prio, const char* tag, const char* fmt, ...);
 
 #if GLOBAL_DEBUG_FORCE_OFF
 #define LOG()                                                                                                          \
+    MG_TRACE_CALL()                                                                                                    \
     {}
 #define LOG_D(...)                                                                                                     \
     {}
@@ -59,10 +61,12 @@ int __android_log_print(int prio, const char* tag, const char* fmt, ...);
 #else
 #if PROFILING
 #define LOG()                                                                                                          \
+    MG_TRACE_CALL()                                                                                                    \
     perfetto::StaticString _FUNC_NAME_ = __func__;                                                                     \
     TRACE_EVENT("glcalls", _FUNC_NAME_);
 #elif LOG_CALLED_FUNCS
 #define LOG()                                                                                                          \
+    MG_TRACE_CALL()                                                                                                    \
     if (DEBUG || GLOBAL_DEBUG) {                                                                                       \
         __android_log_print(ANDROID_LOG_DEBUG, RENDERERNAME, "Use function: %s", __FUNCTION__);                        \
         printf("Use function: %s\n", __FUNCTION__);                                                                    \
@@ -72,6 +76,7 @@ int __android_log_print(int prio, const char* tag, const char* fmt, ...);
 void log_unique_function(const char* func_name);
 #else
 #define LOG()                                                                                                          \
+    MG_TRACE_CALL()                                                                                                    \
     if (DEBUG || GLOBAL_DEBUG) {                                                                                       \
         __android_log_print(ANDROID_LOG_DEBUG, RENDERERNAME, "\nUse function: %s", __FUNCTION__);                      \
         printf("\nUse function: %s\n", __FUNCTION__);                                                                  \
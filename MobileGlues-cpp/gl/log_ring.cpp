@@ -0,0 +1,388 @@
+// MobileGlues - gl/log_ring.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "log_ring.h"
+#include "log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <sched.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define DEBUG 0
+
+// Bytes per thread ring, a power of two
+#define LOG_RING_SIZE (64 * 1024)
+// Threads that can log at the same time; rings of exited threads are reused
+#define LOG_RING_MAX_THREADS 64
+// Longest record; longer messages are split into several
+#define LOG_RING_MAX_RECORD 4096
+#define LOG_RING_FORMAT_BUFFER 512
+// Bytes collected per file before one write()
+#define LOG_RING_BATCH_SIZE (64 * 1024)
+#define LOG_RING_DRAIN_INTERVAL std::chrono::milliseconds(50)
+// Wake the drain thread early once a ring is this full
+#define LOG_RING_WAKE_THRESHOLD (LOG_RING_SIZE / 2)
+#define LOG_RING_CRASH_SPINS 1000
+
+namespace {
+
+struct record_header_t {
+    uint16_t length;
+    LogSink sink;
+};
+
+struct alignas(64) log_ring_t {
+    // Written by the owning thread only
+    std::atomic<size_t> head{0};
+    // Written by the drainer only
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) std::atomic<uint64_t> dropped{0};
+    uint64_t reported_dropped = 0;
+    std::atomic<bool> owned{false};
+    char data[LOG_RING_SIZE];
+};
+
+std::atomic<log_ring_t*> g_rings[LOG_RING_MAX_THREADS];
+std::atomic<size_t> g_ring_count{0};
+// Messages from threads that found every ring taken
+std::atomic<uint64_t> g_unringed_dropped{0};
+uint64_t g_reported_unringed_dropped = 0;
+
+std::atomic<int> g_fds[(size_t)LogSink::Count] = {-1, -1};
+
+std::atomic<bool> g_wake{false};
+
+// Never destroyed: the detached drain thread may still be waiting on them
+// while the process runs its static destructors at exit
+std::mutex& wake_mutex() {
+    static auto* mutex = new std::mutex;
+    return *mutex;
+}
+std::condition_variable& wake_cv() {
+    static auto* cv = new std::condition_variable;
+    return *cv;
+}
+
+// Held while draining so the drain thread, log_ring_flush() and the crash
+// handler never consume the same ring at once.
+std::atomic_flag g_draining = ATOMIC_FLAG_INIT;
+
+struct sink_batch_t {
+    char data[LOG_RING_BATCH_SIZE];
+    size_t size;
+};
+sink_batch_t g_batches[(size_t)LogSink::Count];
+
+log_ring_t* acquire_ring() {
+    size_t count = std::min<size_t>(g_ring_count.load(std::memory_order_acquire), LOG_RING_MAX_THREADS);
+    for (size_t i = 0; i < count; ++i) {
+        log_ring_t* ring = g_rings[i].load(std::memory_order_acquire);
+        bool expected = false;
+        if (ring && ring->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return ring;
+        }
+    }
+
+    size_t index = g_ring_count.fetch_add(1, std::memory_order_acq_rel);
+    if (index >= LOG_RING_MAX_THREADS) {
+        g_ring_count.store(LOG_RING_MAX_THREADS, std::memory_order_release);
+        return nullptr;
+    }
+    auto* ring = new log_ring_t;
+    ring->owned.store(true, std::memory_order_relaxed);
+    g_rings[index].store(ring, std::memory_order_release);
+    return ring;
+}
+
+// Hands the ring back when its thread exits. Whatever it still holds is
+// drained as usual.
+struct thread_ring_t {
+    log_ring_t* ring = nullptr;
+    bool acquired = false;
+
+    log_ring_t* get() {
+        if (!acquired) {
+            ring = acquire_ring();
+            acquired = true;
+        }
+        return ring;
+    }
+
+    ~thread_ring_t() {
+        if (ring) ring->owned.store(false, std::memory_order_release);
+    }
+};
+
+thread_local thread_ring_t t_ring;
+
+void ring_copy_in(log_ring_t* ring, size_t pos, const void* src, size_t length) {
+    size_t offset = pos & (LOG_RING_SIZE - 1);
+    size_t first = std::min<size_t>(length, LOG_RING_SIZE - offset);
+    memcpy(ring->data + offset, src, first);
+    memcpy(ring->data, (const char*)src + first, length - first);
+}
+
+void ring_copy_out(const log_ring_t* ring, size_t pos, void* dst, size_t length) {
+    size_t offset = pos & (LOG_RING_SIZE - 1);
+    size_t first = std::min<size_t>(length, LOG_RING_SIZE - offset);
+    memcpy(dst, ring->data + offset, first);
+    memcpy((char*)dst + first, ring->data, length - first);
+}
+
+// Queues a whole message or nothing, split into records of at most
+// LOG_RING_MAX_RECORD bytes.
+void ring_push(LogSink sink, const char* data, size_t length) {
+    if (length == 0) return;
+
+    log_ring_t* ring = t_ring.get();
+    if (!ring) {
+        g_unringed_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    size_t records = (length + LOG_RING_MAX_RECORD - 1) / LOG_RING_MAX_RECORD;
+    size_t need = records * sizeof(record_header_t) + length;
+    size_t head = ring->head.load(std::memory_order_relaxed);
+    size_t tail = ring->tail.load(std::memory_order_acquire);
+    if (need > LOG_RING_SIZE - (head - tail)) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    while (length > 0) {
+        size_t chunk = std::min<size_t>(length, LOG_RING_MAX_RECORD);
+        record_header_t header = {(uint16_t)chunk, sink};
+        ring_copy_in(ring, head, &header, sizeof(header));
+        ring_copy_in(ring, head + sizeof(header), data, chunk);
+        head += sizeof(header) + chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    ring->head.store(head, std::memory_order_release);
+
+    if (head - tail >= LOG_RING_WAKE_THRESHOLD && !g_wake.exchange(true, std::memory_order_relaxed)) {
+        wake_cv().notify_one();
+    }
+}
+
+// Only plain write() from here on so the crash handler can use it too.
+void write_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+}
+
+void batch_flush(LogSink sink) {
+    sink_batch_t& batch = g_batches[(size_t)sink];
+    int fd = g_fds[(size_t)sink].load(std::memory_order_acquire);
+    if (batch.size > 0 && fd >= 0) {
+        write_all(fd, batch.data, batch.size);
+#if FORCE_SYNC_WITH_LOG_FILE == 1
+        fsync(fd);
+#endif
+    }
+    batch.size = 0;
+}
+
+void batch_append(LogSink sink, const char* data, size_t length) {
+    sink_batch_t& batch = g_batches[(size_t)sink];
+    if (batch.size + length > LOG_RING_BATCH_SIZE) batch_flush(sink);
+    memcpy(batch.data + batch.size, data, length);
+    batch.size += length;
+}
+
+// No snprintf here, this also runs in the crash handler
+void report_dropped(uint64_t dropped, uint64_t& reported) {
+    if (dropped == reported) return;
+    static const char prefix[] = "[MobileGlues] ";
+    static const char suffix[] = " log messages dropped\n";
+    char digits[20];
+    size_t count = 0;
+    for (uint64_t n = dropped - reported; n > 0 || count == 0; n /= 10) {
+        digits[sizeof(digits) - ++count] = (char)('0' + n % 10);
+    }
+    batch_append(LogSink::Latest, prefix, sizeof(prefix) - 1);
+    batch_append(LogSink::Latest, digits + sizeof(digits) - count, count);
+    batch_append(LogSink::Latest, suffix, sizeof(suffix) - 1);
+    reported = dropped;
+}
+
+void drain_ring(log_ring_t* ring) {
+    size_t head = ring->head.load(std::memory_order_acquire);
+    size_t tail = ring->tail.load(std::memory_order_relaxed);
+    // Static rather than on the possibly small signal stack
+    static char record[LOG_RING_MAX_RECORD];
+    while (tail != head) {
+        record_header_t header;
+        ring_copy_out(ring, tail, &header, sizeof(header));
+        ring_copy_out(ring, tail + sizeof(header), record, header.length);
+        tail += sizeof(header) + header.length;
+        if (header.sink < LogSink::Count) batch_append(header.sink, record, header.length);
+    }
+    ring->tail.store(tail, std::memory_order_release);
+    report_dropped(ring->dropped.load(std::memory_order_relaxed), ring->reported_dropped);
+}
+
+// Expects g_draining to be held
+void drain_locked() {
+    size_t count = std::min<size_t>(g_ring_count.load(std::memory_order_acquire), LOG_RING_MAX_THREADS);
+    for (size_t i = 0; i < count; ++i) {
+        log_ring_t* ring = g_rings[i].load(std::memory_order_acquire);
+        if (ring) drain_ring(ring);
+    }
+    report_dropped(g_unringed_dropped.load(std::memory_order_relaxed), g_reported_unringed_dropped);
+    for (size_t sink = 0; sink < (size_t)LogSink::Count; ++sink) {
+        batch_flush((LogSink)sink);
+    }
+}
+
+void drain_all() {
+    while (g_draining.test_and_set(std::memory_order_acquire)) {
+        sched_yield();
+    }
+    drain_locked();
+    g_draining.clear(std::memory_order_release);
+}
+
+[[noreturn]] void drain_thread() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex());
+            // Producers notify without the mutex, so a wakeup can be missed;
+            // the timeout bounds how late the drain is then.
+            wake_cv().wait_for(lock, LOG_RING_DRAIN_INTERVAL,
+                               [] { return g_wake.load(std::memory_order_relaxed); });
+        }
+        g_wake.store(false, std::memory_order_relaxed);
+        drain_all();
+    }
+}
+
+// The JVM and other runtimes raise SIGSEGV and friends in normal operation
+// and a drain on each of those would cost them, so only GLOBAL_DEBUG builds
+// intercept them. abort() always ends the process.
+#if GLOBAL_DEBUG
+const int kCrashSignals[] = {SIGABRT, SIGSEGV, SIGBUS, SIGFPE, SIGILL};
+#else
+const int kCrashSignals[] = {SIGABRT};
+#endif
+struct sigaction g_old_actions[NSIG];
+
+void crash_handler(int sig, siginfo_t* info, void* context) {
+    // The crash may be on the drainer itself, so never wait for it unbounded;
+    // skipping the flush beats hanging the process.
+    for (int i = 0; i < LOG_RING_CRASH_SPINS; ++i) {
+        if (!g_draining.test_and_set(std::memory_order_acquire)) {
+            drain_locked();
+            g_draining.clear(std::memory_order_release);
+            break;
+        }
+        sched_yield();
+    }
+
+    const struct sigaction& old = g_old_actions[sig];
+    if (old.sa_flags & SA_SIGINFO) {
+        if (old.sa_sigaction) old.sa_sigaction(sig, info, context);
+    } else if (old.sa_handler == SIG_DFL) {
+        // The signal is blocked while we run, so it is delivered with the
+        // default action as soon as the handler returns.
+        sigaction(sig, &old, nullptr);
+        raise(sig);
+    } else if (old.sa_handler != SIG_IGN) {
+        old.sa_handler(sig);
+    }
+}
+
+void install_crash_handlers() {
+    struct sigaction action = {};
+    action.sa_sigaction = crash_handler;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    for (int sig : kCrashSignals) {
+        sigaction(sig, &action, &g_old_actions[sig]);
+    }
+}
+
+void start_drain_thread() {
+    std::thread(drain_thread).detach();
+    // The drain thread is detached and simply stops with the process
+    atexit(drain_all);
+}
+
+} // namespace
+
+bool log_ring_open(LogSink sink, const char* path) {
+    static std::once_flag started;
+    std::call_once(started, start_drain_thread);
+
+    if (!path) return false;
+    int fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    // Nothing to save on a crash before there is a file to save it to
+    static std::once_flag handlers;
+    std::call_once(handlers, install_crash_handlers);
+
+    drain_all();
+    int old = g_fds[(size_t)sink].exchange(fd, std::memory_order_acq_rel);
+    if (old >= 0) close(old);
+    return true;
+}
+
+void log_ring_vprintf(LogSink sink, bool newline, const char* format, va_list args) {
+    char buffer[LOG_RING_FORMAT_BUFFER];
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(buffer, sizeof(buffer) - 1, format, copy);
+    va_end(copy);
+    if (length < 0) return;
+
+    if ((size_t)length < sizeof(buffer) - 1) {
+        if (newline) buffer[length++] = '\n';
+        ring_push(sink, buffer, (size_t)length);
+        return;
+    }
+
+    std::vector<char> large((size_t)length + 2);
+    vsnprintf(large.data(), large.size() - 1, format, args);
+    if (newline) large[length++] = '\n';
+    ring_push(sink, large.data(), (size_t)length);
+}
+
+void log_ring_write(LogSink sink, const char* data, size_t length) {
+    ring_push(sink, data, length);
+}
+
+void log_ring_flush() {
+    drain_all();
+}
+
+uint64_t log_ring_dropped() {
+    uint64_t dropped = g_unringed_dropped.load(std::memory_order_relaxed);
+    size_t count = std::min<size_t>(g_ring_count.load(std::memory_order_acquire), LOG_RING_MAX_THREADS);
+    for (size_t i = 0; i < count; ++i) {
+        log_ring_t* ring = g_rings[i].load(std::memory_order_acquire);
+        if (ring) dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
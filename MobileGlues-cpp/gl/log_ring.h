@@ -0,0 +1,41 @@
+// MobileGlues - gl/log_ring.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_LOG_RING_H
+#define MOBILEGLUES_LOG_RING_H
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+
+// Asynchronous writer behind the log files.
+//
+// Every thread formats into its own single-producer ring and never locks or
+// blocks. A background thread drains all rings in batches with one write()
+// per file. When a ring is full the message is dropped and counted; the
+// count is written to latest.log the next time that ring drains. Messages
+// from one thread keep their order, messages from different threads are only
+// ordered per batch. exit() and abort() flush whatever is still queued, as
+// do fatal signals in GLOBAL_DEBUG builds.
+
+enum class LogSink : uint8_t {
+    Latest, // latest.log
+    Calls,  // glcalls.txt
+    Count
+};
+
+// Opens the file behind a sink and starts the drain thread on first use.
+// Messages for a sink without a file are discarded.
+bool log_ring_open(LogSink sink, const char* path);
+void log_ring_vprintf(LogSink sink, bool newline, const char* format, va_list args);
+void log_ring_write(LogSink sink, const char* data, size_t length);
+// Drains everything queued so far on the calling thread
+void log_ring_flush();
+// Messages dropped so far because a ring was full or no ring was left
+uint64_t log_ring_dropped();
+
+#endif // MOBILEGLUES_LOG_RING_H
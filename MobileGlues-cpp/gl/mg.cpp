@@ -7,11 +7,13 @@
 
 #include <unistd.h>
 #include "mg.h"
+#include "log_ring.h"
 
 #define DEBUG 0
 
 hardware_t hardware;
-gl_state_t gl_state;
+gl_state_t g_default_gl_state;
+thread_local gl_state_t gl_state = g_default_gl_state;
 
 FUNC_GL_STATE_SIZEI(proxy_width)
 FUNC_GL_STATE_SIZEI(proxy_height)
@@ -19,54 +21,38 @@ FUNC_GL_STATE_ENUM(proxy_intformat)
 FUNC_GL_STATE_UINT(current_program)
 FUNC_GL_STATE_UINT(current_tex_unit)
 FUNC_GL_STATE_UINT(current_draw_fbo)
-
-#ifndef __APPLE__
-FILE* file;
-#endif
+FUNC_GL_STATE_UINT(current_read_fbo)
+FUNC_GL_STATE_UINT(current_renderbuffer)
+FUNC_GL_STATE_UINT(current_vao)
 
 void start_log() {
 #ifndef __APPLE__
-    file = fopen(log_file_path, "a");
+    log_ring_open(LogSink::Latest, log_file_path);
 #endif
 }
 
+// Formatting happens here, the file write on the log ring's drain thread
 void write_log(const char* format, ...) {
 #ifndef __APPLE__
-    if (file == nullptr) {
-        return;
-    }
     va_list args;
     va_start(args, format);
-    vfprintf(file, format, args);
+    log_ring_vprintf(LogSink::Latest, true, format, args);
     va_end(args);
-    fprintf(file, "\n");
-    fflush(file);
-#if FORCE_SYNC_WITH_LOG_FILE == 1
-    int fd = fileno(file);
-    fsync(fd);
-#endif
-    // Todo: close file
-    // fclose(file);
 #endif
 }
 
 void write_log_n(const char* format, ...) {
 #ifndef __APPLE__
-    if (file == NULL) {
-        return;
-    }
     va_list args;
     va_start(args, format);
-    vfprintf(file, format, args);
+    log_ring_vprintf(LogSink::Latest, false, format, args);
     va_end(args);
-    // Todo: close file
-    fflush(file);
 #endif
 }
 
 void clear_log() {
 #ifndef __APPLE__
-    file = fopen(log_file_path, "w");
+    FILE* file = fopen(log_file_path, "w");
     if (file == nullptr) {
         return;
     }
@@ -59,6 +59,9 @@ extern "C"
     FUNC_GL_STATE_UINT_DECLARATION(current_program)
     FUNC_GL_STATE_UINT_DECLARATION(current_tex_unit)
     FUNC_GL_STATE_UINT_DECLARATION(current_draw_fbo)
+    FUNC_GL_STATE_UINT_DECLARATION(current_read_fbo)
+    FUNC_GL_STATE_UINT_DECLARATION(current_renderbuffer)
+    FUNC_GL_STATE_UINT_DECLARATION(current_vao)
 
     struct hardware_s {
         unsigned int es_version;
@@ -67,6 +70,35 @@ extern "C"
     typedef struct hardware_s* hardware_t;
     extern hardware_t hardware;
 
+#define MG_MAX_TEXTURE_UNITS 32
+// Buffer binding points tracked by buffer.cpp, one per BindingIndex
+#define MG_BUFFER_BINDING_COUNT 13
+
+    struct gl_stencil_face_s {
+        GLenum func;
+        GLint ref;
+        GLuint value_mask;
+        GLuint write_mask;
+        GLenum fail;
+        GLenum zfail;
+        GLenum zpass;
+    };
+
+    struct gl_pixel_store_s {
+        GLint alignment;
+        GLint row_length;
+        GLint image_height;
+        GLint skip_pixels;
+        GLint skip_rows;
+        GLint skip_images;
+    };
+
+    // CPU-side shadow of the GLES context state, kept in sync by the wrapped
+    // entry points (see state.cpp). Object names are the ones GLES sees, except
+    // for the buffer and vertex array bindings. Internal code that changes
+    // state through GLES.* directly must put it back before returning, e.g.
+    // with a StateScope. Each EGL context has its own, see
+    // make_gl_state_current.
     struct gl_state_s {
         GLsizei proxy_width;
         GLsizei proxy_height;
@@ -75,9 +107,49 @@ extern "C"
         GLuint current_program;
         GLuint current_tex_unit;
         GLuint current_draw_fbo;
+        GLuint current_read_fbo;
+        GLuint current_renderbuffer;
+        GLuint current_vao;
+        GLuint texture_binding_2d[MG_MAX_TEXTURE_UNITS];
+
+        // Application names, as buffer.cpp tracks them
+        GLuint bound_buffers[MG_BUFFER_BINDING_COUNT];
+        GLuint bound_vertex_array;
+
+        // The initial viewport and scissor box are the size of whatever surface
+        // the application makes current, so they are only known once set or
+        // queried.
+        GLint viewport[4];
+        GLint scissor_box[4];
+        GLboolean viewport_known;
+        GLboolean scissor_known;
+
+        GLbitfield enabled_caps; // bit per STATE_CAP_* in state.h
+
+        GLenum blend_src_rgb;
+        GLenum blend_dst_rgb;
+        GLenum blend_src_alpha;
+        GLenum blend_dst_alpha;
+        GLenum blend_equation_rgb;
+        GLenum blend_equation_alpha;
+        GLboolean color_mask[4];
+
+        GLenum depth_func;
+        GLboolean depth_mask;
+        GLclampd clear_depth;
+        GLboolean clear_depth_known;
+
+        struct gl_stencil_face_s stencil_front;
+        struct gl_stencil_face_s stencil_back;
+
+        struct gl_pixel_store_s pack;
+        struct gl_pixel_store_s unpack;
     };
     typedef struct gl_state_s* gl_state_t;
-    extern gl_state_t gl_state;
+    // The shadow of the context current on the calling thread. Threads that
+    // have none made current through eglMakeCurrent share the startup one.
+    extern thread_local gl_state_t gl_state;
+    extern gl_state_t g_default_gl_state;
 
     GLenum pname_convert(GLenum pname);
     GLenum map_tex_target(GLenum target);
@@ -6,7 +6,11 @@
 // End of Source File Header
 
 #include "multidraw.h"
+#include "indirect_ring.h"
+#include "buffer.h"
+#include "index_cache.h"
 #include "../config/settings.h"
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <vector>
@@ -17,6 +21,8 @@ typedef void (*glMultiDrawElements_t)(GLenum, const GLsizei*, GLenum, const void
 
 void glMultiDrawElements(GLenum mode, const GLsizei* count, GLenum type, const void* const* indices,
                          GLsizei primcount) {
+    LOG()
+    MG_TRACE_ARGS(glMultiDrawElements, mode, count, type, indices, primcount)
     static glMultiDrawElements_t func_ptr = nullptr;
 
     if (func_ptr == nullptr) {
@@ -44,10 +50,13 @@ void glMultiDrawElements(GLenum mode, const GLsizei* count, GLenum type, const v
     func_ptr(mode, count, type, indices, primcount);
 }
 
-typedef void (*glMultiDrawElementsBaseVertex_t)(GLenum, GLsizei*, GLenum, const void* const*, GLsizei, const GLint*);
+typedef void (*glMultiDrawElementsBaseVertex_t)(GLenum, const GLsizei*, GLenum, const void* const*, GLsizei,
+                                                const GLint*);
 
-void glMultiDrawElementsBaseVertex(GLenum mode, GLsizei* counts, GLenum type, const void* const* indices,
+void glMultiDrawElementsBaseVertex(GLenum mode, const GLsizei* counts, GLenum type, const void* const* indices,
                                    GLsizei primcount, const GLint* basevertex) {
+    LOG()
+    MG_TRACE_ARGS(glMultiDrawElementsBaseVertex, mode, counts, type, indices, primcount, basevertex)
     static glMultiDrawElementsBaseVertex_t func_ptr = nullptr;
 
     if (func_ptr == nullptr) {
@@ -76,44 +85,14 @@ void glMultiDrawElementsBaseVertex(GLenum mode, GLsizei* counts, GLenum type, co
     func_ptr(mode, counts, type, indices, primcount, basevertex);
 }
 
-static bool g_indirect_cmds_inited = false;
-static GLsizei g_cmdbufsize = 0;
-static GLuint g_indirectbuffer = 0;
-static GLuint prevIndirectBuffer = 0;
-
-void prepare_indirect_buffer(const GLsizei* counts, GLenum type, const void* const* indices, GLsizei primcount,
-                             const GLint* basevertex) {
-    GLES.glGetIntegerv(GL_DRAW_INDIRECT_BUFFER_BINDING, (GLint*)&prevIndirectBuffer);
-    if (!g_indirect_cmds_inited) {
-        GLES.glGenBuffers(1, &g_indirectbuffer);
-        GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, g_indirectbuffer);
-        g_cmdbufsize = 1;
-        GLES.glBufferData(GL_DRAW_INDIRECT_BUFFER, g_cmdbufsize * sizeof(draw_elements_indirect_command_t), NULL,
-                          GL_DYNAMIC_DRAW);
-
-        g_indirect_cmds_inited = true;
-    }
-    GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, g_indirectbuffer);
-
-    if (g_cmdbufsize < primcount) {
-        size_t sz = g_cmdbufsize;
-
-        LOG_D("Before resize: %d", sz)
-
-        // 2-exponential to reduce reallocation
-        while (sz < primcount)
-            sz *= 2;
-
-        GLES.glBufferData(GL_DRAW_INDIRECT_BUFFER, sz * sizeof(draw_elements_indirect_command_t), NULL,
-                          GL_DYNAMIC_DRAW);
-        g_cmdbufsize = sz;
-    }
-
-    LOG_D("After resize: %d", g_cmdbufsize)
-
-    auto* pcmds = (draw_elements_indirect_command_t*)GLES.glMapBufferRange(
-        GL_DRAW_INDIRECT_BUFFER, 0, primcount * sizeof(draw_elements_indirect_command_t),
-        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+// Writes one indirect command per sub-draw into the indirect ring, which is
+// left bound to GL_DRAW_INDIRECT_BUFFER. Returns false if no storage could be
+// mapped; the caller must still call IndirectRing::submit().
+static bool prepare_indirect_buffer(const GLsizei* counts, GLenum type, const void* const* indices,
+                                    GLsizei primcount, const GLint* basevertex, GLintptr& offset) {
+    auto& ring = IndirectRing::get_instance();
+    auto* pcmds = ring.begin(primcount, offset);
+    if (!pcmds) return false;
 
     GLsizei elementSize;
     switch (type) {
@@ -139,138 +118,79 @@ void prepare_indirect_buffer(const GLsizei* counts, GLenum type, const void* con
         pcmds[i].reservedMustBeZero = 0;
     }
 
-    GLES.glUnmapBuffer(GL_DRAW_INDIRECT_BUFFER);
+    ring.end();
+    return true;
 }
 
-void mg_glMultiDrawElementsBaseVertex_drawelements(GLenum mode, GLsizei* counts, GLenum type,
+void mg_glMultiDrawElementsBaseVertex_drawelements(GLenum mode, const GLsizei* counts, GLenum type,
                                                    const void* const* indices, GLsizei primcount,
                                                    const GLint* basevertex) {
     LOG()
     void prepareForDraw();
     prepareForDraw();
-    GLint prevElementBuffer;
-    GLES.glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &prevElementBuffer);
-
+    auto& indexCache = BaseVertexIndexCache::get_instance();
+    const GLuint elementBuffer = find_real_bound_buffer(GL_ELEMENT_ARRAY_BUFFER_BINDING);
+    bool elementBufferBound = true;
     for (GLsizei i = 0; i < primcount; ++i) {
         if (counts[i] <= 0) continue;
 
-        GLsizei currentCount = counts[i];
-        const GLvoid* currentIndices = indices[i];
-        GLint currentBaseVertex = basevertex[i];
-
-        size_t indexSize;
-        switch (type) {
-        case GL_UNSIGNED_INT:
-            indexSize = sizeof(GLuint);
-            break;
-        case GL_UNSIGNED_SHORT:
-            indexSize = sizeof(GLushort);
-            break;
-        case GL_UNSIGNED_BYTE:
-            indexSize = sizeof(GLubyte);
-            break;
-        default:
-            return;
-        }
-
-        GLuint tempBuffer;
-        GLES.glGenBuffers(1, &tempBuffer);
-        GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tempBuffer);
-
-        void* srcData = nullptr;
-        void* tempIndices = malloc(currentCount * indexSize);
-        if (!tempIndices) {
-            GLES.glDeleteBuffers(1, &tempBuffer);
+        if (basevertex[i] == 0) {
+            if (!elementBufferBound) GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBuffer);
+            elementBufferBound = true;
+            GLES.glDrawElements(mode, counts[i], type, indices[i]);
             continue;
         }
 
-        if (prevElementBuffer != 0) {
-            GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, prevElementBuffer);
-            srcData = GLES.glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)currentIndices, currentCount * indexSize,
-                                            GL_MAP_READ_BIT);
-
-            if (!srcData) {
-                free(tempIndices);
-                GLES.glDeleteBuffers(1, &tempBuffer);
-                continue;
-            }
-        } else {
-            srcData = (void*)currentIndices;
-        }
-
-        switch (type) {
-        case GL_UNSIGNED_INT:
-            for (int j = 0; j < currentCount; ++j) {
-                ((GLuint*)tempIndices)[j] = ((GLuint*)srcData)[j] + currentBaseVertex;
-            }
-            break;
-        case GL_UNSIGNED_SHORT:
-            for (int j = 0; j < currentCount; ++j) {
-                ((GLushort*)tempIndices)[j] = ((GLushort*)srcData)[j] + currentBaseVertex;
-            }
-            break;
-        case GL_UNSIGNED_BYTE:
-            for (int j = 0; j < currentCount; ++j) {
-                ((GLubyte*)tempIndices)[j] = ((GLubyte*)srcData)[j] + currentBaseVertex;
-            }
-            break;
+        const void* offset = nullptr;
+        if (indexCache.bind(counts[i], type, indices[i], basevertex[i], offset)) {
+            GLES.glDrawElements(mode, counts[i], type, offset);
         }
-
-        if (prevElementBuffer != 0) {
-            GLES.glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
-        }
-
-        GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tempBuffer);
-        GLES.glBufferData(GL_ELEMENT_ARRAY_BUFFER, currentCount * indexSize, tempIndices, GL_STREAM_DRAW);
-        free(tempIndices);
-        GLES.glDrawElements(mode, currentCount, type, 0);
-
-        GLES.glDeleteBuffers(1, &tempBuffer);
+        elementBufferBound = false;
     }
-
-    GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, prevElementBuffer);
+    if (!elementBufferBound) GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBuffer);
 
     CHECK_GL_ERROR
 }
 
-void mg_glMultiDrawElementsBaseVertex_indirect(GLenum mode, GLsizei* counts, GLenum type, const void* const* indices,
-                                               GLsizei primcount, const GLint* basevertex) {
+void mg_glMultiDrawElementsBaseVertex_indirect(GLenum mode, const GLsizei* counts, GLenum type,
+                                               const void* const* indices, GLsizei primcount, const GLint* basevertex) {
     LOG()
     void prepareForDraw();
     prepareForDraw();
 
-    prepare_indirect_buffer(counts, type, indices, primcount, basevertex);
-
-    // Draw indirect!
-    for (GLsizei i = 0; i < primcount; ++i) {
-        const GLvoid* offset = reinterpret_cast<GLvoid*>(i * sizeof(draw_elements_indirect_command_t));
-        GLES.glDrawElementsIndirect(mode, type, offset);
+    GLintptr base = 0;
+    if (prepare_indirect_buffer(counts, type, indices, primcount, basevertex, base)) {
+        // Draw indirect!
+        for (GLsizei i = 0; i < primcount; ++i) {
+            const GLvoid* offset = reinterpret_cast<GLvoid*>(base + i * sizeof(draw_elements_indirect_command_t));
+            GLES.glDrawElementsIndirect(mode, type, offset);
+        }
     }
-
-    GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, prevIndirectBuffer);
+    IndirectRing::get_instance().submit();
 
     CHECK_GL_ERROR
 }
 
-void mg_glMultiDrawElementsBaseVertex_multiindirect(GLenum mode, GLsizei* counts, GLenum type,
+void mg_glMultiDrawElementsBaseVertex_multiindirect(GLenum mode, const GLsizei* counts, GLenum type,
                                                     const void* const* indices, GLsizei primcount,
                                                     const GLint* basevertex) {
     LOG()
     void prepareForDraw();
     prepareForDraw();
 
-    prepare_indirect_buffer(counts, type, indices, primcount, basevertex);
-
-    // Multi-draw indirect!
-    GLES.glMultiDrawElementsIndirectEXT(mode, type, 0, primcount, 0);
-
-    GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, prevIndirectBuffer);
+    GLintptr base = 0;
+    if (prepare_indirect_buffer(counts, type, indices, primcount, basevertex, base)) {
+        // Multi-draw indirect!
+        GLES.glMultiDrawElementsIndirectEXT(mode, type, reinterpret_cast<const void*>(base), primcount, 0);
+    }
+    IndirectRing::get_instance().submit();
 
     CHECK_GL_ERROR
 }
 
-void mg_glMultiDrawElementsBaseVertex_basevertex(GLenum mode, GLsizei* counts, GLenum type, const void* const* indices,
-                                                 GLsizei primcount, const GLint* basevertex) {
+void mg_glMultiDrawElementsBaseVertex_basevertex(GLenum mode, const GLsizei* counts, GLenum type,
+                                                 const void* const* indices, GLsizei primcount,
+                                                 const GLint* basevertex) {
     LOG()
     void prepareForDraw();
     prepareForDraw();
@@ -293,14 +213,15 @@ void mg_glMultiDrawElements_indirect(GLenum mode, const GLsizei* count, GLenum t
     void prepareForDraw();
     prepareForDraw();
 
-    prepare_indirect_buffer(count, type, indices, primcount, 0);
-    // Draw indirect!
-    for (GLsizei i = 0; i < primcount; ++i) {
-        const GLvoid* offset = reinterpret_cast<GLvoid*>(i * sizeof(draw_elements_indirect_command_t));
-        GLES.glDrawElementsIndirect(mode, type, offset);
+    GLintptr base = 0;
+    if (prepare_indirect_buffer(count, type, indices, primcount, 0, base)) {
+        // Draw indirect!
+        for (GLsizei i = 0; i < primcount; ++i) {
+            const GLvoid* offset = reinterpret_cast<GLvoid*>(base + i * sizeof(draw_elements_indirect_command_t));
+            GLES.glDrawElementsIndirect(mode, type, offset);
+        }
     }
-
-    GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, prevIndirectBuffer);
+    IndirectRing::get_instance().submit();
     CHECK_GL_ERROR
 }
 
@@ -342,12 +263,12 @@ void mg_glMultiDrawElements_multiindirect(GLenum mode, const GLsizei* count, GLe
     void prepareForDraw();
     prepareForDraw();
 
-    prepare_indirect_buffer(count, type, indices, primcount, 0);
-
-    // Multi-draw indirect!
-    GLES.glMultiDrawElementsIndirectEXT(mode, type, 0, primcount, 0);
-
-    GLES.glBindBuffer(GL_DRAW_INDIRECT_BUFFER, prevIndirectBuffer);
+    GLintptr base = 0;
+    if (prepare_indirect_buffer(count, type, indices, primcount, 0, base)) {
+        // Multi-draw indirect!
+        GLES.glMultiDrawElementsIndirectEXT(mode, type, reinterpret_cast<const void*>(base), primcount, 0);
+    }
+    IndirectRing::get_instance().submit();
 
     CHECK_GL_ERROR
 }
@@ -382,18 +303,83 @@ static bool is_strip_like_mode(GLenum mode) {
     }
 }
 
+// Keep in sync with shaders/multidraw_scan.comp
+const std::string multidraw_scan_shader =
+    R"(#version 310 es
+
+#define SCAN_THREADS 128u
+
+layout(local_size_x = 128) in;
+
+layout(location = 0) uniform uint uDrawCount;
+
+// x = count, y = firstIndex, z = baseVertex, w = exclusive prefix sum of x (output)
+layout(std430, binding = 1) buffer Draws { uvec4 draws[]; };
+
+shared uint partial[SCAN_THREADS];
+
+void main() {
+    uint tid = gl_LocalInvocationID.x;
+    uint perThread = (uDrawCount + SCAN_THREADS - 1u) / SCAN_THREADS;
+    uint begin = min(tid * perThread, uDrawCount);
+    uint end = min(begin + perThread, uDrawCount);
+
+    // Each thread reduces its own slice serially...
+    uint sum = 0u;
+    for (uint i = begin; i < end; ++i) {
+        sum += draws[i].x;
+    }
+    partial[tid] = sum;
+    memoryBarrierShared();
+    barrier();
+
+    // ...then the slice totals are scanned in shared memory (Blelloch)
+    for (uint stride = 1u; stride < SCAN_THREADS; stride <<= 1u) {
+        uint idx = (tid + 1u) * stride * 2u - 1u;
+        if (idx < SCAN_THREADS) {
+            partial[idx] += partial[idx - stride];
+        }
+        memoryBarrierShared();
+        barrier();
+    }
+    if (tid == 0u) {
+        partial[SCAN_THREADS - 1u] = 0u;
+    }
+    memoryBarrierShared();
+    barrier();
+    for (uint stride = SCAN_THREADS / 2u; stride > 0u; stride >>= 1u) {
+        uint idx = (tid + 1u) * stride * 2u - 1u;
+        if (idx < SCAN_THREADS) {
+            uint left = partial[idx - stride];
+            partial[idx - stride] = partial[idx];
+            partial[idx] += left;
+        }
+        memoryBarrierShared();
+        barrier();
+    }
+
+    uint running = partial[tid];
+    for (uint i = begin; i < end; ++i) {
+        uint count = draws[i].x;
+        draws[i].w = running;
+        running += count;
+    }
+}
+
+)";
+
+// Keep in sync with shaders/multidraw_compute.comp
 const std::string multidraw_comp_shader =
     R"(#version 310 es
 
 layout(local_size_x = 64) in;
 
-layout(location = 0) uniform uint uElementSize;
+layout(location = 0) uniform uint uDrawCount;
+layout(location = 1) uniform uint uElementSize;
 
 layout(std430, binding = 0) readonly buffer Input { uint in_indices[]; };
-layout(std430, binding = 1) readonly buffer FirstIndex { uint firstIndex[]; };
-layout(std430, binding = 2) readonly buffer BaseVertex { int baseVertex[]; };
-layout(std430, binding = 3) readonly buffer Prefix { uint prefixSums[]; };
-layout(std430, binding = 4) writeonly buffer Output { uint out_indices[]; };
+layout(std430, binding = 1) readonly buffer Draws { uvec4 draws[]; };
+layout(std430, binding = 2) writeonly buffer Output { uint out_indices[]; };
 
 uint read_index(uint elementIndex) {
     if (uElementSize == 4u) {
@@ -409,46 +395,43 @@ uint read_index(uint elementIndex) {
     return (word >> shift) & 0xFFu;
 }
 
+// One work group per draw; its invocations stride over the draw's indices.
 void main() {
-    uint outIdx = gl_GlobalInvocationID.x;
-    uint drawCount = uint(prefixSums.length());
-    if (drawCount == 0u) {
-        return;
-    }
-    uint total = prefixSums[drawCount - 1u];
-    if (outIdx >= total) {
+    uint drawId = gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x;
+    if (drawId >= uDrawCount) {
         return;
     }
 
-    int low = 0;
-    int high = int(drawCount) - 1;
-    while (low < high) {
-        int mid = low + (high - low) / 2;
-        if (prefixSums[mid] > outIdx) {
-            high = mid; // next [low, mid)
-        } else {
-            low = mid + 1; // next [mid + 1, high)
-        }
+    uvec4 draw = draws[drawId];
+    int baseVertex = int(draw.z);
+    for (uint i = gl_LocalInvocationID.x; i < draw.x; i += gl_WorkGroupSize.x) {
+        out_indices[draw.w + i] = uint(int(read_index(draw.y + i)) + baseVertex);
     }
-
-    uint localIdx = outIdx - ((low == 0) ? 0u : (prefixSums[low - 1]));
-    uint inIndex = localIdx + firstIndex[low];
-
-    int idx = int(read_index(inIndex));
-    out_indices[outIdx] = uint(idx + baseVertex[low]);
 }
 
 )";
 
+#define MULTIDRAW_SCAN_DRAW_COUNT_LOC 0
+#define MULTIDRAW_EXPAND_DRAW_COUNT_LOC 0
+#define MULTIDRAW_EXPAND_ELEMENT_SIZE_LOC 1
+#define MULTIDRAW_MAX_GROUPS_X 65535u
+
+struct multidraw_compute_draw_t {
+    GLuint count;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint offset; // written by the scan pass
+};
+
 static bool g_compute_inited = false;
-std::vector<GLuint> g_prefix_sum(1);
-GLuint g_prefixsumbuffer = 0;
-GLuint g_firstidx_ssbo = 0;
-GLuint g_basevtx_ssbo = 0;
-GLuint g_outputibo = 0;
-GLuint g_compute_program = 0;
-GLint g_element_size_loc = -1;
-char g_compile_info[1024];
+static GLuint g_scan_program = 0;
+static GLuint g_compute_program = 0;
+static GLuint g_draws_ssbo = 0;
+static GLuint g_outputibo = 0;
+static size_t g_draws_capacity = 0;
+static size_t g_output_capacity = 0;
+static std::vector<multidraw_compute_draw_t> g_compute_draws;
+static char g_compile_info[1024];
 
 GLuint compile_compute_program(const std::string& src) {
     INIT_CHECK_GL_ERROR
@@ -498,13 +481,37 @@ GLuint compile_compute_program(const std::string& src) {
 
     GLES.glDeleteShader(shader);
     CHECK_GL_ERROR_NO_INIT
-    g_element_size_loc = GLES.glGetUniformLocation(program, "uElementSize");
-    CHECK_GL_ERROR_NO_INIT
 
     return program;
 }
 
-GLAPI GLAPIENTRY void mg_glMultiDrawElementsBaseVertex_compute(GLenum mode, GLsizei* counts, GLenum type,
+static bool init_multidraw_compute() {
+    LOG_D("Initializing multidraw compute pipeline...")
+    g_scan_program = compile_compute_program(multidraw_scan_shader);
+    g_compute_program = g_scan_program ? compile_compute_program(multidraw_comp_shader) : 0;
+    if (g_compute_program == 0) {
+        if (g_scan_program) GLES.glDeleteProgram(g_scan_program);
+        g_scan_program = 0;
+        return false;
+    }
+    GLES.glGenBuffers(1, &g_draws_ssbo);
+    GLES.glGenBuffers(1, &g_outputibo);
+    return true;
+}
+
+// Grows `buffer` to hold at least `size` bytes. Storage is only ever
+// respecified when it grows; the contents are rewritten by every draw anyway.
+static void grow_compute_buffer(GLenum target, GLuint buffer, size_t& capacity, size_t size, GLenum usage) {
+    if (size <= capacity) return;
+    size_t newCapacity = capacity ? capacity : 4096;
+    while (newCapacity < size)
+        newCapacity *= 2;
+    GLES.glBindBuffer(target, buffer);
+    GLES.glBufferData(target, (GLsizeiptr)newCapacity, nullptr, usage);
+    capacity = newCapacity;
+}
+
+GLAPI GLAPIENTRY void mg_glMultiDrawElementsBaseVertex_compute(GLenum mode, const GLsizei* counts, GLenum type,
                                                                const void* const* indices, GLsizei primcount,
                                                                const GLint* basevertex) {
     LOG()
@@ -541,48 +548,24 @@ GLAPI GLAPIENTRY void mg_glMultiDrawElementsBaseVertex_compute(GLenum mode, GLsi
         return;
     }
 
-    // Align compute shader input format with standard OpenGL indirect-draw format
-    //    prepare_indirect_buffer(counts, type, indices, primcount, basevertex);
-    //    prepare_compute_drawcmd_ssbo(counts, type, indices, primcount, basevertex);
-
-    // Init compute buffers
     if (!g_compute_inited) {
-        LOG_D("Initializing multidraw compute pipeline...")
-        GLES.glGenBuffers(1, &g_prefixsumbuffer);
-        GLES.glGenBuffers(1, &g_firstidx_ssbo);
-        GLES.glGenBuffers(1, &g_basevtx_ssbo);
-        GLES.glGenBuffers(1, &g_outputibo);
-
-        g_compute_program = compile_compute_program(multidraw_comp_shader);
-        if (g_compute_program == 0) {
+        if (!init_multidraw_compute()) {
             LOG_E("mg_glMultiDrawElementsBaseVertex_compute: compute program init failed, fallback")
-            GLES.glDeleteBuffers(1, &g_prefixsumbuffer);
-            GLES.glDeleteBuffers(1, &g_firstidx_ssbo);
-            GLES.glDeleteBuffers(1, &g_basevtx_ssbo);
-            GLES.glDeleteBuffers(1, &g_outputibo);
-            g_prefixsumbuffer = 0;
-            g_firstidx_ssbo = 0;
-            g_basevtx_ssbo = 0;
-            g_outputibo = 0;
             mg_glMultiDrawElementsBaseVertex_drawelements(mode, counts, type, indices, primcount, basevertex);
             return;
         }
-
         g_compute_inited = true;
     }
 
-    GLint ibo = 0;
-    GLES.glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ibo);
-    CHECK_GL_ERROR_NO_INIT
+    const GLuint ibo = find_real_bound_buffer(GL_ELEMENT_ARRAY_BUFFER_BINDING);
     if (ibo == 0) {
         LOG_D("mg_glMultiDrawElementsBaseVertex_compute: no element array buffer bound, fallback")
         mg_glMultiDrawElementsBaseVertex_drawelements(mode, counts, type, indices, primcount, basevertex);
         return;
     }
-    GLint ibo_size = 0;
-    GLES.glGetBufferParameteriv(GL_ELEMENT_ARRAY_BUFFER, GL_BUFFER_SIZE, &ibo_size);
-    CHECK_GL_ERROR_NO_INIT
-    if (ibo_size <= 0) {
+    // Tracked by glBufferData/glBufferStorage, no need to ask the driver
+    const size_t ibo_size = get_buffer_data_size(find_bound_buffer(GL_ELEMENT_ARRAY_BUFFER_BINDING));
+    if (ibo_size == 0) {
         LOG_E("mg_glMultiDrawElementsBaseVertex_compute: invalid index buffer size, fallback")
         mg_glMultiDrawElementsBaseVertex_drawelements(mode, counts, type, indices, primcount, basevertex);
         return;
@@ -593,25 +576,24 @@ GLAPI GLAPIENTRY void mg_glMultiDrawElementsBaseVertex_compute(GLenum mode, GLsi
         return;
     }
 
-    g_prefix_sum.resize(primcount);
-    std::vector<GLuint> first_index(primcount, 0);
-    std::vector<GLint> base_vtx(primcount, 0);
-
-    uint64_t running = 0;
+    // Only validation and packing happen on the CPU; the offsets of each
+    // draw in the output buffer are scanned on the GPU.
+    g_compute_draws.resize(primcount);
+    uint64_t total = 0;
     for (GLsizei i = 0; i < primcount; ++i) {
         GLsizei c = counts[i];
         if (c < 0) {
             LOG_E("mg_glMultiDrawElementsBaseVertex_compute: negative count at %d", i)
             c = 0;
         }
-        running += static_cast<uint64_t>(c);
-        if (running > static_cast<uint64_t>(std::numeric_limits<GLuint>::max())) {
+        total += static_cast<uint64_t>(c);
+        if (total > static_cast<uint64_t>(std::numeric_limits<GLuint>::max())) {
             LOG_E("mg_glMultiDrawElementsBaseVertex_compute: total index count overflow, fallback")
             mg_glMultiDrawElementsBaseVertex_drawelements(mode, counts, type, indices, primcount, basevertex);
             return;
         }
-        g_prefix_sum[i] = static_cast<GLuint>(running);
 
+        GLuint firstIndex = 0;
         if (c > 0) {
             if (!indices[i]) {
                 LOG_E("mg_glMultiDrawElementsBaseVertex_compute: indices[%d] is null", i)
@@ -623,125 +605,65 @@ GLAPI GLAPIENTRY void mg_glMultiDrawElementsBaseVertex_compute(GLenum mode, GLsi
             if ((byteOffset % elementSize) != 0) {
                 LOG_E("mg_glMultiDrawElementsBaseVertex_compute: misaligned index offset at %d", i)
             }
-            if (byteOffset64 > static_cast<uint64_t>(ibo_size)) {
-                LOG_E("mg_glMultiDrawElementsBaseVertex_compute: index offset out of range at %d", i)
-                mg_glMultiDrawElementsBaseVertex_drawelements(mode, counts, type, indices, primcount, basevertex);
-                return;
-            }
             uint64_t byteEnd = byteOffset64 + static_cast<uint64_t>(c) * elementSize;
-            if (byteEnd > static_cast<uint64_t>(ibo_size)) {
+            if (byteOffset64 > static_cast<uint64_t>(ibo_size) || byteEnd > static_cast<uint64_t>(ibo_size)) {
                 LOG_E("mg_glMultiDrawElementsBaseVertex_compute: index range out of bounds at %d", i)
                 mg_glMultiDrawElementsBaseVertex_drawelements(mode, counts, type, indices, primcount, basevertex);
                 return;
             }
-            uint64_t elementOffset = byteOffset64 / elementSize;
-            if (elementOffset > static_cast<uint64_t>(std::numeric_limits<GLuint>::max())) {
-                LOG_E("mg_glMultiDrawElementsBaseVertex_compute: index offset overflow at %d", i)
-                mg_glMultiDrawElementsBaseVertex_drawelements(mode, counts, type, indices, primcount, basevertex);
-                return;
-            }
-            first_index[i] = static_cast<GLuint>(elementOffset);
+            firstIndex = static_cast<GLuint>(byteOffset64 / elementSize);
         }
 
-        if (basevertex) {
-            base_vtx[i] = basevertex[i];
-        }
+        g_compute_draws[i] = {static_cast<GLuint>(c), firstIndex, basevertex ? basevertex[i] : 0, 0};
     }
 
-    auto total_indices = g_prefix_sum[primcount - 1];
-    if (total_indices == 0) {
+    if (total == 0) {
         return;
     }
 
-    GLint prev_ssbo_binding = 0;
-    GLES.glGetIntegerv(GL_SHADER_STORAGE_BUFFER_BINDING, &prev_ssbo_binding);
-    CHECK_GL_ERROR_NO_INIT
-
-    // Fill in the data
-    GLES.glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_firstidx_ssbo);
+    // Upload draws into the persistent SSBO, growing the buffers if needed
+    const size_t drawsSize = sizeof(multidraw_compute_draw_t) * primcount;
+    grow_compute_buffer(GL_SHADER_STORAGE_BUFFER, g_draws_ssbo, g_draws_capacity, drawsSize, GL_DYNAMIC_DRAW);
+    GLES.glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_draws_ssbo);
+    GLES.glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, (GLsizeiptr)drawsSize, g_compute_draws.data());
     CHECK_GL_ERROR_NO_INIT
-    GLES.glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * primcount, first_index.data(), GL_DYNAMIC_DRAW);
+    grow_compute_buffer(GL_SHADER_STORAGE_BUFFER, g_outputibo, g_output_capacity, sizeof(GLuint) * total,
+                        GL_DYNAMIC_COPY);
     CHECK_GL_ERROR_NO_INIT
 
-    GLES.glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_basevtx_ssbo);
-    CHECK_GL_ERROR_NO_INIT
-    GLES.glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLint) * primcount, base_vtx.data(), GL_DYNAMIC_DRAW);
-    CHECK_GL_ERROR_NO_INIT
-
-    GLES.glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_prefixsumbuffer);
-    CHECK_GL_ERROR_NO_INIT
-    GLES.glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * primcount, g_prefix_sum.data(), GL_DYNAMIC_DRAW);
-    CHECK_GL_ERROR_NO_INIT
-
-    // Allocate output buffer
-    GLES.glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_outputibo);
-    CHECK_GL_ERROR_NO_INIT
-    GLES.glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * total_indices, nullptr, GL_DYNAMIC_DRAW);
-    CHECK_GL_ERROR_NO_INIT
-
-    GLES.glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-    CHECK_GL_ERROR_NO_INIT
-
-    // Bind buffers
-    GLint prev_ssbo_base[5] = {};
-    for (int i = 0; i < 5; ++i) {
-        GLES.glGetIntegeri_v(GL_SHADER_STORAGE_BUFFER_BINDING, i, &prev_ssbo_base[i]);
-        CHECK_GL_ERROR_NO_INIT
-    }
-
     GLES.glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ibo);
-    CHECK_GL_ERROR_NO_INIT
-    GLES.glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, g_firstidx_ssbo);
-    CHECK_GL_ERROR_NO_INIT
-    GLES.glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, g_basevtx_ssbo);
-    CHECK_GL_ERROR_NO_INIT
-    GLES.glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, g_prefixsumbuffer);
-    CHECK_GL_ERROR_NO_INIT
-    GLES.glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, g_outputibo);
+    GLES.glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, g_draws_ssbo, 0, (GLsizeiptr)drawsSize);
+    GLES.glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, g_outputibo);
     CHECK_GL_ERROR_NO_INIT
 
-    // Save states
-    GLint prev_program = 0;
-    GLES.glGetIntegerv(GL_CURRENT_PROGRAM, &prev_program);
-    CHECK_GL_ERROR_NO_INIT
-    GLint prev_vb = 0;
-    GLES.glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &prev_vb);
+    // Pass 1: exclusive scan of the counts
+    GLES.glUseProgram(g_scan_program);
+    GLES.glUniform1ui(MULTIDRAW_SCAN_DRAW_COUNT_LOC, (GLuint)primcount);
+    GLES.glDispatchCompute(1, 1, 1);
+    GLES.glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
     CHECK_GL_ERROR_NO_INIT
 
-    // Dispatch compute
+    // Pass 2: one work group per draw copies its indices to its range
+    const GLuint groupsX = std::min<GLuint>((GLuint)primcount, MULTIDRAW_MAX_GROUPS_X);
+    const GLuint groupsY = ((GLuint)primcount + groupsX - 1) / groupsX;
     LOG_D("Using compute program = %d", g_compute_program)
     GLES.glUseProgram(g_compute_program);
-    CHECK_GL_ERROR_NO_INIT
-    if (g_element_size_loc >= 0) {
-        GLES.glUniform1ui(g_element_size_loc, elementSize);
-        CHECK_GL_ERROR_NO_INIT
-    }
-    LOG_D("Dispatch compute")
-    GLES.glDispatchCompute((total_indices + 63) / 64, 1, 1);
+    GLES.glUniform1ui(MULTIDRAW_EXPAND_DRAW_COUNT_LOC, (GLuint)primcount);
+    GLES.glUniform1ui(MULTIDRAW_EXPAND_ELEMENT_SIZE_LOC, elementSize);
+    GLES.glDispatchCompute(groupsX, groupsY, 1);
+    GLES.glMemoryBarrier(GL_ELEMENT_ARRAY_BARRIER_BIT);
     CHECK_GL_ERROR_NO_INIT
 
-    // Wait for compute to complete
-    LOG_D("memory barrier")
-    GLES.glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT);
-    CHECK_GL_ERROR_NO_INIT
+    // Restore the application's state from what we track, then draw
+    GLES.glUseProgram(gl_state->current_program);
+    for (GLuint i = 0; i < 3; ++i) {
+        restore_ssbo_binding(i);
+    }
+    GLES.glBindBuffer(GL_SHADER_STORAGE_BUFFER, find_real_bound_buffer(GL_SHADER_STORAGE_BUFFER_BINDING));
 
-    // Bind index buffer and do draw
     LOG_D("draw")
-    GLES.glUseProgram(prev_program);
-    CHECK_GL_ERROR_NO_INIT
-    GLES.glBindBuffer(GL_ARRAY_BUFFER, prev_vb);
-    CHECK_GL_ERROR_NO_INIT
     GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_outputibo);
-    CHECK_GL_ERROR_NO_INIT
-    GLES.glDrawElements(mode, total_indices, GL_UNSIGNED_INT, 0);
-
-    // Restore states
-    for (int i = 0; i < 5; ++i) {
-        GLES.glBindBufferBase(GL_SHADER_STORAGE_BUFFER, i, prev_ssbo_base[i]);
-        CHECK_GL_ERROR_NO_INIT
-    }
-    GLES.glBindBuffer(GL_SHADER_STORAGE_BUFFER, prev_ssbo_binding);
-    CHECK_GL_ERROR_NO_INIT
+    GLES.glDrawElements(mode, (GLsizei)total, GL_UNSIGNED_INT, 0);
     GLES.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
     CHECK_GL_ERROR_NO_INIT
 }
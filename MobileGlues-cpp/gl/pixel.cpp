@@ -8,6 +8,21 @@
 #include "pixel.h"
 #include "log.h"
 #include "mg.h"
+#include "buffer.h"
+#include "../gles/loader.h"
+#include "ankerl/unordered_dense.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PIXEL_SIMD_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define PIXEL_SIMD_SSE2 1
+#endif
 
 #define DEBUG 0
 
@@ -574,3 +589,647 @@ bool pixel_convert(const GLvoid* src, GLvoid** dst, GLuint width, GLuint height,
     }
     return true;
 }
+
+// Conversion engine for uploads and readbacks GLES cannot take natively.
+// Each kernel is written once against a small vector interface and
+// instantiated for NEON, SSE2 and plain scalar code; rows are converted in
+// SIMD blocks with a scalar tail.
+
+namespace {
+    template <typename T> struct Scalar {
+        T v;
+        static constexpr int lanes = 1;
+        static Scalar load(const GLubyte* p) {
+            Scalar s;
+            memcpy(&s.v, p, sizeof(T));
+            return s;
+        }
+        void store(GLubyte* p) const { memcpy(p, &v, sizeof(T)); }
+        static Scalar splat(uint32_t x) { return {(T)x}; }
+        template <int N> Scalar shl() const { return {(T)(v << N)}; }
+        template <int N> Scalar shr() const { return {(T)(v >> N)}; }
+        Scalar operator&(Scalar o) const { return {(T)(v & o.v)}; }
+        Scalar operator|(Scalar o) const { return {(T)(v | o.v)}; }
+        Scalar operator+(Scalar o) const { return {(T)(v + o.v)}; }
+        Scalar operator*(Scalar o) const { return {(T)(v * o.v)}; }
+    };
+
+#if PIXEL_SIMD_NEON
+    struct Vec32 {
+        uint32x4_t v;
+        static constexpr int lanes = 4;
+        static Vec32 load(const GLubyte* p) { return {vreinterpretq_u32_u8(vld1q_u8(p))}; }
+        void store(GLubyte* p) const { vst1q_u8(p, vreinterpretq_u8_u32(v)); }
+        static Vec32 splat(uint32_t x) { return {vdupq_n_u32(x)}; }
+        template <int N> Vec32 shl() const { return {vshlq_n_u32(v, N)}; }
+        template <int N> Vec32 shr() const { return {vshrq_n_u32(v, N)}; }
+        Vec32 operator&(Vec32 o) const { return {vandq_u32(v, o.v)}; }
+        Vec32 operator|(Vec32 o) const { return {vorrq_u32(v, o.v)}; }
+    };
+    struct Vec16 {
+        uint16x8_t v;
+        static constexpr int lanes = 8;
+        static Vec16 load(const GLubyte* p) { return {vreinterpretq_u16_u8(vld1q_u8(p))}; }
+        void store(GLubyte* p) const { vst1q_u8(p, vreinterpretq_u8_u16(v)); }
+        static Vec16 splat(uint32_t x) { return {vdupq_n_u16((uint16_t)x)}; }
+        template <int N> Vec16 shl() const { return {vshlq_n_u16(v, N)}; }
+        template <int N> Vec16 shr() const { return {vshrq_n_u16(v, N)}; }
+        Vec16 operator&(Vec16 o) const { return {vandq_u16(v, o.v)}; }
+        Vec16 operator|(Vec16 o) const { return {vorrq_u16(v, o.v)}; }
+        Vec16 operator+(Vec16 o) const { return {vaddq_u16(v, o.v)}; }
+        Vec16 operator*(Vec16 o) const { return {vmulq_u16(v, o.v)}; }
+    };
+#elif PIXEL_SIMD_SSE2
+    struct Vec32 {
+        __m128i v;
+        static constexpr int lanes = 4;
+        static Vec32 load(const GLubyte* p) { return {_mm_loadu_si128((const __m128i*)p)}; }
+        void store(GLubyte* p) const { _mm_storeu_si128((__m128i*)p, v); }
+        static Vec32 splat(uint32_t x) { return {_mm_set1_epi32((int)x)}; }
+        template <int N> Vec32 shl() const { return {_mm_slli_epi32(v, N)}; }
+        template <int N> Vec32 shr() const { return {_mm_srli_epi32(v, N)}; }
+        Vec32 operator&(Vec32 o) const { return {_mm_and_si128(v, o.v)}; }
+        Vec32 operator|(Vec32 o) const { return {_mm_or_si128(v, o.v)}; }
+    };
+    struct Vec16 {
+        __m128i v;
+        static constexpr int lanes = 8;
+        static Vec16 load(const GLubyte* p) { return {_mm_loadu_si128((const __m128i*)p)}; }
+        void store(GLubyte* p) const { _mm_storeu_si128((__m128i*)p, v); }
+        static Vec16 splat(uint32_t x) { return {_mm_set1_epi16((short)x)}; }
+        template <int N> Vec16 shl() const { return {_mm_slli_epi16(v, N)}; }
+        template <int N> Vec16 shr() const { return {_mm_srli_epi16(v, N)}; }
+        Vec16 operator&(Vec16 o) const { return {_mm_and_si128(v, o.v)}; }
+        Vec16 operator|(Vec16 o) const { return {_mm_or_si128(v, o.v)}; }
+        Vec16 operator+(Vec16 o) const { return {_mm_add_epi16(v, o.v)}; }
+        Vec16 operator*(Vec16 o) const { return {_mm_mullo_epi16(v, o.v)}; }
+    };
+#else
+    using Vec32 = Scalar<uint32_t>;
+    using Vec16 = Scalar<uint16_t>;
+#endif
+
+    template <int N, typename V> V shl(V v) { return v.template shl<N>(); }
+    template <int N, typename V> V shr(V v) { return v.template shr<N>(); }
+
+    // 32-bit pixels, as loaded on a little endian CPU
+
+    // [B,G,R,A] <-> [R,G,B,A]
+    struct SwapRB8888 {
+        template <typename V> static V apply(V v) {
+            return (v & V::splat(0xFF00FF00u)) | (shr<16>(v) & V::splat(0xFFu)) | shl<16>(v & V::splat(0xFFu));
+        }
+    };
+    // BGRA/8888 [A,R,G,B] -> [R,G,B,A]
+    struct RotateRight8 {
+        template <typename V> static V apply(V v) { return shr<8>(v) | shl<24>(v); }
+    };
+    struct RotateLeft8 {
+        template <typename V> static V apply(V v) { return shl<8>(v) | shr<24>(v); }
+    };
+    // RGBA/8888 [A,B,G,R] <-> [R,G,B,A]
+    struct Reverse8888 {
+        template <typename V> static V apply(V v) {
+            return shl<24>(v) | (shl<8>(v) & V::splat(0x00FF0000u)) | (shr<8>(v) & V::splat(0x0000FF00u)) |
+                   shr<24>(v);
+        }
+    };
+
+    // 16-bit pixels, all converted to the ES RGBA 5551 / 4444 / RGB 565 layouts
+
+    struct Bgra1555RevTo5551 {
+        template <typename V> static V apply(V v) { return shl<1>(v) | shr<15>(v); }
+    };
+    struct Rgba1555RevTo5551 {
+        template <typename V> static V apply(V v) {
+            return shl<11>(v) | (shl<1>(v) & V::splat(0x07C0)) | (shr<9>(v) & V::splat(0x003E)) | shr<15>(v);
+        }
+    };
+    struct Bgra5551To5551 {
+        template <typename V> static V apply(V v) {
+            return (v & V::splat(0x07C1)) | (shr<10>(v) & V::splat(0x003E)) | shl<10>(v & V::splat(0x003E));
+        }
+    };
+    struct Bgra4444RevTo4444 {
+        template <typename V> static V apply(V v) { return shl<4>(v) | shr<12>(v); }
+    };
+    struct Rgba4444RevTo4444 {
+        template <typename V> static V apply(V v) {
+            return shl<12>(v) | (shl<4>(v) & V::splat(0x0F00)) | (shr<4>(v) & V::splat(0x00F0)) | shr<12>(v);
+        }
+    };
+    struct Bgra4444To4444 {
+        template <typename V> static V apply(V v) {
+            return (v & V::splat(0x0F0F)) | (shr<8>(v) & V::splat(0x00F0)) | (shl<8>(v) & V::splat(0xF000));
+        }
+    };
+    // RGB/565_REV and BGR/565 -> RGB/565
+    struct Swap565 {
+        template <typename V> static V apply(V v) { return (v & V::splat(0x07E0)) | shr<11>(v) | shl<11>(v); }
+    };
+
+    // 16-bit ES layouts widened to RGBA8 for textures stored that way. The
+    // channels are rounded like the GL normalized conversion, c * 255 / max.
+
+    template <typename V> V widen4(V x) { return x * V::splat(17); }
+    template <typename V> V widen5(V x) { return shr<6>(x * V::splat(527) + V::splat(23)); }
+    template <typename V> V widen6(V x) { return shr<6>(x * V::splat(259) + V::splat(33)); }
+
+    // Narrows vectors of 8-bit channel values to interleaved RGBA8
+    void store_rgba8(Scalar<uint16_t> r, Scalar<uint16_t> g, Scalar<uint16_t> b, Scalar<uint16_t> a, GLubyte* dst) {
+        dst[0] = (GLubyte)r.v;
+        dst[1] = (GLubyte)g.v;
+        dst[2] = (GLubyte)b.v;
+        dst[3] = (GLubyte)a.v;
+    }
+#if PIXEL_SIMD_NEON
+    void store_rgba8(Vec16 r, Vec16 g, Vec16 b, Vec16 a, GLubyte* dst) {
+        uint8x8x4_t out = {{vmovn_u16(r.v), vmovn_u16(g.v), vmovn_u16(b.v), vmovn_u16(a.v)}};
+        vst4_u8(dst, out);
+    }
+#elif PIXEL_SIMD_SSE2
+    void store_rgba8(Vec16 r, Vec16 g, Vec16 b, Vec16 a, GLubyte* dst) {
+        __m128i rg = _mm_or_si128(r.v, _mm_slli_epi16(g.v, 8));
+        __m128i ba = _mm_or_si128(b.v, _mm_slli_epi16(a.v, 8));
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(rg, ba));
+    }
+#endif
+
+    struct Widen5551 {
+        template <typename V> static void apply(V v, GLubyte* dst) {
+            const V mask = V::splat(0x1F);
+            store_rgba8(widen5(shr<11>(v)), widen5(shr<6>(v) & mask), widen5(shr<1>(v) & mask),
+                        (v & V::splat(1)) * V::splat(0xFF), dst);
+        }
+    };
+    struct Widen4444 {
+        template <typename V> static void apply(V v, GLubyte* dst) {
+            const V mask = V::splat(0xF);
+            store_rgba8(widen4(shr<12>(v)), widen4(shr<8>(v) & mask), widen4(shr<4>(v) & mask), widen4(v & mask),
+                        dst);
+        }
+    };
+    struct Widen565 {
+        template <typename V> static void apply(V v, GLubyte* dst) {
+            store_rgba8(widen5(shr<11>(v)), widen6(shr<5>(v) & V::splat(0x3F)), widen5(v & V::splat(0x1F)),
+                        V::splat(0xFF), dst);
+        }
+    };
+    // Client data already in the ES layout
+    struct Same {
+        template <typename V> static V apply(V v) { return v; }
+    };
+
+    template <typename Op, typename T, typename V> void convert_row(const GLubyte* src, GLubyte* dst, GLsizei width) {
+        GLsizei i = 0;
+        for (; i + V::lanes <= width; i += V::lanes)
+            Op::apply(V::load(src + i * sizeof(T))).store(dst + i * sizeof(T));
+        for (; i < width; ++i)
+            Op::apply(Scalar<T>::load(src + i * sizeof(T))).store(dst + i * sizeof(T));
+    }
+
+    // Op moves the client pixel to the ES 16-bit layout first
+    template <typename Op, typename Widen> void widen_row(const GLubyte* src, GLubyte* dst, GLsizei width) {
+        GLsizei i = 0;
+        for (; i + Vec16::lanes <= width; i += Vec16::lanes)
+            Widen::apply(Op::apply(Vec16::load(src + i * 2)), dst + i * 4);
+        for (; i < width; ++i)
+            Widen::apply(Op::apply(Scalar<uint16_t>::load(src + i * 2)), dst + i * 4);
+    }
+
+    void bgr_to_rgb_row(const GLubyte* src, GLubyte* dst, GLsizei width) {
+        for (GLsizei i = 0; i < width; ++i, src += 3, dst += 3) {
+            GLubyte b = src[0];
+            dst[0] = src[2];
+            dst[1] = src[1];
+            dst[2] = b;
+        }
+    }
+
+    // SSE2 has no byte shuffle to regroup 3-byte pixels, so only NEON
+    // gets a vector loop here
+    template <bool SwapRB> void rgb_to_rgba_row(const GLubyte* src, GLubyte* dst, GLsizei width) {
+        GLsizei i = 0;
+#if PIXEL_SIMD_NEON
+        for (; i + 16 <= width; i += 16) {
+            uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+            uint8x16x4_t out = {{rgb.val[SwapRB ? 2 : 0], rgb.val[1], rgb.val[SwapRB ? 0 : 2], vdupq_n_u8(0xFF)}};
+            vst4q_u8(dst + i * 4, out);
+        }
+#endif
+        for (; i < width; ++i) {
+            dst[i * 4 + 0] = src[i * 3 + (SwapRB ? 2 : 0)];
+            dst[i * 4 + 1] = src[i * 3 + 1];
+            dst[i * 4 + 2] = src[i * 3 + (SwapRB ? 0 : 2)];
+            dst[i * 4 + 3] = 0xFF;
+        }
+    }
+
+    void luminance_to_rgba_row(const GLubyte* src, GLubyte* dst, GLsizei width) {
+        GLsizei i = 0;
+#if PIXEL_SIMD_NEON
+        for (; i + 16 <= width; i += 16) {
+            uint8x16_t l = vld1q_u8(src + i);
+            uint8x16x4_t out = {{l, l, l, vdupq_n_u8(0xFF)}};
+            vst4q_u8(dst + i * 4, out);
+        }
+#elif PIXEL_SIMD_SSE2
+        const __m128i alpha = _mm_set1_epi32((int)0xFF000000u);
+        for (; i + 16 <= width; i += 16) {
+            __m128i l = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i lo = _mm_unpacklo_epi8(l, l);
+            __m128i hi = _mm_unpackhi_epi8(l, l);
+            _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(_mm_unpacklo_epi16(lo, lo), alpha));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_or_si128(_mm_unpackhi_epi16(lo, lo), alpha));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 32), _mm_or_si128(_mm_unpacklo_epi16(hi, hi), alpha));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 48), _mm_or_si128(_mm_unpackhi_epi16(hi, hi), alpha));
+        }
+#endif
+        for (; i < width; ++i) {
+            dst[i * 4 + 0] = dst[i * 4 + 1] = dst[i * 4 + 2] = src[i];
+            dst[i * 4 + 3] = 0xFF;
+        }
+    }
+
+    void alpha_to_rgba_row(const GLubyte* src, GLubyte* dst, GLsizei width) {
+        GLsizei i = 0;
+#if PIXEL_SIMD_NEON
+        for (; i + 16 <= width; i += 16) {
+            uint8x16_t zero = vdupq_n_u8(0);
+            uint8x16x4_t out = {{zero, zero, zero, vld1q_u8(src + i)}};
+            vst4q_u8(dst + i * 4, out);
+        }
+#elif PIXEL_SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= width; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i lo = _mm_unpacklo_epi8(zero, a);
+            __m128i hi = _mm_unpackhi_epi8(zero, a);
+            _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_unpacklo_epi16(zero, lo));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_unpackhi_epi16(zero, lo));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 32), _mm_unpacklo_epi16(zero, hi));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 48), _mm_unpackhi_epi16(zero, hi));
+        }
+#endif
+        for (; i < width; ++i) {
+            dst[i * 4 + 0] = dst[i * 4 + 1] = dst[i * 4 + 2] = 0;
+            dst[i * 4 + 3] = src[i];
+        }
+    }
+
+    void luminance_alpha_to_rgba_row(const GLubyte* src, GLubyte* dst, GLsizei width) {
+        GLsizei i = 0;
+#if PIXEL_SIMD_NEON
+        for (; i + 16 <= width; i += 16) {
+            uint8x16x2_t la = vld2q_u8(src + i * 2);
+            uint8x16x4_t out = {{la.val[0], la.val[0], la.val[0], la.val[1]}};
+            vst4q_u8(dst + i * 4, out);
+        }
+#elif PIXEL_SIMD_SSE2
+        const __m128i lowByte = _mm_set1_epi16(0x00FF);
+        for (; i + 8 <= width; i += 8) {
+            __m128i la = _mm_loadu_si128((const __m128i*)(src + i * 2));
+            __m128i l = _mm_and_si128(la, lowByte);
+            __m128i ll = _mm_or_si128(l, _mm_slli_epi16(l, 8));
+            _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_unpacklo_epi16(ll, la));
+            _mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_unpackhi_epi16(ll, la));
+        }
+#endif
+        for (; i < width; ++i) {
+            dst[i * 4 + 0] = dst[i * 4 + 1] = dst[i * 4 + 2] = src[i * 2];
+            dst[i * 4 + 3] = src[i * 2 + 1];
+        }
+    }
+
+#define ROW32(op) convert_row<op, uint32_t, Vec32>
+#define ROW16(op) convert_row<op, uint16_t, Vec16>
+#define WIDEN(op, widen) widen_row<op, widen>
+
+    const pixel_conversion_t kPixelConversions[] = {
+        // format, type, es_format, es_type, size, es_size, same_bytes, expand, unpack, pack
+        {GL_BGRA, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_BYTE, 4, 4, false, false, ROW32(SwapRB8888),
+         ROW32(SwapRB8888)},
+        {GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, GL_RGBA, GL_UNSIGNED_BYTE, 4, 4, false, false, ROW32(SwapRB8888),
+         ROW32(SwapRB8888)},
+        {GL_BGRA, GL_UNSIGNED_INT_8_8_8_8, GL_RGBA, GL_UNSIGNED_BYTE, 4, 4, false, false, ROW32(RotateRight8),
+         ROW32(RotateLeft8)},
+        {GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, GL_RGBA, GL_UNSIGNED_BYTE, 4, 4, false, false, ROW32(Reverse8888),
+         ROW32(Reverse8888)},
+        {GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV, GL_RGBA, GL_UNSIGNED_BYTE, 4, 4, true, false, nullptr, nullptr},
+        // Textures stored as RGBA8 take everything widened to RGBA/UNSIGNED_BYTE.
+        // These come first so they win over the 16-bit ES layouts below.
+        {GL_BGRA, GL_UNSIGNED_SHORT_1_5_5_5_REV, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true,
+         WIDEN(Bgra1555RevTo5551, Widen5551), nullptr},
+        {GL_RGBA, GL_UNSIGNED_SHORT_1_5_5_5_REV, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true,
+         WIDEN(Rgba1555RevTo5551, Widen5551), nullptr},
+        {GL_BGRA, GL_UNSIGNED_SHORT_5_5_5_1, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true,
+         WIDEN(Bgra5551To5551, Widen5551), nullptr},
+        {GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true, WIDEN(Same, Widen5551),
+         nullptr},
+        {GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4_REV, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true,
+         WIDEN(Bgra4444RevTo4444, Widen4444), nullptr},
+        {GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4_REV, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true,
+         WIDEN(Rgba4444RevTo4444, Widen4444), nullptr},
+        {GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true,
+         WIDEN(Bgra4444To4444, Widen4444), nullptr},
+        {GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true, WIDEN(Same, Widen4444),
+         nullptr},
+        {GL_RGB, GL_UNSIGNED_SHORT_5_6_5, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true, WIDEN(Same, Widen565),
+         nullptr},
+        {GL_RGB, GL_UNSIGNED_SHORT_5_6_5_REV, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true, WIDEN(Swap565, Widen565),
+         nullptr},
+        {GL_BGR, GL_UNSIGNED_SHORT_5_6_5, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true, WIDEN(Swap565, Widen565),
+         nullptr},
+        {GL_BGR, GL_UNSIGNED_SHORT_5_6_5_REV, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true, WIDEN(Same, Widen565),
+         nullptr},
+        {GL_RGB, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_BYTE, 3, 4, false, true, rgb_to_rgba_row<false>, nullptr},
+        {GL_BGR, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_BYTE, 3, 4, false, true, rgb_to_rgba_row<true>, nullptr},
+        {GL_BGRA, GL_UNSIGNED_SHORT_1_5_5_5_REV, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1, 2, 2, false, false,
+         ROW16(Bgra1555RevTo5551), nullptr},
+        {GL_RGBA, GL_UNSIGNED_SHORT_1_5_5_5_REV, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1, 2, 2, false, false,
+         ROW16(Rgba1555RevTo5551), nullptr},
+        {GL_BGRA, GL_UNSIGNED_SHORT_5_5_5_1, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1, 2, 2, false, false,
+         ROW16(Bgra5551To5551), nullptr},
+        {GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4_REV, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, 2, 2, false, false,
+         ROW16(Bgra4444RevTo4444), nullptr},
+        {GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4_REV, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, 2, 2, false, false,
+         ROW16(Rgba4444RevTo4444), nullptr},
+        {GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, 2, 2, false, false,
+         ROW16(Bgra4444To4444), nullptr},
+        {GL_RGB, GL_UNSIGNED_SHORT_5_6_5_REV, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, 2, 2, false, false, ROW16(Swap565),
+         nullptr},
+        {GL_BGR, GL_UNSIGNED_SHORT_5_6_5, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, 2, 2, false, false, ROW16(Swap565),
+         nullptr},
+        {GL_BGR, GL_UNSIGNED_SHORT_5_6_5_REV, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, 2, 2, true, false, nullptr, nullptr},
+        {GL_BGR, GL_UNSIGNED_BYTE, GL_RGB, GL_UNSIGNED_BYTE, 3, 3, false, false, bgr_to_rgb_row, nullptr},
+        {GL_LUMINANCE, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_BYTE, 1, 4, false, true, luminance_to_rgba_row, nullptr},
+        {GL_ALPHA, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_BYTE, 1, 4, false, true, alpha_to_rgba_row, nullptr},
+        {GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_BYTE, 2, 4, false, true,
+         luminance_alpha_to_rgba_row, nullptr},
+    };
+
+#undef ROW32
+#undef ROW16
+#undef WIDEN
+
+    struct PixelStoreParam {
+        GLenum pname;
+        GLint gl_pixel_store_s::*field;
+        GLint tight;
+    };
+
+    const PixelStoreParam kUnpackParams[] = {
+        {GL_UNPACK_ALIGNMENT, &gl_pixel_store_s::alignment, 1},
+        {GL_UNPACK_ROW_LENGTH, &gl_pixel_store_s::row_length, 0},
+        {GL_UNPACK_IMAGE_HEIGHT, &gl_pixel_store_s::image_height, 0},
+        {GL_UNPACK_SKIP_PIXELS, &gl_pixel_store_s::skip_pixels, 0},
+        {GL_UNPACK_SKIP_ROWS, &gl_pixel_store_s::skip_rows, 0},
+        {GL_UNPACK_SKIP_IMAGES, &gl_pixel_store_s::skip_images, 0},
+    };
+
+    const PixelStoreParam kPackParams[] = {
+        {GL_PACK_ALIGNMENT, &gl_pixel_store_s::alignment, 1},
+        {GL_PACK_ROW_LENGTH, &gl_pixel_store_s::row_length, 0},
+        {GL_PACK_SKIP_PIXELS, &gl_pixel_store_s::skip_pixels, 0},
+        {GL_PACK_SKIP_ROWS, &gl_pixel_store_s::skip_rows, 0},
+    };
+
+    // Switches GLES between the application's pixel store state and a tightly
+    // packed one, touching only the parameters that differ
+    template <size_t N>
+    void set_pixel_store(const PixelStoreParam (&params)[N], const gl_pixel_store_s& state, bool tight) {
+        for (const auto& p : params) {
+            if (state.*p.field != p.tight) GLES.glPixelStorei(p.pname, tight ? p.tight : state.*p.field);
+        }
+    }
+
+    struct PixelLayout {
+        size_t rowBytes;
+        size_t imageBytes;
+        size_t first;
+        size_t span;
+    };
+
+    PixelLayout get_pixel_layout(const gl_pixel_store_s& store, GLsizei size, GLsizei width, GLsizei height,
+                                 GLsizei depth) {
+        PixelLayout layout{};
+        layout.rowBytes = widthalign((size_t)(store.row_length > 0 ? store.row_length : width) * size, store.alignment);
+        layout.imageBytes = layout.rowBytes * (depth > 0 && store.image_height > 0 ? store.image_height : height);
+        layout.first = (size_t)store.skip_rows * layout.rowBytes + (size_t)store.skip_pixels * size;
+        if (depth > 0) layout.first += (size_t)store.skip_images * layout.imageBytes;
+        layout.span = layout.first + (size_t)(depth > 1 ? depth - 1 : 0) * layout.imageBytes +
+                      (size_t)(height - 1) * layout.rowBytes + (size_t)width * size;
+        return layout;
+    }
+
+    thread_local std::vector<GLubyte> g_pixel_scratch;
+
+    // A converted readback that landed in a pack buffer as the ES pair
+    struct PendingPack {
+        size_t first;
+        size_t rowBytes;
+        GLsizei width, height, size;
+        pixel_row_fn pack;
+
+        size_t end() const { return first + (size_t)(height - 1) * rowBytes + (size_t)width * size; }
+    };
+
+    ankerl::unordered_dense::map<GLuint, std::vector<PendingPack>> g_pending_packs;
+
+    // Before a readback into `buffer`: a pending conversion the read writes
+    // over exactly is dropped, anything else it touches is converted first
+    void pack_buffer_overwrite(GLuint buffer, const void* pixels, GLsizei width, GLsizei height, GLsizei size) {
+        const PixelLayout layout = get_pixel_layout(gl_state->pack, size, width, height, 0);
+        const size_t first = (size_t)pixels + layout.first;
+        auto it = g_pending_packs.find(buffer);
+        if (it == g_pending_packs.end()) return;
+        auto& pending = it->second;
+        pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                     [&](const PendingPack& p) {
+                                         return p.first == first && p.rowBytes == layout.rowBytes &&
+                                                p.width == width && p.height == height && p.size == size;
+                                     }),
+                      pending.end());
+        if (pending.empty()) {
+            g_pending_packs.erase(it);
+            return;
+        }
+        pack_buffer_resolve(buffer, (GLintptr)pixels, (GLsizeiptr)layout.span);
+    }
+} // namespace
+
+void pack_buffer_resolve(GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    if (g_pending_packs.empty()) return;
+    auto it = g_pending_packs.find(buffer);
+    if (it == g_pending_packs.end()) return;
+
+    const size_t begin = (size_t)offset;
+    const size_t end = size < 0 ? SIZE_MAX : begin + (size_t)size;
+    auto& pending = it->second;
+    auto overlaps = [&](const PendingPack& p) { return p.first < end && p.end() > begin; };
+    size_t lo = SIZE_MAX, hi = 0;
+    for (const PendingPack& p : pending) {
+        if (!overlaps(p)) continue;
+        lo = std::min(lo, p.first);
+        hi = std::max(hi, p.end());
+    }
+    if (lo >= hi) return;
+
+    // Waits for the reads, so this only happens once the application needs the data
+    GLuint realBuffer = find_real_buffer(buffer);
+    GLuint bound = find_real_bound_buffer(GL_PIXEL_PACK_BUFFER_BINDING);
+    if (bound != realBuffer) GLES.glBindBuffer(GL_PIXEL_PACK_BUFFER, realBuffer);
+    auto* data = static_cast<GLubyte*>(GLES.glMapBufferRange(GL_PIXEL_PACK_BUFFER, (GLintptr)lo, (GLsizeiptr)(hi - lo),
+                                                             GL_MAP_READ_BIT | GL_MAP_WRITE_BIT));
+    if (data) {
+        for (const PendingPack& p : pending) {
+            if (!overlaps(p)) continue;
+            for (GLsizei row = 0; row < p.height; ++row) {
+                GLubyte* line = data + (p.first - lo) + row * p.rowBytes;
+                p.pack(line, line, p.width);
+            }
+        }
+        GLES.glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        LOG_E("pack_buffer_resolve: cannot map buffer %u", buffer)
+    }
+    if (bound != realBuffer) GLES.glBindBuffer(GL_PIXEL_PACK_BUFFER, bound);
+
+    pending.erase(std::remove_if(pending.begin(), pending.end(), overlaps), pending.end());
+    if (pending.empty()) g_pending_packs.erase(it);
+}
+
+void pack_buffer_forget(GLuint buffer) {
+    if (!g_pending_packs.empty()) g_pending_packs.erase(buffer);
+}
+
+void pack_buffer_before_read(GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) {
+    if (g_pending_packs.empty() || width <= 0 || height <= 0) return;
+    GLuint buffer = find_bound_buffer(GL_PIXEL_PACK_BUFFER_BINDING);
+    GLsizei size = pixel_sizeof(format, type);
+    if (!buffer) return;
+    if (size > 0)
+        pack_buffer_overwrite(buffer, pixels, width, height, size);
+    else
+        pack_buffer_resolve(buffer, 0, -1);
+}
+
+const pixel_conversion_t* find_pixel_conversion(GLenum format, GLenum type, bool expand) {
+#ifndef __BIG_ENDIAN__
+    for (const auto& conversion : kPixelConversions) {
+        if (conversion.format == format && conversion.type == type && (!conversion.expand || expand))
+            return &conversion;
+    }
+#endif
+    return nullptr;
+}
+
+void set_unpack_tight(bool tight) {
+    set_pixel_store(kUnpackParams, gl_state->unpack, tight);
+}
+
+PixelUpload::PixelUpload(const pixel_conversion_t* conversion, GLsizei width, GLsizei height, GLsizei depth,
+                         GLenum& format, GLenum& type, const void*& pixels) {
+    if (!conversion) return;
+    LOG_D("PixelUpload: %s/%s -> %s/%s, %dx%dx%d", glEnumToString(format), glEnumToString(type),
+          glEnumToString(conversion->es_format), glEnumToString(conversion->es_type), width, height, depth)
+    format = conversion->es_format;
+    type = conversion->es_type;
+    if (conversion->same_bytes || width <= 0 || height <= 0 || depth < 0) return;
+
+    GLuint unpackBuffer = find_real_bound_buffer(GL_PIXEL_UNPACK_BUFFER_BINDING);
+    if (!pixels && !unpackBuffer) return; // allocation only
+
+    const PixelLayout layout = get_pixel_layout(gl_state->unpack, conversion->size, width, height, depth);
+    const GLsizei images = depth > 0 ? depth : 1;
+    const size_t esRowBytes = (size_t)width * conversion->es_size;
+
+    const GLubyte* src = static_cast<const GLubyte*>(pixels);
+    if (unpackBuffer) {
+        src = static_cast<const GLubyte*>(GLES.glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, (GLintptr)pixels,
+                                                                (GLsizeiptr)layout.span, GL_MAP_READ_BIT));
+        if (!src) {
+            LOG_E("PixelUpload: cannot map the unpack buffer")
+            return;
+        }
+    }
+
+    g_pixel_scratch.resize(esRowBytes * height * images);
+    GLubyte* dst = g_pixel_scratch.data();
+    for (GLsizei image = 0; image < images; ++image) {
+        for (GLsizei row = 0; row < height; ++row) {
+            conversion->unpack(src + layout.first + image * layout.imageBytes + row * layout.rowBytes, dst, width);
+            dst += esRowBytes;
+        }
+    }
+
+    if (unpackBuffer) {
+        GLES.glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        m_unpackBuffer = unpackBuffer;
+    }
+    set_unpack_tight(true);
+    m_tight = true;
+    pixels = g_pixel_scratch.data();
+}
+
+PixelUpload::~PixelUpload() {
+    if (m_tight) set_unpack_tight(false);
+    if (m_unpackBuffer) GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_unpackBuffer);
+}
+
+bool read_pixels_converted(const pixel_conversion_t* conversion, GLint x, GLint y, GLsizei width, GLsizei height,
+                           void* pixels) {
+    if (conversion->same_bytes) {
+        pack_buffer_before_read(width, height, conversion->format, conversion->type, pixels);
+        GLES.glReadPixels(x, y, width, height, conversion->es_format, conversion->es_type, pixels);
+        return true;
+    }
+    if (!conversion->pack) return false;
+    if (width <= 0 || height <= 0) return true;
+
+    LOG_D("read_pixels_converted: %s/%s <- %s/%s, %dx%d", glEnumToString(conversion->format),
+          glEnumToString(conversion->type), glEnumToString(conversion->es_format),
+          glEnumToString(conversion->es_type), width, height)
+
+    GLuint packBuffer = find_real_bound_buffer(GL_PIXEL_PACK_BUFFER_BINDING);
+    if (packBuffer && conversion->es_size == conversion->size) {
+        // Same layout in both pairs: the GPU packs into the application's
+        // buffer, and the rows are converted in place once it is mapped
+        GLuint buffer = find_bound_buffer(GL_PIXEL_PACK_BUFFER_BINDING);
+        const PixelLayout layout = get_pixel_layout(gl_state->pack, conversion->size, width, height, 0);
+        pack_buffer_overwrite(buffer, pixels, width, height, conversion->size);
+        GLES.glReadPixels(x, y, width, height, conversion->es_format, conversion->es_type, pixels);
+        g_pending_packs[buffer].push_back(
+            {(size_t)pixels + layout.first, layout.rowBytes, width, height, conversion->size, conversion->pack});
+        return true;
+    }
+
+    // Otherwise read tightly packed into scratch memory first
+    const size_t esRowBytes = (size_t)width * conversion->es_size;
+    g_pixel_scratch.resize(esRowBytes * height);
+    if (packBuffer) GLES.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    set_pixel_store(kPackParams, gl_state->pack, true);
+    GLES.glReadPixels(x, y, width, height, conversion->es_format, conversion->es_type, g_pixel_scratch.data());
+    set_pixel_store(kPackParams, gl_state->pack, false);
+
+    // Then convert into the application's layout. A bound pack buffer has to
+    // be mapped for that, which waits for the read above.
+    const PixelLayout layout = get_pixel_layout(gl_state->pack, conversion->size, width, height, 0);
+    GLubyte* dst = static_cast<GLubyte*>(pixels);
+    if (packBuffer) {
+        GLES.glBindBuffer(GL_PIXEL_PACK_BUFFER, packBuffer);
+        dst = static_cast<GLubyte*>(
+            GLES.glMapBufferRange(GL_PIXEL_PACK_BUFFER, (GLintptr)pixels, (GLsizeiptr)layout.span, GL_MAP_WRITE_BIT));
+        if (!dst) {
+            LOG_E("read_pixels_converted: cannot map the pack buffer")
+            return true;
+        }
+    }
+    for (GLsizei row = 0; row < height; ++row) {
+        conversion->pack(g_pixel_scratch.data() + row * esRowBytes, dst + layout.first + row * layout.rowBytes, width);
+    }
+    if (packBuffer) GLES.glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    return true;
+}
@@ -41,4 +41,67 @@ GLboolean is_type_packed(GLenum type);
 bool pixel_convert(const GLvoid* src, GLvoid** dst, GLuint width, GLuint height, GLenum src_format, GLenum src_type,
                    GLenum dst_format, GLenum dst_type, GLuint stride, GLuint align);
 
+typedef void (*pixel_row_fn)(const GLubyte* src, GLubyte* dst, GLsizei width);
+
+// A desktop format/type pair GLES does not accept, and the pair it is
+// transferred as instead.
+typedef struct {
+    GLenum format, type;
+    GLenum es_format, es_type;
+    GLsizei size, es_size;
+    // Same bytes in memory, only the enums change
+    bool same_bytes;
+    // Only used for textures stored as RGBA8, see find_pixel_conversion
+    bool expand;
+    pixel_row_fn unpack; // client -> ES
+    pixel_row_fn pack;   // ES -> client, nullptr if it cannot be read back
+} pixel_conversion_t;
+
+// Returns nullptr when GLES takes format/type as is. Conversions that widen
+// to RGBA/GL_UNSIGNED_BYTE (luminance/alpha, 16-bit packed and 24-bit RGB)
+// are only considered when `expand` is set, that is when the destination
+// texture is stored as RGBA8, including sized luminance or alpha formats
+// promoted to it.
+const pixel_conversion_t* find_pixel_conversion(GLenum format, GLenum type, bool expand = false);
+
+// Switches the GLES unpack state between the application's (shadowed) values
+// and tightly packed ones, touching only what differs between the two
+void set_unpack_tight(bool tight);
+
+// Converts the client data of a texture upload into a tightly packed scratch
+// copy and points format/type/pixels at it while the object lives. An
+// application unpack buffer is mapped for the conversion and unbound around
+// the upload; the unpack state is put back on destruction.
+class PixelUpload {
+public:
+    // depth is 0 for 1D/2D uploads, which ignore the image unpack state
+    PixelUpload(const pixel_conversion_t* conversion, GLsizei width, GLsizei height, GLsizei depth, GLenum& format,
+                GLenum& type, const void*& pixels);
+    ~PixelUpload();
+
+    PixelUpload(const PixelUpload&) = delete;
+    PixelUpload& operator=(const PixelUpload&) = delete;
+
+private:
+    bool m_tight = false;
+    GLuint m_unpackBuffer = 0;
+};
+
+// glReadPixels for a pair that needs conversion. Reads as the ES pair and
+// converts into pixels, honouring the pack state and a bound pack buffer.
+// Returns false if the pair cannot be read back this way.
+bool read_pixels_converted(const pixel_conversion_t* conversion, GLint x, GLint y, GLsizei width, GLsizei height,
+                           void* pixels);
+
+// A converted readback into an application pack buffer is packed by GLES as
+// the ES pair, and its rows are converted in place only when the data is
+// reached: the buffer is mapped, written, copied or bound for another use,
+// or a later readback overlaps it. Buffers by application name, size < 0
+// covers the whole buffer.
+void pack_buffer_resolve(GLuint buffer, GLintptr offset, GLsizeiptr size);
+void pack_buffer_forget(GLuint buffer);
+
+// Resolves what a glReadPixels into the bound pack buffer would overwrite
+void pack_buffer_before_read(GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+
 #endif // MOBILEGLUES_PIXEL_H
@@ -5,18 +5,22 @@
 // SPDX-License-Identifier: LGPL-2.1-only
 // End of Source File Header
 
-#include <regex.h>
 #include "GL/glext.h"
 #include "GLES3/gl32.h"
 #include "log.h"
 #include "shader.h"
 #include "program.h"
-#include <regex>
 #include <cstring>
 #include <iostream>
 #include "../config/settings.h"
 #include <ankerl/unordered_dense.h>
 #include "drawing.h"
+#include "texture_buffer.h"
+#include "immediate.h"
+#include "glsl/program_cache.h"
+#include "glsl/glsl_scanner.h"
+#include "glsl/digest.h"
+#include <algorithm>
 
 #define DEBUG 0
 
@@ -26,6 +30,19 @@ UnorderedMap<GLuint, bool> program_map_is_sampler_buffer_emulated;
 extern UnorderedMap<GLuint, bool> shader_map_is_atomic_counter_emulated;
 UnorderedMap<GLuint, bool> program_map_is_atomic_counter_emulated;
 
+extern UnorderedMap<GLuint, uint64_t> shader_map_essl_hash;
+
+// Locations bound through glBindAttribLocation / glBindFragDataLocation, part of the program binary key
+UnorderedMap<GLuint, std::vector<std::pair<std::string, GLuint>>> program_map_bound_locations;
+
+// glTransformFeedbackVaryings and glProgramParameteri state, also part of the key
+struct FeedbackVaryings {
+    GLenum buffer_mode;
+    std::vector<std::string> names;
+};
+UnorderedMap<GLuint, FeedbackVaryings> program_map_feedback_varyings;
+UnorderedMap<GLuint, std::vector<std::pair<GLenum, GLint>>> program_map_parameters;
+
 enum class ShouldGenerateFSState : int {
     Never = 0,
     Maybe = 1,
@@ -34,70 +51,128 @@ enum class ShouldGenerateFSState : int {
 
 UnorderedMap<GLuint, ShouldGenerateFSState> program_map_should_generate_fs;
 
+// Rewrites `out <qualifiers> <type> name;` into `layout (location = color) out <qualifiers> <type> name;`
 char* updateLayoutLocation(const char* esslSource, GLuint color, const char* name) {
-    std::string shaderCode(esslSource);
-
-    std::string pattern = std::string(R"((layout\s*$[^)]*location\s*=\s*\d+[^)]*$\s*)?)") +
-                          R"(out\s+((?:highp|mediump|lowp|\w+\s+)*\w+)\s+)" + name + R"(\s*;)";
-
-    std::string replacement = "layout (location = " + std::to_string(color) + ") out $2 " + name + ";";
+    std::string_view code(esslSource);
+    std::string_view variable(name);
+    GLSLCodeMap map(code);
+    std::string modifiedCode;
+    modifiedCode.reserve(code.size() + 32);
+    size_t copied = 0;
+
+    size_t at = map.find("out");
+    while (at != std::string_view::npos) {
+        GLSLScanner scanner(code, at + 3);
+        size_t typeStart = scanner.position() + scanner.skipSpaces();
+        size_t typeEnd = std::string_view::npos;
+        if (typeStart > at + 3) {
+            // Qualifiers and type are whitespace-separated words, the variable name follows the last one
+            while (!scanner.consumeWord().empty()) {
+                size_t wordEnd = scanner.position();
+                if (scanner.skipSpaces() == 0) break;
+                if (scanner.peekWord() == variable) {
+                    GLSLScanner after(code, scanner.position() + variable.size());
+                    after.skipSpaces();
+                    if (after.consume(';')) {
+                        typeEnd = wordEnd;
+                        scanner = after;
+                        break;
+                    }
+                }
+            }
+        }
 
-    std::regex reg(pattern);
-    std::string modifiedCode = std::regex_replace(shaderCode, reg, replacement);
+        if (typeEnd == std::string_view::npos) {
+            at = map.find("out", at + 1);
+            continue;
+        }
+        modifiedCode.append(code.substr(copied, at - copied));
+        modifiedCode.append("layout (location = ").append(std::to_string(color)).append(") out ");
+        modifiedCode.append(code.substr(typeStart, typeEnd - typeStart)).append(" ").append(variable).append(";");
+        copied = scanner.position();
+        at = map.find("out", copied);
+    }
+    modifiedCode.append(code.substr(copied));
 
     char* result = new char[modifiedCode.size() + 1];
     strcpy(result, modifiedCode.c_str());
     return result;
 }
 
+void glBindAttribLocation(GLuint program, GLuint index, const GLchar* name) {
+    LOG()
+    MG_TRACE_ARGS(glBindAttribLocation, program, index, name)
+    LOG_D("glBindAttribLocation(%d, %d, %s)", program, index, name)
+    program_map_bound_locations[program].emplace_back(std::string("a:") + name, index);
+    GLES.glBindAttribLocation(program, index, name);
+    CHECK_GL_ERROR
+}
+
+// Bindings that name an outColorN output with its own N were already applied
+// while translating
+static bool is_translated_out_color(const std::string& name, GLuint color) {
+    if (name.size() <= 8 || name.compare(0, 8, "outColor") != 0) return false;
+    for (size_t i = 8; i < name.size(); ++i) {
+        if (!isdigit((unsigned char)name[i])) return false;
+    }
+    return std::stoul(name.substr(8)) == color;
+}
+
 void glBindFragDataLocation(GLuint program, GLuint color, const GLchar* name) {
     LOG()
+    MG_TRACE_ARGS(glBindFragDataLocation, program, color, name)
     LOG_D("glBindFragDataLocation(%d, %d, %s)", program, color, name)
+    // Applied to the attached fragment shaders in glLinkProgram, like GL does
+    program_map_bound_locations[program].emplace_back(std::string("f:") + name, color);
+}
 
-    if (strlen(name) > 8 && strncmp(name, "outColor", 8) == 0) {
-        const char* numberStr = name + 8;
-        bool isNumber = true;
-        for (int i = 0; numberStr[i] != '\0'; ++i) {
-            if (!isdigit(numberStr[i])) {
-                isNumber = false;
-                break;
-            }
-        }
+// Latest binding per name, sorted by name
+static std::vector<std::pair<std::string, GLuint>> effective_bindings(GLuint program) {
+    auto it = program_map_bound_locations.find(program);
+    if (it == program_map_bound_locations.end()) return {};
+    // Later bindings of the same name win, like in GL
+    std::vector<std::pair<std::string, GLuint>> bindings(it->second.rbegin(), it->second.rend());
+    std::stable_sort(bindings.begin(), bindings.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    bindings.erase(std::unique(bindings.begin(), bindings.end(),
+                               [](const auto& a, const auto& b) { return a.first == b.first; }),
+                   bindings.end());
+    return bindings;
+}
 
-        if (isNumber) {
-            unsigned int extractedColor = static_cast<unsigned int>(std::stoul(numberStr));
-            if (extractedColor == color) {
-                // outColor was bound in glsl process. exit now
-                LOG_D("Find outColor* with color *, skipping")
-                return;
-            }
+// Rewrites the outputs of the program's fragment shaders for its frag data
+// bindings. Each shader keeps the unpatched ESSL so a shader shared between
+// programs gets the locations of whichever program is linked.
+static void apply_frag_data_locations(GLuint program, const std::vector<GLuint>& shaders) {
+    std::vector<std::pair<std::string, GLuint>> bindings = effective_bindings(program);
+    for (GLuint shader : shaders) {
+        auto it = shader_map_info.find(shader);
+        if (it == shader_map_info.end() || it->second.type != GL_FRAGMENT_SHADER || it->second.converted.empty())
+            continue;
+        shader_t& info = it->second;
+
+        std::string essl = info.converted;
+        for (const auto& [key, color] : bindings) {
+            if (key.compare(0, 2, "f:") != 0) continue;
+            std::string name = key.substr(2);
+            if (is_translated_out_color(name, color)) continue;
+            char* patched = updateLayoutLocation(essl.c_str(), color, name.c_str());
+            essl = patched;
+            delete[] patched;
         }
-    }
 
-    char* origin_glsl = nullptr;
-    if (shaderInfo.frag_data_changed) {
-        size_t glslLen = strlen(shaderInfo.frag_data_changed_converted) + 1;
-        origin_glsl = (char*)malloc(glslLen);
-        if (origin_glsl == nullptr) {
-            LOG_E("Memory reallocation failed for frag_data_changed_converted\n")
-            return;
-        }
-        strcpy(origin_glsl, shaderInfo.frag_data_changed_converted);
-    } else {
-        size_t glslLen = shaderInfo.converted.length() + 1;
-        origin_glsl = (char*)malloc(glslLen);
-        if (origin_glsl == nullptr) {
-            LOG_E("Memory reallocation failed for converted\n")
-            return;
-        }
-        strcpy(origin_glsl, shaderInfo.converted.c_str());
+        const std::string& current = info.uploaded.empty() ? info.converted : info.uploaded;
+        if (essl == current) continue;
+
+        const char* src = essl.c_str();
+        GLES.glShaderSource(shader, 1, &src, nullptr);
+        shader_map_essl_hash[shader] = digest::hash64(essl);
+        // Compiled with the others when the link reaches the driver
+        info.compile_requested = true;
+        GLES.glDetachShader(program, shader);
+        GLES.glAttachShader(program, shader);
+        info.uploaded = essl == info.converted ? std::string() : std::move(essl);
+        CHECK_GL_ERROR
     }
-
-    char* result_glsl = updateLayoutLocation(origin_glsl, color, name);
-    free(origin_glsl);
-
-    shaderInfo.frag_data_changed_converted = result_glsl;
-    shaderInfo.frag_data_changed = 1;
 }
 
 static std::string DefaultFSSource;
@@ -119,28 +194,78 @@ void GenerateDefaultFSSource() {
 }
 
 static UnorderedMap<unsigned, GLuint> DefaultFSMap; // essl version <-> shader id
+
+// Key = translated sources of every attached shader + bound locations + transform
+// feedback varyings + program parameters, serialized as is so the cache can
+// compare it in full. Returns false if some attached shader was not seen by
+// glShaderSource.
+static bool compute_program_binary_key(GLuint program, std::string& key) {
+    GLint count = 0;
+    GLES.glGetProgramiv(program, GL_ATTACHED_SHADERS, &count);
+    if (count <= 0) return false;
+    std::vector<GLuint> shaders(count);
+    GLES.glGetAttachedShaders(program, count, &count, shaders.data());
+
+    std::vector<uint64_t> hashes;
+    hashes.reserve(count);
+    for (GLsizei i = 0; i < count; ++i) {
+        auto it = shader_map_essl_hash.find(shaders[i]);
+        if (it == shader_map_essl_hash.end()) return false;
+        hashes.push_back(it->second);
+    }
+    std::sort(hashes.begin(), hashes.end()); // attach order does not matter
+
+    auto append = [&key](const void* data, size_t size) { key.append(static_cast<const char*>(data), size); };
+    key.clear();
+    uint32_t n = hashes.size();
+    append(&n, sizeof(n));
+    append(hashes.data(), hashes.size() * sizeof(uint64_t));
+
+    auto bindings = effective_bindings(program);
+    n = bindings.size();
+    append(&n, sizeof(n));
+    for (const auto& [name, location] : bindings) {
+        append(name.c_str(), name.size() + 1);
+        append(&location, sizeof(location));
+    }
+
+    n = 0;
+    auto varyings = program_map_feedback_varyings.find(program);
+    if (varyings != program_map_feedback_varyings.end()) n = varyings->second.names.size();
+    append(&n, sizeof(n));
+    if (n) {
+        append(&varyings->second.buffer_mode, sizeof(GLenum));
+        for (const std::string& name : varyings->second.names)
+            append(name.c_str(), name.size() + 1);
+    }
+
+    n = 0;
+    auto parameters = program_map_parameters.find(program);
+    if (parameters != program_map_parameters.end()) n = parameters->second.size();
+    append(&n, sizeof(n));
+    if (n) append(parameters->second.data(), n * sizeof(std::pair<GLenum, GLint>));
+    return true;
+}
 void glLinkProgram(GLuint program) {
     LOG()
+    MG_TRACE_ARGS(glLinkProgram, program)
 
     LOG_D("glLinkProgram(%d)", program)
-    if (!shaderInfo.converted.empty() && shaderInfo.frag_data_changed) {
-        GLES.glShaderSource(shaderInfo.id, 1, (const GLchar* const*)&shaderInfo.frag_data_changed_converted, nullptr);
-        GLES.glCompileShader(shaderInfo.id);
-        GLint status = 0;
-        GLES.glGetShaderiv(shaderInfo.id, GL_COMPILE_STATUS, &status);
-        if (status != GL_TRUE) {
-            char tmp[500];
-            GLES.glGetShaderInfoLog(shaderInfo.id, 500, nullptr, tmp);
-            LOG_E("Failed to compile patched shader, log:\n%s", tmp)
+    // Only this program's translations have to be ready, other ones keep
+    // running. The driver compiles them only if the binary cache misses.
+    std::vector<GLuint> shaders = finish_program_shaders(program);
+    for (GLuint shader : shaders) {
+        if (hardware->emulate_texture_buffer && shader_map_is_sampler_buffer_emulated[shader])
+            program_map_is_sampler_buffer_emulated[program] = true;
+        if (shader_map_is_atomic_counter_emulated[shader]) {
+            program_map_is_atomic_counter_emulated[program] = true;
+            LOG_D("Shader %d is atomic counter emulated, setting program %d to atomic counter emulated", shader,
+                  program)
         }
-        GLES.glDetachShader(program, shaderInfo.id);
-        GLES.glAttachShader(program, shaderInfo.id);
-        CHECK_GL_ERROR
     }
-    shaderInfo.id = 0;
-    shaderInfo.converted = "";
-    shaderInfo.frag_data_changed_converted = nullptr;
-    shaderInfo.frag_data_changed = 0;
+    // Uniform locations change on relink
+    if (hardware->emulate_texture_buffer) texture_buffer_forget_program(program);
+    apply_frag_data_locations(program, shaders);
 
     // Generate defaut fragment shader if needed
     if (program_map_should_generate_fs[program] == ShouldGenerateFSState::Maybe) {
@@ -150,6 +275,7 @@ void glLinkProgram(GLuint program) {
             default_fs = GLES.glCreateShader(GL_FRAGMENT_SHADER);
             const char* src = DefaultFSSource.c_str();
             GLES.glShaderSource(default_fs, 1, &src, nullptr);
+            shader_map_essl_hash[default_fs] = digest::hash64(DefaultFSSource);
 
             GLES.glCompileShader(default_fs);
 
@@ -172,13 +298,62 @@ void glLinkProgram(GLuint program) {
         }
     }
 
+    auto& binary_cache = ProgramBinaryCache::get_instance();
+    std::string binary_key;
+    bool cacheable = binary_cache.enabled() && compute_program_binary_key(program, binary_key);
+    if (cacheable && binary_cache.load(program, binary_key)) {
+        CHECK_GL_ERROR
+        return;
+    }
+
+    for (GLuint shader : shaders)
+        flush_shader(shader);
+    if (cacheable) GLES.glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     GLES.glLinkProgram(program);
 
+    if (cacheable) {
+        GLint status = GL_FALSE;
+        GLES.glGetProgramiv(program, GL_LINK_STATUS, &status);
+        if (status == GL_TRUE) binary_cache.store(program, binary_key);
+    }
+
+    CHECK_GL_ERROR
+}
+
+void glTransformFeedbackVaryings(GLuint program, GLsizei count, const GLchar* const* varyings, GLenum bufferMode) {
+    LOG()
+    MG_TRACE_ARGS(glTransformFeedbackVaryings, program, count, varyings, bufferMode)
+    LOG_D("glTransformFeedbackVaryings(%u, %d, ..., 0x%x)", program, count, bufferMode)
+    FeedbackVaryings& state = program_map_feedback_varyings[program];
+    state.buffer_mode = bufferMode;
+    state.names.assign(varyings, varyings + std::max(count, 0));
+    GLES.glTransformFeedbackVaryings(program, count, varyings, bufferMode);
+    CHECK_GL_ERROR
+}
+
+void glProgramParameteri(GLuint program, GLenum pname, GLint value) {
+    LOG()
+    MG_TRACE_ARGS(glProgramParameteri, program, pname, value)
+    LOG_D("glProgramParameteri(%u, 0x%x, %d)", program, pname, value)
+    // The retrievable hint is ours to set, it does not change the linked program
+    if (pname != GL_PROGRAM_BINARY_RETRIEVABLE_HINT) {
+        auto& parameters = program_map_parameters[program];
+        auto it =
+            std::find_if(parameters.begin(), parameters.end(), [pname](const auto& p) { return p.first == pname; });
+        if (it != parameters.end()) {
+            it->second = value;
+        } else {
+            parameters.emplace_back(pname, value);
+            std::sort(parameters.begin(), parameters.end());
+        }
+    }
+    GLES.glProgramParameteri(program, pname, value);
     CHECK_GL_ERROR
 }
 
 void glGetProgramiv(GLuint program, GLenum pname, GLint* params) {
     LOG()
+    MG_TRACE_ARGS(glGetProgramiv, program, pname, params)
     GLES.glGetProgramiv(program, pname, params);
     if (global_settings.ignore_error >= IgnoreErrorLevel::Partial &&
         (pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS) && !*params) {
@@ -194,6 +369,8 @@ void glGetProgramiv(GLuint program, GLenum pname, GLint* params) {
 
 void glUseProgram(GLuint program) {
     LOG()
+    MG_TRACE_ARGS(glUseProgram, program)
+    flush_immediate();
     LOG_D("glUseProgram(%d)", program)
     if (program != gl_state->current_program) {
         gl_state->current_program = program;
@@ -204,16 +381,13 @@ void glUseProgram(GLuint program) {
 
 void glAttachShader(GLuint program, GLuint shader) {
     LOG()
+    MG_TRACE_ARGS(glAttachShader, program, shader)
     LOG_D("glAttachShader(%u, %u)", program, shader)
-    if (hardware->emulate_texture_buffer && shader_map_is_sampler_buffer_emulated[shader])
-        program_map_is_sampler_buffer_emulated[program] = true;
-    if (shader_map_is_atomic_counter_emulated[shader]) {
-        program_map_is_atomic_counter_emulated[program] = true;
-        LOG_D("Shader %d is atomic counter emulated, setting program %d to atomic counter emulated", shader, program)
-    }
+    // Translation flags are picked up in glLinkProgram, attaching does not wait for it
 
-    GLint type = 0;
-    GLES.glGetShaderiv(shader, GL_SHADER_TYPE, &type);
+    auto info = shader_map_info.find(shader);
+    GLint type = info != shader_map_info.end() ? (GLint)info->second.type : 0;
+    if (!type) GLES.glGetShaderiv(shader, GL_SHADER_TYPE, &type);
     auto& should_gen_fs_map = program_map_should_generate_fs;
     if (type == GL_FRAGMENT_SHADER) {
         should_gen_fs_map[program] = ShouldGenerateFSState::Never;
@@ -228,19 +402,19 @@ void glAttachShader(GLuint program, GLuint shader) {
     CHECK_GL_ERROR
 }
 
-extern UnorderedMap<GLuint, SamplerInfo> g_samplerCacheForSamplerBuffer;
-
 GLuint glCreateProgram() {
     LOG()
+    MG_TRACE_ARGS(glCreateProgram)
     LOG_D("glCreateProgram")
     GLuint program = GLES.glCreateProgram();
     if (hardware->emulate_texture_buffer) {
         program_map_is_sampler_buffer_emulated[program] = false;
-        if (g_samplerCacheForSamplerBuffer.find(program) != g_samplerCacheForSamplerBuffer.end()) {
-            g_samplerCacheForSamplerBuffer.erase(program);
-        }
+        texture_buffer_forget_program(program);
     }
     program_map_is_atomic_counter_emulated[program] = false;
+    program_map_bound_locations.erase(program);
+    program_map_feedback_varyings.erase(program);
+    program_map_parameters.erase(program);
     program_map_should_generate_fs[program] = ShouldGenerateFSState::Unknown;
 
     CHECK_GL_ERROR
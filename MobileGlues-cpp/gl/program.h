@@ -15,9 +15,13 @@ extern "C"
 {
 #endif
 
+    GLAPI GLAPIENTRY void glBindAttribLocation(GLuint program, GLuint index, const GLchar* name);
     GLAPI GLAPIENTRY void glBindFragDataLocation(GLuint program, GLuint color, const GLchar* name);
     GLAPI GLAPIENTRY void glLinkProgram(GLuint program);
     GLAPI GLAPIENTRY void glGetProgramiv(GLuint program, GLenum pname, GLint* params);
+    GLAPI GLAPIENTRY void glTransformFeedbackVaryings(GLuint program, GLsizei count, const GLchar* const* varyings,
+                                                      GLenum bufferMode);
+    GLAPI GLAPIENTRY void glProgramParameteri(GLuint program, GLenum pname, GLint value);
     GLAPI GLAPIENTRY void glUseProgram(GLuint program);
     GLAPI GLAPIENTRY GLuint glCreateProgram();
     GLAPI GLAPIENTRY void glAttachShader(GLuint program, GLuint shader);
@@ -5,13 +5,13 @@
 // SPDX-License-Identifier: LGPL-2.1-only
 // End of Source File Header
 #include <string>
+#include <ctime>
 #include <random>
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
 #include <unordered_set>
 #include <string>
-#include <format>
 
 struct RandomStringOptions {
     size_t minLength = 8;
@@ -14,15 +14,26 @@
 #include "../gles/loader.h"
 #include "../includes.h"
 #include "glsl/glsl_for_es.h"
+#include "glsl/translator_pool.h"
 #include "../config/settings.h"
 #include "FSR1/FSR1.h"
+#include "glsl/digest.h"
 
 #define DEBUG 0
 
-struct shader_t shaderInfo;
+UnorderedMap<GLuint, shader_t> shader_map_info;
 
 UnorderedMap<GLuint, bool> shader_map_is_sampler_buffer_emulated;
 UnorderedMap<GLuint, bool> shader_map_is_atomic_counter_emulated;
+UnorderedMap<GLuint, uint64_t> shader_map_essl_hash;
+
+struct pending_shader_t {
+    std::shared_future<TranslateResult> result;
+    bool is_sampler_buffer_emulated;
+};
+
+// Shaders whose translation is still running on the TranslatorPool
+static UnorderedMap<GLuint, pending_shader_t> pending_shaders;
 
 bool can_run_essl3(unsigned int esversion, const char* glsl) {
     if (strncmp(glsl, "#version 100", 12) == 0) {
@@ -51,15 +62,77 @@ bool check_if_sampler_buffer_used(std::string str) {
     return str.find("samplerBuffer") != std::string::npos;
 }
 
+static void upload_converted_source(GLuint shader, const std::string& essl_src, bool is_sampler_buffer_emulated) {
+    shader_t& info = shader_map_info[shader];
+    info.converted = essl_src;
+    info.uploaded.clear();
+    const char* s[] = {essl_src.c_str()};
+    GLES.glShaderSource(shader, 1, s, nullptr);
+    shader_map_essl_hash[shader] = digest::hash64(essl_src);
+    if (hardware->emulate_texture_buffer) shader_map_is_sampler_buffer_emulated[shader] = is_sampler_buffer_emulated;
+}
+
+void finish_pending_shader(GLuint shader) {
+    auto it = pending_shaders.find(shader);
+    if (it == pending_shaders.end()) return;
+    pending_shader_t pending = std::move(it->second);
+    pending_shaders.erase(it);
+
+    const TranslateResult& result = pending.result.get();
+    if (result.return_code == 1) { // atomicCounterEmulated
+        shader_map_is_atomic_counter_emulated[shader] = true;
+        LOG_D("[INFO] [Shader] Atomic counter emulated in shader %d", shader)
+    }
+
+    if (result.essl.empty()) {
+        LOG_E("Failed to convert shader %d.", shader)
+        return;
+    }
+    LOG_D("\n[INFO] [Shader] Converted Shader source: \n%s", result.essl.c_str())
+    upload_converted_source(shader, result.essl, pending.is_sampler_buffer_emulated);
+    CHECK_GL_ERROR
+}
+
+void flush_shader(GLuint shader) {
+    finish_pending_shader(shader);
+    auto it = shader_map_info.find(shader);
+    if (it == shader_map_info.end() || !it->second.compile_requested) return;
+    it->second.compile_requested = false;
+    GLES.glCompileShader(shader);
+}
+
+std::vector<GLuint> finish_program_shaders(GLuint program) {
+    GLint count = 0;
+    GLES.glGetProgramiv(program, GL_ATTACHED_SHADERS, &count);
+    std::vector<GLuint> shaders(count > 0 ? count : 0);
+    if (count > 0) GLES.glGetAttachedShaders(program, count, &count, shaders.data());
+    shaders.resize(count > 0 ? count : 0);
+    for (GLuint shader : shaders) {
+        finish_pending_shader(shader);
+    }
+    return shaders;
+}
+
 void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
     LOG()
-    shaderInfo.id = 0;
-    shaderInfo.converted = "";
-    shaderInfo.frag_data_changed = 0;
+    MG_TRACE_ARGS(glShaderSource, shader, count, string, length)
+    auto pending = pending_shaders.find(shader);
+    if (pending != pending_shaders.end()) {
+        // The old source never reached the driver: drop its translation, and the
+        // compile requested for it, instead of waiting for the result
+        pending_shaders.erase(pending);
+        shader_map_info[shader].compile_requested = false;
+    } else {
+        // A compile requested earlier still applies to the old source
+        flush_shader(shader);
+    }
+    shader_t& info = shader_map_info[shader];
+    info.converted.clear();
+    info.uploaded.clear();
     size_t l = 0;
     for (int i = 0; i < count; i++)
         l += (length && length[i] >= 0) ? length[i] : strlen(string[i]);
-    std::string glsl_src, essl_src;
+    std::string glsl_src;
     glsl_src.reserve(l + 1);
     if (length) {
         for (int i = 0; i < count; i++) {
@@ -79,40 +152,60 @@ void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, c
     if (is_direct_shader(glsl_src.c_str())) {
         LOG_D("[INFO] [Shader] Direct shader source: ")
         LOG_D("%s", glsl_src.c_str())
-        essl_src = glsl_src;
-    } else {
-        int glsl_version = getGLSLVersion(glsl_src.c_str());
-        LOG_D("[INFO] [Shader] Shader source: ")
-        LOG_D("%s", glsl_src.c_str())
-        GLint shaderType;
-        GLES.glGetShaderiv(shader, GL_SHADER_TYPE, &shaderType);
-        int return_code = 0;
-        essl_src = GLSLtoGLSLES(glsl_src.c_str(), shaderType, hardware->es_version, glsl_version, return_code);
-        if (return_code == 1) { // atomicCounterEmulated
-            shader_map_is_atomic_counter_emulated[shader] = true;
-            LOG_D("[INFO] [Shader] Atomic counter emulated in shader %d", shader)
-        }
+        upload_converted_source(shader, glsl_src, is_sampler_buffer_emulated);
+        CHECK_GL_ERROR
+        return;
+    }
 
-        if (essl_src.empty()) {
-            LOG_E("Failed to convert shader %d.", shader)
-            return;
-        }
-        LOG_D("\n[INFO] [Shader] Converted Shader source: \n%s", essl_src.c_str())
+    int glsl_version = getGLSLVersion(glsl_src.c_str());
+    LOG_D("[INFO] [Shader] Shader source: ")
+    LOG_D("%s", glsl_src.c_str())
+    GLint shaderType = info.type;
+    if (!shaderType) GLES.glGetShaderiv(shader, GL_SHADER_TYPE, &shaderType);
+
+    // Translation is joined in finish_pending_shader(), at the latest when the shader is observed or linked
+    pending_shaders[shader] = {TranslatorPool::get_instance().submit(std::move(glsl_src), shaderType,
+                                                                     hardware->es_version, glsl_version),
+                               is_sampler_buffer_emulated};
+}
+
+// The driver compile waits for the first glGetShaderiv / glGetShaderInfoLog
+// or the link, so the translation of several shaders can overlap.
+void glCompileShader(GLuint shader) {
+    LOG()
+    MG_TRACE_ARGS(glCompileShader, shader)
+    shader_map_info[shader].compile_requested = true;
+}
+
+void glDeleteShader(GLuint shader) {
+    LOG()
+    MG_TRACE_ARGS(glDeleteShader, shader)
+    GLES.glDeleteShader(shader);
+    auto it = shader_map_info.find(shader);
+    if (!GLES.glIsShader(shader)) {
+        pending_shaders.erase(shader);
+        if (it != shader_map_info.end()) shader_map_info.erase(it);
+        shader_map_essl_hash.erase(shader);
+        shader_map_is_sampler_buffer_emulated.erase(shader);
+        shader_map_is_atomic_counter_emulated.erase(shader);
     }
-    if (!essl_src.empty()) {
-        shaderInfo.id = shader;
-        shaderInfo.converted = essl_src;
-        const char* s[] = {essl_src.c_str()};
-        GLES.glShaderSource(shader, count, s, nullptr);
-        if (hardware->emulate_texture_buffer)
-            shader_map_is_sampler_buffer_emulated[shader] = is_sampler_buffer_emulated;
-    } else
-        LOG_E("Failed to convert glsl.")
+    // Otherwise it is still attached to a program, which may link it later:
+    // its translation and any deferred compile are picked up then
+    CHECK_GL_ERROR
+}
+
+void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    LOG()
+    MG_TRACE_ARGS(glGetShaderInfoLog, shader, bufSize, length, infoLog)
+    flush_shader(shader);
+    GLES.glGetShaderInfoLog(shader, bufSize, length, infoLog);
     CHECK_GL_ERROR
 }
 
 void glGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
     LOG()
+    MG_TRACE_ARGS(glGetShaderiv, shader, pname, params)
+    flush_shader(shader);
     GLES.glGetShaderiv(shader, pname, params);
     if (global_settings.ignore_error >= IgnoreErrorLevel::Partial && pname == GL_COMPILE_STATUS && !*params) {
         GLchar infoLog[512];
@@ -130,9 +223,17 @@ GLuint glCreateShader(GLenum shaderType) {
     }
 
     LOG()
+    MG_TRACE_ARGS(glCreateShader, shaderType)
     LOG_D("glCreateShader(%s)", glEnumToString(shaderType))
     GLuint shader = GLES.glCreateShader(shaderType);
-    if (shader != 0 && hardware->emulate_texture_buffer) shader_map_is_sampler_buffer_emulated[shader] = false;
+    if (shader != 0) {
+        // The name may belong to a shader deleted while attached, freed along with its program
+        pending_shaders.erase(shader);
+        shader_map_info[shader] = {shaderType, {}, {}, false};
+        shader_map_essl_hash.erase(shader);
+        shader_map_is_atomic_counter_emulated.erase(shader);
+        if (hardware->emulate_texture_buffer) shader_map_is_sampler_buffer_emulated[shader] = false;
+    }
     CHECK_GL_ERROR
     return shader;
 }
\ No newline at end of file
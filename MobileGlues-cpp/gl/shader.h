@@ -9,15 +9,23 @@
 
 #include <GL/gl.h>
 #include <string>
+#include <vector>
+#include "../includes.h"
 
 struct shader_t {
-    GLuint id;
-    std::string converted;
-    char* frag_data_changed_converted;
-    int frag_data_changed;
+    GLenum type;
+    std::string converted; // ESSL from glShaderSource, before any frag data location patch
+    std::string uploaded;  // ESSL the driver currently holds, empty while it equals `converted`
+    bool compile_requested;
 };
 
-extern struct shader_t shaderInfo;
+extern UnorderedMap<GLuint, shader_t> shader_map_info;
+
+void finish_pending_shader(GLuint shader);
+// Joins the translation and issues the glCompileShader deferred until now
+void flush_shader(GLuint shader);
+// finish_pending_shader() for every shader attached to `program`, returns them
+std::vector<GLuint> finish_program_shaders(GLuint program);
 
 #ifdef __cplusplus
 extern "C"
@@ -27,8 +35,14 @@ extern "C"
     GLAPI GLAPIENTRY void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string,
                                          const GLint* length);
 
+    GLAPI GLAPIENTRY void glCompileShader(GLuint shader);
+
+    GLAPI GLAPIENTRY void glDeleteShader(GLuint shader);
+
     GLAPI GLAPIENTRY void glGetShaderiv(GLuint shader, GLenum pname, GLint* params);
 
+    GLAPI GLAPIENTRY void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+
 #ifdef __cplusplus
 }
 #endif
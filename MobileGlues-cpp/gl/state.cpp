@@ -0,0 +1,866 @@
+// MobileGlues - gl/state.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "state.h"
+#include "buffer.h"
+#include "display_list.h"
+#include "FSR1/FSR1.h"
+#include "immediate.h"
+#include <ankerl/unordered_dense.h>
+#include <mutex>
+
+#define DEBUG 0
+
+uint64_t g_state_filter_dropped[(int)FilteredCall::Count] = {0};
+
+static const char* kFilteredCallNames[] = {
+    "glBindTexture", "glActiveTexture", "glBindBuffer", "glBindVertexArray", "glEnable",
+    "glDisable", "glBlendFunc", "glBlendEquation", "glColorMask", "glDepthFunc",
+    "glDepthMask", "glClearDepth", "glViewport", "glScissor",
+};
+static_assert(sizeof(kFilteredCallNames) / sizeof(kFilteredCallNames[0]) == (size_t)FilteredCall::Count);
+
+std::string dump_state_filter_stats(const std::string& prefix) {
+    std::string out;
+    for (int i = 0; i < (int)FilteredCall::Count; ++i) {
+        out += prefix + kFilteredCallNames[i] + ": " + std::to_string(g_state_filter_dropped[i]) + " dropped\n";
+    }
+    return out;
+}
+
+static GLbitfield cap_bit(GLenum cap) {
+    switch (cap) {
+    case GL_BLEND:
+        return STATE_CAP_BLEND;
+    case GL_CULL_FACE:
+        return STATE_CAP_CULL_FACE;
+    case GL_DEPTH_TEST:
+        return STATE_CAP_DEPTH_TEST;
+    case GL_DITHER:
+        return STATE_CAP_DITHER;
+    case GL_POLYGON_OFFSET_FILL:
+        return STATE_CAP_POLYGON_OFFSET_FILL;
+    case GL_PRIMITIVE_RESTART_FIXED_INDEX:
+        return STATE_CAP_PRIMITIVE_RESTART_FIXED_INDEX;
+    case GL_RASTERIZER_DISCARD:
+        return STATE_CAP_RASTERIZER_DISCARD;
+    case GL_SAMPLE_ALPHA_TO_COVERAGE:
+        return STATE_CAP_SAMPLE_ALPHA_TO_COVERAGE;
+    case GL_SAMPLE_COVERAGE:
+        return STATE_CAP_SAMPLE_COVERAGE;
+    case GL_SAMPLE_MASK:
+        return STATE_CAP_SAMPLE_MASK;
+    case GL_SCISSOR_TEST:
+        return STATE_CAP_SCISSOR_TEST;
+    case GL_STENCIL_TEST:
+        return STATE_CAP_STENCIL_TEST;
+    default:
+        return 0;
+    }
+}
+
+static const GLenum kCapEnums[] = {
+    GL_BLEND,
+    GL_CULL_FACE,
+    GL_DEPTH_TEST,
+    GL_DITHER,
+    GL_POLYGON_OFFSET_FILL,
+    GL_PRIMITIVE_RESTART_FIXED_INDEX,
+    GL_RASTERIZER_DISCARD,
+    GL_SAMPLE_ALPHA_TO_COVERAGE,
+    GL_SAMPLE_COVERAGE,
+    GL_SAMPLE_MASK,
+    GL_SCISSOR_TEST,
+    GL_STENCIL_TEST,
+};
+
+static void init_stencil_face(gl_stencil_face_s& face) {
+    face.func = GL_ALWAYS;
+    face.ref = 0;
+    face.value_mask = ~0u;
+    face.write_mask = ~0u;
+    face.fail = GL_KEEP;
+    face.zfail = GL_KEEP;
+    face.zpass = GL_KEEP;
+}
+
+static void init_pixel_store(gl_pixel_store_s& store) {
+    store.alignment = 4;
+    store.row_length = 0;
+    store.image_height = 0;
+    store.skip_pixels = 0;
+    store.skip_rows = 0;
+    store.skip_images = 0;
+}
+
+void init_gl_state_shadow(gl_state_t state) {
+    state->current_program = 0;
+    state->current_tex_unit = 0;
+    state->current_draw_fbo = 0;
+    state->current_read_fbo = 0;
+    state->current_renderbuffer = 0;
+    state->current_vao = 0;
+    memset(state->texture_binding_2d, 0, sizeof(state->texture_binding_2d));
+    memset(state->bound_buffers, 0, sizeof(state->bound_buffers));
+    state->bound_vertex_array = 0;
+
+    memset(state->viewport, 0, sizeof(state->viewport));
+    memset(state->scissor_box, 0, sizeof(state->scissor_box));
+    state->viewport_known = GL_FALSE;
+    state->scissor_known = GL_FALSE;
+
+    state->enabled_caps = STATE_CAP_DITHER;
+
+    state->blend_src_rgb = GL_ONE;
+    state->blend_dst_rgb = GL_ZERO;
+    state->blend_src_alpha = GL_ONE;
+    state->blend_dst_alpha = GL_ZERO;
+    state->blend_equation_rgb = GL_FUNC_ADD;
+    state->blend_equation_alpha = GL_FUNC_ADD;
+    for (auto& mask : state->color_mask)
+        mask = GL_TRUE;
+
+    state->depth_func = GL_LESS;
+    state->depth_mask = GL_TRUE;
+    // Only trusted once set through glClearDepth
+    state->clear_depth = 1.0;
+    state->clear_depth_known = GL_FALSE;
+
+    init_stencil_face(state->stencil_front);
+    init_stencil_face(state->stencil_back);
+
+    init_pixel_store(state->pack);
+    init_pixel_store(state->unpack);
+}
+
+// Shadows of the contexts made current so far. The one init_gl_state made for
+// the temporary startup context is not among them.
+static std::mutex g_context_states_mutex;
+static ankerl::unordered_dense::map<const void*, gl_state_t> g_context_states;
+// Contexts current on some thread, and the shadows of those destroyed while
+// current, freed once their thread moves on
+static ankerl::unordered_dense::set<const void*> g_current_contexts;
+static ankerl::unordered_dense::map<const void*, gl_state_t> g_destroyed_states;
+static thread_local const void* t_current_context = nullptr;
+
+void make_gl_state_current(const void* context) {
+    if (context == t_current_context) return;
+
+    std::lock_guard<std::mutex> lock(g_context_states_mutex);
+    if (t_current_context) {
+        g_current_contexts.erase(t_current_context);
+        auto destroyed = g_destroyed_states.find(t_current_context);
+        if (destroyed != g_destroyed_states.end()) {
+            delete destroyed->second;
+            g_destroyed_states.erase(destroyed);
+        }
+    }
+    t_current_context = context;
+    if (!context) {
+        gl_state = g_default_gl_state;
+        return;
+    }
+
+    g_current_contexts.insert(context);
+    gl_state_t& state = g_context_states[context];
+    if (!state) {
+        state = new gl_state_s{};
+        init_gl_state_shadow(state);
+    }
+    LOG_D(" -> gl_state: switched to the shadow of context %p", context)
+    gl_state = state;
+}
+
+void forget_gl_state_context(const void* context) {
+    std::lock_guard<std::mutex> lock(g_context_states_mutex);
+    auto it = g_context_states.find(context);
+    if (it == g_context_states.end()) return;
+    // EGL keeps a current context alive until it is released, and so do we
+    if (g_current_contexts.count(context))
+        g_destroyed_states[context] = it->second;
+    else
+        delete it->second;
+    g_context_states.erase(it);
+}
+
+void set_gl_state_viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    gl_state->viewport[0] = x;
+    gl_state->viewport[1] = y;
+    gl_state->viewport[2] = width;
+    gl_state->viewport[3] = height;
+    gl_state->viewport_known = GL_TRUE;
+    LOG_D(" -> gl_state: viewport is %d, %d, %d, %d", x, y, width, height)
+}
+
+void set_gl_state_pixel_store(GLenum pname, GLint param) {
+    bool isAlignment = pname == GL_PACK_ALIGNMENT || pname == GL_UNPACK_ALIGNMENT;
+    if (isAlignment ? (param != 1 && param != 2 && param != 4 && param != 8) : param < 0) return;
+
+    switch (pname) {
+    case GL_PACK_ALIGNMENT:
+        gl_state->pack.alignment = param;
+        break;
+    case GL_PACK_ROW_LENGTH:
+        gl_state->pack.row_length = param;
+        break;
+    case GL_PACK_SKIP_PIXELS:
+        gl_state->pack.skip_pixels = param;
+        break;
+    case GL_PACK_SKIP_ROWS:
+        gl_state->pack.skip_rows = param;
+        break;
+    case GL_PACK_IMAGE_HEIGHT:
+        gl_state->pack.image_height = param;
+        break;
+    case GL_PACK_SKIP_IMAGES:
+        gl_state->pack.skip_images = param;
+        break;
+    case GL_UNPACK_ALIGNMENT:
+        gl_state->unpack.alignment = param;
+        break;
+    case GL_UNPACK_ROW_LENGTH:
+        gl_state->unpack.row_length = param;
+        break;
+    case GL_UNPACK_IMAGE_HEIGHT:
+        gl_state->unpack.image_height = param;
+        break;
+    case GL_UNPACK_SKIP_PIXELS:
+        gl_state->unpack.skip_pixels = param;
+        break;
+    case GL_UNPACK_SKIP_ROWS:
+        gl_state->unpack.skip_rows = param;
+        break;
+    case GL_UNPACK_SKIP_IMAGES:
+        gl_state->unpack.skip_images = param;
+        break;
+    default:
+        break;
+    }
+}
+
+void set_gl_state_texture_binding_2d(GLuint unit, GLuint texture) {
+    if (unit >= MG_MAX_TEXTURE_UNITS) return;
+    gl_state->texture_binding_2d[unit] = texture;
+}
+
+// Deleting a texture unbinds it from every unit
+void forget_gl_state_texture(GLuint texture) {
+    if (texture == 0) return;
+    for (auto& binding : gl_state->texture_binding_2d) {
+        if (binding == texture) binding = 0;
+    }
+}
+
+void set_gl_state_caps(GLbitfield caps) {
+    for (GLenum cap : kCapEnums) {
+        GLbitfield bit = cap_bit(cap);
+        if (!((caps ^ gl_state->enabled_caps) & bit)) continue;
+        if (caps & bit)
+            glEnable(cap);
+        else
+            glDisable(cap);
+    }
+}
+
+static gl_stencil_face_s* stencil_faces(GLenum face, gl_stencil_face_s*& second) {
+    second = nullptr;
+    switch (face) {
+    case GL_FRONT:
+        return &gl_state->stencil_front;
+    case GL_BACK:
+        return &gl_state->stencil_back;
+    case GL_FRONT_AND_BACK:
+        second = &gl_state->stencil_back;
+        return &gl_state->stencil_front;
+    default:
+        return nullptr;
+    }
+}
+
+// Viewport and scissor box start out as the surface size, so the first query
+// before the application sets them has to go to GLES.
+static void ensure_rect_known(GLenum pname, GLint* rect, GLboolean& known) {
+    if (known) return;
+    GLES.glGetIntegerv(pname, rect);
+    known = GL_TRUE;
+}
+
+bool get_shadow_integerv(GLenum pname, GLint* params) {
+    if (GLbitfield bit = cap_bit(pname)) {
+        *params = (gl_state->enabled_caps & bit) ? 1 : 0;
+        return true;
+    }
+
+    switch (pname) {
+    case GL_CURRENT_PROGRAM:
+        *params = (GLint)gl_state->current_program;
+        return true;
+    case GL_ACTIVE_TEXTURE:
+        *params = (GLint)(GL_TEXTURE0 + gl_state->current_tex_unit);
+        return true;
+    case GL_TEXTURE_BINDING_2D:
+        *params = gl_state->current_tex_unit < MG_MAX_TEXTURE_UNITS
+                      ? (GLint)gl_state->texture_binding_2d[gl_state->current_tex_unit]
+                      : 0;
+        return true;
+    case GL_DRAW_FRAMEBUFFER_BINDING:
+        *params = (GLint)gl_state->current_draw_fbo;
+        return true;
+    case GL_READ_FRAMEBUFFER_BINDING:
+        *params = (GLint)gl_state->current_read_fbo;
+        return true;
+    case GL_RENDERBUFFER_BINDING:
+        *params = (GLint)gl_state->current_renderbuffer;
+        return true;
+    case GL_VIEWPORT:
+        ensure_rect_known(GL_VIEWPORT, gl_state->viewport, gl_state->viewport_known);
+        memcpy(params, gl_state->viewport, sizeof(gl_state->viewport));
+        return true;
+    case GL_SCISSOR_BOX:
+        ensure_rect_known(GL_SCISSOR_BOX, gl_state->scissor_box, gl_state->scissor_known);
+        memcpy(params, gl_state->scissor_box, sizeof(gl_state->scissor_box));
+        return true;
+    case GL_BLEND_SRC_RGB:
+        *params = (GLint)gl_state->blend_src_rgb;
+        return true;
+    case GL_BLEND_DST_RGB:
+        *params = (GLint)gl_state->blend_dst_rgb;
+        return true;
+    case GL_BLEND_SRC_ALPHA:
+        *params = (GLint)gl_state->blend_src_alpha;
+        return true;
+    case GL_BLEND_DST_ALPHA:
+        *params = (GLint)gl_state->blend_dst_alpha;
+        return true;
+    case GL_BLEND_EQUATION_RGB:
+        *params = (GLint)gl_state->blend_equation_rgb;
+        return true;
+    case GL_BLEND_EQUATION_ALPHA:
+        *params = (GLint)gl_state->blend_equation_alpha;
+        return true;
+    case GL_COLOR_WRITEMASK:
+        for (int i = 0; i < 4; ++i)
+            params[i] = gl_state->color_mask[i];
+        return true;
+    case GL_DEPTH_FUNC:
+        *params = (GLint)gl_state->depth_func;
+        return true;
+    case GL_DEPTH_WRITEMASK:
+        *params = gl_state->depth_mask;
+        return true;
+    case GL_STENCIL_FUNC:
+        *params = (GLint)gl_state->stencil_front.func;
+        return true;
+    case GL_STENCIL_REF:
+        *params = gl_state->stencil_front.ref;
+        return true;
+    case GL_STENCIL_VALUE_MASK:
+        *params = (GLint)gl_state->stencil_front.value_mask;
+        return true;
+    case GL_STENCIL_WRITEMASK:
+        *params = (GLint)gl_state->stencil_front.write_mask;
+        return true;
+    case GL_STENCIL_FAIL:
+        *params = (GLint)gl_state->stencil_front.fail;
+        return true;
+    case GL_STENCIL_PASS_DEPTH_FAIL:
+        *params = (GLint)gl_state->stencil_front.zfail;
+        return true;
+    case GL_STENCIL_PASS_DEPTH_PASS:
+        *params = (GLint)gl_state->stencil_front.zpass;
+        return true;
+    case GL_STENCIL_BACK_FUNC:
+        *params = (GLint)gl_state->stencil_back.func;
+        return true;
+    case GL_STENCIL_BACK_REF:
+        *params = gl_state->stencil_back.ref;
+        return true;
+    case GL_STENCIL_BACK_VALUE_MASK:
+        *params = (GLint)gl_state->stencil_back.value_mask;
+        return true;
+    case GL_STENCIL_BACK_WRITEMASK:
+        *params = (GLint)gl_state->stencil_back.write_mask;
+        return true;
+    case GL_STENCIL_BACK_FAIL:
+        *params = (GLint)gl_state->stencil_back.fail;
+        return true;
+    case GL_STENCIL_BACK_PASS_DEPTH_FAIL:
+        *params = (GLint)gl_state->stencil_back.zfail;
+        return true;
+    case GL_STENCIL_BACK_PASS_DEPTH_PASS:
+        *params = (GLint)gl_state->stencil_back.zpass;
+        return true;
+    case GL_PACK_ALIGNMENT:
+        *params = gl_state->pack.alignment;
+        return true;
+    case GL_PACK_ROW_LENGTH:
+        *params = gl_state->pack.row_length;
+        return true;
+    case GL_PACK_SKIP_PIXELS:
+        *params = gl_state->pack.skip_pixels;
+        return true;
+    case GL_PACK_SKIP_ROWS:
+        *params = gl_state->pack.skip_rows;
+        return true;
+    case GL_UNPACK_ALIGNMENT:
+        *params = gl_state->unpack.alignment;
+        return true;
+    case GL_UNPACK_ROW_LENGTH:
+        *params = gl_state->unpack.row_length;
+        return true;
+    case GL_UNPACK_IMAGE_HEIGHT:
+        *params = gl_state->unpack.image_height;
+        return true;
+    case GL_UNPACK_SKIP_PIXELS:
+        *params = gl_state->unpack.skip_pixels;
+        return true;
+    case GL_UNPACK_SKIP_ROWS:
+        *params = gl_state->unpack.skip_rows;
+        return true;
+    case GL_UNPACK_SKIP_IMAGES:
+        *params = gl_state->unpack.skip_images;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool get_shadow_booleanv(GLenum pname, GLboolean* params) {
+    if (GLbitfield bit = cap_bit(pname)) {
+        *params = (gl_state->enabled_caps & bit) ? GL_TRUE : GL_FALSE;
+        return true;
+    }
+
+    switch (pname) {
+    case GL_COLOR_WRITEMASK:
+        memcpy(params, gl_state->color_mask, sizeof(gl_state->color_mask));
+        return true;
+    case GL_DEPTH_WRITEMASK:
+        *params = gl_state->depth_mask;
+        return true;
+    default:
+        return false;
+    }
+}
+
+void glEnable(GLenum cap) {
+    LOG()
+    MG_TRACE_ARGS(glEnable, cap)
+    LOG_D("glEnable, cap = %s", glEnumToString(cap))
+    LIST_RECORD(ListOp::Enable, {cap})
+    // Fixed-function texturing only affects immediate mode draws
+    if (cap == GL_TEXTURE_2D) {
+        immediate_set_texture_2d(true);
+        return;
+    }
+    GLbitfield bit = cap_bit(cap);
+    FILTER_REDUNDANT_CALL(FilteredCall::Enable, bit && (gl_state->enabled_caps & bit))
+    gl_state->enabled_caps |= bit;
+    flush_immediate();
+    GLES.glEnable(cap);
+    CHECK_GL_ERROR
+}
+
+void glDisable(GLenum cap) {
+    LOG()
+    MG_TRACE_ARGS(glDisable, cap)
+    LOG_D("glDisable, cap = %s", glEnumToString(cap))
+    LIST_RECORD(ListOp::Disable, {cap})
+    // Fixed-function texturing only affects immediate mode draws
+    if (cap == GL_TEXTURE_2D) {
+        immediate_set_texture_2d(false);
+        return;
+    }
+    GLbitfield bit = cap_bit(cap);
+    FILTER_REDUNDANT_CALL(FilteredCall::Disable, bit && !(gl_state->enabled_caps & bit))
+    gl_state->enabled_caps &= ~bit;
+    flush_immediate();
+    GLES.glDisable(cap);
+    CHECK_GL_ERROR
+}
+
+GLboolean glIsEnabled(GLenum cap) {
+    LOG()
+    MG_TRACE_ARGS(glIsEnabled, cap)
+    LOG_D("glIsEnabled, cap = %s", glEnumToString(cap))
+    if (cap == GL_TEXTURE_2D) return immediate_texture_2d_enabled() ? GL_TRUE : GL_FALSE;
+    if (GLbitfield bit = cap_bit(cap)) return (gl_state->enabled_caps & bit) ? GL_TRUE : GL_FALSE;
+    return GLES.glIsEnabled(cap);
+}
+
+// The non-indexed queries report draw buffer 0
+void glEnablei(GLenum target, GLuint index) {
+    LOG()
+    MG_TRACE_ARGS(glEnablei, target, index)
+    LOG_D("glEnablei, target = %s, index = %u", glEnumToString(target), index)
+    if (target == GL_BLEND && index == 0) gl_state->enabled_caps |= STATE_CAP_BLEND;
+    flush_immediate();
+    GLES.glEnablei(target, index);
+    CHECK_GL_ERROR
+}
+
+void glDisablei(GLenum target, GLuint index) {
+    LOG()
+    MG_TRACE_ARGS(glDisablei, target, index)
+    LOG_D("glDisablei, target = %s, index = %u", glEnumToString(target), index)
+    if (target == GL_BLEND && index == 0) gl_state->enabled_caps &= ~STATE_CAP_BLEND;
+    flush_immediate();
+    GLES.glDisablei(target, index);
+    CHECK_GL_ERROR
+}
+
+void glScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    LOG()
+    MG_TRACE_ARGS(glScissor, x, y, width, height)
+    LOG_D("glScissor, x = %d, y = %d, width = %d, height = %d", x, y, width, height)
+    FILTER_REDUNDANT_CALL(FilteredCall::Scissor, gl_state->scissor_known && gl_state->scissor_box[0] == x &&
+                                                     gl_state->scissor_box[1] == y &&
+                                                     gl_state->scissor_box[2] == width &&
+                                                     gl_state->scissor_box[3] == height)
+    if (width >= 0 && height >= 0) {
+        gl_state->scissor_box[0] = x;
+        gl_state->scissor_box[1] = y;
+        gl_state->scissor_box[2] = width;
+        gl_state->scissor_box[3] = height;
+        gl_state->scissor_known = GL_TRUE;
+    }
+    flush_immediate();
+    ApplyFSRScissor(x, y, width, height);
+    CHECK_GL_ERROR
+}
+
+static bool blend_func_is(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    return gl_state->blend_src_rgb == srcRGB && gl_state->blend_dst_rgb == dstRGB &&
+           gl_state->blend_src_alpha == srcAlpha && gl_state->blend_dst_alpha == dstAlpha;
+}
+
+static void set_blend_func(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    gl_state->blend_src_rgb = srcRGB;
+    gl_state->blend_dst_rgb = dstRGB;
+    gl_state->blend_src_alpha = srcAlpha;
+    gl_state->blend_dst_alpha = dstAlpha;
+}
+
+void glBlendFunc(GLenum sfactor, GLenum dfactor) {
+    LOG()
+    MG_TRACE_ARGS(glBlendFunc, sfactor, dfactor)
+    LOG_D("glBlendFunc, sfactor = %s, dfactor = %s", glEnumToString(sfactor), glEnumToString(dfactor))
+    LIST_RECORD(ListOp::BlendFunc, {sfactor, dfactor})
+    FILTER_REDUNDANT_CALL(FilteredCall::BlendFunc, blend_func_is(sfactor, dfactor, sfactor, dfactor))
+    set_blend_func(sfactor, dfactor, sfactor, dfactor);
+    flush_immediate();
+    GLES.glBlendFunc(sfactor, dfactor);
+    CHECK_GL_ERROR
+}
+
+void glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+    LOG()
+    MG_TRACE_ARGS(glBlendFuncSeparate, sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha)
+    LOG_D("glBlendFuncSeparate, %s, %s, %s, %s", glEnumToString(sfactorRGB), glEnumToString(dfactorRGB),
+          glEnumToString(sfactorAlpha), glEnumToString(dfactorAlpha))
+    FILTER_REDUNDANT_CALL(FilteredCall::BlendFunc, blend_func_is(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha))
+    set_blend_func(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+    flush_immediate();
+    GLES.glBlendFuncSeparate(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+    CHECK_GL_ERROR
+}
+
+void glBlendFunci(GLuint buf, GLenum src, GLenum dst) {
+    LOG()
+    MG_TRACE_ARGS(glBlendFunci, buf, src, dst)
+    LOG_D("glBlendFunci, buf = %u, src = %s, dst = %s", buf, glEnumToString(src), glEnumToString(dst))
+    if (buf == 0) set_blend_func(src, dst, src, dst);
+    flush_immediate();
+    GLES.glBlendFunci(buf, src, dst);
+    CHECK_GL_ERROR
+}
+
+void glBlendFuncSeparatei(GLuint buf, GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    LOG()
+    MG_TRACE_ARGS(glBlendFuncSeparatei, buf, srcRGB, dstRGB, srcAlpha, dstAlpha)
+    LOG_D("glBlendFuncSeparatei, buf = %u", buf)
+    if (buf == 0) set_blend_func(srcRGB, dstRGB, srcAlpha, dstAlpha);
+    flush_immediate();
+    GLES.glBlendFuncSeparatei(buf, srcRGB, dstRGB, srcAlpha, dstAlpha);
+    CHECK_GL_ERROR
+}
+
+void glBlendEquation(GLenum mode) {
+    LOG()
+    MG_TRACE_ARGS(glBlendEquation, mode)
+    LOG_D("glBlendEquation, mode = %s", glEnumToString(mode))
+    FILTER_REDUNDANT_CALL(FilteredCall::BlendEquation,
+                          gl_state->blend_equation_rgb == mode && gl_state->blend_equation_alpha == mode)
+    gl_state->blend_equation_rgb = mode;
+    gl_state->blend_equation_alpha = mode;
+    flush_immediate();
+    GLES.glBlendEquation(mode);
+    CHECK_GL_ERROR
+}
+
+void glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+    LOG()
+    MG_TRACE_ARGS(glBlendEquationSeparate, modeRGB, modeAlpha)
+    LOG_D("glBlendEquationSeparate, modeRGB = %s, modeAlpha = %s", glEnumToString(modeRGB), glEnumToString(modeAlpha))
+    FILTER_REDUNDANT_CALL(FilteredCall::BlendEquation,
+                          gl_state->blend_equation_rgb == modeRGB && gl_state->blend_equation_alpha == modeAlpha)
+    gl_state->blend_equation_rgb = modeRGB;
+    gl_state->blend_equation_alpha = modeAlpha;
+    flush_immediate();
+    GLES.glBlendEquationSeparate(modeRGB, modeAlpha);
+    CHECK_GL_ERROR
+}
+
+void glBlendEquationi(GLuint buf, GLenum mode) {
+    LOG()
+    MG_TRACE_ARGS(glBlendEquationi, buf, mode)
+    LOG_D("glBlendEquationi, buf = %u, mode = %s", buf, glEnumToString(mode))
+    if (buf == 0) {
+        gl_state->blend_equation_rgb = mode;
+        gl_state->blend_equation_alpha = mode;
+    }
+    flush_immediate();
+    GLES.glBlendEquationi(buf, mode);
+    CHECK_GL_ERROR
+}
+
+void glBlendEquationSeparatei(GLuint buf, GLenum modeRGB, GLenum modeAlpha) {
+    LOG()
+    MG_TRACE_ARGS(glBlendEquationSeparatei, buf, modeRGB, modeAlpha)
+    LOG_D("glBlendEquationSeparatei, buf = %u", buf)
+    if (buf == 0) {
+        gl_state->blend_equation_rgb = modeRGB;
+        gl_state->blend_equation_alpha = modeAlpha;
+    }
+    flush_immediate();
+    GLES.glBlendEquationSeparatei(buf, modeRGB, modeAlpha);
+    CHECK_GL_ERROR
+}
+
+void glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    LOG()
+    MG_TRACE_ARGS(glColorMask, red, green, blue, alpha)
+    LOG_D("glColorMask, %d, %d, %d, %d", red, green, blue, alpha)
+    const GLboolean mask[4] = {(GLboolean)(red ? GL_TRUE : GL_FALSE), (GLboolean)(green ? GL_TRUE : GL_FALSE),
+                               (GLboolean)(blue ? GL_TRUE : GL_FALSE), (GLboolean)(alpha ? GL_TRUE : GL_FALSE)};
+    FILTER_REDUNDANT_CALL(FilteredCall::ColorMask, memcmp(gl_state->color_mask, mask, sizeof(mask)) == 0)
+    memcpy(gl_state->color_mask, mask, sizeof(mask));
+    flush_immediate();
+    GLES.glColorMask(red, green, blue, alpha);
+    CHECK_GL_ERROR
+}
+
+void glColorMaski(GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a) {
+    LOG()
+    MG_TRACE_ARGS(glColorMaski, index, r, g, b, a)
+    LOG_D("glColorMaski, index = %u, %d, %d, %d, %d", index, r, g, b, a)
+    if (index == 0) {
+        gl_state->color_mask[0] = r ? GL_TRUE : GL_FALSE;
+        gl_state->color_mask[1] = g ? GL_TRUE : GL_FALSE;
+        gl_state->color_mask[2] = b ? GL_TRUE : GL_FALSE;
+        gl_state->color_mask[3] = a ? GL_TRUE : GL_FALSE;
+    }
+    flush_immediate();
+    GLES.glColorMaski(index, r, g, b, a);
+    CHECK_GL_ERROR
+}
+
+void glDepthFunc(GLenum func) {
+    LOG()
+    MG_TRACE_ARGS(glDepthFunc, func)
+    LOG_D("glDepthFunc, func = %s", glEnumToString(func))
+    LIST_RECORD(ListOp::DepthFunc, {func})
+    FILTER_REDUNDANT_CALL(FilteredCall::DepthFunc, gl_state->depth_func == func)
+    gl_state->depth_func = func;
+    flush_immediate();
+    GLES.glDepthFunc(func);
+    CHECK_GL_ERROR
+}
+
+void glDepthMask(GLboolean flag) {
+    LOG()
+    MG_TRACE_ARGS(glDepthMask, flag)
+    LOG_D("glDepthMask, flag = %d", flag)
+    LIST_RECORD(ListOp::DepthMask, {flag})
+    GLboolean mask = flag ? GL_TRUE : GL_FALSE;
+    FILTER_REDUNDANT_CALL(FilteredCall::DepthMask, gl_state->depth_mask == mask)
+    gl_state->depth_mask = mask;
+    flush_immediate();
+    GLES.glDepthMask(flag);
+    CHECK_GL_ERROR
+}
+
+void glStencilFunc(GLenum func, GLint ref, GLuint mask) {
+    LOG()
+    MG_TRACE_ARGS(glStencilFunc, func, ref, mask)
+    LOG_D("glStencilFunc, func = %s, ref = %d, mask = 0x%x", glEnumToString(func), ref, mask)
+    glStencilFuncSeparate(GL_FRONT_AND_BACK, func, ref, mask);
+}
+
+void glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+    LOG()
+    MG_TRACE_ARGS(glStencilFuncSeparate, face, func, ref, mask)
+    LOG_D("glStencilFuncSeparate, face = %s, func = %s, ref = %d, mask = 0x%x", glEnumToString(face),
+          glEnumToString(func), ref, mask)
+    gl_stencil_face_s* second;
+    for (gl_stencil_face_s* f = stencil_faces(face, second); f; f = second, second = nullptr) {
+        f->func = func;
+        f->ref = ref;
+        f->value_mask = mask;
+    }
+    flush_immediate();
+    GLES.glStencilFuncSeparate(face, func, ref, mask);
+    CHECK_GL_ERROR
+}
+
+void glStencilOp(GLenum fail, GLenum zfail, GLenum zpass) {
+    LOG()
+    MG_TRACE_ARGS(glStencilOp, fail, zfail, zpass)
+    LOG_D("glStencilOp, %s, %s, %s", glEnumToString(fail), glEnumToString(zfail), glEnumToString(zpass))
+    glStencilOpSeparate(GL_FRONT_AND_BACK, fail, zfail, zpass);
+}
+
+void glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    LOG()
+    MG_TRACE_ARGS(glStencilOpSeparate, face, sfail, dpfail, dppass)
+    LOG_D("glStencilOpSeparate, face = %s, %s, %s, %s", glEnumToString(face), glEnumToString(sfail),
+          glEnumToString(dpfail), glEnumToString(dppass))
+    gl_stencil_face_s* second;
+    for (gl_stencil_face_s* f = stencil_faces(face, second); f; f = second, second = nullptr) {
+        f->fail = sfail;
+        f->zfail = dpfail;
+        f->zpass = dppass;
+    }
+    flush_immediate();
+    GLES.glStencilOpSeparate(face, sfail, dpfail, dppass);
+    CHECK_GL_ERROR
+}
+
+void glStencilMask(GLuint mask) {
+    LOG()
+    MG_TRACE_ARGS(glStencilMask, mask)
+    LOG_D("glStencilMask, mask = 0x%x", mask)
+    glStencilMaskSeparate(GL_FRONT_AND_BACK, mask);
+}
+
+void glStencilMaskSeparate(GLenum face, GLuint mask) {
+    LOG()
+    MG_TRACE_ARGS(glStencilMaskSeparate, face, mask)
+    LOG_D("glStencilMaskSeparate, face = %s, mask = 0x%x", glEnumToString(face), mask)
+    gl_stencil_face_s* second;
+    for (gl_stencil_face_s* f = stencil_faces(face, second); f; f = second, second = nullptr) {
+        f->write_mask = mask;
+    }
+    flush_immediate();
+    GLES.glStencilMaskSeparate(face, mask);
+    CHECK_GL_ERROR
+}
+
+void glGetBooleanv(GLenum pname, GLboolean* data) {
+    LOG()
+    MG_TRACE_ARGS(glGetBooleanv, pname, data)
+    LOG_D("glGetBooleanv, pname: %s", glEnumToString(pname))
+    if (get_shadow_booleanv(pname, data)) return;
+    GLES.glGetBooleanv(pname, data);
+    CHECK_GL_ERROR
+}
+
+static void restore_stencil_face(GLenum face, const gl_stencil_face_s& s) {
+    GLES.glStencilFuncSeparate(face, s.func, s.ref, s.value_mask);
+    GLES.glStencilOpSeparate(face, s.fail, s.zfail, s.zpass);
+    GLES.glStencilMaskSeparate(face, s.write_mask);
+}
+
+StateScope::StateScope(GLbitfield mask) : m_mask(mask), m_saved(*gl_state) {
+    if (m_mask & STATE_SCOPE_ARRAY_BUFFER) m_arrayBuffer = find_real_bound_buffer(GL_ARRAY_BUFFER_BINDING);
+}
+
+StateScope::~StateScope() {
+    const gl_state_s& s = m_saved;
+
+    if (m_mask & STATE_SCOPE_PROGRAM) {
+        gl_state->current_program = s.current_program;
+        GLES.glUseProgram(s.current_program);
+    }
+    if (m_mask & STATE_SCOPE_VERTEX_ARRAY) {
+        gl_state->current_vao = s.current_vao;
+        GLES.glBindVertexArray(s.current_vao);
+    }
+    if (m_mask & STATE_SCOPE_ARRAY_BUFFER) {
+        GLES.glBindBuffer(GL_ARRAY_BUFFER, m_arrayBuffer);
+    }
+    if (m_mask & STATE_SCOPE_TEXTURE) {
+        GLuint unit = s.current_tex_unit;
+        gl_state->current_tex_unit = unit;
+        GLES.glActiveTexture(GL_TEXTURE0 + unit);
+        if (unit < MG_MAX_TEXTURE_UNITS) {
+            gl_state->texture_binding_2d[unit] = s.texture_binding_2d[unit];
+            GLES.glBindTexture(GL_TEXTURE_2D, s.texture_binding_2d[unit]);
+        }
+    }
+    if (m_mask & STATE_SCOPE_RENDERBUFFER) {
+        gl_state->current_renderbuffer = s.current_renderbuffer;
+        GLES.glBindRenderbuffer(GL_RENDERBUFFER, s.current_renderbuffer);
+    }
+    if (m_mask & STATE_SCOPE_FRAMEBUFFER) {
+        gl_state->current_read_fbo = s.current_read_fbo;
+        gl_state->current_draw_fbo = s.current_draw_fbo;
+        GLES.glBindFramebuffer(GL_READ_FRAMEBUFFER, s.current_read_fbo);
+        GLES.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s.current_draw_fbo);
+    }
+    if ((m_mask & STATE_SCOPE_VIEWPORT) && s.viewport_known) {
+        memcpy(gl_state->viewport, s.viewport, sizeof(s.viewport));
+        gl_state->viewport_known = GL_TRUE;
+        GLES.glViewport(s.viewport[0], s.viewport[1], s.viewport[2], s.viewport[3]);
+    }
+    if ((m_mask & STATE_SCOPE_SCISSOR) && s.scissor_known) {
+        memcpy(gl_state->scissor_box, s.scissor_box, sizeof(s.scissor_box));
+        gl_state->scissor_known = GL_TRUE;
+        GLES.glScissor(s.scissor_box[0], s.scissor_box[1], s.scissor_box[2], s.scissor_box[3]);
+    }
+    if (m_mask & STATE_SCOPE_CAPS) {
+        gl_state->enabled_caps = s.enabled_caps;
+        for (GLenum cap : kCapEnums) {
+            if (s.enabled_caps & cap_bit(cap))
+                GLES.glEnable(cap);
+            else
+                GLES.glDisable(cap);
+        }
+    }
+    if (m_mask & STATE_SCOPE_BLEND) {
+        set_blend_func(s.blend_src_rgb, s.blend_dst_rgb, s.blend_src_alpha, s.blend_dst_alpha);
+        gl_state->blend_equation_rgb = s.blend_equation_rgb;
+        gl_state->blend_equation_alpha = s.blend_equation_alpha;
+        GLES.glBlendFuncSeparate(s.blend_src_rgb, s.blend_dst_rgb, s.blend_src_alpha, s.blend_dst_alpha);
+        GLES.glBlendEquationSeparate(s.blend_equation_rgb, s.blend_equation_alpha);
+    }
+    if (m_mask & STATE_SCOPE_COLOR_MASK) {
+        memcpy(gl_state->color_mask, s.color_mask, sizeof(s.color_mask));
+        GLES.glColorMask(s.color_mask[0], s.color_mask[1], s.color_mask[2], s.color_mask[3]);
+    }
+    if (m_mask & STATE_SCOPE_DEPTH) {
+        gl_state->depth_func = s.depth_func;
+        gl_state->depth_mask = s.depth_mask;
+        GLES.glDepthFunc(s.depth_func);
+        GLES.glDepthMask(s.depth_mask);
+    }
+    if (m_mask & STATE_SCOPE_STENCIL) {
+        gl_state->stencil_front = s.stencil_front;
+        gl_state->stencil_back = s.stencil_back;
+        restore_stencil_face(GL_FRONT, s.stencil_front);
+        restore_stencil_face(GL_BACK, s.stencil_back);
+    }
+    if (m_mask & STATE_SCOPE_UNPACK) {
+        gl_state->unpack = s.unpack;
+        GLES.glPixelStorei(GL_UNPACK_ALIGNMENT, s.unpack.alignment);
+        GLES.glPixelStorei(GL_UNPACK_ROW_LENGTH, s.unpack.row_length);
+        GLES.glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, s.unpack.image_height);
+        GLES.glPixelStorei(GL_UNPACK_SKIP_PIXELS, s.unpack.skip_pixels);
+        GLES.glPixelStorei(GL_UNPACK_SKIP_ROWS, s.unpack.skip_rows);
+        GLES.glPixelStorei(GL_UNPACK_SKIP_IMAGES, s.unpack.skip_images);
+    }
+}
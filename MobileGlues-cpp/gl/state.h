@@ -0,0 +1,170 @@
+// MobileGlues - gl/state.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_STATE_H
+#define MOBILEGLUES_STATE_H
+
+#include "../includes.h"
+#include <GL/gl.h>
+#include "glcorearb.h"
+#include "log.h"
+#include "../gles/loader.h"
+#include "mg.h"
+#include "../config/settings.h"
+
+#include <cstdint>
+#include <string>
+
+// Capabilities shadowed in gl_state->enabled_caps. Anything else passed to
+// glEnable/glDisable goes straight to GLES and is not answered from the shadow.
+enum StateCap : GLbitfield {
+    STATE_CAP_BLEND = 1u << 0,
+    STATE_CAP_CULL_FACE = 1u << 1,
+    STATE_CAP_DEPTH_TEST = 1u << 2,
+    STATE_CAP_DITHER = 1u << 3,
+    STATE_CAP_POLYGON_OFFSET_FILL = 1u << 4,
+    STATE_CAP_PRIMITIVE_RESTART_FIXED_INDEX = 1u << 5,
+    STATE_CAP_RASTERIZER_DISCARD = 1u << 6,
+    STATE_CAP_SAMPLE_ALPHA_TO_COVERAGE = 1u << 7,
+    STATE_CAP_SAMPLE_COVERAGE = 1u << 8,
+    STATE_CAP_SAMPLE_MASK = 1u << 9,
+    STATE_CAP_SCISSOR_TEST = 1u << 10,
+    STATE_CAP_STENCIL_TEST = 1u << 11,
+};
+
+// Entry points covered by the redundant state filter
+enum class FilteredCall : int {
+    BindTexture = 0,
+    ActiveTexture,
+    BindBuffer,
+    BindVertexArray,
+    Enable,
+    Disable,
+    BlendFunc,
+    BlendEquation,
+    ColorMask,
+    DepthFunc,
+    DepthMask,
+    ClearDepth,
+    Viewport,
+    Scissor,
+    Count
+};
+
+extern uint64_t g_state_filter_dropped[(int)FilteredCall::Count];
+
+// Per-call counts of what the filter dropped, one line each
+std::string dump_state_filter_stats(const std::string& prefix = "");
+
+// Returns from the calling entry point, without reaching GLES, when the state
+// filter is enabled and the call would leave the shadowed state as it is.
+#define FILTER_REDUNDANT_CALL(call, redundant)                                                                         \
+    if (global_settings.state_filter && (redundant)) {                                                                 \
+        ++g_state_filter_dropped[(int)(call)];                                                                         \
+        LOG_D("  -> redundant, dropped")                                                                               \
+        return;                                                                                                        \
+    }
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    GLAPI GLAPIENTRY void glEnable(GLenum cap);
+    GLAPI GLAPIENTRY void glDisable(GLenum cap);
+    GLAPI GLAPIENTRY GLboolean glIsEnabled(GLenum cap);
+    GLAPI GLAPIENTRY void glEnablei(GLenum target, GLuint index);
+    GLAPI GLAPIENTRY void glDisablei(GLenum target, GLuint index);
+    GLAPI GLAPIENTRY void glScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+    GLAPI GLAPIENTRY void glBlendFunc(GLenum sfactor, GLenum dfactor);
+    GLAPI GLAPIENTRY void glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha,
+                                              GLenum dfactorAlpha);
+    GLAPI GLAPIENTRY void glBlendFunci(GLuint buf, GLenum src, GLenum dst);
+    GLAPI GLAPIENTRY void glBlendFuncSeparatei(GLuint buf, GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha,
+                                               GLenum dstAlpha);
+    GLAPI GLAPIENTRY void glBlendEquation(GLenum mode);
+    GLAPI GLAPIENTRY void glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha);
+    GLAPI GLAPIENTRY void glBlendEquationi(GLuint buf, GLenum mode);
+    GLAPI GLAPIENTRY void glBlendEquationSeparatei(GLuint buf, GLenum modeRGB, GLenum modeAlpha);
+    GLAPI GLAPIENTRY void glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+    GLAPI GLAPIENTRY void glColorMaski(GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a);
+    GLAPI GLAPIENTRY void glDepthFunc(GLenum func);
+    GLAPI GLAPIENTRY void glDepthMask(GLboolean flag);
+    GLAPI GLAPIENTRY void glStencilFunc(GLenum func, GLint ref, GLuint mask);
+    GLAPI GLAPIENTRY void glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+    GLAPI GLAPIENTRY void glStencilOp(GLenum fail, GLenum zfail, GLenum zpass);
+    GLAPI GLAPIENTRY void glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+    GLAPI GLAPIENTRY void glStencilMask(GLuint mask);
+    GLAPI GLAPIENTRY void glStencilMaskSeparate(GLenum face, GLuint mask);
+    GLAPI GLAPIENTRY void glGetBooleanv(GLenum pname, GLboolean* data);
+
+#ifdef __cplusplus
+}
+#endif
+
+// Resets the shadow to the initial state of a fresh GLES context.
+void init_gl_state_shadow(gl_state_t state);
+
+// Points gl_state at the shadow of context, after eglMakeCurrent made it
+// current on this thread. A context seen for the first time gets a fresh
+// shadow. EGL_NO_CONTEXT keeps gl_state as it is.
+void make_gl_state_current(const void* context);
+
+// Frees the shadow of a context eglDestroyContext destroyed
+void forget_gl_state_context(const void* context);
+
+void set_gl_state_viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+void set_gl_state_pixel_store(GLenum pname, GLint param);
+void set_gl_state_texture_binding_2d(GLuint unit, GLuint texture);
+void forget_gl_state_texture(GLuint texture);
+
+// Calls glEnable/glDisable for the shadowed capabilities that differ from caps
+void set_gl_state_caps(GLbitfield caps);
+
+// Answer a query from the shadow. Return false if pname is not shadowed and
+// the caller has to ask GLES.
+bool get_shadow_integerv(GLenum pname, GLint* params);
+bool get_shadow_booleanv(GLenum pname, GLboolean* params);
+
+enum StateScopeBits : GLbitfield {
+    STATE_SCOPE_PROGRAM = 1u << 0,
+    STATE_SCOPE_VERTEX_ARRAY = 1u << 1,
+    STATE_SCOPE_ARRAY_BUFFER = 1u << 2,
+    // Active texture unit and the GL_TEXTURE_2D binding on that unit
+    STATE_SCOPE_TEXTURE = 1u << 3,
+    STATE_SCOPE_FRAMEBUFFER = 1u << 4,
+    STATE_SCOPE_RENDERBUFFER = 1u << 5,
+    STATE_SCOPE_VIEWPORT = 1u << 6,
+    STATE_SCOPE_SCISSOR = 1u << 7,
+    STATE_SCOPE_CAPS = 1u << 8,
+    STATE_SCOPE_BLEND = 1u << 9,
+    STATE_SCOPE_COLOR_MASK = 1u << 10,
+    STATE_SCOPE_DEPTH = 1u << 11,
+    STATE_SCOPE_STENCIL = 1u << 12,
+    STATE_SCOPE_UNPACK = 1u << 13,
+};
+
+// Saves the selected parts of the shadow and, on destruction, puts both GLES
+// and the shadow back to them. Nothing is queried from the driver, so code
+// inside the scope may change the saved state through GLES.* freely.
+class StateScope {
+public:
+    explicit StateScope(GLbitfield mask);
+    ~StateScope();
+
+    StateScope(const StateScope&) = delete;
+    StateScope& operator=(const StateScope&) = delete;
+
+    const gl_state_s& saved() const { return m_saved; }
+
+private:
+    GLbitfield m_mask;
+    GLuint m_arrayBuffer = 0;
+    gl_state_s m_saved;
+};
+
+#endif // MOBILEGLUES_STATE_H
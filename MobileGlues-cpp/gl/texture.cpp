@@ -12,8 +12,10 @@
 #include <cstring>
 #include <vector>
 
-#ifndef __APPLE__
+#ifdef __ANDROID__
 #include <android/log.h>
+#endif
+#ifndef __APPLE__
 #include <malloc.h>
 #endif
 
@@ -22,6 +24,12 @@
 #include "framebuffer.h"
 #include "log.h"
 #include "mg.h"
+#include "pixel.h"
+#include "state.h"
+#include "texture_buffer.h"
+#include "FSR1/FSR1.h"
+#include "display_list.h"
+#include "immediate.h"
 #include <GL/gl.h>
 #include <ankerl/unordered_dense.h>
 
@@ -151,7 +159,7 @@ TextureTarget ConvertGLEnumToTextureTarget(GLenum target) {
     }
 }
 
-const int MAX_TEXTURE_IMAGE_UNITS = 32;
+const int MAX_TEXTURE_IMAGE_UNITS = MG_MAX_TEXTURE_UNITS;
 
 class TextureBindingSlot {
 public:
@@ -477,6 +485,8 @@ void internal_convert(GLenum* internal_format, GLenum* type, GLenum* format) {
 
 void glTexParameterf(GLenum target, GLenum pname, GLfloat param) {
     LOG()
+    MG_TRACE_ARGS(glTexParameterf, target, pname, param)
+    flush_immediate();
     pname = pname_convert(pname);
     LOG_D("glTexParameterf, target: %d, pname: %d, param: %f", target, pname, param)
 
@@ -503,6 +513,7 @@ void glTexParameterf(GLenum target, GLenum pname, GLfloat param) {
 void glTexImage1D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLint border, GLenum format,
                   GLenum type, const GLvoid* pixels) {
     LOG()
+    MG_TRACE_ARGS(glTexImage1D, target, level, internalFormat, width, border, format, type, pixels)
     LOG_D("glTexImage1D not implemented!")
     LOG_D("glTexImage1D, target: %d, level: %d, internalFormat: %d, width: %d, "
           "border: %d, format: %d, type: %d",
@@ -533,15 +544,39 @@ void glTexImage1D(GLenum target, GLint level, GLint internalFormat, GLsizei widt
     CHECK_GL_ERROR
 }
 
+// Sized luminance/alpha formats do not exist in GLES; store them as RGBA8 and
+// expand the client data on upload
+static void promote_luminance_alpha(GLint& internalFormat) {
+    switch (internalFormat) {
+    case GL_LUMINANCE8:
+    case GL_ALPHA8:
+    case GL_LUMINANCE8_ALPHA8:
+        internalFormat = GL_RGBA8;
+        break;
+    default:
+        break;
+    }
+}
+
+// internal_convert uploads these as RGBA/GL_UNSIGNED_BYTE, so data in any
+// other layout has to be widened to that first
+static bool stored_as_rgba8(GLint internalFormat) {
+    return internalFormat == GL_RGBA8 || internalFormat == GL_RGBA;
+}
+
 void glTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border,
                   GLenum format, GLenum type, const GLvoid* pixels) {
     LOG()
-    GLenum transfer_format = format;
+    MG_TRACE_ARGS(glTexImage2D, target, level, internalFormat, width, height, border, format, type, pixels)
+    flush_immediate();
 
     LOG_D("mg_glTexImage2D,target: %s,level: %d,internalFormat: %s->%s,width: "
           "%d,height: %d,border: %d,format: %s,type: %s, pixels: 0x%x",
           glEnumToString(target), level, glEnumToString(internalFormat), glEnumToString(internalFormat), width, height,
           border, glEnumToString(format), glEnumToString(type), pixels)
+    promote_luminance_alpha(internalFormat);
+    bool expand = stored_as_rgba8(internalFormat);
+    PixelUpload upload(find_pixel_conversion(format, type, expand), width, height, 0, format, type, pixels);
     internal_convert(reinterpret_cast<GLenum*>(&internalFormat), &type, &format);
 
     LOG_D("GLES.glTexImage2D,target: %s,level: %d,internalFormat: %s->%s,width: "
@@ -569,34 +604,6 @@ void glTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei widt
     tex->swizzle_param[2] = GL_BLUE;
     tex->swizzle_param[3] = GL_ALPHA;
 
-    if (transfer_format == GL_BGRA && tex->format != transfer_format && internalFormat == GL_RGBA8 && width <= 128 &&
-        height <= 128) { // xaero has 64x64 tiles...hack here
-        LOG_D("Detected GL_BGRA format @ tex = %d, do swizzle", tex->texture)
-        if (tex->swizzle_param[0] == 0) { // assert this as never called glTexParameteri(...,
-                                          // GL_TEXTURE_SWIZZLE_R, ...)
-            tex->swizzle_param[0] = GL_RED;
-            tex->swizzle_param[1] = GL_GREEN;
-            tex->swizzle_param[2] = GL_BLUE;
-            tex->swizzle_param[3] = GL_ALPHA;
-        }
-
-        GLint r = tex->swizzle_param[0];
-        GLint g = tex->swizzle_param[1];
-        GLint b = tex->swizzle_param[2];
-        GLint a = tex->swizzle_param[3];
-        tex->swizzle_param[0] = g;
-        tex->swizzle_param[1] = b;
-        tex->swizzle_param[2] = a;
-        tex->swizzle_param[3] = r;
-        tex->format = transfer_format;
-
-        GLES.glTexParameteri(target, GL_TEXTURE_SWIZZLE_R, tex->swizzle_param[0]);
-        GLES.glTexParameteri(target, GL_TEXTURE_SWIZZLE_G, tex->swizzle_param[1]);
-        GLES.glTexParameteri(target, GL_TEXTURE_SWIZZLE_B, tex->swizzle_param[2]);
-        GLES.glTexParameteri(target, GL_TEXTURE_SWIZZLE_A, tex->swizzle_param[3]);
-        CHECK_GL_ERROR
-    }
-
     tex->format = format;
 
     GLES.glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
@@ -607,10 +614,14 @@ void glTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei widt
 void glTexImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth,
                   GLint border, GLenum format, GLenum type, const GLvoid* pixels) {
     LOG()
+    MG_TRACE_ARGS(glTexImage3D, target, level, internalFormat, width, height, depth, border, format, type, pixels)
     LOG_D("glTexImage3D, target: 0x%x, level: %d, internalFormat: 0x%x, width: "
           "0x%x, height: %d, depth: %d, border: %d, format: 0x%x, type: %d",
           target, level, internalFormat, width, height, depth, border, format, type)
 
+    promote_luminance_alpha(internalFormat);
+    bool expand = stored_as_rgba8(internalFormat);
+    PixelUpload upload(find_pixel_conversion(format, type, expand), width, height, depth, format, type, pixels);
     internal_convert(reinterpret_cast<GLenum*>(&internalFormat), &type, &format);
     GLenum rtarget = map_tex_target(target);
     if (rtarget == GL_PROXY_TEXTURE_3D) {
@@ -641,6 +652,7 @@ void glTexImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei widt
 
 void glTexStorage1D(GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width) {
     LOG()
+    MG_TRACE_ARGS(glTexStorage1D, target, levels, internalFormat, width)
     LOG_D("glTexStorage1D not implemented!")
     LOG_D("glTexStorage1D, target: %d, levels: %d, internalFormat: %d, width: %d", target, levels, internalFormat,
           width)
@@ -662,6 +674,7 @@ void glTexStorage1D(GLenum target, GLsizei levels, GLenum internalFormat, GLsize
 
 void glTexStorage2D(GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height) {
     LOG()
+    MG_TRACE_ARGS(glTexStorage2D, target, levels, internalFormat, width, height)
     LOG_D("glTexStorage2D, target: %d, levels: %d, internalFormat: %d, width: "
           "%d, height: %d",
           target, levels, internalFormat, width, height)
@@ -687,6 +700,7 @@ void glTexStorage2D(GLenum target, GLsizei levels, GLenum internalFormat, GLsize
 void glTexStorage3D(GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height,
                     GLsizei depth) {
     LOG()
+    MG_TRACE_ARGS(glTexStorage3D, target, levels, internalFormat, width, height, depth)
     LOG_D("glTexStorage3D, target: %d, levels: %d, internalFormat: %d, width: "
           "%d, height: %d, depth: %d",
           target, levels, internalFormat, width, height, depth)
@@ -712,6 +726,7 @@ void glTexStorage3D(GLenum target, GLsizei levels, GLenum internalFormat, GLsize
 void glCopyTexImage1D(GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width,
                       GLint border) {
     LOG()
+    MG_TRACE_ARGS(glCopyTexImage1D, target, level, internalFormat, x, y, width, border)
     LOG_D("glCopyTexImage1D not implemented!")
     LOG_D("glCopyTexImage1D, target: %d, level: %d, internalFormat: %d, x: %d, "
           "y: %d, width: %d, border: %d",
@@ -762,6 +777,8 @@ static GLenum get_binding_for_target(GLenum target) {
 void glCopyTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width,
                       GLsizei height, GLint border) {
     LOG()
+    MG_TRACE_ARGS(glCopyTexImage2D, target, level, internalFormat, x, y, width, height, border)
+    flush_immediate();
 
     INIT_CHECK_GL_ERROR
 
@@ -803,7 +820,9 @@ void glCopyTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLint x
         }
         CHECK_GL_ERROR_NO_INIT
 
-        GLES.glBlitFramebuffer(x, y, x + width, y + height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        GLint srcX0 = x, srcY0 = y, srcX1 = x + width, srcY1 = y + height;
+        ScaleFSRReadCorners(srcX0, srcY0, srcX1, srcY1);
+        GLES.glBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
         CHECK_GL_ERROR_NO_INIT
 
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFBO);
@@ -811,7 +830,9 @@ void glCopyTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLint x
         glDeleteFramebuffers(1, &tempDrawFBO);
         CHECK_GL_ERROR_NO_INIT
     } else {
-        GLES.glCopyTexImage2D(target, level, internalFormat, x, y, width, height, border);
+        GLint srcX = x, srcY = y;
+        FSRReadScope fsr(srcX, srcY, width, height);
+        GLES.glCopyTexImage2D(target, level, internalFormat, srcX, srcY, width, height, border);
         CHECK_GL_ERROR_NO_INIT
     }
 
@@ -832,6 +853,8 @@ void glCopyTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLint x
 void glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width,
                          GLsizei height) {
     LOG()
+    MG_TRACE_ARGS(glCopyTexSubImage2D, target, level, xoffset, yoffset, x, y, width, height)
+    flush_immediate();
     GLint internalFormat;
     GLES.glGetTexLevelParameteriv(target, level, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
 
@@ -858,20 +881,39 @@ void glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffse
             return;
         }
 
-        GLES.glBlitFramebuffer(x, y, x + width, y + height, xoffset, yoffset, xoffset + width, yoffset + height,
+        GLint srcX0 = x, srcY0 = y, srcX1 = x + width, srcY1 = y + height;
+        ScaleFSRReadCorners(srcX0, srcY0, srcX1, srcY1);
+        GLES.glBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, xoffset, yoffset, xoffset + width, yoffset + height,
                                GL_DEPTH_BUFFER_BIT, GL_NEAREST);
 
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFBO);
         glDeleteFramebuffers(1, &tempDrawFBO);
     } else {
+        FSRReadScope fsr(x, y, width, height);
         GLES.glCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height);
     }
 
     CHECK_GL_ERROR
 }
 
+void glCopyTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y,
+                         GLsizei width, GLsizei height) {
+    LOG()
+    MG_TRACE_ARGS(glCopyTexSubImage3D, target, level, xoffset, yoffset, zoffset, x, y, width, height)
+    LOG_D("glCopyTexSubImage3D, target: %s, level: %d, xoffset: %d, yoffset: %d, zoffset: %d, "
+          "x: %d, y: %d, width: %d, height: %d",
+          glEnumToString(target), level, xoffset, yoffset, zoffset, x, y, width, height)
+    flush_immediate();
+
+    FSRReadScope fsr(x, y, width, height);
+    GLES.glCopyTexSubImage3D(target, level, xoffset, yoffset, zoffset, x, y, width, height);
+
+    CHECK_GL_ERROR
+}
+
 void glRenderbufferStorage(GLenum target, GLenum internalFormat, GLsizei width, GLsizei height) {
     LOG()
+    MG_TRACE_ARGS(glRenderbufferStorage, target, internalFormat, width, height)
 
     INIT_CHECK_GL_ERROR_FORCE
 
@@ -887,6 +929,7 @@ void glRenderbufferStorage(GLenum target, GLenum internalFormat, GLsizei width,
 void glRenderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum internalFormat, GLsizei width,
                                       GLsizei height) {
     LOG()
+    MG_TRACE_ARGS(glRenderbufferStorageMultisample, target, samples, internalFormat, width, height)
 
     INIT_CHECK_GL_ERROR_FORCE
 
@@ -901,6 +944,7 @@ void glRenderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum int
 
 void glGetTexLevelParameterfv(GLenum target, GLint level, GLenum pname, GLfloat* params) {
     LOG()
+    MG_TRACE_ARGS(glGetTexLevelParameterfv, target, level, pname, params)
     LOG_D("glGetTexLevelParameterfv,target: %d, level: %d, pname: %d", target, level, pname)
     if (gl_state) {
         GLenum rtarget = map_tex_target(target);
@@ -926,6 +970,7 @@ void glGetTexLevelParameterfv(GLenum target, GLint level, GLenum pname, GLfloat*
 
 void glGetTexLevelParameteriv(GLenum target, GLint level, GLenum pname, GLint* params) {
     LOG()
+    MG_TRACE_ARGS(glGetTexLevelParameteriv, target, level, pname, params)
     LOG_D("glGetTexLevelParameteriv,target: %s, level: %d, pname: %s", glEnumToString(target), level,
           glEnumToString(pname))
     if (gl_state) {
@@ -954,6 +999,8 @@ void glGetTexLevelParameteriv(GLenum target, GLint level, GLenum pname, GLint* p
 
 void glTexParameteriv(GLenum target, GLenum pname, const GLint* params) {
     LOG()
+    MG_TRACE_ARGS(glTexParameteriv, target, pname, params)
+    flush_immediate();
     LOG_D("glTexParameteriv, target: %s, pname: %s", glEnumToString(target), glEnumToString(pname))
 
     if (pname == GL_TEXTURE_SWIZZLE_RGBA) {
@@ -984,33 +1031,64 @@ void glTexParameteriv(GLenum target, GLenum pname, const GLint* params) {
 void glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
                      GLenum format, GLenum type, const void* pixels) {
     LOG()
+    MG_TRACE_ARGS(glTexSubImage2D, target, level, xoffset, yoffset, width, height, format, type, pixels)
+    flush_immediate();
 
     LOG_D("glTexSubImage2D, target = %s, level = %d, xoffset = %d, yoffset = %d, "
           "width = %d, height = %d, format = %s, type = %s, pixels = 0x%x",
           glEnumToString(target), level, xoffset, yoffset, width, height, glEnumToString(format), glEnumToString(type),
           pixels)
 
-    if (format == GL_BGRA && type == GL_UNSIGNED_INT_8_8_8_8) {
-        format = GL_RGBA;
-        type = GL_UNSIGNED_BYTE;
-    }
+    TextureObject* tex = mgGetTexObjectByTarget(target);
+    bool expand = tex && stored_as_rgba8((GLint)tex->internal_format);
+    PixelUpload upload(find_pixel_conversion(format, type, expand), width, height, 0, format, type, pixels);
 
     GLES.glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
 
     CHECK_GL_ERROR
 }
 
+void glTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width,
+                     GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels) {
+    LOG()
+    MG_TRACE_ARGS(glTexSubImage3D, target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels)
+
+    LOG_D("glTexSubImage3D, target = %s, level = %d, offset = %d,%d,%d, size = %dx%dx%d, format = %s, type = %s",
+          glEnumToString(target), level, xoffset, yoffset, zoffset, width, height, depth, glEnumToString(format),
+          glEnumToString(type))
+
+    TextureObject* tex = mgGetTexObjectByTarget(target);
+    bool expand = tex && stored_as_rgba8((GLint)tex->internal_format);
+    PixelUpload upload(find_pixel_conversion(format, type, expand), width, height, depth, format, type, pixels);
+
+    GLES.glTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+
+    CHECK_GL_ERROR
+}
+
 void glBindTexture(GLenum target, GLuint texture) {
     LOG()
+    MG_TRACE_ARGS(glBindTexture, target, texture)
+    flush_immediate();
     LOG_D("glBindTexture(%s, %d)", glEnumToString(target), texture)
+    LIST_RECORD(ListOp::BindTexture, {target, texture})
     INIT_CHECK_GL_ERROR
 
+    if (target == GL_TEXTURE_2D && gl_state->current_tex_unit < MG_MAX_TEXTURE_UNITS) {
+        auto bound = mgGetTexObjectByTarget(GL_TEXTURE_2D);
+        FILTER_REDUNDANT_CALL(FilteredCall::BindTexture,
+                              gl_state->texture_binding_2d[gl_state->current_tex_unit] == texture &&
+                                  (bound ? bound->texture : 0) == texture)
+    }
+
     if (hardware && gl_state && hardware->emulate_texture_buffer && target == GL_TEXTURE_BUFFER) {
-        GLES.glActiveTexture(GL_TEXTURE0 + 15);
+        GLES.glActiveTexture(GL_TEXTURE0 + TEXTURE_BUFFER_UNIT);
         GLES.glBindTexture(GL_TEXTURE_2D, texture);
         GLES.glActiveTexture(GL_TEXTURE0 + gl_state->current_tex_unit);
+        set_gl_state_texture_binding_2d(TEXTURE_BUFFER_UNIT, texture);
     } else {
         GLES.glBindTexture(target, texture);
+        if (target == GL_TEXTURE_2D) set_gl_state_texture_binding_2d(gl_state->current_tex_unit, texture);
     }
     CHECK_GL_ERROR_NO_INIT
 
@@ -1033,22 +1111,29 @@ void glBindTexture(GLenum target, GLuint texture) {
 
 void glDeleteTextures(GLsizei n, const GLuint* textures) {
     LOG()
+    MG_TRACE_ARGS(glDeleteTextures, n, textures)
+    flush_immediate();
     INIT_CHECK_GL_ERROR
     GLES.glDeleteTextures(n, textures);
     CHECK_GL_ERROR_NO_INIT
 
     for (GLsizei i = 0; i < n; ++i) {
         MarkTextureObjectForDeletion(textures[i]);
+        forget_gl_state_texture(textures[i]);
+        texture_buffer_forget_texture(textures[i]);
+        framebuffer_forget_texture(textures[i]);
     }
 }
 
 void glActiveTexture(GLenum texture) {
     LOG()
+    MG_TRACE_ARGS(glActiveTexture, texture)
     LOG_D("glActiveTexture, texture = %s", glEnumToString(texture))
     if (texture < GL_TEXTURE0 || texture >= GL_TEXTURE0 + MAX_TEXTURE_IMAGE_UNITS) {
         LOG_E("Invalid texture enum: %s", glEnumToString(texture))
         return;
     }
+    FILTER_REDUNDANT_CALL(FilteredCall::ActiveTexture, gl_state->current_tex_unit == texture - GL_TEXTURE0)
 
     set_gl_state_current_tex_unit(texture - GL_TEXTURE0);
     GLES.glActiveTexture(texture);
@@ -1056,118 +1141,122 @@ void glActiveTexture(GLenum texture) {
     CHECK_GL_ERROR
 }
 
+// Read framebuffer for glGetTexImage, created once and reused
+static GLuint g_readbackFBO = 0;
+
+// Size of one packed image of a 3D or layered readback, honouring the
+// GL_PACK_* state the way desktop glGetTexImage does
+static size_t pack_image_size(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+    const auto& pack = gl_state->pack;
+    size_t rowPixels = pack.row_length > 0 ? pack.row_length : width;
+    size_t rowBytes = widthalign(rowPixels * pixel_sizeof(format, type), pack.alignment);
+    size_t rows = pack.image_height > 0 ? pack.image_height : height;
+    return rowBytes * rows;
+}
+
+// glReadPixels from the bound read framebuffer, as it is
+static void read_pixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels) {
+    const pixel_conversion_t* conversion = find_pixel_conversion(format, type);
+    if (conversion && read_pixels_converted(conversion, x, y, width, height, pixels)) return;
+
+    pack_buffer_before_read(width, height, format, type, pixels);
+    GLES.glReadPixels(x, y, width, height, format, type, pixels);
+}
+
 void glGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void* pixels) {
     LOG()
+    MG_TRACE_ARGS(glGetTexImage, target, level, format, type, pixels)
     LOG_D("glGetTexImage, target: 0x%x, level: %d, format: 0x%x, type: 0x%x, pixels: 0x%x", target, level, format, type,
           pixels)
-    GLint prevDrawFBO;
-    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDrawFBO);
-    GLint prevReadFBO;
-    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFBO);
-
-    GLuint tempFBO = 0;
-    glGenFramebuffers(1, &tempFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, tempFBO);
-
-    GLint textureId = 0;
-    GLenum textureBindingTarget;
-    if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) {
-        textureBindingTarget = GL_TEXTURE_BINDING_CUBE_MAP;
-    } else if (target == GL_TEXTURE_2D) {
-        textureBindingTarget = GL_TEXTURE_BINDING_2D;
-    } else {
+    flush_immediate();
+
+    bool isCubeFace = target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z;
+    bool isLayered = target == GL_TEXTURE_3D || target == GL_TEXTURE_2D_ARRAY || target == GL_TEXTURE_CUBE_MAP_ARRAY;
+    if (target != GL_TEXTURE_2D && !isCubeFace && !isLayered) {
         LOG_E("glGetTexImage: Unsupported or complex target: 0x%x", target)
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFBO);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFBO);
-        glDeleteFramebuffers(1, &tempFBO);
         return;
     }
-    glGetIntegerv(textureBindingTarget, &textureId);
 
+    GLuint textureId = 0;
+    if (target == GL_TEXTURE_2D && gl_state->current_tex_unit < MG_MAX_TEXTURE_UNITS) {
+        textureId = gl_state->texture_binding_2d[gl_state->current_tex_unit];
+    } else {
+        auto textureObject = mgGetTexObjectByTarget(target);
+        textureId = textureObject ? textureObject->texture : 0;
+    }
     if (textureId == 0) {
         LOG_E("glGetTexImage: No texture bound to the specified target.")
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFBO);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFBO);
-        glDeleteFramebuffers(1, &tempFBO);
         return;
     }
 
-    GLint width = 0, height = 0;
+    GLint width = 0, height = 0, depth = 1;
     glGetTexLevelParameteriv(target, level, GL_TEXTURE_WIDTH, &width);
     glGetTexLevelParameteriv(target, level, GL_TEXTURE_HEIGHT, &height);
+    if (isLayered) glGetTexLevelParameteriv(target, level, GL_TEXTURE_DEPTH, &depth);
 
-    if (width == 0 || height == 0) {
+    if (width == 0 || height == 0 || depth == 0) {
         LOG_E("glGetTexImage: Texture level %d has zero width or height.", level)
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFBO);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFBO);
-        glDeleteFramebuffers(1, &tempFBO);
         return;
     }
 
-    if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) {
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, textureId, level);
-    } else if (target == GL_TEXTURE_2D) {
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, level);
+    size_t imageSize = 0;
+    if (isLayered) {
+        imageSize = pack_image_size(width, height, format, type);
+        if (imageSize == 0) {
+            LOG_E("glGetTexImage: Cannot size %s/%s images for a layered readback", glEnumToString(format),
+                  glEnumToString(type))
+            return;
+        }
     }
 
-    GLenum fboStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-    if (fboStatus != GL_FRAMEBUFFER_COMPLETE) {
-        LOG_E("glGetTexImage: Failed to create complete framebuffer. Status: 0x%x", fboStatus)
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFBO);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFBO);
-        glDeleteFramebuffers(1, &tempFBO);
-        return;
-    }
+    // Only the read binding is touched, the scope puts it back from the shadow
+    StateScope state(STATE_SCOPE_FRAMEBUFFER);
+    if (!g_readbackFBO) GLES.glGenFramebuffers(1, &g_readbackFBO);
+    GLES.glBindFramebuffer(GL_READ_FRAMEBUFFER, g_readbackFBO);
+
+    // With a GL_PIXEL_PACK_BUFFER bound `pixels` is an offset into it, so
+    // each pack below is queued on the GPU and nothing waits for it here.
+    auto* dst = static_cast<GLubyte*>(pixels) + imageSize * gl_state->pack.skip_images;
+    for (GLint layer = 0; layer < depth; ++layer) {
+        if (isLayered) {
+            GLES.glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, textureId, level, layer);
+        } else {
+            GLES.glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, textureId, level);
+        }
 
-    glReadBuffer(GL_COLOR_ATTACHMENT0);
+        if (layer == 0) {
+            GLenum fboStatus = glCheckFramebufferStatus(GL_READ_FRAMEBUFFER);
+            if (fboStatus != GL_FRAMEBUFFER_COMPLETE) {
+                LOG_E("glGetTexImage: Failed to create complete framebuffer. Status: 0x%x", fboStatus)
+                break;
+            }
+        }
 
-    glReadPixels(0, 0, width, height, format, type, pixels);
+        read_pixels(0, 0, width, height, format, type, dst + imageSize * layer);
+    }
 
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFBO);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFBO);
-    glDeleteFramebuffers(1, &tempFBO);
+    // Do not keep the texture alive through the scratch framebuffer
+    GLES.glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
 }
 
-#if GLOBAL_DEBUG || DEBUG
-#include "../config/config.h"
-#include <fstream>
-#endif
-
 void glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels) {
     LOG()
+    MG_TRACE_ARGS(glReadPixels, x, y, width, height, format, type, pixels)
+    flush_immediate();
     LOG_D("glReadPixels, x=%d, y=%d, width=%d, height=%d, format=0x%x, "
           "type=0x%x, pixels=0x%x",
           x, y, width, height, format, type, pixels)
 
-    static int count = 0;
-    GLenum prevFormat = format;
+    FSRReadScope fsr(x, y, width, height);
+    read_pixels(x, y, width, height, format, type, pixels);
 
-    if (format == GL_BGRA && type == GL_UNSIGNED_INT_8_8_8_8) {
-        format = GL_RGBA;
-        type = GL_UNSIGNED_BYTE;
-    }
-    LOG_D("glReadPixels converted, x=%d, y=%d, width=%d, height=%d, format=0x%x, "
-          "type=0x%x, pixels=0x%x",
-          x, y, width, height, format, type, pixels)
-    GLES.glReadPixels(x, y, width, height, format, type, pixels);
-
-#if GLOBAL_DEBUG || DEBUG
-    if (prevFormat == GL_BGRA && type == GL_UNSIGNED_BYTE) {
-        std::vector<uint8_t> px(width * height * sizeof(uint8_t) * 4, 0);
-        GLES.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        GLES.glReadPixels(x, y, width, height, format, type, px.data());
-
-        std::fstream fs(std::string(concatenate(mg_directory_path, "/readpixels/")) + std::to_string(count++) + ".bin",
-                        std::ios::out | std::ios::binary | std::ios::trunc);
-        fs.write((const char*)px.data(), px.size());
-        fs.close();
-    }
-#endif
     CHECK_GL_ERROR
 }
 
 void glTexParameteri(GLenum target, GLenum pname, GLint param) {
     LOG()
+    MG_TRACE_ARGS(glTexParameteri, target, pname, param)
+    flush_immediate();
     pname = pname_convert(pname);
     LOG_D("glTexParameteri, pname: 0x%x", pname)
 
@@ -1182,6 +1271,7 @@ void glTexParameteri(GLenum target, GLenum pname, GLint param) {
 
 void glClearTexImage(GLuint texture, GLint level, GLenum format, GLenum type, const void* data) {
     LOG()
+    MG_TRACE_ARGS(glClearTexImage, texture, level, format, type, data)
     LOG_D("glClearTexImage, texture: %d, level: %d, format: %d, type: %d", texture, level, format, type)
     INIT_CHECK_GL_ERROR_FORCE
     GLuint fbo, prevDrawFBO, prevReadFBO;
@@ -1223,7 +1313,7 @@ void glClearTexImage(GLuint texture, GLint level, GLenum format, GLenum type, co
             GLES.glClearColor(floatData[0], floatData[1], floatData[2], 1.0f);
         } else if (format == GL_DEPTH_COMPONENT && type == GL_FLOAT) {
             auto* depthData = static_cast<const GLfloat*>(data);
-            GLES.glClearDepthf(depthData[0]);
+            glClearDepth(depthData[0]);
             GLES.glClear(GL_DEPTH_BUFFER_BIT);
         } else if (format == GL_STENCIL_INDEX && type == GL_UNSIGNED_BYTE) {
             auto* stencilData = static_cast<const GLubyte*>(data);
@@ -1247,7 +1337,12 @@ void glClearTexImage(GLuint texture, GLint level, GLenum format, GLenum type, co
 }
 
 void glPixelStorei(GLenum pname, GLint param) {
+    LOG()
+    MG_TRACE_ARGS(glPixelStorei, pname, param)
     LOG_D("glPixelStorei, pname = %s, param = %d", glEnumToString(pname), param)
+    set_gl_state_pixel_store(pname, param);
+    // Only used by glGetTexImage, ES has no packing of 3D images
+    if (pname == GL_PACK_IMAGE_HEIGHT || pname == GL_PACK_SKIP_IMAGES) return;
     GLES.glPixelStorei(pname, param);
     CHECK_GL_ERROR
 }
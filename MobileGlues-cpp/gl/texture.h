@@ -35,6 +35,8 @@ extern "C"
                                            GLsizei width, GLsizei height, GLint border);
     GLAPI GLAPIENTRY void glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x,
                                               GLint y, GLsizei width, GLsizei height);
+    GLAPI GLAPIENTRY void glCopyTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+                                              GLint x, GLint y, GLsizei width, GLsizei height);
     GLAPI GLAPIENTRY void glRenderbufferStorage(GLenum target, GLenum internalFormat, GLsizei width, GLsizei height);
     GLAPI GLAPIENTRY void glRenderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum internalFormat,
                                                            GLsizei width, GLsizei height);
@@ -42,6 +44,9 @@ extern "C"
     GLAPI GLAPIENTRY void glGetTexLevelParameteriv(GLenum target, GLint level, GLenum pname, GLint* params);
     GLAPI GLAPIENTRY void glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
                                           GLsizei height, GLenum format, GLenum type, const void* pixels);
+    GLAPI GLAPIENTRY void glTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+                                          GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type,
+                                          const void* pixels);
     GLAPI GLAPIENTRY void glTexParameteriv(GLenum target, GLenum pname, const GLint* params);
     GLAPI GLAPIENTRY void glGenerateTextureMipmap(GLuint texture);
     GLAPI GLAPIENTRY void glBindTexture(GLenum target, GLuint texture);
@@ -0,0 +1,399 @@
+// MobileGlues - gl/texture_buffer.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "texture_buffer.h"
+#include "buffer.h"
+#include "log.h"
+#include "mg.h"
+#include "pixel.h"
+#include "texture.h"
+#include "../gles/loader.h"
+#include <ankerl/unordered_dense.h>
+
+#include <algorithm>
+#include <vector>
+
+#define DEBUG 0
+
+// Past this many disjoint dirty ranges the whole texture is uploaded instead
+#define TEXTURE_BUFFER_MAX_DIRTY_RANGES 32
+
+extern UnorderedMap<GLuint, bool> program_map_is_sampler_buffer_emulated;
+
+namespace {
+    struct TextureBufferFormat {
+        GLenum internalformat;
+        GLenum format;
+        GLenum type;
+        GLuint size;
+    };
+
+    // The buffer texture formats GLES can also sample as 2D textures
+    const TextureBufferFormat kTextureBufferFormats[] = {
+        {GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1},
+        {GL_R16F, GL_RED, GL_HALF_FLOAT, 2},
+        {GL_R32F, GL_RED, GL_FLOAT, 4},
+        {GL_R8I, GL_RED_INTEGER, GL_BYTE, 1},
+        {GL_R16I, GL_RED_INTEGER, GL_SHORT, 2},
+        {GL_R32I, GL_RED_INTEGER, GL_INT, 4},
+        {GL_R8UI, GL_RED_INTEGER, GL_UNSIGNED_BYTE, 1},
+        {GL_R16UI, GL_RED_INTEGER, GL_UNSIGNED_SHORT, 2},
+        {GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, 4},
+        {GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2},
+        {GL_RG16F, GL_RG, GL_HALF_FLOAT, 4},
+        {GL_RG32F, GL_RG, GL_FLOAT, 8},
+        {GL_RG8I, GL_RG_INTEGER, GL_BYTE, 2},
+        {GL_RG16I, GL_RG_INTEGER, GL_SHORT, 4},
+        {GL_RG32I, GL_RG_INTEGER, GL_INT, 8},
+        {GL_RG8UI, GL_RG_INTEGER, GL_UNSIGNED_BYTE, 2},
+        {GL_RG16UI, GL_RG_INTEGER, GL_UNSIGNED_SHORT, 4},
+        {GL_RG32UI, GL_RG_INTEGER, GL_UNSIGNED_INT, 8},
+        {GL_RGB32F, GL_RGB, GL_FLOAT, 12},
+        {GL_RGB32I, GL_RGB_INTEGER, GL_INT, 12},
+        {GL_RGB32UI, GL_RGB_INTEGER, GL_UNSIGNED_INT, 12},
+        {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4},
+        {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8},
+        {GL_RGBA32F, GL_RGBA, GL_FLOAT, 16},
+        {GL_RGBA8I, GL_RGBA_INTEGER, GL_BYTE, 4},
+        {GL_RGBA16I, GL_RGBA_INTEGER, GL_SHORT, 8},
+        {GL_RGBA32I, GL_RGBA_INTEGER, GL_INT, 16},
+        {GL_RGBA8UI, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, 4},
+        {GL_RGBA16UI, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, 8},
+        {GL_RGBA32UI, GL_RGBA_INTEGER, GL_UNSIGNED_INT, 16},
+    };
+
+    const TextureBufferFormat* find_texture_buffer_format(GLenum internalformat) {
+        for (const auto& format : kTextureBufferFormats) {
+            if (format.internalformat == internalformat) return &format;
+        }
+        return nullptr;
+    }
+
+    struct ByteRange {
+        size_t begin;
+        size_t end;
+    };
+
+    struct EmulatedTextureBuffer {
+        GLuint buffer = 0;
+        const TextureBufferFormat* format = nullptr;
+        GLintptr offset = 0;
+        GLsizeiptr size = -1;
+
+        // What the 2D texture was last allocated as
+        const TextureBufferFormat* allocatedFormat = nullptr;
+        GLsizei width = 0;
+        GLsizei height = 0;
+
+        // Dirty bytes of the buffer, sorted and disjoint
+        std::vector<ByteRange> dirty;
+        bool wholeDirty = true;
+    };
+
+    struct ProgramSamplers {
+        GLint locWidth = -1;
+        GLint locHeight = -1;
+        std::vector<GLint> samplers;
+        // Last values written to the size uniforms
+        GLint width = -1;
+        GLint height = -1;
+    };
+
+    ankerl::unordered_dense::map<GLuint, EmulatedTextureBuffer> g_texture_buffers;
+    // Application buffer -> emulated textures sourcing from it
+    ankerl::unordered_dense::map<GLuint, std::vector<GLuint>> g_buffer_users;
+    // Application buffer -> range mapped for writing
+    ankerl::unordered_dense::map<GLuint, ByteRange> g_mapped_ranges;
+    ankerl::unordered_dense::map<GLuint, ProgramSamplers> g_program_samplers;
+
+    void add_dirty_range(EmulatedTextureBuffer& tb, size_t begin, size_t end) {
+        if (tb.wholeDirty || begin >= end) return;
+
+        auto& dirty = tb.dirty;
+        auto it = std::lower_bound(dirty.begin(), dirty.end(), begin,
+                                   [](const ByteRange& r, size_t value) { return r.end < value; });
+        // Merge every range that overlaps or touches [begin, end)
+        auto last = it;
+        while (last != dirty.end() && last->begin <= end) {
+            begin = std::min(begin, last->begin);
+            end = std::max(end, last->end);
+            ++last;
+        }
+        it = dirty.erase(it, last);
+        dirty.insert(it, {begin, end});
+
+        if (dirty.size() > TEXTURE_BUFFER_MAX_DIRTY_RANGES) {
+            dirty.clear();
+            tb.wholeDirty = true;
+        }
+    }
+
+    void detach_from_buffer(GLuint texture, GLuint buffer) {
+        auto it = g_buffer_users.find(buffer);
+        if (it == g_buffer_users.end()) return;
+        auto& users = it->second;
+        users.erase(std::remove(users.begin(), users.end(), texture), users.end());
+        if (users.empty()) g_buffer_users.erase(it);
+    }
+
+    size_t query_buffer_size(GLuint buffer) {
+        size_t size = get_buffer_data_size(buffer);
+        if (size) return size;
+
+        // Storage that did not come through glBufferData
+        GLint querySize = 0;
+        GLuint prev = find_real_bound_buffer(GL_COPY_READ_BUFFER_BINDING);
+        GLES.glBindBuffer(GL_COPY_READ_BUFFER, find_real_buffer(buffer));
+        GLES.glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &querySize);
+        GLES.glBindBuffer(GL_COPY_READ_BUFFER, prev);
+        return querySize > 0 ? (size_t)querySize : 0;
+    }
+
+    // Copies texels [first, last) from the bound unpack buffer. Full rows go
+    // in one call; a trailing partial row needs its own, as reading a full row
+    // there would run past the end of the buffer.
+    void upload_texels(const EmulatedTextureBuffer& tb, size_t texels, size_t first, size_t last) {
+        if (first >= last) return;
+        const size_t width = tb.width;
+        const size_t rowBytes = width * tb.format->size;
+        const size_t fullRows = texels / width;
+        const size_t firstRow = first / width;
+        const size_t lastRow = (last - 1) / width;
+
+        if (firstRow < fullRows) {
+            size_t rows = std::min(lastRow + 1, fullRows) - firstRow;
+            GLES.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, (GLint)firstRow, (GLsizei)width, (GLsizei)rows,
+                                 tb.format->format, tb.format->type, (const void*)(tb.offset + firstRow * rowBytes));
+        }
+        if (lastRow >= fullRows) {
+            GLES.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, (GLint)lastRow, (GLsizei)(texels - lastRow * width), 1,
+                                 tb.format->format, tb.format->type, (const void*)(tb.offset + lastRow * rowBytes));
+        }
+    }
+
+    // Expects the texture to be bound to GL_TEXTURE_2D on the active unit
+    void flush_texture_buffer(GLuint texture, EmulatedTextureBuffer& tb) {
+        GLuint realBuffer = find_real_buffer(tb.buffer);
+        if (!realBuffer || !tb.format) return;
+
+        // Persistently mapped buffers change behind our back
+        if (get_buffer_generation(tb.buffer) == BUFFER_GENERATION_VOLATILE) tb.wholeDirty = true;
+        if (!tb.wholeDirty && tb.dirty.empty()) return;
+
+        const size_t bufferSize = query_buffer_size(tb.buffer);
+        const size_t begin = std::min((size_t)tb.offset, bufferSize);
+        const size_t end = tb.size < 0 ? bufferSize : std::min(begin + (size_t)tb.size, bufferSize);
+        const size_t texels = (end - begin) / tb.format->size;
+
+        GLsizei width = (GLsizei)std::max<size_t>(std::min<size_t>(texels, TEXTURE_BUFFER_WIDTH), 1);
+        GLsizei height = (GLsizei)std::max<size_t>((texels + width - 1) / width, 1);
+        if (tb.allocatedFormat != tb.format || tb.width != width || tb.height != height) {
+            LOG_D("texture_buffer: allocating texture %u as %dx%d %s", texture, width, height,
+                  glEnumToString(tb.format->internalformat))
+            if (!tb.allocatedFormat) {
+                GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+                GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+                GLES.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+            }
+            GLuint prevUnpack = find_real_bound_buffer(GL_PIXEL_UNPACK_BUFFER_BINDING);
+            if (prevUnpack) GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            GLES.glTexImage2D(GL_TEXTURE_2D, 0, (GLint)tb.format->internalformat, width, height, 0,
+                              tb.format->format, tb.format->type, nullptr);
+            if (prevUnpack) GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, prevUnpack);
+            tb.allocatedFormat = tb.format;
+            tb.width = width;
+            tb.height = height;
+            tb.wholeDirty = true;
+
+            if (auto tex = mgGetTexObjectByID(texture)) {
+                tex->target = TextureTarget::TEXTURE_BUFFER;
+                tex->internal_format = tb.format->internalformat;
+                tex->format = tb.format->format;
+                tex->width = width;
+                tex->height = height;
+                tex->depth = 1;
+            }
+        }
+
+        if (texels) {
+            GLuint prevUnpack = find_real_bound_buffer(GL_PIXEL_UNPACK_BUFFER_BINDING);
+            GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, realBuffer);
+            set_unpack_tight(true);
+
+            if (tb.wholeDirty) {
+                LOG_D("texture_buffer: uploading all %zu texels of texture %u", texels, texture)
+                upload_texels(tb, texels, 0, texels);
+            } else {
+                const size_t texelSize = tb.format->size;
+                for (const auto& range : tb.dirty) {
+                    size_t first = range.begin > begin ? (range.begin - begin) / texelSize : 0;
+                    size_t last = range.end > begin ? (range.end - begin + texelSize - 1) / texelSize : 0;
+                    LOG_D("texture_buffer: uploading texels [%zu, %zu) of texture %u", first,
+                          std::min(last, texels), texture)
+                    upload_texels(tb, texels, first, std::min(last, texels));
+                }
+            }
+
+            set_unpack_tight(false);
+            GLES.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, prevUnpack);
+        }
+
+        tb.dirty.clear();
+        tb.wholeDirty = false;
+        CHECK_GL_ERROR
+    }
+
+    ProgramSamplers* get_program_samplers(GLuint program) {
+        auto it = g_program_samplers.find(program);
+        if (it != g_program_samplers.end()) return &it->second;
+
+        auto emulated = program_map_is_sampler_buffer_emulated.find(program);
+        if (emulated == program_map_is_sampler_buffer_emulated.end() || !emulated->second) return nullptr;
+
+        auto& info = g_program_samplers[program];
+        info.locWidth = GLES.glGetUniformLocation(program, "u_BufferTexWidth");
+        info.locHeight = GLES.glGetUniformLocation(program, "u_BufferTexHeight");
+        if (info.locWidth == -1) LOG_W("u_BufferTexWidth uniform not found in program %d", program);
+
+        GLint numUniforms = 0;
+        GLES.glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &numUniforms);
+        for (GLint i = 0; i < numUniforms; ++i) {
+            const GLsizei bufSize = 256;
+            GLchar name[bufSize];
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            GLES.glGetActiveUniform(program, i, bufSize, &length, &size, &type, name);
+
+            // process_sampler_buffer turns isamplerBuffer into isampler2D
+            if (type != GL_INT_SAMPLER_2D) continue;
+            GLint location = GLES.glGetUniformLocation(program, name);
+            if (location < 0) continue;
+            info.samplers.push_back(location);
+            // Sampler units are program state, so this sticks until relink
+            GLES.glUniform1i(location, TEXTURE_BUFFER_UNIT);
+        }
+        LOG_D("texture_buffer: program %u has %zu emulated samplers", program, info.samplers.size())
+        return &info;
+    }
+} // namespace
+
+void texture_buffer_attach(GLuint texture, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    const TextureBufferFormat* format = find_texture_buffer_format(internalformat);
+    if (!format) {
+        LOG_E("texture_buffer: unsupported internal format %s", glEnumToString(internalformat))
+        return;
+    }
+
+    auto& tb = g_texture_buffers[texture];
+    if (tb.buffer == buffer && tb.format == format && tb.offset == offset && tb.size == size) return;
+
+    if (tb.buffer != buffer) {
+        if (tb.buffer) detach_from_buffer(texture, tb.buffer);
+        if (buffer) g_buffer_users[buffer].push_back(texture);
+    }
+    tb.buffer = buffer;
+    tb.format = format;
+    tb.offset = offset;
+    tb.size = size;
+    tb.dirty.clear();
+    tb.wholeDirty = true;
+}
+
+void texture_buffer_written(GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    if (g_buffer_users.empty()) return;
+    auto it = g_buffer_users.find(buffer);
+    if (it == g_buffer_users.end()) return;
+
+    for (GLuint texture : it->second) {
+        auto& tb = g_texture_buffers[texture];
+        if (size < 0) {
+            tb.dirty.clear();
+            tb.wholeDirty = true;
+        } else {
+            add_dirty_range(tb, (size_t)offset, (size_t)offset + (size_t)size);
+        }
+    }
+}
+
+void texture_buffer_mapped(GLuint buffer, GLintptr offset, GLsizeiptr length) {
+    if (g_buffer_users.find(buffer) == g_buffer_users.end()) return;
+    g_mapped_ranges[buffer] = {(size_t)offset, length < 0 ? SIZE_MAX : (size_t)offset + (size_t)length};
+}
+
+void texture_buffer_unmapped(GLuint buffer) {
+    if (g_mapped_ranges.empty()) return;
+    auto it = g_mapped_ranges.find(buffer);
+    if (it == g_mapped_ranges.end()) return;
+
+    ByteRange range = it->second;
+    g_mapped_ranges.erase(it);
+    texture_buffer_written(buffer, (GLintptr)range.begin,
+                           range.end == SIZE_MAX ? -1 : (GLsizeiptr)(range.end - range.begin));
+}
+
+void texture_buffer_forget_buffer(GLuint buffer) {
+    g_mapped_ranges.erase(buffer);
+    auto it = g_buffer_users.find(buffer);
+    if (it == g_buffer_users.end()) return;
+    for (GLuint texture : it->second) {
+        g_texture_buffers[texture].buffer = 0;
+    }
+    g_buffer_users.erase(it);
+}
+
+void texture_buffer_forget_texture(GLuint texture) {
+    auto it = g_texture_buffers.find(texture);
+    if (it == g_texture_buffers.end()) return;
+    if (it->second.buffer) detach_from_buffer(texture, it->second.buffer);
+    g_texture_buffers.erase(it);
+}
+
+void texture_buffer_prepare_draw(GLuint program) {
+    GLuint texture = gl_state->texture_binding_2d[TEXTURE_BUFFER_UNIT];
+    auto it = texture ? g_texture_buffers.find(texture) : g_texture_buffers.end();
+    if (it != g_texture_buffers.end()) {
+        auto& tb = it->second;
+        if (tb.wholeDirty || !tb.dirty.empty() ||
+            get_buffer_generation(tb.buffer) == BUFFER_GENERATION_VOLATILE) {
+            // The texture is already bound on its unit; only the active unit
+            // has to move for the uploads
+            if (gl_state->current_tex_unit != TEXTURE_BUFFER_UNIT)
+                GLES.glActiveTexture(GL_TEXTURE0 + TEXTURE_BUFFER_UNIT);
+            flush_texture_buffer(texture, tb);
+            if (gl_state->current_tex_unit != TEXTURE_BUFFER_UNIT)
+                GLES.glActiveTexture(GL_TEXTURE0 + gl_state->current_tex_unit);
+        }
+    }
+
+    ProgramSamplers* info = get_program_samplers(program);
+    if (!info || info->samplers.empty() || it == g_texture_buffers.end()) return;
+
+    const auto& tb = it->second;
+    if (info->width != tb.width && info->locWidth != -1) {
+        GLES.glUniform1i(info->locWidth, tb.width);
+        info->width = tb.width;
+    }
+    if (info->height != tb.height && info->locHeight != -1) {
+        GLES.glUniform1i(info->locHeight, tb.height);
+        info->height = tb.height;
+    }
+}
+
+void texture_buffer_forget_program(GLuint program) {
+    g_program_samplers.erase(program);
+}
+
+bool texture_buffer_is_sampler(GLuint program, GLint location) {
+    auto it = g_program_samplers.find(program);
+    if (it == g_program_samplers.end()) return false;
+    const auto& samplers = it->second.samplers;
+    return std::find(samplers.begin(), samplers.end(), location) != samplers.end();
+}
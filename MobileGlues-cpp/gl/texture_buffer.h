@@ -0,0 +1,51 @@
+// MobileGlues - gl/texture_buffer.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_TEXTURE_BUFFER_H
+#define MOBILEGLUES_TEXTURE_BUFFER_H
+
+#include "../includes.h"
+#include <GL/gl.h>
+#include "glcorearb.h"
+
+// Buffer texture emulation for GLES 3.1 and below
+// (hardware->emulate_texture_buffer).
+//
+// The texture bound to GL_TEXTURE_BUFFER lives as a GL_TEXTURE_2D on unit
+// TEXTURE_BUFFER_UNIT, TEXTURE_BUFFER_WIDTH texels wide. Shaders index it
+// through u_BufferTexWidth/u_BufferTexHeight (see process_sampler_buffer).
+// Writes to a source buffer are recorded as dirty byte ranges, and only the
+// rows they cover are copied from the buffer before the next draw.
+
+#define TEXTURE_BUFFER_UNIT 15
+#define TEXTURE_BUFFER_WIDTH 8192
+
+// glTexBuffer/glTexBufferRange on the emulated texture. size < 0 covers the
+// whole buffer.
+void texture_buffer_attach(GLuint texture, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+// Source buffer writes, by application buffer name. size < 0 means the whole
+// buffer, which is also what a reallocation reports.
+void texture_buffer_written(GLuint buffer, GLintptr offset, GLsizeiptr size);
+void texture_buffer_mapped(GLuint buffer, GLintptr offset, GLsizeiptr length);
+void texture_buffer_unmapped(GLuint buffer);
+
+void texture_buffer_forget_buffer(GLuint buffer);
+void texture_buffer_forget_texture(GLuint texture);
+
+// Uploads what is dirty in the bound emulated texture and points the
+// program's emulated samplers and size uniforms at it.
+void texture_buffer_prepare_draw(GLuint program);
+
+// Drops the sampler cache of a program, on (re)link or name reuse.
+void texture_buffer_forget_program(GLuint program);
+
+// Whether location is an emulated buffer sampler of program, whose unit has
+// to stay TEXTURE_BUFFER_UNIT.
+bool texture_buffer_is_sampler(GLuint program, GLint location);
+
+#endif // MOBILEGLUES_TEXTURE_BUFFER_H
@@ -11,15 +11,18 @@
 
 void glVertexAttribI1ui(GLuint index, GLuint x) {
     LOG()
+    MG_TRACE_ARGS(glVertexAttribI1ui, index, x)
     GLES.glVertexAttribI4ui(index, x, 0, 0, 0);
 }
 
 void glVertexAttribI2ui(GLuint index, GLuint x, GLuint y) {
     LOG()
+    MG_TRACE_ARGS(glVertexAttribI2ui, index, x, y)
     GLES.glVertexAttribI4ui(index, x, y, 0, 0);
 }
 
 void glVertexAttribI3ui(GLuint index, GLuint x, GLuint y, GLuint z) {
     LOG()
+    MG_TRACE_ARGS(glVertexAttribI3ui, index, x, y, z)
     GLES.glVertexAttribI4ui(index, x, y, z, 0);
 }
\ No newline at end of file
@@ -468,6 +468,7 @@ extern "C"
     GL_FUNC_TYPEDEF(void, glBufferStorageEXT, GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)
     GL_FUNC_TYPEDEF(void, glGetQueryObjectivEXT, GLuint id, GLenum pname, GLint* params)
     GL_FUNC_TYPEDEF(void, glGetQueryObjecti64vEXT, GLuint id, GLenum pname, GLint64* params)
+    GL_FUNC_TYPEDEF(void, glQueryCounterEXT, GLuint id, GLenum target)
     GL_FUNC_TYPEDEF(void, glBindFragDataLocationEXT, GLuint program, GLuint colorNumber, const GLchar* name)
     GL_FUNC_TYPEDEF(void*, glMapBufferOES, GLenum target, GLenum access)
 
@@ -846,6 +847,7 @@ extern "C"
         GL_FUNC_DECL(glBufferStorageEXT)
         GL_FUNC_DECL(glGetQueryObjectivEXT)
         GL_FUNC_DECL(glGetQueryObjecti64vEXT)
+        GL_FUNC_DECL(glQueryCounterEXT)
         GL_FUNC_DECL(glBindFragDataLocationEXT)
         GL_FUNC_DECL(glMapBufferOES)
 
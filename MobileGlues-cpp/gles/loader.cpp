@@ -15,12 +15,16 @@
 #include "../gl/envvars.h"
 #include "../gl/log.h"
 #include "../gl/mg.h"
+#include "../gl/state.h"
 #include "../gl/buffer.h"
 #include "../gl/getter.h"
 #include "../config/settings.h"
 #include "../gl/texture.h"
 #include "../gl/framebuffer.h"
 
+#include <ankerl/unordered_dense.h>
+#include <string_view>
+
 #define DEBUG 0
 
 void *gles = nullptr, *egl = nullptr;
@@ -76,10 +80,27 @@ void* open_lib(const char** names, const char* override) {
     return lib;
 }
 
+const char* backend_library_override(const char* var) {
+#if defined(MG_BUILD_TESTS) || GLOBAL_DEBUG
+    if (HasEnvVar(var)) return GetEnvVar(var);
+#endif
+    return nullptr;
+}
+
 void load_libs() {
 #ifndef __APPLE__
     const char* gles_override = global_settings.angle == AngleMode::Enabled ? GLES_ANGLE : nullptr;
     const char* egl_override = global_settings.angle == AngleMode::Enabled ? EGL_ANGLE : nullptr;
+    // Explicit backend libraries, e.g. a desktop GLES implementation or a
+    // headless stand-in when running off-device. These win over ANGLE.
+    if (const char* library = backend_library_override("MG_GLES_LIBRARY")) {
+        gles_override = library;
+        LOG_I("Using GLES backend from MG_GLES_LIBRARY: %s", gles_override)
+    }
+    if (const char* library = backend_library_override("MG_EGL_LIBRARY")) {
+        egl_override = library;
+        LOG_I("Using EGL backend from MG_EGL_LIBRARY: %s", egl_override)
+    }
     gles = open_lib(gles3_lib, gles_override);
     egl = open_lib(egl_lib, egl_override);
 #else
@@ -92,6 +113,12 @@ void* proc_address(void* lib, const char* name) {
     return dlsym(lib, name);
 }
 
+void* gles_resolve(const char* name) {
+    void* func = proc_address(gles, name);
+    if (!func) LOG_E("GLES function %s is not available", name)
+    return func;
+}
+
 void set_hardware() {
     hardware = new hardware_s;
     set_es_version();
@@ -103,6 +130,8 @@ void set_hardware() {
 
 void init_gl_state() {
     gl_state = new gl_state_s;
+    init_gl_state_shadow(gl_state);
+    g_default_gl_state = gl_state;
     set_gl_state_proxy_height(0);
     set_gl_state_proxy_width(0);
     set_gl_state_proxy_intformat(0);
@@ -131,6 +160,26 @@ void LogOpenGLExtensions() {
 
 struct gles_caps_t g_gles_caps;
 
+// Backend extensions we look for, keyed by name, and the flag each one sets
+static const ankerl::unordered_dense::map<std::string_view, int gles_caps_t::*> backend_extensions = {
+    {"GL_EXT_buffer_storage", &gles_caps_t::GL_EXT_buffer_storage},
+    {"GL_EXT_disjoint_timer_query", &gles_caps_t::GL_EXT_disjoint_timer_query},
+    {"GL_QCOM_texture_lod_bias", &gles_caps_t::GL_QCOM_texture_lod_bias},
+    {"GL_EXT_blend_func_extended", &gles_caps_t::GL_EXT_blend_func_extended},
+    {"GL_EXT_texture_format_BGRA8888", &gles_caps_t::GL_EXT_texture_format_BGRA8888},
+    {"GL_EXT_read_format_bgra", &gles_caps_t::GL_EXT_read_format_bgra},
+    {"GL_OES_mapbuffer", &gles_caps_t::GL_OES_mapbuffer},
+    {"GL_EXT_multi_draw_indirect", &gles_caps_t::GL_EXT_multi_draw_indirect},
+    {"GL_OES_draw_elements_base_vertex", &gles_caps_t::GL_OES_draw_elements_base_vertex},
+    {"GL_OES_depth_texture", &gles_caps_t::GL_OES_depth_texture},
+    {"GL_OES_depth24", &gles_caps_t::GL_OES_depth24},
+    {"GL_OES_depth_texture_float", &gles_caps_t::GL_OES_depth_texture_float},
+    {"GL_EXT_texture_norm16", &gles_caps_t::GL_EXT_texture_norm16},
+    {"GL_EXT_texture_rg", &gles_caps_t::GL_EXT_texture_rg},
+    {"GL_EXT_texture_query_lod", &gles_caps_t::GL_EXT_texture_query_lod},
+    {"GL_EXT_draw_elements_base_vertex", &gles_caps_t::GL_EXT_draw_elements_base_vertex},
+};
+
 void InitGLESCapabilities() {
     memset(&g_gles_caps, 0, sizeof(struct gles_caps_t));
 
@@ -146,39 +195,8 @@ void InitGLESCapabilities() {
         const char* extension = (const char*)GLES.glGetStringi(GL_EXTENSIONS, i);
         if (extension) {
             LOG_D("%s", (const char*)extension)
-            if (strcmp(extension, "GL_EXT_buffer_storage") == 0) {
-                g_gles_caps.GL_EXT_buffer_storage = 1;
-            } else if (strcmp(extension, "GL_EXT_disjoint_timer_query") == 0) {
-                g_gles_caps.GL_EXT_disjoint_timer_query = 1;
-            } else if (strcmp(extension, "GL_QCOM_texture_lod_bias") == 0) {
-                g_gles_caps.GL_QCOM_texture_lod_bias = 1;
-            } else if (strcmp(extension, "GL_EXT_blend_func_extended") == 0) {
-                g_gles_caps.GL_EXT_blend_func_extended = 1;
-            } else if (strcmp(extension, "GL_EXT_texture_format_BGRA8888") == 0) {
-                g_gles_caps.GL_EXT_texture_format_BGRA8888 = 1;
-            } else if (strcmp(extension, "GL_EXT_read_format_bgra") == 0) {
-                g_gles_caps.GL_EXT_read_format_bgra = 1;
-            } else if (strcmp(extension, "GL_OES_mapbuffer") == 0) {
-                g_gles_caps.GL_OES_mapbuffer = 1;
-            } else if (strcmp(extension, "GL_EXT_multi_draw_indirect") == 0) {
-                g_gles_caps.GL_EXT_multi_draw_indirect = 1;
-            } else if (strcmp(extension, "GL_OES_draw_elements_base_vertex") == 0) {
-                g_gles_caps.GL_OES_draw_elements_base_vertex = 1;
-            } else if (strcmp(extension, "GL_OES_depth_texture") == 0) {
-                g_gles_caps.GL_OES_depth_texture = 1;
-            } else if (strcmp(extension, "GL_OES_depth24") == 0) {
-                g_gles_caps.GL_OES_depth24 = 1;
-            } else if (strcmp(extension, "GL_OES_depth_texture_float") == 0) {
-                g_gles_caps.GL_OES_depth_texture_float = 1;
-            } else if (strcmp(extension, "GL_EXT_texture_norm16") == 0) {
-                g_gles_caps.GL_EXT_texture_norm16 = 1;
-            } else if (strcmp(extension, "GL_EXT_texture_rg") == 0) {
-                g_gles_caps.GL_EXT_texture_rg = 1;
-            } else if (strcmp(extension, "GL_EXT_texture_query_lod") == 0) {
-                g_gles_caps.GL_EXT_texture_query_lod = 1;
-            } else if (strcmp(extension, "GL_EXT_draw_elements_base_vertex") == 0) {
-                g_gles_caps.GL_EXT_draw_elements_base_vertex = 1;
-            }
+            auto it = backend_extensions.find(std::string_view(extension));
+            if (it != backend_extensions.end()) g_gles_caps.*(it->second) = 1;
         } else {
             LOG_D("(nullptr)")
         }
@@ -460,8 +478,8 @@ void init_target_gles() {
     INIT_GLES_FUNC(glIsTransformFeedback)
     INIT_GLES_FUNC(glPauseTransformFeedback)
     INIT_GLES_FUNC(glResumeTransformFeedback)
-    INIT_GLES_FUNC(glGetProgramBinary)
-    INIT_GLES_FUNC(glProgramBinary)
+    INIT_GLES_FUNC_EAGER(glGetProgramBinary)
+    INIT_GLES_FUNC_EAGER(glProgramBinary)
     INIT_GLES_FUNC(glProgramParameteri)
     INIT_GLES_FUNC(glInvalidateFramebuffer)
     INIT_GLES_FUNC(glInvalidateSubFramebuffer)
@@ -581,15 +599,16 @@ void init_target_gles() {
     INIT_GLES_FUNC(glTexBufferRange)
     INIT_GLES_FUNC(glTexStorage3DMultisample)
     INIT_GLES_FUNC(glMapBufferRange)
-    INIT_GLES_FUNC(glBufferStorageEXT)
-    INIT_GLES_FUNC(glGetQueryObjectivEXT)
-    INIT_GLES_FUNC(glGetQueryObjecti64vEXT)
+    INIT_GLES_FUNC_EAGER(glBufferStorageEXT)
+    INIT_GLES_FUNC_EAGER(glGetQueryObjectivEXT)
+    INIT_GLES_FUNC_EAGER(glGetQueryObjecti64vEXT)
+    INIT_GLES_FUNC_EAGER(glQueryCounterEXT)
     INIT_GLES_FUNC(glBindFragDataLocationEXT)
     INIT_GLES_FUNC(glMapBufferOES)
 
-    INIT_GLES_FUNC(glMultiDrawArraysIndirectEXT)
-    INIT_GLES_FUNC(glMultiDrawElementsIndirectEXT)
-    INIT_GLES_FUNC(glMultiDrawElementsBaseVertexEXT)
+    INIT_GLES_FUNC_EAGER(glMultiDrawArraysIndirectEXT)
+    INIT_GLES_FUNC_EAGER(glMultiDrawElementsIndirectEXT)
+    INIT_GLES_FUNC_EAGER(glMultiDrawElementsBaseVertexEXT)
     //    INIT_GLES_FUNC(glBruh)
 
     LOG_D("glMultiDrawArraysIndirectEXT() @ 0x%x", GLES.glMultiDrawArraysIndirectEXT)
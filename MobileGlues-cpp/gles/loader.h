@@ -27,20 +27,41 @@ extern "C"
 
     void load_libs();
 
+    // Resolves a GLES entry point from the backend library
+    void* gles_resolve(const char* name);
+
 #if GLOBAL_DEBUG
-#define INIT_GLES_FUNC(name)                                                                                           \
+#define INIT_GLES_FUNC_EAGER(name)                                                                                     \
     {                                                                                                                  \
         LOG_D("INIT_GLES_FUNC(%s)", #name);                                                                            \
         GLES.name = (name##_PTR)proc_address(gles, #name);                                                             \
         if (GLES.name == NULL) LOG_W("Error: GLES function " #name " is NULL\n");                                      \
     }
 #else
-#define INIT_GLES_FUNC(name)                                                                                           \
+#define INIT_GLES_FUNC_EAGER(name)                                                                                     \
     { GLES.name = (name##_PTR)proc_address(gles, #name); }
 #endif
 
+// Installs a trampoline that looks the function up on its first call, then
+// replaces itself so later calls go straight to the driver. Most of the
+// table is never called by a given game, so startup skips those lookups.
+// Functions whose pointer is tested for presence must use
+// INIT_GLES_FUNC_EAGER instead, as the trampoline is never NULL.
+#define INIT_GLES_FUNC(name)                                                                                           \
+    {                                                                                                                  \
+        GLES.name = [](auto... args) {                                                                                 \
+            GLES.name = (name##_PTR)gles_resolve(#name);                                                               \
+            return GLES.name(args...);                                                                                 \
+        };                                                                                                             \
+    }
+
     void* open_lib(const char** names, const char* override);
 
+    // Backend library named by an MG_GLES_LIBRARY / MG_EGL_LIBRARY style
+    // variable. Only test and GLOBAL_DEBUG builds honor these, so a release
+    // build never loads a library from the environment. nullptr otherwise.
+    const char* backend_library_override(const char* var);
+
 #define LOAD_EGL(name)                                                                                                 \
     static name##_PTR egl_##name = NULL;                                                                               \
     {                                                                                                                  \
@@ -94,13 +115,17 @@ extern "C"
 #ifndef __APPLE__
 #define NATIVE_FUNCTION_HEAD(type, name, ...)                                                                          \
     extern "C" GLAPI GLAPIENTRY type name##ARB(__VA_ARGS__) __attribute__((alias(#name)));                             \
-    extern "C" GLAPI GLAPIENTRY type name(__VA_ARGS__) {
+    extern "C" GLAPI GLAPIENTRY type name(__VA_ARGS__) {                                                               \
+        MG_TRACE_CALL()
 #else
-#define NATIVE_FUNCTION_HEAD(type, name, ...) extern "C" GLAPI GLAPIENTRY type name(__VA_ARGS__) {
+#define NATIVE_FUNCTION_HEAD(type, name, ...)                                                                          \
+    extern "C" GLAPI GLAPIENTRY type name(__VA_ARGS__) {                                                               \
+        MG_TRACE_CALL()
 #endif
 
 #if GLOBAL_DEBUG
 #define NATIVE_FUNCTION_END(type, name, ...)                                                                           \
+    MG_TRACE_ARGS(name, __VA_ARGS__)                                                                                   \
     LOG_D("Use native function: %s @ %s(...)", RENDERERNAME, __FUNCTION__);                                            \
     type ret = GLES.name(__VA_ARGS__);                                                                                 \
     GLenum ERR = GLES.glGetError();                                                                                    \
@@ -109,6 +134,7 @@ extern "C"
     }
 #else
 #define NATIVE_FUNCTION_END(type, name, ...)                                                                           \
+    MG_TRACE_ARGS(name, __VA_ARGS__)                                                                                   \
     LOG_D("Use native function: %s @ %s(...)", RENDERERNAME, __FUNCTION__);                                            \
     type ret = GLES.name(__VA_ARGS__);                                                                                 \
     CHECK_GL_ERROR                                                                                                     \
@@ -118,12 +144,14 @@ extern "C"
 
 #if GLOBAL_DEBUG
 #define NATIVE_FUNCTION_END_NO_RETURN(type, name, ...)                                                                 \
+    MG_TRACE_ARGS(name, __VA_ARGS__)                                                                                   \
     LOG_D("Use native function: %s @ %s(...)", RENDERERNAME, __FUNCTION__);                                            \
     GLES.name(__VA_ARGS__);                                                                                            \
     CHECK_GL_ERROR                                                                                                     \
     }
 #else
 #define NATIVE_FUNCTION_END_NO_RETURN(type, name, ...)                                                                 \
+    MG_TRACE_ARGS(name, __VA_ARGS__)                                                                                   \
     LOG_D("Use native function: %s @ %s(...)", RENDERERNAME, __FUNCTION__);                                            \
     GLES.name(__VA_ARGS__);                                                                                            \
     }
@@ -164,6 +192,9 @@ extern "C"
     };
 
     extern struct gles_caps_t g_gles_caps;
+    // Reads the backend's extensions into g_gles_caps and rebuilds the list
+    // exposed to the application
+    void InitGLESCapabilities();
 
 #ifdef __cplusplus
 }
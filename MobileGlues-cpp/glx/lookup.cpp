@@ -13,12 +13,55 @@
 #include "../gl/mg.h"
 #include "../includes.h"
 #include <EGL/egl.h>
+#include <ankerl/unordered_dense.h>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <dlfcn.h>
+#include <string_view>
 
 #define DEBUG 0
 
+namespace {
+    struct proc_entry {
+        std::string name;
+        void* proc;
+    };
+
+    // Every name resolved so far, including the ones that do not exist:
+    // callers probe for extension entry points and repeat the probe on every
+    // context they create. Lock-free like the set of logged functions: slots
+    // are only ever filled, entries are never freed, and the table is several
+    // times larger than the GL and GLES entry points together.
+    constexpr size_t PROC_CACHE_CAPACITY = 16384;
+    std::atomic<const proc_entry*> g_proc_cache[PROC_CACHE_CAPACITY];
+
+    // Our own library. The entry points callers ask for are ours, so looking
+    // there first skips walking every object loaded into the process.
+    void* self_handle() {
+        static void* handle = [] {
+            Dl_info info;
+            void* lib = nullptr;
+            if (dladdr((void*)&glXGetProcAddress, &info) && info.dli_fname)
+                lib = dlopen(info.dli_fname, RTLD_NOW | RTLD_NOLOAD);
+            if (!lib) LOG_W("glXGetProcAddress: cannot locate own library, searching globally")
+            return lib;
+        }();
+        return handle;
+    }
+
+    void* resolve_proc(const char* name) {
+#ifdef __APPLE__
+        return dlsym((void*)(~(uintptr_t)0), name);
+#else
+        void* proc = nullptr;
+        if (void* self = self_handle()) proc = dlsym(self, name);
+        if (!proc) proc = dlsym(RTLD_DEFAULT, name);
+        return proc;
+#endif
+    }
+} // namespace
+
 std::string handle_multidraw_func_name(std::string name) {
     std::string namestr = name;
     if (namestr != "glMultiDrawElementsBaseVertex" && namestr != "glMultiDrawElements") {
@@ -51,26 +94,42 @@ std::string handle_multidraw_func_name(std::string name) {
     return namestr;
 }
 
-void* glXGetProcAddress(const char* name) {
-    LOG()
+static void* resolve_gl_proc(std::string_view name) {
+    // The multidraw mode is fixed once settings are loaded, so the emulation
+    // picked for these names can be cached like any other
     std::string real_func_name = handle_multidraw_func_name(std::string(name));
-#ifdef __APPLE__
-    return dlsym((void*)(~(uintptr_t)0), real_func_name.c_str());
-#else
-
-    void* proc = nullptr;
+    void* proc = resolve_proc(real_func_name.c_str());
+    if (!proc) LOG_W("Failed to get OpenGL function: %s", real_func_name.c_str())
+    return proc;
+}
 
-    proc = dlsym(RTLD_DEFAULT, real_func_name.c_str());
+void* glXGetProcAddress(const char* name) {
+    LOG()
+    if (!name) return nullptr;
+    std::string_view key(name);
 
-    if (!proc) {
-        LOG_W("Failed to get OpenGL function: %s", real_func_name.c_str())
-        return nullptr;
+    const uint64_t hash = ankerl::unordered_dense::hash<std::string_view>{}(key);
+    proc_entry* resolved = nullptr;
+    for (size_t probe = 0; probe < PROC_CACHE_CAPACITY; ++probe) {
+        auto& slot = g_proc_cache[(hash + probe) & (PROC_CACHE_CAPACITY - 1)];
+        const proc_entry* entry = slot.load(std::memory_order_acquire);
+        if (!entry) {
+            if (!resolved) resolved = new proc_entry{std::string(key), resolve_gl_proc(key)};
+            if (slot.compare_exchange_strong(entry, resolved, std::memory_order_acq_rel)) return resolved->proc;
+            // Another thread filled the slot first, entry is now its name
+        }
+        if (entry->name == key) {
+            delete resolved;
+            return entry->proc;
+        }
     }
 
+    // Only with the table full, which no GL API is large enough for
+    void* proc = resolved ? resolved->proc : resolve_gl_proc(key);
+    delete resolved;
     return proc;
-#endif
 }
 
 void* glXGetProcAddressARB(const char* name) {
     return glXGetProcAddress(name);
-}
\ No newline at end of file
+}
@@ -8,6 +8,7 @@
 #include "config/settings.h"
 #include "egl/egl.h"
 #include "egl/loader.h"
+#include "gl/call_trace.h"
 #include "gl/envvars.h"
 #include "gl/gl.h"
 #include "gl/log.h"
@@ -58,6 +59,7 @@ void proc_init() {
     show_license();
 
     init_settings();
+    init_call_trace();
 
     load_libs();
     init_target_egl();
@@ -0,0 +1,29 @@
+#version 330 core
+
+// Post-processing pass in the style of shader packs
+#define BLOOM_STRENGTH 0.35
+/* const int colortex0Format = RGBA16F; */
+
+uniform sampler2D colortex0;
+uniform sampler2D colortex1;
+uniform float viewWidth;
+uniform float viewHeight;
+
+in vec2 texcoord;
+
+layout(location = 0) out vec4 outColor0;
+
+vec3 tonemap(vec3 color) {
+    return color / (color + vec3(1.0));
+}
+
+void main() {
+    vec2 texel = vec2(1.0 / viewWidth, 1.0 / viewHeight);
+    vec3 color = texture(colortex0, texcoord).rgb;
+    vec3 bloom = vec3(0.0);
+    for (int i = -2; i <= 2; ++i) {
+        bloom += texture(colortex1, texcoord + vec2(float(i), 0.0) * texel).rgb;
+    }
+    color += bloom * (BLOOM_STRENGTH / 5.0);
+    outColor0 = vec4(tonemap(color), 1.0);
+}
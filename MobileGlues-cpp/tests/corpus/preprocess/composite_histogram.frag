@@ -0,0 +1,39 @@
+#version 430 compatibility
+#line 1 0
+#define HISTOGRAM_BINS 4
+#line 1 1
+
+layout(binding = 0, offset = 0) uniform atomic_uint lumaDark;
+layout(binding = 1, offset = 0) uniform atomic_uint lumaMid;
+layout(binding = 2, offset = 0) uniform atomic_uint lumaBright;
+layout(binding = 3) uniform atomic_uint lumaTotal;
+
+uniform sampler2D colortex0;
+uniform float exposureBias;
+
+in vec2 texcoord;
+
+/* RENDERTARGETS: 0 */
+layout(location = 0) out vec4 colorOut;
+#line 1 2
+
+float luminance(vec3 color) {
+    return dot(color, vec3(0.2125, 0.7154, 0.0721));
+}
+#line 18 1
+
+void main() {
+    vec3 color = texture(colortex0, texcoord).rgb;
+    float luma = log2(max(luminance(color), 1e-5)) + exposureBias;
+
+    if (luma < -4.0) {
+        atomicCounterIncrement(lumaDark);
+    } else if (luma < 2.0) {
+        atomicCounterIncrement(lumaMid);
+    } else {
+        atomicCounterIncrement(lumaBright);
+    }
+    uint seen = atomicCounterIncrement(lumaTotal);
+
+    colorOut = vec4(color, float(seen % 256u) / 255.0);
+}
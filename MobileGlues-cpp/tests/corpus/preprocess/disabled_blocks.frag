@@ -0,0 +1,23 @@
+#version 330 core
+#define HAS_SHADOWS
+#if 0
+layout(binding = 0) uniform atomic_uint disabledCounter;
+vec2 lod = textureQueryLod(tex, uv);
+#endif
+#ifdef GL_ARB_derivative_control
+float d = dFdxFine(1.0);
+#else
+float d = dFdx(1.0);
+#endif
+#ifdef IRIS_FEATURE_SSBO
+vec4 maybe = GI_TemporalFilter();
+#endif
+#ifndef HAS_SHADOWS
+vec2 skipped = textureQueryLod(tex, uv).xy;
+#elif defined(HAS_SHADOWS)
+vec2 kept = textureQueryLod(tex, uv).xy;
+#endif
+uniform sampler2D tex;
+in vec2 uv;
+out vec4 color;
+void main() { color = vec4(d, kept, 1.0); }
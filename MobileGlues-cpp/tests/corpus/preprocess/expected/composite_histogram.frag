@@ -0,0 +1,56 @@
+#version 430 compatibility
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+#define HISTOGRAM_BINS 4
+
+layout(std430, binding=0) buffer AtomicCounterSSBO_0 {
+    uint lumaDark;
+};
+
+layout(std430, binding=1) buffer AtomicCounterSSBO_1 {
+    uint lumaMid;
+};
+
+layout(std430, binding=2) buffer AtomicCounterSSBO_2 {
+    uint lumaBright;
+};
+
+layout(std430, binding=3) buffer AtomicCounterSSBO_3 {
+    uint lumaTotal;
+};
+
+
+uniform sampler2D colortex0;
+uniform float exposureBias;
+
+in vec2 texcoord;
+
+/* RENDERTARGETS: 0 */
+layout(location = 0) out vec4 colorOut;
+
+float luminance(vec3 color) {
+    return dot(color, vec3(0.2125, 0.7154, 0.0721));
+}
+
+void main() {
+    vec3 color = texture(colortex0, texcoord).rgb;
+    float luma = log2(max(luminance(color), 1e-5)) + exposureBias;
+
+    if (luma < -4.0) {
+        atomicAdd(lumaDark, 1u);
+    memoryBarrierBuffer();
+    } else if (luma < 2.0) {
+        atomicAdd(lumaMid, 1u);
+    memoryBarrierBuffer();
+    } else {
+        atomicAdd(lumaBright, 1u);
+    memoryBarrierBuffer();
+    }
+    uint seen = atomicAdd(lumaTotal, 1u);
+    memoryBarrierBuffer();
+
+    colorOut = vec4(color, float(seen % 256u) / 255.0);
+}
+
+// Non-opaque atomic uniform converted to SSBO
\ No newline at end of file
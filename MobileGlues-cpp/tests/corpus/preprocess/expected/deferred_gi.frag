@@ -0,0 +1,103 @@
+#version 330 compatibility
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+#define GI_ENABLED
+#define GI_SAMPLES 8 // [4 8 16]
+#define GI_RADIUS 2.0
+
+uniform sampler2D colortex0;
+uniform sampler2D colortex1;
+uniform sampler2D colortex2;
+uniform sampler2D depthtex0;
+uniform sampler2D noisetex;
+uniform mat4 gbufferProjection;
+uniform mat4 gbufferProjectionInverse;
+uniform mat4 gbufferModelView;
+uniform mat4 gbufferModelViewInverse;
+uniform mat4 gbufferPreviousProjection;
+uniform mat4 gbufferPreviousModelView;
+uniform vec3 sunPosition;
+uniform vec2 screenSize;
+uniform vec2 pixelSize;
+uniform vec2 taaJitter;
+uniform float frameTimeCounter;
+uniform int frameCounter;
+
+vec4 GI_TemporalFilter() {
+    vec2 uv = gl_FragCoord.xy / screenSize;
+    uv += taaJitter * pixelSize;
+    vec4 currentGI = texture(colortex0, uv);
+    float depth = texture(depthtex0, uv).r;
+    vec4 clipPos = vec4(uv * 2.0 - 1.0, depth, 1.0);
+    vec4 viewPos = gbufferProjectionInverse * clipPos;
+    viewPos /= viewPos.w;
+    vec4 worldPos = gbufferModelViewInverse * viewPos;
+    vec4 prevClipPos = gbufferPreviousProjection * (gbufferPreviousModelView * worldPos);
+    prevClipPos /= prevClipPos.w;
+    vec2 prevUV = prevClipPos.xy * 0.5 + 0.5;
+    vec4 historyGI = texture(colortex1, prevUV);
+    float difference = length(currentGI.rgb - historyGI.rgb);
+    float thresholdValue = 0.1;
+    float adaptiveBlend = mix(0.9, 0.0, smoothstep(thresholdValue, thresholdValue * 2.0, difference));
+    vec4 filteredGI = mix(currentGI, historyGI, adaptiveBlend);
+    if (difference > thresholdValue * 2.0) {
+        filteredGI = currentGI;
+    }
+    return filteredGI;
+}
+
+
+uniform float aoWeights[GI_SAMPLES];
+
+in vec2 texcoord;
+
+/* RENDERTARGETS: 1 */
+layout(location = 0) out vec4 giOut;
+
+vec3 viewPosition(vec2 uv, float depth) {
+    vec4 clip = vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    vec4 view = gbufferProjectionInverse * clip;
+    return view.xyz / view.w;
+}
+
+vec3 sampleHemisphere(vec3 normal, vec2 seed) {
+    float phi = 6.2831853 * seed.x;
+    float cosTheta = sqrt(1.0 - seed.y);
+    float sinTheta = sqrt(seed.y);
+    vec3 tangent = normalize(cross(normal, abs(normal.y) < 0.99 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0)));
+    vec3 bitangent = cross(normal, tangent);
+    mat3 rot = mat3(tangent, bitangent, normal);
+    const mat3 rotInverse = mat3(rot[0][0], rot[1][0], rot[2][0], rot[0][1], rot[1][1], rot[2][1], rot[0][2], rot[1][2], rot[2][2]);
+    return rot * vec3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta) + rotInverse[2] * 0.0;
+}
+
+void main() {
+    float depth = texture(depthtex0, texcoord).r;
+    if (depth >= 1.0) {
+        giOut = vec4(0.0);
+        return;
+    }
+    vec3 normal = texture(colortex2, texcoord).xyz * 2.0 - 1.0;
+    vec3 position = viewPosition(texcoord, depth);
+    vec2 noise = texture(noisetex, gl_FragCoord.xy / 64.0 + float(frameCounter % 64) * 0.618).rg;
+
+    vec3 gi = vec3(0.0);
+#ifdef GI_ENABLED
+    for (int i = 0; i < GI_SAMPLES; ++i) {
+        vec2 seed = fract(noise + vec2(float(i) * 0.7548, float(i) * 0.5698));
+        vec3 dir = sampleHemisphere(normal, seed);
+        vec3 probe = position + dir * GI_RADIUS * (float(i) + 1.0) / float(GI_SAMPLES);
+        vec4 clip = gbufferProjection * vec4(probe, 1.0);
+        vec2 uv = clip.xy / clip.w * 0.5 + 0.5;
+        if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0)))) continue;
+        float sampledDepth = texture(depthtex0, uv).r;
+        float weight = sampledDepth < depth ? aoWeights[i] : 0.0;
+        gi += texture(colortex0, uv).rgb * weight;
+    }
+    gi /= float(GI_SAMPLES);
+#endif
+
+    vec4 history = GI_TemporalFilter();
+    giOut = vec4(mix(gi, history.rgb, 0.9), 1.0);
+}
@@ -0,0 +1,64 @@
+#version 330 core
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+
+
+#define textureQueryLod mg_textureQueryLod
+
+vec2 mg_textureQueryLod(sampler2D tex, vec2 uv) {
+    vec2 texSizeF = vec2(textureSize(tex, 0));
+    vec2 dFdx_uv = dFdx(uv * texSizeF);
+    vec2 dFdy_uv = dFdy(uv * texSizeF);
+    float maxDerivative = max(length(dFdx_uv), length(dFdy_uv));
+    float lod = log2(maxDerivative);
+    return vec2(lod);
+}
+
+#define HAS_SHADOWS
+#if 0
+layout(binding = 0) uniform atomic_uint disabledCounter;
+vec2 lod = textureQueryLod(tex, uv);
+#endif
+#if 0
+float d = dFdxFine(1.0);
+#else
+float d = dFdx(1.0);
+#endif
+#ifdef IRIS_FEATURE_SSBO
+vec4 maybe = GI_TemporalFilter();
+#endif
+#ifndef HAS_SHADOWS
+vec2 skipped = textureQueryLod(tex, uv).xy;
+#elif defined(HAS_SHADOWS)
+vec2 kept = textureQueryLod(tex, uv).xy;
+#endif
+uniform sampler2D tex;
+
+vec4 GI_TemporalFilter() {
+    vec2 uv = gl_FragCoord.xy / screenSize;
+    uv += taaJitter * pixelSize;
+    vec4 currentGI = texture(colortex0, uv);
+    float depth = texture(depthtex0, uv).r;
+    vec4 clipPos = vec4(uv * 2.0 - 1.0, depth, 1.0);
+    vec4 viewPos = gbufferProjectionInverse * clipPos;
+    viewPos /= viewPos.w;
+    vec4 worldPos = gbufferModelViewInverse * viewPos;
+    vec4 prevClipPos = gbufferPreviousProjection * (gbufferPreviousModelView * worldPos);
+    prevClipPos /= prevClipPos.w;
+    vec2 prevUV = prevClipPos.xy * 0.5 + 0.5;
+    vec4 historyGI = texture(colortex1, prevUV);
+    float difference = length(currentGI.rgb - historyGI.rgb);
+    float thresholdValue = 0.1;
+    float adaptiveBlend = mix(0.9, 0.0, smoothstep(thresholdValue, thresholdValue * 2.0, difference));
+    vec4 filteredGI = mix(currentGI, historyGI, adaptiveBlend);
+    if (difference > thresholdValue * 2.0) {
+        filteredGI = currentGI;
+    }
+    return filteredGI;
+}
+
+
+in vec2 uv;
+out vec4 color;
+void main() { color = vec4(d, kept, 1.0); }
@@ -0,0 +1,97 @@
+#version 330 compatibility
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+#extension GL_ARB_shader_texture_lod : enable
+#extension GL_ARB_texture_query_lod : enable
+
+
+#define textureQueryLod mg_textureQueryLod
+
+vec2 mg_textureQueryLod(sampler2D tex, vec2 uv) {
+    vec2 texSizeF = vec2(textureSize(tex, 0));
+    vec2 dFdx_uv = dFdx(uv * texSizeF);
+    vec2 dFdy_uv = dFdy(uv * texSizeF);
+    float maxDerivative = max(length(dFdx_uv), length(dFdy_uv));
+    float lod = log2(maxDerivative);
+    return vec2(lod);
+}
+
+#define NORMAL_MAPPING
+#define PARALLAX_DEPTH 0.25 // [0.1 0.25 0.5]
+#define PARALLAX_SAMPLES 32
+
+uniform sampler2D gtexture;
+uniform sampler2D lightmap;
+uniform sampler2D normals;
+uniform sampler2D specular;
+uniform ivec2 atlasSize;
+uniform float alphaTestRef;
+uniform vec3 shadowLightPosition;
+uniform int heldBlockLightValue;
+
+in vec2 texcoord;
+in vec2 lmcoord;
+in vec4 glcolor;
+in vec3 worldPos;
+in float blockId;
+#ifdef NORMAL_MAPPING
+in mat3 tbnMatrix;
+in vec4 vTexCoordAM;
+#endif
+
+/* RENDERTARGETS: 0,1,2 */
+layout(location = 0) out vec4 albedoOut;
+layout(location = 1) out vec4 normalOut;
+layout(location = 2) out vec4 materialOut;
+
+float mipLevel(vec2 coord) {
+    // Chosen by the hardware where possible, parallax needs it for textureLod
+#if 0
+    vec2 dx = dFdxFine(coord * vec2(atlasSize));
+    vec2 dy = dFdyFine(coord * vec2(atlasSize));
+    return max(0.0, 0.5 * log2(max(dot(dx, dx), dot(dy, dy))));
+#else
+    return textureQueryLod(gtexture, coord).x;
+#endif
+}
+
+#ifdef NORMAL_MAPPING
+vec2 parallaxCoord(vec2 coord, vec3 viewTangent, float lod) {
+    vec2 step = viewTangent.xy * PARALLAX_DEPTH / (-viewTangent.z * float(PARALLAX_SAMPLES));
+    float height = 1.0;
+    for (int i = 0; i < PARALLAX_SAMPLES; ++i) {
+        float sampled = textureLod(normals, fract(coord) * vTexCoordAM.pq + vTexCoordAM.st, lod).a;
+        if (sampled >= height) break;
+        coord += step;
+        height -= 1.0 / float(PARALLAX_SAMPLES);
+    }
+    return fract(coord) * vTexCoordAM.pq + vTexCoordAM.st;
+}
+#endif
+
+void main() {
+    vec2 coord = texcoord;
+    float lod = mipLevel(coord);
+#ifdef NORMAL_MAPPING
+    vec3 viewTangent = normalize(tbnMatrix * -worldPos);
+    if (lod < 4.0) coord = parallaxCoord((texcoord - vTexCoordAM.st) / vTexCoordAM.pq, viewTangent, lod);
+#endif
+
+    vec4 albedo = textureLod(gtexture, coord, lod) * glcolor;
+    if (albedo.a < alphaTestRef) discard;
+    albedo.rgb *= texture(lightmap, lmcoord).rgb;
+
+    vec3 normal = vec3(0.0, 0.0, 1.0);
+#ifdef NORMAL_MAPPING
+    normal.xy = textureLod(normals, coord, lod).xy * 2.0 - 1.0;
+    normal.z = sqrt(max(0.0, 1.0 - dot(normal.xy, normal.xy)));
+    normal = normalize(normal * tbnMatrix);
+#endif
+
+    vec4 spec = textureLod(specular, coord, lod);
+    float emissive = spec.a < 1.0 ? spec.a : 0.0;
+    albedoOut = albedo;
+    normalOut = vec4(normal * 0.5 + 0.5, 1.0);
+    materialOut = vec4(spec.rg, emissive, float(heldBlockLightValue) / 15.0);
+}
@@ -0,0 +1,67 @@
+#version 330 compatibility
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+#define WAVING_PLANTS
+#define WAVING_LEAVES
+#define NORMAL_MAPPING
+
+uniform mat4 gbufferModelView;
+uniform mat4 gbufferModelViewInverse;
+uniform mat4 gbufferProjection;
+uniform vec3 cameraPosition;
+uniform float frameTimeCounter;
+uniform float rainStrength;
+uniform ivec2 atlasSize;
+
+in vec4 mc_Entity;
+in vec4 mc_midTexCoord;
+in vec4 at_tangent;
+
+out vec2 texcoord;
+out vec2 lmcoord;
+out vec4 glcolor;
+out vec3 worldPos;
+out float blockId;
+#ifdef NORMAL_MAPPING
+out mat3 tbnMatrix;
+out vec4 vTexCoordAM;
+#endif
+
+vec3 wavingOffset(vec3 pos, float strength) {
+    float t = frameTimeCounter * (1.0 + rainStrength);
+    float wave = sin(t * 1.7 + pos.x * 0.9 + pos.z * 1.3) * 0.04 + sin(t * 3.1 + pos.z) * 0.02;
+    return vec3(wave, 0.0, wave * 0.7) * strength;
+}
+
+void main() {
+    texcoord = (gl_TextureMatrix[0] * gl_MultiTexCoord0).xy;
+    lmcoord = (gl_TextureMatrix[1] * gl_MultiTexCoord1).xy;
+    glcolor = gl_Color;
+    blockId = mc_Entity.x;
+
+    vec4 position = gbufferModelViewInverse * (gl_ModelViewMatrix * gl_Vertex);
+    worldPos = position.xyz + cameraPosition;
+    bool topVertex = texcoord.t < mc_midTexCoord.t;
+#ifdef WAVING_PLANTS
+    if ((blockId == 10001.0 || blockId == 10002.0) && topVertex) position.xyz += wavingOffset(worldPos, 1.0);
+#endif
+#ifdef WAVING_LEAVES
+    if (blockId == 10003.0) position.xyz += wavingOffset(worldPos, 0.5);
+#endif
+
+#ifdef NORMAL_MAPPING
+    vec3 normal = normalize(gl_NormalMatrix * gl_Normal);
+    vec3 tangent = normalize(gl_NormalMatrix * at_tangent.xyz);
+    vec3 binormal = cross(tangent, normal) * sign(at_tangent.w);
+    tbnMatrix = mat3(tangent.x, binormal.x, normal.x,
+                     tangent.y, binormal.y, normal.y,
+                     tangent.z, binormal.z, normal.z);
+    vec2 midCoord = mc_midTexCoord.st;
+    vec2 texMinMidCoord = texcoord - midCoord;
+    vTexCoordAM.pq = abs(texMinMidCoord) * 2.0;
+    vTexCoordAM.st = min(texcoord, midCoord - texMinMidCoord);
+#endif
+
+    gl_Position = gbufferProjection * gbufferModelView * position;
+}
@@ -0,0 +1,46 @@
+#version 330 core
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+uniform sampler2D colortex0;
+uniform sampler2D colortex1;
+uniform sampler2D depthtex0;
+layout(std140) uniform mat4 gbufferProjectionInverse;
+uniform mat4 gbufferModelViewInverse;
+uniform highp mat4 gbufferPreviousProjection;
+uniform mat4 gbufferPreviousModelView;
+uniform vec2 screenSize; // uniform vec2 inComment;
+uniform vec2 taaJitter;
+uniform vec2 pixelSize;
+uniform float weights[4];
+
+vec4 GI_TemporalFilter() {
+    vec2 uv = gl_FragCoord.xy / screenSize;
+    uv += taaJitter * pixelSize;
+    vec4 currentGI = texture(colortex0, uv);
+    float depth = texture(depthtex0, uv).r;
+    vec4 clipPos = vec4(uv * 2.0 - 1.0, depth, 1.0);
+    vec4 viewPos = gbufferProjectionInverse * clipPos;
+    viewPos /= viewPos.w;
+    vec4 worldPos = gbufferModelViewInverse * viewPos;
+    vec4 prevClipPos = gbufferPreviousProjection * (gbufferPreviousModelView * worldPos);
+    prevClipPos /= prevClipPos.w;
+    vec2 prevUV = prevClipPos.xy * 0.5 + 0.5;
+    vec4 historyGI = texture(colortex1, prevUV);
+    float difference = length(currentGI.rgb - historyGI.rgb);
+    float thresholdValue = 0.1;
+    float adaptiveBlend = mix(0.9, 0.0, smoothstep(thresholdValue, thresholdValue * 2.0, difference));
+    vec4 filteredGI = mix(currentGI, historyGI, adaptiveBlend);
+    if (difference > thresholdValue * 2.0) {
+        filteredGI = currentGI;
+    }
+    return filteredGI;
+}
+
+
+in vec2 uv;
+out vec4 color;
+
+void main() {
+    color = GI_TemporalFilter() * weights[0];
+}
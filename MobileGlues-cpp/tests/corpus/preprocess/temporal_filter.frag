@@ -0,0 +1,18 @@
+#version 330 core
+uniform sampler2D colortex0;
+uniform sampler2D colortex1;
+uniform sampler2D depthtex0;
+layout(std140) uniform mat4 gbufferProjectionInverse;
+uniform mat4 gbufferModelViewInverse;
+uniform highp mat4 gbufferPreviousProjection;
+uniform mat4 gbufferPreviousModelView;
+uniform vec2 screenSize; // uniform vec2 inComment;
+uniform vec2 taaJitter;
+uniform vec2 pixelSize;
+uniform float weights[4];
+in vec2 uv;
+out vec4 color;
+
+void main() {
+    color = GI_TemporalFilter() * weights[0];
+}
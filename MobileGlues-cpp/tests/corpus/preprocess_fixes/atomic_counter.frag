@@ -0,0 +1,13 @@
+#version 430 core
+layout(binding = 0, offset = 0) uniform atomic_uint fragments;
+layout (binding=1) uniform atomic_uint overdraw ;
+uniform int scale;
+out vec4 color;
+
+void main() {
+    uint index = atomicCounterIncrement(fragments);
+    atomicCounterAdd(overdraw, uint((scale + 1) * 2));
+    // atomicCounterDecrement(fragments);
+    if (atomicCounter(overdraw) > 4u) atomicCounterDecrement(overdraw);
+    color = vec4(float(index));
+}
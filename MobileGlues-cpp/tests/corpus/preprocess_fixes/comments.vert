@@ -0,0 +1,12 @@
+#version 330 core
+#line 1 "shaders/gbuffers_terrain.vsh"
+// uniform atomic_uint notACounter; textureQueryLod GI_TemporalFilter
+/* layout(binding = 0) uniform atomic_uint alsoNot;
+   atomicCounterIncrement(alsoNot); */
+in vec3 position;
+out vec2 texcoord; // out vec4 outColor0;
+
+void main() {
+    texcoord = position.xy; /* "quoted" */
+    gl_Position = vec4(position, 1.0);
+}
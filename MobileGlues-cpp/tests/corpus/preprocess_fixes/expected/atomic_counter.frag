@@ -0,0 +1,27 @@
+#version 430 core
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+layout(std430, binding=0) buffer AtomicCounterSSBO_0 {
+    uint fragments;
+};
+
+layout(std430, binding=1) buffer AtomicCounterSSBO_1 {
+    uint overdraw;
+};
+
+uniform int scale;
+out vec4 color;
+
+void main() {
+    uint index = atomicAdd(fragments, 1u);
+    memoryBarrierBuffer();
+    atomicAdd(overdraw, uint((scale + 1) * 2));
+    memoryBarrierBuffer();
+    // atomicCounterDecrement(fragments);
+    if (overdraw > 4u) atomicAdd(overdraw, uint(-1));
+    memoryBarrierBuffer();
+    color = vec4(float(index));
+}
+
+// Non-opaque atomic uniform converted to SSBO
\ No newline at end of file
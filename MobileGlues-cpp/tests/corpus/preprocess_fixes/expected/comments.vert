@@ -0,0 +1,14 @@
+#version 330 core
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+// uniform atomic_uint notACounter; textureQueryLod GI_TemporalFilter
+/* layout(binding = 0) uniform atomic_uint alsoNot;
+   atomicCounterIncrement(alsoNot); */
+in vec3 position;
+out vec2 texcoord; // out vec4 outColor0;
+
+void main() {
+    texcoord = position.xy; /* "quoted" */
+    gl_Position = vec4(position, 1.0);
+}
@@ -0,0 +1,9 @@
+#version 150
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+out vec4 color;
+// #line 30 stays, it is a comment
+void main() {
+    color = vec4(1.0);
+}
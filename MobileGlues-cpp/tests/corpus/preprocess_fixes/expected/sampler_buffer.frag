@@ -0,0 +1,30 @@
+#version 330 core
+
+#define MG_MOBILEGLUES
+#define MG_MOBILEGLUES_VERSION <version>
+#extension GL_ARB_texture_buffer_object : enable
+
+uniform int u_BufferTexWidth;
+uniform int u_BufferTexHeight;
+
+ivec2 bufferCoords(int index) {
+    int width = u_BufferTexWidth;
+    int x = index % width;
+    int y = index / width;
+    if (y >= u_BufferTexHeight) {
+        y = u_BufferTexHeight - 1;
+        x = width - 1;
+    }
+    return ivec2(x, y);
+}
+uniform isampler2D voxelData;
+uniform sampler2D colortex0;
+in vec2 uv;
+out vec4 color;
+
+void main() {
+    int base = int(gl_FragCoord.x) * 4;
+    ivec4 voxel = texelFetch(voxelData, bufferCoords(base + int(uv.y * float(textureSize(colortex0, 0).y))), 0);
+    vec4 albedo = texelFetch(colortex0, ivec2(gl_FragCoord.xy), 0);
+    color = albedo * float(voxel.x);
+}
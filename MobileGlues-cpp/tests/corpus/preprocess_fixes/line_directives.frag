@@ -0,0 +1,9 @@
+#version 150
+#line 10
+  #  line 20 "composite.fsh"
+out vec4 color;
+// #line 30 stays, it is a comment
+void main() {
+#line 40
+    color = vec4(1.0);
+}
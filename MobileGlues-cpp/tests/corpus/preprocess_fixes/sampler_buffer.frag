@@ -0,0 +1,13 @@
+#version 330 core
+#extension GL_ARB_texture_buffer_object : enable
+uniform isamplerBuffer voxelData;
+uniform sampler2D colortex0;
+in vec2 uv;
+out vec4 color;
+
+void main() {
+    int base = int(gl_FragCoord.x) * 4;
+    ivec4 voxel = texelFetch(voxelData, base + int(uv.y * float(textureSize(colortex0, 0).y)));
+    vec4 albedo = texelFetch(colortex0, ivec2(gl_FragCoord.xy), 0);
+    color = albedo * float(voxel.x);
+}
@@ -0,0 +1,134 @@
+// MobileGlues - tests/framework/mg_test.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_MG_TEST_H
+#define MOBILEGLUES_MG_TEST_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Minimal self-registering test harness for mobileglues_tests.
+//
+//   TEST(suite, name) { EXPECT_EQ(a, b); ASSERT_TRUE(c); }
+//   BENCH(suite, name) { mg_test::measure("op", iterations, "ops", [&] { ... }); }
+//
+// Tests run by default, benchmarks only with --bench. A substring filter can
+// be passed as the first non-flag argument.
+
+namespace mg_test {
+    struct Case {
+        const char* suite;
+        const char* name;
+        bool bench;
+        void (*fn)();
+    };
+
+    inline std::vector<Case>& registry() {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    struct Registrar {
+        Registrar(const char* suite, const char* name, bool bench, void (*fn)()) {
+            registry().push_back({suite, name, bench, fn});
+        }
+    };
+
+    // Thrown by ASSERT_* to abort the current case
+    struct AssertionFailure {};
+
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    inline void fail(const char* file, int line, const std::string& message) {
+        fprintf(stderr, "%s:%d: failure: %s\n", file, line, message.c_str());
+        failures()++;
+    }
+
+    template <typename T> std::string describe(const T& value) {
+        if constexpr (std::is_pointer_v<T>) {
+            std::ostringstream s;
+            s << (const void*)value;
+            return s.str();
+        } else if constexpr (std::is_enum_v<T>) {
+            return std::to_string((long long)value);
+        } else if constexpr (requires(std::ostream& o) { o << value; }) {
+            std::ostringstream s;
+            s << value;
+            return s.str();
+        } else {
+            return "<value>";
+        }
+    }
+
+    template <typename A, typename B>
+    bool check_eq(const A& a, const B& b, const char* ea, const char* eb, const char* file, int line) {
+        if (a == b) return true;
+        fail(file, line, std::string(ea) + " == " + eb + " (" + describe(a) + " vs " + describe(b) + ")");
+        return false;
+    }
+
+    // Runs fn `iterations` times and prints the rate in `unit` per second,
+    // scaled by `units_per_iteration`. Returns seconds per iteration.
+    inline double measure(const char* label, size_t iterations, const char* unit, const std::function<void()>& fn,
+                          double units_per_iteration = 1.0) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            fn();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double rate = seconds > 0 ? iterations * units_per_iteration / seconds : 0.0;
+        printf("  %-48s %14.1f %s/s  (%.3f us/iter)\n", label, rate, unit, seconds * 1e6 / (double)iterations);
+        return seconds / (double)iterations;
+    }
+} // namespace mg_test
+
+#define MG_TEST_CASE(suite, name, bench)                                                                               \
+    static void mg_test_##suite##_##name();                                                                            \
+    static mg_test::Registrar mg_test_registrar_##suite##_##name(#suite, #name, bench, mg_test_##suite##_##name);      \
+    static void mg_test_##suite##_##name()
+
+#define TEST(suite, name) MG_TEST_CASE(suite, name, false)
+#define BENCH(suite, name) MG_TEST_CASE(suite, name, true)
+
+#define EXPECT_TRUE(cond)                                                                                              \
+    do {                                                                                                               \
+        if (!(cond)) mg_test::fail(__FILE__, __LINE__, "expected " #cond);                                             \
+    } while (0)
+#define EXPECT_FALSE(cond) EXPECT_TRUE(!(cond))
+#define EXPECT_EQ(a, b) mg_test::check_eq((a), (b), #a, #b, __FILE__, __LINE__)
+#define EXPECT_NE(a, b)                                                                                                \
+    do {                                                                                                               \
+        if ((a) == (b)) mg_test::fail(__FILE__, __LINE__, "expected " #a " != " #b);                                  \
+    } while (0)
+#define EXPECT_NEAR(a, b, eps)                                                                                         \
+    do {                                                                                                               \
+        double mg_a = (a), mg_b = (b);                                                                                 \
+        if (!(std::fabs(mg_a - mg_b) <= (eps)))                                                                        \
+            mg_test::fail(__FILE__, __LINE__,                                                                          \
+                          std::string(#a " ~= " #b " (") + std::to_string(mg_a) + " vs " + std::to_string(mg_b) +     \
+                              ")");                                                                                    \
+    } while (0)
+#define ASSERT_TRUE(cond)                                                                                              \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            mg_test::fail(__FILE__, __LINE__, "expected " #cond);                                                      \
+            throw mg_test::AssertionFailure{};                                                                         \
+        }                                                                                                              \
+    } while (0)
+#define ASSERT_EQ(a, b)                                                                                                \
+    do {                                                                                                               \
+        if (!mg_test::check_eq((a), (b), #a, #b, __FILE__, __LINE__)) throw mg_test::AssertionFailure{};               \
+    } while (0)
+
+#endif // MOBILEGLUES_MG_TEST_H
@@ -0,0 +1,297 @@
+// MobileGlues - tests/mock/mock_egl.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "mock_internal.h"
+#define EGL_EGL_PROTOTYPES 0
+#include <EGL/egl.h>
+
+// EGL side of the mock: one display, one config, and any number of contexts
+// and surfaces that all share the single GLES context in mock_gles.cpp.
+// Window and pbuffer surfaces report the mock's surface size.
+
+#define MOCK_DISPLAY ((EGLDisplay)0xD15)
+#define MOCK_CONFIG ((EGLConfig)0xC0F)
+
+namespace {
+    uintptr_t g_next_handle = 0x100;
+    EGLint g_egl_error = EGL_SUCCESS;
+    EGLenum g_api = EGL_OPENGL_ES_API;
+    EGLContext g_context = EGL_NO_CONTEXT;
+    EGLSurface g_draw = EGL_NO_SURFACE, g_read = EGL_NO_SURFACE;
+
+    void* new_handle() { return (void*)g_next_handle++; }
+} // namespace
+
+MOCK_API EGLint eglGetError() {
+    MOCK_RECORD(eglGetError);
+    EGLint error = g_egl_error;
+    g_egl_error = EGL_SUCCESS;
+    return error;
+}
+
+MOCK_API EGLDisplay eglGetDisplay(EGLNativeDisplayType display_id) {
+    MOCK_RECORD(eglGetDisplay, display_id);
+    return MOCK_DISPLAY;
+}
+
+MOCK_API EGLDisplay eglGetPlatformDisplay(EGLenum platform, void* native_display, const EGLAttrib* attrib_list) {
+    MOCK_RECORD(eglGetPlatformDisplay, platform, native_display, attrib_list);
+    return MOCK_DISPLAY;
+}
+
+MOCK_API EGLBoolean eglInitialize(EGLDisplay dpy, EGLint* major, EGLint* minor) {
+    MOCK_RECORD(eglInitialize, dpy, major, minor);
+    if (major) *major = 1;
+    if (minor) *minor = 5;
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglTerminate(EGLDisplay dpy) {
+    MOCK_RECORD(eglTerminate, dpy);
+    return EGL_TRUE;
+}
+
+MOCK_API const char* eglQueryString(EGLDisplay dpy, EGLint name) {
+    MOCK_RECORD(eglQueryString, dpy, name);
+    switch (name) {
+    case EGL_VENDOR:
+        return "MobileGL-Dev";
+    case EGL_VERSION:
+        return "1.5 Mock";
+    case EGL_CLIENT_APIS:
+        return "OpenGL_ES";
+    case EGL_EXTENSIONS:
+        return "EGL_KHR_surfaceless_context EGL_KHR_create_context";
+    default:
+        g_egl_error = EGL_BAD_PARAMETER;
+        return nullptr;
+    }
+}
+
+MOCK_API EGLBoolean eglBindAPI(EGLenum api) {
+    MOCK_RECORD(eglBindAPI, api);
+    g_api = api;
+    return EGL_TRUE;
+}
+
+MOCK_API EGLenum eglQueryAPI() {
+    MOCK_RECORD(eglQueryAPI);
+    return g_api;
+}
+
+MOCK_API EGLBoolean eglGetConfigs(EGLDisplay dpy, EGLConfig* configs, EGLint config_size, EGLint* num_config) {
+    MOCK_RECORD(eglGetConfigs, dpy, configs, config_size, num_config);
+    if (configs && config_size > 0) configs[0] = MOCK_CONFIG;
+    if (num_config) *num_config = 1;
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglChooseConfig(EGLDisplay dpy, const EGLint* attrib_list, EGLConfig* configs,
+                                    EGLint config_size, EGLint* num_config) {
+    MOCK_RECORD(eglChooseConfig, dpy, attrib_list, configs, config_size, num_config);
+    if (configs && config_size > 0) configs[0] = MOCK_CONFIG;
+    if (num_config) *num_config = 1;
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglGetConfigAttrib(EGLDisplay dpy, EGLConfig config, EGLint attribute, EGLint* value) {
+    MOCK_RECORD(eglGetConfigAttrib, dpy, config, attribute, value);
+    switch (attribute) {
+    case EGL_RED_SIZE:
+    case EGL_GREEN_SIZE:
+    case EGL_BLUE_SIZE:
+    case EGL_ALPHA_SIZE:
+    case EGL_STENCIL_SIZE:
+        *value = 8;
+        break;
+    case EGL_BUFFER_SIZE:
+        *value = 32;
+        break;
+    case EGL_DEPTH_SIZE:
+        *value = 24;
+        break;
+    case EGL_CONFIG_ID:
+        *value = 1;
+        break;
+    case EGL_SURFACE_TYPE:
+        *value = EGL_WINDOW_BIT | EGL_PBUFFER_BIT;
+        break;
+    case EGL_RENDERABLE_TYPE:
+    case EGL_CONFORMANT:
+        *value = EGL_OPENGL_ES2_BIT | 0x40; // EGL_OPENGL_ES3_BIT
+        break;
+    case EGL_NATIVE_VISUAL_ID:
+        *value = 1; // WINDOW_FORMAT_RGBA_8888
+        break;
+    default:
+        *value = 0;
+    }
+    return EGL_TRUE;
+}
+
+MOCK_API EGLContext eglCreateContext(EGLDisplay dpy, EGLConfig config, EGLContext share_context,
+                                     const EGLint* attrib_list) {
+    MOCK_RECORD(eglCreateContext, dpy, config, share_context, attrib_list);
+    return new_handle();
+}
+
+MOCK_API EGLBoolean eglDestroyContext(EGLDisplay dpy, EGLContext ctx) {
+    MOCK_RECORD(eglDestroyContext, dpy, ctx);
+    if (ctx == g_context) g_context = EGL_NO_CONTEXT;
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglQueryContext(EGLDisplay dpy, EGLContext ctx, EGLint attribute, EGLint* value) {
+    MOCK_RECORD(eglQueryContext, dpy, ctx, attribute, value);
+    switch (attribute) {
+    case EGL_CONTEXT_CLIENT_VERSION:
+        *value = 3;
+        break;
+    case EGL_CONTEXT_CLIENT_TYPE:
+        *value = EGL_OPENGL_ES_API;
+        break;
+    case EGL_CONFIG_ID:
+        *value = 1;
+        break;
+    default:
+        *value = 0;
+    }
+    return EGL_TRUE;
+}
+
+MOCK_API EGLSurface eglCreateWindowSurface(EGLDisplay dpy, EGLConfig config, EGLNativeWindowType win,
+                                           const EGLint* attrib_list) {
+    MOCK_RECORD(eglCreateWindowSurface, dpy, config, win, attrib_list);
+    return new_handle();
+}
+
+MOCK_API EGLSurface eglCreatePbufferSurface(EGLDisplay dpy, EGLConfig config, const EGLint* attrib_list) {
+    MOCK_RECORD(eglCreatePbufferSurface, dpy, config, attrib_list);
+    return new_handle();
+}
+
+MOCK_API EGLSurface eglCreatePixmapSurface(EGLDisplay dpy, EGLConfig config, EGLNativePixmapType pixmap,
+                                           const EGLint* attrib_list) {
+    MOCK_RECORD(eglCreatePixmapSurface, dpy, config, pixmap, attrib_list);
+    return new_handle();
+}
+
+MOCK_API EGLSurface eglCreatePbufferFromClientBuffer(EGLDisplay dpy, EGLenum buftype, EGLClientBuffer buffer,
+                                                     EGLConfig config, const EGLint* attrib_list) {
+    MOCK_RECORD(eglCreatePbufferFromClientBuffer, dpy, buftype, buffer, config, attrib_list);
+    return new_handle();
+}
+
+MOCK_API EGLBoolean eglDestroySurface(EGLDisplay dpy, EGLSurface surface) {
+    MOCK_RECORD(eglDestroySurface, dpy, surface);
+    if (surface == g_draw) g_draw = EGL_NO_SURFACE;
+    if (surface == g_read) g_read = EGL_NO_SURFACE;
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglQuerySurface(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint* value) {
+    MOCK_RECORD(eglQuerySurface, dpy, surface, attribute, value);
+    switch (attribute) {
+    case EGL_WIDTH:
+        *value = mg_mock::surface_width();
+        break;
+    case EGL_HEIGHT:
+        *value = mg_mock::surface_height();
+        break;
+    case EGL_CONFIG_ID:
+        *value = 1;
+        break;
+    case EGL_RENDER_BUFFER:
+        *value = EGL_BACK_BUFFER;
+        break;
+    default:
+        *value = 0;
+    }
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglSurfaceAttrib(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint value) {
+    MOCK_RECORD(eglSurfaceAttrib, dpy, surface, attribute, value);
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglBindTexImage(EGLDisplay dpy, EGLSurface surface, EGLint buffer) {
+    MOCK_RECORD(eglBindTexImage, dpy, surface, buffer);
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglReleaseTexImage(EGLDisplay dpy, EGLSurface surface, EGLint buffer) {
+    MOCK_RECORD(eglReleaseTexImage, dpy, surface, buffer);
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglMakeCurrent(EGLDisplay dpy, EGLSurface draw, EGLSurface read, EGLContext ctx) {
+    MOCK_RECORD(eglMakeCurrent, dpy, draw, read, ctx);
+    bool fresh = ctx != EGL_NO_CONTEXT && ctx != g_context;
+    g_context = ctx;
+    g_draw = draw;
+    g_read = read;
+    if (fresh) mg_mock::reset_viewport_to_surface();
+    return EGL_TRUE;
+}
+
+MOCK_API EGLContext eglGetCurrentContext() {
+    MOCK_RECORD(eglGetCurrentContext);
+    return g_context;
+}
+
+MOCK_API EGLDisplay eglGetCurrentDisplay() {
+    MOCK_RECORD(eglGetCurrentDisplay);
+    return g_context == EGL_NO_CONTEXT ? EGL_NO_DISPLAY : MOCK_DISPLAY;
+}
+
+MOCK_API EGLSurface eglGetCurrentSurface(EGLint readdraw) {
+    MOCK_RECORD(eglGetCurrentSurface, readdraw);
+    return readdraw == EGL_READ ? g_read : g_draw;
+}
+
+MOCK_API EGLBoolean eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
+    MOCK_RECORD(eglSwapBuffers, dpy, surface);
+    mg_mock::count_swap();
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglSwapInterval(EGLDisplay dpy, EGLint interval) {
+    MOCK_RECORD(eglSwapInterval, dpy, interval);
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglCopyBuffers(EGLDisplay dpy, EGLSurface surface, EGLNativePixmapType target) {
+    MOCK_RECORD(eglCopyBuffers, dpy, surface, target);
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglReleaseThread() {
+    MOCK_RECORD(eglReleaseThread);
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglWaitClient() {
+    MOCK_RECORD(eglWaitClient);
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglWaitGL() {
+    MOCK_RECORD(eglWaitGL);
+    return EGL_TRUE;
+}
+
+MOCK_API EGLBoolean eglWaitNative(EGLint engine) {
+    MOCK_RECORD(eglWaitNative, engine);
+    return EGL_TRUE;
+}
+
+// Resolves within the mock itself, never through the process' global scope
+MOCK_API __eglMustCastToProperFunctionPointerType eglGetProcAddress(const char* procname) {
+    MOCK_RECORD(eglGetProcAddress, procname);
+    return (__eglMustCastToProperFunctionPointerType)mg_mock::proc(procname);
+}
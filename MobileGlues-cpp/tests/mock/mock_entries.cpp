@@ -0,0 +1,20 @@
+// MobileGlues - tests/mock/mock_entries.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "mock_internal.h"
+
+// Fallback for every entry point the mock does not model: record the call
+// and return zero. The stateful definitions in mock_gles.cpp are strong
+// symbols and replace these at link time.
+
+#define MOCK_ENTRY(ret, name, params, args)                                                                            \
+    MOCK_API __attribute__((weak)) ret name params {                                                                   \
+        mg_mock::Recorder{#name} args;                                                                                 \
+        return mg_mock::default_result<ret>();                                                                         \
+    }
+
+#include "mock_entries.inc"
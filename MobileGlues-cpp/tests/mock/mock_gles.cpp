@@ -0,0 +1,3234 @@
+// MobileGlues - tests/mock/mock_gles.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "mock_internal.h"
+#include <algorithm>
+#include <dlfcn.h>
+#include <map>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+
+// Stateful part of the mock: a GLES 3.2 context that is just complete
+// enough for MobileGlues to run on and for tests to check the results.
+// Invalid calls set GL errors but are otherwise not validated.
+
+#define MOCK_MAX_TEXTURE_UNITS 32
+#define MOCK_MAX_VERTEX_ATTRIBS 16
+#define MOCK_MAX_DRAW_BUFFERS 8
+#define MOCK_BINARY_FORMAT 0x4D4F434B // 'MOCK'
+#define MOCK_BINARY_MAGIC "MGMOCKBIN"
+
+#define GL_HALF_FLOAT_OES 0x8D61
+#define GL_TIMESTAMP_EXT 0x8E28
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#define GL_DYNAMIC_STORAGE_BIT_EXT 0x0100
+
+namespace mg_mock {
+    bool g_recording = true;
+
+    struct Buffer {
+        std::vector<uint8_t> data;
+        GLenum usage = GL_STATIC_DRAW;
+        bool immutable = false;
+        GLbitfield storage_flags = 0;
+        bool mapped = false;
+        GLintptr map_offset = 0;
+        GLsizeiptr map_length = 0;
+        GLbitfield map_access = 0;
+    };
+
+    struct Texture {
+        GLenum target = 0;
+        bool immutable = false;
+        GLint immutable_levels = 0;
+        std::map<uint64_t, TexLevel> levels; // face << 32 | level
+        std::unordered_map<GLenum, GLint> params;
+    };
+
+    struct Renderbuffer {
+        GLsizei samples = 0;
+        TexLevel storage;
+    };
+
+    struct Framebuffer {
+        std::map<GLenum, Attachment> attachments;
+        std::vector<GLenum> draw_buffers{GL_COLOR_ATTACHMENT0};
+        GLenum read_buffer = GL_COLOR_ATTACHMENT0;
+    };
+
+    struct VertexAttrib {
+        bool enabled = false;
+        bool integer = false;
+        GLboolean normalized = GL_FALSE;
+        GLint size = 4;
+        GLenum type = GL_FLOAT;
+        GLsizei stride = 0;
+        uintptr_t pointer = 0;
+        GLuint buffer = 0;
+        GLuint divisor = 0;
+    };
+
+    struct VertexArray {
+        GLuint element_buffer = 0;
+        VertexAttrib attribs[MOCK_MAX_VERTEX_ATTRIBS];
+    };
+
+    struct Shader {
+        GLenum type = 0;
+        std::string source;
+        bool compiled = false;
+        bool deleted = false;
+        std::string log;
+    };
+
+    struct Program {
+        std::set<GLuint> attached;
+        bool linked = false;
+        bool deleted = false;
+        std::string log;
+        // type and source of every stage at the last link
+        std::vector<std::pair<GLenum, std::string>> stages;
+        std::map<std::string, GLuint> attrib_bindings;
+        std::map<std::string, GLint> uniform_locations;
+        std::map<std::string, GLuint> uniform_blocks;
+        std::map<GLint, std::vector<uint32_t>> uniforms;
+        std::vector<std::string> tf_varyings;
+        GLenum tf_mode = GL_INTERLEAVED_ATTRIBS;
+        GLint binary_retrievable = GL_FALSE;
+        GLint separable = GL_FALSE;
+    };
+
+    struct IndexedBinding {
+        GLuint buffer = 0;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+    };
+
+    struct PixelStore {
+        GLint alignment = 4;
+        GLint row_length = 0;
+        GLint image_height = 0;
+        GLint skip_pixels = 0;
+        GLint skip_rows = 0;
+        GLint skip_images = 0;
+    };
+
+    struct StencilFace {
+        GLenum func = GL_ALWAYS;
+        GLint ref = 0;
+        GLuint value_mask = ~0u;
+        GLuint write_mask = ~0u;
+        GLenum fail = GL_KEEP, zfail = GL_KEEP, zpass = GL_KEEP;
+    };
+
+    struct Context {
+        GLenum error = GL_NO_ERROR;
+        GLuint next_name = 1;
+
+        std::unordered_map<GLuint, Buffer> buffers;
+        std::unordered_map<GLuint, Texture> textures;
+        std::unordered_map<GLuint, Renderbuffer> renderbuffers;
+        std::unordered_map<GLuint, Framebuffer> framebuffers;
+        std::unordered_map<GLuint, VertexArray> vertex_arrays;
+        std::unordered_map<GLuint, Shader> shaders;
+        std::unordered_map<GLuint, Program> programs;
+        std::set<GLuint> queries, samplers, transform_feedbacks;
+        std::set<uintptr_t> syncs;
+        uintptr_t next_sync = 0x1000;
+        size_t fences = 0;
+
+        std::unordered_map<GLenum, GLuint> buffer_bindings;
+        std::map<std::pair<GLenum, GLuint>, IndexedBinding> indexed_bindings;
+        GLuint active_unit = 0;
+        std::unordered_map<GLenum, GLuint> texture_units[MOCK_MAX_TEXTURE_UNITS];
+        GLuint sampler_units[MOCK_MAX_TEXTURE_UNITS] = {};
+        GLuint draw_fbo = 0, read_fbo = 0;
+        GLuint renderbuffer = 0;
+        GLuint vao = 0;
+        GLuint program = 0;
+
+        std::set<GLenum> enabled{GL_DITHER};
+        GLenum blend_src_rgb = GL_ONE, blend_dst_rgb = GL_ZERO, blend_src_alpha = GL_ONE, blend_dst_alpha = GL_ZERO;
+        GLenum blend_eq_rgb = GL_FUNC_ADD, blend_eq_alpha = GL_FUNC_ADD;
+        GLfloat blend_color[4] = {};
+        GLboolean color_mask[4] = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
+        GLenum depth_func = GL_LESS;
+        GLboolean depth_mask = GL_TRUE;
+        GLfloat depth_range[2] = {0.0f, 1.0f};
+        StencilFace stencil_front, stencil_back;
+        GLint viewport[4] = {};
+        GLint scissor[4] = {};
+        GLenum cull_face = GL_BACK;
+        GLenum front_face = GL_CCW;
+        GLfloat polygon_offset[2] = {};
+        GLfloat line_width = 1.0f;
+        GLfloat clear_color[4] = {};
+        GLfloat clear_depth = 1.0f;
+        GLint clear_stencil = 0;
+        PixelStore pack, unpack;
+        GLfloat vertex_attrib_values[MOCK_MAX_VERTEX_ATTRIBS][4] = {};
+
+        int surface_width = 64, surface_height = 64;
+        std::vector<uint8_t> default_fb = std::vector<uint8_t>(64 * 64 * 4);
+        size_t swaps = 0;
+
+        size_t compiles = 0, links = 0;
+        bool reject_binaries = false;
+
+        bool capture_draws = true;
+        std::vector<Draw> draws;
+        std::vector<std::pair<std::string, ComputeKernel>> kernels;
+
+        std::vector<std::string> extensions{
+            "GL_EXT_buffer_storage",         "GL_EXT_disjoint_timer_query",    "GL_EXT_multi_draw_indirect",
+            "GL_OES_draw_elements_base_vertex", "GL_EXT_draw_elements_base_vertex", "GL_EXT_texture_format_BGRA8888",
+            "GL_EXT_read_format_bgra",       "GL_OES_depth_texture",           "GL_OES_depth24",
+            "GL_EXT_texture_norm16",         "GL_EXT_texture_rg",              "GL_OES_mapbuffer",
+            "GL_EXT_color_buffer_float",     "GL_EXT_color_buffer_half_float",
+        };
+        std::string extension_string;
+        std::vector<GLenum> compressed_formats{GL_COMPRESSED_RGB8_ETC2, GL_COMPRESSED_RGBA8_ETC2_EAC,
+                                               GL_COMPRESSED_R11_EAC};
+
+        std::vector<Call> calls;
+        std::unordered_map<std::string_view, size_t> call_counts;
+
+        Context() { vertex_arrays[0]; }
+    };
+
+    static Context& ctx() {
+        static Context* c = new Context();
+        return *c;
+    }
+
+    static void set_error(GLenum error) {
+        if (ctx().error == GL_NO_ERROR) ctx().error = error;
+    }
+
+    void record_call(const char* name, const uint64_t* args, uint32_t argc) {
+        Context& c = ctx();
+        Call call{};
+        call.name = name;
+        call.argc = std::min<uint32_t>(argc, 16);
+        memcpy(call.args, args, call.argc * sizeof(uint64_t));
+        c.calls.push_back(call);
+        c.call_counts[name]++;
+    }
+
+    // Formats
+
+    static int format_components(GLenum format) {
+        switch (format) {
+        case GL_RED:
+        case GL_RED_INTEGER:
+        case GL_ALPHA:
+        case GL_LUMINANCE:
+        case GL_DEPTH_COMPONENT:
+        case GL_STENCIL_INDEX:
+            return 1;
+        case GL_RG:
+        case GL_RG_INTEGER:
+        case GL_LUMINANCE_ALPHA:
+        case GL_DEPTH_STENCIL:
+            return 2;
+        case GL_RGB:
+        case GL_RGB_INTEGER:
+            return 3;
+        default:
+            return 4;
+        }
+    }
+
+    // Size of one component, or of the whole pixel for packed types
+    static int type_size(GLenum type, bool& packed) {
+        packed = false;
+        switch (type) {
+        case GL_UNSIGNED_BYTE:
+        case GL_BYTE:
+            return 1;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT:
+        case GL_HALF_FLOAT_OES:
+            return 2;
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+            packed = true;
+            return 2;
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_10F_11F_11F_REV:
+        case GL_UNSIGNED_INT_5_9_9_9_REV:
+        case GL_UNSIGNED_INT_24_8:
+            packed = true;
+            return 4;
+        case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+            packed = true;
+            return 8;
+        default:
+            return 4;
+        }
+    }
+
+    static int pixel_size(GLenum format, GLenum type) {
+        bool packed;
+        int size = type_size(type, packed);
+        return packed ? size : size * format_components(format);
+    }
+
+    static void sized_format(GLenum internalformat, GLenum& format, GLenum& type) {
+        switch (internalformat) {
+        case GL_R8:
+            format = GL_RED, type = GL_UNSIGNED_BYTE;
+            return;
+        case GL_RG8:
+            format = GL_RG, type = GL_UNSIGNED_BYTE;
+            return;
+        case GL_RGB8:
+        case GL_SRGB8:
+            format = GL_RGB, type = GL_UNSIGNED_BYTE;
+            return;
+        case GL_RGB565:
+            format = GL_RGB, type = GL_UNSIGNED_SHORT_5_6_5;
+            return;
+        case GL_RGBA4:
+            format = GL_RGBA, type = GL_UNSIGNED_SHORT_4_4_4_4;
+            return;
+        case GL_RGB5_A1:
+            format = GL_RGBA, type = GL_UNSIGNED_SHORT_5_5_5_1;
+            return;
+        case GL_RGB10_A2:
+            format = GL_RGBA, type = GL_UNSIGNED_INT_2_10_10_10_REV;
+            return;
+        case GL_R11F_G11F_B10F:
+            format = GL_RGB, type = GL_UNSIGNED_INT_10F_11F_11F_REV;
+            return;
+        case GL_RGB9_E5:
+            format = GL_RGB, type = GL_UNSIGNED_INT_5_9_9_9_REV;
+            return;
+        case GL_R16F:
+            format = GL_RED, type = GL_HALF_FLOAT;
+            return;
+        case GL_RG16F:
+            format = GL_RG, type = GL_HALF_FLOAT;
+            return;
+        case GL_RGB16F:
+            format = GL_RGB, type = GL_HALF_FLOAT;
+            return;
+        case GL_RGBA16F:
+            format = GL_RGBA, type = GL_HALF_FLOAT;
+            return;
+        case GL_R32F:
+            format = GL_RED, type = GL_FLOAT;
+            return;
+        case GL_RG32F:
+            format = GL_RG, type = GL_FLOAT;
+            return;
+        case GL_RGB32F:
+            format = GL_RGB, type = GL_FLOAT;
+            return;
+        case GL_RGBA32F:
+            format = GL_RGBA, type = GL_FLOAT;
+            return;
+        case GL_R8UI:
+            format = GL_RED_INTEGER, type = GL_UNSIGNED_BYTE;
+            return;
+        case GL_R32UI:
+            format = GL_RED_INTEGER, type = GL_UNSIGNED_INT;
+            return;
+        case GL_R32I:
+            format = GL_RED_INTEGER, type = GL_INT;
+            return;
+        case GL_RG32UI:
+            format = GL_RG_INTEGER, type = GL_UNSIGNED_INT;
+            return;
+        case GL_RGBA8UI:
+            format = GL_RGBA_INTEGER, type = GL_UNSIGNED_BYTE;
+            return;
+        case GL_RGBA16UI:
+            format = GL_RGBA_INTEGER, type = GL_UNSIGNED_SHORT;
+            return;
+        case GL_RGBA32UI:
+            format = GL_RGBA_INTEGER, type = GL_UNSIGNED_INT;
+            return;
+        case GL_RGBA32I:
+            format = GL_RGBA_INTEGER, type = GL_INT;
+            return;
+        case GL_DEPTH_COMPONENT16:
+            format = GL_DEPTH_COMPONENT, type = GL_UNSIGNED_SHORT;
+            return;
+        case GL_DEPTH_COMPONENT24:
+            format = GL_DEPTH_COMPONENT, type = GL_UNSIGNED_INT;
+            return;
+        case GL_DEPTH_COMPONENT32F:
+            format = GL_DEPTH_COMPONENT, type = GL_FLOAT;
+            return;
+        case GL_DEPTH24_STENCIL8:
+            format = GL_DEPTH_STENCIL, type = GL_UNSIGNED_INT_24_8;
+            return;
+        case GL_DEPTH32F_STENCIL8:
+            format = GL_DEPTH_STENCIL, type = GL_FLOAT_32_UNSIGNED_INT_24_8_REV;
+            return;
+        case GL_STENCIL_INDEX8:
+            format = GL_STENCIL_INDEX, type = GL_UNSIGNED_BYTE;
+            return;
+        case GL_RED:
+        case GL_RG:
+        case GL_RGB:
+        case GL_LUMINANCE:
+        case GL_ALPHA:
+        case GL_LUMINANCE_ALPHA:
+            format = internalformat, type = GL_UNSIGNED_BYTE;
+            return;
+        default:
+            format = GL_RGBA, type = GL_UNSIGNED_BYTE;
+            return;
+        }
+    }
+
+    // Byte layout of a client image described by the pixel store state
+    struct ImageLayout {
+        size_t pixel, row, image, start;
+    };
+
+    static ImageLayout image_layout(const PixelStore& store, GLenum format, GLenum type, GLsizei width,
+                                    GLsizei height) {
+        bool packed;
+        int component = type_size(type, packed);
+        ImageLayout layout{};
+        layout.pixel = pixel_size(format, type);
+        size_t row_pixels = store.row_length > 0 ? store.row_length : width;
+        size_t alignment = store.alignment;
+        size_t row = layout.pixel * row_pixels;
+        if ((size_t)component < alignment) row = (row + alignment - 1) / alignment * alignment;
+        layout.row = row;
+        layout.image = row * (store.image_height > 0 ? store.image_height : height);
+        layout.start =
+            store.skip_images * layout.image + store.skip_rows * layout.row + store.skip_pixels * layout.pixel;
+        return layout;
+    }
+
+    // Objects and bindings
+
+    static GLuint new_name() { return ctx().next_name++; }
+
+    static GLuint bound_buffer(GLenum target) {
+        Context& c = ctx();
+        if (target == GL_ELEMENT_ARRAY_BUFFER) return c.vertex_arrays[c.vao].element_buffer;
+        auto it = c.buffer_bindings.find(target);
+        return it == c.buffer_bindings.end() ? 0 : it->second;
+    }
+
+    static Buffer* buffer_for(GLenum target) {
+        GLuint name = bound_buffer(target);
+        if (!name) return nullptr;
+        return &ctx().buffers[name];
+    }
+
+    // Client pointer or offset into the bound unpack/pack buffer
+    static uint8_t* resolve_pixels(GLenum pbo_target, const void* pointer) {
+        if (Buffer* pbo = buffer_for(pbo_target)) return pbo->data.data() + (uintptr_t)pointer;
+        return (uint8_t*)pointer;
+    }
+
+    static GLenum texture_binding_target(GLenum target) {
+        if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+            return GL_TEXTURE_CUBE_MAP;
+        return target;
+    }
+
+    static GLuint bound_texture(GLenum target) {
+        Context& c = ctx();
+        auto& unit = c.texture_units[c.active_unit];
+        auto it = unit.find(texture_binding_target(target));
+        return it == unit.end() ? 0 : it->second;
+    }
+
+    static uint64_t level_key(GLenum target, GLint level) {
+        GLenum face = texture_binding_target(target) == GL_TEXTURE_CUBE_MAP ? target : 0;
+        return (uint64_t)face << 32 | (uint32_t)level;
+    }
+
+    static TexLevel* texture_level_for(GLenum target, GLint level) {
+        GLuint name = bound_texture(target);
+        auto it = ctx().textures.find(name);
+        if (it == ctx().textures.end()) return nullptr;
+        auto lit = it->second.levels.find(level_key(target, level));
+        return lit == it->second.levels.end() ? nullptr : &lit->second;
+    }
+
+    static TexLevel& define_level(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height,
+                                  GLsizei depth, GLenum format, GLenum type) {
+        Texture& tex = ctx().textures[bound_texture(target)];
+        if (!tex.target) tex.target = texture_binding_target(target);
+        TexLevel& l = tex.levels[level_key(target, level)];
+        l.width = width;
+        l.height = height;
+        l.depth = depth;
+        l.internalformat = internalformat;
+        l.format = format;
+        l.type = type;
+        l.compressed = false;
+        l.data.assign((size_t)pixel_size(format, type) * width * height * depth, 0);
+        return l;
+    }
+
+    static void unpack_into(TexLevel& l, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth,
+                            GLenum format, GLenum type, const void* pixels) {
+        const uint8_t* src = resolve_pixels(GL_PIXEL_UNPACK_BUFFER, pixels);
+        if (!src) return;
+        ImageLayout in = image_layout(ctx().unpack, format, type, width, height);
+        size_t dst_pixel = pixel_size(l.format, l.type);
+        if (dst_pixel != in.pixel) {
+            set_error(GL_INVALID_OPERATION);
+            return;
+        }
+        if (x < 0 || y < 0 || z < 0 || x + width > l.width || y + height > l.height || z + depth > l.depth) {
+            set_error(GL_INVALID_VALUE);
+            return;
+        }
+        for (GLsizei k = 0; k < depth; ++k) {
+            for (GLsizei j = 0; j < height; ++j) {
+                const uint8_t* s = src + in.start + k * in.image + j * in.row;
+                uint8_t* d = l.data.data() + (((size_t)(z + k) * l.height + (y + j)) * l.width + x) * dst_pixel;
+                memcpy(d, s, width * dst_pixel);
+            }
+        }
+    }
+
+    // A color surface to read from or draw into
+    struct Surface {
+        uint8_t* data = nullptr;
+        GLsizei width = 0, height = 0;
+        GLenum format = GL_RGBA, type = GL_UNSIGNED_BYTE;
+    };
+
+    static Surface attachment_surface(const Attachment& a) {
+        Context& c = ctx();
+        TexLevel* l = nullptr;
+        size_t offset = 0;
+        if (a.type == GL_TEXTURE) {
+            auto it = c.textures.find(a.name);
+            if (it == c.textures.end()) return {};
+            GLenum target = a.textarget ? a.textarget : it->second.target;
+            auto lit = it->second.levels.find(level_key(target, a.level));
+            if (lit == it->second.levels.end()) return {};
+            l = &lit->second;
+            offset = (size_t)a.layer * l->width * l->height * pixel_size(l->format, l->type);
+        } else if (a.type == GL_RENDERBUFFER) {
+            auto it = c.renderbuffers.find(a.name);
+            if (it == c.renderbuffers.end()) return {};
+            l = &it->second.storage;
+        }
+        if (!l || l->data.empty()) return {};
+        return {l->data.data() + offset, l->width, l->height, l->format, l->type};
+    }
+
+    static Surface framebuffer_surface(GLuint fbo, GLenum buffer) {
+        Context& c = ctx();
+        if (fbo == 0) {
+            if (buffer == GL_NONE) return {};
+            return {c.default_fb.data(), c.surface_width, c.surface_height, GL_RGBA, GL_UNSIGNED_BYTE};
+        }
+        auto it = c.framebuffers.find(fbo);
+        if (it == c.framebuffers.end()) return {};
+        auto ait = it->second.attachments.find(buffer);
+        if (ait == it->second.attachments.end()) return {};
+        return attachment_surface(ait->second);
+    }
+
+    static Surface read_surface() {
+        Context& c = ctx();
+        GLenum buffer = c.read_fbo ? c.framebuffers[c.read_fbo].read_buffer : GL_BACK;
+        return framebuffer_surface(c.read_fbo, buffer);
+    }
+
+    static std::vector<Surface> draw_surfaces() {
+        Context& c = ctx();
+        std::vector<Surface> out;
+        if (c.draw_fbo == 0) {
+            out.push_back(framebuffer_surface(0, GL_BACK));
+            return out;
+        }
+        for (GLenum buffer : c.framebuffers[c.draw_fbo].draw_buffers) {
+            Surface s = framebuffer_surface(c.draw_fbo, buffer);
+            if (s.data) out.push_back(s);
+        }
+        return out;
+    }
+
+    static void copy_from_read(TexLevel& dst, GLint dx, GLint dy, GLint dz, GLint x, GLint y, GLsizei width,
+                               GLsizei height) {
+        Surface src = read_surface();
+        if (!src.data) {
+            set_error(GL_INVALID_FRAMEBUFFER_OPERATION);
+            return;
+        }
+        size_t ps = pixel_size(src.format, src.type);
+        if (ps != (size_t)pixel_size(dst.format, dst.type)) {
+            set_error(GL_INVALID_OPERATION);
+            return;
+        }
+        for (GLsizei j = 0; j < height; ++j) {
+            for (GLsizei i = 0; i < width; ++i) {
+                GLint sx = x + i, sy = y + j, tx = dx + i, ty = dy + j;
+                if (sx < 0 || sy < 0 || sx >= src.width || sy >= src.height) continue;
+                if (tx < 0 || ty < 0 || tx >= dst.width || ty >= dst.height) continue;
+                memcpy(dst.data.data() + (((size_t)dz * dst.height + ty) * dst.width + tx) * ps,
+                       src.data + ((size_t)sy * src.width + sx) * ps, ps);
+            }
+        }
+    }
+
+    // Vertex fetch for draw capture
+
+    static float fetch_component(const uint8_t* p, GLenum type, GLboolean normalized, int i) {
+        switch (type) {
+        case GL_FLOAT: {
+            float f;
+            memcpy(&f, p + i * 4, 4);
+            return f;
+        }
+        case GL_UNSIGNED_BYTE:
+            return normalized ? p[i] / 255.0f : p[i];
+        case GL_BYTE:
+            return normalized ? std::max(((int8_t*)p)[i] / 127.0f, -1.0f) : ((int8_t*)p)[i];
+        case GL_UNSIGNED_SHORT: {
+            uint16_t v;
+            memcpy(&v, p + i * 2, 2);
+            return normalized ? v / 65535.0f : v;
+        }
+        case GL_SHORT: {
+            int16_t v;
+            memcpy(&v, p + i * 2, 2);
+            return normalized ? std::max(v / 32767.0f, -1.0f) : v;
+        }
+        case GL_UNSIGNED_INT: {
+            uint32_t v;
+            memcpy(&v, p + i * 4, 4);
+            return normalized ? (float)(v / 4294967295.0) : (float)v;
+        }
+        case GL_INT: {
+            int32_t v;
+            memcpy(&v, p + i * 4, 4);
+            return normalized ? std::max((float)(v / 2147483647.0), -1.0f) : (float)v;
+        }
+        default:
+            return 0.0f;
+        }
+    }
+
+    static uint32_t fetch_index(const uint8_t* p, GLenum type, size_t i) {
+        switch (type) {
+        case GL_UNSIGNED_BYTE:
+            return p[i];
+        case GL_UNSIGNED_SHORT: {
+            uint16_t v;
+            memcpy(&v, p + i * 2, 2);
+            return v;
+        }
+        default: {
+            uint32_t v;
+            memcpy(&v, p + i * 4, 4);
+            return v;
+        }
+        }
+    }
+
+    static size_t index_size(GLenum type) {
+        return type == GL_UNSIGNED_BYTE ? 1 : type == GL_UNSIGNED_SHORT ? 2 : 4;
+    }
+
+    static void capture_draw(const char* name, GLenum mode, GLint first, GLsizei count, GLsizei instances,
+                             GLenum index_type, const void* indices, GLint basevertex) {
+        Context& c = ctx();
+        if (!c.capture_draws) return;
+        Draw d{};
+        d.name = name;
+        d.mode = mode;
+        d.first = first;
+        d.count = count;
+        d.instances = instances;
+        d.basevertex = basevertex;
+        d.index_type = index_type;
+        d.program = c.program;
+        d.vao = c.vao;
+
+        VertexArray& vao = c.vertex_arrays[c.vao];
+        std::vector<uint32_t> vertices;
+        if (index_type) {
+            const uint8_t* src = (const uint8_t*)indices;
+            if (vao.element_buffer) src = c.buffers[vao.element_buffer].data.data() + (uintptr_t)indices;
+            for (GLsizei i = 0; i < count && src; ++i) {
+                d.indices.push_back(fetch_index(src, index_type, i));
+                vertices.push_back(d.indices.back() + basevertex);
+            }
+        } else {
+            for (GLsizei i = 0; i < count; ++i)
+                vertices.push_back(first + i);
+        }
+
+        for (GLuint index = 0; index < MOCK_MAX_VERTEX_ATTRIBS; ++index) {
+            const VertexAttrib& a = vao.attribs[index];
+            if (!a.enabled) continue;
+            DrawAttrib out{index, a.size, {}};
+            const uint8_t* base = (const uint8_t*)a.pointer;
+            if (a.buffer) {
+                auto& data = c.buffers[a.buffer].data;
+                base = data.data() + a.pointer;
+            }
+            size_t component = index_size(a.type == GL_FLOAT || a.type == GL_INT || a.type == GL_UNSIGNED_INT
+                                              ? GL_UNSIGNED_INT
+                                          : a.type == GL_SHORT || a.type == GL_UNSIGNED_SHORT ? GL_UNSIGNED_SHORT
+                                                                                              : GL_UNSIGNED_BYTE);
+            size_t stride = a.stride ? a.stride : component * a.size;
+            for (uint32_t v : vertices) {
+                uint32_t fetched = a.divisor ? 0 : v;
+                for (int i = 0; i < a.size; ++i)
+                    out.values.push_back(base ? fetch_component(base + fetched * stride, a.type, a.normalized, i)
+                                              : 0.0f);
+            }
+            d.attribs.push_back(std::move(out));
+        }
+        c.draws.push_back(std::move(d));
+    }
+
+    // Queries
+
+    static void append(std::vector<double>& v, std::initializer_list<double> values) {
+        v.insert(v.end(), values.begin(), values.end());
+    }
+
+    static bool query(GLenum pname, std::vector<double>& v) {
+        Context& c = ctx();
+        switch (pname) {
+        case GL_MAJOR_VERSION:
+            append(v, {3});
+            return true;
+        case GL_MINOR_VERSION:
+            append(v, {2});
+            return true;
+        case GL_NUM_EXTENSIONS:
+            append(v, {(double)c.extensions.size()});
+            return true;
+        case GL_NUM_COMPRESSED_TEXTURE_FORMATS:
+            append(v, {(double)c.compressed_formats.size()});
+            return true;
+        case GL_COMPRESSED_TEXTURE_FORMATS:
+            for (GLenum f : c.compressed_formats)
+                v.push_back(f);
+            return true;
+        case GL_NUM_PROGRAM_BINARY_FORMATS:
+            append(v, {1});
+            return true;
+        case GL_PROGRAM_BINARY_FORMATS:
+            append(v, {MOCK_BINARY_FORMAT});
+            return true;
+        case GL_NUM_SHADER_BINARY_FORMATS:
+            append(v, {0});
+            return true;
+        case GL_MAX_TEXTURE_SIZE:
+        case GL_MAX_RENDERBUFFER_SIZE:
+        case GL_MAX_CUBE_MAP_TEXTURE_SIZE:
+            append(v, {16384});
+            return true;
+        case GL_MAX_VIEWPORT_DIMS:
+            append(v, {16384, 16384});
+            return true;
+        case GL_MAX_3D_TEXTURE_SIZE:
+        case GL_MAX_ARRAY_TEXTURE_LAYERS:
+            append(v, {2048});
+            return true;
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_VERTEX_ATTRIBS:
+        case GL_MAX_VERTEX_ATTRIB_BINDINGS:
+            append(v, {16});
+            return true;
+        case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+            append(v, {MOCK_MAX_TEXTURE_UNITS});
+            return true;
+        case GL_MAX_DRAW_BUFFERS:
+        case GL_MAX_COLOR_ATTACHMENTS:
+        case GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS:
+        case GL_MAX_IMAGE_UNITS:
+            append(v, {MOCK_MAX_DRAW_BUFFERS});
+            return true;
+        case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+            append(v, {72});
+            return true;
+        case GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS:
+            append(v, {4});
+            return true;
+        case GL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS:
+            append(v, {1});
+            return true;
+        case GL_MAX_SAMPLES:
+        case GL_MAX_INTEGER_SAMPLES:
+            append(v, {4});
+            return true;
+        case GL_MAX_VERTEX_UNIFORM_VECTORS:
+        case GL_MAX_FRAGMENT_UNIFORM_VECTORS:
+            append(v, {1024});
+            return true;
+        case GL_MAX_VARYING_VECTORS:
+            append(v, {32});
+            return true;
+        case GL_MAX_UNIFORM_BLOCK_SIZE:
+            append(v, {65536});
+            return true;
+        case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+        case GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT:
+            append(v, {256});
+            return true;
+        case GL_MAX_ELEMENT_INDEX:
+            append(v, {4294967295.0});
+            return true;
+        case GL_MAX_ELEMENTS_VERTICES:
+        case GL_MAX_ELEMENTS_INDICES:
+            append(v, {1 << 20});
+            return true;
+        case GL_MAX_TEXTURE_LOD_BIAS:
+            append(v, {15.0});
+            return true;
+        case GL_ALIASED_LINE_WIDTH_RANGE:
+            append(v, {1.0, 8.0});
+            return true;
+        case GL_ALIASED_POINT_SIZE_RANGE:
+            append(v, {1.0, 1024.0});
+            return true;
+        case GL_SUBPIXEL_BITS:
+            append(v, {4});
+            return true;
+        case GL_RED_BITS:
+        case GL_GREEN_BITS:
+        case GL_BLUE_BITS:
+        case GL_ALPHA_BITS:
+        case GL_STENCIL_BITS:
+            append(v, {8});
+            return true;
+        case GL_DEPTH_BITS:
+            append(v, {24});
+            return true;
+        case GL_IMPLEMENTATION_COLOR_READ_FORMAT:
+            append(v, {GL_RGBA});
+            return true;
+        case GL_IMPLEMENTATION_COLOR_READ_TYPE:
+            append(v, {GL_UNSIGNED_BYTE});
+            return true;
+        case GL_GPU_DISJOINT_EXT:
+            append(v, {0});
+            return true;
+        case GL_TIMESTAMP_EXT:
+            append(v, {0});
+            return true;
+
+        case GL_ARRAY_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_ARRAY_BUFFER)});
+            return true;
+        case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_ELEMENT_ARRAY_BUFFER)});
+            return true;
+        case GL_COPY_READ_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_COPY_READ_BUFFER)});
+            return true;
+        case GL_COPY_WRITE_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_COPY_WRITE_BUFFER)});
+            return true;
+        case GL_PIXEL_PACK_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_PIXEL_PACK_BUFFER)});
+            return true;
+        case GL_PIXEL_UNPACK_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_PIXEL_UNPACK_BUFFER)});
+            return true;
+        case GL_UNIFORM_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_UNIFORM_BUFFER)});
+            return true;
+        case GL_SHADER_STORAGE_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_SHADER_STORAGE_BUFFER)});
+            return true;
+        case GL_TRANSFORM_FEEDBACK_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_TRANSFORM_FEEDBACK_BUFFER)});
+            return true;
+        case GL_DRAW_INDIRECT_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_DRAW_INDIRECT_BUFFER)});
+            return true;
+        case GL_TEXTURE_BUFFER_BINDING:
+            append(v, {(double)bound_buffer(GL_TEXTURE_BUFFER)});
+            return true;
+        case GL_ACTIVE_TEXTURE:
+            append(v, {(double)(GL_TEXTURE0 + c.active_unit)});
+            return true;
+        case GL_TEXTURE_BINDING_2D:
+            append(v, {(double)bound_texture(GL_TEXTURE_2D)});
+            return true;
+        case GL_TEXTURE_BINDING_3D:
+            append(v, {(double)bound_texture(GL_TEXTURE_3D)});
+            return true;
+        case GL_TEXTURE_BINDING_2D_ARRAY:
+            append(v, {(double)bound_texture(GL_TEXTURE_2D_ARRAY)});
+            return true;
+        case GL_TEXTURE_BINDING_CUBE_MAP:
+            append(v, {(double)bound_texture(GL_TEXTURE_CUBE_MAP)});
+            return true;
+        case GL_SAMPLER_BINDING:
+            append(v, {(double)c.sampler_units[c.active_unit]});
+            return true;
+        case GL_DRAW_FRAMEBUFFER_BINDING:
+            append(v, {(double)c.draw_fbo});
+            return true;
+        case GL_READ_FRAMEBUFFER_BINDING:
+            append(v, {(double)c.read_fbo});
+            return true;
+        case GL_RENDERBUFFER_BINDING:
+            append(v, {(double)c.renderbuffer});
+            return true;
+        case GL_VERTEX_ARRAY_BINDING:
+            append(v, {(double)c.vao});
+            return true;
+        case GL_CURRENT_PROGRAM:
+            append(v, {(double)c.program});
+            return true;
+        case GL_READ_BUFFER:
+            append(v, {(double)(c.read_fbo ? c.framebuffers[c.read_fbo].read_buffer : GL_BACK)});
+            return true;
+
+        case GL_VIEWPORT:
+            append(v, {(double)c.viewport[0], (double)c.viewport[1], (double)c.viewport[2], (double)c.viewport[3]});
+            return true;
+        case GL_SCISSOR_BOX:
+            append(v, {(double)c.scissor[0], (double)c.scissor[1], (double)c.scissor[2], (double)c.scissor[3]});
+            return true;
+        case GL_BLEND_SRC_RGB:
+            append(v, {(double)c.blend_src_rgb});
+            return true;
+        case GL_BLEND_DST_RGB:
+            append(v, {(double)c.blend_dst_rgb});
+            return true;
+        case GL_BLEND_SRC_ALPHA:
+            append(v, {(double)c.blend_src_alpha});
+            return true;
+        case GL_BLEND_DST_ALPHA:
+            append(v, {(double)c.blend_dst_alpha});
+            return true;
+        case GL_BLEND_EQUATION_RGB:
+            append(v, {(double)c.blend_eq_rgb});
+            return true;
+        case GL_BLEND_EQUATION_ALPHA:
+            append(v, {(double)c.blend_eq_alpha});
+            return true;
+        case GL_BLEND_COLOR:
+            append(v, {c.blend_color[0], c.blend_color[1], c.blend_color[2], c.blend_color[3]});
+            return true;
+        case GL_COLOR_WRITEMASK:
+            append(v, {(double)c.color_mask[0], (double)c.color_mask[1], (double)c.color_mask[2],
+                       (double)c.color_mask[3]});
+            return true;
+        case GL_DEPTH_FUNC:
+            append(v, {(double)c.depth_func});
+            return true;
+        case GL_DEPTH_WRITEMASK:
+            append(v, {(double)c.depth_mask});
+            return true;
+        case GL_DEPTH_RANGE:
+            append(v, {c.depth_range[0], c.depth_range[1]});
+            return true;
+        case GL_DEPTH_CLEAR_VALUE:
+            append(v, {c.clear_depth});
+            return true;
+        case GL_COLOR_CLEAR_VALUE:
+            append(v, {c.clear_color[0], c.clear_color[1], c.clear_color[2], c.clear_color[3]});
+            return true;
+        case GL_STENCIL_CLEAR_VALUE:
+            append(v, {(double)c.clear_stencil});
+            return true;
+        case GL_STENCIL_FUNC:
+            append(v, {(double)c.stencil_front.func});
+            return true;
+        case GL_STENCIL_REF:
+            append(v, {(double)c.stencil_front.ref});
+            return true;
+        case GL_STENCIL_VALUE_MASK:
+            append(v, {(double)c.stencil_front.value_mask});
+            return true;
+        case GL_STENCIL_WRITEMASK:
+            append(v, {(double)c.stencil_front.write_mask});
+            return true;
+        case GL_STENCIL_FAIL:
+            append(v, {(double)c.stencil_front.fail});
+            return true;
+        case GL_STENCIL_PASS_DEPTH_FAIL:
+            append(v, {(double)c.stencil_front.zfail});
+            return true;
+        case GL_STENCIL_PASS_DEPTH_PASS:
+            append(v, {(double)c.stencil_front.zpass});
+            return true;
+        case GL_STENCIL_BACK_FUNC:
+            append(v, {(double)c.stencil_back.func});
+            return true;
+        case GL_STENCIL_BACK_REF:
+            append(v, {(double)c.stencil_back.ref});
+            return true;
+        case GL_STENCIL_BACK_VALUE_MASK:
+            append(v, {(double)c.stencil_back.value_mask});
+            return true;
+        case GL_STENCIL_BACK_WRITEMASK:
+            append(v, {(double)c.stencil_back.write_mask});
+            return true;
+        case GL_STENCIL_BACK_FAIL:
+            append(v, {(double)c.stencil_back.fail});
+            return true;
+        case GL_STENCIL_BACK_PASS_DEPTH_FAIL:
+            append(v, {(double)c.stencil_back.zfail});
+            return true;
+        case GL_STENCIL_BACK_PASS_DEPTH_PASS:
+            append(v, {(double)c.stencil_back.zpass});
+            return true;
+        case GL_CULL_FACE_MODE:
+            append(v, {(double)c.cull_face});
+            return true;
+        case GL_FRONT_FACE:
+            append(v, {(double)c.front_face});
+            return true;
+        case GL_POLYGON_OFFSET_FACTOR:
+            append(v, {c.polygon_offset[0]});
+            return true;
+        case GL_POLYGON_OFFSET_UNITS:
+            append(v, {c.polygon_offset[1]});
+            return true;
+        case GL_LINE_WIDTH:
+            append(v, {c.line_width});
+            return true;
+        case GL_PACK_ALIGNMENT:
+            append(v, {(double)c.pack.alignment});
+            return true;
+        case GL_PACK_ROW_LENGTH:
+            append(v, {(double)c.pack.row_length});
+            return true;
+        case GL_PACK_SKIP_PIXELS:
+            append(v, {(double)c.pack.skip_pixels});
+            return true;
+        case GL_PACK_SKIP_ROWS:
+            append(v, {(double)c.pack.skip_rows});
+            return true;
+        case GL_UNPACK_ALIGNMENT:
+            append(v, {(double)c.unpack.alignment});
+            return true;
+        case GL_UNPACK_ROW_LENGTH:
+            append(v, {(double)c.unpack.row_length});
+            return true;
+        case GL_UNPACK_IMAGE_HEIGHT:
+            append(v, {(double)c.unpack.image_height});
+            return true;
+        case GL_UNPACK_SKIP_PIXELS:
+            append(v, {(double)c.unpack.skip_pixels});
+            return true;
+        case GL_UNPACK_SKIP_ROWS:
+            append(v, {(double)c.unpack.skip_rows});
+            return true;
+        case GL_UNPACK_SKIP_IMAGES:
+            append(v, {(double)c.unpack.skip_images});
+            return true;
+        default:
+            if (c.enabled.count(pname) || pname == GL_BLEND || pname == GL_CULL_FACE || pname == GL_DEPTH_TEST ||
+                pname == GL_DITHER || pname == GL_SCISSOR_TEST || pname == GL_STENCIL_TEST ||
+                pname == GL_POLYGON_OFFSET_FILL || pname == GL_RASTERIZER_DISCARD ||
+                pname == GL_SAMPLE_ALPHA_TO_COVERAGE || pname == GL_SAMPLE_COVERAGE ||
+                pname == GL_PRIMITIVE_RESTART_FIXED_INDEX || pname == GL_SAMPLE_MASK) {
+                append(v, {c.enabled.count(pname) ? 1.0 : 0.0});
+                return true;
+            }
+            set_error(GL_INVALID_ENUM);
+            return false;
+        }
+    }
+
+    static Program* program(GLuint name) {
+        auto it = ctx().programs.find(name);
+        return it == ctx().programs.end() ? nullptr : &it->second;
+    }
+
+    static void set_uniform(GLint location, const void* values, size_t words) {
+        Program* p = program(ctx().program);
+        if (!p || location < 0) return;
+        auto& slot = p->uniforms[location];
+        slot.resize(words);
+        memcpy(slot.data(), values, words * 4);
+    }
+
+    static void link(Program& p) {
+        Context& c = ctx();
+        c.links++;
+        p.stages.clear();
+        p.linked = true;
+        p.log.clear();
+        for (GLuint s : p.attached) {
+            auto it = c.shaders.find(s);
+            if (it == c.shaders.end() || !it->second.compiled) {
+                p.linked = false;
+                p.log = "mock: attached shader did not compile";
+                continue;
+            }
+            p.stages.emplace_back(it->second.type, it->second.source);
+        }
+        if (p.attached.empty()) {
+            p.linked = false;
+            p.log = "mock: no shaders attached";
+        }
+    }
+
+    static std::vector<uint8_t> serialize_binary(const Program& p) {
+        std::vector<uint8_t> out(MOCK_BINARY_MAGIC, MOCK_BINARY_MAGIC + sizeof(MOCK_BINARY_MAGIC));
+        auto put = [&](uint32_t v) { out.insert(out.end(), (uint8_t*)&v, (uint8_t*)&v + 4); };
+        put((uint32_t)p.stages.size());
+        for (auto& [type, source] : p.stages) {
+            put(type);
+            put((uint32_t)source.size());
+            out.insert(out.end(), source.begin(), source.end());
+        }
+        return out;
+    }
+
+    static bool deserialize_binary(Program& p, const uint8_t* data, size_t size) {
+        size_t pos = sizeof(MOCK_BINARY_MAGIC);
+        if (size < pos || memcmp(data, MOCK_BINARY_MAGIC, pos) != 0) return false;
+        auto get = [&](uint32_t& v) {
+            if (pos + 4 > size) return false;
+            memcpy(&v, data + pos, 4);
+            pos += 4;
+            return true;
+        };
+        uint32_t count;
+        if (!get(count)) return false;
+        p.stages.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t type, length;
+            if (!get(type) || !get(length) || pos + length > size) return false;
+            p.stages.emplace_back(type, std::string((const char*)data + pos, length));
+            pos += length;
+        }
+        return pos == size;
+    }
+
+    static void resize_default_framebuffer(int width, int height) {
+        Context& c = ctx();
+        c.surface_width = width;
+        c.surface_height = height;
+        c.default_fb.assign((size_t)width * height * 4, 0);
+    }
+
+    // Called from eglMakeCurrent, a fresh context starts with the surface size
+    void reset_viewport_to_surface() {
+        Context& c = ctx();
+        c.viewport[0] = c.viewport[1] = 0;
+        c.viewport[2] = c.surface_width;
+        c.viewport[3] = c.surface_height;
+        memcpy(c.scissor, c.viewport, sizeof(c.viewport));
+    }
+
+    void count_swap() { ctx().swaps++; }
+
+    int surface_width() { return ctx().surface_width; }
+
+    int surface_height() { return ctx().surface_height; }
+
+    // Introspection API
+
+    void set_recording(bool enabled) { g_recording = enabled; }
+
+    void clear_calls() {
+        ctx().calls.clear();
+        ctx().call_counts.clear();
+    }
+
+    const std::vector<Call>& calls() { return ctx().calls; }
+
+    size_t count(const char* name) {
+        auto it = ctx().call_counts.find(name);
+        return it == ctx().call_counts.end() ? 0 : it->second;
+    }
+
+    std::vector<Call> calls_named(const char* name) {
+        std::vector<Call> out;
+        for (const Call& call : ctx().calls) {
+            if (strcmp(call.name, name) == 0) out.push_back(call);
+        }
+        return out;
+    }
+
+    void* proc(const char* name) {
+        static void* self = [] {
+            Dl_info info{};
+            dladdr((void*)&proc, &info);
+            return dlopen(info.dli_fname, RTLD_NOW | RTLD_NOLOAD);
+        }();
+        return self ? dlsym(self, name) : nullptr;
+    }
+
+    void get_integerv(GLenum pname, GLint* params) {
+        std::vector<double> v;
+        if (!query(pname, v)) return;
+        for (size_t i = 0; i < v.size(); ++i)
+            params[i] = (GLint)(int64_t)v[i];
+    }
+
+    const std::vector<uint8_t>* buffer_data(GLuint buffer) {
+        auto it = ctx().buffers.find(buffer);
+        return it == ctx().buffers.end() ? nullptr : &it->second.data;
+    }
+
+    size_t live_buffers() { return ctx().buffers.size(); }
+
+    const TexLevel* texture_level(GLuint texture, GLint level, GLenum face) {
+        auto it = ctx().textures.find(texture);
+        if (it == ctx().textures.end()) return nullptr;
+        auto lit = it->second.levels.find((uint64_t)face << 32 | (uint32_t)level);
+        return lit == it->second.levels.end() ? nullptr : &lit->second;
+    }
+
+    GLenum texture_target(GLuint texture) {
+        auto it = ctx().textures.find(texture);
+        return it == ctx().textures.end() ? 0 : it->second.target;
+    }
+
+    GLint texture_parameter(GLuint texture, GLenum pname) {
+        auto it = ctx().textures.find(texture);
+        if (it == ctx().textures.end()) return 0;
+        auto pit = it->second.params.find(pname);
+        return pit == it->second.params.end() ? 0 : pit->second;
+    }
+
+    size_t live_textures() { return ctx().textures.size(); }
+
+    Attachment fbo_attachment(GLuint framebuffer, GLenum attachment) {
+        auto it = ctx().framebuffers.find(framebuffer);
+        if (it == ctx().framebuffers.end()) return {};
+        auto ait = it->second.attachments.find(attachment);
+        return ait == it->second.attachments.end() ? Attachment{} : ait->second;
+    }
+
+    std::vector<GLenum> fbo_draw_buffers(GLuint framebuffer) {
+        auto it = ctx().framebuffers.find(framebuffer);
+        return it == ctx().framebuffers.end() ? std::vector<GLenum>{} : it->second.draw_buffers;
+    }
+
+    void set_surface_size(int width, int height) { resize_default_framebuffer(width, height); }
+
+    const std::vector<uint8_t>& default_framebuffer() { return ctx().default_fb; }
+
+    size_t swap_count() { return ctx().swaps; }
+
+    std::string shader_source(GLuint shader) {
+        auto it = ctx().shaders.find(shader);
+        return it == ctx().shaders.end() ? std::string() : it->second.source;
+    }
+
+    size_t compile_count() { return ctx().compiles; }
+
+    size_t link_count() { return ctx().links; }
+
+    void set_program_binary_rejected(bool rejected) { ctx().reject_binaries = rejected; }
+
+    std::vector<uint32_t> uniform_value(GLuint prog, GLint location) {
+        Program* p = program(prog);
+        if (!p) return {};
+        auto it = p->uniforms.find(location);
+        return it == p->uniforms.end() ? std::vector<uint32_t>{} : it->second;
+    }
+
+    void set_capture_draws(bool enabled) { ctx().capture_draws = enabled; }
+
+    const std::vector<Draw>& draws() { return ctx().draws; }
+
+    void clear_draws() { ctx().draws.clear(); }
+
+    void set_compute_kernel(const std::string& marker, ComputeKernel kernel) {
+        auto& kernels = ctx().kernels;
+        kernels.erase(std::remove_if(kernels.begin(), kernels.end(), [&](const auto& k) { return k.first == marker; }),
+                      kernels.end());
+        if (kernel) kernels.emplace_back(marker, std::move(kernel));
+    }
+
+    uint8_t* indexed_buffer(GLenum target, GLuint index, size_t* size) {
+        Context& c = ctx();
+        auto it = c.indexed_bindings.find({target, index});
+        if (it == c.indexed_bindings.end() || !it->second.buffer) return nullptr;
+        auto& data = c.buffers[it->second.buffer].data;
+        size_t offset = std::min((size_t)it->second.offset, data.size());
+        size_t available = data.size() - offset;
+        if (size) *size = it->second.size ? std::min((size_t)it->second.size, available) : available;
+        return data.data() + offset;
+    }
+
+    size_t live_syncs() { return ctx().syncs.size(); }
+
+    size_t fence_count() { return ctx().fences; }
+
+    void set_extensions(const std::vector<std::string>& extensions) {
+        ctx().extensions = extensions;
+        ctx().extension_string.clear();
+    }
+
+    void set_compressed_formats(const std::vector<GLenum>& formats) { ctx().compressed_formats = formats; }
+} // namespace mg_mock
+
+using namespace mg_mock;
+
+// Errors and strings
+
+MOCK_API GLenum glGetError() {
+    MOCK_RECORD(glGetError);
+    GLenum error = ctx().error;
+    ctx().error = GL_NO_ERROR;
+    return error;
+}
+
+MOCK_API const GLubyte* glGetString(GLenum name) {
+    MOCK_RECORD(glGetString, name);
+    Context& c = ctx();
+    switch (name) {
+    case GL_VENDOR:
+        return (const GLubyte*)"MobileGL-Dev";
+    case GL_RENDERER:
+        return (const GLubyte*)"MobileGlues Mock";
+    case GL_VERSION:
+        return (const GLubyte*)"OpenGL ES 3.2 Mock";
+    case GL_SHADING_LANGUAGE_VERSION:
+        return (const GLubyte*)"OpenGL ES GLSL ES 3.20";
+    case GL_EXTENSIONS:
+        if (c.extension_string.empty()) {
+            for (auto& e : c.extensions)
+                c.extension_string += e + " ";
+        }
+        return (const GLubyte*)c.extension_string.c_str();
+    default:
+        set_error(GL_INVALID_ENUM);
+        return nullptr;
+    }
+}
+
+MOCK_API const GLubyte* glGetStringi(GLenum name, GLuint index) {
+    MOCK_RECORD(glGetStringi, name, index);
+    if (name != GL_EXTENSIONS || index >= ctx().extensions.size()) {
+        set_error(GL_INVALID_VALUE);
+        return nullptr;
+    }
+    return (const GLubyte*)ctx().extensions[index].c_str();
+}
+
+MOCK_API void glGetIntegerv(GLenum pname, GLint* data) {
+    MOCK_RECORD(glGetIntegerv, pname, data);
+    get_integerv(pname, data);
+}
+
+MOCK_API void glGetInteger64v(GLenum pname, GLint64* data) {
+    MOCK_RECORD(glGetInteger64v, pname, data);
+    std::vector<double> v;
+    if (!query(pname, v)) return;
+    for (size_t i = 0; i < v.size(); ++i)
+        data[i] = (GLint64)v[i];
+}
+
+MOCK_API void glGetFloatv(GLenum pname, GLfloat* data) {
+    MOCK_RECORD(glGetFloatv, pname, data);
+    std::vector<double> v;
+    if (!query(pname, v)) return;
+    for (size_t i = 0; i < v.size(); ++i)
+        data[i] = (GLfloat)v[i];
+}
+
+MOCK_API void glGetBooleanv(GLenum pname, GLboolean* data) {
+    MOCK_RECORD(glGetBooleanv, pname, data);
+    std::vector<double> v;
+    if (!query(pname, v)) return;
+    for (size_t i = 0; i < v.size(); ++i)
+        data[i] = v[i] != 0.0 ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glGetIntegeri_v(GLenum target, GLuint index, GLint* data) {
+    MOCK_RECORD(glGetIntegeri_v, target, index, data);
+    auto find = [&](GLenum bind_target) -> IndexedBinding {
+        auto it = ctx().indexed_bindings.find({bind_target, index});
+        return it == ctx().indexed_bindings.end() ? IndexedBinding{} : it->second;
+    };
+    switch (target) {
+    case GL_UNIFORM_BUFFER_BINDING:
+        *data = (GLint)find(GL_UNIFORM_BUFFER).buffer;
+        return;
+    case GL_SHADER_STORAGE_BUFFER_BINDING:
+        *data = (GLint)find(GL_SHADER_STORAGE_BUFFER).buffer;
+        return;
+    case GL_TRANSFORM_FEEDBACK_BUFFER_BINDING:
+        *data = (GLint)find(GL_TRANSFORM_FEEDBACK_BUFFER).buffer;
+        return;
+    case GL_UNIFORM_BUFFER_START:
+        *data = (GLint)find(GL_UNIFORM_BUFFER).offset;
+        return;
+    case GL_UNIFORM_BUFFER_SIZE:
+        *data = (GLint)find(GL_UNIFORM_BUFFER).size;
+        return;
+    default:
+        set_error(GL_INVALID_ENUM);
+    }
+}
+
+MOCK_API GLboolean glIsEnabled(GLenum cap) {
+    MOCK_RECORD(glIsEnabled, cap);
+    return ctx().enabled.count(cap) ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glGetInternalformativ(GLenum target, GLenum internalformat, GLenum pname, GLsizei count,
+                                    GLint* params) {
+    MOCK_RECORD(glGetInternalformativ, target, internalformat, pname, count, params);
+    if (count < 1) return;
+    if (pname == GL_NUM_SAMPLE_COUNTS) {
+        *params = 1;
+    } else if (pname == GL_SAMPLES) {
+        *params = 4;
+    }
+}
+
+MOCK_API void glGetShaderPrecisionFormat(GLenum shadertype, GLenum precisiontype, GLint* range, GLint* precision) {
+    MOCK_RECORD(glGetShaderPrecisionFormat, shadertype, precisiontype, range, precision);
+    range[0] = 127;
+    range[1] = 127;
+    *precision = 23;
+}
+
+// Fixed function state
+
+MOCK_API void glEnable(GLenum cap) {
+    MOCK_RECORD(glEnable, cap);
+    ctx().enabled.insert(cap);
+}
+
+MOCK_API void glDisable(GLenum cap) {
+    MOCK_RECORD(glDisable, cap);
+    ctx().enabled.erase(cap);
+}
+
+MOCK_API void glEnablei(GLenum target, GLuint index) {
+    MOCK_RECORD(glEnablei, target, index);
+    if (index == 0) ctx().enabled.insert(target);
+}
+
+MOCK_API void glDisablei(GLenum target, GLuint index) {
+    MOCK_RECORD(glDisablei, target, index);
+    if (index == 0) ctx().enabled.erase(target);
+}
+
+MOCK_API void glBlendFunc(GLenum sfactor, GLenum dfactor) {
+    MOCK_RECORD(glBlendFunc, sfactor, dfactor);
+    Context& c = ctx();
+    c.blend_src_rgb = c.blend_src_alpha = sfactor;
+    c.blend_dst_rgb = c.blend_dst_alpha = dfactor;
+}
+
+MOCK_API void glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+    MOCK_RECORD(glBlendFuncSeparate, sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+    Context& c = ctx();
+    c.blend_src_rgb = sfactorRGB;
+    c.blend_dst_rgb = dfactorRGB;
+    c.blend_src_alpha = sfactorAlpha;
+    c.blend_dst_alpha = dfactorAlpha;
+}
+
+MOCK_API void glBlendFunci(GLuint buf, GLenum src, GLenum dst) {
+    MOCK_RECORD(glBlendFunci, buf, src, dst);
+    if (buf == 0) {
+        Context& c = ctx();
+        c.blend_src_rgb = c.blend_src_alpha = src;
+        c.blend_dst_rgb = c.blend_dst_alpha = dst;
+    }
+}
+
+MOCK_API void glBlendFuncSeparatei(GLuint buf, GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    MOCK_RECORD(glBlendFuncSeparatei, buf, srcRGB, dstRGB, srcAlpha, dstAlpha);
+    if (buf == 0) {
+        Context& c = ctx();
+        c.blend_src_rgb = srcRGB;
+        c.blend_dst_rgb = dstRGB;
+        c.blend_src_alpha = srcAlpha;
+        c.blend_dst_alpha = dstAlpha;
+    }
+}
+
+MOCK_API void glBlendEquation(GLenum mode) {
+    MOCK_RECORD(glBlendEquation, mode);
+    ctx().blend_eq_rgb = ctx().blend_eq_alpha = mode;
+}
+
+MOCK_API void glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+    MOCK_RECORD(glBlendEquationSeparate, modeRGB, modeAlpha);
+    ctx().blend_eq_rgb = modeRGB;
+    ctx().blend_eq_alpha = modeAlpha;
+}
+
+MOCK_API void glBlendEquationi(GLuint buf, GLenum mode) {
+    MOCK_RECORD(glBlendEquationi, buf, mode);
+    if (buf == 0) ctx().blend_eq_rgb = ctx().blend_eq_alpha = mode;
+}
+
+MOCK_API void glBlendEquationSeparatei(GLuint buf, GLenum modeRGB, GLenum modeAlpha) {
+    MOCK_RECORD(glBlendEquationSeparatei, buf, modeRGB, modeAlpha);
+    if (buf == 0) {
+        ctx().blend_eq_rgb = modeRGB;
+        ctx().blend_eq_alpha = modeAlpha;
+    }
+}
+
+MOCK_API void glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    MOCK_RECORD(glBlendColor, red, green, blue, alpha);
+    GLfloat color[4] = {red, green, blue, alpha};
+    memcpy(ctx().blend_color, color, sizeof(color));
+}
+
+MOCK_API void glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    MOCK_RECORD(glColorMask, red, green, blue, alpha);
+    GLboolean* m = ctx().color_mask;
+    m[0] = red ? GL_TRUE : GL_FALSE;
+    m[1] = green ? GL_TRUE : GL_FALSE;
+    m[2] = blue ? GL_TRUE : GL_FALSE;
+    m[3] = alpha ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glColorMaski(GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a) {
+    MOCK_RECORD(glColorMaski, index, r, g, b, a);
+    if (index != 0) return;
+    GLboolean* m = ctx().color_mask;
+    m[0] = r ? GL_TRUE : GL_FALSE;
+    m[1] = g ? GL_TRUE : GL_FALSE;
+    m[2] = b ? GL_TRUE : GL_FALSE;
+    m[3] = a ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glDepthFunc(GLenum func) {
+    MOCK_RECORD(glDepthFunc, func);
+    ctx().depth_func = func;
+}
+
+MOCK_API void glDepthMask(GLboolean flag) {
+    MOCK_RECORD(glDepthMask, flag);
+    ctx().depth_mask = flag ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glDepthRangef(GLfloat n, GLfloat f) {
+    MOCK_RECORD(glDepthRangef, n, f);
+    ctx().depth_range[0] = n;
+    ctx().depth_range[1] = f;
+}
+
+static void for_stencil_faces(GLenum face, void (*apply)(StencilFace&, const void*), const void* arg) {
+    if (face == GL_FRONT || face == GL_FRONT_AND_BACK) apply(ctx().stencil_front, arg);
+    if (face == GL_BACK || face == GL_FRONT_AND_BACK) apply(ctx().stencil_back, arg);
+}
+
+MOCK_API void glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+    MOCK_RECORD(glStencilFuncSeparate, face, func, ref, mask);
+    StencilFace value{func, ref, mask};
+    for_stencil_faces(
+        face,
+        [](StencilFace& f, const void* v) {
+            auto* s = (const StencilFace*)v;
+            f.func = s->func;
+            f.ref = s->ref;
+            f.value_mask = s->value_mask;
+        },
+        &value);
+}
+
+MOCK_API void glStencilFunc(GLenum func, GLint ref, GLuint mask) {
+    MOCK_RECORD(glStencilFunc, func, ref, mask);
+    bool was = g_recording;
+    g_recording = false;
+    glStencilFuncSeparate(GL_FRONT_AND_BACK, func, ref, mask);
+    g_recording = was;
+}
+
+MOCK_API void glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    MOCK_RECORD(glStencilOpSeparate, face, sfail, dpfail, dppass);
+    StencilFace value{};
+    value.fail = sfail;
+    value.zfail = dpfail;
+    value.zpass = dppass;
+    for_stencil_faces(
+        face,
+        [](StencilFace& f, const void* v) {
+            auto* s = (const StencilFace*)v;
+            f.fail = s->fail;
+            f.zfail = s->zfail;
+            f.zpass = s->zpass;
+        },
+        &value);
+}
+
+MOCK_API void glStencilOp(GLenum fail, GLenum zfail, GLenum zpass) {
+    MOCK_RECORD(glStencilOp, fail, zfail, zpass);
+    bool was = g_recording;
+    g_recording = false;
+    glStencilOpSeparate(GL_FRONT_AND_BACK, fail, zfail, zpass);
+    g_recording = was;
+}
+
+MOCK_API void glStencilMaskSeparate(GLenum face, GLuint mask) {
+    MOCK_RECORD(glStencilMaskSeparate, face, mask);
+    for_stencil_faces(
+        face, [](StencilFace& f, const void* v) { f.write_mask = *(const GLuint*)v; }, &mask);
+}
+
+MOCK_API void glStencilMask(GLuint mask) {
+    MOCK_RECORD(glStencilMask, mask);
+    bool was = g_recording;
+    g_recording = false;
+    glStencilMaskSeparate(GL_FRONT_AND_BACK, mask);
+    g_recording = was;
+}
+
+MOCK_API void glViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    MOCK_RECORD(glViewport, x, y, width, height);
+    if (width < 0 || height < 0) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    GLint* v = ctx().viewport;
+    v[0] = x, v[1] = y, v[2] = width, v[3] = height;
+}
+
+MOCK_API void glScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    MOCK_RECORD(glScissor, x, y, width, height);
+    if (width < 0 || height < 0) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    GLint* s = ctx().scissor;
+    s[0] = x, s[1] = y, s[2] = width, s[3] = height;
+}
+
+MOCK_API void glCullFace(GLenum mode) {
+    MOCK_RECORD(glCullFace, mode);
+    ctx().cull_face = mode;
+}
+
+MOCK_API void glFrontFace(GLenum mode) {
+    MOCK_RECORD(glFrontFace, mode);
+    ctx().front_face = mode;
+}
+
+MOCK_API void glPolygonOffset(GLfloat factor, GLfloat units) {
+    MOCK_RECORD(glPolygonOffset, factor, units);
+    ctx().polygon_offset[0] = factor;
+    ctx().polygon_offset[1] = units;
+}
+
+MOCK_API void glLineWidth(GLfloat width) {
+    MOCK_RECORD(glLineWidth, width);
+    ctx().line_width = width;
+}
+
+MOCK_API void glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    MOCK_RECORD(glClearColor, red, green, blue, alpha);
+    GLfloat color[4] = {red, green, blue, alpha};
+    memcpy(ctx().clear_color, color, sizeof(color));
+}
+
+MOCK_API void glClearDepthf(GLfloat d) {
+    MOCK_RECORD(glClearDepthf, d);
+    ctx().clear_depth = d;
+}
+
+MOCK_API void glClearStencil(GLint s) {
+    MOCK_RECORD(glClearStencil, s);
+    ctx().clear_stencil = s;
+}
+
+MOCK_API void glClear(GLbitfield mask) {
+    MOCK_RECORD(glClear, mask);
+    Context& c = ctx();
+    if (!(mask & GL_COLOR_BUFFER_BIT)) return;
+    uint8_t rgba[4];
+    for (int i = 0; i < 4; ++i)
+        rgba[i] = (uint8_t)(std::clamp(c.clear_color[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+    bool scissor = c.enabled.count(GL_SCISSOR_TEST);
+    for (Surface& s : draw_surfaces()) {
+        if (s.format != GL_RGBA || s.type != GL_UNSIGNED_BYTE) continue;
+        for (GLint y = 0; y < s.height; ++y) {
+            for (GLint x = 0; x < s.width; ++x) {
+                if (scissor && (x < c.scissor[0] || y < c.scissor[1] || x >= c.scissor[0] + c.scissor[2] ||
+                                y >= c.scissor[1] + c.scissor[3]))
+                    continue;
+                uint8_t* p = s.data + ((size_t)y * s.width + x) * 4;
+                for (int i = 0; i < 4; ++i) {
+                    if (c.color_mask[i]) p[i] = rgba[i];
+                }
+            }
+        }
+    }
+}
+
+MOCK_API void glPixelStorei(GLenum pname, GLint param) {
+    MOCK_RECORD(glPixelStorei, pname, param);
+    Context& c = ctx();
+    switch (pname) {
+    case GL_PACK_ALIGNMENT:
+        c.pack.alignment = param;
+        break;
+    case GL_PACK_ROW_LENGTH:
+        c.pack.row_length = param;
+        break;
+    case GL_PACK_SKIP_PIXELS:
+        c.pack.skip_pixels = param;
+        break;
+    case GL_PACK_SKIP_ROWS:
+        c.pack.skip_rows = param;
+        break;
+    case GL_UNPACK_ALIGNMENT:
+        c.unpack.alignment = param;
+        break;
+    case GL_UNPACK_ROW_LENGTH:
+        c.unpack.row_length = param;
+        break;
+    case GL_UNPACK_IMAGE_HEIGHT:
+        c.unpack.image_height = param;
+        break;
+    case GL_UNPACK_SKIP_PIXELS:
+        c.unpack.skip_pixels = param;
+        break;
+    case GL_UNPACK_SKIP_ROWS:
+        c.unpack.skip_rows = param;
+        break;
+    case GL_UNPACK_SKIP_IMAGES:
+        c.unpack.skip_images = param;
+        break;
+    default:
+        set_error(GL_INVALID_ENUM);
+    }
+}
+
+// Buffers
+
+MOCK_API void glGenBuffers(GLsizei n, GLuint* buffers) {
+    MOCK_RECORD(glGenBuffers, n, buffers);
+    for (GLsizei i = 0; i < n; ++i) {
+        buffers[i] = new_name();
+        ctx().buffers[buffers[i]];
+    }
+}
+
+MOCK_API void glDeleteBuffers(GLsizei n, const GLuint* buffers) {
+    MOCK_RECORD(glDeleteBuffers, n, buffers);
+    Context& c = ctx();
+    for (GLsizei i = 0; i < n; ++i) {
+        GLuint name = buffers[i];
+        if (!name) continue;
+        c.buffers.erase(name);
+        for (auto& [target, bound] : c.buffer_bindings) {
+            if (bound == name) bound = 0;
+        }
+        for (auto& [key, binding] : c.indexed_bindings) {
+            if (binding.buffer == name) binding = {};
+        }
+        for (auto& [id, vao] : c.vertex_arrays) {
+            if (vao.element_buffer == name) vao.element_buffer = 0;
+            for (auto& a : vao.attribs) {
+                if (a.buffer == name) a.buffer = 0;
+            }
+        }
+    }
+}
+
+MOCK_API GLboolean glIsBuffer(GLuint buffer) {
+    MOCK_RECORD(glIsBuffer, buffer);
+    return ctx().buffers.count(buffer) ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glBindBuffer(GLenum target, GLuint buffer) {
+    MOCK_RECORD(glBindBuffer, target, buffer);
+    Context& c = ctx();
+    if (buffer) c.buffers[buffer];
+    if (target == GL_ELEMENT_ARRAY_BUFFER)
+        c.vertex_arrays[c.vao].element_buffer = buffer;
+    else
+        c.buffer_bindings[target] = buffer;
+}
+
+// Indexed bindings also replace the generic binding point
+MOCK_API void glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    MOCK_RECORD(glBindBufferRange, target, index, buffer, offset, size);
+    Context& c = ctx();
+    if (buffer) c.buffers[buffer];
+    c.indexed_bindings[{target, index}] = {buffer, offset, size};
+    c.buffer_bindings[target] = buffer;
+}
+
+MOCK_API void glBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    MOCK_RECORD(glBindBufferBase, target, index, buffer);
+    Context& c = ctx();
+    if (buffer) c.buffers[buffer];
+    c.indexed_bindings[{target, index}] = {buffer, 0, 0};
+    c.buffer_bindings[target] = buffer;
+}
+
+MOCK_API void glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    MOCK_RECORD(glBufferData, target, size, data, usage);
+    Buffer* b = buffer_for(target);
+    if (!b || b->immutable) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    b->data.assign((size_t)size, 0);
+    if (data) memcpy(b->data.data(), data, size);
+    b->usage = usage;
+    b->mapped = false;
+}
+
+MOCK_API void glBufferStorageEXT(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
+    MOCK_RECORD(glBufferStorageEXT, target, size, data, flags);
+    Buffer* b = buffer_for(target);
+    if (!b || b->immutable) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    b->data.assign((size_t)size, 0);
+    if (data) memcpy(b->data.data(), data, size);
+    b->immutable = true;
+    b->storage_flags = flags;
+}
+
+MOCK_API void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    MOCK_RECORD(glBufferSubData, target, offset, size, data);
+    Buffer* b = buffer_for(target);
+    if (!b || offset < 0 || size < 0 || (size_t)(offset + size) > b->data.size() ||
+        (b->immutable && !(b->storage_flags & GL_DYNAMIC_STORAGE_BIT_EXT))) {
+        set_error(b ? GL_INVALID_VALUE : GL_INVALID_OPERATION);
+        return;
+    }
+    if (data) memcpy(b->data.data() + offset, data, size);
+}
+
+MOCK_API void* glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    MOCK_RECORD(glMapBufferRange, target, offset, length, access);
+    Buffer* b = buffer_for(target);
+    if (!b || b->mapped || offset < 0 || length <= 0 || (size_t)(offset + length) > b->data.size()) {
+        set_error(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+    b->mapped = true;
+    b->map_offset = offset;
+    b->map_length = length;
+    b->map_access = access;
+    return b->data.data() + offset;
+}
+
+MOCK_API GLboolean glUnmapBuffer(GLenum target) {
+    MOCK_RECORD(glUnmapBuffer, target);
+    Buffer* b = buffer_for(target);
+    if (!b || !b->mapped) {
+        set_error(GL_INVALID_OPERATION);
+        return GL_FALSE;
+    }
+    b->mapped = false;
+    return GL_TRUE;
+}
+
+MOCK_API void glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset,
+                                  GLsizeiptr size) {
+    MOCK_RECORD(glCopyBufferSubData, readTarget, writeTarget, readOffset, writeOffset, size);
+    Buffer* src = buffer_for(readTarget);
+    Buffer* dst = buffer_for(writeTarget);
+    if (!src || !dst || (size_t)(readOffset + size) > src->data.size() ||
+        (size_t)(writeOffset + size) > dst->data.size()) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    memmove(dst->data.data() + writeOffset, src->data.data() + readOffset, size);
+}
+
+MOCK_API void glGetBufferParameteriv(GLenum target, GLenum pname, GLint* params) {
+    MOCK_RECORD(glGetBufferParameteriv, target, pname, params);
+    Buffer* b = buffer_for(target);
+    if (!b) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    switch (pname) {
+    case GL_BUFFER_SIZE:
+        *params = (GLint)b->data.size();
+        break;
+    case GL_BUFFER_USAGE:
+        *params = (GLint)b->usage;
+        break;
+    case GL_BUFFER_MAPPED:
+        *params = b->mapped;
+        break;
+    case GL_BUFFER_ACCESS_FLAGS:
+        *params = (GLint)b->map_access;
+        break;
+    case GL_BUFFER_MAP_OFFSET:
+        *params = (GLint)b->map_offset;
+        break;
+    case GL_BUFFER_MAP_LENGTH:
+        *params = (GLint)b->map_length;
+        break;
+    default:
+        set_error(GL_INVALID_ENUM);
+    }
+}
+
+MOCK_API void glGetBufferParameteri64v(GLenum target, GLenum pname, GLint64* params) {
+    MOCK_RECORD(glGetBufferParameteri64v, target, pname, params);
+    bool was = g_recording;
+    g_recording = false;
+    GLint value = 0;
+    glGetBufferParameteriv(target, pname, &value);
+    *params = value;
+    g_recording = was;
+}
+
+MOCK_API void glGetBufferPointerv(GLenum target, GLenum pname, void** params) {
+    MOCK_RECORD(glGetBufferPointerv, target, pname, params);
+    Buffer* b = buffer_for(target);
+    *params = b && b->mapped ? b->data.data() + b->map_offset : nullptr;
+}
+
+// Textures
+
+MOCK_API void glGenTextures(GLsizei n, GLuint* textures) {
+    MOCK_RECORD(glGenTextures, n, textures);
+    for (GLsizei i = 0; i < n; ++i) {
+        textures[i] = new_name();
+        ctx().textures[textures[i]];
+    }
+}
+
+MOCK_API void glDeleteTextures(GLsizei n, const GLuint* textures) {
+    MOCK_RECORD(glDeleteTextures, n, textures);
+    Context& c = ctx();
+    for (GLsizei i = 0; i < n; ++i) {
+        GLuint name = textures[i];
+        if (!name) continue;
+        c.textures.erase(name);
+        for (auto& unit : c.texture_units) {
+            for (auto& [target, bound] : unit) {
+                if (bound == name) bound = 0;
+            }
+        }
+        for (auto& [id, fbo] : c.framebuffers) {
+            for (auto& [point, a] : fbo.attachments) {
+                if (a.type == GL_TEXTURE && a.name == name) a = {};
+            }
+        }
+    }
+}
+
+MOCK_API GLboolean glIsTexture(GLuint texture) {
+    MOCK_RECORD(glIsTexture, texture);
+    return ctx().textures.count(texture) ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glActiveTexture(GLenum texture) {
+    MOCK_RECORD(glActiveTexture, texture);
+    GLuint unit = texture - GL_TEXTURE0;
+    if (unit >= MOCK_MAX_TEXTURE_UNITS) {
+        set_error(GL_INVALID_ENUM);
+        return;
+    }
+    ctx().active_unit = unit;
+}
+
+MOCK_API void glBindTexture(GLenum target, GLuint texture) {
+    MOCK_RECORD(glBindTexture, target, texture);
+    Context& c = ctx();
+    if (texture) {
+        Texture& tex = c.textures[texture];
+        if (!tex.target) tex.target = target;
+        if (tex.target != target) {
+            set_error(GL_INVALID_OPERATION);
+            return;
+        }
+    }
+    c.texture_units[c.active_unit][target] = texture;
+}
+
+MOCK_API void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                           GLint border, GLenum format, GLenum type, const void* pixels) {
+    MOCK_RECORD(glTexImage2D, target, level, internalformat, width, height, border, format, type, pixels);
+    if (!bound_texture(target)) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    TexLevel& l = define_level(target, level, internalformat, width, height, 1, format, type);
+    if (pixels || bound_buffer(GL_PIXEL_UNPACK_BUFFER)) unpack_into(l, 0, 0, 0, width, height, 1, format, type, pixels);
+}
+
+MOCK_API void glTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                           GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels) {
+    MOCK_RECORD(glTexImage3D, target, level, internalformat, width, height, depth, border, format, type, pixels);
+    if (!bound_texture(target)) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    TexLevel& l = define_level(target, level, internalformat, width, height, depth, format, type);
+    if (pixels || bound_buffer(GL_PIXEL_UNPACK_BUFFER))
+        unpack_into(l, 0, 0, 0, width, height, depth, format, type, pixels);
+}
+
+MOCK_API void glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                              GLsizei height, GLenum format, GLenum type, const void* pixels) {
+    MOCK_RECORD(glTexSubImage2D, target, level, xoffset, yoffset, width, height, format, type, pixels);
+    TexLevel* l = texture_level_for(target, level);
+    if (!l) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    unpack_into(*l, xoffset, yoffset, 0, width, height, 1, format, type, pixels);
+}
+
+MOCK_API void glTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+                              GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type,
+                              const void* pixels) {
+    MOCK_RECORD(glTexSubImage3D, target, level, xoffset, yoffset, zoffset, width, height, depth, format, type,
+                pixels);
+    TexLevel* l = texture_level_for(target, level);
+    if (!l) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    unpack_into(*l, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+}
+
+static void tex_storage(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height,
+                        GLsizei depth) {
+    GLuint name = bound_texture(target);
+    if (!name || ctx().textures[name].immutable) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    GLenum format, type;
+    sized_format(internalformat, format, type);
+    bool cube = target == GL_TEXTURE_CUBE_MAP;
+    for (GLsizei i = 0; i < levels; ++i) {
+        GLsizei w = std::max(width >> i, 1), h = std::max(height >> i, 1);
+        GLsizei d = target == GL_TEXTURE_3D ? std::max(depth >> i, 1) : depth;
+        if (cube) {
+            for (GLenum face = GL_TEXTURE_CUBE_MAP_POSITIVE_X; face <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z; ++face)
+                define_level(face, i, internalformat, w, h, 1, format, type);
+        } else {
+            define_level(target, i, internalformat, w, h, d, format, type);
+        }
+    }
+    Texture& tex = ctx().textures[name];
+    tex.immutable = true;
+    tex.immutable_levels = levels;
+}
+
+MOCK_API void glTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height) {
+    MOCK_RECORD(glTexStorage2D, target, levels, internalformat, width, height);
+    tex_storage(target, levels, internalformat, width, height, 1);
+}
+
+MOCK_API void glTexStorage3D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height,
+                             GLsizei depth) {
+    MOCK_RECORD(glTexStorage3D, target, levels, internalformat, width, height, depth);
+    tex_storage(target, levels, internalformat, width, height, depth);
+}
+
+MOCK_API void glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                     GLsizei height, GLint border, GLsizei imageSize, const void* data) {
+    MOCK_RECORD(glCompressedTexImage2D, target, level, internalformat, width, height, border, imageSize, data);
+    if (!bound_texture(target)) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    TexLevel& l = define_level(target, level, internalformat, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+    l.compressed = true;
+    const uint8_t* src = resolve_pixels(GL_PIXEL_UNPACK_BUFFER, data);
+    l.data.assign(src, src ? src + imageSize : src);
+}
+
+MOCK_API void glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width,
+                               GLsizei height, GLint border) {
+    MOCK_RECORD(glCopyTexImage2D, target, level, internalformat, x, y, width, height, border);
+    if (!bound_texture(target)) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    Surface src = read_surface();
+    TexLevel& l = define_level(target, level, internalformat, width, height, 1, src.format, src.type);
+    copy_from_read(l, 0, 0, 0, x, y, width, height);
+}
+
+MOCK_API void glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y,
+                                  GLsizei width, GLsizei height) {
+    MOCK_RECORD(glCopyTexSubImage2D, target, level, xoffset, yoffset, x, y, width, height);
+    TexLevel* l = texture_level_for(target, level);
+    if (!l) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    copy_from_read(*l, xoffset, yoffset, 0, x, y, width, height);
+}
+
+MOCK_API void glCopyTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x,
+                                  GLint y, GLsizei width, GLsizei height) {
+    MOCK_RECORD(glCopyTexSubImage3D, target, level, xoffset, yoffset, zoffset, x, y, width, height);
+    TexLevel* l = texture_level_for(target, level);
+    if (!l) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    copy_from_read(*l, xoffset, yoffset, zoffset, x, y, width, height);
+}
+
+static void tex_parameter(GLenum target, GLenum pname, GLint value) {
+    GLuint name = bound_texture(target);
+    if (!name) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    ctx().textures[name].params[pname] = value;
+}
+
+MOCK_API void glTexParameteri(GLenum target, GLenum pname, GLint param) {
+    MOCK_RECORD(glTexParameteri, target, pname, param);
+    tex_parameter(target, pname, param);
+}
+
+MOCK_API void glTexParameterf(GLenum target, GLenum pname, GLfloat param) {
+    MOCK_RECORD(glTexParameterf, target, pname, param);
+    tex_parameter(target, pname, (GLint)param);
+}
+
+MOCK_API void glTexParameteriv(GLenum target, GLenum pname, const GLint* params) {
+    MOCK_RECORD(glTexParameteriv, target, pname, params);
+    tex_parameter(target, pname, params[0]);
+}
+
+MOCK_API void glTexParameterfv(GLenum target, GLenum pname, const GLfloat* params) {
+    MOCK_RECORD(glTexParameterfv, target, pname, params);
+    tex_parameter(target, pname, (GLint)params[0]);
+}
+
+static GLint get_tex_parameter(GLenum target, GLenum pname) {
+    GLuint name = bound_texture(target);
+    Texture& tex = ctx().textures[name];
+    if (pname == GL_TEXTURE_IMMUTABLE_FORMAT) return tex.immutable;
+    if (pname == GL_TEXTURE_IMMUTABLE_LEVELS) return tex.immutable_levels;
+    auto it = tex.params.find(pname);
+    if (it != tex.params.end()) return it->second;
+    switch (pname) {
+    case GL_TEXTURE_MIN_FILTER:
+        return GL_NEAREST_MIPMAP_LINEAR;
+    case GL_TEXTURE_MAG_FILTER:
+        return GL_LINEAR;
+    case GL_TEXTURE_WRAP_S:
+    case GL_TEXTURE_WRAP_T:
+    case GL_TEXTURE_WRAP_R:
+        return GL_REPEAT;
+    case GL_TEXTURE_MAX_LEVEL:
+        return 1000;
+    case GL_TEXTURE_MAX_LOD:
+        return 1000;
+    case GL_TEXTURE_MIN_LOD:
+        return -1000;
+    case GL_TEXTURE_SWIZZLE_R:
+        return GL_RED;
+    case GL_TEXTURE_SWIZZLE_G:
+        return GL_GREEN;
+    case GL_TEXTURE_SWIZZLE_B:
+        return GL_BLUE;
+    case GL_TEXTURE_SWIZZLE_A:
+        return GL_ALPHA;
+    default:
+        return 0;
+    }
+}
+
+MOCK_API void glGetTexParameteriv(GLenum target, GLenum pname, GLint* params) {
+    MOCK_RECORD(glGetTexParameteriv, target, pname, params);
+    *params = get_tex_parameter(target, pname);
+}
+
+MOCK_API void glGetTexParameterfv(GLenum target, GLenum pname, GLfloat* params) {
+    MOCK_RECORD(glGetTexParameterfv, target, pname, params);
+    *params = (GLfloat)get_tex_parameter(target, pname);
+}
+
+MOCK_API void glGetTexLevelParameteriv(GLenum target, GLint level, GLenum pname, GLint* params) {
+    MOCK_RECORD(glGetTexLevelParameteriv, target, level, pname, params);
+    TexLevel* l = texture_level_for(target, level);
+    *params = 0;
+    if (!l) return;
+    switch (pname) {
+    case GL_TEXTURE_WIDTH:
+        *params = l->width;
+        break;
+    case GL_TEXTURE_HEIGHT:
+        *params = l->height;
+        break;
+    case GL_TEXTURE_DEPTH:
+        *params = l->depth;
+        break;
+    case GL_TEXTURE_INTERNAL_FORMAT:
+        *params = (GLint)l->internalformat;
+        break;
+    case GL_TEXTURE_COMPRESSED:
+        *params = l->compressed;
+        break;
+    default:
+        break;
+    }
+}
+
+MOCK_API void glGetTexLevelParameterfv(GLenum target, GLint level, GLenum pname, GLfloat* params) {
+    MOCK_RECORD(glGetTexLevelParameterfv, target, level, pname, params);
+    bool was = g_recording;
+    g_recording = false;
+    GLint value;
+    glGetTexLevelParameteriv(target, level, pname, &value);
+    *params = (GLfloat)value;
+    g_recording = was;
+}
+
+MOCK_API void glGenerateMipmap(GLenum target) {
+    MOCK_RECORD(glGenerateMipmap, target);
+    TexLevel* base = texture_level_for(target, 0);
+    if (!base) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    TexLevel copy = *base;
+    for (GLint level = 1; copy.width > 1 || copy.height > 1; ++level) {
+        copy.width = std::max(copy.width / 2, 1);
+        copy.height = std::max(copy.height / 2, 1);
+        if (!texture_level_for(target, level))
+            define_level(target, level, copy.internalformat, copy.width, copy.height, copy.depth, copy.format,
+                         copy.type);
+    }
+}
+
+MOCK_API void glBindSampler(GLuint unit, GLuint sampler) {
+    MOCK_RECORD(glBindSampler, unit, sampler);
+    if (unit < MOCK_MAX_TEXTURE_UNITS) ctx().sampler_units[unit] = sampler;
+}
+
+MOCK_API void glGenSamplers(GLsizei count, GLuint* samplers) {
+    MOCK_RECORD(glGenSamplers, count, samplers);
+    for (GLsizei i = 0; i < count; ++i) {
+        samplers[i] = new_name();
+        ctx().samplers.insert(samplers[i]);
+    }
+}
+
+MOCK_API void glDeleteSamplers(GLsizei count, const GLuint* samplers) {
+    MOCK_RECORD(glDeleteSamplers, count, samplers);
+    for (GLsizei i = 0; i < count; ++i)
+        ctx().samplers.erase(samplers[i]);
+}
+
+// Framebuffers
+
+MOCK_API void glGenFramebuffers(GLsizei n, GLuint* framebuffers) {
+    MOCK_RECORD(glGenFramebuffers, n, framebuffers);
+    for (GLsizei i = 0; i < n; ++i) {
+        framebuffers[i] = new_name();
+        ctx().framebuffers[framebuffers[i]];
+    }
+}
+
+MOCK_API void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    MOCK_RECORD(glDeleteFramebuffers, n, framebuffers);
+    Context& c = ctx();
+    for (GLsizei i = 0; i < n; ++i) {
+        GLuint name = framebuffers[i];
+        if (!name) continue;
+        c.framebuffers.erase(name);
+        if (c.draw_fbo == name) c.draw_fbo = 0;
+        if (c.read_fbo == name) c.read_fbo = 0;
+    }
+}
+
+MOCK_API GLboolean glIsFramebuffer(GLuint framebuffer) {
+    MOCK_RECORD(glIsFramebuffer, framebuffer);
+    return ctx().framebuffers.count(framebuffer) ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glBindFramebuffer(GLenum target, GLuint framebuffer) {
+    MOCK_RECORD(glBindFramebuffer, target, framebuffer);
+    Context& c = ctx();
+    if (framebuffer) c.framebuffers[framebuffer];
+    if (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER) c.draw_fbo = framebuffer;
+    if (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER) c.read_fbo = framebuffer;
+}
+
+static Framebuffer* target_framebuffer(GLenum target) {
+    Context& c = ctx();
+    GLuint name = target == GL_READ_FRAMEBUFFER ? c.read_fbo : c.draw_fbo;
+    if (!name) {
+        set_error(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+    return &c.framebuffers[name];
+}
+
+static void attach(GLenum target, GLenum attachment, const Attachment& a) {
+    Framebuffer* fbo = target_framebuffer(target);
+    if (!fbo) return;
+    if (attachment == GL_DEPTH_STENCIL_ATTACHMENT) {
+        fbo->attachments[GL_DEPTH_ATTACHMENT] = a;
+        fbo->attachments[GL_STENCIL_ATTACHMENT] = a;
+        return;
+    }
+    fbo->attachments[attachment] = a;
+}
+
+MOCK_API void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture,
+                                     GLint level) {
+    MOCK_RECORD(glFramebufferTexture2D, target, attachment, textarget, texture, level);
+    attach(target, attachment,
+           texture ? Attachment{GL_TEXTURE, texture, level, 0, textarget} : Attachment{GL_NONE, 0, 0, 0, 0});
+}
+
+MOCK_API void glFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level,
+                                        GLint layer) {
+    MOCK_RECORD(glFramebufferTextureLayer, target, attachment, texture, level, layer);
+    attach(target, attachment,
+           texture ? Attachment{GL_TEXTURE, texture, level, layer, 0} : Attachment{GL_NONE, 0, 0, 0, 0});
+}
+
+MOCK_API void glFramebufferTexture(GLenum target, GLenum attachment, GLuint texture, GLint level) {
+    MOCK_RECORD(glFramebufferTexture, target, attachment, texture, level);
+    attach(target, attachment,
+           texture ? Attachment{GL_TEXTURE, texture, level, 0, 0} : Attachment{GL_NONE, 0, 0, 0, 0});
+}
+
+MOCK_API void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget,
+                                        GLuint renderbuffer) {
+    MOCK_RECORD(glFramebufferRenderbuffer, target, attachment, renderbuffertarget, renderbuffer);
+    attach(target, attachment,
+           renderbuffer ? Attachment{GL_RENDERBUFFER, renderbuffer, 0, 0, 0} : Attachment{GL_NONE, 0, 0, 0, 0});
+}
+
+MOCK_API void glDrawBuffers(GLsizei n, const GLenum* bufs) {
+    MOCK_RECORD(glDrawBuffers, n, bufs);
+    Context& c = ctx();
+    if (n < 0 || n > MOCK_MAX_DRAW_BUFFERS) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    if (!c.draw_fbo) return;
+    c.framebuffers[c.draw_fbo].draw_buffers.assign(bufs, bufs + n);
+}
+
+MOCK_API void glReadBuffer(GLenum src) {
+    MOCK_RECORD(glReadBuffer, src);
+    Context& c = ctx();
+    if (c.read_fbo) c.framebuffers[c.read_fbo].read_buffer = src;
+}
+
+MOCK_API GLenum glCheckFramebufferStatus(GLenum target) {
+    MOCK_RECORD(glCheckFramebufferStatus, target);
+    Context& c = ctx();
+    GLuint name = target == GL_READ_FRAMEBUFFER ? c.read_fbo : c.draw_fbo;
+    if (!name) return GL_FRAMEBUFFER_COMPLETE;
+    for (auto& [point, a] : c.framebuffers[name].attachments) {
+        if (a.type != GL_NONE) return GL_FRAMEBUFFER_COMPLETE;
+    }
+    return GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT;
+}
+
+MOCK_API void glGetFramebufferAttachmentParameteriv(GLenum target, GLenum attachment, GLenum pname,
+                                                    GLint* params) {
+    MOCK_RECORD(glGetFramebufferAttachmentParameteriv, target, attachment, pname, params);
+    Framebuffer* fbo = target_framebuffer(target);
+    if (!fbo) return;
+    Attachment a = fbo->attachments[attachment];
+    switch (pname) {
+    case GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE:
+        *params = (GLint)a.type;
+        break;
+    case GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME:
+        *params = (GLint)a.name;
+        break;
+    case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL:
+        *params = a.level;
+        break;
+    case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER:
+        *params = a.layer;
+        break;
+    case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE:
+        *params = (GLint)a.textarget;
+        break;
+    default:
+        *params = 0;
+    }
+}
+
+MOCK_API void glGenRenderbuffers(GLsizei n, GLuint* renderbuffers) {
+    MOCK_RECORD(glGenRenderbuffers, n, renderbuffers);
+    for (GLsizei i = 0; i < n; ++i) {
+        renderbuffers[i] = new_name();
+        ctx().renderbuffers[renderbuffers[i]];
+    }
+}
+
+MOCK_API void glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
+    MOCK_RECORD(glDeleteRenderbuffers, n, renderbuffers);
+    Context& c = ctx();
+    for (GLsizei i = 0; i < n; ++i) {
+        c.renderbuffers.erase(renderbuffers[i]);
+        if (c.renderbuffer == renderbuffers[i]) c.renderbuffer = 0;
+    }
+}
+
+MOCK_API void glBindRenderbuffer(GLenum target, GLuint renderbuffer) {
+    MOCK_RECORD(glBindRenderbuffer, target, renderbuffer);
+    if (renderbuffer) ctx().renderbuffers[renderbuffer];
+    ctx().renderbuffer = renderbuffer;
+}
+
+MOCK_API void glRenderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum internalformat,
+                                               GLsizei width, GLsizei height) {
+    MOCK_RECORD(glRenderbufferStorageMultisample, target, samples, internalformat, width, height);
+    Context& c = ctx();
+    if (!c.renderbuffer) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    Renderbuffer& rb = c.renderbuffers[c.renderbuffer];
+    rb.samples = samples;
+    TexLevel& l = rb.storage;
+    sized_format(internalformat, l.format, l.type);
+    l.internalformat = internalformat;
+    l.width = width;
+    l.height = height;
+    l.depth = 1;
+    l.data.assign((size_t)pixel_size(l.format, l.type) * width * height, 0);
+}
+
+MOCK_API void glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+    MOCK_RECORD(glRenderbufferStorage, target, internalformat, width, height);
+    bool was = g_recording;
+    g_recording = false;
+    glRenderbufferStorageMultisample(target, 0, internalformat, width, height);
+    g_recording = was;
+}
+
+MOCK_API void glGetRenderbufferParameteriv(GLenum target, GLenum pname, GLint* params) {
+    MOCK_RECORD(glGetRenderbufferParameteriv, target, pname, params);
+    Renderbuffer& rb = ctx().renderbuffers[ctx().renderbuffer];
+    switch (pname) {
+    case GL_RENDERBUFFER_WIDTH:
+        *params = rb.storage.width;
+        break;
+    case GL_RENDERBUFFER_HEIGHT:
+        *params = rb.storage.height;
+        break;
+    case GL_RENDERBUFFER_INTERNAL_FORMAT:
+        *params = (GLint)rb.storage.internalformat;
+        break;
+    case GL_RENDERBUFFER_SAMPLES:
+        *params = rb.samples;
+        break;
+    default:
+        *params = 0;
+    }
+}
+
+// Nearest-neighbour color blit between surfaces with the same texel size
+MOCK_API void glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0,
+                                GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
+    MOCK_RECORD(glBlitFramebuffer, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    if (!(mask & GL_COLOR_BUFFER_BIT)) return;
+    Surface src = read_surface();
+    if (!src.data) return;
+    size_t ps = pixel_size(src.format, src.type);
+    GLint dw = dstX1 - dstX0, dh = dstY1 - dstY0;
+    if (!dw || !dh) return;
+    for (Surface& dst : draw_surfaces()) {
+        if ((size_t)pixel_size(dst.format, dst.type) != ps) continue;
+        for (GLint y = std::min(dstY0, dstY1); y < std::max(dstY0, dstY1); ++y) {
+            if (y < 0 || y >= dst.height) continue;
+            GLint sy = srcY0 + (GLint)((y - dstY0 + 0.5) * (srcY1 - srcY0) / dh);
+            for (GLint x = std::min(dstX0, dstX1); x < std::max(dstX0, dstX1); ++x) {
+                if (x < 0 || x >= dst.width) continue;
+                GLint sx = srcX0 + (GLint)((x - dstX0 + 0.5) * (srcX1 - srcX0) / dw);
+                if (sx < 0 || sy < 0 || sx >= src.width || sy >= src.height) continue;
+                memcpy(dst.data + ((size_t)y * dst.width + x) * ps, src.data + ((size_t)sy * src.width + sx) * ps,
+                       ps);
+            }
+        }
+    }
+}
+
+MOCK_API void glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type,
+                           void* pixels) {
+    MOCK_RECORD(glReadPixels, x, y, width, height, format, type, pixels);
+    Surface src = read_surface();
+    if (!src.data) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    uint8_t* dst = resolve_pixels(GL_PIXEL_PACK_BUFFER, pixels);
+    if (!dst) return;
+    ImageLayout out = image_layout(ctx().pack, format, type, width, height);
+    size_t ps = pixel_size(src.format, src.type);
+    bool same = ps == out.pixel;
+    for (GLsizei j = 0; j < height; ++j) {
+        for (GLsizei i = 0; i < width; ++i) {
+            uint8_t* d = dst + out.start + j * out.row + i * out.pixel;
+            GLint sx = x + i, sy = y + j;
+            if (!same || sx < 0 || sy < 0 || sx >= src.width || sy >= src.height) {
+                memset(d, 0, out.pixel);
+                continue;
+            }
+            memcpy(d, src.data + ((size_t)sy * src.width + sx) * ps, ps);
+        }
+    }
+}
+
+// Vertex arrays
+
+MOCK_API void glGenVertexArrays(GLsizei n, GLuint* arrays) {
+    MOCK_RECORD(glGenVertexArrays, n, arrays);
+    for (GLsizei i = 0; i < n; ++i) {
+        arrays[i] = new_name();
+        ctx().vertex_arrays[arrays[i]];
+    }
+}
+
+MOCK_API void glDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    MOCK_RECORD(glDeleteVertexArrays, n, arrays);
+    Context& c = ctx();
+    for (GLsizei i = 0; i < n; ++i) {
+        if (!arrays[i]) continue;
+        c.vertex_arrays.erase(arrays[i]);
+        if (c.vao == arrays[i]) c.vao = 0;
+    }
+}
+
+MOCK_API GLboolean glIsVertexArray(GLuint array) {
+    MOCK_RECORD(glIsVertexArray, array);
+    return array && ctx().vertex_arrays.count(array) ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glBindVertexArray(GLuint array) {
+    MOCK_RECORD(glBindVertexArray, array);
+    ctx().vertex_arrays[array];
+    ctx().vao = array;
+}
+
+static VertexAttrib* attrib(GLuint index) {
+    if (index >= MOCK_MAX_VERTEX_ATTRIBS) {
+        set_error(GL_INVALID_VALUE);
+        return nullptr;
+    }
+    Context& c = ctx();
+    return &c.vertex_arrays[c.vao].attribs[index];
+}
+
+MOCK_API void glEnableVertexAttribArray(GLuint index) {
+    MOCK_RECORD(glEnableVertexAttribArray, index);
+    if (VertexAttrib* a = attrib(index)) a->enabled = true;
+}
+
+MOCK_API void glDisableVertexAttribArray(GLuint index) {
+    MOCK_RECORD(glDisableVertexAttribArray, index);
+    if (VertexAttrib* a = attrib(index)) a->enabled = false;
+}
+
+MOCK_API void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
+                                    const void* pointer) {
+    MOCK_RECORD(glVertexAttribPointer, index, size, type, normalized, stride, pointer);
+    VertexAttrib* a = attrib(index);
+    if (!a) return;
+    a->size = size;
+    a->type = type;
+    a->normalized = normalized;
+    a->integer = false;
+    a->stride = stride;
+    a->pointer = (uintptr_t)pointer;
+    a->buffer = bound_buffer(GL_ARRAY_BUFFER);
+}
+
+MOCK_API void glVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer) {
+    MOCK_RECORD(glVertexAttribIPointer, index, size, type, stride, pointer);
+    VertexAttrib* a = attrib(index);
+    if (!a) return;
+    a->size = size;
+    a->type = type;
+    a->normalized = GL_FALSE;
+    a->integer = true;
+    a->stride = stride;
+    a->pointer = (uintptr_t)pointer;
+    a->buffer = bound_buffer(GL_ARRAY_BUFFER);
+}
+
+MOCK_API void glVertexAttribDivisor(GLuint index, GLuint divisor) {
+    MOCK_RECORD(glVertexAttribDivisor, index, divisor);
+    if (VertexAttrib* a = attrib(index)) a->divisor = divisor;
+}
+
+MOCK_API void glVertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+    MOCK_RECORD(glVertexAttrib4f, index, x, y, z, w);
+    if (index >= MOCK_MAX_VERTEX_ATTRIBS) return;
+    GLfloat v[4] = {x, y, z, w};
+    memcpy(ctx().vertex_attrib_values[index], v, sizeof(v));
+}
+
+MOCK_API void glVertexAttrib4fv(GLuint index, const GLfloat* v) {
+    MOCK_RECORD(glVertexAttrib4fv, index, v);
+    if (index < MOCK_MAX_VERTEX_ATTRIBS) memcpy(ctx().vertex_attrib_values[index], v, 4 * sizeof(GLfloat));
+}
+
+MOCK_API void glVertexAttrib3fv(GLuint index, const GLfloat* v) {
+    MOCK_RECORD(glVertexAttrib3fv, index, v);
+    if (index >= MOCK_MAX_VERTEX_ATTRIBS) return;
+    GLfloat values[4] = {v[0], v[1], v[2], 1.0f};
+    memcpy(ctx().vertex_attrib_values[index], values, sizeof(values));
+}
+
+MOCK_API void glGetVertexAttribiv(GLuint index, GLenum pname, GLint* params) {
+    MOCK_RECORD(glGetVertexAttribiv, index, pname, params);
+    VertexAttrib* a = attrib(index);
+    if (!a) return;
+    switch (pname) {
+    case GL_VERTEX_ATTRIB_ARRAY_ENABLED:
+        *params = a->enabled;
+        break;
+    case GL_VERTEX_ATTRIB_ARRAY_SIZE:
+        *params = a->size;
+        break;
+    case GL_VERTEX_ATTRIB_ARRAY_TYPE:
+        *params = (GLint)a->type;
+        break;
+    case GL_VERTEX_ATTRIB_ARRAY_NORMALIZED:
+        *params = a->normalized;
+        break;
+    case GL_VERTEX_ATTRIB_ARRAY_INTEGER:
+        *params = a->integer;
+        break;
+    case GL_VERTEX_ATTRIB_ARRAY_STRIDE:
+        *params = a->stride;
+        break;
+    case GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING:
+        *params = (GLint)a->buffer;
+        break;
+    case GL_VERTEX_ATTRIB_ARRAY_DIVISOR:
+        *params = (GLint)a->divisor;
+        break;
+    default:
+        *params = 0;
+    }
+}
+
+MOCK_API void glGetVertexAttribfv(GLuint index, GLenum pname, GLfloat* params) {
+    MOCK_RECORD(glGetVertexAttribfv, index, pname, params);
+    if (pname == GL_CURRENT_VERTEX_ATTRIB && index < MOCK_MAX_VERTEX_ATTRIBS) {
+        memcpy(params, ctx().vertex_attrib_values[index], 4 * sizeof(GLfloat));
+        return;
+    }
+    GLint value = 0;
+    glGetVertexAttribiv(index, pname, &value);
+    *params = (GLfloat)value;
+}
+
+MOCK_API void glGetVertexAttribPointerv(GLuint index, GLenum pname, void** pointer) {
+    MOCK_RECORD(glGetVertexAttribPointerv, index, pname, pointer);
+    VertexAttrib* a = attrib(index);
+    *pointer = a ? (void*)a->pointer : nullptr;
+}
+
+// Draws
+
+MOCK_API void glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    MOCK_RECORD(glDrawArrays, mode, first, count);
+    capture_draw("glDrawArrays", mode, first, count, 1, 0, nullptr, 0);
+}
+
+MOCK_API void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {
+    MOCK_RECORD(glDrawArraysInstanced, mode, first, count, instancecount);
+    capture_draw("glDrawArraysInstanced", mode, first, count, instancecount, 0, nullptr, 0);
+}
+
+MOCK_API void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    MOCK_RECORD(glDrawElements, mode, count, type, indices);
+    capture_draw("glDrawElements", mode, 0, count, 1, type, indices, 0);
+}
+
+MOCK_API void glDrawRangeElements(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type,
+                                  const void* indices) {
+    MOCK_RECORD(glDrawRangeElements, mode, start, end, count, type, indices);
+    capture_draw("glDrawRangeElements", mode, 0, count, 1, type, indices, 0);
+}
+
+MOCK_API void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices,
+                                      GLsizei instancecount) {
+    MOCK_RECORD(glDrawElementsInstanced, mode, count, type, indices, instancecount);
+    capture_draw("glDrawElementsInstanced", mode, 0, count, instancecount, type, indices, 0);
+}
+
+MOCK_API void glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices,
+                                       GLint basevertex) {
+    MOCK_RECORD(glDrawElementsBaseVertex, mode, count, type, indices, basevertex);
+    capture_draw("glDrawElementsBaseVertex", mode, 0, count, 1, type, indices, basevertex);
+}
+
+MOCK_API void glDrawRangeElementsBaseVertex(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type,
+                                            const void* indices, GLint basevertex) {
+    MOCK_RECORD(glDrawRangeElementsBaseVertex, mode, start, end, count, type, indices, basevertex);
+    capture_draw("glDrawRangeElementsBaseVertex", mode, 0, count, 1, type, indices, basevertex);
+}
+
+MOCK_API void glDrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices,
+                                                GLsizei instancecount, GLint basevertex) {
+    MOCK_RECORD(glDrawElementsInstancedBaseVertex, mode, count, type, indices, instancecount, basevertex);
+    capture_draw("glDrawElementsInstancedBaseVertex", mode, 0, count, instancecount, type, indices, basevertex);
+}
+
+struct DrawArraysCommand {
+    GLuint count, instanceCount, first, baseInstance;
+};
+
+struct DrawElementsCommand {
+    GLuint count, instanceCount, firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+static const uint8_t* indirect_commands(const void* indirect) {
+    Buffer* b = buffer_for(GL_DRAW_INDIRECT_BUFFER);
+    return b ? b->data.data() + (uintptr_t)indirect : (const uint8_t*)indirect;
+}
+
+static void draw_arrays_indirect(const char* name, GLenum mode, const void* indirect, GLsizei drawcount,
+                                 GLsizei stride) {
+    const uint8_t* p = indirect_commands(indirect);
+    if (!p) return;
+    for (GLsizei i = 0; i < drawcount; ++i) {
+        DrawArraysCommand cmd;
+        memcpy(&cmd, p + (size_t)i * (stride ? stride : sizeof(cmd)), sizeof(cmd));
+        capture_draw(name, mode, (GLint)cmd.first, (GLsizei)cmd.count, (GLsizei)cmd.instanceCount, 0, nullptr, 0);
+    }
+}
+
+static void draw_elements_indirect(const char* name, GLenum mode, GLenum type, const void* indirect,
+                                   GLsizei drawcount, GLsizei stride) {
+    const uint8_t* p = indirect_commands(indirect);
+    if (!p) return;
+    for (GLsizei i = 0; i < drawcount; ++i) {
+        DrawElementsCommand cmd;
+        memcpy(&cmd, p + (size_t)i * (stride ? stride : sizeof(cmd)), sizeof(cmd));
+        capture_draw(name, mode, 0, (GLsizei)cmd.count, (GLsizei)cmd.instanceCount, type,
+                     (const void*)(uintptr_t)(cmd.firstIndex * index_size(type)), cmd.baseVertex);
+    }
+}
+
+MOCK_API void glDrawArraysIndirect(GLenum mode, const void* indirect) {
+    MOCK_RECORD(glDrawArraysIndirect, mode, indirect);
+    draw_arrays_indirect("glDrawArraysIndirect", mode, indirect, 1, 0);
+}
+
+MOCK_API void glDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect) {
+    MOCK_RECORD(glDrawElementsIndirect, mode, type, indirect);
+    draw_elements_indirect("glDrawElementsIndirect", mode, type, indirect, 1, 0);
+}
+
+MOCK_API void glMultiDrawArraysIndirectEXT(GLenum mode, const void* indirect, GLsizei drawcount, GLsizei stride) {
+    MOCK_RECORD(glMultiDrawArraysIndirectEXT, mode, indirect, drawcount, stride);
+    draw_arrays_indirect("glMultiDrawArraysIndirectEXT", mode, indirect, drawcount, stride);
+}
+
+MOCK_API void glMultiDrawElementsIndirectEXT(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount,
+                                             GLsizei stride) {
+    MOCK_RECORD(glMultiDrawElementsIndirectEXT, mode, type, indirect, drawcount, stride);
+    draw_elements_indirect("glMultiDrawElementsIndirectEXT", mode, type, indirect, drawcount, stride);
+}
+
+MOCK_API void glMultiDrawElementsBaseVertexEXT(GLenum mode, const GLsizei* count, GLenum type,
+                                               const void* const* indices, GLsizei drawcount,
+                                               const GLint* basevertex) {
+    MOCK_RECORD(glMultiDrawElementsBaseVertexEXT, mode, count, type, indices, drawcount, basevertex);
+    for (GLsizei i = 0; i < drawcount; ++i)
+        capture_draw("glMultiDrawElementsBaseVertexEXT", mode, 0, count[i], 1, type, indices[i], basevertex[i]);
+}
+
+// Compute
+
+MOCK_API void glDispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z) {
+    MOCK_RECORD(glDispatchCompute, num_groups_x, num_groups_y, num_groups_z);
+    Context& c = ctx();
+    Program* p = program(c.program);
+    if (!p || !p->linked) {
+        set_error(GL_INVALID_OPERATION);
+        return;
+    }
+    const GLuint groups[3] = {num_groups_x, num_groups_y, num_groups_z};
+    for (const auto& [type, source] : p->stages) {
+        if (type != GL_COMPUTE_SHADER) continue;
+        for (const auto& [marker, kernel] : c.kernels) {
+            if (source.find(marker) != std::string::npos) {
+                kernel(c.program, groups);
+                return;
+            }
+        }
+    }
+}
+
+// Syncs and queries
+
+MOCK_API GLsync glFenceSync(GLenum condition, GLbitfield flags) {
+    MOCK_RECORD(glFenceSync, condition, flags);
+    Context& c = ctx();
+    uintptr_t sync = c.next_sync++;
+    c.syncs.insert(sync);
+    c.fences++;
+    return (GLsync)sync;
+}
+
+MOCK_API void glDeleteSync(GLsync sync) {
+    MOCK_RECORD(glDeleteSync, sync);
+    if (sync && !ctx().syncs.erase((uintptr_t)sync)) set_error(GL_INVALID_VALUE);
+}
+
+MOCK_API GLboolean glIsSync(GLsync sync) {
+    MOCK_RECORD(glIsSync, sync);
+    return ctx().syncs.count((uintptr_t)sync) ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API GLenum glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+    MOCK_RECORD(glClientWaitSync, sync, flags, timeout);
+    if (!ctx().syncs.count((uintptr_t)sync)) {
+        set_error(GL_INVALID_VALUE);
+        return GL_WAIT_FAILED;
+    }
+    return GL_ALREADY_SIGNALED;
+}
+
+MOCK_API void glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+    MOCK_RECORD(glWaitSync, sync, flags, timeout);
+    if (!ctx().syncs.count((uintptr_t)sync)) set_error(GL_INVALID_VALUE);
+}
+
+MOCK_API void glGetSynciv(GLsync sync, GLenum pname, GLsizei count, GLsizei* length, GLint* values) {
+    MOCK_RECORD(glGetSynciv, sync, pname, count, length, values);
+    if (count < 1) return;
+    if (length) *length = 1;
+    *values = pname == GL_SYNC_STATUS ? GL_SIGNALED : 0;
+}
+
+MOCK_API void glGenQueries(GLsizei n, GLuint* ids) {
+    MOCK_RECORD(glGenQueries, n, ids);
+    for (GLsizei i = 0; i < n; ++i) {
+        ids[i] = new_name();
+        ctx().queries.insert(ids[i]);
+    }
+}
+
+MOCK_API void glDeleteQueries(GLsizei n, const GLuint* ids) {
+    MOCK_RECORD(glDeleteQueries, n, ids);
+    for (GLsizei i = 0; i < n; ++i)
+        ctx().queries.erase(ids[i]);
+}
+
+MOCK_API void glGetQueryObjectuiv(GLuint id, GLenum pname, GLuint* params) {
+    MOCK_RECORD(glGetQueryObjectuiv, id, pname, params);
+    *params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+// Shaders and programs
+
+MOCK_API GLuint glCreateShader(GLenum type) {
+    MOCK_RECORD(glCreateShader, type);
+    GLuint name = new_name();
+    ctx().shaders[name].type = type;
+    return name;
+}
+
+MOCK_API void glDeleteShader(GLuint shader) {
+    MOCK_RECORD(glDeleteShader, shader);
+    Context& c = ctx();
+    for (auto& [id, p] : c.programs) {
+        if (p.attached.count(shader)) {
+            c.shaders[shader].deleted = true;
+            return;
+        }
+    }
+    c.shaders.erase(shader);
+}
+
+MOCK_API GLboolean glIsShader(GLuint shader) {
+    MOCK_RECORD(glIsShader, shader);
+    return ctx().shaders.count(shader) ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
+    MOCK_RECORD(glShaderSource, shader, count, string, length);
+    auto it = ctx().shaders.find(shader);
+    if (it == ctx().shaders.end()) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    std::string source;
+    for (GLsizei i = 0; i < count; ++i) {
+        if (length && length[i] >= 0)
+            source.append(string[i], length[i]);
+        else
+            source.append(string[i]);
+    }
+    it->second.source = std::move(source);
+}
+
+MOCK_API void glCompileShader(GLuint shader) {
+    MOCK_RECORD(glCompileShader, shader);
+    auto it = ctx().shaders.find(shader);
+    if (it == ctx().shaders.end()) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    ctx().compiles++;
+    Shader& s = it->second;
+    s.compiled = s.source.find(kCompileErrorMarker) == std::string::npos;
+    s.log = s.compiled ? "" : "mock: compile error requested";
+}
+
+MOCK_API void glGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+    MOCK_RECORD(glGetShaderiv, shader, pname, params);
+    auto it = ctx().shaders.find(shader);
+    if (it == ctx().shaders.end()) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    Shader& s = it->second;
+    switch (pname) {
+    case GL_COMPILE_STATUS:
+        *params = s.compiled;
+        break;
+    case GL_INFO_LOG_LENGTH:
+        *params = s.log.empty() ? 0 : (GLint)s.log.size() + 1;
+        break;
+    case GL_SHADER_TYPE:
+        *params = (GLint)s.type;
+        break;
+    case GL_SHADER_SOURCE_LENGTH:
+        *params = s.source.empty() ? 0 : (GLint)s.source.size() + 1;
+        break;
+    case GL_DELETE_STATUS:
+        *params = s.deleted;
+        break;
+    default:
+        set_error(GL_INVALID_ENUM);
+    }
+}
+
+static void copy_log(const std::string& log, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    GLsizei n = bufSize > 0 ? std::min<GLsizei>(bufSize - 1, (GLsizei)log.size()) : 0;
+    if (infoLog && bufSize > 0) {
+        memcpy(infoLog, log.data(), n);
+        infoLog[n] = 0;
+    }
+    if (length) *length = n;
+}
+
+MOCK_API void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    MOCK_RECORD(glGetShaderInfoLog, shader, bufSize, length, infoLog);
+    copy_log(ctx().shaders[shader].log, bufSize, length, infoLog);
+}
+
+MOCK_API void glGetShaderSource(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* source) {
+    MOCK_RECORD(glGetShaderSource, shader, bufSize, length, source);
+    copy_log(ctx().shaders[shader].source, bufSize, length, source);
+}
+
+MOCK_API GLuint glCreateProgram() {
+    MOCK_RECORD(glCreateProgram);
+    GLuint name = new_name();
+    ctx().programs[name];
+    return name;
+}
+
+MOCK_API void glDeleteProgram(GLuint prog) {
+    MOCK_RECORD(glDeleteProgram, prog);
+    Context& c = ctx();
+    auto it = c.programs.find(prog);
+    if (it == c.programs.end()) return;
+    for (GLuint s : it->second.attached) {
+        auto sit = c.shaders.find(s);
+        if (sit != c.shaders.end() && sit->second.deleted) c.shaders.erase(sit);
+    }
+    c.programs.erase(it);
+    if (c.program == prog) c.program = 0;
+}
+
+MOCK_API GLboolean glIsProgram(GLuint prog) {
+    MOCK_RECORD(glIsProgram, prog);
+    return ctx().programs.count(prog) ? GL_TRUE : GL_FALSE;
+}
+
+MOCK_API void glAttachShader(GLuint prog, GLuint shader) {
+    MOCK_RECORD(glAttachShader, prog, shader);
+    Program* p = program(prog);
+    if (!p || !ctx().shaders.count(shader)) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    p->attached.insert(shader);
+}
+
+MOCK_API void glDetachShader(GLuint prog, GLuint shader) {
+    MOCK_RECORD(glDetachShader, prog, shader);
+    if (Program* p = program(prog)) p->attached.erase(shader);
+}
+
+MOCK_API void glGetAttachedShaders(GLuint prog, GLsizei maxCount, GLsizei* count, GLuint* shaders) {
+    MOCK_RECORD(glGetAttachedShaders, prog, maxCount, count, shaders);
+    Program* p = program(prog);
+    GLsizei n = 0;
+    if (p) {
+        for (GLuint s : p->attached) {
+            if (n >= maxCount) break;
+            shaders[n++] = s;
+        }
+    }
+    if (count) *count = n;
+}
+
+MOCK_API void glBindAttribLocation(GLuint prog, GLuint index, const GLchar* name) {
+    MOCK_RECORD(glBindAttribLocation, prog, index, name);
+    if (Program* p = program(prog)) p->attrib_bindings[name] = index;
+}
+
+MOCK_API GLint glGetAttribLocation(GLuint prog, const GLchar* name) {
+    MOCK_RECORD(glGetAttribLocation, prog, name);
+    Program* p = program(prog);
+    if (!p) return -1;
+    auto it = p->attrib_bindings.find(name);
+    return it == p->attrib_bindings.end() ? -1 : (GLint)it->second;
+}
+
+MOCK_API void glTransformFeedbackVaryings(GLuint prog, GLsizei count, const GLchar* const* varyings,
+                                          GLenum bufferMode) {
+    MOCK_RECORD(glTransformFeedbackVaryings, prog, count, varyings, bufferMode);
+    Program* p = program(prog);
+    if (!p) return;
+    p->tf_varyings.assign(varyings, varyings + count);
+    p->tf_mode = bufferMode;
+}
+
+MOCK_API void glProgramParameteri(GLuint prog, GLenum pname, GLint value) {
+    MOCK_RECORD(glProgramParameteri, prog, pname, value);
+    Program* p = program(prog);
+    if (!p) return;
+    if (pname == GL_PROGRAM_BINARY_RETRIEVABLE_HINT) p->binary_retrievable = value;
+    if (pname == GL_PROGRAM_SEPARABLE) p->separable = value;
+}
+
+MOCK_API void glLinkProgram(GLuint prog) {
+    MOCK_RECORD(glLinkProgram, prog);
+    Program* p = program(prog);
+    if (!p) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    link(*p);
+}
+
+MOCK_API void glValidateProgram(GLuint prog) { MOCK_RECORD(glValidateProgram, prog); }
+
+MOCK_API void glGetProgramiv(GLuint prog, GLenum pname, GLint* params) {
+    MOCK_RECORD(glGetProgramiv, prog, pname, params);
+    Program* p = program(prog);
+    if (!p) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    switch (pname) {
+    case GL_LINK_STATUS:
+        *params = p->linked;
+        break;
+    case GL_VALIDATE_STATUS:
+        *params = p->linked;
+        break;
+    case GL_DELETE_STATUS:
+        *params = p->deleted;
+        break;
+    case GL_INFO_LOG_LENGTH:
+        *params = p->log.empty() ? 0 : (GLint)p->log.size() + 1;
+        break;
+    case GL_ATTACHED_SHADERS:
+        *params = (GLint)p->attached.size();
+        break;
+    case GL_PROGRAM_BINARY_LENGTH:
+        *params = p->linked ? (GLint)serialize_binary(*p).size() : 0;
+        break;
+    case GL_PROGRAM_BINARY_RETRIEVABLE_HINT:
+        *params = p->binary_retrievable;
+        break;
+    case GL_PROGRAM_SEPARABLE:
+        *params = p->separable;
+        break;
+    case GL_TRANSFORM_FEEDBACK_VARYINGS:
+        *params = (GLint)p->tf_varyings.size();
+        break;
+    case GL_TRANSFORM_FEEDBACK_BUFFER_MODE:
+        *params = (GLint)p->tf_mode;
+        break;
+    case GL_ACTIVE_UNIFORMS:
+    case GL_ACTIVE_ATTRIBUTES:
+    case GL_ACTIVE_UNIFORM_BLOCKS:
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+    case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:
+        *params = 0;
+        break;
+    default:
+        set_error(GL_INVALID_ENUM);
+    }
+}
+
+MOCK_API void glGetProgramInfoLog(GLuint prog, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    MOCK_RECORD(glGetProgramInfoLog, prog, bufSize, length, infoLog);
+    Program* p = program(prog);
+    copy_log(p ? p->log : std::string(), bufSize, length, infoLog);
+}
+
+MOCK_API void glGetProgramBinary(GLuint prog, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary) {
+    MOCK_RECORD(glGetProgramBinary, prog, bufSize, length, binaryFormat, binary);
+    Program* p = program(prog);
+    if (!p || !p->linked) {
+        set_error(GL_INVALID_OPERATION);
+        if (length) *length = 0;
+        return;
+    }
+    std::vector<uint8_t> blob = serialize_binary(*p);
+    if ((size_t)bufSize < blob.size()) {
+        set_error(GL_INVALID_OPERATION);
+        if (length) *length = 0;
+        return;
+    }
+    memcpy(binary, blob.data(), blob.size());
+    if (length) *length = (GLsizei)blob.size();
+    if (binaryFormat) *binaryFormat = MOCK_BINARY_FORMAT;
+}
+
+MOCK_API void glProgramBinary(GLuint prog, GLenum binaryFormat, const void* binary, GLsizei length) {
+    MOCK_RECORD(glProgramBinary, prog, binaryFormat, binary, length);
+    Program* p = program(prog);
+    if (!p) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    p->linked = !ctx().reject_binaries && binaryFormat == MOCK_BINARY_FORMAT &&
+                deserialize_binary(*p, (const uint8_t*)binary, (size_t)length);
+    p->log = p->linked ? "" : "mock: program binary rejected";
+}
+
+MOCK_API void glUseProgram(GLuint prog) {
+    MOCK_RECORD(glUseProgram, prog);
+    if (prog && !program(prog)) {
+        set_error(GL_INVALID_VALUE);
+        return;
+    }
+    ctx().program = prog;
+}
+
+// Locations are handed out in query order and stay stable per program
+MOCK_API GLint glGetUniformLocation(GLuint prog, const GLchar* name) {
+    MOCK_RECORD(glGetUniformLocation, prog, name);
+    Program* p = program(prog);
+    if (!p || !p->linked) return -1;
+    auto [it, inserted] = p->uniform_locations.emplace(name, (GLint)p->uniform_locations.size());
+    return it->second;
+}
+
+MOCK_API GLuint glGetUniformBlockIndex(GLuint prog, const GLchar* uniformBlockName) {
+    MOCK_RECORD(glGetUniformBlockIndex, prog, uniformBlockName);
+    Program* p = program(prog);
+    if (!p) return GL_INVALID_INDEX;
+    auto [it, inserted] = p->uniform_blocks.emplace(uniformBlockName, (GLuint)p->uniform_blocks.size());
+    return it->second;
+}
+
+#define MOCK_UNIFORM(suffix, type, n)                                                                                  \
+    MOCK_API void glUniform##n##suffix##v(GLint location, GLsizei count, const type* value) {                          \
+        MOCK_RECORD(glUniform##n##suffix##v, location, count, value);                                                  \
+        set_uniform(location, value, (size_t)count * n);                                                               \
+    }
+
+MOCK_UNIFORM(f, GLfloat, 1)
+MOCK_UNIFORM(f, GLfloat, 2)
+MOCK_UNIFORM(f, GLfloat, 3)
+MOCK_UNIFORM(f, GLfloat, 4)
+MOCK_UNIFORM(i, GLint, 1)
+MOCK_UNIFORM(i, GLint, 2)
+MOCK_UNIFORM(i, GLint, 3)
+MOCK_UNIFORM(i, GLint, 4)
+MOCK_UNIFORM(ui, GLuint, 1)
+MOCK_UNIFORM(ui, GLuint, 2)
+MOCK_UNIFORM(ui, GLuint, 3)
+MOCK_UNIFORM(ui, GLuint, 4)
+
+MOCK_API void glUniform1f(GLint location, GLfloat v0) {
+    MOCK_RECORD(glUniform1f, location, v0);
+    set_uniform(location, &v0, 1);
+}
+
+MOCK_API void glUniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    MOCK_RECORD(glUniform2f, location, v0, v1);
+    GLfloat v[] = {v0, v1};
+    set_uniform(location, v, 2);
+}
+
+MOCK_API void glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    MOCK_RECORD(glUniform3f, location, v0, v1, v2);
+    GLfloat v[] = {v0, v1, v2};
+    set_uniform(location, v, 3);
+}
+
+MOCK_API void glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    MOCK_RECORD(glUniform4f, location, v0, v1, v2, v3);
+    GLfloat v[] = {v0, v1, v2, v3};
+    set_uniform(location, v, 4);
+}
+
+MOCK_API void glUniform1i(GLint location, GLint v0) {
+    MOCK_RECORD(glUniform1i, location, v0);
+    set_uniform(location, &v0, 1);
+}
+
+MOCK_API void glUniform2i(GLint location, GLint v0, GLint v1) {
+    MOCK_RECORD(glUniform2i, location, v0, v1);
+    GLint v[] = {v0, v1};
+    set_uniform(location, v, 2);
+}
+
+MOCK_API void glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+    MOCK_RECORD(glUniform4i, location, v0, v1, v2, v3);
+    GLint v[] = {v0, v1, v2, v3};
+    set_uniform(location, v, 4);
+}
+
+MOCK_API void glUniform1ui(GLint location, GLuint v0) {
+    MOCK_RECORD(glUniform1ui, location, v0);
+    set_uniform(location, &v0, 1);
+}
+
+MOCK_API void glUniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3) {
+    MOCK_RECORD(glUniform4ui, location, v0, v1, v2, v3);
+    GLuint v[] = {v0, v1, v2, v3};
+    set_uniform(location, v, 4);
+}
+
+#define MOCK_UNIFORM_MATRIX(dim, words)                                                                                \
+    MOCK_API void glUniformMatrix##dim##fv(GLint location, GLsizei count, GLboolean transpose,                         \
+                                           const GLfloat* value) {                                                     \
+        MOCK_RECORD(glUniformMatrix##dim##fv, location, count, transpose, value);                                      \
+        set_uniform(location, value, (size_t)count * words);                                                           \
+    }
+
+MOCK_UNIFORM_MATRIX(2, 4)
+MOCK_UNIFORM_MATRIX(3, 9)
+MOCK_UNIFORM_MATRIX(4, 16)
@@ -0,0 +1,137 @@
+// MobileGlues - tests/mock/mock_gles.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_MOCK_GLES_H
+#define MOBILEGLUES_MOCK_GLES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Introspection side of libmobileglues_mock, the recording GLES 3.2 / EGL
+// backend the tests load through MG_GLES_LIBRARY and MG_EGL_LIBRARY.
+//
+// The mock keeps the true driver state (objects, bindings, buffer and texel
+// contents, attachments, programs) so tests can compare it with what
+// MobileGlues believes, and records every call with its arguments widened
+// to 64 bits. Floats are recorded as their bit pattern, pointers as
+// addresses.
+
+#define MG_MOCK_API __attribute__((visibility("default")))
+
+namespace mg_mock {
+    using GLenum = unsigned int;
+    using GLuint = unsigned int;
+    using GLint = int;
+    using GLsizei = int;
+
+    struct Call {
+        const char* name;
+        uint32_t argc;
+        uint64_t args[16];
+
+        float f(uint32_t i) const {
+            float value;
+            uint32_t bits = (uint32_t)args[i];
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    };
+
+    MG_MOCK_API void set_recording(bool enabled);
+    MG_MOCK_API void clear_calls();
+    MG_MOCK_API const std::vector<Call>& calls();
+    MG_MOCK_API size_t count(const char* name);
+    MG_MOCK_API std::vector<Call> calls_named(const char* name);
+
+    // Raw entry point of the mock, bypassing MobileGlues
+    MG_MOCK_API void* proc(const char* name);
+    MG_MOCK_API void get_integerv(GLenum pname, GLint* params);
+
+    // Buffers
+    MG_MOCK_API const std::vector<uint8_t>* buffer_data(GLuint buffer);
+    MG_MOCK_API size_t live_buffers();
+
+    // Textures. Texels are stored tightly packed in the upload format.
+    struct TexLevel {
+        GLsizei width = 0, height = 0, depth = 0;
+        GLenum internalformat = 0, format = 0, type = 0;
+        bool compressed = false;
+        std::vector<uint8_t> data;
+    };
+    MG_MOCK_API const TexLevel* texture_level(GLuint texture, GLint level, GLenum face = 0);
+    MG_MOCK_API GLenum texture_target(GLuint texture);
+    MG_MOCK_API GLint texture_parameter(GLuint texture, GLenum pname);
+    MG_MOCK_API size_t live_textures();
+
+    // Framebuffers
+    struct Attachment {
+        GLenum type = 0; // GL_NONE, GL_TEXTURE or GL_RENDERBUFFER
+        GLuint name = 0;
+        GLint level = 0;
+        GLint layer = 0;
+        GLenum textarget = 0;
+    };
+    MG_MOCK_API Attachment fbo_attachment(GLuint framebuffer, GLenum attachment);
+    MG_MOCK_API std::vector<GLenum> fbo_draw_buffers(GLuint framebuffer);
+    MG_MOCK_API void set_surface_size(int width, int height);
+    // RGBA8 contents of the default framebuffer, bottom row first
+    MG_MOCK_API const std::vector<uint8_t>& default_framebuffer();
+    MG_MOCK_API size_t swap_count();
+
+    // Shaders and programs
+    MG_MOCK_API std::string shader_source(GLuint shader);
+    MG_MOCK_API size_t compile_count();
+    MG_MOCK_API size_t link_count();
+    // Sources containing this marker fail to compile
+    constexpr const char* kCompileErrorMarker = "MOCK_COMPILE_ERROR";
+    MG_MOCK_API void set_program_binary_rejected(bool rejected);
+    MG_MOCK_API std::vector<uint32_t> uniform_value(GLuint program, GLint location);
+
+    // Draws, with the vertex attributes they read decoded to floats
+    struct DrawAttrib {
+        GLuint index;
+        GLint size;
+        std::vector<float> values; // size components per emitted vertex
+    };
+    struct Draw {
+        const char* name;
+        GLenum mode;
+        GLint first;
+        GLsizei count;
+        GLsizei instances;
+        GLint basevertex;
+        GLenum index_type;
+        std::vector<uint32_t> indices;
+        GLuint program;
+        GLuint vao;
+        std::vector<DrawAttrib> attribs;
+    };
+    MG_MOCK_API void set_capture_draws(bool enabled);
+    MG_MOCK_API const std::vector<Draw>& draws();
+    MG_MOCK_API void clear_draws();
+
+    // Compute. A dispatch runs the kernel registered for a substring of the
+    // current program's compute shader, or is only recorded without one.
+    using ComputeKernel = std::function<void(GLuint program, const GLuint groups[3])>;
+    MG_MOCK_API void set_compute_kernel(const std::string& marker, ComputeKernel kernel);
+    // Start of the buffer range bound to an indexed binding point
+    MG_MOCK_API uint8_t* indexed_buffer(GLenum target, GLuint index, size_t* size = nullptr);
+
+    // Syncs
+    MG_MOCK_API size_t live_syncs();
+    MG_MOCK_API size_t fence_count();
+
+    // Capabilities
+    MG_MOCK_API void set_extensions(const std::vector<std::string>& extensions);
+    MG_MOCK_API void set_compressed_formats(const std::vector<GLenum>& formats);
+} // namespace mg_mock
+
+#endif // MOBILEGLUES_MOCK_GLES_H
@@ -0,0 +1,68 @@
+// MobileGlues - tests/mock/mock_internal.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_MOCK_INTERNAL_H
+#define MOBILEGLUES_MOCK_INTERNAL_H
+
+// Only the mock's own definitions may declare GLES entry points, the
+// signatures come from gles/gles.h through mock_entries.inc.
+#define GL_GLES_PROTOTYPES 0
+#include <GLES3/gl32.h>
+
+#include "mock_gles.h"
+#include <cstring>
+#include <type_traits>
+
+#define MOCK_API extern "C" __attribute__((visibility("default")))
+
+namespace mg_mock {
+    extern bool g_recording;
+    void record_call(const char* name, const uint64_t* args, uint32_t argc);
+
+    // Default framebuffer hooks for the EGL side
+    void reset_viewport_to_surface();
+    void count_swap();
+    int surface_width();
+    int surface_height();
+
+    template <typename T> inline uint64_t widen(T value) {
+        if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>) {
+            return (uint64_t)(uintptr_t)value;
+        } else if constexpr (std::is_same_v<T, float>) {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        } else if constexpr (std::is_same_v<T, double>) {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        } else {
+            return (uint64_t)value;
+        }
+    }
+
+    template <typename... Args> inline void record(const char* name, Args... args) {
+        if (!g_recording) return;
+        const uint64_t widened[sizeof...(Args) + 1] = {widen(args)...};
+        record_call(name, widened, sizeof...(Args));
+    }
+
+    // Recorder{"glFoo"}(args...) so a parenthesized argument list can be
+    // passed on from a macro as is
+    struct Recorder {
+        const char* name;
+        template <typename... Args> void operator()(Args... args) const { record(name, args...); }
+    };
+
+    template <typename T> inline T default_result() {
+        if constexpr (!std::is_void_v<T>) return T();
+    }
+} // namespace mg_mock
+
+#define MOCK_RECORD(name, ...) mg_mock::record(#name __VA_OPT__(, ) __VA_ARGS__)
+
+#endif // MOBILEGLUES_MOCK_INTERNAL_H
@@ -0,0 +1,404 @@
+// MobileGlues - tests/reference/glsl_regex.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+// The std::regex preprocessing of gl/glsl/glsl_for_es.cpp as it was before
+// GLSLScanner, kept as the reference for the preprocess goldens and
+// the scanner benchmark. Do not fix it: its output is what the scanner is
+// checked against.
+
+#include "glsl_regex.h"
+#include "gl/glsl/glsl_for_es.h"
+#include "version.h"
+
+#include <map>
+#include <regex>
+#include <set>
+
+extern const char* atomicCounterEmulatedWatermark;
+
+static std::string replace_line_starting_with(const std::string& glslCode, const std::string& starting,
+                                       const std::string& substitution = "") {
+    std::string result;
+    size_t length = glslCode.size();
+    size_t start = 0;
+    size_t current = 0;
+
+    auto append_chunk = [&](size_t end) {
+        if (end > start) {
+            result.append(glslCode, start, end - start);
+        }
+    };
+
+    while (current < length) {
+        // Skip whitespace at line begin
+        size_t lineStart = current;
+        while (current < length && (glslCode[current] == ' ' || glslCode[current] == '\t')) {
+            current++;
+        }
+
+        // Check whether #line directive
+        bool isLineDirective = false;
+        if (current + 5 <= length && glslCode.compare(current, 5, "#line") == 0) {
+            isLineDirective = true;
+        }
+
+        // Move to line end
+        while (current < length && glslCode[current] != '\r' && glslCode[current] != '\n') {
+            current++;
+        }
+
+        // Handle carriage return
+        size_t newlineLength = 0;
+        if (current < length) {
+            if (glslCode[current] == '\r') {
+                newlineLength = (current + 1 < length && glslCode[current + 1] == '\n') ? 2 : 1;
+            } else {
+                newlineLength = 1;
+            }
+        }
+
+        if (isLineDirective) {
+            // Find #line directive ->
+            //  1. Append chunk
+            append_chunk(lineStart); // from chunk_begin to before `#line`
+            // 2. Skip this line (incl. \n)
+            current += newlineLength;
+            start = current; // 3. Starting from next line
+
+            result += substitution;
+        } else {
+            // move to a new line
+            current += newlineLength;
+        }
+    }
+
+    // append last block
+    append_chunk(current);
+    return result;
+}
+
+static inline void replace_all(std::string& str, const std::string& from, const std::string& to) {
+    size_t start_pos = 0;
+    while ((start_pos = str.find(from, start_pos)) != std::string::npos) {
+        str.replace(start_pos, from.length(), to);
+        start_pos += to.length(); // Handles case where 'to' is a substring of 'from'
+    }
+}
+
+static size_t find_insertion_point(const std::string& glsl) {
+    size_t pos = 0;
+    size_t insertion_point = 0;
+
+    size_t version_pos = glsl.find("#version");
+    if (version_pos != std::string::npos) {
+        size_t version_end = glsl.find('\n', version_pos);
+        if (version_end == std::string::npos) {
+            version_end = glsl.length();
+        } else {
+            version_end++;
+        }
+        insertion_point = version_end;
+        pos = version_end;
+    } else {
+        insertion_point = 0;
+        pos = 0;
+    }
+
+    while (pos < glsl.length()) {
+        size_t line_begin = pos;
+        while (pos < glsl.length() && std::isspace(glsl[pos])) {
+            pos++;
+        }
+        if (pos >= glsl.length()) break;
+
+        if (glsl[pos] == '#') {
+            pos++;
+            while (pos < glsl.length() && std::isspace(glsl[pos])) {
+                pos++;
+            }
+            if (glsl.compare(pos, 9, "extension") == 0) {
+                size_t ext_end = glsl.find('\n', pos);
+                if (ext_end == std::string::npos) {
+                    ext_end = glsl.length();
+                } else {
+                    ext_end++;
+                }
+                insertion_point = ext_end;
+                pos = ext_end;
+            } else {
+                break;
+            }
+        } else {
+            break;
+        }
+    }
+
+    return insertion_point;
+}
+
+static bool process_non_opaque_atomic_to_ssbo(std::string& source) {
+    if (source.find("atomicCounter") == std::string::npos) return false;
+
+    std::set<std::string> atomic_vars;
+    std::map<std::string, std::string> binding_map;
+    std::regex decl_rx(
+        R"(layout\s*\(\s*binding\s*=\s*(\d+)\s*(?:,\s*offset\s*=\s*(\d+)\s*)?\)\s*uniform\s+atomic_uint\s+(\w+)\s*;)",
+        std::regex::icase);
+
+    std::smatch m;
+    auto it = source.cbegin();
+    while (std::regex_search(it, source.cend(), m, decl_rx)) {
+        size_t prefix = std::distance(source.cbegin(), it);
+        size_t match_pos = prefix + m.position(0);
+        size_t match_len = m.length(0);
+
+        std::string binding = m[1].str();
+        std::string var = m[3].str();
+        atomic_vars.insert(var);
+        binding_map[var] = binding;
+
+        std::string repl = "layout(std430, binding=" + binding + ") buffer AtomicCounterSSBO_" + binding +
+                           " {\n"
+                           "    uint " +
+                           var +
+                           ";\n"
+                           "};\n";
+        source.replace(match_pos, match_len, repl);
+
+        it = source.cbegin() + match_pos + repl.size();
+    }
+
+    if (atomic_vars.empty()) return true;
+
+    for (auto& var : atomic_vars) {
+        source = std::regex_replace(
+            source, std::regex(R"(\batomicCounterIncrement\s*\(\s*)" + var + R"(\s*\))", std::regex::icase),
+            "atomicAdd(" + var + ", 1u)");
+        source = std::regex_replace(
+            source, std::regex(R"(\batomicCounterDecrement\s*\(\s*)" + var + R"(\s*\))", std::regex::icase),
+            "atomicAdd(" + var + ", uint(-1))");
+        source = std::regex_replace(
+            source, std::regex(R"(\batomicCounterAdd\s*\(\s*)" + var + R"(\s*,\s*([^)]+)\s*\))", std::regex::icase),
+            "atomicAdd(" + var + ", $1)");
+        source = std::regex_replace(
+            source, std::regex(R"(\batomicCounter\s*\(\s*)" + var + R"(\s*\))", std::regex::icase), var);
+    }
+
+    // insert memoryBarrierBuffer
+    {
+        std::regex rx_barrier(R"(([ \t]*\batomicAdd\b[^;]*;))", std::regex::icase);
+
+        std::set<size_t> processed_positions;
+        std::string result;
+        size_t last_pos = 0;
+
+        for (auto it = std::sregex_iterator(source.begin(), source.end(), rx_barrier); it != std::sregex_iterator();
+             ++it) {
+
+            size_t start_pos = it->position();
+            size_t end_pos = start_pos + it->length();
+
+            if (processed_positions.find(start_pos) != processed_positions.end()) {
+                continue;
+            }
+
+            result += source.substr(last_pos, start_pos - last_pos);
+
+            std::string matched_stmt = it->str();
+            result += matched_stmt;
+
+            result += "\n    memoryBarrierBuffer();";
+
+            processed_positions.insert(start_pos);
+            last_pos = end_pos;
+        }
+
+        result += source.substr(last_pos);
+        source = result;
+    }
+
+    source += "\n" + std::string(atomicCounterEmulatedWatermark);
+    return true;
+}
+
+static void process_sampler_buffer(std::string& source) {
+    if (source.find("isamplerBuffer") == std::string::npos) {
+        return;
+    }
+
+    size_t pos = 0;
+    while ((pos = source.find("isamplerBuffer", pos)) != std::string::npos) {
+        source.replace(pos, 14, "isampler2D");
+        pos += 11;
+    }
+
+    std::regex pattern(R"(texelFetch\s*\(\s*(\w+)\s*,\s*([^)]+?)\s*\))");
+    source = std::regex_replace(source, pattern,
+                                "texelFetch($1, ivec2(($2) % u_BufferTexWidth, ($2) / u_BufferTexWidth), 0)");
+
+    const char* boundaryProtection = R"(
+ivec2 bufferCoords(int index) {
+    int width = u_BufferTexWidth;
+    int x = index % width;
+    int y = index / width;
+    if (y >= u_BufferTexHeight) {
+        y = u_BufferTexHeight - 1;
+        x = width - 1;
+    }
+    return ivec2(x, y);
+}
+)";
+
+    source = std::regex_replace(source, std::regex("texelFetch\\((\\w+)\\s*,\\s*ivec2\\(([^)]+)\\)\\s*,\\s*0\\)"),
+                                "texelFetch($1, bufferCoords($2), 0)");
+
+    size_t insertion_point = find_insertion_point(source);
+    if (insertion_point != std::string::npos) {
+        source.insert(insertion_point, boundaryProtection);
+    }
+
+    const char* uniformDecl = R"(
+uniform int u_BufferTexWidth;
+uniform int u_BufferTexHeight;
+)";
+
+    insertion_point = find_insertion_point(source);
+    if (insertion_point != std::string::npos) {
+        insertion_point = source.find('\n', insertion_point);
+        if (insertion_point != std::string::npos) {
+            source.insert(insertion_point + 1, uniformDecl);
+        }
+    }
+}
+
+static void inject_textureQueryLod(std::string& glsl) {
+    const std::regex defRegex(R"(vec2\s+mg_textureQueryLod\s*\()", std::regex::ECMAScript);
+
+    if (glsl.find("textureQueryLod") == std::string::npos) {
+        return;
+    }
+    if (std::regex_search(glsl, defRegex)) {
+        return;
+    }
+
+    const std::string textureQueryLodImpl = R"(
+#define textureQueryLod mg_textureQueryLod
+
+vec2 mg_textureQueryLod(sampler2D tex, vec2 uv) {
+    vec2 texSizeF = vec2(textureSize(tex, 0));
+    vec2 dFdx_uv = dFdx(uv * texSizeF);
+    vec2 dFdy_uv = dFdy(uv * texSizeF);
+    float maxDerivative = max(length(dFdx_uv), length(dFdy_uv));
+    float lod = log2(maxDerivative);
+    return vec2(lod);
+}
+)";
+
+    size_t insertPos = find_insertion_point(glsl);
+    glsl.insert(insertPos, "\n" + textureQueryLodImpl + "\n");
+}
+
+static inline void inject_temporal_filter(std::string& glsl) {
+    const std::regex defRegex(R"(vec4\s+GI_TemporalFilter\s*\()", std::regex::ECMAScript);
+
+    if (glsl.find("GI_TemporalFilter") == std::string::npos) {
+        return;
+    }
+    if (std::regex_search(glsl, defRegex)) {
+        return;
+    }
+
+    const std::regex uniformRegex(
+        R"(^\s*(?:layout\s*\([^)]*\)\s*)?uniform\s+\w+(?:\s*\[\s*\d+\s*\])?\s+\w+(?:\s*\[\s*\d+\s*\])?\s*;.*$)",
+        std::regex::ECMAScript | std::regex::multiline);
+    std::sregex_iterator it(glsl.begin(), glsl.end(), uniformRegex);
+    std::sregex_iterator end;
+    size_t insertPos = 0;
+    for (; it != end; ++it) {
+        insertPos = it->position() + it->length();
+    }
+
+    const std::string GI_TemporalFilterImpl = R"(
+vec4 GI_TemporalFilter() {
+    vec2 uv = gl_FragCoord.xy / screenSize;
+    uv += taaJitter * pixelSize;
+    vec4 currentGI = texture(colortex0, uv);
+    float depth = texture(depthtex0, uv).r;
+    vec4 clipPos = vec4(uv * 2.0 - 1.0, depth, 1.0);
+    vec4 viewPos = gbufferProjectionInverse * clipPos;
+    viewPos /= viewPos.w;
+    vec4 worldPos = gbufferModelViewInverse * viewPos;
+    vec4 prevClipPos = gbufferPreviousProjection * (gbufferPreviousModelView * worldPos);
+    prevClipPos /= prevClipPos.w;
+    vec2 prevUV = prevClipPos.xy * 0.5 + 0.5;
+    vec4 historyGI = texture(colortex1, prevUV);
+    float difference = length(currentGI.rgb - historyGI.rgb);
+    float thresholdValue = 0.1;
+    float adaptiveBlend = mix(0.9, 0.0, smoothstep(thresholdValue, thresholdValue * 2.0, difference));
+    vec4 filteredGI = mix(currentGI, historyGI, adaptiveBlend);
+    if (difference > thresholdValue * 2.0) {
+        filteredGI = currentGI;
+    }
+    return filteredGI;
+}
+)";
+    glsl.insert(insertPos, "\n" + GI_TemporalFilterImpl + "\n");
+}
+#define xstr(s) str(s)
+#define str(s) #s
+
+static void inject_mg_macro_definition(std::string& glslCode) {
+    std::string macro_definitions =
+        "\n#define MG_MOBILEGLUES\n"
+        "#define MG_MOBILEGLUES_VERSION " xstr(MAJOR) xstr(MINOR) xstr(REVISION) xstr(PATCH) "\n";
+
+    size_t versionPos = glslCode.rfind("#version");
+    size_t insertionPos = 0;
+
+    if (versionPos != std::string::npos) {
+        size_t nextNewline = glslCode.find('\n', versionPos);
+        insertionPos = (nextNewline != std::string::npos) ? nextNewline + 1 : glslCode.length();
+    } else {
+        size_t firstNewline = glslCode.find('\n');
+        insertionPos = (firstNewline != std::string::npos) ? firstNewline + 1 : 0;
+    }
+
+    glslCode.insert(insertionPos, macro_definitions);
+}
+
+std::string reference::preprocess_glsl(const std::string& glsl, GLenum shaderType, bool* atomicCounterEmulated) {
+    std::string ret = glsl;
+    // Remove lines beginning with `#line`
+    ret = replace_line_starting_with(ret, "#line");
+    // Act as if disable_GL_ARB_derivative_control is false
+    replace_all(ret, "#ifdef GL_ARB_derivative_control", "#if 0");
+    replace_all(ret, "#ifndef GL_ARB_derivative_control", "#if 1");
+
+    // Polyfill transpose()
+    replace_all(ret, "const mat3 rotInverse = transpose(rot);",
+                "const mat3 rotInverse = mat3(rot[0][0], rot[1][0], rot[2][0], rot[0][1], rot[1][1], rot[2][1], "
+                "rot[0][2], rot[1][2], rot[2][2]);");
+
+    // GI_TemporalFilter injection
+    inject_temporal_filter(ret);
+
+    // textureQueryLod injection
+    if (!g_gles_caps.GL_EXT_texture_query_lod) {
+        inject_textureQueryLod(ret);
+    }
+
+    // MobileGlues macros injection
+    inject_mg_macro_definition(ret);
+
+    if (hardware->emulate_texture_buffer) {
+        // Sampler buffer processing
+        process_sampler_buffer(ret);
+    }
+
+    *atomicCounterEmulated = process_non_opaque_atomic_to_ssbo(ret);
+    return ret;
+}
@@ -0,0 +1,19 @@
+// MobileGlues - tests/reference/glsl_regex.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_TEST_REFERENCE_GLSL_REGEX_H
+#define MOBILEGLUES_TEST_REFERENCE_GLSL_REGEX_H
+
+#include <GL/gl.h>
+#include <string>
+
+namespace reference {
+    // preprocess_glsl() with the std::regex rewrites it used before GLSLScanner
+    std::string preprocess_glsl(const std::string& glsl, GLenum shaderType, bool* atomicCounterEmulated);
+} // namespace reference
+
+#endif // MOBILEGLUES_TEST_REFERENCE_GLSL_REGEX_H
@@ -0,0 +1,273 @@
+// MobileGlues - tests/test_call_trace.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "config/config.h"
+#include "gl/buffer.h"
+#include "gl/call_trace.h"
+#include "test_util.h"
+
+namespace {
+    std::string trace_path(const char* name) {
+        return std::string(mg_directory_path) + "/" + name;
+    }
+
+    // Starts and ends in the state it sets up first, so the redundant-state
+    // filter forwards the same calls when the replay runs it again. Buffer
+    // and VAO names come back from MobileGlues' free lists once the captured
+    // objects are deleted, so the replayed names match the traced ones.
+    void set_default_state() {
+        glDisable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ZERO);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glViewport(0, 0, 64, 64);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    struct Workload {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        // Queried up front, the EGL queries would be traced without arguments
+        EGLDisplay display = eglGetCurrentDisplay();
+        EGLSurface surface = eglGetCurrentSurface(EGL_DRAW);
+
+        void run() {
+            const GLfloat vertices[12] = {-1, -1, 0, 1, 3, -1, 0, 1, -1, 3, 0, 1};
+            const GLfloat moved[4] = {-0.5f, -0.5f, 0.25f, 1.0f};
+            glGenVertexArrays(1, &vao);
+            glBindVertexArray(vao);
+            glGenBuffers(1, &vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(moved), moved);
+            glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+            glEnableVertexAttribArray(0);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glClearColor(0.25f, 0.5f, 0.75f, 1.0f);
+            glViewport(0, 0, 32, 16);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            eglSwapBuffers(display, surface);
+            set_default_state();
+        }
+
+        void destroy() {
+            glDeleteBuffers(1, &vbo);
+            glDeleteVertexArrays(1, &vao);
+        }
+    };
+
+    struct Stream {
+        std::vector<std::string> names;
+        std::vector<std::vector<uint64_t>> state_args;
+        std::vector<mg_mock::Draw> draws;
+        std::vector<uint8_t> buffer;
+    };
+
+    // Arguments of calls that carry no driver object names or addresses
+    bool compare_args(const char* name) {
+        static const char* const kState[] = {"glEnable",     "glDisable", "glBlendFunc",
+                                             "glClearColor", "glViewport", "glClear"};
+        return std::any_of(std::begin(kState), std::end(kState), [&](const char* s) { return strcmp(s, name) == 0; });
+    }
+
+    Stream snapshot(GLuint vbo) {
+        Stream stream;
+        for (const mg_mock::Call& call : mg_mock::calls()) {
+            stream.names.emplace_back(call.name);
+            if (compare_args(call.name)) stream.state_args.emplace_back(call.args, call.args + call.argc);
+        }
+        stream.draws = mg_mock::draws();
+        if (const auto* data = mg_mock::buffer_data(find_real_buffer(vbo))) stream.buffer = *data;
+        return stream;
+    }
+
+    std::vector<uint8_t> read_file(const std::string& path) {
+        std::string text = read_text_file(path);
+        return {text.begin(), text.end()};
+    }
+
+    void write_file(const std::string& path, const std::vector<uint8_t>& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+    }
+} // namespace
+
+TEST(CallTrace, ReplayReproducesDriverCalls) {
+    reset_gl_errors();
+    set_default_state();
+    std::string path = trace_path("round_trip.mgct");
+
+    // Once untraced, so one-time setup does not show up in the capture
+    Workload warmup;
+    warmup.run();
+    warmup.destroy();
+
+    Workload captured;
+    mg_mock::clear_calls();
+    mg_mock::clear_draws();
+    ASSERT_TRUE(call_trace_start(path.c_str()));
+    captured.run();
+    call_trace_stop();
+    Stream expected = snapshot(captured.vbo);
+    captured.destroy();
+    ASSERT_EQ(expected.draws.size(), (size_t)1);
+
+    mg_mock::clear_calls();
+    mg_mock::clear_draws();
+    CallTraceReplayStats stats;
+    std::string error;
+    size_t swaps = mg_mock::swap_count();
+    // Queried here, the replayed stream would pick up the queries on every frame
+    EGLDisplay display = captured.display;
+    EGLSurface surface = captured.surface;
+    bool ok = call_trace_replay(path.c_str(), stats, [&] { eglSwapBuffers(display, surface); }, error);
+    ASSERT_TRUE(ok);
+    Stream replayed = snapshot(captured.vbo);
+
+    EXPECT_EQ(stats.frames, (uint64_t)1);
+    EXPECT_EQ(mg_mock::swap_count(), swaps + 1);
+    EXPECT_EQ(stats.unknown, (uint64_t)0);
+    EXPECT_EQ(stats.no_args, (uint64_t)0);
+    EXPECT_EQ(stats.unreplayable, (uint64_t)0);
+    EXPECT_EQ(stats.replayed, stats.calls);
+    EXPECT_TRUE(stats.calls >= 20);
+
+    EXPECT_TRUE(replayed.names == expected.names);
+    EXPECT_TRUE(replayed.state_args == expected.state_args);
+    EXPECT_TRUE(replayed.buffer == expected.buffer);
+    ASSERT_EQ(replayed.draws.size(), (size_t)1);
+    ASSERT_EQ(replayed.draws[0].attribs.size(), expected.draws[0].attribs.size());
+    for (size_t i = 0; i < replayed.draws[0].attribs.size(); ++i)
+        EXPECT_TRUE(replayed.draws[0].attribs[i].values == expected.draws[0].attribs[i].values);
+
+    // The replay recreated the objects under the same names
+    captured.destroy();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(CallTrace, ReplayRebindsFramebuffers) {
+    reset_gl_errors();
+    std::string path = trace_path("framebuffer.mgct");
+    // Created outside the trace, so the replay binds the same names
+    GLuint texture = 0, fbo = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 16, 16, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    mg_mock::clear_calls();
+    ASSERT_TRUE(call_trace_start(path.c_str()));
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    EXPECT_EQ(glCheckFramebufferStatus(GL_FRAMEBUFFER), (GLenum)GL_FRAMEBUFFER_COMPLETE);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    call_trace_stop();
+    std::vector<mg_mock::Call> expected = mg_mock::calls();
+    EXPECT_EQ(mg_mock::fbo_attachment(fbo, GL_COLOR_ATTACHMENT0).name, texture);
+
+    // Detached again, so only the replay can put the texture back
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    ASSERT_EQ(mg_mock::fbo_attachment(fbo, GL_COLOR_ATTACHMENT0).name, (GLuint)0);
+
+    mg_mock::clear_calls();
+    CallTraceReplayStats stats;
+    std::string error;
+    ASSERT_TRUE(call_trace_replay(path.c_str(), stats, nullptr, error));
+    EXPECT_EQ(stats.calls, (uint64_t)5);
+    EXPECT_EQ(stats.no_args, (uint64_t)0);
+    EXPECT_EQ(stats.replayed, stats.calls);
+    EXPECT_EQ(mg_mock::fbo_attachment(fbo, GL_COLOR_ATTACHMENT0).name, texture);
+
+    std::vector<mg_mock::Call> replayed = mg_mock::calls();
+    ASSERT_EQ(replayed.size(), expected.size());
+    for (size_t i = 0; i < replayed.size(); ++i) {
+        EXPECT_TRUE(strcmp(replayed[i].name, expected[i].name) == 0);
+        EXPECT_TRUE(std::equal(replayed[i].args, replayed[i].args + replayed[i].argc, expected[i].args,
+                               expected[i].args + expected[i].argc));
+    }
+
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &texture);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(CallTrace, ClientMemoryOutsideTheTraceIsNotReplayed) {
+    reset_gl_errors();
+    std::string path = trace_path("client_arrays.mgct");
+    const GLfloat vertices[12] = {};
+
+    // A client-side vertex array is read by the draw, not by the call that set it up
+    ASSERT_TRUE(call_trace_start(path.c_str()));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 0, vertices);
+    call_trace_stop();
+
+    CallTraceReplayStats stats;
+    std::string error;
+    mg_mock::clear_calls();
+    ASSERT_TRUE(call_trace_replay(path.c_str(), stats, nullptr, error));
+    EXPECT_EQ(stats.calls, (uint64_t)1);
+    EXPECT_EQ(stats.unreplayable, (uint64_t)1);
+    EXPECT_EQ(mg_mock::count("glVertexAttribPointer"), (size_t)0);
+}
+
+TEST(CallTrace, DamagedTracesAreRejected) {
+    std::string path = trace_path("damaged.mgct");
+    ASSERT_TRUE(call_trace_start(path.c_str()));
+    glViewport(0, 0, 48, 48);
+    glViewport(0, 0, 64, 64);
+    call_trace_stop();
+    std::vector<uint8_t> bytes = read_file(path);
+    ASSERT_TRUE(bytes.size() > 16);
+
+    CallTraceReplayStats stats;
+    std::string error;
+    std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 3);
+    write_file(path, truncated);
+    EXPECT_TRUE(!call_trace_replay(path.c_str(), stats, nullptr, error));
+    EXPECT_TRUE(!error.empty());
+
+    std::vector<uint8_t> old_version = bytes;
+    old_version[4] = 1;
+    write_file(path, old_version);
+    error.clear();
+    EXPECT_TRUE(!call_trace_replay(path.c_str(), stats, nullptr, error));
+    EXPECT_TRUE(error.find("version") != std::string::npos);
+}
+
+BENCH(CallTrace, CaptureAndReplay) {
+    std::string path = trace_path("bench.mgct");
+    mg_mock::set_recording(false);
+    mg_test::measure("traced glViewport, tracing off", 200000, "calls", [] { glViewport(0, 0, 64, 64); });
+
+    ASSERT_TRUE(call_trace_start(path.c_str()));
+    mg_test::measure("traced glViewport, tracing on", 200000, "calls", [] { glViewport(0, 0, 64, 64); });
+    const GLfloat data[64] = {};
+    GLuint vbo = 0;
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_DYNAMIC_DRAW);
+    mg_test::measure("traced glBufferSubData 256 bytes", 200000, "calls",
+                     [&] { glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(data), data); });
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    call_trace_stop();
+    glDeleteBuffers(1, &vbo);
+
+    CallTraceReplayStats stats;
+    std::string error;
+    mg_test::measure("replay", 1, "calls", [&] { call_trace_replay(path.c_str(), stats, nullptr, error); },
+                     400003);
+    mg_mock::set_recording(true);
+    // Recreated by the replay
+    glDeleteBuffers(1, &vbo);
+}
@@ -0,0 +1,139 @@
+// MobileGlues - tests/test_digest.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "config/config.h"
+#include "config/settings.h"
+#include "gl/glsl/cache.h"
+#include "gl/glsl/digest.h"
+#include "test_util.h"
+#include <random>
+#include <unistd.h>
+
+namespace {
+    std::string hex(const digest::SHA256& d) {
+        static const char* digits = "0123456789abcdef";
+        std::string out;
+        for (uint8_t b : d) {
+            out += digits[b >> 4];
+            out += digits[b & 15];
+        }
+        return out;
+    }
+} // namespace
+
+// FIPS 180-2 vectors, plus lengths around the 55/56/64 byte padding edges
+TEST(Digest, Sha256KnownAnswers) {
+    printf("  backend: %s\n", digest::sha256_backend());
+    EXPECT_EQ(hex(digest::sha256("")), std::string("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    EXPECT_EQ(hex(digest::sha256("abc")),
+              std::string("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    EXPECT_EQ(hex(digest::sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+              std::string("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+    EXPECT_EQ(hex(digest::sha256(std::string(1000000, 'a'))),
+              std::string("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+    EXPECT_EQ(hex(digest::sha256(std::string(55, 'a'))),
+              std::string("9f4390f8d30c2dd92ec9f095b65e2b9ae9b0a925a5258e241c9f1e910f734318"));
+    EXPECT_EQ(hex(digest::sha256(std::string(56, 'a'))),
+              std::string("b35439a4ac6f0948b6d6f9e3c6af0f5f590ce20f1bde7090ef7970686ec6738a"));
+    EXPECT_EQ(hex(digest::sha256(std::string(64, 'a'))),
+              std::string("ffe054fe7ae0cb6dc65c3af9b61d5209f439851db43d0ba5997337df154668eb"));
+}
+
+// Every backend this CPU can run must agree with the scalar code, on lengths
+// around block boundaries and on input that is not 16-byte aligned
+TEST(Digest, BackendsMatchScalar) {
+    std::vector<const char*> backends = digest::sha256_backends();
+    ASSERT_EQ(std::string(backends.back()), std::string("scalar"));
+    EXPECT_EQ(std::string(backends.front()), std::string(digest::sha256_backend()));
+    for (const char* name : backends)
+        printf("  backend: %s\n", name);
+
+    std::mt19937 rng(1234);
+    std::string buffer(64 * 33 + 16, '\0');
+    for (char& c : buffer)
+        c = (char)rng();
+    std::vector<size_t> lengths;
+    for (size_t block = 0; block <= 32; ++block) {
+        for (int delta = -9; delta <= 9; ++delta) {
+            long length = (long)block * 64 + delta;
+            if (length >= 0) lengths.push_back((size_t)length);
+        }
+    }
+    for (int i = 0; i < 200; ++i)
+        lengths.push_back(rng() % (64 * 33));
+
+    for (size_t length : lengths) {
+        std::string_view data(buffer.data() + rng() % 16, length);
+        std::string expected = hex(digest::sha256(data, "scalar"));
+        for (const char* name : backends) {
+            if (hex(digest::sha256(data, name)) != expected) {
+                printf("  %s differs at length %zu\n", name, length);
+                EXPECT_EQ(hex(digest::sha256(data, name)), expected);
+            }
+        }
+    }
+}
+
+TEST(Digest, BucketHashUsesEveryByte) {
+    digest::SHA256 base = digest::sha256("key");
+    digest::SHA256Hash hasher;
+    for (size_t i = 0; i < base.size(); ++i) {
+        digest::SHA256 other = base;
+        other[i] ^= 1;
+        EXPECT_NE(hasher(other), hasher(base));
+    }
+    std::string_view abc = "abc";
+    EXPECT_EQ(digest::hash64(abc, 1), digest::hash64(abc.data(), abc.size(), 1));
+    EXPECT_NE(digest::hash64(abc, 1), digest::hash64(abc, 2));
+}
+
+// Cache records carry the whole SHA-256 of the key, not a truncated form
+TEST(Digest, CacheRecordsStoreFullDigest) {
+    std::string log = std::string(getenv("MG_DIR_PATH")) + "/digest_key.log";
+    std::string index = log + ".idx";
+    char* saved_log = glsl_cache_file_path;
+    char* saved_index = glsl_cache_index_path;
+    glsl_cache_file_path = log.data();
+    glsl_cache_index_path = index.data();
+
+    const std::string key = "#version 330 core\nvoid main() {}\n//1.3.4|320";
+    {
+        Cache cache;
+        cache.put(key.c_str(), "#version 320 es\nvoid main() {}\n");
+    }
+    std::string contents = read_text_file(log);
+    digest::SHA256 expected = digest::sha256(key);
+    EXPECT_TRUE(contents.find(std::string(expected.begin(), expected.end())) != std::string::npos);
+
+    // A key differing only in the ESSL version suffix is a different entry
+    {
+        Cache cache;
+        std::string essl;
+        EXPECT_TRUE(cache.get(key.c_str(), essl));
+        std::string other = key.substr(0, key.size() - 3) + "310";
+        EXPECT_FALSE(cache.get(other.c_str(), essl));
+    }
+
+    glsl_cache_file_path = saved_log;
+    glsl_cache_index_path = saved_index;
+    unlink(log.c_str());
+    unlink(index.c_str());
+}
+
+BENCH(Digest, Throughput) {
+    for (size_t size : {64u, 4096u, 1u << 20}) {
+        std::string data(size, 'x');
+        for (size_t i = 0; i < size; ++i)
+            data[i] = (char)(i * 131 + 7);
+        int iterations = (int)std::max<size_t>(8, (64u << 20) / size / 8);
+        double mb = size / (1024.0 * 1024.0);
+        std::string label = "sha256 " + std::to_string(size) + " B (" + digest::sha256_backend() + ")";
+        mg_test::measure(label.c_str(), iterations, "MB", [&] { digest::sha256(data); }, mb);
+        label = "hash64 " + std::to_string(size) + " B";
+        mg_test::measure(label.c_str(), iterations, "MB", [&] { digest::hash64(data); }, mb);
+    }
+}
@@ -0,0 +1,242 @@
+// MobileGlues - tests/test_display_list.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/display_list.h"
+#include "gl/immediate.h"
+#include "test_util.h"
+
+namespace {
+    void reset_lists() {
+        reset_gl_errors();
+        glUseProgram(0);
+        glDisable(GL_BLEND);
+        glDisable(GL_DEPTH_TEST);
+        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        glListBase(0);
+        glFinish();
+        mg_mock::clear_calls();
+        mg_mock::clear_draws();
+    }
+
+    const mg_mock::DrawAttrib* attrib(const mg_mock::Draw& draw, GLuint index) {
+        for (const mg_mock::DrawAttrib& a : draw.attribs)
+            if (a.index == index) return &a;
+        return nullptr;
+    }
+
+    // x of every vertex the draw read, which the tests use as vertex ids
+    std::vector<float> xs(const mg_mock::Draw& draw) {
+        std::vector<float> out;
+        const mg_mock::DrawAttrib* a = attrib(draw, IMMEDIATE_ATTRIB_POSITION);
+        if (!a) return out;
+        for (size_t i = 0; i < a->values.size(); i += (size_t)a->size)
+            out.push_back(a->values[i]);
+        return out;
+    }
+
+    void primitive(GLenum mode, int n) {
+        glBegin(mode);
+        for (int i = 0; i < n; ++i)
+            glVertex2f((GLfloat)i, 0.0f);
+        glEnd();
+    }
+
+    std::vector<float> current_attrib(GLuint index) {
+        std::vector<float> v(4);
+        MOCK_GL(glGetVertexAttribfv)(index, GL_CURRENT_VERTEX_ATTRIB, v.data());
+        return v;
+    }
+} // namespace
+
+TEST(DisplayList, CompileRecordsWithoutRunning) {
+    reset_lists();
+    GLuint list = glGenLists(1);
+    ASSERT_TRUE(list != 0);
+    glNewList(list, GL_COMPILE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glColor3f(1.0f, 0.0f, 0.0f);
+    primitive(GL_QUADS, 4);
+    primitive(GL_TRIANGLES, 3);
+    glEndList();
+
+    EXPECT_EQ(mg_mock::count("glEnable"), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glBlendFunc"), (size_t)0);
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)0);
+    EXPECT_EQ(immediate_current_color()[1], 1.0f);
+
+    glCallList(list);
+    EXPECT_EQ(mg_mock::count("glEnable"), (size_t)1);
+    EXPECT_EQ(mg_mock::count("glBlendFunc"), (size_t)1);
+    // Both primitives in one draw from the baked VBO
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+    const mg_mock::Draw& draw = mg_mock::draws()[0];
+    EXPECT_EQ(draw.mode, (GLenum)GL_TRIANGLES);
+    EXPECT_TRUE(xs(draw) == (std::vector<float>{0, 1, 2, 0, 2, 3, 0, 1, 2}));
+    const mg_mock::DrawAttrib* color = attrib(draw, IMMEDIATE_ATTRIB_COLOR);
+    ASSERT_TRUE(color != nullptr);
+    for (size_t i = 0; i < color->values.size(); i += 4)
+        EXPECT_TRUE(std::vector<float>(color->values.begin() + i, color->values.begin() + i + 4) ==
+                    (std::vector<float>{1, 0, 0, 1}));
+    // The color the list set is current afterwards, as it would be had the calls run
+    EXPECT_EQ(immediate_current_color()[1], 0.0f);
+
+    // Replaying uploads nothing
+    mg_mock::clear_calls();
+    mg_mock::clear_draws();
+    glCallList(list);
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_EQ(mg_mock::count("glBufferData"), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glMapBufferRange"), (size_t)0);
+
+    glDeleteLists(list, 1);
+    reset_lists();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(DisplayList, StateChangesSplitDraws) {
+    reset_lists();
+    GLuint list = glGenLists(1);
+    glNewList(list, GL_COMPILE);
+    primitive(GL_TRIANGLES, 3);
+    glEnable(GL_BLEND);
+    primitive(GL_TRIANGLES, 3);
+    primitive(GL_LINES, 2);
+    glEndList();
+
+    glCallList(list);
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)3);
+    EXPECT_EQ(mg_mock::draws()[1].mode, (GLenum)GL_TRIANGLES);
+    EXPECT_EQ(mg_mock::draws()[2].mode, (GLenum)GL_LINES);
+    std::vector<std::string> order;
+    for (const mg_mock::Call& call : mg_mock::calls())
+        if (strcmp(call.name, "glDrawArrays") == 0 || strcmp(call.name, "glEnable") == 0)
+            order.emplace_back(call.name);
+    EXPECT_TRUE(order == (std::vector<std::string>{"glDrawArrays", "glEnable", "glDrawArrays", "glDrawArrays"}));
+
+    glDeleteLists(list, 1);
+    reset_lists();
+}
+
+TEST(DisplayList, UnsetAttributesComeFromTheCaller) {
+    reset_lists();
+    GLuint list = glGenLists(1);
+    glNewList(list, GL_COMPILE);
+    primitive(GL_TRIANGLES, 3);
+    glEndList();
+
+    glColor3f(0.0f, 0.0f, 1.0f);
+    glCallList(list);
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_TRUE(attrib(mg_mock::draws()[0], IMMEDIATE_ATTRIB_COLOR) == nullptr);
+    EXPECT_TRUE(current_attrib(IMMEDIATE_ATTRIB_COLOR) == (std::vector<float>{0, 0, 1, 1}));
+
+    glColor3f(0.0f, 1.0f, 0.0f);
+    glCallList(list);
+    EXPECT_TRUE(current_attrib(IMMEDIATE_ATTRIB_COLOR) == (std::vector<float>{0, 1, 0, 1}));
+
+    glDeleteLists(list, 1);
+    reset_lists();
+}
+
+TEST(DisplayList, CompileAndExecuteRunsNow) {
+    reset_lists();
+    GLuint list = glGenLists(1);
+    glNewList(list, GL_COMPILE_AND_EXECUTE);
+    glColor3f(0.0f, 1.0f, 0.0f);
+    primitive(GL_TRIANGLES, 3);
+    glEndList();
+    glFinish();
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_EQ(immediate_current_color()[0], 0.0f);
+
+    glCallList(list);
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)2);
+    EXPECT_TRUE(xs(mg_mock::draws()[0]) == xs(mg_mock::draws()[1]));
+
+    glDeleteLists(list, 1);
+    reset_lists();
+}
+
+TEST(DisplayList, NestedListsAndCallLists) {
+    reset_lists();
+    GLuint base = glGenLists(3);
+    glNewList(base, GL_COMPILE);
+    primitive(GL_TRIANGLES, 3);
+    glEndList();
+    glNewList(base + 1, GL_COMPILE);
+    glCallList(base);
+    glCallList(base);
+    glEndList();
+    glNewList(base + 2, GL_COMPILE);
+    glEnable(GL_DEPTH_TEST);
+    glEndList();
+
+    glListBase(base);
+    const GLubyte names[] = {1, 2};
+    glCallLists(2, GL_UNSIGNED_BYTE, names);
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)2);
+    EXPECT_EQ(mg_mock::count("glEnable"), (size_t)1);
+
+    // A list calling itself stops at the nesting limit
+    glNewList(base, GL_COMPILE);
+    glCallList(base);
+    primitive(GL_POINTS, 1);
+    glEndList();
+    mg_mock::clear_draws();
+    glCallList(base);
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)64);
+
+    glDeleteLists(base, 3);
+    reset_lists();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(DisplayList, Names) {
+    EXPECT_EQ(glGenLists(0), (GLuint)0);
+    GLuint base = glGenLists(3);
+    for (GLuint i = 0; i < 3; ++i)
+        EXPECT_TRUE(glIsList(base + i));
+    // A name glNewList took without glGenLists is not handed out again
+    glNewList(base + 3, GL_COMPILE);
+    glEndList();
+    GLuint next = glGenLists(1);
+    EXPECT_TRUE(next != base + 3);
+    glDeleteLists(base, 4);
+    glDeleteLists(next, 1);
+    EXPECT_TRUE(!glIsList(base));
+    EXPECT_TRUE(!glIsList(next));
+}
+
+BENCH(DisplayList, ReplayAgainstDirectCalls) {
+    mg_mock::set_recording(false);
+    mg_mock::set_capture_draws(false);
+    auto quads = [] {
+        glBegin(GL_QUADS);
+        for (int i = 0; i < 1000; ++i) {
+            const GLfloat x = (GLfloat)(i % 32), y = (GLfloat)(i / 32);
+            glColor3f(x / 32.0f, y / 32.0f, 1.0f);
+            glVertex2f(x, y);
+            glVertex2f(x + 1.0f, y);
+            glVertex2f(x + 1.0f, y + 1.0f);
+            glVertex2f(x, y + 1.0f);
+        }
+        glEnd();
+        glEnable(GL_BLEND);
+        glDisable(GL_BLEND);
+    };
+    mg_test::measure("1000 quads, direct", 200, "quads", [&] { quads(); }, 1000);
+
+    GLuint list = glGenLists(1);
+    glNewList(list, GL_COMPILE);
+    quads();
+    glEndList();
+    mg_test::measure("1000 quads, display list", 200, "quads", [&] { glCallList(list); }, 1000);
+    glDeleteLists(list, 1);
+    mg_mock::set_capture_draws(true);
+    mg_mock::set_recording(true);
+}
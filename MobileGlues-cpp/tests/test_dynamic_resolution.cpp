@@ -0,0 +1,125 @@
+// MobileGlues - tests/test_dynamic_resolution.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/FSR1/DynamicResolution.h"
+#include "test_util.h"
+#include <cmath>
+#include <random>
+
+namespace {
+    const float kTarget = 1000.0f / 60.0f;
+
+    // A GPU whose frame time has a fixed part and a part that grows with
+    // the pixel count
+    struct Load {
+        float fixed_ms;
+        float full_res_ms;
+
+        float frame_ms(float scale) const { return fixed_ms + full_res_ms * scale * scale; }
+    };
+
+    DynamicResolutionController controller() {
+        DynamicResolutionConfig config;
+        config.min_scale = 0.5f;
+        config.target_frame_ms = kTarget;
+        return DynamicResolutionController(config);
+    }
+
+    // Runs frames under a load and returns how often the scale changed
+    int run(DynamicResolutionController& drs, const Load& load, int frames, float noise = 0.0f,
+            uint32_t seed = 1) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> jitter(1.0f - noise, 1.0f + noise);
+        int changes = 0;
+        for (int i = 0; i < frames; ++i) {
+            const float before = drs.scale();
+            drs.update(load.frame_ms(before) * jitter(rng));
+            changes += drs.scale() != before;
+        }
+        return changes;
+    }
+
+    // The frame time the load settles at lies in the dead band, or the scale
+    // sits at a bound
+    bool settled(const DynamicResolutionController& drs, const Load& load) {
+        const DynamicResolutionConfig& config = drs.config();
+        const float ms = load.frame_ms(drs.scale());
+        if (ms > kTarget * config.upper_band) return drs.scale() == config.min_scale;
+        if (ms < kTarget * config.lower_band) return drs.scale() == config.max_scale;
+        return true;
+    }
+} // namespace
+
+TEST(DynamicResolution, SettlesWithoutOscillating) {
+    const Load loads[] = {{1.0f, 30.0f}, {2.0f, 20.0f}, {0.5f, 45.0f}, {4.0f, 14.0f}};
+    for (const Load& load : loads) {
+        DynamicResolutionController drs = controller();
+        run(drs, load, 600);
+        EXPECT_TRUE(settled(drs, load));
+        // And stays there
+        EXPECT_EQ(run(drs, load, 1000), 0);
+    }
+}
+
+TEST(DynamicResolution, FollowsThrottling) {
+    DynamicResolutionController drs = controller();
+    const Load cool = {1.0f, 11.0f}, hot = {1.0f, 25.0f};
+    EXPECT_EQ(run(drs, cool, 300), 0);
+    EXPECT_EQ(drs.scale(), 1.0f);
+
+    // Scales down within a few frames of the slowdown, in one or two steps
+    int frames = 0;
+    while (frames < 100 && hot.frame_ms(drs.scale()) > kTarget * drs.config().upper_band) {
+        drs.update(hot.frame_ms(drs.scale()));
+        ++frames;
+    }
+    EXPECT_TRUE(frames < 30);
+    run(drs, hot, 300);
+    EXPECT_TRUE(settled(drs, hot));
+    EXPECT_TRUE(drs.scale() < 0.9f);
+
+    // Claims the headroom back once the GPU cools down
+    run(drs, cool, 1000);
+    EXPECT_EQ(drs.scale(), 1.0f);
+}
+
+TEST(DynamicResolution, NoiseAndSpikesAreIgnored) {
+    // Frame times jittering inside the dead band
+    DynamicResolutionController drs = controller();
+    EXPECT_EQ(run(drs, {1.0f, kTarget * 0.92f - 1.0f}, 2000, 0.08f, 20251017), 0);
+    EXPECT_EQ(drs.scale(), 1.0f);
+
+    // A hitch every second
+    for (int i = 0; i < 2000; ++i)
+        drs.update(i % 60 == 59 ? kTarget * 3.0f : kTarget * 0.9f);
+    EXPECT_EQ(drs.scale(), 1.0f);
+}
+
+TEST(DynamicResolution, BoundsAndBadSamples) {
+    DynamicResolutionController drs = controller();
+    run(drs, {10.0f, 100.0f}, 500);
+    EXPECT_EQ(drs.scale(), 0.5f);
+    // Over budget even at the lowest scale
+    EXPECT_EQ(run(drs, {10.0f, 100.0f}, 500), 0);
+
+    // Samples that are not a time leave everything as it is
+    const float smoothed = drs.smoothed_frame_ms();
+    for (float bad : {0.0f, -1.0f, NAN})
+        EXPECT_EQ(drs.update(bad), 0.5f);
+    EXPECT_EQ(drs.smoothed_frame_ms(), smoothed);
+
+    // Every scale it picks lies on the step grid or at a bound
+    drs.reset();
+    EXPECT_EQ(drs.scale(), 1.0f);
+    std::mt19937 rng(3);
+    for (int i = 0; i < 5000; ++i) {
+        drs.update(kTarget * std::uniform_real_distribution<float>(0.3f, 2.5f)(rng));
+        const float steps = drs.scale() / drs.config().step;
+        EXPECT_TRUE(drs.scale() >= 0.5f && drs.scale() <= 1.0f);
+        EXPECT_TRUE(std::fabs(steps - std::round(steps)) < 1e-3f);
+    }
+}
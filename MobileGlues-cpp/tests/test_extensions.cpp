@@ -0,0 +1,159 @@
+// MobileGlues - tests/test_extensions.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/getter.h"
+#include "gles/loader.h"
+#include "test_util.h"
+#include <set>
+
+namespace {
+    // Settings the exposed list depends on, pinned for the test and put
+    // back, with the list rebuilt, afterwards
+    struct ExtensionSettings {
+        HideMGEnvLevel hide = global_settings.hide_mg_env_level;
+        bool timer_query = global_settings.ext_timer_query;
+        bool compute_shader = global_settings.ext_compute_shader;
+        bool direct_state_access = global_settings.ext_direct_state_access;
+        Version version = GLVersion;
+        std::vector<std::string> backend;
+
+        ExtensionSettings() {
+            GLint n = 0;
+            MOCK_GL(glGetIntegerv)(GL_NUM_EXTENSIONS, &n);
+            for (GLint i = 0; i < n; ++i)
+                backend.emplace_back((const char*)MOCK_GL(glGetStringi)(GL_EXTENSIONS, (GLuint)i));
+            global_settings.hide_mg_env_level = HideMGEnvLevel::Disabled;
+            global_settings.ext_timer_query = true;
+            global_settings.ext_compute_shader = false;
+            global_settings.ext_direct_state_access = false;
+            GLVersion = Version(4, 0, 0);
+        }
+
+        ~ExtensionSettings() {
+            global_settings.hide_mg_env_level = hide;
+            global_settings.ext_timer_query = timer_query;
+            global_settings.ext_compute_shader = compute_shader;
+            global_settings.ext_direct_state_access = direct_state_access;
+            GLVersion = version;
+            mg_mock::set_extensions(backend);
+            InitGLESCapabilities();
+        }
+    };
+
+    std::vector<std::string> split(const char* s) {
+        std::vector<std::string> out;
+        std::istringstream in(s);
+        std::string name;
+        while (in >> name)
+            out.push_back(name);
+        return out;
+    }
+
+    bool exposed(const char* ext) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+            if (strcmp((const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i), ext) == 0) return true;
+        return false;
+    }
+
+    // What GL_EXTENSIONS read on the mock, with the settings above, before
+    // the registry replaced the appended string
+    const char* const kExpected =
+        "GL_MG_mobileglues GL_MG_backend_string_getter_access GL_MG_settings_string_dump GL_ARB_fragment_program "
+        "GL_ARB_vertex_buffer_object GL_ARB_vertex_array_object GL_ARB_vertex_buffer GL_EXT_vertex_array "
+        "GL_ARB_ES2_compatibility GL_ARB_ES3_compatibility GL_EXT_packed_depth_stencil GL_EXT_depth_texture "
+        "GL_ARB_depth_texture GL_ARB_shading_language_100 GL_ARB_imaging GL_ARB_draw_buffers_blend OpenGL15 "
+        "GL_ARB_shader_storage_buffer_object GL_ARB_shader_image_load_store GL_ARB_clear_texture "
+        "GL_ARB_get_program_binary GL_ARB_separate_shader_objects GL_ARB_multi_bind GL_KHR_no_error "
+        "GL_ARB_buffer_storage GL_ARB_timer_query GL_EXT_timer_query OpenGL32 OpenGL33 OpenGL40 "
+        "GL_ARB_vertex_attrib_binding ";
+} // namespace
+
+TEST(Extensions, ListMatchesThePreviousOutput) {
+    ExtensionSettings settings;
+    InitGLESCapabilities();
+    reset_gl_errors();
+
+    const char* joined = (const char*)glGetString(GL_EXTENSIONS);
+    ASSERT_TRUE(joined != nullptr);
+    EXPECT_EQ(std::string(joined), std::string(kExpected));
+    // Built once, not per call
+    EXPECT_TRUE((const char*)glGetString(GL_EXTENSIONS) == joined);
+
+    const std::vector<std::string> names = split(kExpected);
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    ASSERT_EQ(count, (GLint)names.size());
+    for (GLint i = 0; i < count; ++i) {
+        const char* name = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+        ASSERT_TRUE(name != nullptr);
+        EXPECT_EQ(std::string(name), names[i]);
+    }
+    EXPECT_TRUE(glGetStringi(GL_EXTENSIONS, (GLuint)count) == nullptr);
+    EXPECT_TRUE(!exposed("GL_ARB_bindless_texture"));
+    EXPECT_TRUE(!exposed("GL_ARB"));
+
+    // Appending shows up in every view, once
+    AppendExtension("GL_ARB_test_only");
+    AppendExtension("GL_ARB_test_only");
+    AppendExtension("GL_ARB_imaging");
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    EXPECT_EQ(count, (GLint)names.size() + 1);
+    EXPECT_EQ(std::string((const char*)glGetStringi(GL_EXTENSIONS, (GLuint)count - 1)), "GL_ARB_test_only");
+    EXPECT_EQ(std::string((const char*)glGetString(GL_EXTENSIONS)), std::string(kExpected) + "GL_ARB_test_only ");
+    EXPECT_TRUE(exposed("GL_ARB_test_only"));
+}
+
+TEST(Extensions, HiddenListIsShuffledNotChanged) {
+    ExtensionSettings settings;
+    global_settings.hide_mg_env_level = HideMGEnvLevel::Level1;
+    InitGLESCapabilities();
+
+    std::multiset<std::string> expected;
+    for (const std::string& name : split(kExpected))
+        if (name.rfind("GL_MG_", 0) != 0) expected.insert(name);
+    const std::vector<std::string> names = split((const char*)glGetString(GL_EXTENSIONS));
+    EXPECT_TRUE(std::multiset<std::string>(names.begin(), names.end()) == expected);
+    for (size_t i = 0; i < names.size(); ++i)
+        EXPECT_EQ(std::string((const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i)), names[i]);
+}
+
+TEST(Extensions, CapabilitiesFromTheBackend) {
+    ExtensionSettings settings;
+    mg_mock::set_extensions({"GL_OES_depth24", "GL_EXT_texture_query_lod", "GL_EXT_buffer_storage_x",
+                             "GL_QCOM_texture_lod_bias", "GL_EXT_texture_rg"});
+    InitGLESCapabilities();
+    EXPECT_EQ(g_gles_caps.GL_OES_depth24, 1);
+    EXPECT_EQ(g_gles_caps.GL_EXT_texture_query_lod, 1);
+    EXPECT_EQ(g_gles_caps.GL_QCOM_texture_lod_bias, 1);
+    EXPECT_EQ(g_gles_caps.GL_EXT_texture_rg, 1);
+    // Only whole names count
+    EXPECT_EQ(g_gles_caps.GL_EXT_buffer_storage, 0);
+    EXPECT_EQ(g_gles_caps.GL_EXT_disjoint_timer_query, 0);
+    EXPECT_EQ(g_gles_caps.GL_OES_mapbuffer, 0);
+    EXPECT_TRUE(!exposed("GL_ARB_buffer_storage"));
+    EXPECT_TRUE(!exposed("GL_ARB_timer_query"));
+}
+
+BENCH(Extensions, Startup) {
+    ExtensionSettings settings;
+    mg_mock::set_recording(false);
+    mg_test::measure("InitGLESCapabilities", 2000, "inits", [] { InitGLESCapabilities(); });
+
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    // What LWJGL does while creating its capabilities
+    mg_test::measure("GL_NUM_EXTENSIONS and glGetStringi", 20000, "extensions", [&] {
+        GLint n = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+        for (GLint i = 0; i < n; ++i)
+            glGetStringi(GL_EXTENSIONS, (GLuint)i);
+    }, (size_t)count);
+    mg_test::measure("glGetString(GL_EXTENSIONS)", 200000, "calls", [] { glGetString(GL_EXTENSIONS); });
+    mg_mock::set_recording(true);
+}
@@ -0,0 +1,372 @@
+// MobileGlues - tests/test_fixed_function.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "config/settings.h"
+#include "gl/fixed_function.h"
+#include "gl/immediate.h"
+#include "test_util.h"
+#include <cmath>
+#include <random>
+
+namespace {
+    // Column-major, straight from the formulas in the GL 2.1 specification
+    struct Mat {
+        double m[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+        Mat operator*(const Mat& b) const {
+            Mat r;
+            for (int col = 0; col < 4; ++col)
+                for (int row = 0; row < 4; ++row) {
+                    double sum = 0.0;
+                    for (int k = 0; k < 4; ++k)
+                        sum += m[k * 4 + row] * b.m[col * 4 + k];
+                    r.m[col * 4 + row] = sum;
+                }
+            return r;
+        }
+
+        Mat transposed() const {
+            Mat r;
+            for (int col = 0; col < 4; ++col)
+                for (int row = 0; row < 4; ++row)
+                    r.m[col * 4 + row] = m[row * 4 + col];
+            return r;
+        }
+    };
+
+    Mat translation(double x, double y, double z) {
+        Mat r;
+        r.m[12] = x;
+        r.m[13] = y;
+        r.m[14] = z;
+        return r;
+    }
+
+    Mat scaling(double x, double y, double z) {
+        Mat r;
+        r.m[0] = x;
+        r.m[5] = y;
+        r.m[10] = z;
+        return r;
+    }
+
+    Mat rotation(double degrees, double x, double y, double z) {
+        const double len = std::sqrt(x * x + y * y + z * z);
+        x /= len;
+        y /= len;
+        z /= len;
+        const double c = std::cos(degrees * M_PI / 180.0), s = std::sin(degrees * M_PI / 180.0), t = 1.0 - c;
+        Mat r;
+        r.m[0] = x * x * t + c;
+        r.m[1] = y * x * t + z * s;
+        r.m[2] = x * z * t - y * s;
+        r.m[4] = x * y * t - z * s;
+        r.m[5] = y * y * t + c;
+        r.m[6] = y * z * t + x * s;
+        r.m[8] = x * z * t + y * s;
+        r.m[9] = y * z * t - x * s;
+        r.m[10] = z * z * t + c;
+        return r;
+    }
+
+    Mat ortho(double l, double r, double b, double t, double n, double f) {
+        Mat o;
+        o.m[0] = 2.0 / (r - l);
+        o.m[5] = 2.0 / (t - b);
+        o.m[10] = -2.0 / (f - n);
+        o.m[12] = -(r + l) / (r - l);
+        o.m[13] = -(t + b) / (t - b);
+        o.m[14] = -(f + n) / (f - n);
+        return o;
+    }
+
+    Mat frustum(double l, double r, double b, double t, double n, double f) {
+        Mat o;
+        o.m[0] = 2.0 * n / (r - l);
+        o.m[5] = 2.0 * n / (t - b);
+        o.m[8] = (r + l) / (r - l);
+        o.m[9] = (t + b) / (t - b);
+        o.m[10] = -(f + n) / (f - n);
+        o.m[11] = -1.0;
+        o.m[14] = -2.0 * f * n / (f - n);
+        o.m[15] = 0.0;
+        return o;
+    }
+
+    // Within float rounding of the largest element
+    bool close_to(const GLfloat* actual, const Mat& expected) {
+        double scale = 1.0;
+        for (double v : expected.m)
+            scale = std::max(scale, std::fabs(v));
+        for (int i = 0; i < 16; ++i)
+            if (std::fabs(actual[i] - expected.m[i]) > 1e-5 * scale) return false;
+        return true;
+    }
+
+    bool matrix_is(GLenum pname, const Mat& expected) {
+        GLfloat m[16];
+        glGetFloatv(pname, m);
+        return close_to(m, expected);
+    }
+
+    GLint get_integer(GLenum pname) {
+        GLint value = -1;
+        glGetIntegerv(pname, &value);
+        return value;
+    }
+
+    GLint driver_integer(GLenum pname) {
+        GLint value = -1;
+        MOCK_GL(glGetIntegerv)(pname, &value);
+        return value;
+    }
+
+    void reset_matrices() {
+        reset_gl_errors();
+        glUseProgram(0);
+        glFinish();
+        glActiveTexture(GL_TEXTURE0);
+        for (GLenum mode : {GL_PROJECTION, GL_TEXTURE, GL_COLOR, GL_MODELVIEW}) {
+            glMatrixMode(mode);
+            glLoadIdentity();
+        }
+        mg_mock::clear_calls();
+        mg_mock::clear_draws();
+    }
+
+    void triangle() {
+        glBegin(GL_TRIANGLES);
+        glVertex2f(0.0f, 0.0f);
+        glVertex2f(1.0f, 0.0f);
+        glVertex2f(0.0f, 1.0f);
+        glEnd();
+    }
+
+    struct StateFilterOn {
+        bool saved = global_settings.state_filter;
+        StateFilterOn() { global_settings.state_filter = true; }
+        ~StateFilterOn() { global_settings.state_filter = saved; }
+    };
+} // namespace
+
+TEST(FixedFunction, MatricesMatchReferenceMath) {
+    reset_matrices();
+    std::mt19937 rng(19);
+    std::uniform_real_distribution<double> any(-10.0, 10.0);
+    std::uniform_real_distribution<double> factor(0.5, 2.0);
+    std::uniform_real_distribution<double> angle(-360.0, 360.0);
+
+    for (int round = 0; round < 200; ++round) {
+        glLoadIdentity();
+        Mat expected;
+        for (int op = 0; op < 8; ++op) {
+            Mat m;
+            switch (rng() % 6) {
+            case 0: {
+                const double x = any(rng), y = any(rng), z = any(rng);
+                glTranslatef((GLfloat)x, (GLfloat)y, (GLfloat)z);
+                m = translation((GLfloat)x, (GLfloat)y, (GLfloat)z);
+                break;
+            }
+            case 1: {
+                const double x = factor(rng), y = factor(rng), z = factor(rng);
+                glScaled(x, y, z);
+                m = scaling((GLfloat)x, (GLfloat)y, (GLfloat)z);
+                break;
+            }
+            case 2: {
+                const double a = angle(rng), x = any(rng), y = any(rng), z = any(rng);
+                glRotatef((GLfloat)a, (GLfloat)x, (GLfloat)y, (GLfloat)z);
+                m = rotation((GLfloat)a, (GLfloat)x, (GLfloat)y, (GLfloat)z);
+                break;
+            }
+            case 3: {
+                GLfloat raw[16];
+                for (int i = 0; i < 16; ++i) {
+                    raw[i] = (GLfloat)(any(rng) / 10.0);
+                    m.m[i] = raw[i];
+                }
+                glMultMatrixf(raw);
+                break;
+            }
+            case 4: {
+                GLdouble raw[16];
+                for (int i = 0; i < 16; ++i) {
+                    raw[i] = (GLfloat)(any(rng) / 10.0);
+                    m.m[i] = raw[i];
+                }
+                glMultTransposeMatrixd(raw);
+                m = m.transposed();
+                break;
+            }
+            default:
+                glOrtho(-2.0, 3.0, -1.0, 4.0, 0.5, 20.0);
+                m = ortho(-2.0, 3.0, -1.0, 4.0, 0.5, 20.0);
+                break;
+            }
+            expected = expected * m;
+        }
+        if (!matrix_is(GL_MODELVIEW_MATRIX, expected) ||
+            !matrix_is(GL_TRANSPOSE_MODELVIEW_MATRIX, expected.transposed())) {
+            mg_test::fail(__FILE__, __LINE__, "modelview differs in round " + std::to_string(round));
+            break;
+        }
+    }
+
+    glMatrixMode(GL_PROJECTION);
+    glFrustum(-1.0, 1.0, -0.75, 0.75, 1.0, 100.0);
+    EXPECT_TRUE(matrix_is(GL_PROJECTION_MATRIX, frustum(-1.0, 1.0, -0.75, 0.75, 1.0, 100.0)));
+    GLdouble d[16] = {};
+    glGetDoublev(GL_PROJECTION_MATRIX, d);
+    EXPECT_TRUE(std::fabs(d[11] + 1.0) < 1e-6);
+
+    // Invalid volumes leave the matrix alone
+    glFrustum(-1.0, 1.0, -1.0, 1.0, 0.0, 10.0);
+    glOrtho(1.0, 1.0, -1.0, 1.0, -1.0, 1.0);
+    EXPECT_TRUE(matrix_is(GL_PROJECTION_MATRIX, frustum(-1.0, 1.0, -0.75, 0.75, 1.0, 100.0)));
+    reset_matrices();
+}
+
+TEST(FixedFunction, StacksArePerModeAndUnit) {
+    reset_matrices();
+    glTranslatef(1.0f, 2.0f, 3.0f);
+    glPushMatrix();
+    EXPECT_EQ(get_integer(GL_MODELVIEW_STACK_DEPTH), 2);
+    glScalef(2.0f, 2.0f, 2.0f);
+    EXPECT_TRUE(matrix_is(GL_MODELVIEW_MATRIX, translation(1, 2, 3) * scaling(2, 2, 2)));
+    glPopMatrix();
+    EXPECT_TRUE(matrix_is(GL_MODELVIEW_MATRIX, translation(1, 2, 3)));
+    EXPECT_EQ(get_integer(GL_MODELVIEW_STACK_DEPTH), 1);
+
+    // Underflow and overflow are ignored
+    glPopMatrix();
+    EXPECT_EQ(get_integer(GL_MODELVIEW_STACK_DEPTH), 1);
+    for (int i = 0; i < 40; ++i)
+        glPushMatrix();
+    EXPECT_EQ(get_integer(GL_MODELVIEW_STACK_DEPTH), get_integer(GL_MAX_MODELVIEW_STACK_DEPTH));
+    for (int i = 0; i < 40; ++i)
+        glPopMatrix();
+    EXPECT_TRUE(matrix_is(GL_MODELVIEW_MATRIX, translation(1, 2, 3)));
+
+    glMatrixMode(GL_PROJECTION);
+    EXPECT_EQ(get_integer(GL_MATRIX_MODE), (GLint)GL_PROJECTION);
+    EXPECT_TRUE(matrix_is(GL_PROJECTION_MATRIX, Mat()));
+
+    // Each texture unit has its own texture matrix
+    glMatrixMode(GL_TEXTURE);
+    glActiveTexture(GL_TEXTURE1);
+    glScalef(0.5f, 0.5f, 1.0f);
+    EXPECT_TRUE(matrix_is(GL_TEXTURE_MATRIX, scaling(0.5, 0.5, 1)));
+    glActiveTexture(GL_TEXTURE0);
+    EXPECT_TRUE(matrix_is(GL_TEXTURE_MATRIX, Mat()));
+    glActiveTexture(GL_TEXTURE1);
+    glLoadIdentity();
+
+    reset_matrices();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(FixedFunction, MatricesAreUploadedOnlyWhenTheyChange) {
+    reset_matrices();
+    glMatrixMode(GL_PROJECTION);
+    glOrtho(0.0, 64.0, 0.0, 64.0, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glTranslatef(3.0f, 4.0f, 0.0f);
+
+    triangle();
+    glFinish();
+    EXPECT_EQ(mg_mock::count("glUniformMatrix4fv"), (size_t)2);
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+    const GLuint program = mg_mock::draws()[0].program;
+    std::vector<uint32_t> bits = mg_mock::uniform_value(program, MOCK_GL(glGetUniformLocation)(program, "uMVP"));
+    ASSERT_EQ(bits.size(), (size_t)16);
+    GLfloat mvp[16];
+    memcpy(mvp, bits.data(), sizeof(mvp));
+    EXPECT_TRUE(close_to(mvp, ortho(0, 64, 0, 64, -1, 1) * translation(3, 4, 0)));
+
+    // Unchanged matrices, and a push/pop that leaves them as they were
+    mg_mock::clear_calls();
+    triangle();
+    glFinish();
+    glPushMatrix();
+    glPopMatrix();
+    triangle();
+    glFinish();
+    EXPECT_EQ(mg_mock::count("glUniformMatrix4fv"), (size_t)0);
+
+    // Geometry is drawn with the matrices it was specified under
+    mg_mock::clear_draws();
+    glPushMatrix();
+    glTranslatef(1.0f, 0.0f, 0.0f);
+    triangle();
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)0);
+    glPopMatrix();
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)1);
+
+    reset_matrices();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(FixedFunction, PopAttribRestoresFromItsSnapshot) {
+    reset_matrices();
+    StateFilterOn filter;
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glColor4f(0.5f, 0.25f, 0.125f, 1.0f);
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_CURRENT_BIT | GL_TRANSFORM_BIT | GL_TEXTURE_BIT);
+    EXPECT_EQ(get_integer(GL_ATTRIB_STACK_DEPTH), 1);
+    glEnable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_GREATER);
+    glColor3f(1.0f, 0.0f, 0.0f);
+    glMatrixMode(GL_PROJECTION);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    mg_mock::clear_calls();
+    glPopAttrib();
+    for (const mg_mock::Call& call : mg_mock::calls())
+        EXPECT_TRUE(strncmp(call.name, "glGet", 5) != 0);
+    EXPECT_EQ(driver_integer(GL_BLEND), 0);
+    EXPECT_EQ(driver_integer(GL_DEPTH_TEST), 0);
+    EXPECT_EQ(driver_integer(GL_DEPTH_FUNC), (GLint)GL_LESS);
+    EXPECT_EQ(driver_integer(GL_ACTIVE_TEXTURE), (GLint)GL_TEXTURE0);
+    MOCK_GL(glActiveTexture)(GL_TEXTURE1);
+    EXPECT_EQ(driver_integer(GL_TEXTURE_BINDING_2D), 0);
+    MOCK_GL(glActiveTexture)(GL_TEXTURE0);
+    EXPECT_EQ(get_integer(GL_MATRIX_MODE), (GLint)GL_MODELVIEW);
+    GLfloat color[4];
+    glGetFloatv(GL_CURRENT_COLOR, color);
+    EXPECT_TRUE(color[0] == 0.5f && color[1] == 0.25f && color[2] == 0.125f && color[3] == 1.0f);
+    EXPECT_EQ(get_integer(GL_ATTRIB_STACK_DEPTH), 0);
+
+    // Popping state that did not change costs no driver calls at all, even
+    // without the redundant call filter
+    for (bool filtered : {true, false}) {
+        global_settings.state_filter = filtered;
+        glPushAttrib(GL_ALL_ATTRIB_BITS);
+        mg_mock::clear_calls();
+        glPopAttrib();
+        EXPECT_EQ(mg_mock::calls().size(), (size_t)0);
+    }
+    global_settings.state_filter = true;
+
+    // Groups outside the mask are left as they are
+    glPushAttrib(GL_CURRENT_BIT);
+    glEnable(GL_BLEND);
+    glPopAttrib();
+    EXPECT_EQ(driver_integer(GL_BLEND), 1);
+    glDisable(GL_BLEND);
+
+    glDeleteTextures(1, &texture);
+    reset_matrices();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
@@ -0,0 +1,196 @@
+// MobileGlues - tests/test_framebuffer.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/framebuffer.h"
+#include "test_util.h"
+
+namespace {
+    // A framebuffer with textures on its first three color attachments, the
+    // way a shader pack sets up its G-buffer
+    struct GBuffer {
+        GLuint fbo = 0;
+        GLuint textures[3] = {};
+
+        GBuffer() {
+            reset_gl_errors();
+            glGenTextures(3, textures);
+            glGenFramebuffers(1, &fbo);
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+            for (GLuint i = 0; i < 3; ++i)
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, textures[i], 0);
+            mg_mock::clear_calls();
+        }
+
+        ~GBuffer() {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &fbo);
+            glDeleteTextures(3, textures);
+        }
+
+        // Texture the driver has in color attachment slot
+        GLuint physical(GLuint slot) const {
+            return mg_mock::fbo_attachment(fbo, GL_COLOR_ATTACHMENT0 + slot).name;
+        }
+    };
+
+    void draw_buffers(std::initializer_list<GLenum> bufs) {
+        glDrawBuffers((GLsizei)bufs.size(), bufs.begin());
+    }
+
+    size_t attaches() {
+        return mg_mock::count("glFramebufferTexture2D");
+    }
+} // namespace
+
+TEST(Framebuffer, DrawBuffersRemapOnlyChangedSlots) {
+    GBuffer g;
+    // Already where GLES wants them
+    draw_buffers({GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1});
+    EXPECT_EQ(attaches(), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glDrawBuffers"), (size_t)1);
+
+    // The same list again reaches the driver not at all
+    mg_mock::clear_calls();
+    draw_buffers({GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1});
+    EXPECT_EQ(attaches(), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glDrawBuffers"), (size_t)0);
+
+    // Attachment 2 is drawn through slot 0
+    mg_mock::clear_calls();
+    draw_buffers({GL_COLOR_ATTACHMENT2});
+    EXPECT_EQ(attaches(), (size_t)1);
+    EXPECT_EQ(g.physical(0), g.textures[2]);
+    EXPECT_TRUE(mg_mock::fbo_draw_buffers(g.fbo) == (std::vector<GLenum>{GL_COLOR_ATTACHMENT0}));
+
+    // Going back touches slot 0 only, slot 1 still holds attachment 1
+    mg_mock::clear_calls();
+    draw_buffers({GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1});
+    EXPECT_EQ(attaches(), (size_t)1);
+    EXPECT_EQ(g.physical(0), g.textures[0]);
+    EXPECT_EQ(g.physical(1), g.textures[1]);
+
+    // Passes alternating between two lists, as deferred pipelines do every frame
+    mg_mock::clear_calls();
+    for (int pass = 0; pass < 10; ++pass) {
+        if (pass % 2) {
+            draw_buffers({GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT1});
+            EXPECT_EQ(g.physical(0), g.textures[2]);
+        } else {
+            draw_buffers({GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1});
+            EXPECT_EQ(g.physical(0), g.textures[0]);
+        }
+        EXPECT_EQ(g.physical(1), g.textures[1]);
+    }
+    EXPECT_EQ(attaches(), (size_t)9);
+    EXPECT_EQ(mg_mock::count("glDrawBuffers"), (size_t)0);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Framebuffer, ReadBufferSharesTheSlots) {
+    GBuffer g;
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    EXPECT_EQ(attaches(), (size_t)1);
+    EXPECT_EQ(g.physical(0), g.textures[1]);
+    std::vector<mg_mock::Call> reads = mg_mock::calls_named("glReadBuffer");
+    ASSERT_EQ(reads.size(), (size_t)1);
+    EXPECT_EQ(reads[0].args[0], (uint64_t)GL_COLOR_ATTACHMENT0);
+
+    mg_mock::clear_calls();
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    EXPECT_EQ(attaches(), (size_t)0);
+
+    // Drawing to attachment 0 has to put it back into slot 0
+    mg_mock::clear_calls();
+    draw_buffers({GL_COLOR_ATTACHMENT0});
+    EXPECT_EQ(attaches(), (size_t)1);
+    EXPECT_EQ(g.physical(0), g.textures[0]);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Framebuffer, OtherAttachmentsInvalidateTheSlot) {
+    GBuffer g;
+    draw_buffers({GL_COLOR_ATTACHMENT1});
+    EXPECT_EQ(g.physical(0), g.textures[1]);
+
+    // A renderbuffer replaces what the remap put into slot 0
+    GLuint renderbuffer = 0;
+    glGenRenderbuffers(1, &renderbuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffer);
+    EXPECT_EQ(mg_mock::fbo_attachment(g.fbo, GL_COLOR_ATTACHMENT0).type, (GLenum)GL_RENDERBUFFER);
+    mg_mock::clear_calls();
+    draw_buffers({GL_COLOR_ATTACHMENT1});
+    EXPECT_EQ(attaches(), (size_t)1);
+    EXPECT_EQ(g.physical(0), g.textures[1]);
+    EXPECT_EQ(mg_mock::fbo_attachment(g.fbo, GL_COLOR_ATTACHMENT0).type, (GLenum)GL_TEXTURE);
+
+    // So does a texture layer
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, g.textures[2], 0, 1);
+    mg_mock::clear_calls();
+    draw_buffers({GL_COLOR_ATTACHMENT1});
+    EXPECT_EQ(attaches(), (size_t)1);
+    EXPECT_EQ(g.physical(0), g.textures[1]);
+    EXPECT_EQ(mg_mock::fbo_attachment(g.fbo, GL_COLOR_ATTACHMENT0).layer, 0);
+
+    glDeleteRenderbuffers(1, &renderbuffer);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Framebuffer, DeletedNamesStartOver) {
+    GLuint fbo = 0, texture = 0;
+    {
+        GBuffer g;
+        draw_buffers({GL_COLOR_ATTACHMENT1});
+        fbo = g.fbo;
+        texture = g.textures[1];
+    }
+
+    // A new framebuffer under the same name holds nothing in the driver
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, texture, 0);
+    mg_mock::clear_calls();
+    draw_buffers({GL_COLOR_ATTACHMENT1});
+    EXPECT_EQ(attaches(), (size_t)1);
+    EXPECT_EQ(mg_mock::count("glDrawBuffers"), (size_t)1);
+    EXPECT_EQ(mg_mock::fbo_attachment(fbo, GL_COLOR_ATTACHMENT0).name, texture);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Framebuffer, DeletedTexturesLeaveTheSlots) {
+    GBuffer g;
+    draw_buffers({GL_COLOR_ATTACHMENT1});
+    EXPECT_EQ(g.physical(0), g.textures[1]);
+
+    // The driver hands the name out again for a new texture, which the
+    // application attaches where the old one was
+    const GLuint texture = g.textures[1];
+    glDeleteTextures(1, &texture);
+    EXPECT_EQ(g.physical(0), (GLuint)0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, texture, 0);
+    mg_mock::clear_calls();
+    draw_buffers({GL_COLOR_ATTACHMENT1});
+    EXPECT_EQ(attaches(), (size_t)1);
+    EXPECT_EQ(g.physical(0), texture);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+BENCH(Framebuffer, DeferredPasses) {
+    mg_mock::set_recording(false);
+    GBuffer g;
+    mg_test::measure("alternating draw buffer lists", 100000, "passes", [] {
+        draw_buffers({GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1});
+        draw_buffers({GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT1});
+    }, 2);
+    mg_test::measure("repeated draw buffer list", 100000, "passes", [] {
+        draw_buffers({GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1});
+    }, 1);
+    mg_mock::set_recording(true);
+}
@@ -0,0 +1,118 @@
+// MobileGlues - tests/test_fsr1.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/FSR1/FSR1.h"
+#include "test_util.h"
+#include <cmath>
+
+namespace {
+    float from_bits(uint32_t bits) {
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    double from_half(uint32_t half) {
+        const int exponent = (int)((half >> 10) & 0x1fu);
+        const double mantissa = (double)(half & 0x3ffu) / 1024.0;
+        const double value = exponent == 0 ? std::ldexp(mantissa, -14) : std::ldexp(1.0 + mantissa, exponent - 15);
+        return (half & 0x8000u) ? -value : value;
+    }
+
+    // Within a couple of float roundings of the exact value
+    bool close_to(float actual, double expected) {
+        return std::fabs((double)actual - expected) <= std::fabs(expected) * 0x1p-22 + 1e-30;
+    }
+
+    // FsrEasuCon from ffx_fsr1.h, in double
+    void easu_reference(double con[16], double viewportWidth, double viewportHeight, double inputWidth,
+                        double inputHeight, double outputWidth, double outputHeight) {
+        const double rw = 1.0 / inputWidth, rh = 1.0 / inputHeight;
+        const double values[16] = {viewportWidth / outputWidth,
+                                   viewportHeight / outputHeight,
+                                   0.5 * viewportWidth / outputWidth - 0.5,
+                                   0.5 * viewportHeight / outputHeight - 0.5,
+                                   rw,
+                                   rh,
+                                   rw,
+                                   -rh,
+                                   -rw,
+                                   2.0 * rh,
+                                   rw,
+                                   2.0 * rh,
+                                   0.0,
+                                   4.0 * rh,
+                                   0.0,
+                                   0.0};
+        memcpy(con, values, sizeof(values));
+    }
+} // namespace
+
+TEST(FSR1, EasuConstantsMatchReference) {
+    struct Case {
+        float viewport[2], input[2], output[2];
+    };
+    const Case cases[] = {
+        {{1200, 540}, {1200, 540}, {2400, 1080}},
+        {{1280, 720}, {1280, 720}, {1920, 1080}},
+        {{1917, 1079}, {1917, 1079}, {2876, 1620}},
+        // Dynamic resolution draws into the lower left part of the input
+        {{843, 379}, {1200, 540}, {1200, 540}},
+        {{1, 1}, {1, 1}, {1, 1}},
+    };
+    for (const Case& c : cases) {
+        uint32_t con[16];
+        double expected[16];
+        FsrEasuConstants(con, c.viewport[0], c.viewport[1], c.input[0], c.input[1], c.output[0], c.output[1]);
+        easu_reference(expected, c.viewport[0], c.viewport[1], c.input[0], c.input[1], c.output[0], c.output[1]);
+        for (int i = 0; i < 16; ++i) {
+            if (!close_to(from_bits(con[i]), expected[i])) {
+                mg_test::fail(__FILE__, __LINE__,
+                              "con[" + std::to_string(i) + "] = " + std::to_string(from_bits(con[i])) + ", expected " +
+                                  std::to_string(expected[i]));
+            }
+        }
+        EXPECT_EQ(con[14], 0u);
+        EXPECT_EQ(con[15], 0u);
+    }
+
+    // Exact in float, so exact in the bits
+    uint32_t con[16];
+    FsrEasuConstants(con, 1200, 540, 1200, 540, 2400, 1080);
+    EXPECT_EQ(from_bits(con[0]), 0.5f);
+    EXPECT_EQ(from_bits(con[2]), -0.25f);
+    EXPECT_EQ(con[12], 0u);
+}
+
+TEST(FSR1, RcasConstantsMatchReference) {
+    for (int strength = 0; strength <= 10; ++strength) {
+        const float stops = FsrSharpnessStops(strength);
+        EXPECT_TRUE(close_to(stops, (10 - strength) * 0.2));
+
+        uint32_t con[4];
+        FsrRcasConstants(con, stops);
+        const double sharpness = std::exp2(-(double)stops);
+        EXPECT_TRUE(close_to(from_bits(con[0]), sharpness));
+
+        // Both halves of con[1] hold the nearest half to the scale
+        const uint32_t half = con[1] & 0xffffu;
+        EXPECT_EQ(con[1] >> 16, half);
+        const double error = std::fabs(from_half(half) - sharpness);
+        EXPECT_TRUE(error <= std::fabs(from_half(half + 1) - sharpness));
+        EXPECT_TRUE(error <= std::fabs(from_half(half - 1) - sharpness));
+        EXPECT_EQ(con[2], 0u);
+        EXPECT_EQ(con[3], 0u);
+    }
+
+    uint32_t con[4];
+    FsrRcasConstants(con, FsrSharpnessStops(10));
+    EXPECT_EQ(con[0], 0x3f800000u);
+    EXPECT_EQ(con[1], 0x3c003c00u);
+    FsrRcasConstants(con, 2.0f);
+    EXPECT_EQ(con[0], 0x3e800000u);
+    EXPECT_EQ(con[1], 0x34003400u);
+}
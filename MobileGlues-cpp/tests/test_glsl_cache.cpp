@@ -0,0 +1,189 @@
+// MobileGlues - tests/test_glsl_cache.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "config/config.h"
+#include "gl/glsl/cache.h"
+#include "test_util.h"
+#include <unistd.h>
+
+namespace {
+    // Points an enabled cache at its own log and index for the lifetime of the test
+    struct ScopedCacheFiles {
+        std::string log, index;
+        char* saved_log;
+        char* saved_index;
+        size_t saved_size;
+
+        explicit ScopedCacheFiles(const char* name)
+            : log(std::string(getenv("MG_DIR_PATH")) + "/" + name + ".log"), index(log + ".idx"),
+              saved_log(glsl_cache_file_path), saved_index(glsl_cache_index_path),
+              saved_size(global_settings.max_glsl_cache_size) {
+            global_settings.max_glsl_cache_size = 32 * 1024 * 1024;
+            unlink(log.c_str());
+            unlink(index.c_str());
+            glsl_cache_file_path = log.data();
+            glsl_cache_index_path = index.data();
+        }
+        ~ScopedCacheFiles() {
+            glsl_cache_file_path = saved_log;
+            glsl_cache_index_path = saved_index;
+            global_settings.max_glsl_cache_size = saved_size;
+            unlink(log.c_str());
+            unlink(index.c_str());
+        }
+    };
+
+    std::string key_of(int i) { return "glsl source #" + std::to_string(i); }
+    std::string essl_of(int i) { return "#version 320 es\n// translated " + std::to_string(i) + "\n"; }
+
+    void fill(int count) {
+        Cache cache;
+        for (int i = 0; i < count; ++i)
+            cache.put(key_of(i).c_str(), essl_of(i).c_str());
+    }
+
+    void write_file(const std::string& path, const std::string& data) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), (std::streamsize)data.size());
+    }
+
+    // Every hit must be exactly what was stored; returns the number of hits
+    int check_hits(Cache& cache, int count) {
+        int hits = 0;
+        for (int i = 0; i < count; ++i) {
+            std::string essl;
+            if (!cache.get(key_of(i).c_str(), essl)) continue;
+            EXPECT_EQ(essl, essl_of(i));
+            ++hits;
+        }
+        return hits;
+    }
+} // namespace
+
+TEST(GlslCache, ReopensFromIndex) {
+    ScopedCacheFiles files("reopen");
+    fill(50);
+    EXPECT_TRUE(std::filesystem::exists(files.index));
+    Cache cache;
+    EXPECT_EQ(check_hits(cache, 50), 50);
+}
+
+TEST(GlslCache, RecordsAfterTheIndexAreScanned) {
+    ScopedCacheFiles files("tail");
+    fill(20);
+    std::string index = read_text_file(files.index);
+    {
+        Cache cache;
+        for (int i = 20; i < 30; ++i)
+            cache.put(key_of(i).c_str(), essl_of(i).c_str());
+    }
+    // As if the process died before it could rewrite the index
+    write_file(files.index, index);
+    Cache cache;
+    EXPECT_EQ(check_hits(cache, 30), 30);
+}
+
+// Cutting the log anywhere, with or without the index of the complete log,
+// must keep exactly the records that are still whole and nothing else.
+TEST(GlslCache, TruncatedLogKeepsWholeRecords) {
+    ScopedCacheFiles files("truncate");
+    const int count = 12;
+    fill(count);
+    std::string log = read_text_file(files.log);
+    std::string index = read_text_file(files.index);
+
+    // Record i ends at ends[i]
+    ASSERT_TRUE(!log.empty());
+    std::vector<size_t> ends;
+    size_t header_size = log.size();
+    for (int i = 0; i < count; ++i)
+        header_size -= essl_of(i).size() + 44; // RecordHeader is 44 bytes
+    size_t end = header_size;
+    for (int i = 0; i < count; ++i) {
+        end += essl_of(i).size() + 44;
+        ends.push_back(end);
+    }
+    ASSERT_EQ(ends.back(), log.size());
+
+    for (size_t cut = 0; cut <= log.size(); cut += 7) {
+        for (bool keep_index : {false, true}) {
+            write_file(files.log, log.substr(0, cut));
+            if (keep_index) {
+                write_file(files.index, index);
+            } else {
+                unlink(files.index.c_str());
+            }
+            int whole = 0;
+            while (whole < count && ends[whole] <= cut)
+                ++whole;
+            Cache cache;
+            EXPECT_EQ(check_hits(cache, count), whole);
+        }
+    }
+}
+
+TEST(GlslCache, CorruptRecordIsDroppedOnFirstHit) {
+    ScopedCacheFiles files("corrupt");
+    fill(10);
+    std::string log = read_text_file(files.log);
+    std::string needle = "translated 4\n";
+    size_t at = log.find(needle);
+    ASSERT_TRUE(at != std::string::npos);
+    log[at] = 'T';
+    write_file(files.log, log);
+
+    {
+        Cache cache; // served from the index, so the damage is only seen on the hit
+        std::string essl;
+        EXPECT_FALSE(cache.get(key_of(4).c_str(), essl));
+        EXPECT_EQ(check_hits(cache, 10), 9);
+    }
+    // Without the index, the scan stops at the bad record
+    unlink(files.index.c_str());
+    Cache cache;
+    EXPECT_EQ(check_hits(cache, 10), 4);
+}
+
+// Two processes appending to the same log in turn
+TEST(GlslCache, SharedLogKeepsEveryWritersRecords) {
+    ScopedCacheFiles files("shared");
+    {
+        Cache first;
+        Cache second;
+        for (int i = 0; i < 15; ++i) {
+            Cache& writer = i / 5 == 1 ? second : first;
+            writer.put(key_of(i).c_str(), essl_of(i).c_str());
+        }
+        // The first writer's index, which is written last, still has its own records right
+    }
+    {
+        Cache cache;
+        std::string essl;
+        for (int i : {0, 4, 10, 14}) {
+            EXPECT_TRUE(cache.get(key_of(i).c_str(), essl));
+            EXPECT_EQ(essl, essl_of(i));
+        }
+    }
+    unlink(files.index.c_str());
+    Cache cache;
+    EXPECT_EQ(check_hits(cache, 15), 15);
+}
+
+BENCH(GlslCache, Startup) {
+    ScopedCacheFiles files("startup");
+    fill(2000);
+    std::string index = read_text_file(files.index);
+    mg_test::measure("open with index", 20, "entries", [&] { Cache cache; }, 2000);
+    mg_test::measure(
+        "open by scanning", 20, "entries",
+        [&] {
+            unlink(files.index.c_str());
+            Cache cache;
+        },
+        2000);
+    write_file(files.index, index);
+}
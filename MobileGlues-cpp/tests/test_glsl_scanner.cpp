@@ -0,0 +1,196 @@
+// MobileGlues - tests/test_glsl_scanner.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/glsl/glsl_for_es.h"
+#include "gl/glsl/glsl_scanner.h"
+#include "reference/glsl_regex.h"
+#include "test_util.h"
+
+namespace {
+    using Preprocess = std::string (*)(const std::string&, GLenum, bool*);
+
+    // Fixed environment for the preprocessing goldens, and the version macro
+    // masked so they survive version bumps
+    std::string preprocess_for_golden(const std::string& glsl, GLenum type, Preprocess preprocess = preprocess_glsl) {
+        bool saved_emulate = hardware->emulate_texture_buffer;
+        bool saved_lod = g_gles_caps.GL_EXT_texture_query_lod;
+        hardware->emulate_texture_buffer = true;
+        g_gles_caps.GL_EXT_texture_query_lod = false;
+        bool atomic = false;
+        std::string out = preprocess(glsl, type, &atomic);
+        hardware->emulate_texture_buffer = saved_emulate;
+        g_gles_caps.GL_EXT_texture_query_lod = saved_lod;
+
+        const std::string macro = "#define MG_MOBILEGLUES_VERSION ";
+        size_t at = out.find(macro);
+        if (at != std::string::npos) out.replace(at + macro.size(), out.find('\n', at) - at - macro.size(), "<version>");
+        return out;
+    }
+
+    // preprocess_glsl over tests/corpus/<dir> against the files in its expected/.
+    // With MG_UPDATE_GOLDEN=1 they are rewritten from `golden` instead.
+    void check_goldens(const char* dir, Preprocess golden) {
+        bool update = getenv("MG_UPDATE_GOLDEN") != nullptr;
+        auto files = corpus_files(dir);
+        ASSERT_TRUE(!files.empty());
+        for (const auto& path : files) {
+            std::filesystem::path expected_path = path.parent_path() / "expected" / path.filename();
+            if (update) {
+                std::filesystem::create_directories(expected_path.parent_path());
+                std::ofstream(expected_path, std::ios::binary)
+                    << preprocess_for_golden(read_text_file(path), shader_type_of(path), golden);
+                continue;
+            }
+            ASSERT_TRUE(std::filesystem::exists(expected_path));
+            std::string got = preprocess_for_golden(read_text_file(path), shader_type_of(path));
+            if (got != read_text_file(expected_path)) mg_test::fail(__FILE__, __LINE__, "differs: " + path.string());
+        }
+    }
+
+    size_t position_of(std::string_view src, std::string_view needle) { return src.find(needle); }
+} // namespace
+
+TEST(GlslScanner, SkipsCommentsStringsAndDirectives) {
+    std::string_view src = "#define A 1 // out a\n"
+                           "out vec4 a; // out b\n"
+                           "/* out c\n out d */ out vec4 e;\n"
+                           "#line 3 \"out.glsl\"\n";
+    GLSLCodeMap map(src);
+    EXPECT_FALSE(map.isCode(position_of(src, "define")));
+    EXPECT_TRUE(map.isCode(position_of(src, "out vec4 a")));
+    EXPECT_FALSE(map.isCode(position_of(src, "out b")));
+    EXPECT_FALSE(map.isCode(position_of(src, "out d")));
+    EXPECT_TRUE(map.isCode(position_of(src, "out vec4 e")));
+    EXPECT_FALSE(map.isCode(position_of(src, "out.glsl")));
+    EXPECT_EQ(map.find("out"), position_of(src, "out vec4 a"));
+    EXPECT_EQ(map.find("out", position_of(src, "a;")), position_of(src, "out vec4 e"));
+    EXPECT_EQ(map.find("vec"), std::string_view::npos); // whole words only
+    ASSERT_EQ(map.directives().size(), (size_t)2);
+    EXPECT_TRUE(map.directives()[0].name == "define");
+    EXPECT_EQ(map.directives()[0].text, std::string(" A 1 "));
+}
+
+TEST(GlslScanner, EvaluatesStaticConditionals) {
+    std::string_view src = "#define KNOWN\n"
+                           "#if 0\nzero\n#elif 1\none\n#else\nother\n#endif\n"
+                           "#ifdef KNOWN\nknown\n#else\nnotknown\n#endif\n"
+                           "#ifdef DRIVER_MACRO\ndriver\n#else\nnodriver\n#endif\n"
+                           "#undef KNOWN\n"
+                           "#if defined(KNOWN) \\\n || 0\ncontinued\n#endif\n"
+                           "#ifndef KNOWN\n#if 0\nnested\n#endif\nafter\n#endif\n";
+    GLSLCodeMap map(src);
+    EXPECT_FALSE(map.isCode(position_of(src, "zero")));
+    EXPECT_TRUE(map.isCode(position_of(src, "one")));
+    EXPECT_FALSE(map.isCode(position_of(src, "other")));
+    EXPECT_TRUE(map.isCode(position_of(src, "known\n#else")));
+    EXPECT_FALSE(map.isCode(position_of(src, "notknown")));
+    // Unknown to the source, either branch may be compiled
+    EXPECT_TRUE(map.isCode(position_of(src, "driver")));
+    EXPECT_TRUE(map.isCode(position_of(src, "nodriver")));
+    // `|| 0` is beyond what is evaluated, so the group is kept
+    EXPECT_TRUE(map.isCode(position_of(src, "continued")));
+    EXPECT_FALSE(map.isCode(position_of(src, "nested")));
+    EXPECT_TRUE(map.isCode(position_of(src, "after")));
+}
+
+TEST(GlslScanner, FollowsLineDirectives) {
+    std::string_view src = "a\nb\n#line 100\nc\nd\n// #line 5\ne\n";
+    GLSLCodeMap map(src);
+    EXPECT_EQ(map.lineAt(position_of(src, "a")), 1);
+    EXPECT_EQ(map.lineAt(position_of(src, "b")), 2);
+    EXPECT_EQ(map.lineAt(position_of(src, "c")), 100);
+    EXPECT_EQ(map.lineAt(position_of(src, "d")), 101);
+    EXPECT_EQ(map.lineAt(position_of(src, "\ne\n") + 1), 103);
+}
+
+TEST(GlslScanner, SplitsCallArguments) {
+    std::string_view src = "f( a, g(b, c)[1] , (d + e) * 2 ) tail";
+    GLSLScanner scanner(src, 1);
+    std::vector<std::string_view> args;
+    ASSERT_TRUE(scanner.consumeArguments(args));
+    ASSERT_EQ(args.size(), (size_t)3);
+    EXPECT_TRUE(args[0] == "a");
+    EXPECT_TRUE(args[1] == "g(b, c)[1]");
+    EXPECT_TRUE(args[2] == "(d + e) * 2");
+    EXPECT_EQ(scanner.position(), position_of(src, " tail"));
+
+    GLSLScanner unbalanced("(a, (b)", 0);
+    EXPECT_FALSE(unbalanced.consumeArguments(args));
+    EXPECT_EQ(unbalanced.position(), (size_t)0);
+}
+
+TEST(GlslScanner, AppliesEditsInOnePass) {
+    std::string_view src = "uniform isamplerBuffer data; x = texelFetch(data, i);";
+    GLSLEdits edits;
+    edits.replace(position_of(src, "texelFetch"), src.size() - 1, "texelFetch(data, bufferCoords(i), 0)");
+    edits.replace(position_of(src, "isamplerBuffer"), position_of(src, " data;"), "isampler2D");
+    edits.insert(0, "// header\n");
+    edits.replace(position_of(src, "Fetch"), position_of(src, "(data, i)"), "dropped, overlaps");
+    EXPECT_EQ(edits.apply(src),
+              std::string("// header\nuniform isampler2D data; x = texelFetch(data, bufferCoords(i), 0);"));
+    EXPECT_TRUE(edits.empty());
+}
+
+TEST(GlslScanner, VersionIgnoresComments) {
+    EXPECT_EQ(getGLSLVersion("// #version 110\n#version 330 core\n"), 330);
+    EXPECT_EQ(getGLSLVersion("/* #version 460 */ void main() {}"), -1);
+}
+
+// Shaderpack sources, whose expected/ files come from the regex
+// implementation the scanner replaced (tests/reference)
+TEST(GlslScanner, PreprocessGoldenCorpus) {
+    check_goldens("preprocess", reference::preprocess_glsl);
+}
+
+// Sources the regex implementation got wrong: matches inside comments and
+// disabled groups, spaced #line directives, the buffer texelFetch rewrite.
+// Their expected/ files are the scanner's output, reviewed by hand.
+TEST(GlslScanner, PreprocessFixesCorpus) {
+    check_goldens("preprocess_fixes", preprocess_glsl);
+    for (const auto& path : corpus_files("preprocess_fixes")) {
+        std::string glsl = read_text_file(path);
+        // Otherwise it belongs in the golden corpus
+        if (preprocess_for_golden(glsl, shader_type_of(path), reference::preprocess_glsl) ==
+            preprocess_for_golden(glsl, shader_type_of(path)))
+            mg_test::fail(__FILE__, __LINE__, "same as the regex output: " + path.string());
+    }
+}
+
+BENCH(GlslScanner, Preprocess) {
+    std::vector<std::pair<std::string, GLenum>> corpus;
+    size_t bytes = 0;
+    for (const char* dir : {"glsl", "preprocess", "preprocess_fixes"}) {
+        for (const auto& path : corpus_files(dir)) {
+            corpus.emplace_back(read_text_file(path), shader_type_of(path));
+            bytes += corpus.back().first.size();
+        }
+    }
+    double mb = bytes / (1024.0 * 1024.0);
+    mg_test::measure(
+        "code map", 2000, "MB",
+        [&] {
+            for (const auto& [glsl, type] : corpus)
+                GLSLCodeMap map(glsl);
+        },
+        mb);
+    double scanner = mg_test::measure(
+        "preprocess_glsl", 2000, "MB",
+        [&] {
+            for (const auto& [glsl, type] : corpus)
+                preprocess_for_golden(glsl, type);
+        },
+        mb);
+    double regex = mg_test::measure(
+        "preprocess_glsl, regex baseline", 20, "MB",
+        [&] {
+            for (const auto& [glsl, type] : corpus)
+                preprocess_for_golden(glsl, type, reference::preprocess_glsl);
+        },
+        mb);
+    printf("    scanner %.1fx the regex baseline over %zu sources, %.1f KB\n", regex / scanner, corpus.size(),
+           bytes / 1024.0);
+}
@@ -0,0 +1,282 @@
+// MobileGlues - tests/test_immediate.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/immediate.h"
+#include "test_util.h"
+
+namespace {
+    // Starts every test with nothing pending, white, and no program bound
+    void reset_immediate() {
+        reset_gl_errors();
+        glUseProgram(0);
+        glDisable(GL_TEXTURE_2D);
+        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        glFinish();
+        mg_mock::clear_calls();
+        mg_mock::clear_draws();
+    }
+
+    const mg_mock::DrawAttrib* attrib(const mg_mock::Draw& draw, GLuint index) {
+        for (const mg_mock::DrawAttrib& a : draw.attribs)
+            if (a.index == index) return &a;
+        return nullptr;
+    }
+
+    // x of every vertex the draw read, which the tests use as vertex ids
+    std::vector<float> xs(const mg_mock::Draw& draw) {
+        std::vector<float> out;
+        const mg_mock::DrawAttrib* a = attrib(draw, IMMEDIATE_ATTRIB_POSITION);
+        if (!a) return out;
+        for (size_t i = 0; i < a->values.size(); i += (size_t)a->size)
+            out.push_back(a->values[i]);
+        return out;
+    }
+
+    // A primitive of n vertices at x = 0, 1, ... n - 1
+    void primitive(GLenum mode, int n) {
+        glBegin(mode);
+        for (int i = 0; i < n; ++i)
+            glVertex2f((GLfloat)i, 0.0f);
+        glEnd();
+    }
+
+    size_t index_of(const char* name) {
+        const auto& calls = mg_mock::calls();
+        for (size_t i = 0; i < calls.size(); ++i)
+            if (strcmp(calls[i].name, name) == 0) return i;
+        return calls.size();
+    }
+} // namespace
+
+TEST(Immediate, PrimitivesBecomeTriangles) {
+    struct Case {
+        GLenum mode;
+        int vertices;
+        std::vector<float> expected;
+    };
+    const Case cases[] = {
+        {GL_QUADS, 9, {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7}},
+        {GL_QUAD_STRIP, 6, {0, 1, 3, 0, 3, 2, 2, 3, 5, 2, 5, 4}},
+        {GL_TRIANGLE_STRIP, 5, {0, 1, 2, 2, 1, 3, 2, 3, 4}},
+        {GL_TRIANGLE_FAN, 5, {0, 1, 2, 0, 2, 3, 0, 3, 4}},
+        {GL_POLYGON, 4, {0, 1, 2, 0, 2, 3}},
+        {GL_TRIANGLES, 7, {0, 1, 2, 3, 4, 5}},
+    };
+    for (const Case& c : cases) {
+        reset_immediate();
+        primitive(c.mode, c.vertices);
+        glFinish();
+        ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+        const mg_mock::Draw& draw = mg_mock::draws()[0];
+        EXPECT_EQ(draw.mode, (GLenum)GL_TRIANGLES);
+        EXPECT_EQ(draw.count, (GLsizei)c.expected.size());
+        EXPECT_TRUE(xs(draw) == c.expected);
+    }
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Immediate, LinesAndPoints) {
+    reset_immediate();
+    primitive(GL_LINE_LOOP, 3);
+    primitive(GL_LINE_STRIP, 3);
+    glFinish();
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_EQ(mg_mock::draws()[0].mode, (GLenum)GL_LINES);
+    EXPECT_TRUE(xs(mg_mock::draws()[0]) == (std::vector<float>{0, 1, 1, 2, 2, 0, 0, 1, 1, 2}));
+
+    reset_immediate();
+    primitive(GL_POINTS, 3);
+    glFinish();
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_EQ(mg_mock::draws()[0].mode, (GLenum)GL_POINTS);
+    EXPECT_TRUE(xs(mg_mock::draws()[0]) == (std::vector<float>{0, 1, 2}));
+}
+
+TEST(Immediate, VerticesTakeTheCurrentAttributes) {
+    reset_immediate();
+    glBegin(GL_TRIANGLES);
+    glColor4ub(255, 0, 0, 255);
+    glTexCoord2f(0.25f, 0.5f);
+    glNormal3f(0.0f, 1.0f, 0.0f);
+    glVertex3f(1.0f, 2.0f, 3.0f);
+    glColor3f(0.0f, 1.0f, 0.0f);
+    glVertex4f(4.0f, 5.0f, 6.0f, 2.0f);
+    glTexCoord1f(1.0f);
+    glVertex2i(7, 8);
+    glEnd();
+    glFinish();
+
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+    const mg_mock::Draw& draw = mg_mock::draws()[0];
+    const mg_mock::DrawAttrib* position = attrib(draw, IMMEDIATE_ATTRIB_POSITION);
+    const mg_mock::DrawAttrib* color = attrib(draw, IMMEDIATE_ATTRIB_COLOR);
+    const mg_mock::DrawAttrib* texcoord = attrib(draw, IMMEDIATE_ATTRIB_TEXCOORD);
+    const mg_mock::DrawAttrib* normal = attrib(draw, IMMEDIATE_ATTRIB_NORMAL);
+    ASSERT_TRUE(position && color && texcoord && normal);
+    EXPECT_TRUE(position->values == (std::vector<float>{1, 2, 3, 1, 4, 5, 6, 2, 7, 8, 0, 1}));
+    EXPECT_TRUE(color->values == (std::vector<float>{1, 0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1}));
+    EXPECT_TRUE(texcoord->values ==
+                (std::vector<float>{0.25f, 0.5f, 0, 1, 0.25f, 0.5f, 0, 1, 1, 0, 0, 1}));
+    EXPECT_TRUE(normal->values == (std::vector<float>{0, 1, 0, 0, 1, 0, 0, 1, 0}));
+
+    // The current values outlive glEnd
+    EXPECT_EQ(immediate_current_color()[1], 1.0f);
+    EXPECT_EQ(immediate_current_texcoord()[0], 1.0f);
+}
+
+TEST(Immediate, PairsOfTheSameKindAreBatched) {
+    reset_immediate();
+    for (int i = 0; i < 100; ++i) {
+        primitive(GL_QUADS, 4);
+        primitive(GL_TRIANGLE_FAN, 4);
+    }
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)0);
+    glFinish();
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_EQ(mg_mock::draws()[0].count, (GLsizei)1200);
+    EXPECT_EQ(mg_mock::count("glMapBufferRange"), (size_t)1);
+
+    // A different kind draws what came before it
+    reset_immediate();
+    primitive(GL_TRIANGLES, 3);
+    primitive(GL_LINES, 2);
+    primitive(GL_TRIANGLES, 3);
+    primitive(GL_POINTS, 1);
+    glFinish();
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)4);
+    EXPECT_EQ(mg_mock::draws()[0].mode, (GLenum)GL_TRIANGLES);
+    EXPECT_EQ(mg_mock::draws()[1].mode, (GLenum)GL_LINES);
+    EXPECT_EQ(mg_mock::draws()[2].mode, (GLenum)GL_TRIANGLES);
+    EXPECT_EQ(mg_mock::draws()[3].mode, (GLenum)GL_POINTS);
+
+    // So does toggling fixed-function texturing
+    reset_immediate();
+    primitive(GL_TRIANGLES, 3);
+    glEnable(GL_TEXTURE_2D);
+    primitive(GL_TRIANGLES, 3);
+    glDisable(GL_TEXTURE_2D);
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)2);
+}
+
+TEST(Immediate, StateChangesDrawThePendingBatchFirst) {
+    reset_immediate();
+    glDisable(GL_BLEND);
+    mg_mock::clear_calls();
+    primitive(GL_TRIANGLES, 3);
+    glEnable(GL_BLEND);
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_TRUE(index_of("glDrawArrays") < index_of("glEnable"));
+
+    // Through a draw of the application's own
+    mg_mock::clear_calls();
+    mg_mock::clear_draws();
+    primitive(GL_TRIANGLES, 3);
+    glClear(GL_COLOR_BUFFER_BIT);
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_TRUE(index_of("glDrawArrays") < index_of("glClear"));
+
+    // The generated program and VAO do not leak into the application's state
+    GLint program = -1, vao = -1;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+    EXPECT_EQ(program, 0);
+    EXPECT_EQ(vao, 0);
+    EXPECT_TRUE(mg_mock::draws()[0].program != 0);
+    glDisable(GL_BLEND);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Immediate, NativeStateChangesDrawThePendingBatchFirst) {
+    reset_immediate();
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+    mg_mock::clear_calls();
+    mg_mock::clear_draws();
+
+    // The two triangles would be batched if culling did not change in between
+    primitive(GL_TRIANGLES, 3);
+    glCullFace(GL_FRONT);
+    EXPECT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_TRUE(index_of("glDrawArrays") < index_of("glCullFace"));
+    primitive(GL_TRIANGLES, 3);
+    glFinish();
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)2);
+    EXPECT_TRUE(xs(mg_mock::draws()[1]) == (std::vector<float>{0.0f, 1.0f, 2.0f}));
+
+    glCullFace(GL_BACK);
+    glDisable(GL_CULL_FACE);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Immediate, LargeBatchesAreDrawnInParts) {
+    reset_immediate();
+    // More than a batch holds and more than the streaming VBO holds
+    const int n = 100000;
+    primitive(GL_POINTS, n);
+    // Drawn without waiting for a flush
+    ASSERT_TRUE(mg_mock::draws().size() >= 2);
+    size_t total = 0;
+    float next = 0.0f;
+    bool ordered = true;
+    for (const mg_mock::Draw& draw : mg_mock::draws()) {
+        total += (size_t)draw.count;
+        for (float x : xs(draw))
+            ordered &= x == next++;
+    }
+    EXPECT_EQ(total, (size_t)n);
+    EXPECT_TRUE(ordered);
+
+    // Triangles are never split across parts
+    reset_immediate();
+    primitive(GL_TRIANGLES, 3 * 30000);
+    for (const mg_mock::Draw& draw : mg_mock::draws())
+        EXPECT_EQ(draw.count % 3, 0);
+    glFinish();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Immediate, MisnestedCallsAreIgnored) {
+    reset_immediate();
+    glEnd();
+    glVertex2f(1.0f, 1.0f);
+    glBegin(GL_TRIANGLES);
+    glBegin(GL_QUADS);
+    glVertex2f(0.0f, 0.0f);
+    glVertex2f(1.0f, 0.0f);
+    glVertex2f(2.0f, 0.0f);
+    glEnd();
+    glFinish();
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+    EXPECT_TRUE(xs(mg_mock::draws()[0]) == (std::vector<float>{0, 1, 2}));
+    EXPECT_TRUE(!immediate_in_begin());
+}
+
+BENCH(Immediate, TexturedQuads) {
+    mg_mock::set_recording(false);
+    mg_mock::set_capture_draws(false);
+    glEnable(GL_TEXTURE_2D);
+    mg_test::measure("1000 textured quads and a flush", 200, "quads", [] {
+        glBegin(GL_QUADS);
+        for (int i = 0; i < 1000; ++i) {
+            const GLfloat x = (GLfloat)(i % 32), y = (GLfloat)(i / 32);
+            glColor4ub(255, 255, 255, 255);
+            glTexCoord2f(0.0f, 0.0f);
+            glVertex2f(x, y);
+            glTexCoord2f(1.0f, 0.0f);
+            glVertex2f(x + 1.0f, y);
+            glTexCoord2f(1.0f, 1.0f);
+            glVertex2f(x + 1.0f, y + 1.0f);
+            glTexCoord2f(0.0f, 1.0f);
+            glVertex2f(x, y + 1.0f);
+        }
+        glEnd();
+        glFlush();
+    }, 1000);
+    glDisable(GL_TEXTURE_2D);
+    mg_mock::set_capture_draws(true);
+    mg_mock::set_recording(true);
+}
@@ -0,0 +1,197 @@
+// MobileGlues - tests/test_index_cache.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/buffer.h"
+#include "gl/index_cache.h"
+#include "gl/multidraw.h"
+#include "test_util.h"
+#include <random>
+
+namespace {
+    template <typename T> std::vector<T> random_indices(std::mt19937& rng, size_t count) {
+        std::vector<T> out(count);
+        for (T& v : out)
+            v = (T)rng();
+        return out;
+    }
+
+    template <typename T> void check_kernel(GLenum type, std::mt19937& rng) {
+        // Every tail length around the vector widths, from unaligned pointers,
+        // with bases that wrap in the index type
+        for (size_t count = 0; count <= 67; ++count) {
+            for (GLint basevertex : {0, 1, -1, 1000, -70000, 0x12345678}) {
+                std::vector<T> src = random_indices<T>(rng, count + 1);
+                std::vector<T> dst(count + 1);
+                add_base_vertex(type, src.data() + 1, dst.data() + 1, (GLsizei)count, basevertex);
+                std::vector<T> inplace = src;
+                add_base_vertex(type, inplace.data() + 1, inplace.data() + 1, (GLsizei)count, basevertex);
+                for (size_t i = 1; i <= count; ++i) {
+                    T expected = (T)(src[i] + (T)basevertex);
+                    ASSERT_EQ(dst[i], expected);
+                    ASSERT_EQ(inplace[i], expected);
+                }
+            }
+        }
+    }
+
+    // A VAO without enabled attributes, so the mock does not decode vertices
+    // for the rebased indices, and an element buffer of 4096 ushort indices
+    struct IndexedGeometry {
+        GLuint vao = 0;
+        GLuint ibo = 0;
+        std::vector<uint16_t> indices;
+
+        IndexedGeometry() : indices(4096) {
+            for (size_t i = 0; i < indices.size(); ++i)
+                indices[i] = (uint16_t)(i * 7);
+            glGenVertexArrays(1, &vao);
+            glBindVertexArray(vao);
+            glGenBuffers(1, &ibo);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(indices.size() * sizeof(uint16_t)), indices.data(),
+                         GL_STATIC_DRAW);
+        }
+
+        ~IndexedGeometry() {
+            glBindVertexArray(0);
+            glDeleteVertexArrays(1, &vao);
+            glDeleteBuffers(1, &ibo);
+        }
+    };
+
+    struct BaseVertexDraws {
+        std::vector<GLsizei> counts;
+        std::vector<const void*> offsets;
+        std::vector<GLint> basevertices;
+
+        void add(GLsizei count, size_t first, GLint basevertex) {
+            counts.push_back(count);
+            offsets.push_back((const void*)(uintptr_t)(first * sizeof(uint16_t)));
+            basevertices.push_back(basevertex);
+        }
+
+        void draw() {
+            mg_glMultiDrawElementsBaseVertex_drawelements(GL_TRIANGLES, counts.data(), GL_UNSIGNED_SHORT,
+                                                          offsets.data(), (GLsizei)counts.size(),
+                                                          basevertices.data());
+        }
+    };
+
+    void expect_rebased(const mg_mock::Draw& draw, const std::vector<uint16_t>& source, size_t first,
+                        GLint basevertex) {
+        EXPECT_EQ(draw.basevertex, 0);
+        ASSERT_EQ(draw.indices.size(), (size_t)draw.count);
+        for (GLsizei i = 0; i < draw.count; ++i)
+            ASSERT_EQ(draw.indices[i], (uint32_t)(uint16_t)(source[first + i] + basevertex));
+    }
+} // namespace
+
+TEST(IndexCache, KernelsMatchScalar) {
+    std::mt19937 rng(9);
+    check_kernel<uint8_t>(GL_UNSIGNED_BYTE, rng);
+    check_kernel<uint16_t>(GL_UNSIGNED_SHORT, rng);
+    check_kernel<uint32_t>(GL_UNSIGNED_INT, rng);
+}
+
+TEST(IndexCache, RebasedDrawsAreReused) {
+    reset_gl_errors();
+    IndexedGeometry geometry;
+    BaseVertexDraws draws;
+    draws.add(30, 0, 100);
+    draws.add(6, 30, 0);
+    draws.add(99, 512, -5);
+
+    mg_mock::clear_draws();
+    mg_mock::clear_calls();
+    draws.draw();
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)3);
+    expect_rebased(mg_mock::draws()[0], geometry.indices, 0, 100);
+    expect_rebased(mg_mock::draws()[2], geometry.indices, 512, -5);
+    // A zero base vertex draws straight from the application's buffer
+    EXPECT_EQ(mg_mock::draws()[1].indices[0], (uint32_t)geometry.indices[30]);
+    EXPECT_EQ(mg_mock::count("glMapBufferRange"), (size_t)2);
+    EXPECT_EQ(mg_mock::count("glDeleteBuffers"), (size_t)0);
+
+    // The second frame only binds the cached copies
+    mg_mock::clear_draws();
+    mg_mock::clear_calls();
+    draws.draw();
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)3);
+    expect_rebased(mg_mock::draws()[0], geometry.indices, 0, 100);
+    expect_rebased(mg_mock::draws()[2], geometry.indices, 512, -5);
+    EXPECT_EQ(mg_mock::count("glMapBufferRange"), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glBufferData"), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glBufferSubData"), (size_t)0);
+
+    GLint bound = 0;
+    mg_mock::get_integerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &bound);
+    EXPECT_EQ((GLuint)bound, find_real_buffer(geometry.ibo));
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+    mg_mock::clear_draws();
+}
+
+TEST(IndexCache, BufferWritesInvalidate) {
+    reset_gl_errors();
+    IndexedGeometry geometry;
+    BaseVertexDraws draws;
+    draws.add(12, 8, 3);
+    draws.draw();
+
+    // Writes through each tracked path must be seen by the next draw
+    for (int round = 0; round < 3; ++round) {
+        for (size_t i = 8; i < 20; ++i)
+            geometry.indices[i] = (uint16_t)(geometry.indices[i] + 11);
+        if (round == 0) {
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 8 * sizeof(uint16_t), 12 * sizeof(uint16_t),
+                            geometry.indices.data() + 8);
+        } else if (round == 1) {
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(geometry.indices.size() * sizeof(uint16_t)),
+                         geometry.indices.data(), GL_STATIC_DRAW);
+        } else {
+            void* mapped = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 8 * sizeof(uint16_t), 12 * sizeof(uint16_t),
+                                            GL_MAP_WRITE_BIT);
+            ASSERT_TRUE(mapped != nullptr);
+            memcpy(mapped, geometry.indices.data() + 8, 12 * sizeof(uint16_t));
+            glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+        }
+
+        mg_mock::clear_draws();
+        draws.draw();
+        ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+        expect_rebased(mg_mock::draws()[0], geometry.indices, 8, 3);
+    }
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+    mg_mock::clear_draws();
+}
+
+BENCH(IndexCache, RewrittenIndices) {
+    std::mt19937 rng(1);
+    const size_t count = 1 << 16;
+    auto u8 = random_indices<uint8_t>(rng, count);
+    auto u16 = random_indices<uint16_t>(rng, count);
+    auto u32 = random_indices<uint32_t>(rng, count);
+    mg_test::measure("add_base_vertex ubyte", 2000, "indices",
+                     [&] { add_base_vertex(GL_UNSIGNED_BYTE, u8.data(), u8.data(), (GLsizei)count, 7); }, count);
+    mg_test::measure("add_base_vertex ushort", 2000, "indices",
+                     [&] { add_base_vertex(GL_UNSIGNED_SHORT, u16.data(), u16.data(), (GLsizei)count, 7); }, count);
+    mg_test::measure("add_base_vertex uint", 2000, "indices",
+                     [&] { add_base_vertex(GL_UNSIGNED_INT, u32.data(), u32.data(), (GLsizei)count, 7); }, count);
+
+    // Through the cache: every draw a miss, then every draw a hit
+    IndexedGeometry geometry;
+    mg_mock::set_capture_draws(false);
+    BaseVertexDraws draws;
+    for (GLint i = 0; i < 64; ++i)
+        draws.add(60, (size_t)i * 60, i + 1);
+    mg_test::measure("rebased multidraw x64, cache miss", 200, "indices", [&] {
+        for (GLint& basevertex : draws.basevertices)
+            basevertex += 64;
+        draws.draw();
+    }, 64 * 60);
+    mg_test::measure("rebased multidraw x64, cache hit", 2000, "indices", [&] { draws.draw(); }, 64 * 60);
+    mg_mock::set_capture_draws(true);
+}
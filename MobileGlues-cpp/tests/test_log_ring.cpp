@@ -0,0 +1,181 @@
+// MobileGlues - tests/test_log_ring.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/log_ring.h"
+#include "gl/mg.h"
+#include "test_util.h"
+#include <atomic>
+#include <csignal>
+#include <cstdarg>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    // A fresh file behind the glcalls.txt sink, which nothing else writes to
+    // while the tests run
+    std::filesystem::path open_calls_file(const char* name) {
+        std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                     ("mobileglues-" + std::to_string(getpid()) + "-" + name + ".txt");
+        std::filesystem::remove(path);
+        log_ring_open(LogSink::Calls, path.c_str());
+        return path;
+    }
+
+    void print(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        log_ring_vprintf(LogSink::Calls, true, format, args);
+        va_end(args);
+    }
+
+    std::vector<std::string> lines(const std::filesystem::path& path) {
+        std::vector<std::string> out;
+        std::istringstream in(read_text_file(path));
+        std::string line;
+        while (std::getline(in, line))
+            out.push_back(line);
+        return out;
+    }
+
+    // What write_log did before the ring: format and flush on the caller
+    void stdio_write_log(FILE* file, const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        vfprintf(file, format, args);
+        va_end(args);
+        fprintf(file, "\n");
+        fflush(file);
+    }
+} // namespace
+
+TEST(LogRing, ThreadsKeepTheirOrder) {
+    std::filesystem::path path = open_calls_file("order");
+    const uint64_t dropped = log_ring_dropped();
+    const int kThreads = 4, kMessages = 2000;
+    std::vector<std::thread> threads;
+    // Nobody exits before all are done, or a thread started later would take
+    // over the ring of one that finished, with its lines still in it
+    std::atomic<int> finished{0};
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t, &finished] {
+            for (int i = 0; i < kMessages; ++i)
+                print("%d %d", t, i);
+            finished.fetch_add(1);
+            while (finished.load() < kThreads)
+                std::this_thread::yield();
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    log_ring_flush();
+
+    // Small enough to fit each thread's ring without a drain, so nothing is lost
+    EXPECT_EQ(log_ring_dropped(), dropped);
+    std::vector<int> next(kThreads, 0);
+    size_t count = 0;
+    for (const std::string& line : lines(path)) {
+        int t = -1, i = -1;
+        if (sscanf(line.c_str(), "%d %d", &t, &i) != 2 || t < 0 || t >= kThreads) {
+            mg_test::fail(__FILE__, __LINE__, "unexpected line: " + line);
+            break;
+        }
+        EXPECT_EQ(i, next[t]++);
+        ++count;
+    }
+    EXPECT_EQ(count, (size_t)(kThreads * kMessages));
+    std::filesystem::remove(path);
+}
+
+TEST(LogRing, RingsOfExitedThreadsAreReused) {
+    std::filesystem::path path = open_calls_file("reuse");
+    const uint64_t dropped = log_ring_dropped();
+    // Far more threads than there are rings, one after another
+    for (int i = 0; i < 200; ++i)
+        std::thread([i] { print("thread %d", i); }).join();
+    log_ring_flush();
+    EXPECT_EQ(log_ring_dropped(), dropped);
+    std::vector<std::string> written = lines(path);
+    ASSERT_EQ(written.size(), (size_t)200);
+    EXPECT_EQ(written[199], std::string("thread 199"));
+    std::filesystem::remove(path);
+}
+
+TEST(LogRing, LongMessagesStayWhole) {
+    std::filesystem::path path = open_calls_file("long");
+    const uint64_t dropped = log_ring_dropped();
+    // Split into several records, written back to back
+    std::string line(10000, 'x');
+    line += '\n';
+    log_ring_write(LogSink::Calls, line.data(), line.size());
+    std::string formatted(700, 'y');
+    print("%s", formatted.c_str());
+
+    // Larger than a whole ring, so dropped and counted
+    std::string huge(100000, 'z');
+    log_ring_write(LogSink::Calls, huge.data(), huge.size());
+    log_ring_flush();
+
+    EXPECT_EQ(log_ring_dropped(), dropped + 1);
+    std::vector<std::string> written = lines(path);
+    ASSERT_EQ(written.size(), (size_t)2);
+    EXPECT_EQ(written[0], std::string(10000, 'x'));
+    EXPECT_EQ(written[1], formatted);
+    std::filesystem::remove(path);
+}
+
+TEST(LogRing, AbortFlushesTheRings) {
+    std::filesystem::path path = open_calls_file("abort");
+    fflush(stdout);
+    pid_t child = fork();
+    ASSERT_TRUE(child >= 0);
+    if (child == 0) {
+        print("last words");
+        abort();
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+    std::vector<std::string> written = lines(path);
+    ASSERT_EQ(written.size(), (size_t)1);
+    EXPECT_EQ(written[0], std::string("last words"));
+    std::filesystem::remove(path);
+}
+
+#if !GLOBAL_DEBUG
+TEST(LogRing, FaultSignalsAreLeftToTheHost) {
+    std::filesystem::path path = open_calls_file("signals");
+    for (int sig : {SIGSEGV, SIGBUS, SIGFPE, SIGILL}) {
+        struct sigaction action = {};
+        sigaction(sig, nullptr, &action);
+        EXPECT_TRUE(action.sa_handler == SIG_DFL);
+    }
+    std::filesystem::remove(path);
+}
+#endif
+
+BENCH(LogRing, AgainstStdio) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                 ("mobileglues-" + std::to_string(getpid()) + "-stdio.txt");
+    FILE* file = fopen(path.c_str(), "w");
+    if (file) {
+        mg_test::measure("write_log, fprintf and fflush per line", 200000, "lines", [&] {
+            stdio_write_log(file, "glBindTexture, target: %s, texture: %d", "GL_TEXTURE_2D", 42);
+        });
+        fclose(file);
+    }
+    std::filesystem::remove(path);
+
+    path = open_calls_file("bench");
+    const uint64_t dropped = log_ring_dropped();
+    mg_test::measure("write_log, through the ring", 200000, "lines",
+                     [] { print("glBindTexture, target: %s, texture: %d", "GL_TEXTURE_2D", 42); });
+    log_ring_flush();
+    printf("    %llu of 200000 lines dropped with the ring full\n",
+           (unsigned long long)(log_ring_dropped() - dropped));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,92 @@
+// MobileGlues - tests/test_main.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "config/settings.h"
+#include "test_util.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+// Points MobileGlues at the mock backend and a scratch MG directory, runs
+// the normal initialization and makes a context current through the public
+// EGL entry points, then runs the registered cases.
+
+static void make_current() {
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    eglInitialize(display, nullptr, nullptr);
+    EGLint attribs[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT, EGL_NONE};
+    EGLConfig config;
+    EGLint count = 0;
+    eglChooseConfig(display, attribs, &config, 1, &count);
+    EGLint ctx_attribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, ctx_attribs);
+    EGLint pb_attribs[] = {EGL_WIDTH, 64, EGL_HEIGHT, 64, EGL_NONE};
+    EGLSurface surface = eglCreatePbufferSurface(display, config, pb_attribs);
+    eglMakeCurrent(display, surface, surface, context);
+}
+
+int main(int argc, char** argv) {
+    bool bench = false;
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--bench") == 0)
+            bench = true;
+        else
+            filter = argv[i];
+    }
+
+    char dir[] = "/tmp/mobileglues-tests-XXXXXX";
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    setenv("MG_DIR_PATH", dir, 1);
+    setenv("MG_GLES_LIBRARY", MG_MOCK_LIBRARY, 1);
+    setenv("MG_EGL_LIBRARY", MG_MOCK_LIBRARY, 1);
+
+    // Started again by the ProcAddress benchmark, to time startup alone
+    if (getenv("MG_TIME_PROC_INIT")) {
+        auto start = std::chrono::steady_clock::now();
+        proc_init();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("proc_init %.3f ms\n", ms);
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+        return 0;
+    }
+
+    proc_init();
+    // Disk caches on, as a launcher-provided config would have them
+    global_settings.max_glsl_cache_size = 32 * 1024 * 1024;
+    make_current();
+
+    int ran = 0, failed = 0;
+    for (const mg_test::Case& c : mg_test::registry()) {
+        if (c.bench != bench) continue;
+        std::string full = std::string(c.suite) + "." + c.name;
+        if (filter && full.find(filter) == std::string::npos) continue;
+        printf("[ RUN  ] %s\n", full.c_str());
+        fflush(stdout);
+        int before = mg_test::failures();
+        try {
+            c.fn();
+        } catch (const mg_test::AssertionFailure&) {
+        } catch (const std::exception& e) {
+            mg_test::fail(__FILE__, __LINE__, std::string("exception: ") + e.what());
+        }
+        bool ok = mg_test::failures() == before;
+        printf("[ %s ] %s\n", ok ? " OK " : "FAIL", full.c_str());
+        ran++;
+        if (!ok) failed++;
+    }
+    printf("%d %s run, %d failed\n", ran, bench ? "benchmarks" : "tests", failed);
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    return failed ? 1 : 0;
+}
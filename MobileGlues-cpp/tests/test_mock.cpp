@@ -0,0 +1,106 @@
+// MobileGlues - tests/test_mock.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/buffer.h"
+#include "test_util.h"
+#include <cstring>
+
+// Sanity checks that MobileGlues really runs on the mock and that the mock
+// keeps the state the other tests compare against.
+
+TEST(Mock, BackendIsLoaded) {
+    const char* renderer = (const char*)MOCK_GL(glGetString)(GL_RENDERER);
+    ASSERT_TRUE(renderer != nullptr);
+    EXPECT_EQ(std::string(renderer), std::string("MobileGlues Mock"));
+
+    // Through MobileGlues' own entry points, whatever the earlier tests cleared
+    mg_mock::clear_calls();
+    EGLContext context = eglGetCurrentContext();
+    ASSERT_TRUE(context != EGL_NO_CONTEXT);
+    EXPECT_TRUE(eglMakeCurrent(eglGetCurrentDisplay(), eglGetCurrentSurface(EGL_DRAW), eglGetCurrentSurface(EGL_READ),
+                               context));
+    EXPECT_EQ(mg_mock::count("eglMakeCurrent"), (size_t)1);
+    glFlush();
+    EXPECT_EQ(mg_mock::count("glFlush"), (size_t)1);
+}
+
+TEST(Mock, BufferUploadReachesDriver) {
+    reset_gl_errors();
+    const uint8_t data[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_STATIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 4, 4, data + 12);
+
+    const std::vector<uint8_t>* stored = mg_mock::buffer_data(find_real_buffer(buffer));
+    ASSERT_TRUE(stored != nullptr);
+    ASSERT_EQ(stored->size(), sizeof(data));
+    EXPECT_EQ((*stored)[3], 4);
+    EXPECT_EQ((*stored)[4], 13);
+    EXPECT_EQ((*stored)[7], 16);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDeleteBuffers(1, &buffer);
+}
+
+TEST(Mock, ClearAndReadBack) {
+    reset_gl_errors();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    uint8_t pixel[4] = {};
+    glReadPixels(3, 5, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    EXPECT_EQ(pixel[0], 255);
+    EXPECT_EQ(pixel[1], 0);
+    EXPECT_EQ(pixel[3], 255);
+    EXPECT_EQ(mg_mock::default_framebuffer()[0], 255);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+TEST(Mock, DrawCaptureDecodesAttributes) {
+    auto genVertexArrays = MOCK_GL(glGenVertexArrays);
+    auto bindVertexArray = MOCK_GL(glBindVertexArray);
+    auto genBuffers = MOCK_GL(glGenBuffers);
+    auto bindBuffer = MOCK_GL(glBindBuffer);
+    auto bufferData = MOCK_GL(glBufferData);
+    auto vertexAttribPointer = MOCK_GL(glVertexAttribPointer);
+    auto enableVertexAttribArray = MOCK_GL(glEnableVertexAttribArray);
+    auto drawElements = MOCK_GL(glDrawElements);
+
+    GLint old_vao = 0, old_array = 0;
+    mg_mock::get_integerv(GL_VERTEX_ARRAY_BINDING, &old_vao);
+    mg_mock::get_integerv(GL_ARRAY_BUFFER_BINDING, &old_array);
+
+    GLuint vao, buffers[2];
+    genVertexArrays(1, &vao);
+    bindVertexArray(vao);
+    genBuffers(2, buffers);
+    const float positions[] = {0.0f, 0.5f, 1.0f, 1.5f, 2.0f, 2.5f};
+    const uint16_t indices[] = {2, 0, 1};
+    bindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    bufferData(GL_ARRAY_BUFFER, sizeof(positions), positions, GL_STATIC_DRAW);
+    bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+    bufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    enableVertexAttribArray(0);
+
+    mg_mock::clear_draws();
+    drawElements(GL_TRIANGLES, 3, GL_UNSIGNED_SHORT, nullptr);
+    ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+    const mg_mock::Draw& draw = mg_mock::draws()[0];
+    EXPECT_EQ(draw.indices, (std::vector<uint32_t>{2, 0, 1}));
+    ASSERT_EQ(draw.attribs.size(), (size_t)1);
+    EXPECT_EQ(draw.attribs[0].values, (std::vector<float>{2.0f, 2.5f, 0.0f, 0.5f, 1.0f, 1.5f}));
+
+    bindVertexArray(old_vao);
+    bindBuffer(GL_ARRAY_BUFFER, old_array);
+    MOCK_GL(glDeleteVertexArrays)(1, &vao);
+    MOCK_GL(glDeleteBuffers)(2, buffers);
+    mg_mock::clear_draws();
+}
@@ -0,0 +1,316 @@
+// MobileGlues - tests/test_multidraw.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/buffer.h"
+#include "gl/multidraw.h"
+#include "test_util.h"
+#include <EGL/egl.h>
+#include <limits>
+#include <random>
+
+namespace {
+    // A VAO with 64 vertices and an index buffer of 0..1023 (mod 64) the
+    // sub-draws of a multidraw pick ranges from
+    struct Geometry {
+        GLuint vao = 0;
+        GLuint buffers[2] = {};
+
+        Geometry() {
+            glGenVertexArrays(1, &vao);
+            glBindVertexArray(vao);
+            glGenBuffers(2, buffers);
+            std::vector<float> positions(64 * 2);
+            for (size_t i = 0; i < positions.size(); ++i)
+                positions[i] = (float)i;
+            std::vector<uint16_t> indices(1024);
+            for (size_t i = 0; i < indices.size(); ++i)
+                indices[i] = (uint16_t)(i % 64);
+            glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(positions.size() * sizeof(float)), positions.data(),
+                         GL_STATIC_DRAW);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(indices.size() * sizeof(uint16_t)), indices.data(),
+                         GL_STATIC_DRAW);
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+            glEnableVertexAttribArray(0);
+        }
+
+        ~Geometry() {
+            glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteVertexArrays(1, &vao);
+            glDeleteBuffers(2, buffers);
+        }
+    };
+
+    // `primcount` sub-draws of 3 indices each, starting at consecutive triangles
+    struct MultiDraw {
+        std::vector<GLsizei> counts;
+        std::vector<const void*> offsets;
+
+        explicit MultiDraw(GLsizei primcount, GLsizei first = 0) {
+            for (GLsizei i = 0; i < primcount; ++i) {
+                counts.push_back(3);
+                offsets.push_back((const void*)(uintptr_t)(((first + i) * 3 % 1020) * sizeof(uint16_t)));
+            }
+        }
+
+        void draw() const {
+            mg_glMultiDrawElements_multiindirect(GL_TRIANGLES, counts.data(), GL_UNSIGNED_SHORT, offsets.data(),
+                                                 (GLsizei)counts.size());
+        }
+    };
+
+    void swap_buffers() {
+        eglSwapBuffers(eglGetCurrentDisplay(), eglGetCurrentSurface(EGL_DRAW));
+    }
+} // namespace
+
+namespace {
+    // C++ transcriptions of multidraw_scan_shader and multidraw_comp_shader in
+    // gl/multidraw.cpp that the mock runs on dispatch. Invocations of a work
+    // group run one after another between barriers.
+    void scan_kernel(GLuint program, const GLuint groups[3]) {
+        const uint32_t threads = 128;
+        EXPECT_EQ(groups[0] * groups[1] * groups[2], 1u);
+        uint32_t drawCount = mg_mock::uniform_value(program, 0).at(0);
+        auto* draws = (uint32_t*)mg_mock::indexed_buffer(GL_SHADER_STORAGE_BUFFER, 1);
+        ASSERT_TRUE(draws != nullptr);
+
+        uint32_t partial[threads];
+        uint32_t perThread = (drawCount + threads - 1) / threads;
+        auto slice = [&](uint32_t tid, uint32_t& begin, uint32_t& end) {
+            begin = std::min(tid * perThread, drawCount);
+            end = std::min(begin + perThread, drawCount);
+        };
+        for (uint32_t tid = 0; tid < threads; ++tid) {
+            uint32_t begin, end, sum = 0;
+            slice(tid, begin, end);
+            for (uint32_t i = begin; i < end; ++i)
+                sum += draws[i * 4];
+            partial[tid] = sum;
+        }
+        for (uint32_t stride = 1; stride < threads; stride <<= 1) {
+            for (uint32_t tid = 0; tid < threads; ++tid) {
+                uint32_t idx = (tid + 1) * stride * 2 - 1;
+                if (idx < threads) partial[idx] += partial[idx - stride];
+            }
+        }
+        partial[threads - 1] = 0;
+        for (uint32_t stride = threads / 2; stride > 0; stride >>= 1) {
+            for (uint32_t tid = 0; tid < threads; ++tid) {
+                uint32_t idx = (tid + 1) * stride * 2 - 1;
+                if (idx < threads) {
+                    uint32_t left = partial[idx - stride];
+                    partial[idx - stride] = partial[idx];
+                    partial[idx] += left;
+                }
+            }
+        }
+        for (uint32_t tid = 0; tid < threads; ++tid) {
+            uint32_t begin, end, running = partial[tid];
+            slice(tid, begin, end);
+            for (uint32_t i = begin; i < end; ++i) {
+                uint32_t count = draws[i * 4];
+                draws[i * 4 + 3] = running;
+                running += count;
+            }
+        }
+    }
+
+    void expand_kernel(GLuint program, const GLuint groups[3]) {
+        const uint32_t localSize = 64;
+        uint32_t drawCount = mg_mock::uniform_value(program, 0).at(0);
+        uint32_t elementSize = mg_mock::uniform_value(program, 1).at(0);
+        size_t inSize = 0, drawsSize = 0, outSize = 0;
+        auto* in = (const uint32_t*)mg_mock::indexed_buffer(GL_SHADER_STORAGE_BUFFER, 0, &inSize);
+        auto* draws = (const uint32_t*)mg_mock::indexed_buffer(GL_SHADER_STORAGE_BUFFER, 1, &drawsSize);
+        auto* out = (uint32_t*)mg_mock::indexed_buffer(GL_SHADER_STORAGE_BUFFER, 2, &outSize);
+        ASSERT_TRUE(in && draws && out);
+        ASSERT_TRUE(drawsSize >= drawCount * 16u);
+
+        auto read_index = [&](uint32_t element) -> uint32_t {
+            if (elementSize == 4) return in[element];
+            if (elementSize == 2) return (in[element >> 1] >> ((element & 1) * 16)) & 0xFFFF;
+            return (in[element >> 2] >> ((element & 3) * 8)) & 0xFF;
+        };
+        for (uint32_t gy = 0; gy < groups[1]; ++gy) {
+            for (uint32_t gx = 0; gx < groups[0]; ++gx) {
+                uint32_t drawId = gy * groups[0] + gx;
+                if (drawId >= drawCount) continue;
+                const uint32_t* draw = draws + drawId * 4;
+                for (uint32_t tid = 0; tid < localSize; ++tid) {
+                    for (uint32_t i = tid; i < draw[0]; i += localSize) {
+                        ASSERT_TRUE((draw[3] + i + 1) * 4 <= outSize);
+                        ASSERT_TRUE((draw[1] + i + 1) * elementSize <= inSize);
+                        out[draw[3] + i] = (uint32_t)((int32_t)read_index(draw[1] + i) + (int32_t)draw[2]);
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename T> struct IndexedDraws {
+        std::vector<T> elements;
+        std::vector<GLsizei> counts;
+        std::vector<const void*> offsets;
+        std::vector<GLint> basevertices;
+        std::vector<uint32_t> expected;
+
+        IndexedDraws(std::mt19937& rng, size_t primcount, size_t elementCount) {
+            elements.resize(elementCount);
+            for (T& e : elements)
+                e = (T)(rng() % std::min<uint64_t>(std::numeric_limits<T>::max(), 60000));
+            for (size_t i = 0; i < primcount; ++i) {
+                // Zero counts and counts beyond one work group are included
+                GLsizei count = rng() % 8 == 0 ? 0 : (GLsizei)(rng() % 200);
+                size_t first = rng() % (elementCount - count);
+                GLint basevertex = (GLint)(rng() % 2000) - 500;
+                counts.push_back(count);
+                offsets.push_back((const void*)(uintptr_t)(first * sizeof(T)));
+                basevertices.push_back(basevertex);
+                for (GLsizei j = 0; j < count; ++j)
+                    expected.push_back((uint32_t)((int32_t)elements[first + j] + basevertex));
+            }
+        }
+    };
+
+    template <typename T> void check_compute_multidraw(GLenum type, size_t primcount, uint32_t seed) {
+        std::mt19937 rng(seed);
+        IndexedDraws<T> draws(rng, primcount, 4096);
+        Geometry geometry;
+        // The generated indices go far beyond the vertices the mock could decode
+        glDisableVertexAttribArray(0);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(draws.elements.size() * sizeof(T)), draws.elements.data(),
+                     GL_STATIC_DRAW);
+
+        mg_mock::clear_draws();
+        mg_mock::clear_calls();
+        mg_glMultiDrawElementsBaseVertex_compute(GL_TRIANGLES, draws.counts.data(), type, draws.offsets.data(),
+                                                 (GLsizei)primcount, draws.basevertices.data());
+        // The element buffer size is known without asking the driver
+        EXPECT_EQ(mg_mock::count("glGetBufferParameteriv"), (size_t)0);
+        ASSERT_EQ(mg_mock::draws().size(), (size_t)1);
+        const mg_mock::Draw& draw = mg_mock::draws()[0];
+        EXPECT_EQ(draw.index_type, (GLenum)GL_UNSIGNED_INT);
+        EXPECT_EQ(draw.indices.size(), draws.expected.size());
+        EXPECT_TRUE(draw.indices == draws.expected);
+
+        // The application's element buffer and program are back in place
+        GLint bound = 0;
+        mg_mock::get_integerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &bound);
+        EXPECT_EQ((GLuint)bound, find_real_buffer(geometry.buffers[1]));
+        mg_mock::get_integerv(GL_CURRENT_PROGRAM, &bound);
+        EXPECT_EQ(bound, 0);
+        EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+        mg_mock::clear_draws();
+    }
+} // namespace
+
+TEST(MultidrawCompute, MatchesCpuReference) {
+    reset_gl_errors();
+    mg_mock::set_compute_kernel("SCAN_THREADS", scan_kernel);
+    mg_mock::set_compute_kernel("out_indices", expand_kernel);
+    // Fewer draws than scan threads, a multiple of them, and an uneven split
+    check_compute_multidraw<uint16_t>(GL_UNSIGNED_SHORT, 5, 1);
+    check_compute_multidraw<uint16_t>(GL_UNSIGNED_SHORT, 256, 2);
+    check_compute_multidraw<uint16_t>(GL_UNSIGNED_SHORT, 1000, 3);
+    check_compute_multidraw<uint8_t>(GL_UNSIGNED_BYTE, 300, 4);
+    check_compute_multidraw<uint32_t>(GL_UNSIGNED_INT, 777, 5);
+    mg_mock::set_compute_kernel("SCAN_THREADS", nullptr);
+    mg_mock::set_compute_kernel("out_indices", nullptr);
+}
+
+TEST(IndirectRing, CommandsReachTheDriver) {
+    reset_gl_errors();
+    Geometry geometry;
+    mg_mock::clear_draws();
+    MultiDraw(3, 5).draw();
+    const auto& draws = mg_mock::draws();
+    ASSERT_EQ(draws.size(), (size_t)3);
+    for (size_t i = 0; i < draws.size(); ++i) {
+        uint32_t first = (uint32_t)(5 + i) * 3;
+        EXPECT_EQ(draws[i].indices, (std::vector<uint32_t>{first, first + 1, first + 2}));
+    }
+    // The application's indirect binding is restored
+    GLint bound = -1;
+    mg_mock::get_integerv(GL_DRAW_INDIRECT_BUFFER_BINDING, &bound);
+    EXPECT_EQ(bound, 0);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+    swap_buffers();
+    mg_mock::clear_draws();
+}
+
+// Submissions share a fence per ring segment and per frame, not one per draw
+TEST(IndirectRing, FencesPerSegmentAndFrame) {
+    Geometry geometry;
+    mg_mock::set_capture_draws(false);
+    swap_buffers();
+
+    const int draws = 4000;
+    const MultiDraw multidraw(4); // 80 bytes per draw, 320 KB in total
+    size_t fences = mg_mock::fence_count();
+    for (int i = 0; i < draws; ++i)
+        multidraw.draw();
+    size_t issued = mg_mock::fence_count() - fences;
+    EXPECT_TRUE(issued >= 1);
+    EXPECT_TRUE(issued <= 8);
+    // Live fences are bounded by the ring segments, not by the draws
+    EXPECT_TRUE(mg_mock::live_syncs() <= 6);
+
+    fences = mg_mock::fence_count();
+    swap_buffers();
+    EXPECT_EQ(mg_mock::fence_count() - fences, (size_t)1);
+    // Nothing left to fence for an idle frame
+    swap_buffers();
+    EXPECT_EQ(mg_mock::fence_count() - fences, (size_t)1);
+    mg_mock::set_capture_draws(true);
+}
+
+// Growing the ring waits for and retires the fences of the old storage
+TEST(IndirectRing, GrowRetiresFences) {
+    reset_gl_errors();
+    Geometry geometry;
+    mg_mock::set_capture_draws(false);
+    for (int i = 0; i < 100; ++i)
+        MultiDraw(4).draw();
+    swap_buffers();
+    EXPECT_TRUE(mg_mock::live_syncs() > 0);
+
+    mg_mock::clear_calls();
+    MultiDraw(8192).draw(); // 160 KB, needs a larger ring
+
+    size_t wait = 0, deleteSync = 0, deleteBuffer = 0;
+    const auto& calls = mg_mock::calls();
+    for (size_t i = 0; i < calls.size(); ++i) {
+        std::string name = calls[i].name;
+        if (name == "glClientWaitSync" && !wait) wait = i + 1;
+        if (name == "glDeleteSync") deleteSync = i + 1;
+        if (name == "glDeleteBuffers" && !deleteBuffer) deleteBuffer = i + 1;
+    }
+    ASSERT_TRUE(wait && deleteSync && deleteBuffer);
+    EXPECT_TRUE(wait < deleteSync);
+    EXPECT_TRUE(deleteSync < deleteBuffer);
+    // Only the submission into the new storage is in flight, and not fenced yet
+    EXPECT_EQ(mg_mock::live_syncs(), (size_t)0);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+    swap_buffers();
+    mg_mock::clear_calls();
+    mg_mock::set_capture_draws(true);
+}
+
+BENCH(IndirectRing, Commands) {
+    Geometry geometry;
+    mg_mock::set_capture_draws(false);
+    for (GLsizei primcount : {1, 16, 256}) {
+        const MultiDraw multidraw(primcount);
+        std::string label = "multidraw indirect x" + std::to_string(primcount);
+        mg_test::measure(label.c_str(), 20000, "commands", [&] { multidraw.draw(); }, primcount);
+        swap_buffers();
+    }
+    mg_mock::set_capture_draws(true);
+}
@@ -0,0 +1,467 @@
+// MobileGlues - tests/test_pixel.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/pixel.h"
+#include "test_util.h"
+
+namespace {
+    // Component bit widths of a packed type, first component first. Without
+    // _REV the first component sits in the most significant bits.
+    struct PackedType {
+        GLenum type;
+        int bits[4];
+        int count;
+        bool rev;
+    };
+
+    const PackedType kPackedTypes[] = {
+        {GL_UNSIGNED_INT_8_8_8_8, {8, 8, 8, 8}, 4, false},
+        {GL_UNSIGNED_INT_8_8_8_8_REV, {8, 8, 8, 8}, 4, true},
+        {GL_UNSIGNED_SHORT_5_5_5_1, {5, 5, 5, 1}, 4, false},
+        {GL_UNSIGNED_SHORT_1_5_5_5_REV, {5, 5, 5, 1}, 4, true},
+        {GL_UNSIGNED_SHORT_4_4_4_4, {4, 4, 4, 4}, 4, false},
+        {GL_UNSIGNED_SHORT_4_4_4_4_REV, {4, 4, 4, 4}, 4, true},
+        {GL_UNSIGNED_SHORT_5_6_5, {5, 6, 5}, 3, false},
+        {GL_UNSIGNED_SHORT_5_6_5_REV, {5, 6, 5}, 3, true},
+    };
+
+    const PackedType* packed_type(GLenum type) {
+        for (const PackedType& packed : kPackedTypes) {
+            if (packed.type == type) return &packed;
+        }
+        return nullptr;
+    }
+
+    // The RGBA channel each component of a format lands in
+    const int kLuminance = -1;
+    struct Channels {
+        int index[4];
+        int count;
+    };
+
+    Channels channels(GLenum format) {
+        switch (format) {
+        case GL_RGBA:
+            return {{0, 1, 2, 3}, 4};
+        case GL_BGRA:
+            return {{2, 1, 0, 3}, 4};
+        case GL_RGB:
+            return {{0, 1, 2}, 3};
+        case GL_BGR:
+            return {{2, 1, 0}, 3};
+        case GL_LUMINANCE:
+            return {{kLuminance}, 1};
+        case GL_ALPHA:
+            return {{3}, 1};
+        case GL_LUMINANCE_ALPHA:
+            return {{kLuminance, 3}, 2};
+        default:
+            return {{}, 0};
+        }
+    }
+
+    // A pixel as normalized RGBA, unpacked the way the GL spec describes it
+    struct Texel {
+        double c[4] = {0.0, 0.0, 0.0, 1.0};
+    };
+
+    Texel decode(GLenum format, GLenum type, const uint8_t* p) {
+        const Channels ch = channels(format);
+        uint32_t values[4] = {};
+        int bits[4] = {8, 8, 8, 8};
+        if (const PackedType* packed = packed_type(type)) {
+            int total = 0;
+            for (int i = 0; i < packed->count; ++i)
+                total += packed->bits[i];
+            uint32_t word = 0;
+            memcpy(&word, p, total / 8);
+            int shift = packed->rev ? 0 : total;
+            for (int i = 0; i < packed->count; ++i) {
+                bits[i] = packed->bits[i];
+                if (!packed->rev) shift -= bits[i];
+                values[i] = word >> shift & ((1u << bits[i]) - 1);
+                if (packed->rev) shift += bits[i];
+            }
+        } else {
+            for (int i = 0; i < ch.count; ++i)
+                values[i] = p[i];
+        }
+
+        Texel t;
+        for (int i = 0; i < ch.count; ++i) {
+            double c = values[i] / (double)((1u << bits[i]) - 1);
+            if (ch.index[i] == kLuminance)
+                t.c[0] = t.c[1] = t.c[2] = c;
+            else
+                t.c[ch.index[i]] = c;
+        }
+        return t;
+    }
+
+    void encode(GLenum format, GLenum type, const Texel& t, uint8_t* out) {
+        const Channels ch = channels(format);
+        auto quantize = [&](int i, int bits) { return (uint32_t)std::lround(t.c[ch.index[i]] * ((1u << bits) - 1)); };
+        if (const PackedType* packed = packed_type(type)) {
+            int total = 0;
+            for (int i = 0; i < packed->count; ++i)
+                total += packed->bits[i];
+            uint32_t word = 0;
+            int shift = packed->rev ? 0 : total;
+            for (int i = 0; i < packed->count; ++i) {
+                if (!packed->rev) shift -= packed->bits[i];
+                word |= quantize(i, packed->bits[i]) << shift;
+                if (packed->rev) shift += packed->bits[i];
+            }
+            memcpy(out, &word, total / 8);
+        } else {
+            for (int i = 0; i < ch.count; ++i)
+                out[i] = (uint8_t)quantize(i, 8);
+        }
+    }
+
+    struct Case {
+        GLenum format, type;
+        bool expand;
+        GLenum es_format, es_type;
+    };
+
+    // Every pair MobileGlues converts, and what GLES gets instead
+    const Case kCases[] = {
+        {GL_BGRA, GL_UNSIGNED_BYTE, false, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, false, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_INT_8_8_8_8, false, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, false, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV, false, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_SHORT_1_5_5_5_REV, false, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1},
+        {GL_RGBA, GL_UNSIGNED_SHORT_1_5_5_5_REV, false, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1},
+        {GL_BGRA, GL_UNSIGNED_SHORT_5_5_5_1, false, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1},
+        {GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4_REV, false, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4},
+        {GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4_REV, false, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4},
+        {GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4, false, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4},
+        {GL_RGB, GL_UNSIGNED_SHORT_5_6_5_REV, false, GL_RGB, GL_UNSIGNED_SHORT_5_6_5},
+        {GL_BGR, GL_UNSIGNED_SHORT_5_6_5, false, GL_RGB, GL_UNSIGNED_SHORT_5_6_5},
+        {GL_BGR, GL_UNSIGNED_SHORT_5_6_5_REV, false, GL_RGB, GL_UNSIGNED_SHORT_5_6_5},
+        {GL_BGR, GL_UNSIGNED_BYTE, false, GL_RGB, GL_UNSIGNED_BYTE},
+        {GL_LUMINANCE, GL_UNSIGNED_BYTE, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_ALPHA, GL_UNSIGNED_BYTE, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_SHORT_1_5_5_5_REV, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_UNSIGNED_SHORT_1_5_5_5_REV, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_SHORT_5_5_5_1, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4_REV, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4_REV, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGB, GL_UNSIGNED_SHORT_5_6_5, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGB, GL_UNSIGNED_SHORT_5_6_5_REV, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGR, GL_UNSIGNED_SHORT_5_6_5, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGR, GL_UNSIGNED_SHORT_5_6_5_REV, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_RGB, GL_UNSIGNED_BYTE, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGR, GL_UNSIGNED_BYTE, true, GL_RGBA, GL_UNSIGNED_BYTE},
+    };
+
+    std::string describe_case(const Case& c) {
+        return std::string(glEnumToString(c.format)) + "/" + glEnumToString(c.type) + (c.expand ? " expanded" : "");
+    }
+
+    // Every value of 1- and 2-byte pixels. Wider ones get every value in
+    // each byte with random neighbours, then random pixels.
+    std::vector<uint8_t> test_pixels(GLsizei size) {
+        std::vector<uint8_t> out;
+        if (size <= 2) {
+            const size_t count = (size_t)1 << (8 * size);
+            out.resize(count * size);
+            for (size_t i = 0; i < count; ++i) {
+                for (GLsizei k = 0; k < size; ++k)
+                    out[i * size + k] = (uint8_t)(i >> (8 * k));
+            }
+            return out;
+        }
+        uint32_t seed = 0x9E3779B9u;
+        auto next = [&] {
+            seed = seed * 1664525u + 1013904223u;
+            return (uint8_t)(seed >> 24);
+        };
+        for (GLsizei byte = 0; byte < size; ++byte) {
+            for (int v = 0; v < 256; ++v) {
+                for (GLsizei k = 0; k < size; ++k)
+                    out.push_back(k == byte ? (uint8_t)v : next());
+            }
+        }
+        for (GLsizei i = 0; i < 65536 * size; ++i)
+            out.push_back(next());
+        return out;
+    }
+
+    std::vector<uint8_t> reference(const Case& c, const std::vector<uint8_t>& src, GLsizei size, GLsizei es_size) {
+        const size_t count = src.size() / size;
+        std::vector<uint8_t> out(count * es_size);
+        for (size_t i = 0; i < count; ++i)
+            encode(c.es_format, c.es_type, decode(c.format, c.type, &src[i * size]), &out[i * es_size]);
+        return out;
+    }
+
+    // Reports the first pixel that differs
+    bool check_pixels(const std::string& what, const uint8_t* got, const uint8_t* expected, size_t count,
+                      GLsizei size, const char* file, int line) {
+        for (size_t i = 0; i < count; ++i) {
+            if (memcmp(got + i * size, expected + i * size, size) == 0) continue;
+            uint32_t g = 0, e = 0;
+            memcpy(&g, got + i * size, std::min<GLsizei>(size, 4));
+            memcpy(&e, expected + i * size, std::min<GLsizei>(size, 4));
+            char message[256];
+            snprintf(message, sizeof(message), "%s: pixel %zu is 0x%08x, expected 0x%08x", what.c_str(), i, g, e);
+            mg_test::fail(file, line, message);
+            return false;
+        }
+        return true;
+    }
+
+#define EXPECT_PIXELS(what, got, expected, count, size)                                                                \
+    check_pixels((what), (got), (expected), (count), (size), __FILE__, __LINE__)
+
+    // Upload source with a non-default unpack state around the pixels
+    struct Unpack {
+        GLint alignment = 8, row_length = 11, skip_pixels = 2, skip_rows = 1;
+
+        void apply() const {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length);
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, skip_pixels);
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, skip_rows);
+        }
+        static void reset() {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+        }
+
+        size_t row_bytes(GLsizei size) const {
+            return ((size_t)row_length * size + alignment - 1) / alignment * alignment;
+        }
+        // The client image, and the tightly packed pixels it holds
+        std::vector<uint8_t> image(const std::vector<uint8_t>& pixels, GLsizei width, GLsizei height,
+                                   GLsizei size) const {
+            std::vector<uint8_t> out(row_bytes(size) * (skip_rows + height), 0xEE);
+            for (GLsizei y = 0; y < height; ++y)
+                memcpy(&out[(skip_rows + y) * row_bytes(size) + skip_pixels * size], &pixels[(size_t)y * width * size],
+                       (size_t)width * size);
+            return out;
+        }
+    };
+} // namespace
+
+TEST(PixelConversion, MatchesSpecReference) {
+    for (const Case& c : kCases) {
+        const std::string what = describe_case(c);
+        const pixel_conversion_t* conversion = find_pixel_conversion(c.format, c.type, c.expand);
+        ASSERT_TRUE(conversion != nullptr);
+        EXPECT_EQ(conversion->es_format, c.es_format);
+        EXPECT_EQ(conversion->es_type, c.es_type);
+        EXPECT_EQ(conversion->size, pixel_sizeof(c.format, c.type));
+        EXPECT_EQ(conversion->es_size, pixel_sizeof(c.es_format, c.es_type));
+
+        const GLsizei size = conversion->size, es_size = conversion->es_size;
+        std::vector<uint8_t> src = test_pixels(size);
+        std::vector<uint8_t> expected = reference(c, src, size, es_size);
+        const size_t count = src.size() / size;
+        if (conversion->same_bytes) {
+            EXPECT_PIXELS(what + " same bytes", src.data(), expected.data(), count, size);
+            continue;
+        }
+
+        std::vector<uint8_t> got(expected.size(), 0xCD);
+        conversion->unpack(src.data(), got.data(), (GLsizei)count);
+        EXPECT_PIXELS(what, got.data(), expected.data(), count, es_size);
+
+        // Short rows run only the scalar tail, or one vector block and a
+        // tail, from unaligned addresses
+        std::vector<uint8_t> in(64 * size + 1), out(64 * es_size + 3);
+        for (GLsizei width = 1; width <= 64; ++width) {
+            memcpy(in.data() + 1, src.data() + (size_t)width * 3 * size, (size_t)width * size);
+            conversion->unpack(in.data() + 1, out.data() + 3, width);
+            if (!EXPECT_PIXELS(what + " width " + std::to_string(width), out.data() + 3,
+                               expected.data() + (size_t)width * 3 * es_size, width, es_size))
+                break;
+        }
+    }
+}
+
+TEST(PixelConversion, PackInvertsUnpack) {
+    size_t packable = 0;
+    for (const Case& c : kCases) {
+        const pixel_conversion_t* conversion = find_pixel_conversion(c.format, c.type, c.expand);
+        ASSERT_TRUE(conversion != nullptr);
+        if (conversion->same_bytes || !conversion->pack) continue;
+        ++packable;
+        EXPECT_EQ(conversion->size, conversion->es_size);
+        const std::string what = describe_case(c);
+        const GLsizei size = conversion->size;
+
+        // ES pixels as GLES returns them
+        std::vector<uint8_t> es = test_pixels(size);
+        const size_t count = es.size() / size;
+        const Case back{c.es_format, c.es_type, false, c.format, c.type};
+        std::vector<uint8_t> expected = reference(back, es, size, size);
+        std::vector<uint8_t> got(es.size(), 0xCD);
+        conversion->pack(es.data(), got.data(), (GLsizei)count);
+        EXPECT_PIXELS(what + " pack", got.data(), expected.data(), count, size);
+
+        // Pack buffers are converted in place
+        conversion->pack(es.data(), es.data(), (GLsizei)count);
+        EXPECT_PIXELS(what + " in place", es.data(), expected.data(), count, size);
+
+        std::vector<uint8_t> round_trip(got.size());
+        conversion->unpack(got.data(), round_trip.data(), (GLsizei)count);
+        conversion->pack(round_trip.data(), round_trip.data(), (GLsizei)count);
+        EXPECT_PIXELS(what + " round trip", round_trip.data(), got.data(), count, size);
+    }
+    EXPECT_EQ(packable, (size_t)4);
+}
+
+TEST(PixelConversion, NativePairsAreNotConverted) {
+    EXPECT_TRUE(find_pixel_conversion(GL_RGBA, GL_UNSIGNED_BYTE) == nullptr);
+    EXPECT_TRUE(find_pixel_conversion(GL_RGBA, GL_UNSIGNED_BYTE, true) == nullptr);
+    EXPECT_TRUE(find_pixel_conversion(GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4) == nullptr);
+    EXPECT_TRUE(find_pixel_conversion(GL_RGB, GL_UNSIGNED_SHORT_5_6_5) == nullptr);
+    EXPECT_TRUE(find_pixel_conversion(GL_RGB, GL_UNSIGNED_BYTE) == nullptr);
+    // Luminance and alpha textures GLES still has take their data as is
+    EXPECT_TRUE(find_pixel_conversion(GL_LUMINANCE, GL_UNSIGNED_BYTE) == nullptr);
+    EXPECT_TRUE(find_pixel_conversion(GL_ALPHA, GL_UNSIGNED_BYTE) == nullptr);
+}
+
+TEST(PixelConversion, MatchesLegacyPixelConvert) {
+    // The pairs the old scalar converter has a dedicated path for
+    const Case cases[] = {
+        {GL_BGRA, GL_UNSIGNED_BYTE, false, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_SHORT_1_5_5_5_REV, false, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1},
+        {GL_LUMINANCE, GL_UNSIGNED_BYTE, true, GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGR, GL_UNSIGNED_BYTE, false, GL_RGB, GL_UNSIGNED_BYTE},
+    };
+    for (const Case& c : cases) {
+        const pixel_conversion_t* conversion = find_pixel_conversion(c.format, c.type, c.expand);
+        ASSERT_TRUE(conversion != nullptr);
+        std::vector<uint8_t> src = test_pixels(conversion->size);
+        const GLuint count = (GLuint)(src.size() / conversion->size);
+        std::vector<uint8_t> legacy(count * conversion->es_size), got(legacy.size());
+        void* dst = legacy.data();
+        ASSERT_TRUE(pixel_convert(src.data(), &dst, count, 1, c.format, c.type, c.es_format, c.es_type, 0, 1));
+        conversion->unpack(src.data(), got.data(), (GLsizei)count);
+        EXPECT_PIXELS(describe_case(c), got.data(), legacy.data(), count, conversion->es_size);
+    }
+}
+
+TEST(PixelConversion, TexImageUploadsConvertedData) {
+    reset_gl_errors();
+    const GLsizei width = 9, height = 3;
+    const Unpack unpack;
+    // Internal format, and the level GLES ends up with
+    const struct {
+        Case c;
+        GLint internalformat;
+    } uploads[] = {
+        {{GL_BGRA, GL_UNSIGNED_BYTE, false, GL_RGBA, GL_UNSIGNED_BYTE}, GL_RGBA8},
+        {{GL_BGRA, GL_UNSIGNED_INT_8_8_8_8, false, GL_RGBA, GL_UNSIGNED_BYTE}, GL_RGBA8},
+        {{GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4_REV, false, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4}, GL_RGBA4},
+        {{GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4_REV, true, GL_RGBA, GL_UNSIGNED_BYTE}, GL_RGBA8},
+        {{GL_RGB, GL_UNSIGNED_SHORT_5_6_5, true, GL_RGBA, GL_UNSIGNED_BYTE}, GL_RGBA},
+        {{GL_BGR, GL_UNSIGNED_BYTE, true, GL_RGBA, GL_UNSIGNED_BYTE}, GL_RGBA8},
+        {{GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, true, GL_RGBA, GL_UNSIGNED_BYTE}, GL_LUMINANCE8_ALPHA8},
+    };
+
+    for (const auto& upload : uploads) {
+        const Case& c = upload.c;
+        const GLsizei size = pixel_sizeof(c.format, c.type), es_size = pixel_sizeof(c.es_format, c.es_type);
+        std::vector<uint8_t> pixels = test_pixels(size);
+        pixels.resize((size_t)width * height * size);
+        std::vector<uint8_t> expected = reference(c, pixels, size, es_size);
+
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        unpack.apply();
+        std::vector<uint8_t> image = unpack.image(pixels, width, height, size);
+        glTexImage2D(GL_TEXTURE_2D, 0, upload.internalformat, width, height, 0, c.format, c.type, image.data());
+
+        const mg_mock::TexLevel* level = mg_mock::texture_level(texture, 0);
+        ASSERT_TRUE(level != nullptr);
+        EXPECT_EQ(level->format, c.es_format);
+        EXPECT_EQ(level->type, c.es_type);
+        EXPECT_EQ(level->data.size(), expected.size());
+        if (level->data.size() == expected.size())
+            EXPECT_PIXELS(describe_case(c), level->data.data(), expected.data(), expected.size() / es_size, es_size);
+
+        // A sub-image of the first two rows, shifted by one texel
+        std::vector<uint8_t> sub(pixels.begin(), pixels.begin() + (size_t)(width - 1) * 2 * size);
+        std::vector<uint8_t> sub_expected = reference(c, sub, size, es_size);
+        image = unpack.image(sub, width - 1, 2, size);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 1, 1, width - 1, 2, c.format, c.type, image.data());
+        for (GLsizei y = 0; y < 2 && level->data.size() == expected.size(); ++y) {
+            EXPECT_PIXELS(describe_case(c) + " sub-image", &level->data[((size_t)(y + 1) * width + 1) * es_size],
+                          &sub_expected[(size_t)y * (width - 1) * es_size], width - 1, es_size);
+        }
+
+        // The application's unpack state is back once the upload is done
+        GLint row_length = 0;
+        MOCK_GL(glGetIntegerv)(GL_UNPACK_ROW_LENGTH, &row_length);
+        EXPECT_EQ(row_length, unpack.row_length);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDeleteTextures(1, &texture);
+    }
+    Unpack::reset();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+BENCH(PixelConversion, Throughput) {
+    const GLsizei width = 1024, height = 256;
+    const double megapixels = width * height / 1e6;
+    std::vector<uint8_t> src((size_t)width * height * 4), dst((size_t)width * height * 4);
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = (uint8_t)(i * 7 + 3);
+
+    for (const Case& c : kCases) {
+        const pixel_conversion_t* conversion = find_pixel_conversion(c.format, c.type, c.expand);
+        if (!conversion || conversion->same_bytes) continue;
+        const size_t rowBytes = (size_t)width * conversion->size, esRowBytes = (size_t)width * conversion->es_size;
+        mg_test::measure(("unpack " + describe_case(c)).c_str(), 50, "Mpx", [&] {
+            for (GLsizei y = 0; y < height; ++y)
+                conversion->unpack(src.data() + y * rowBytes, dst.data() + y * esRowBytes, width);
+        }, megapixels);
+        if (conversion->pack) {
+            mg_test::measure(("pack " + describe_case(c)).c_str(), 50, "Mpx", [&] {
+                for (GLsizei y = 0; y < height; ++y)
+                    conversion->pack(dst.data() + y * esRowBytes, dst.data() + y * esRowBytes, width);
+            }, megapixels);
+        }
+    }
+
+    // The scalar converter the engine replaced, for comparison
+    mg_test::measure("pixel_convert BGRA/GL_UNSIGNED_BYTE", 50, "Mpx", [&] {
+        void* out = dst.data();
+        pixel_convert(src.data(), &out, width, height, GL_BGRA, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_BYTE, 0, 1);
+    }, megapixels);
+    mg_test::measure("pixel_convert BGRA/GL_UNSIGNED_SHORT_1_5_5_5_REV", 50, "Mpx", [&] {
+        void* out = dst.data();
+        pixel_convert(src.data(), &out, width, height, GL_BGRA, GL_UNSIGNED_SHORT_1_5_5_5_REV, GL_RGBA,
+                      GL_UNSIGNED_SHORT_5_5_5_1, 0, 1);
+    }, megapixels);
+
+    // The whole upload path, including the mock storing the texels
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    mg_mock::set_recording(false);
+    mg_test::measure("glTexSubImage2D BGRA/GL_UNSIGNED_BYTE", 50, "Mpx", [&] {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, src.data());
+    }, megapixels);
+    mg_mock::set_recording(true);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDeleteTextures(1, &texture);
+}
@@ -0,0 +1,156 @@
+// MobileGlues - tests/test_proc_address.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/immediate.h"
+#include "gles/loader.h"
+#include "glx/lookup.h"
+#include "test_util.h"
+#include <dlfcn.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    // What LWJGL asks for while creating its capabilities, in miniature
+    const char* const kNames[] = {
+        "glBegin",          "glEnd",           "glVertex3f",        "glDrawArrays",     "glDrawElements",
+        "glBindTexture",    "glTexImage2D",    "glTexSubImage2D",   "glBindBuffer",     "glBufferData",
+        "glBufferSubData",  "glMapBufferRange", "glUseProgram",     "glUniform4f",      "glEnable",
+        "glDisable",        "glBlendFunc",     "glViewport",        "glClear",          "glGetIntegerv",
+        "glGetString",      "glGenTextures",   "glDeleteTextures",  "glReadPixels",     "glBindFramebuffer",
+        "glTexParameteri",  "glColor4f",       "glMatrixMode",      "glCallList",       "glNewList",
+        "glGetProgramiv",   "glLinkProgram",
+    };
+
+    // Extension entry points LWJGL probes for and MobileGlues does not have
+    const char* const kMissing[] = {"glMapObjectBufferATI", "glMapTexture2DINTEL", "glMapNamedBufferEXT",
+                                    "glGetObjectLabelEXT"};
+
+    // Runs test_main again with MG_TIME_PROC_INIT set, which makes it time
+    // proc_init and exit, and returns the time it printed
+    double proc_init_ms_in_fresh_process() {
+        int fds[2];
+        if (pipe(fds) != 0) return -1.0;
+        fflush(stdout);
+        pid_t child = fork();
+        if (child == 0) {
+            dup2(fds[1], STDOUT_FILENO);
+            close(fds[0]);
+            close(fds[1]);
+            setenv("MG_TIME_PROC_INIT", "1", 1);
+            execl("/proc/self/exe", "mobileglues_tests", (char*)nullptr);
+            _exit(127);
+        }
+        close(fds[1]);
+        std::string output;
+        char chunk[4096];
+        ssize_t n;
+        while ((n = read(fds[0], chunk, sizeof(chunk))) > 0)
+            output.append(chunk, (size_t)n);
+        close(fds[0]);
+        int status = 0;
+        if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            return -1.0;
+        // After whatever proc_init itself logged to stdout
+        size_t at = output.rfind("proc_init ");
+        double ms = -1.0;
+        if (at == std::string::npos || sscanf(output.c_str() + at, "proc_init %lf ms", &ms) != 1) return -1.0;
+        return ms;
+    }
+} // namespace
+
+TEST(ProcAddress, ResolvesOurEntryPoints) {
+    EXPECT_TRUE(glXGetProcAddress("glBegin") == (void*)&glBegin);
+    EXPECT_TRUE(glXGetProcAddress("glDrawArrays") == (void*)&glDrawArrays);
+    EXPECT_TRUE(glXGetProcAddress("glDrawArrays") != mg_mock::proc("glDrawArrays"));
+    EXPECT_TRUE(glXGetProcAddressARB("glBegin") == glXGetProcAddress("glBegin"));
+    EXPECT_TRUE(glXGetProcAddress(nullptr) == nullptr);
+
+    // Misses are answered from the cache as well, and stay misses
+    for (const char* name : kMissing) {
+        EXPECT_TRUE(glXGetProcAddress(name) == nullptr);
+        EXPECT_TRUE(glXGetProcAddress(name) == nullptr);
+    }
+
+    // The cache is keyed by the name, not by the pointer passed in
+    std::string copy = "glEnd";
+    EXPECT_TRUE(glXGetProcAddress(copy.c_str()) == (void*)&glEnd);
+}
+
+TEST(ProcAddress, BackendFunctionsBindOnFirstCall) {
+    void* driver = mg_mock::proc("glReleaseShaderCompiler");
+    ASSERT_TRUE(driver != nullptr);
+    // Nothing in MobileGlues calls this one, so it still holds the trampoline
+    EXPECT_TRUE((void*)GLES.glReleaseShaderCompiler != driver);
+
+    mg_mock::clear_calls();
+    GLES.glReleaseShaderCompiler();
+    EXPECT_EQ(mg_mock::count("glReleaseShaderCompiler"), (size_t)1);
+    EXPECT_TRUE((void*)GLES.glReleaseShaderCompiler == driver);
+
+    GLES.glReleaseShaderCompiler();
+    EXPECT_EQ(mg_mock::count("glReleaseShaderCompiler"), (size_t)2);
+
+    // Pointers tested for presence are resolved up front
+    EXPECT_TRUE((void*)GLES.glBufferStorageEXT == mg_mock::proc("glBufferStorageEXT"));
+    EXPECT_TRUE((void*)GLES.glProgramBinary == mg_mock::proc("glProgramBinary"));
+}
+
+BENCH(ProcAddress, Lookups) {
+    const size_t n = sizeof(kNames) / sizeof(kNames[0]);
+    // The backend lookups startup used to make for every table entry, and
+    // now makes only for the entries a game calls
+    mg_test::measure("backend dlsym at init", 2000, "lookups", [&] {
+        for (const char* name : kNames)
+            gles_resolve(name);
+    }, n);
+
+    // The global search every glXGetProcAddress used to make
+    mg_test::measure("dlsym(RTLD_DEFAULT)", 2000, "lookups", [&] {
+        for (const char* name : kNames)
+            dlsym(RTLD_DEFAULT, name);
+    }, n);
+
+    mg_test::measure("glXGetProcAddress, cached", 2000, "lookups", [&] {
+        for (const char* name : kNames)
+            glXGetProcAddress(name);
+    }, n);
+    mg_test::measure("glXGetProcAddress, cached miss", 2000, "lookups", [&] {
+        for (const char* name : kMissing)
+            glXGetProcAddress(name);
+    }, sizeof(kMissing) / sizeof(kMissing[0]));
+
+    // Render and loader threads asking at once, which no longer serialize
+    const unsigned threads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    char label[64];
+    snprintf(label, sizeof(label), "glXGetProcAddress, cached, %u threads", threads);
+    mg_test::measure(label, 1, "lookups", [&] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([] {
+                for (int i = 0; i < 2000; ++i) {
+                    for (const char* name : kNames)
+                        glXGetProcAddress(name);
+                }
+            });
+        }
+        for (std::thread& worker : workers)
+            worker.join();
+    }, 2000.0 * n * threads);
+
+    // Startup, with nothing resolved or cached yet
+    const int runs = 10;
+    double total = 0, fastest = 0;
+    for (int i = 0; i < runs; ++i) {
+        double ms = proc_init_ms_in_fresh_process();
+        ASSERT_TRUE(ms >= 0);
+        total += ms;
+        fastest = i == 0 ? ms : std::min(fastest, ms);
+    }
+    printf("  %-48s %14.3f ms  (fastest %.3f ms, %d processes)\n", "proc_init in a fresh process", total / runs,
+           fastest, runs);
+}
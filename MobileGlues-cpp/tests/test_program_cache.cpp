@@ -0,0 +1,211 @@
+// MobileGlues - tests/test_program_cache.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "config/config.h"
+#include "config/settings.h"
+#include "gl/glsl/cache.h"
+#include "gl/glsl/program_cache.h"
+#include "test_util.h"
+#include <xxhash32.h>
+
+namespace {
+    // Sources are tagged per test so nothing is served from an earlier test's entries
+    struct Sources {
+        std::string vertex, fragment;
+    };
+
+    Sources sources_for(const char* tag) {
+        std::string comment = std::string("// ") + tag + "\n";
+        return {"#version 300 es\n" + comment +
+                    "in vec4 position;\nout vec4 v_color;\n"
+                    "void main() { v_color = position; gl_Position = position; }\n",
+                "#version 300 es\n" + comment +
+                    "precision mediump float;\nin vec4 v_color;\nout vec4 color;\n"
+                    "void main() { color = v_color; }\n"};
+    }
+
+    GLuint compiled(GLenum type, const std::string& source) {
+        GLuint shader = glCreateShader(type);
+        const char* src = source.c_str();
+        glShaderSource(shader, 1, &src, nullptr);
+        glCompileShader(shader);
+        return shader;
+    }
+
+    // Creates and links a program from `sources`, `setup` runs before the link.
+    // Returns whether the driver had to link it, i.e. the cache missed.
+    template <typename Setup> bool link_needed(const Sources& sources, Setup setup) {
+        GLuint vs = compiled(GL_VERTEX_SHADER, sources.vertex);
+        GLuint fs = compiled(GL_FRAGMENT_SHADER, sources.fragment);
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vs);
+        glAttachShader(program, fs);
+        setup(program);
+        size_t links = mg_mock::link_count();
+        glLinkProgram(program);
+        GLint status = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+        EXPECT_EQ(status, GL_TRUE);
+        glDeleteShader(vs);
+        glDeleteShader(fs);
+        return mg_mock::link_count() != links;
+    }
+
+    bool link_needed(const Sources& sources) {
+        return link_needed(sources, [](GLuint) {});
+    }
+
+    std::vector<std::filesystem::path> binary_files() {
+        std::vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::directory_iterator(program_cache_dir_path)) {
+            if (entry.path().extension() == ".bin") files.push_back(entry.path());
+        }
+        return files;
+    }
+
+    // The binary added to the cache directory by linking `sources`
+    std::filesystem::path stored_binary(const Sources& sources) {
+        auto before = binary_files();
+        EXPECT_TRUE(link_needed(sources));
+        for (const auto& path : binary_files()) {
+            if (std::find(before.begin(), before.end(), path) == before.end()) return path;
+        }
+        return {};
+    }
+} // namespace
+
+TEST(ProgramCache, IsEnabledOnTheMock) {
+    EXPECT_TRUE(ProgramBinaryCache::get_instance().enabled());
+}
+
+TEST(ProgramCache, SameSourcesRestoreFromBinary) {
+    Sources sources = sources_for("restore");
+    EXPECT_TRUE(link_needed(sources));
+    EXPECT_FALSE(link_needed(sources));
+}
+
+TEST(ProgramCache, HitsCompileNothing) {
+    Sources sources = sources_for("compiles");
+    size_t compiles = mg_mock::compile_count();
+    EXPECT_TRUE(link_needed(sources));
+    EXPECT_EQ(mg_mock::compile_count(), compiles + 2);
+
+    compiles = mg_mock::compile_count();
+    EXPECT_FALSE(link_needed(sources));
+    EXPECT_EQ(mg_mock::compile_count(), compiles);
+}
+
+TEST(ProgramCache, RejectedBinaryFallsBackToLink) {
+    Sources sources = sources_for("rejected");
+    EXPECT_TRUE(link_needed(sources));
+    mg_mock::set_program_binary_rejected(true);
+    EXPECT_TRUE(link_needed(sources));
+    mg_mock::set_program_binary_rejected(false);
+    EXPECT_FALSE(link_needed(sources));
+}
+
+TEST(ProgramCache, LinkStateIsPartOfTheKey) {
+    Sources sources = sources_for("state");
+    EXPECT_TRUE(link_needed(sources));
+
+    auto bind = [](GLuint program) { glBindAttribLocation(program, 3, "position"); };
+    EXPECT_TRUE(link_needed(sources, bind));
+    EXPECT_FALSE(link_needed(sources, bind));
+
+    auto varyings = [](GLuint program) {
+        const char* names[] = {"v_color"};
+        glTransformFeedbackVaryings(program, 1, names, GL_INTERLEAVED_ATTRIBS);
+    };
+    EXPECT_TRUE(link_needed(sources, varyings));
+    EXPECT_FALSE(link_needed(sources, varyings));
+    auto separate = [](GLuint program) {
+        const char* names[] = {"v_color"};
+        glTransformFeedbackVaryings(program, 1, names, GL_SEPARATE_ATTRIBS);
+    };
+    EXPECT_TRUE(link_needed(sources, separate));
+
+    auto separable = [](GLuint program) { glProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_TRUE); };
+    EXPECT_TRUE(link_needed(sources, separable));
+    EXPECT_FALSE(link_needed(sources, separable));
+
+    // The unadorned program still maps to its own entry
+    EXPECT_FALSE(link_needed(sources));
+}
+
+// An entry whose stored key differs (a hash collision) must not be loaded
+TEST(ProgramCache, StoredKeyIsCompared) {
+    auto before = binary_files();
+    Sources sources = sources_for("collision");
+    EXPECT_TRUE(link_needed(sources));
+    auto after = binary_files();
+    ASSERT_EQ(after.size(), before.size() + 1);
+    std::filesystem::path entry;
+    for (const auto& path : after) {
+        if (std::find(before.begin(), before.end(), path) == before.end()) entry = path;
+    }
+
+    // Swap the key for another one of the same length, with a valid checksum
+    std::string data = read_text_file(entry);
+    const size_t header_size = 20, key_offset = header_size;
+    uint32_t key_length, binary_length;
+    memcpy(&binary_length, data.data() + 8, 4);
+    memcpy(&key_length, data.data() + 12, 4);
+    ASSERT_EQ(data.size(), header_size + key_length + binary_length);
+    data[key_offset] ^= 0x5A;
+    uint32_t checksum = XXHash32::hash(data.data() + key_offset, key_length + binary_length, 0x3250474d);
+    memcpy(data.data() + 16, &checksum, 4);
+    {
+        std::ofstream out(entry, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), (std::streamsize)data.size());
+    }
+
+    EXPECT_TRUE(link_needed(sources));
+    EXPECT_FALSE(link_needed(sources));
+}
+
+TEST(ProgramCache, BudgetIsSharedWithGlslCache) {
+    size_t saved = global_settings.max_glsl_cache_size;
+    Sources sources = sources_for("budget");
+    // A one byte budget leaves no room for the binary
+    global_settings.max_glsl_cache_size = 1;
+    size_t files = binary_files().size();
+    EXPECT_TRUE(link_needed(sources));
+    EXPECT_EQ(binary_files().size(), files);
+    global_settings.max_glsl_cache_size = saved;
+    EXPECT_TRUE(link_needed(sources));
+    EXPECT_FALSE(link_needed(sources));
+}
+
+TEST(ProgramCache, FullBudgetEvictsLeastRecentlyUsed) {
+    size_t saved = global_settings.max_glsl_cache_size;
+    Sources a = sources_for("evict-a"), b = sources_for("evict-b"), c = sources_for("evict-c");
+    std::filesystem::path a_file = stored_binary(a), b_file = stored_binary(b);
+    ASSERT_TRUE(!a_file.empty());
+    ASSERT_TRUE(!b_file.empty());
+
+    // Everything else is newer; a is older than b until it is loaded again
+    auto now = std::filesystem::file_time_type::clock::now();
+    for (const auto& path : binary_files())
+        std::filesystem::last_write_time(path, now);
+    std::filesystem::last_write_time(a_file, now - std::chrono::hours(2));
+    std::filesystem::last_write_time(b_file, now - std::chrono::hours(1));
+    EXPECT_FALSE(link_needed(a));
+
+    // No room left: storing c must push out b rather than be refused
+    size_t used = Cache::get_instance().size();
+    for (const auto& path : binary_files())
+        used += std::filesystem::file_size(path);
+    global_settings.max_glsl_cache_size = used;
+    std::filesystem::path c_file = stored_binary(c);
+    EXPECT_FALSE(c_file.empty());
+    EXPECT_TRUE(std::filesystem::exists(a_file));
+    EXPECT_FALSE(std::filesystem::exists(b_file));
+    EXPECT_FALSE(link_needed(c));
+    EXPECT_FALSE(link_needed(a));
+    global_settings.max_glsl_cache_size = saved;
+    EXPECT_TRUE(link_needed(b));
+}
@@ -0,0 +1,314 @@
+// MobileGlues - tests/test_readback.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/buffer.h"
+#include "test_util.h"
+
+namespace {
+    const GLsizei kWidth = 5, kHeight = 3;
+
+    // Distinct bytes per texel and channel, so swizzles and row order show
+    std::vector<uint8_t> texels(GLsizei width, GLsizei height, GLsizei layers = 1) {
+        std::vector<uint8_t> out((size_t)width * height * layers * 4);
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] = (uint8_t)(i * 7 + 3);
+        return out;
+    }
+
+    // The bytes one RGBA8 texel reads back as, for a desktop format/type pair
+    void expected_texel(GLenum format, GLenum type, const uint8_t* rgba, uint8_t* out) {
+        const uint8_t r = rgba[0], g = rgba[1], b = rgba[2], a = rgba[3];
+        uint32_t packed = 0;
+        if (type == GL_UNSIGNED_BYTE) {
+            const uint8_t rgba_order[4] = {r, g, b, a}, bgra_order[4] = {b, g, r, a};
+            memcpy(out, format == GL_BGRA ? bgra_order : rgba_order, 4);
+            return;
+        }
+        const bool bgra = format == GL_BGRA;
+        const uint32_t c0 = bgra ? b : r, c2 = bgra ? r : b;
+        if (type == GL_UNSIGNED_INT_8_8_8_8)
+            packed = c0 << 24 | (uint32_t)g << 16 | c2 << 8 | a;
+        else // GL_UNSIGNED_INT_8_8_8_8_REV
+            packed = (uint32_t)a << 24 | c2 << 16 | (uint32_t)g << 8 | c0;
+        memcpy(out, &packed, 4);
+    }
+
+    struct Pair {
+        GLenum format, type;
+    };
+
+    const Pair kPairs[] = {
+        {GL_RGBA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_BYTE},
+        {GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV},
+        {GL_BGRA, GL_UNSIGNED_INT_8_8_8_8},
+        {GL_RGBA, GL_UNSIGNED_INT_8_8_8_8},
+        {GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV},
+    };
+
+    // Pack state of a readback, and the layout it implies for 4-byte pixels
+    struct Pack {
+        GLint alignment = 4, row_length = 0, skip_pixels = 0, skip_rows = 0, image_height = 0, skip_images = 0;
+
+        void apply() const {
+            glPixelStorei(GL_PACK_ALIGNMENT, alignment);
+            glPixelStorei(GL_PACK_ROW_LENGTH, row_length);
+            glPixelStorei(GL_PACK_SKIP_PIXELS, skip_pixels);
+            glPixelStorei(GL_PACK_SKIP_ROWS, skip_rows);
+            glPixelStorei(GL_PACK_IMAGE_HEIGHT, image_height);
+            glPixelStorei(GL_PACK_SKIP_IMAGES, skip_images);
+        }
+
+        size_t row_bytes(GLsizei width) const {
+            size_t bytes = (size_t)(row_length ? row_length : width) * 4;
+            return (bytes + alignment - 1) / alignment * alignment;
+        }
+        size_t image_bytes(GLsizei width, GLsizei height) const {
+            return row_bytes(width) * (image_height ? image_height : height);
+        }
+        size_t offset(GLsizei width, GLsizei height, GLint x, GLint y, GLint layer) const {
+            return (size_t)(skip_images + layer) * image_bytes(width, height) +
+                   (size_t)(skip_rows + y) * row_bytes(width) + (size_t)(skip_pixels + x) * 4;
+        }
+        size_t span(GLsizei width, GLsizei height, GLsizei layers) const {
+            return offset(width, height, width, height - 1, layers - 1);
+        }
+    };
+
+    // What a readback of `source` leaves in memory that was filled with 0xCD
+    std::vector<uint8_t> expected_readback(const std::vector<uint8_t>& source, GLsizei width, GLsizei height,
+                                           GLsizei layers, Pair pair, const Pack& pack) {
+        std::vector<uint8_t> out(pack.span(width, height, layers), 0xCD);
+        for (GLint layer = 0; layer < layers; ++layer) {
+            for (GLint y = 0; y < height; ++y) {
+                for (GLint x = 0; x < width; ++x) {
+                    const uint8_t* texel = source.data() + (((size_t)layer * height + y) * width + x) * 4;
+                    expected_texel(pair.format, pair.type, texel, out.data() + pack.offset(width, height, x, y, layer));
+                }
+            }
+        }
+        return out;
+    }
+
+    struct Texture {
+        GLenum target;
+        GLuint name = 0;
+
+        Texture(GLenum target, GLsizei width, GLsizei height, GLsizei depth, const std::vector<uint8_t>& data)
+            : target(target) {
+            glGenTextures(1, &name);
+            glBindTexture(target, name);
+            if (depth)
+                glTexImage3D(target, 0, GL_RGBA8, width, height, depth, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+            else
+                glTexImage2D(target, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+        }
+
+        ~Texture() {
+            glBindTexture(target, 0);
+            glDeleteTextures(1, &name);
+        }
+    };
+
+    // Reads go through a framebuffer with the texture attached
+    struct ReadFramebuffer {
+        GLuint fbo = 0;
+
+        explicit ReadFramebuffer(GLuint texture) {
+            glGenFramebuffers(1, &fbo);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+            glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+        }
+
+        ~ReadFramebuffer() {
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &fbo);
+        }
+    };
+
+    struct PackBuffer {
+        GLuint name = 0;
+
+        explicit PackBuffer(size_t size) {
+            std::vector<uint8_t> fill(size, 0xCD);
+            glGenBuffers(1, &name);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, name);
+            glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)size, fill.data(), GL_STREAM_READ);
+        }
+
+        std::vector<uint8_t> map(size_t size) {
+            auto* data = (const uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT);
+            std::vector<uint8_t> out;
+            if (data) out.assign(data, data + size);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            return out;
+        }
+
+        ~PackBuffer() {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            glDeleteBuffers(1, &name);
+        }
+    };
+
+    void reset_pack() {
+        Pack{}.apply();
+    }
+} // namespace
+
+TEST(Readback, GetTexImageFormats) {
+    reset_gl_errors();
+    std::vector<uint8_t> source = texels(kWidth, kHeight);
+    Texture texture(GL_TEXTURE_2D, kWidth, kHeight, 0, source);
+    Pack packs[3];
+    packs[1].alignment = 8;
+    packs[1].row_length = 7;
+    packs[1].skip_pixels = 1;
+    packs[2].skip_rows = 2;
+    packs[2].alignment = 1;
+
+    for (const Pack& pack : packs) {
+        pack.apply();
+        for (Pair pair : kPairs) {
+            std::vector<uint8_t> expected = expected_readback(source, kWidth, kHeight, 1, pair, pack);
+            std::vector<uint8_t> got(expected.size() + 16, 0xCD);
+            glGetTexImage(GL_TEXTURE_2D, 0, pair.format, pair.type, got.data());
+            got.resize(expected.size());
+            EXPECT_TRUE(got == expected);
+        }
+    }
+    reset_pack();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Readback, GetTexImageLayers) {
+    reset_gl_errors();
+    const GLsizei layers = 3;
+    std::vector<uint8_t> source = texels(kWidth, kHeight, layers);
+    Pack pack;
+    pack.image_height = kHeight + 1;
+    pack.skip_images = 1;
+    pack.apply();
+
+    for (GLenum target : {GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D}) {
+        Texture texture(target, kWidth, kHeight, layers, source);
+        mg_mock::clear_calls();
+        for (Pair pair : {kPairs[0], kPairs[1]}) {
+            std::vector<uint8_t> expected = expected_readback(source, kWidth, kHeight, layers, pair, pack);
+            std::vector<uint8_t> got(expected.size(), 0xCD);
+            glGetTexImage(target, 0, pair.format, pair.type, got.data());
+            EXPECT_TRUE(got == expected);
+        }
+        // One scratch framebuffer, reattached per layer
+        EXPECT_EQ(mg_mock::count("glFramebufferTextureLayer"), (size_t)(2 * layers));
+        EXPECT_EQ(mg_mock::count("glDeleteFramebuffers"), (size_t)0);
+    }
+    reset_pack();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Readback, PackBufferConversionWaitsForMap) {
+    reset_gl_errors();
+    std::vector<uint8_t> source = texels(kWidth, kHeight);
+    Texture texture(GL_TEXTURE_2D, kWidth, kHeight, 0, source);
+    ReadFramebuffer framebuffer(texture.name);
+    Pack pack;
+    pack.row_length = 6;
+    pack.apply();
+    const size_t size = pack.span(kWidth, kHeight, 1);
+
+    for (Pair pair : kPairs) {
+        PackBuffer buffer(size);
+        mg_mock::clear_calls();
+        glReadPixels(0, 0, kWidth, kHeight, pair.format, pair.type, nullptr);
+        // Packed by the driver into the buffer, nothing mapped yet
+        EXPECT_EQ(mg_mock::count("glMapBufferRange"), (size_t)0);
+        EXPECT_EQ(mg_mock::count("glReadPixels"), (size_t)1);
+        EXPECT_TRUE(mg_mock::calls_named("glReadPixels")[0].args[6] == 0);
+
+        std::vector<uint8_t> expected = expected_readback(source, kWidth, kHeight, 1, pair, pack);
+        EXPECT_TRUE(buffer.map(size) == expected);
+        // Converted once: mapping again sees the same bytes
+        EXPECT_TRUE(buffer.map(size) == expected);
+    }
+    reset_pack();
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(Readback, PackBufferWritesSettlePendingConversions) {
+    reset_gl_errors();
+    std::vector<uint8_t> source = texels(kWidth, kHeight);
+    Texture texture(GL_TEXTURE_2D, kWidth, kHeight, 0, source);
+    ReadFramebuffer framebuffer(texture.name);
+    reset_pack();
+    const Pair bgra = kPairs[1];
+    const size_t image = (size_t)kWidth * kHeight * 4;
+
+    // Two readbacks into one buffer, the second overlapping the first
+    {
+        PackBuffer buffer(image * 2);
+        glReadPixels(0, 0, kWidth, kHeight, bgra.format, bgra.type, nullptr);
+        glReadPixels(0, 0, kWidth, kHeight, bgra.format, bgra.type, (void*)(image / 2));
+        std::vector<uint8_t> expected(image * 2, 0xCD);
+        std::vector<uint8_t> once = expected_readback(source, kWidth, kHeight, 1, bgra, Pack{});
+        std::copy(once.begin(), once.end(), expected.begin());
+        std::copy(once.begin(), once.end(), expected.begin() + image / 2);
+        EXPECT_TRUE(buffer.map(image * 2) == expected);
+    }
+
+    // Reallocated storage drops the pending conversion
+    {
+        PackBuffer buffer(image);
+        glReadPixels(0, 0, kWidth, kHeight, bgra.format, bgra.type, nullptr);
+        std::vector<uint8_t> zeros(image, 0);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)image, zeros.data(), GL_STREAM_READ);
+        EXPECT_TRUE(buffer.map(image) == zeros);
+    }
+
+    // Copies out of the buffer see converted data
+    {
+        PackBuffer buffer(image);
+        glReadPixels(0, 0, kWidth, kHeight, bgra.format, bgra.type, nullptr);
+        GLuint copy = 0;
+        glGenBuffers(1, &copy);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, copy);
+        glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)image, nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer.name);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)image);
+        const std::vector<uint8_t>* copied = mg_mock::buffer_data(find_real_buffer(copy));
+        ASSERT_TRUE(copied != nullptr);
+        EXPECT_TRUE(*copied == expected_readback(source, kWidth, kHeight, 1, bgra, Pack{}));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        glDeleteBuffers(1, &copy);
+    }
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+BENCH(Readback, PackBufferReadback) {
+    const GLsizei width = 256, height = 256;
+    std::vector<uint8_t> source = texels(width, height);
+    Texture texture(GL_TEXTURE_2D, width, height, 0, source);
+    ReadFramebuffer framebuffer(texture.name);
+    reset_pack();
+    const size_t size = (size_t)width * height * 4;
+    mg_mock::set_recording(false);
+
+    std::vector<uint8_t> client(size);
+    mg_test::measure("glReadPixels BGRA, client memory", 200, "pixels",
+                     [&] { glReadPixels(0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, client.data()); },
+                     (double)width * height);
+    PackBuffer buffer(size);
+    mg_test::measure("glReadPixels BGRA, pack buffer", 200, "pixels",
+                     [&] { glReadPixels(0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, nullptr); },
+                     (double)width * height);
+    mg_test::measure("glReadPixels BGRA, pack buffer then map", 200, "pixels", [&] {
+        glReadPixels(0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }, (double)width * height);
+    mg_mock::set_recording(true);
+}
@@ -0,0 +1,244 @@
+// MobileGlues - tests/test_shader.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "config/settings.h"
+#include "gl/glsl/glsl_for_es.h"
+#include "gl/glsl/translator_pool.h"
+#include "gl/program.h"
+#include "gl/shader.h"
+#include "test_util.h"
+
+static const char* kDirectVertex = "#version 300 es\n"
+                                   "in vec4 position;\n"
+                                   "void main() { gl_Position = position; }\n";
+static const char* kDirectFragment = "#version 300 es\n"
+                                     "precision mediump float;\n"
+                                     "out vec4 color;\n"
+                                     "void main() { color = vec4(1.0); }\n";
+
+extern UnorderedMap<GLuint, uint64_t> shader_map_essl_hash;
+
+static GLuint make_shader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    return shader;
+}
+
+// Every worker count must produce exactly what the serial path produces
+TEST(Shader, PoolMatchesSerialTranslation) {
+    size_t saved_cache_size = global_settings.max_glsl_cache_size;
+    global_settings.max_glsl_cache_size = 0; // translate every time instead of serving the first run's result
+
+    struct Input {
+        std::string glsl;
+        GLenum type;
+    };
+    std::vector<Input> corpus;
+    for (const auto& path : corpus_files("glsl")) {
+        corpus.push_back({read_text_file(path), shader_type_of(path)});
+    }
+    ASSERT_TRUE(!corpus.empty());
+
+    TranslatorPool serial(0);
+    std::vector<TranslateResult> expected;
+    for (const Input& in : corpus) {
+        expected.push_back(serial.submit(in.glsl, in.type, 320, getGLSLVersion(in.glsl.c_str())).get());
+    }
+
+    for (unsigned workers : {1u, 2u, 4u}) {
+        TranslatorPool pool(workers);
+        std::vector<std::shared_future<TranslateResult>> futures;
+        // Several rounds so workers pick up shaders in varying order
+        for (int round = 0; round < 3; ++round) {
+            for (const Input& in : corpus) {
+                futures.push_back(pool.submit(in.glsl, in.type, 320, getGLSLVersion(in.glsl.c_str())));
+            }
+        }
+        for (size_t i = 0; i < futures.size(); ++i) {
+            const TranslateResult& got = futures[i].get();
+            EXPECT_EQ(got.essl, expected[i % corpus.size()].essl);
+            EXPECT_EQ(got.return_code, expected[i % corpus.size()].return_code);
+        }
+    }
+
+    global_settings.max_glsl_cache_size = saved_cache_size;
+}
+
+TEST(Shader, CompileWaitsForFirstObservation) {
+    GLuint shader = make_shader(GL_VERTEX_SHADER, kDirectVertex);
+    size_t compiles = mg_mock::compile_count();
+    glCompileShader(shader);
+    EXPECT_EQ(mg_mock::compile_count(), compiles);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    EXPECT_EQ(status, GL_TRUE);
+    EXPECT_EQ(mg_mock::compile_count(), compiles + 1);
+
+    // Already compiled, observing again must not recompile
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    EXPECT_EQ(mg_mock::compile_count(), compiles + 1);
+    glDeleteShader(shader);
+}
+
+TEST(Shader, LinkFlushesOnlyAttachedShaders) {
+    GLuint vs = make_shader(GL_VERTEX_SHADER, kDirectVertex);
+    GLuint fs = make_shader(GL_FRAGMENT_SHADER, kDirectFragment);
+    GLuint unrelated = make_shader(GL_FRAGMENT_SHADER, kDirectFragment);
+    glCompileShader(vs);
+    glCompileShader(fs);
+    glCompileShader(unrelated);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    size_t compiles = mg_mock::compile_count();
+    glLinkProgram(program);
+    EXPECT_EQ(mg_mock::compile_count(), compiles + 2);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    EXPECT_EQ(linked, GL_TRUE);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(unrelated, GL_COMPILE_STATUS, &status);
+    EXPECT_EQ(status, GL_TRUE);
+    EXPECT_EQ(mg_mock::compile_count(), compiles + 3);
+
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    glDeleteShader(unrelated);
+}
+
+// A fragment shader shared by two programs gets each program's own binding
+TEST(Shader, FragDataLocationIsPerProgram) {
+    GLuint vs = make_shader(GL_VERTEX_SHADER, kDirectVertex);
+    GLuint fs = make_shader(GL_FRAGMENT_SHADER, kDirectFragment);
+    GLuint other_fs = make_shader(GL_FRAGMENT_SHADER, kDirectFragment);
+    glCompileShader(vs);
+    glCompileShader(fs);
+    glCompileShader(other_fs);
+
+    GLuint a = glCreateProgram();
+    glAttachShader(a, vs);
+    glAttachShader(a, fs);
+    glBindFragDataLocation(a, 2, "color");
+
+    GLuint b = glCreateProgram();
+    glAttachShader(b, vs);
+    glAttachShader(b, other_fs);
+
+    glLinkProgram(a);
+    EXPECT_TRUE(mg_mock::shader_source(fs).find("layout (location = 2) out vec4 color;") != std::string::npos);
+    glLinkProgram(b);
+    EXPECT_EQ(mg_mock::shader_source(other_fs), std::string(kDirectFragment));
+    // Binding on b after the fact must not leak into a's shader
+    glBindFragDataLocation(b, 1, "color");
+    glLinkProgram(b);
+    EXPECT_TRUE(mg_mock::shader_source(other_fs).find("layout (location = 1) out vec4 color;") !=
+                std::string::npos);
+    EXPECT_TRUE(mg_mock::shader_source(fs).find("layout (location = 2) out vec4 color;") != std::string::npos);
+
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    glDeleteShader(other_fs);
+}
+
+// Replacing the source drops the old translation instead of joining and compiling it
+TEST(Shader, NewSourceDiscardsPendingTranslation) {
+    std::string legacy;
+    for (const auto& path : corpus_files("glsl")) {
+        if (shader_type_of(path) == GL_VERTEX_SHADER) legacy = read_text_file(path);
+    }
+    ASSERT_TRUE(!legacy.empty());
+    GLuint shader = make_shader(GL_VERTEX_SHADER, legacy.c_str());
+    glCompileShader(shader);
+
+    size_t compiles = mg_mock::compile_count();
+    size_t uploads = mg_mock::count("glShaderSource");
+    const char* source = kDirectVertex;
+    glShaderSource(shader, 1, &source, nullptr);
+    EXPECT_EQ(mg_mock::compile_count(), compiles);
+    EXPECT_EQ(mg_mock::count("glShaderSource"), uploads + 1);
+    EXPECT_EQ(mg_mock::shader_source(shader), std::string(kDirectVertex));
+
+    glCompileShader(shader);
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    EXPECT_EQ(status, GL_TRUE);
+    EXPECT_EQ(mg_mock::compile_count(), compiles + 1);
+    glDeleteShader(shader);
+}
+
+// Deleting forgets a shader once the driver has, an attached one is kept for the link
+TEST(Shader, DeleteForgetsFreedShaders) {
+    GLuint vs = make_shader(GL_VERTEX_SHADER, kDirectVertex);
+    GLuint fs = make_shader(GL_FRAGMENT_SHADER, kDirectFragment);
+    glCompileShader(vs);
+    glCompileShader(fs);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, fs);
+
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    EXPECT_EQ(shader_map_info.count(vs), (size_t)0);
+    EXPECT_EQ(shader_map_essl_hash.count(vs), (size_t)0);
+    EXPECT_EQ(shader_map_info.count(fs), (size_t)1);
+    EXPECT_EQ(shader_map_essl_hash.count(fs), (size_t)1);
+    glDeleteProgram(program);
+}
+
+// A deleted shader stays usable while attached, translation and all
+TEST(Shader, DeletedAttachedShaderKeepsItsTranslation) {
+    std::string legacy;
+    for (const auto& path : corpus_files("glsl")) {
+        if (shader_type_of(path) == GL_VERTEX_SHADER) legacy = read_text_file(path);
+    }
+    ASSERT_TRUE(!legacy.empty());
+    GLuint vs = make_shader(GL_VERTEX_SHADER, legacy.c_str());
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+
+    size_t compiles = mg_mock::compile_count();
+    glDeleteShader(vs);
+    EXPECT_EQ(mg_mock::compile_count(), compiles);
+    glCompileShader(vs);
+    GLint status = GL_FALSE;
+    glGetShaderiv(vs, GL_COMPILE_STATUS, &status);
+    EXPECT_EQ(status, GL_TRUE);
+    EXPECT_EQ(mg_mock::compile_count(), compiles + 1);
+    EXPECT_TRUE(!mg_mock::shader_source(vs).empty());
+    EXPECT_EQ(shader_map_essl_hash.count(vs), (size_t)1);
+    glDeleteProgram(program);
+}
+
+BENCH(Shader, CorpusTranslation) {
+    size_t saved_cache_size = global_settings.max_glsl_cache_size;
+    global_settings.max_glsl_cache_size = 0;
+    std::vector<std::pair<std::string, GLenum>> corpus;
+    for (const auto& path : corpus_files("glsl")) {
+        corpus.emplace_back(read_text_file(path), shader_type_of(path));
+    }
+    for (unsigned workers : {0u, 1u, 2u, 4u}) {
+        TranslatorPool pool(workers);
+        std::string label = "corpus x8, " + std::to_string(workers) + " worker(s)";
+        mg_test::measure(
+            label.c_str(), 5, "shaders",
+            [&] {
+                std::vector<std::shared_future<TranslateResult>> futures;
+                for (int round = 0; round < 8; ++round) {
+                    for (const auto& [glsl, type] : corpus) {
+                        futures.push_back(pool.submit(glsl, type, 320, getGLSLVersion(glsl.c_str())));
+                    }
+                }
+                for (auto& f : futures)
+                    f.wait();
+            },
+            8.0 * corpus.size());
+    }
+    global_settings.max_glsl_cache_size = saved_cache_size;
+}
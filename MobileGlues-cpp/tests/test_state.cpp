@@ -0,0 +1,506 @@
+// MobileGlues - tests/test_state.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "config/settings.h"
+#include "gl/state.h"
+#include "test_util.h"
+#include <future>
+#include <random>
+#include <thread>
+
+namespace {
+    struct ShadowedQuery {
+        GLenum pname;
+        int size;
+    };
+
+    // Every pname get_shadow_integerv answers that the mock models too
+    const ShadowedQuery kShadowedQueries[] = {
+        {GL_BLEND, 1},
+        {GL_CULL_FACE, 1},
+        {GL_DEPTH_TEST, 1},
+        {GL_DITHER, 1},
+        {GL_POLYGON_OFFSET_FILL, 1},
+        {GL_PRIMITIVE_RESTART_FIXED_INDEX, 1},
+        {GL_RASTERIZER_DISCARD, 1},
+        {GL_SAMPLE_ALPHA_TO_COVERAGE, 1},
+        {GL_SAMPLE_COVERAGE, 1},
+        {GL_SAMPLE_MASK, 1},
+        {GL_SCISSOR_TEST, 1},
+        {GL_STENCIL_TEST, 1},
+        {GL_CURRENT_PROGRAM, 1},
+        {GL_ACTIVE_TEXTURE, 1},
+        {GL_TEXTURE_BINDING_2D, 1},
+        {GL_DRAW_FRAMEBUFFER_BINDING, 1},
+        {GL_READ_FRAMEBUFFER_BINDING, 1},
+        {GL_RENDERBUFFER_BINDING, 1},
+        {GL_VIEWPORT, 4},
+        {GL_SCISSOR_BOX, 4},
+        {GL_BLEND_SRC_RGB, 1},
+        {GL_BLEND_DST_RGB, 1},
+        {GL_BLEND_SRC_ALPHA, 1},
+        {GL_BLEND_DST_ALPHA, 1},
+        {GL_BLEND_EQUATION_RGB, 1},
+        {GL_BLEND_EQUATION_ALPHA, 1},
+        {GL_COLOR_WRITEMASK, 4},
+        {GL_DEPTH_FUNC, 1},
+        {GL_DEPTH_WRITEMASK, 1},
+        {GL_STENCIL_FUNC, 1},
+        {GL_STENCIL_REF, 1},
+        {GL_STENCIL_VALUE_MASK, 1},
+        {GL_STENCIL_WRITEMASK, 1},
+        {GL_STENCIL_FAIL, 1},
+        {GL_STENCIL_PASS_DEPTH_FAIL, 1},
+        {GL_STENCIL_PASS_DEPTH_PASS, 1},
+        {GL_STENCIL_BACK_FUNC, 1},
+        {GL_STENCIL_BACK_REF, 1},
+        {GL_STENCIL_BACK_VALUE_MASK, 1},
+        {GL_STENCIL_BACK_WRITEMASK, 1},
+        {GL_STENCIL_BACK_FAIL, 1},
+        {GL_STENCIL_BACK_PASS_DEPTH_FAIL, 1},
+        {GL_STENCIL_BACK_PASS_DEPTH_PASS, 1},
+        {GL_PACK_ALIGNMENT, 1},
+        {GL_PACK_ROW_LENGTH, 1},
+        {GL_PACK_SKIP_PIXELS, 1},
+        {GL_PACK_SKIP_ROWS, 1},
+        {GL_UNPACK_ALIGNMENT, 1},
+        {GL_UNPACK_ROW_LENGTH, 1},
+        {GL_UNPACK_IMAGE_HEIGHT, 1},
+        {GL_UNPACK_SKIP_PIXELS, 1},
+        {GL_UNPACK_SKIP_ROWS, 1},
+        {GL_UNPACK_SKIP_IMAGES, 1},
+    };
+
+    const GLenum kCaps[] = {GL_BLEND,        GL_CULL_FACE,          GL_DEPTH_TEST,
+                            GL_DITHER,       GL_SCISSOR_TEST,       GL_STENCIL_TEST,
+                            GL_SAMPLE_COVERAGE, GL_POLYGON_OFFSET_FILL, GL_RASTERIZER_DISCARD};
+    const GLenum kBlendFactors[] = {GL_ZERO, GL_ONE, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_DST_COLOR};
+    const GLenum kBlendEquations[] = {GL_FUNC_ADD, GL_FUNC_SUBTRACT, GL_FUNC_REVERSE_SUBTRACT, GL_MIN, GL_MAX};
+    const GLenum kCompareFuncs[] = {GL_LESS, GL_LEQUAL, GL_EQUAL, GL_GREATER, GL_ALWAYS, GL_NEVER};
+    const GLenum kStencilOps[] = {GL_KEEP, GL_ZERO, GL_REPLACE, GL_INCR, GL_DECR_WRAP, GL_INVERT};
+    const GLenum kFaces[] = {GL_FRONT, GL_BACK, GL_FRONT_AND_BACK};
+    const GLenum kPixelStores[] = {GL_PACK_ALIGNMENT,      GL_PACK_ROW_LENGTH,     GL_PACK_SKIP_PIXELS,
+                                   GL_PACK_SKIP_ROWS,      GL_UNPACK_ALIGNMENT,    GL_UNPACK_ROW_LENGTH,
+                                   GL_UNPACK_IMAGE_HEIGHT, GL_UNPACK_SKIP_PIXELS,  GL_UNPACK_SKIP_ROWS,
+                                   GL_UNPACK_SKIP_IMAGES};
+
+    template <typename T, size_t N> T pick(std::mt19937& rng, const T (&values)[N]) {
+        return values[rng() % N];
+    }
+
+    // Compares what MobileGlues answers with the mock's true state
+    bool shadow_matches_driver(const char* step) {
+        bool matches = true;
+        for (const ShadowedQuery& query : kShadowedQueries) {
+            GLint shadow[4] = {-1, -1, -1, -1};
+            GLint driver[4] = {-1, -1, -1, -1};
+            glGetIntegerv(query.pname, shadow);
+            mg_mock::get_integerv(query.pname, driver);
+            for (int i = 0; i < query.size; ++i) {
+                if (shadow[i] == driver[i]) continue;
+                char message[160];
+                snprintf(message, sizeof(message), "after %s: pname 0x%04x[%d] is %d in the shadow, %d in the driver",
+                         step, query.pname, i, shadow[i], driver[i]);
+                mg_test::fail(__FILE__, __LINE__, message);
+                matches = false;
+                break;
+            }
+        }
+        return matches;
+    }
+
+    // Puts the state the random calls touch back to the context defaults, so
+    // later tests draw and read back with a clean context
+    struct DefaultStateOnExit {
+        GLint viewport[4] = {};
+        GLint scissor[4] = {};
+
+        DefaultStateOnExit() {
+            glGetIntegerv(GL_VIEWPORT, viewport);
+            glGetIntegerv(GL_SCISSOR_BOX, scissor);
+        }
+
+        ~DefaultStateOnExit() { apply(); }
+
+        void apply() const {
+            for (GLenum cap : kCaps) {
+                if (cap == GL_DITHER)
+                    glEnable(cap);
+                else
+                    glDisable(cap);
+            }
+            glBlendFunc(GL_ONE, GL_ZERO);
+            glBlendEquation(GL_FUNC_ADD);
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            glDepthFunc(GL_LESS);
+            glDepthMask(GL_TRUE);
+            glStencilFunc(GL_ALWAYS, 0, ~0u);
+            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            glStencilMask(~0u);
+            glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+            glScissor(scissor[0], scissor[1], scissor[2], scissor[3]);
+            for (GLenum pname : kPixelStores) {
+                bool alignment = pname == GL_PACK_ALIGNMENT || pname == GL_UNPACK_ALIGNMENT;
+                glPixelStorei(pname, alignment ? 4 : 0);
+            }
+            glClearDepth(1.0);
+            glActiveTexture(GL_TEXTURE0);
+            reset_gl_errors();
+        }
+    };
+
+    // Objects for the binding calls, created through MobileGlues
+    struct StateObjects {
+        GLuint textures[4] = {};
+        GLuint framebuffers[2] = {};
+        GLuint renderbuffers[2] = {};
+        GLuint buffers[3] = {};
+        GLuint vertexArrays[2] = {};
+
+        StateObjects() {
+            glGenTextures(4, textures);
+            glGenFramebuffers(2, framebuffers);
+            glGenRenderbuffers(2, renderbuffers);
+            glGenBuffers(3, buffers);
+            glGenVertexArrays(2, vertexArrays);
+        }
+
+        ~StateObjects() {
+            unbind();
+            glDeleteTextures(4, textures);
+            glDeleteFramebuffers(2, framebuffers);
+            glDeleteRenderbuffers(2, renderbuffers);
+            glDeleteBuffers(3, buffers);
+            glDeleteVertexArrays(2, vertexArrays);
+        }
+
+        void unbind() const {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glBindRenderbuffer(GL_RENDERBUFFER, 0);
+            glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            for (GLenum unit = 0; unit < 8; ++unit) {
+                glActiveTexture(GL_TEXTURE0 + unit);
+                glBindTexture(GL_TEXTURE_2D, 0);
+            }
+            glActiveTexture(GL_TEXTURE0);
+        }
+    };
+
+    // Issues one random state-setting call and returns its name
+    const char* random_state_call(std::mt19937& rng, const StateObjects& objects) {
+        switch (rng() % 17) {
+        case 0:
+            glEnable(pick(rng, kCaps));
+            return "glEnable";
+        case 1:
+            glDisable(pick(rng, kCaps));
+            return "glDisable";
+        case 2:
+            glBlendFunc(pick(rng, kBlendFactors), pick(rng, kBlendFactors));
+            return "glBlendFunc";
+        case 3:
+            glBlendFuncSeparate(pick(rng, kBlendFactors), pick(rng, kBlendFactors), pick(rng, kBlendFactors),
+                                pick(rng, kBlendFactors));
+            return "glBlendFuncSeparate";
+        case 4:
+            glBlendEquation(pick(rng, kBlendEquations));
+            return "glBlendEquation";
+        case 5:
+            glBlendEquationSeparate(pick(rng, kBlendEquations), pick(rng, kBlendEquations));
+            return "glBlendEquationSeparate";
+        case 6:
+            glColorMask(rng() & 1, rng() & 1, rng() & 1, rng() & 1);
+            return "glColorMask";
+        case 7:
+            glDepthFunc(pick(rng, kCompareFuncs));
+            glDepthMask(rng() & 1);
+            return "glDepthFunc/glDepthMask";
+        case 8:
+            if (rng() & 1)
+                glStencilFunc(pick(rng, kCompareFuncs), (GLint)(rng() % 256), rng() % 256);
+            else
+                glStencilFuncSeparate(pick(rng, kFaces), pick(rng, kCompareFuncs), (GLint)(rng() % 256), rng() % 256);
+            return "glStencilFunc";
+        case 9:
+            if (rng() & 1)
+                glStencilOp(pick(rng, kStencilOps), pick(rng, kStencilOps), pick(rng, kStencilOps));
+            else
+                glStencilOpSeparate(pick(rng, kFaces), pick(rng, kStencilOps), pick(rng, kStencilOps),
+                                    pick(rng, kStencilOps));
+            return "glStencilOp";
+        case 10:
+            if (rng() & 1)
+                glStencilMask(rng() % 256);
+            else
+                glStencilMaskSeparate(pick(rng, kFaces), rng() % 256);
+            return "glStencilMask";
+        case 11:
+            glViewport((GLint)(rng() % 64), (GLint)(rng() % 64), (GLsizei)(rng() % 512), (GLsizei)(rng() % 512));
+            return "glViewport";
+        case 12:
+            glScissor((GLint)(rng() % 64), (GLint)(rng() % 64), (GLsizei)(rng() % 512), (GLsizei)(rng() % 512));
+            return "glScissor";
+        case 13:
+            glActiveTexture(GL_TEXTURE0 + rng() % 8);
+            return "glActiveTexture";
+        case 14:
+            glBindTexture(GL_TEXTURE_2D, rng() % 5 ? objects.textures[rng() % 4] : 0);
+            return "glBindTexture";
+        case 15: {
+            const GLenum targets[] = {GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER, GL_READ_FRAMEBUFFER};
+            if (rng() & 1)
+                glBindFramebuffer(pick(rng, targets), rng() % 3 ? objects.framebuffers[rng() % 2] : 0);
+            else
+                glBindRenderbuffer(GL_RENDERBUFFER, rng() % 3 ? objects.renderbuffers[rng() % 2] : 0);
+            return "glBindFramebuffer/glBindRenderbuffer";
+        }
+        default: {
+            GLenum pname = pick(rng, kPixelStores);
+            bool alignment = pname == GL_PACK_ALIGNMENT || pname == GL_UNPACK_ALIGNMENT;
+            glPixelStorei(pname, alignment ? 1 << (rng() % 4) : (GLint)(rng() % 16));
+            return "glPixelStorei";
+        }
+        }
+    }
+
+    // random_state_call plus the filtered entry points that are not shadowed
+    // in gl_state. Values come from small sets so repeats are common.
+    const char* random_filtered_call(std::mt19937& rng, const StateObjects& objects) {
+        switch (rng() % 20) {
+        case 0: {
+            const GLenum targets[] = {GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER};
+            glBindBuffer(pick(rng, targets), rng() % 4 ? objects.buffers[rng() % 3] : 0);
+            return "glBindBuffer";
+        }
+        case 1:
+            glBindVertexArray(rng() % 3 ? objects.vertexArrays[rng() % 2] : 0);
+            return "glBindVertexArray";
+        case 2: {
+            const GLclampd depths[] = {0.0, 0.5, 1.0};
+            glClearDepth(pick(rng, depths));
+            return "glClearDepth";
+        }
+        default:
+            return random_state_call(rng, objects);
+        }
+    }
+
+    // The driver's state as far as the filtered calls can change it, read
+    // from the mock without going through MobileGlues
+    std::vector<GLint> driver_state() {
+        std::vector<GLint> state;
+        auto get = [&](GLenum pname, int size) {
+            GLint values[4] = {};
+            mg_mock::get_integerv(pname, values);
+            state.insert(state.end(), values, values + size);
+        };
+        for (const ShadowedQuery& query : kShadowedQueries)
+            get(query.pname, query.size);
+        get(GL_ARRAY_BUFFER_BINDING, 1);
+        get(GL_ELEMENT_ARRAY_BUFFER_BINDING, 1);
+        get(GL_UNIFORM_BUFFER_BINDING, 1);
+        get(GL_VERTEX_ARRAY_BINDING, 1);
+
+        GLint active = 0;
+        mg_mock::get_integerv(GL_ACTIVE_TEXTURE, &active);
+        for (GLenum unit = 0; unit < 8; ++unit) {
+            MOCK_GL(glActiveTexture)(GL_TEXTURE0 + unit);
+            get(GL_TEXTURE_BINDING_2D, 1);
+        }
+        MOCK_GL(glActiveTexture)((GLenum)active);
+
+        GLfloat clearDepth = 0.0f;
+        MOCK_GL(glGetFloatv)(GL_DEPTH_CLEAR_VALUE, &clearDepth);
+        state.push_back((GLint)(clearDepth * 1000.0f));
+        return state;
+    }
+
+    uint64_t total_dropped() {
+        uint64_t total = 0;
+        for (uint64_t dropped : g_state_filter_dropped)
+            total += dropped;
+        return total;
+    }
+} // namespace
+
+TEST(StateShadow, RandomCallsMatchDriver) {
+    reset_gl_errors();
+    DefaultStateOnExit defaults;
+    StateObjects objects;
+    ASSERT_TRUE(shadow_matches_driver("setup"));
+
+    std::mt19937 rng(10);
+    for (int step = 0; step < 3000; ++step) {
+        const char* call = random_state_call(rng, objects);
+        ASSERT_TRUE(shadow_matches_driver(call));
+    }
+}
+
+TEST(StateShadow, QueriesStayOnTheCpu) {
+    reset_gl_errors();
+    GLint rect[4];
+    // The initial viewport and scissor box are learned from the driver once
+    glGetIntegerv(GL_VIEWPORT, rect);
+    glGetIntegerv(GL_SCISSOR_BOX, rect);
+
+    mg_mock::clear_calls();
+    for (const ShadowedQuery& query : kShadowedQueries) {
+        GLint values[4];
+        glGetIntegerv(query.pname, values);
+    }
+    GLboolean mask[4];
+    glGetBooleanv(GL_COLOR_WRITEMASK, mask);
+    glGetBooleanv(GL_DEPTH_WRITEMASK, mask);
+    for (GLenum cap : kCaps)
+        glIsEnabled(cap);
+    EXPECT_EQ(mg_mock::count("glGetIntegerv"), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glGetBooleanv"), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glIsEnabled"), (size_t)0);
+}
+
+TEST(StateShadow, ScopeRestoresDriverAndShadow) {
+    reset_gl_errors();
+    DefaultStateOnExit defaults;
+    StateObjects objects;
+    std::mt19937 rng(11);
+    for (int step = 0; step < 50; ++step)
+        random_state_call(rng, objects);
+    ASSERT_TRUE(shadow_matches_driver("setup"));
+
+    const GLbitfield everything = STATE_SCOPE_PROGRAM | STATE_SCOPE_VERTEX_ARRAY | STATE_SCOPE_ARRAY_BUFFER |
+                                  STATE_SCOPE_TEXTURE | STATE_SCOPE_FRAMEBUFFER | STATE_SCOPE_RENDERBUFFER |
+                                  STATE_SCOPE_VIEWPORT | STATE_SCOPE_SCISSOR | STATE_SCOPE_CAPS | STATE_SCOPE_BLEND |
+                                  STATE_SCOPE_COLOR_MASK | STATE_SCOPE_DEPTH | STATE_SCOPE_STENCIL |
+                                  STATE_SCOPE_UNPACK;
+    for (int round = 0; round < 20; ++round) {
+        mg_mock::clear_calls();
+        {
+            StateScope scope(everything);
+            // Internal passes change state both through the front end and
+            // straight through GLES
+            for (int step = 0; step < 20; ++step)
+                random_state_call(rng, objects);
+            GLES.glBindFramebuffer(GL_FRAMEBUFFER, objects.framebuffers[1]);
+            GLES.glDisable(GL_DITHER);
+            GLES.glBlendFunc(GL_ONE, GL_ONE);
+            GLES.glViewport(1, 2, 3, 4);
+        }
+        EXPECT_EQ(mg_mock::count("glGetIntegerv"), (size_t)0);
+        ASSERT_TRUE(shadow_matches_driver("StateScope"));
+    }
+}
+
+TEST(StateFilter, FilteredStreamMatchesUnfiltered) {
+    reset_gl_errors();
+    DefaultStateOnExit defaults;
+    StateObjects objects;
+    const bool wasEnabled = global_settings.state_filter;
+
+    std::vector<GLint> finalState[2];
+    size_t driverCalls[2] = {};
+    uint64_t dropped[2] = {};
+    for (int filtered = 0; filtered < 2; ++filtered) {
+        // Both runs start from the same state, set without filtering
+        global_settings.state_filter = false;
+        objects.unbind();
+        defaults.apply();
+
+        global_settings.state_filter = filtered != 0;
+        const uint64_t droppedBefore = total_dropped();
+        mg_mock::clear_calls();
+        std::mt19937 rng(12);
+        for (int step = 0; step < 5000; ++step)
+            random_filtered_call(rng, objects);
+        driverCalls[filtered] = mg_mock::calls().size();
+        dropped[filtered] = total_dropped() - droppedBefore;
+        finalState[filtered] = driver_state();
+        // Dropping a call must never make the shadow drift from the driver
+        EXPECT_TRUE(shadow_matches_driver(filtered ? "filtered stream" : "unfiltered stream"));
+    }
+    global_settings.state_filter = wasEnabled;
+
+    EXPECT_TRUE(finalState[0] == finalState[1]);
+    EXPECT_EQ(dropped[0], (uint64_t)0);
+    EXPECT_TRUE(dropped[1] > 0);
+    EXPECT_TRUE(driverCalls[1] < driverCalls[0]);
+    printf("  %llu of 5000 calls dropped, %zu vs %zu driver calls\n", (unsigned long long)dropped[1],
+           driverCalls[1], driverCalls[0]);
+}
+
+TEST(StateFilter, EachContextHasItsOwnShadow) {
+    reset_gl_errors();
+    const bool wasEnabled = global_settings.state_filter;
+    global_settings.state_filter = true;
+    EGLDisplay display = eglGetCurrentDisplay();
+    EGLSurface draw = eglGetCurrentSurface(EGL_DRAW);
+    EGLSurface read = eglGetCurrentSurface(EGL_READ);
+    EGLContext first = eglGetCurrentContext();
+    const EGLint attribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+    EGLContext second = eglCreateContext(display, nullptr, first, attribs);
+    ASSERT_TRUE(second != EGL_NO_CONTEXT);
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+
+    glEnable(GL_BLEND);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    mg_mock::clear_calls();
+    glEnable(GL_BLEND);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    EXPECT_EQ(mg_mock::count("glEnable"), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glBindBuffer"), (size_t)0);
+
+    // Blend is off and nothing is bound in a context that never saw the calls
+    ASSERT_TRUE(eglMakeCurrent(display, draw, read, second));
+    mg_mock::clear_calls();
+    glEnable(GL_BLEND);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    EXPECT_EQ(mg_mock::count("glEnable"), (size_t)1);
+    EXPECT_EQ(mg_mock::count("glBindBuffer"), (size_t)1);
+    glEnable(GL_BLEND);
+    EXPECT_EQ(mg_mock::count("glEnable"), (size_t)1);
+
+    // The first context comes back with the shadow it left
+    ASSERT_TRUE(eglMakeCurrent(display, draw, read, first));
+    mg_mock::clear_calls();
+    glEnable(GL_BLEND);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    EXPECT_EQ(mg_mock::count("glEnable"), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glBindBuffer"), (size_t)0);
+
+    // Another thread making a context current leaves this thread's shadow be
+    std::promise<void> current, checked;
+    GLboolean otherBlend = GL_TRUE;
+    std::thread other([&] {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, second);
+        glDisable(GL_BLEND);
+        current.set_value();
+        checked.get_future().wait();
+        otherBlend = glIsEnabled(GL_BLEND);
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    });
+    current.get_future().wait();
+    mg_mock::clear_calls();
+    glEnable(GL_BLEND);
+    EXPECT_EQ(mg_mock::count("glEnable"), (size_t)0);
+    checked.set_value();
+    other.join();
+    EXPECT_EQ(otherBlend, (GLboolean)GL_FALSE);
+
+    ASSERT_TRUE(eglMakeCurrent(display, draw, read, first));
+    mg_mock::clear_calls();
+    glEnable(GL_BLEND);
+    EXPECT_EQ(mg_mock::count("glEnable"), (size_t)0);
+    glDisable(GL_BLEND);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDeleteBuffers(1, &buffer);
+    EXPECT_TRUE(eglDestroyContext(display, second));
+    global_settings.state_filter = wasEnabled;
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
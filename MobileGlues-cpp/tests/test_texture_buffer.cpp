@@ -0,0 +1,242 @@
+// MobileGlues - tests/test_texture_buffer.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/mg.h"
+#include "gl/texture_buffer.h"
+#include "test_util.h"
+#include <random>
+
+namespace {
+    // The mock takes GL_TEXTURE_BUFFER natively, so the emulation is forced
+    struct EmulateTextureBuffer {
+        bool saved = hardware->emulate_texture_buffer;
+        EmulateTextureBuffer() { hardware->emulate_texture_buffer = true; }
+        ~EmulateTextureBuffer() { hardware->emulate_texture_buffer = saved; }
+    };
+
+    // Three full rows of 4-byte texels and a partial one
+    const size_t kTexels = TEXTURE_BUFFER_WIDTH * 3 + 1000;
+    const size_t kSize = kTexels * 4;
+
+    std::vector<uint8_t> random_bytes(std::mt19937& rng, size_t size) {
+        std::vector<uint8_t> out(size);
+        for (auto& b : out)
+            b = (uint8_t)rng();
+        return out;
+    }
+
+    // A buffer texture bound on GL_TEXTURE_BUFFER, and what its source
+    // buffer should hold
+    struct BufferTexture {
+        GLuint buffer = 0;
+        GLuint texture = 0;
+        std::vector<uint8_t> shadow;
+
+        BufferTexture(std::mt19937& rng, size_t size) : shadow(random_bytes(rng, size)) {
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+            glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)size, shadow.data(), GL_DYNAMIC_DRAW);
+            glGenTextures(1, &texture);
+            glBindTexture(GL_TEXTURE_BUFFER, texture);
+        }
+
+        ~BufferTexture() {
+            glBindTexture(GL_TEXTURE_BUFFER, 0);
+            glDeleteTextures(1, &texture);
+            glBindBuffer(GL_TEXTURE_BUFFER, 0);
+            glDeleteBuffers(1, &buffer);
+        }
+
+        void sub_data(size_t offset, const std::vector<uint8_t>& data) {
+            glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+            glBufferSubData(GL_TEXTURE_BUFFER, (GLintptr)offset, (GLsizeiptr)data.size(), data.data());
+            memcpy(shadow.data() + offset, data.data(), data.size());
+        }
+
+        void map_write(size_t offset, const std::vector<uint8_t>& data) {
+            glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+            void* p = glMapBufferRange(GL_TEXTURE_BUFFER, (GLintptr)offset, (GLsizeiptr)data.size(),
+                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+            if (p) memcpy(p, data.data(), data.size());
+            glUnmapBuffer(GL_TEXTURE_BUFFER);
+            memcpy(shadow.data() + offset, data.data(), data.size());
+        }
+
+        void copy_from(GLuint source, const std::vector<uint8_t>& source_data, size_t from, size_t offset,
+                       size_t length) {
+            glBindBuffer(GL_COPY_READ_BUFFER, source);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)from, (GLintptr)offset,
+                                (GLsizeiptr)length);
+            memcpy(shadow.data() + offset, source_data.data() + from, length);
+        }
+
+        // The emulated 2D texture holds the texels of [offset, offset + bytes)
+        // row after row
+        bool matches(size_t offset, size_t bytes) const {
+            const mg_mock::TexLevel* level = mg_mock::texture_level(texture, 0);
+            return level && level->data.size() >= bytes &&
+                   memcmp(level->data.data(), shadow.data() + offset, bytes) == 0;
+        }
+    };
+
+    void draw() {
+        glDrawArrays(GL_POINTS, 0, 1);
+    }
+
+    struct Upload {
+        uint64_t y, width, height;
+        bool operator==(const Upload& o) const { return y == o.y && width == o.width && height == o.height; }
+    };
+
+    // glTexSubImage2D calls of the last draw, as rows
+    std::vector<Upload> uploads() {
+        std::vector<Upload> out;
+        for (const mg_mock::Call& call : mg_mock::calls_named("glTexSubImage2D"))
+            out.push_back({call.args[3], call.args[4], call.args[5]});
+        return out;
+    }
+} // namespace
+
+TEST(TextureBuffer, RandomPartialUpdates) {
+    EmulateTextureBuffer emulate;
+    reset_gl_errors();
+    std::mt19937 rng(20251017);
+    BufferTexture tb(rng, kSize);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, tb.buffer);
+    draw();
+
+    const mg_mock::TexLevel* level = mg_mock::texture_level(tb.texture, 0);
+    ASSERT_TRUE(level != nullptr);
+    EXPECT_EQ(level->width, (GLsizei)TEXTURE_BUFFER_WIDTH);
+    EXPECT_EQ(level->height, (GLsizei)4);
+    EXPECT_EQ(level->format, (GLenum)GL_RED_INTEGER);
+    EXPECT_EQ(level->type, (GLenum)GL_UNSIGNED_INT);
+    EXPECT_TRUE(tb.matches(0, kSize));
+
+    GLuint source = 0;
+    std::vector<uint8_t> source_data = random_bytes(rng, kSize);
+    glGenBuffers(1, &source);
+    glBindBuffer(GL_COPY_READ_BUFFER, source);
+    glBufferData(GL_COPY_READ_BUFFER, (GLsizeiptr)kSize, source_data.data(), GL_STATIC_DRAW);
+
+    // Small writes, writes across rows and into the partial row, and enough
+    // of them between draws now and then to overflow the dirty range list
+    for (int round = 0; round < 300; ++round) {
+        const int writes = round % 25 == 24 ? 40 : 1 + (int)(rng() % 4);
+        for (int i = 0; i < writes; ++i) {
+            const size_t offset = rng() % kSize;
+            const size_t limit = std::min<size_t>(kSize - offset, rng() % 2 ? 64 : TEXTURE_BUFFER_WIDTH * 8);
+            const size_t length = 1 + rng() % limit;
+            switch (rng() % 3) {
+            case 0:
+                tb.sub_data(offset, random_bytes(rng, length));
+                break;
+            case 1:
+                tb.map_write(offset, random_bytes(rng, length));
+                break;
+            default:
+                tb.copy_from(source, source_data, rng() % (kSize - length + 1), offset, length);
+                break;
+            }
+        }
+        mg_mock::clear_calls();
+        draw();
+        EXPECT_EQ(mg_mock::count("glTexImage2D"), (size_t)0);
+        if (!tb.matches(0, kSize)) {
+            mg_test::fail(__FILE__, __LINE__, "texels differ after round " + std::to_string(round));
+            break;
+        }
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glDeleteBuffers(1, &source);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(TextureBuffer, UploadsOnlyDirtyRows) {
+    EmulateTextureBuffer emulate;
+    reset_gl_errors();
+    std::mt19937 rng(7);
+    const uint64_t width = TEXTURE_BUFFER_WIDTH;
+    BufferTexture tb(rng, kSize);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8, tb.buffer);
+    draw();
+
+    // Binding the same buffer again does not upload anything
+    mg_mock::clear_calls();
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8, tb.buffer);
+    draw();
+    EXPECT_EQ(mg_mock::count("glTexImage2D"), (size_t)0);
+    EXPECT_EQ(mg_mock::count("glTexSubImage2D"), (size_t)0);
+
+    // Inside one row
+    mg_mock::clear_calls();
+    tb.sub_data((width + 10) * 4, random_bytes(rng, 8));
+    draw();
+    EXPECT_TRUE(uploads() == (std::vector<Upload>{{1, width, 1}}));
+
+    // Across three full rows, in one copy
+    mg_mock::clear_calls();
+    tb.map_write(100 * 4, random_bytes(rng, width * 2 * 4));
+    draw();
+    EXPECT_TRUE(uploads() == (std::vector<Upload>{{0, width, 3}}));
+
+    // Into the partial last row, which only has 1000 texels
+    mg_mock::clear_calls();
+    tb.sub_data((width * 2 + 5) * 4, random_bytes(rng, width * 4));
+    draw();
+    EXPECT_TRUE(uploads() == (std::vector<Upload>{{2, width, 1}, {3, 1000, 1}}));
+
+    // Disjoint ranges go separately, overlapping ones together
+    mg_mock::clear_calls();
+    tb.sub_data(4, random_bytes(rng, 4));
+    tb.sub_data((width * 2 + 1) * 4, random_bytes(rng, 16));
+    tb.sub_data((width * 2 + 3) * 4, random_bytes(rng, 16));
+    draw();
+    EXPECT_TRUE(uploads() == (std::vector<Upload>{{0, width, 1}, {2, width, 1}}));
+    EXPECT_EQ(mg_mock::count("glTexImage2D"), (size_t)0);
+    EXPECT_TRUE(tb.matches(0, kSize));
+
+    // Nothing written, nothing uploaded
+    mg_mock::clear_calls();
+    draw();
+    EXPECT_EQ(mg_mock::count("glTexSubImage2D"), (size_t)0);
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
+
+TEST(TextureBuffer, RangeFollowsItsOffset) {
+    EmulateTextureBuffer emulate;
+    reset_gl_errors();
+    std::mt19937 rng(11);
+    const size_t offset = 256, bytes = (TEXTURE_BUFFER_WIDTH + 300) * 8;
+    BufferTexture tb(rng, offset + bytes + 512);
+    glTexBufferRange(GL_TEXTURE_BUFFER, GL_RG32F, tb.buffer, (GLintptr)offset, (GLsizeiptr)bytes);
+    draw();
+    const mg_mock::TexLevel* level = mg_mock::texture_level(tb.texture, 0);
+    ASSERT_TRUE(level != nullptr);
+    EXPECT_EQ(level->height, (GLsizei)2);
+    EXPECT_TRUE(tb.matches(offset, bytes));
+
+    // Outside the range
+    mg_mock::clear_calls();
+    tb.sub_data(0, random_bytes(rng, offset));
+    tb.sub_data(offset + bytes, random_bytes(rng, 512));
+    draw();
+    EXPECT_EQ(mg_mock::count("glTexSubImage2D"), (size_t)0);
+
+    for (int round = 0; round < 50; ++round) {
+        const size_t at = rng() % (tb.shadow.size() - 1);
+        tb.map_write(at, random_bytes(rng, 1 + rng() % std::min<size_t>(tb.shadow.size() - at, 20000)));
+        draw();
+        if (!tb.matches(offset, bytes)) {
+            mg_test::fail(__FILE__, __LINE__, "texels differ after round " + std::to_string(round));
+            break;
+        }
+    }
+    EXPECT_EQ(glGetError(), (GLenum)GL_NO_ERROR);
+}
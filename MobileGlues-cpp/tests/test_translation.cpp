@@ -0,0 +1,83 @@
+// MobileGlues - tests/test_translation.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/glsl/glsl_for_es.h"
+#include "test_util.h"
+
+// Each stage of GLSLtoGLSLES_2 on its own, over the GLSL corpus. The
+// glslang and SPIRV-Cross stages run on this thread's reused translation
+// context, so after the first round they measure steady-state cost.
+BENCH(Translation, Stages) {
+    struct Input {
+        std::string glsl;
+        GLenum type;
+        std::string preprocessed;
+        int version;
+        std::vector<unsigned int> spirv;
+        std::string essl;
+    };
+    std::vector<Input> corpus;
+    for (const auto& path : corpus_files("glsl")) {
+        Input in{read_text_file(path), shader_type_of(path)};
+        bool atomic = false;
+        in.preprocessed = preprocess_glsl(in.glsl, in.type, &atomic);
+        in.version = get_or_add_glsl_version(in.preprocessed);
+        const char* src[] = {in.preprocessed.c_str()};
+        int errc = 0;
+        in.spirv = glsl_to_spirv(in.type, in.version, src, errc);
+        if (!in.spirv.empty()) in.essl = spirv_to_essl(in.spirv, 320, errc);
+        if (in.essl.empty()) in.essl = in.glsl; // post-processing still has something to chew on
+        corpus.push_back(std::move(in));
+    }
+    ASSERT_TRUE(!corpus.empty());
+    const int rounds = 20;
+    const double shaders = (double)corpus.size();
+
+    mg_test::measure(
+        "preprocess", rounds, "shaders",
+        [&] {
+            for (const Input& in : corpus) {
+                bool atomic = false;
+                std::string out = preprocess_glsl(in.glsl, in.type, &atomic);
+                get_or_add_glsl_version(out);
+            }
+        },
+        shaders);
+
+    mg_test::measure(
+        "glslang parse + link + SPIR-V", rounds, "shaders",
+        [&] {
+            for (const Input& in : corpus) {
+                const char* src[] = {in.preprocessed.c_str()};
+                int errc = 0;
+                glsl_to_spirv(in.type, in.version, src, errc);
+            }
+        },
+        shaders);
+
+    mg_test::measure(
+        "SPIRV-Cross to ESSL", rounds, "shaders",
+        [&] {
+            for (const Input& in : corpus) {
+                if (in.spirv.empty()) continue; // translation is unavailable in this build
+                int errc = 0;
+                spirv_to_essl(in.spirv, 320, errc);
+            }
+        },
+        shaders);
+
+    mg_test::measure(
+        "ESSL post-processing", rounds, "shaders",
+        [&] {
+            for (const Input& in : corpus) {
+                std::string essl = in.type != GL_COMPUTE_SHADER ? removeLayoutBinding(in.essl) : in.essl;
+                essl = processOutColorLocations(essl);
+                forceSupporterOutput(essl);
+            }
+        },
+        shaders);
+}
@@ -0,0 +1,66 @@
+// MobileGlues - tests/test_util.h
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#ifndef MOBILEGLUES_TEST_UTIL_H
+#define MOBILEGLUES_TEST_UTIL_H
+
+#define GL_GLEXT_PROTOTYPES
+#include "includes.h"
+#include "mg_test.h"
+#include "mock_gles.h"
+#include <GL/gl.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Entry points called by the tests resolve to MobileGlues, the ones behind
+// it to the mock. mock_gl() calls the mock directly, e.g. to set up driver
+// state MobileGlues should not know about.
+template <typename Fn> inline Fn mock_gl(const char* name) {
+    return (Fn)mg_mock::proc(name);
+}
+
+#define MOCK_GL(name) mock_gl<decltype(&name)>(#name)
+
+// Drains GL errors on both sides so a test starts from a clean slate
+inline void reset_gl_errors() {
+    while (glGetError() != GL_NO_ERROR) {
+    }
+    while (MOCK_GL(glGetError)() != GL_NO_ERROR) {
+    }
+}
+
+inline std::string read_text_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream s;
+    s << in.rdbuf();
+    return s.str();
+}
+
+// Files of tests/corpus/<name>, sorted so runs are reproducible
+inline std::vector<std::filesystem::path> corpus_files(const char* name) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::path(MG_TEST_SOURCE_DIR) /
+                                                                 "corpus" / name)) {
+        if (entry.is_regular_file()) files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+inline GLenum shader_type_of(const std::filesystem::path& path) {
+    std::string ext = path.extension().string();
+    if (ext == ".vert") return GL_VERTEX_SHADER;
+    if (ext == ".comp") return GL_COMPUTE_SHADER;
+    if (ext == ".geom") return GL_GEOMETRY_SHADER;
+    return GL_FRAGMENT_SHADER;
+}
+
+#endif // MOBILEGLUES_TEST_UTIL_H
@@ -0,0 +1,130 @@
+// MobileGlues - tests/tools/mg_replay.cpp
+// Copyright (c) 2025-2026 MobileGL-Dev
+// Licensed under the GNU Lesser General Public License v2.1:
+//   https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt
+// SPDX-License-Identifier: LGPL-2.1-only
+// End of Source File Header
+
+#include "gl/call_trace.h"
+#include "includes.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Replays a call trace written with enableCallTrace through the MobileGlues
+// front end and prints where the time went, per entry point.
+//
+//   mg_replay [--gles <libGLESv3>] [--egl <libEGL>] [--frames] trace.bin
+//
+// Without --gles/--egl (or MG_GLES_LIBRARY/MG_EGL_LIBRARY) the mock backend
+// is used, which measures MobileGlues' own overhead. Object names are not
+// remapped, so the trace must have been captured from process start.
+
+static void usage() {
+    fprintf(stderr, "usage: mg_replay [--gles <library>] [--egl <library>] [--frames] <trace>\n");
+}
+
+static EGLDisplay g_display = EGL_NO_DISPLAY;
+static EGLSurface g_surface = EGL_NO_SURFACE;
+
+static bool make_current() {
+    g_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (!eglInitialize(g_display, nullptr, nullptr)) return false;
+    EGLint attribs[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT, EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_NONE};
+    EGLConfig config;
+    EGLint count = 0;
+    if (!eglChooseConfig(g_display, attribs, &config, 1, &count) || count == 0) return false;
+    EGLint ctx_attribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+    EGLContext context = eglCreateContext(g_display, config, EGL_NO_CONTEXT, ctx_attribs);
+    EGLint pb_attribs[] = {EGL_WIDTH, 1280, EGL_HEIGHT, 720, EGL_NONE};
+    g_surface = eglCreatePbufferSurface(g_display, config, pb_attribs);
+    return context != EGL_NO_CONTEXT && g_surface != EGL_NO_SURFACE &&
+           eglMakeCurrent(g_display, g_surface, g_surface, context);
+}
+
+int main(int argc, char** argv) {
+    const char* gles = getenv("MG_GLES_LIBRARY");
+    const char* egl = getenv("MG_EGL_LIBRARY");
+    const char* trace = nullptr;
+    bool frames = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--gles") == 0 && i + 1 < argc)
+            gles = argv[++i];
+        else if (strcmp(argv[i], "--egl") == 0 && i + 1 < argc)
+            egl = argv[++i];
+        else if (strcmp(argv[i], "--frames") == 0)
+            frames = true;
+        else if (argv[i][0] != '-' && !trace)
+            trace = argv[i];
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (!trace) {
+        usage();
+        return 2;
+    }
+
+    char dir[] = "/tmp/mg-replay-XXXXXX";
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    setenv("MG_DIR_PATH", dir, 1);
+    setenv("MG_GLES_LIBRARY", gles ? gles : MG_MOCK_LIBRARY, 1);
+    setenv("MG_EGL_LIBRARY", egl ? egl : MG_MOCK_LIBRARY, 1);
+
+    proc_init();
+    if (!make_current()) {
+        fprintf(stderr, "mg_replay: cannot make a context current\n");
+        return 1;
+    }
+
+    CallTraceReplayStats stats;
+    std::string error;
+    uint64_t start = call_trace_now();
+    bool ok = call_trace_replay(
+        trace, stats,
+        [&] {
+            uint64_t frame_start = call_trace_now();
+            eglSwapBuffers(g_display, g_surface);
+            if (frames)
+                printf("frame %llu: %.3f ms\n", (unsigned long long)stats.frames,
+                       (call_trace_now() - frame_start) / 1e6);
+        },
+        error);
+    uint64_t total = call_trace_now() - start;
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    if (!ok) {
+        fprintf(stderr, "mg_replay: %s: %s\n", trace, error.c_str());
+        return 1;
+    }
+
+    std::vector<const CallTraceReplayEntryStats*> entries;
+    for (const CallTraceReplayEntryStats& entry : stats.entries) {
+        if (entry.calls) entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const auto* a, const auto* b) { return a->replayed_ns > b->replayed_ns; });
+
+    printf("%-40s %10s %10s %12s %12s %10s\n", "entry point", "calls", "replayed", "captured ms", "replayed ms",
+           "ns/call");
+    for (const CallTraceReplayEntryStats* entry : entries) {
+        printf("%-40s %10llu %10llu %12.3f %12.3f %10.0f\n", entry->name.c_str(), (unsigned long long)entry->calls,
+               (unsigned long long)entry->replayed, entry->captured_ns / 1e6, entry->replayed_ns / 1e6,
+               entry->replayed ? (double)entry->replayed_ns / (double)entry->replayed : 0.0);
+    }
+    printf("\n%llu frames, %llu calls: %llu replayed, %llu unreplayable, %llu without arguments, %llu unknown\n",
+           (unsigned long long)stats.frames, (unsigned long long)stats.calls, (unsigned long long)stats.replayed,
+           (unsigned long long)stats.unreplayable, (unsigned long long)stats.no_args,
+           (unsigned long long)stats.unknown);
+    printf("replay took %.3f ms\n", total / 1e6);
+    return 0;
+}